@@ -67,16 +67,85 @@ struct TerrainInterface : TerrainSceneData
 		return heightMap.metersPerTexel;
 	}
 
+	bool IsHeightMapStreamed()
+	{
+		return heightMap.streamingTilesNum.x > 0u;
+	}
+
+	// Valid only for streamed height maps
+	float LoadHeightTexel(int2 texel)
+	{
+		texel = clamp(texel, int2(0, 0), int2(heightMap.res) - 1);
+
+		const uint2 tileCoords = uint2(texel) / heightMap.streamingTileRes;
+		const uint physicalSlot = heightMap.pageTable.Load(tileCoords.y * heightMap.streamingTilesNum.x + tileCoords.x);
+
+		if (physicalSlot != IDX_NONE_32)
+		{
+			const uint2 slotCoords = uint2(physicalSlot % heightMap.physicalSlotsPerRow, physicalSlot / heightMap.physicalSlotsPerRow);
+			return heightMap.physicalTiles.Load(slotCoords * heightMap.streamingTileRes + uint2(texel) % heightMap.streamingTileRes);
+		}
+
+		// Tile is not resident - use low resolution height map
+		const float2 uv = (float2(texel) + 0.5f) * heightMap.invRes;
+		return heightMap.texture.SampleLevel(BindlessSamplers::LinearClampEdge(), uv, 0);
+	}
+
 	float GetHeight(float2 locationXY)
 	{
-		const float heightMapValue = heightMap.texture.SampleLevel(BindlessSamplers::LinearClampEdge(), GetHeightMapUV(locationXY), 0);
+		if (!IsHeightMapStreamed())
+		{
+			const float heightMapValue = heightMap.texture.SampleLevel(BindlessSamplers::LinearClampEdge(), GetHeightMapUV(locationXY), 0);
+			return lerp(heightMap.minHeight, heightMap.maxHeight, heightMapValue);
+		}
+
+		// Physical tiles don't have borders, so filtering is done manually
+		const float2 texelPos = GetHeightMapUV(locationXY) * heightMap.res - 0.5f;
+		const int2 baseTexel = int2(floor(texelPos));
+		const float2 fraction = texelPos - float2(baseTexel);
+
+		const float h00 = LoadHeightTexel(baseTexel);
+		const float h10 = LoadHeightTexel(baseTexel + int2(1, 0));
+		const float h01 = LoadHeightTexel(baseTexel + int2(0, 1));
+		const float h11 = LoadHeightTexel(baseTexel + int2(1, 1));
+
+		const float heightMapValue = lerp(lerp(h00, h10, fraction.x), lerp(h01, h11, fraction.x), fraction.y);
 		return lerp(heightMap.minHeight, heightMap.maxHeight, heightMapValue);
 	}
 
 	float GetHeightSmooth(float2 locationXY)
 	{
-		const float2 uv = GetHeightMapUV(locationXY);
-		const float heightMapValue = SampleTricubicBSpline(heightMap.texture.GetResource(), BindlessSamplers::LinearClampEdge(), uv, heightMap.res, heightMap.invRes);
+		if (!IsHeightMapStreamed())
+		{
+			const float2 uv = GetHeightMapUV(locationXY);
+			const float heightMapValue = SampleTricubicBSpline(heightMap.texture.GetResource(), BindlessSamplers::LinearClampEdge(), uv, heightMap.res, heightMap.invRes);
+			return lerp(heightMap.minHeight, heightMap.maxHeight, heightMapValue);
+		}
+
+		const float2 texelPos = GetHeightMapUV(locationXY) * heightMap.res - 0.5f;
+		const int2 baseTexel = int2(floor(texelPos));
+		const float2 t = texelPos - float2(baseTexel);
+
+		// Cubic B-spline weights
+		const float2 t2 = t * t;
+		const float2 t3 = t2 * t;
+		float2 weights[4];
+		weights[0] = (1.f - 3.f * t + 3.f * t2 - t3) / 6.f;
+		weights[1] = (3.f * t3 - 6.f * t2 + 4.f) / 6.f;
+		weights[2] = (-3.f * t3 + 3.f * t2 + 3.f * t + 1.f) / 6.f;
+		weights[3] = t3 / 6.f;
+
+		float heightMapValue = 0.f;
+		for (int y = 0; y < 4; ++y)
+		{
+			float rowValue = 0.f;
+			for (int x = 0; x < 4; ++x)
+			{
+				rowValue += weights[x].x * LoadHeightTexel(baseTexel + int2(x - 1, y - 1));
+			}
+			heightMapValue += weights[y].y * rowValue;
+		}
+
 		return lerp(heightMap.minHeight, heightMap.maxHeight, heightMapValue);
 	}
 
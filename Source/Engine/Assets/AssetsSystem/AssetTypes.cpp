@@ -38,6 +38,18 @@ void AssetFactory::DeleteAsset(AssetType assetType, AssetsSystem& assetSystem, c
 	deleter(assetSystem, path, data);
 }
 
+void AssetFactory::CollectCompilationDependencies(AssetType assetType, const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies) const
+{
+	const auto it = m_assetTypes.find(assetType.id);
+	if (it == m_assetTypes.end())
+	{
+		return;
+	}
+
+	const auto& dependenciesCollector = it->second.dependenciesCollector;
+	dependenciesCollector(path, data, outDependencies);
+}
+
 AssetType AssetFactory::GetAssetTypeByKey(AssetTypeKey key) const
 {
 	const auto it = m_assetTypes.find(key);
@@ -214,6 +214,9 @@ protected:
 	// This can be overridden by child class. In order to do that, create the same static function with the same signature
 	static void OnAssetDeleted(AssetsSystem& assetSystem, const ResourcePath& path, const AssetInstanceData& data) {}
 
+	// Assets that must be compiled before this asset. Used to schedule batch compilation. Can be overridden the same way as OnAssetDeleted
+	static void CollectCompilationDependencies(const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies) {}
+
 	operator AssetDerivedDataKey() const { return AssetDerivedDataKey(GetResourcePathID()); }
 
 	template<typename THeader, typename TBlobWriter>
@@ -243,12 +246,12 @@ private:
 template<typename THeader, typename TBlobWriter>
 void AssetInstance::CreateDerivedData(AssetDerivedDataKey key, const THeader& header, Uint32 blobSize, TBlobWriter&& blobWriter)
 {
-	lib::String headerData;
+	lib::DynamicArray<Byte> headerData;
 	if constexpr (!std::is_same_v<THeader, DDCNoHeader>)
 	{
-		srl::Serializer serializer = srl::Serializer::CreateWriter();
+		srl::Serializer serializer = srl::Serializer::CreateBinaryWriter();
 		const_cast<THeader&>(header).Serialize(serializer);
-		headerData = serializer.ToCompactString();
+		headerData = serializer.ToBinary();
 	}
 
 	const Uint32 headerSize = static_cast<Uint32>(headerData.size());
@@ -295,9 +298,18 @@ lib::MTHandle<DDCLoadedData<THeader>> AssetInstance::LoadDerivedData(AssetDerive
 	std::memcpy(&headerSize, immutableSpan.data(), sizeof(Uint32));
 	if constexpr (!std::is_same_v<THeader, DDCNoHeader>)
 	{
-		const lib::StringView headerData(reinterpret_cast<const char*>(immutableSpan.data() + sizeof(Uint32)), headerSize);
-		srl::Serializer serializer = srl::Serializer::CreateReader(headerData);
-		result->header.Serialize(serializer);
+		const lib::Span<const Byte> headerData(immutableSpan.data() + sizeof(Uint32), headerSize);
+		if (srl::Serializer::IsBinaryData(headerData))
+		{
+			srl::Serializer serializer = srl::Serializer::CreateBinaryReader(headerData);
+			result->header.Serialize(serializer);
+		}
+		else
+		{
+			// Derived data created before headers were stored in binary format
+			srl::Serializer serializer = srl::Serializer::CreateReader(lib::StringView(reinterpret_cast<const char*>(headerData.data()), headerData.size()));
+			result->header.Serialize(serializer);
+		}
 	}
 
 	const Uint32 dataSize = static_cast<Uint32>(immutableSpan.size()) - sizeof(Uint32) - headerSize;
@@ -334,13 +346,20 @@ public:
 			TAssetType::OnAssetDeleted(assetSystem, path, data);
 		};
 
-		m_assetTypes[CreateAssetTypeKey<TAssetType>()] = AssetTypeMetaData{ .type = CreateAssetType<TAssetType>(), .factory = factory, .deleter = deleter};
+		const auto dependenciesCollector = [](const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies) -> void
+		{
+			TAssetType::CollectCompilationDependencies(path, data, outDependencies);
+		};
+
+		m_assetTypes[CreateAssetTypeKey<TAssetType>()] = AssetTypeMetaData{ .type = CreateAssetType<TAssetType>(), .factory = factory, .deleter = deleter, .dependenciesCollector = dependenciesCollector };
 	}
 
 	AssetHandle CreateAsset(AssetsSystem& owningSystem, const AssetInstanceDefinition& definition);
 
 	void DeleteAsset(AssetType assetType, AssetsSystem& assetSystem, const ResourcePath& path, const AssetInstanceData& data);
 
+	void CollectCompilationDependencies(AssetType assetType, const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies) const;
+
 	AssetType GetAssetTypeByKey(AssetTypeKey key) const;
 
 private:
@@ -352,6 +371,7 @@ private:
 		AssetType type;
 		lib::RawCallable<AssetHandle(AssetsSystem& owningSystem, const AssetInstanceDefinition& definition)>       factory;
 		lib::RawCallable<void(AssetsSystem& assetSystem, const ResourcePath& path, const AssetInstanceData& data)> deleter;
+		lib::RawCallable<void(const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies)> dependenciesCollector;
 	};
 
 	lib::HashMap<AssetTypeKey, AssetTypeMetaData> m_assetTypes;
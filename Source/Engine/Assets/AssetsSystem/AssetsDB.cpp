@@ -1,275 +1,788 @@
 #include "AssetsDB.h"
-#include "Containers/DynamicArray.h"
-#include "Eigen/src/SparseCore/SparseUtil.h"
 #include "ResourcePath.h"
 #include <cstring>
 #include <cwchar>
 
+SPT_DEFINE_LOG_CATEGORY(AssetsDB, true);
+
 
 namespace spt::as
 {
 
-AssetsDB::AssetsDB()
+namespace priv
+{
+
+static constexpr Uint32 assetsFileMagic = 0x42444153u; // "SADB"
+static constexpr Uint32 pathsFileMagic  = 0x50444153u; // "SADP"
+static constexpr Uint32 fileVersion     = 2u;
+
+struct DeltaLogRecord
+{
+	ResourcePathID pathID       = InvalidResourcePathID;
+	AssetTypeKey   assetTypeKey = 0u;
+	Uint32         isDeleted    = 0u;
+	/** Length of UTF-8 path that follows the record */
+	Uint32         pathLength   = 0u;
+};
+
+// Format used before records were sorted and paths were pooled
+struct LegacyAssetsDBHeader
+{
+	Uint32 descriptorsNum;
+	Uint32 padding;
+};
+
+struct LegacyAssetDescriptorData
+{
+	ResourcePathID pathID;
+	AssetTypeKey   assetTypeKey;
+};
+
+struct LegacyPathDescriptorData
 {
+	static constexpr Uint32 s_maxLength = 256u;
+	wchar_t path[s_maxLength];
+};
+
+static lib::String PathToUTF8(const lib::Path& path)
+{
+	const std::u8string utf8Path = path.generic_u8string();
+	return lib::String(reinterpret_cast<const char*>(utf8Path.data()), utf8Path.size());
 }
 
-void AssetsDB::Initalize(const AssetsDBInitInfo& initInfo)
+static ResourcePath UTF8ToPath(lib::StringView utf8Path)
 {
-	SPT_PROFILER_FUNCTION();
+	return ResourcePath(lib::Path(std::u8string_view(reinterpret_cast<const char8_t*>(utf8Path.data()), utf8Path.size())));
+}
 
-	m_ddc = &initInfo.ddc;
+/** Newer delta chunk is merged with older one if older chunk isn't at least this many times larger. Keeps number of chunks logarithmic */
+static constexpr SizeType deltaChunksSizeRatio = 2u;
 
-	const Bool shouldLoadPathsDB = initInfo.pathsDDCKey.IsValid();
+/** Inserts or replaces entry, keeping delta sorted by path ID */
+static void UpsertDeltaEntry(lib::DynamicArray<assets_db::DeltaEntry>& delta, assets_db::DeltaEntry entry)
+{
+	const auto it = std::lower_bound(delta.begin(), delta.end(), entry.pathID,
+									 [](const assets_db::DeltaEntry& lhs, ResourcePathID rhs) { return lhs.pathID < rhs; });
 
-	Bool shouldInitalizeDB = false;
-	if (initInfo.ddc.DoesKeyExist(initInfo.assetsDDCKey) || initInfo.ddc.DoesKeyExist(initInfo.pathsDDCKey))
+	if (it != delta.end() && it->pathID == entry.pathID)
+	{
+		*it = std::move(entry);
+	}
+	else
 	{
-		m_assetsDDCHandle = initInfo.ddc.GetResourceHandle(initInfo.assetsDDCKey, DDCResourceMapping{ .writable = true });
+		delta.insert(it, std::move(entry));
+	}
+}
+
+/** Entries of newer chunk override entries of older chunk with the same path ID */
+static assets_db::DeltaChunkHandle MergeDeltaChunks(const assets_db::DeltaChunk& older, const assets_db::DeltaChunk& newer)
+{
+	lib::SharedPtr<assets_db::DeltaChunk> merged = std::make_shared<assets_db::DeltaChunk>();
+	merged->entries.reserve(older.entries.size() + newer.entries.size());
+
+	SizeType olderIdx = 0u;
+	SizeType newerIdx = 0u;
 
-		if (shouldLoadPathsDB)
+	while (olderIdx < older.entries.size() || newerIdx < newer.entries.size())
+	{
+		const Bool takeOlder = newerIdx >= newer.entries.size() || (olderIdx < older.entries.size() && older.entries[olderIdx].pathID < newer.entries[newerIdx].pathID);
+
+		if (takeOlder)
+		{
+			merged->entries.emplace_back(older.entries[olderIdx++]);
+		}
+		else
 		{
-			m_pathsDDCHandle = initInfo.ddc.GetResourceHandle(initInfo.pathsDDCKey, DDCResourceMapping{ .writable = true });
+			if (olderIdx < older.entries.size() && older.entries[olderIdx].pathID == newer.entries[newerIdx].pathID)
+			{
+				++olderIdx;
+			}
+
+			merged->entries.emplace_back(newer.entries[newerIdx++]);
 		}
 	}
-	else
+
+	return merged;
+}
+
+static const assets_db::DeltaEntry* FindChunkEntry(const assets_db::DeltaChunk& chunk, ResourcePathID pathID)
+{
+	const auto it = std::lower_bound(chunk.entries.cbegin(), chunk.entries.cend(), pathID,
+									 [](const assets_db::DeltaEntry& lhs, ResourcePathID rhs) { return lhs.pathID < rhs; });
+
+	return it != chunk.entries.cend() && it->pathID == pathID ? &(*it) : nullptr;
+}
+
+} // priv
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// AssetsDBSnapshot ==============================================================================
+
+AssetsDBSnapshot::AssetsDBSnapshot(lib::SharedPtr<const assets_db::BaseStorage> base, lib::DynamicArray<assets_db::DeltaEntry> delta)
+	: m_base(std::move(base))
+{
+	m_assetsNum = m_base ? m_base->records.size() : 0u;
+
+	for (const assets_db::DeltaEntry& entry : delta)
 	{
-		const Uint64 initialDescriptorsCapacity = 1024u;
+		const Bool isInBase = !!FindBaseRecord(entry.pathID);
 
-		m_assetsDDCHandle = initInfo.ddc.CreateDerivedData(initInfo.assetsDDCKey, sizeof(AssetsDBHeader) + sizeof(PersistentAssetDescriptorData) * initialDescriptorsCapacity);
+		if (entry.isDeleted && isInBase)
+		{
+			--m_assetsNum;
+		}
+		else if (!entry.isDeleted && !isInBase)
+		{
+			++m_assetsNum;
+		}
+	}
 
-		if (shouldLoadPathsDB)
+	if (!delta.empty())
+	{
+		lib::SharedPtr<assets_db::DeltaChunk> chunk = std::make_shared<assets_db::DeltaChunk>();
+		chunk->entries = std::move(delta);
+		m_deltaChunks.emplace_back(std::move(chunk));
+	}
+}
+
+AssetsDBSnapshot::AssetsDBSnapshot(const AssetsDBSnapshot& previous, assets_db::DeltaEntry entry)
+	: m_base(previous.m_base)
+	, m_deltaChunks(previous.m_deltaChunks)
+	, m_assetsNum(previous.m_assetsNum)
+{
+	const Bool wasContained = previous.ContainsAsset(entry.pathID);
+
+	if (wasContained && entry.isDeleted)
+	{
+		--m_assetsNum;
+	}
+	else if (!wasContained && !entry.isDeleted)
+	{
+		++m_assetsNum;
+	}
+
+	lib::SharedPtr<assets_db::DeltaChunk> chunk = std::make_shared<assets_db::DeltaChunk>();
+	chunk->entries.emplace_back(std::move(entry));
+
+	assets_db::DeltaChunkHandle newestChunk = std::move(chunk);
+
+	// Each entry is copied only when its chunk is merged, which happens logarithmic number of times
+	while (!m_deltaChunks.empty() && m_deltaChunks.back()->entries.size() <= priv::deltaChunksSizeRatio * newestChunk->entries.size())
+	{
+		newestChunk = priv::MergeDeltaChunks(*m_deltaChunks.back(), *newestChunk);
+		m_deltaChunks.pop_back();
+	}
+
+	m_deltaChunks.emplace_back(std::move(newestChunk));
+}
+
+std::optional<AssetDescriptor> AssetsDBSnapshot::GetAssetDescriptor(ResourcePathID pathID) const
+{
+	if (const assets_db::DeltaEntry* entry = FindDeltaEntry(pathID))
+	{
+		return entry->isDeleted ? std::nullopt : std::make_optional(AssetDescriptor{ .assetTypeKey = entry->assetTypeKey });
+	}
+
+	if (const assets_db::AssetRecord* record = FindBaseRecord(pathID))
+	{
+		return AssetDescriptor{ .assetTypeKey = record->assetTypeKey };
+	}
+
+	return std::nullopt;
+}
+
+Bool AssetsDBSnapshot::ContainsAsset(ResourcePathID pathID) const
+{
+	if (const assets_db::DeltaEntry* entry = FindDeltaEntry(pathID))
+	{
+		return !entry->isDeleted;
+	}
+
+	return !!FindBaseRecord(pathID);
+}
+
+ResourcePath AssetsDBSnapshot::GetPath(ResourcePathID pathID) const
+{
+	if (const assets_db::DeltaEntry* entry = FindDeltaEntry(pathID))
+	{
+		return entry->isDeleted ? ResourcePath() : entry->path;
+	}
+
+	if (const assets_db::AssetRecord* record = FindBaseRecord(pathID))
+	{
+		return GetBaseRecordPath(*record);
+	}
+
+	return ResourcePath();
+}
+
+const assets_db::AssetRecord* AssetsDBSnapshot::FindBaseRecord(ResourcePathID pathID) const
+{
+	if (!m_base)
+	{
+		return nullptr;
+	}
+
+	const lib::Span<const assets_db::AssetRecord> records = m_base->records;
+
+	const auto it = std::lower_bound(records.begin(), records.end(), pathID,
+									 [](const assets_db::AssetRecord& lhs, ResourcePathID rhs) { return lhs.pathID < rhs; });
+
+	return it != records.end() && it->pathID == pathID ? &(*it) : nullptr;
+}
+
+SizeType AssetsDBSnapshot::GetDeltaEntriesNum() const
+{
+	SizeType entriesNum = 0u;
+
+	for (const assets_db::DeltaChunkHandle& chunk : m_deltaChunks)
+	{
+		entriesNum += chunk->entries.size();
+	}
+
+	return entriesNum;
+}
+
+const assets_db::DeltaEntry* AssetsDBSnapshot::FindDeltaEntry(ResourcePathID pathID) const
+{
+	for (auto chunkIt = m_deltaChunks.crbegin(); chunkIt != m_deltaChunks.crend(); ++chunkIt)
+	{
+		if (const assets_db::DeltaEntry* entry = priv::FindChunkEntry(**chunkIt, pathID))
 		{
-			m_pathsDDCHandle = initInfo.ddc.CreateDerivedData(initInfo.pathsDDCKey, sizeof(PersistentPathDescriptorData) * initialDescriptorsCapacity);
+			return entry;
 		}
+	}
 
-		shouldInitalizeDB = true;
+	return nullptr;
+}
+
+lib::DynamicArray<const assets_db::DeltaEntry*> AssetsDBSnapshot::CollectDeltaEntries() const
+{
+	lib::DynamicArray<const assets_db::DeltaEntry*> entries;
+	entries.reserve(GetDeltaEntriesNum());
+
+	// Newer chunks go first, so after stable sort the newest entry is the first one with its path ID
+	for (auto chunkIt = m_deltaChunks.crbegin(); chunkIt != m_deltaChunks.crend(); ++chunkIt)
+	{
+		for (const assets_db::DeltaEntry& entry : (*chunkIt)->entries)
+		{
+			entries.emplace_back(&entry);
+		}
 	}
 
+	std::stable_sort(entries.begin(), entries.end(),
+					 [](const assets_db::DeltaEntry* lhs, const assets_db::DeltaEntry* rhs) { return lhs->pathID < rhs->pathID; });
 
-	const Uint64 storageDescriptorsNum = (m_assetsDDCHandle.GetImmutableSpan().size() - sizeof(AssetsDBHeader)) / sizeof(PersistentAssetDescriptorData);
+	const auto newEnd = std::unique(entries.begin(), entries.end(),
+									[](const assets_db::DeltaEntry* lhs, const assets_db::DeltaEntry* rhs) { return lhs->pathID == rhs->pathID; });
+	entries.erase(newEnd, entries.end());
 
-	m_ddcHeader      = reinterpret_cast<AssetsDBHeader*>(m_assetsDDCHandle.GetMutablePtr());
-	m_ddcDescriptors = lib::Span<PersistentAssetDescriptorData>(reinterpret_cast<PersistentAssetDescriptorData*>(m_assetsDDCHandle.GetMutablePtr() + sizeof(AssetsDBHeader)), storageDescriptorsNum);
+	return entries;
+}
+
+ResourcePath AssetsDBSnapshot::GetBaseRecordPath(const assets_db::AssetRecord& record) const
+{
+	const lib::StringView pathsPool = m_base->pathsPool;
 
-	if (shouldInitalizeDB)
+	if (record.pathLength == 0u || static_cast<SizeType>(record.pathOffset) + record.pathLength > pathsPool.size())
 	{
-		m_ddcHeader->descriptorsNum = 0u;
+		return ResourcePath();
 	}
 
-	m_descriptors.reserve(m_ddcHeader->descriptorsNum);
+	return priv::UTF8ToPath(pathsPool.substr(record.pathOffset, record.pathLength));
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// AssetsDB ======================================================================================
+
+AssetsDB::AssetsDB()
+{
+}
+
+void AssetsDB::Initalize(const AssetsDBInitInfo& initInfo)
+{
+	SPT_PROFILER_FUNCTION();
+
+	m_ddc            = &initInfo.ddc;
+	m_assetsDDCKey   = initInfo.assetsDDCKey;
+	m_pathsDDCKey    = initInfo.pathsDDCKey;
+	m_deltaLogDDCKey = initInfo.deltaLogDDCKey;
+	m_hasPathsDB     = initInfo.pathsDDCKey.IsValid();
+
+	m_deltaLogRecordsNum       = 0u;
+	m_nextCompactionRecordsNum = deltaLogCompactionThreshold;
+	m_detachedBase.reset();
+
+	lib::DynamicArray<assets_db::DeltaEntry> delta;
 
-	if (shouldLoadPathsDB)
+	OpenBaseStorage();
+
+	if (!GetCurrentSnapshot() && m_ddc->DoesKeyExist(m_assetsDDCKey))
 	{
-		SPT_CHECK_MSG((m_pathsDDCHandle.GetSize() / sizeof(PersistentPathDescriptorData)) == storageDescriptorsNum, "Assets and Paths databases do not match!")
-		m_ddcPaths       = lib::Span<PersistentPathDescriptorData>(reinterpret_cast<PersistentPathDescriptorData*>(m_pathsDDCHandle.GetMutablePtr()), storageDescriptorsNum);
-		m_paths.reserve(m_ddcHeader->descriptorsNum);
+		if (!ImportLegacyDatabase(delta))
+		{
+			SPT_LOG_WARN(AssetsDB, "Assets database has unknown format and will be recreated");
+		}
 	}
 
-	for (Uint32 i = 0; i < m_ddcHeader->descriptorsNum; ++i)
+	ReplayDeltaLog(delta);
+
+	if (!delta.empty())
 	{
-		const PersistentAssetDescriptorData& persistentAssetDescriptor = m_ddcDescriptors[i];
+		AssetsDBSnapshotHandle snapshot = GetCurrentSnapshot();
+		lib::SharedPtr<const assets_db::BaseStorage> base = snapshot ? snapshot->GetBaseStorage() : nullptr;
+
+		PublishSnapshot(nullptr);
+		snapshot.reset();
 
-		AssetDescriptor descriptor;
-		descriptor.assetTypeKey = persistentAssetDescriptor.assetTypeKey;
-		m_descriptors.emplace(persistentAssetDescriptor.pathID, RuntimeAssetDescriptor{ .descriptor = descriptor, .ddcDescriptorIdx = i });
+		AssetsDBSnapshotHandle mergedSnapshot = std::make_shared<AssetsDBSnapshot>(std::move(base), std::move(delta));
 
-		if (shouldLoadPathsDB)
+		if (IsWritable())
 		{
-			const PersistentPathDescriptorData& persistentPathDescriptor = m_ddcPaths[i];
-			m_paths.emplace(persistentAssetDescriptor.pathID, lib::Path(persistentPathDescriptor.path));
+			// Merge changes to base files, so that next startups can use them directly
+			WriteBaseStorage(std::move(mergedSnapshot));
+			OpenBaseStorage();
+		}
+		else
+		{
+			PublishSnapshot(std::move(mergedSnapshot));
 		}
 	}
 
-	SPT_CHECK(shouldLoadPathsDB == ContainsPathsDB());
+	if (!GetCurrentSnapshot())
+	{
+		PublishSnapshot(std::make_shared<AssetsDBSnapshot>());
+	}
 }
 
 void AssetsDB::Shutdown()
 {
 	SPT_PROFILER_FUNCTION();
 
-	m_assetsDDCHandle.Release();
+	AssetsDBSnapshotHandle snapshot = GetCurrentSnapshot();
+	PublishSnapshot(nullptr);
 
-	m_ddcHeader      = nullptr;
-	m_ddcDescriptors = {};
-	m_ddc            = nullptr;
+	if (IsWritable() && snapshot && snapshot->HasDelta())
+	{
+		WriteBaseStorage(std::move(snapshot));
+	}
 
-	m_descriptors.clear();
+	m_deltaLogStream.close();
 
-	m_pathsDDCHandle.Release();
-	m_ddcPaths = {};
-	m_paths.clear();
+	m_ddc = nullptr;
 }
 
 void AssetsDB::SaveAssetDescriptor(const ResourcePath& assetPath, const AssetDescriptor& descriptor)
 {
 	SPT_PROFILER_FUNCTION();
 
-	const lib::WriteLockGuard lock(m_lock);
-
 	SPT_CHECK(IsWritable());
 
-	const auto it = m_descriptors.find(assetPath.GetID());
-	if (it != m_descriptors.end())
+	const lib::LockGuard lock(m_writeLock);
+
+	AssetsDBSnapshotHandle snapshot = GetCurrentSnapshot();
+
+	if (snapshot->ContainsAsset(assetPath.GetID()))
 	{
 		return;
 	}
 
-	const Uint32 descriptorIdx = m_ddcHeader->descriptorsNum;
-	m_ddcHeader->descriptorsNum += 1u;
+	assets_db::DeltaEntry entry{ .pathID = assetPath.GetID(), .assetTypeKey = descriptor.assetTypeKey, .path = assetPath, .isDeleted = false };
 
-	if (descriptorIdx >= m_ddcDescriptors.size())
+	ApplyDeltaEntry_Locked(std::move(snapshot), std::move(entry));
+}
+
+void AssetsDB::DeleteAssetDescriptor(ResourcePathID pathID)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(IsWritable());
+
+	const lib::LockGuard lock(m_writeLock);
+
+	AssetsDBSnapshotHandle snapshot = GetCurrentSnapshot();
+
+	if (!snapshot->ContainsAsset(pathID))
 	{
-		ResizeStorage_Locked(m_ddcDescriptors.size() * 2u);
+		return;
 	}
 
-	m_ddcDescriptors[descriptorIdx] = PersistentAssetDescriptorData{ .pathID = assetPath.GetID(), .assetTypeKey = descriptor.assetTypeKey };
+	assets_db::DeltaEntry entry{ .pathID = pathID, .isDeleted = true };
 
-	PersistentPathDescriptorData& pathPersistentDescriptor = m_ddcPaths[descriptorIdx];
-	const wchar_t* path = assetPath.GetPath().c_str();
-	const SizeType pathLength = std::wcslen(path);
-	std::memcpy(pathPersistentDescriptor.path, path, pathLength * sizeof(wchar_t));
-	std::memset(pathPersistentDescriptor.path + pathLength, 0, PersistentPathDescriptorData::s_maxLength - pathLength * sizeof(wchar_t));
+	ApplyDeltaEntry_Locked(std::move(snapshot), std::move(entry));
+}
 
-	m_descriptors[assetPath.GetID()] = RuntimeAssetDescriptor{ .descriptor = descriptor, .ddcDescriptorIdx = descriptorIdx };
-	m_paths[assetPath.GetID()] = assetPath;
+AssetsDBSnapshotHandle AssetsDB::GetSnapshot() const
+{
+	const auto readScope = m_snapshot.Read();
 
-	m_assetsDDCHandle.FlushWrites();
-	m_pathsDDCHandle.FlushWrites();
+	// Handle is copied while read scope keeps it alive, so returned snapshot can be used after scope ends
+	return *readScope.Get();
 }
 
-void AssetsDB::DeleteAssetDescriptor(ResourcePathID pathID)
+std::optional<AssetDescriptor> AssetsDB::GetAssetDescriptor(ResourcePathID pathID) const
 {
-	SPT_PROFILER_FUNCTION();
+	const auto readScope = m_snapshot.Read();
+	return (*readScope.Get())->GetAssetDescriptor(pathID);
+}
 
-	SPT_CHECK(IsWritable());
+lib::DynamicArray<AssetMetaData> AssetsDB::GetAllAssetsDescriptors() const
+{
+	const AssetsDBSnapshotHandle snapshot = GetSnapshot();
+
+	lib::DynamicArray<AssetMetaData> result;
+	result.reserve(snapshot->GetAssetsNum());
 
-	const lib::WriteLockGuard lock(m_lock);
+	snapshot->ForEachAsset([&result](const AssetMetaData& metaData)
+						   {
+							   result.emplace_back(metaData);
+						   });
 
-	const auto it = m_descriptors.find(pathID);
-	if (it == m_descriptors.end())
+	return result;
+}
+
+Bool AssetsDB::ContainsAsset(ResourcePathID pathID) const
+{
+	const auto readScope = m_snapshot.Read();
+	return (*readScope.Get())->ContainsAsset(pathID);
+}
+
+ResourcePath AssetsDB::GetPath(ResourcePathID pathID) const
+{
+	SPT_CHECK(ContainsPathsDB());
+
+	const auto readScope = m_snapshot.Read();
+	return (*readScope.Get())->GetPath(pathID);
+}
+
+void AssetsDB::OpenBaseStorage()
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (!m_ddc->DoesKeyExist(m_assetsDDCKey))
 	{
 		return;
 	}
 
-	const RuntimeAssetDescriptor& descriptorToDelete = it->second;
+	lib::SharedPtr<assets_db::BaseStorage> base = std::make_shared<assets_db::BaseStorage>();
 
-	m_ddcHeader->descriptorsNum -= 1u;
+	base->assetsHandle = m_ddc->GetResourceHandle(m_assetsDDCKey);
 
-	if (m_ddcHeader->descriptorsNum != descriptorToDelete.ddcDescriptorIdx)
+	const lib::Span<const Byte> assetsData = base->assetsHandle.GetImmutableSpan();
+	if (assetsData.size() < sizeof(assets_db::AssetsFileHeader))
 	{
-		std::swap(m_ddcDescriptors[descriptorToDelete.ddcDescriptorIdx], m_ddcDescriptors[m_ddcHeader->descriptorsNum]);
-		std::swap(m_ddcPaths[descriptorToDelete.ddcDescriptorIdx], m_ddcPaths[m_ddcHeader->descriptorsNum]);
-
-		const PersistentAssetDescriptorData& swappedDescriptor = m_ddcDescriptors[descriptorToDelete.ddcDescriptorIdx];
-		m_descriptors[swappedDescriptor.pathID].ddcDescriptorIdx = descriptorToDelete.ddcDescriptorIdx;
+		return;
 	}
-	else
+
+	assets_db::AssetsFileHeader assetsHeader;
+	std::memcpy(&assetsHeader, assetsData.data(), sizeof(assets_db::AssetsFileHeader));
+
+	if (assetsHeader.magic != priv::assetsFileMagic || assetsHeader.version != priv::fileVersion
+		|| assetsData.size() < sizeof(assets_db::AssetsFileHeader) + assetsHeader.descriptorsNum * sizeof(assets_db::AssetRecord))
 	{
-		std::memset(&m_ddcDescriptors[descriptorToDelete.ddcDescriptorIdx], 0, sizeof(PersistentAssetDescriptorData));
-		std::memset(&m_ddcPaths[descriptorToDelete.ddcDescriptorIdx], 0, sizeof(PersistentPathDescriptorData));
+		return;
 	}
 
-	m_descriptors.erase(it);
-	m_assetsDDCHandle.FlushWrites();
+	base->records = lib::Span<const assets_db::AssetRecord>(reinterpret_cast<const assets_db::AssetRecord*>(assetsData.data() + sizeof(assets_db::AssetsFileHeader)), assetsHeader.descriptorsNum);
+
+	if (m_hasPathsDB && m_ddc->DoesKeyExist(m_pathsDDCKey))
+	{
+		base->pathsHandle = m_ddc->GetResourceHandle(m_pathsDDCKey);
+
+		const lib::Span<const Byte> pathsData = base->pathsHandle.GetImmutableSpan();
+
+		assets_db::PathsFileHeader pathsHeader;
+		if (pathsData.size() >= sizeof(assets_db::PathsFileHeader))
+		{
+			std::memcpy(&pathsHeader, pathsData.data(), sizeof(assets_db::PathsFileHeader));
+		}
+
+		const Bool isValidPathsFile = pathsHeader.magic == priv::pathsFileMagic && pathsHeader.version == priv::fileVersion
+			                       && pathsData.size() >= sizeof(assets_db::PathsFileHeader) + pathsHeader.poolSize;
 
-	m_paths.erase(pathID);
-	m_pathsDDCHandle.FlushWrites();
+		if (isValidPathsFile)
+		{
+			base->pathsPool = lib::StringView(reinterpret_cast<const char*>(pathsData.data() + sizeof(assets_db::PathsFileHeader)), pathsHeader.poolSize);
+		}
+		else
+		{
+			SPT_LOG_ERROR(AssetsDB, "Assets paths database is invalid");
+		}
+	}
+
+	PublishSnapshot(std::make_shared<AssetsDBSnapshot>(std::move(base), lib::DynamicArray<assets_db::DeltaEntry>{}));
 }
 
-std::optional<AssetDescriptor> AssetsDB::GetAssetDescriptor(ResourcePathID pathID) const
+void AssetsDB::ReplayDeltaLog(lib::DynamicArray<assets_db::DeltaEntry>& outDelta) const
 {
-	std::optional<AssetDescriptor> result;
+	SPT_PROFILER_FUNCTION();
 
+	if (!m_deltaLogDDCKey.IsValid())
 	{
-		const lib::ReadLockGuard lock(m_lock);
+		return;
+	}
+
+	std::ifstream stream(m_ddc->GetDerivedDataPath(m_deltaLogDDCKey), std::ios::binary);
+	if (!stream.is_open())
+	{
+		return;
+	}
+
+	lib::String path;
+
+	while (true)
+	{
+		priv::DeltaLogRecord record;
+		if (!stream.read(reinterpret_cast<char*>(&record), sizeof(priv::DeltaLogRecord)))
+		{
+			break;
+		}
+
+		path.resize(record.pathLength);
+		if (record.pathLength > 0u && !stream.read(path.data(), record.pathLength))
+		{
+			// Write of the last record was interrupted
+			break;
+		}
 
-		auto it = m_descriptors.find(pathID);
-		if (it != m_descriptors.end())
+		assets_db::DeltaEntry entry;
+		entry.pathID       = record.pathID;
+		entry.assetTypeKey = record.assetTypeKey;
+		entry.isDeleted    = record.isDeleted != 0u;
+		if (!entry.isDeleted && !path.empty())
 		{
-			result = it->second.descriptor;
+			entry.path = priv::UTF8ToPath(path);
 		}
+
+		priv::UpsertDeltaEntry(outDelta, std::move(entry));
 	}
+}
 
-	return result;
+void AssetsDB::ApplyDeltaEntry_Locked(AssetsDBSnapshotHandle snapshot, assets_db::DeltaEntry entry)
+{
+	AppendToDeltaLog_Locked(entry);
+
+	PublishSnapshot(std::make_shared<AssetsDBSnapshot>(*snapshot, std::move(entry)));
+
+	// Previous snapshot references base files, so it must be released before compaction
+	snapshot.reset();
+
+	if (m_deltaLogRecordsNum >= m_nextCompactionRecordsNum && !CompactDeltaLog_Locked())
+	{
+		// Base files are still used by older snapshots. Next attempt is made after another batch of records
+		m_nextCompactionRecordsNum = m_deltaLogRecordsNum + deltaLogCompactionThreshold;
+	}
 }
 
-lib::DynamicArray<AssetMetaData> AssetsDB::GetAllAssetsDescriptors() const
+void AssetsDB::AppendToDeltaLog_Locked(const assets_db::DeltaEntry& entry)
 {
-	lib::DynamicArray<AssetMetaData> result;
+	const lib::String path = entry.path.IsValid() ? priv::PathToUTF8(entry.path.GetPath()) : lib::String();
+
+	priv::DeltaLogRecord record;
+	record.pathID       = entry.pathID;
+	record.assetTypeKey = entry.assetTypeKey;
+	record.isDeleted    = entry.isDeleted ? 1u : 0u;
+	record.pathLength   = static_cast<Uint32>(path.size());
 
+	if (!m_deltaLogStream.is_open())
 	{
-		const lib::ReadLockGuard lock(m_lock);
+		const lib::Path logPath = m_ddc->GetDerivedDataPath(m_deltaLogDDCKey);
+		std::filesystem::create_directories(logPath.parent_path());
 
-		result.reserve(m_descriptors.size());
-		for (const auto& [pathID, runtimeDescriptor] : m_descriptors)
-		{
-			result.emplace_back(AssetMetaData{ .pathID = pathID, .descriptor = runtimeDescriptor.descriptor });
-		}
+		m_deltaLogStream.open(logPath, std::ios::binary | std::ios::app);
+		SPT_CHECK(m_deltaLogStream.is_open());
 	}
 
-	return result;
+	m_deltaLogStream.write(reinterpret_cast<const char*>(&record), sizeof(priv::DeltaLogRecord));
+	m_deltaLogStream.write(path.data(), path.size());
+	m_deltaLogStream.flush();
+
+	++m_deltaLogRecordsNum;
 }
 
-Bool AssetsDB::ContainsAsset(ResourcePathID pathID) const
+Bool AssetsDB::CompactDeltaLog_Locked()
 {
-	const lib::ReadLockGuard lock(m_lock);
+	SPT_PROFILER_FUNCTION();
+
+	AssetsDBSnapshotHandle snapshot = GetCurrentSnapshot();
+
+	if (snapshot->GetBaseStorage())
+	{
+		// New snapshot keeps all assets in delta, so base files are released together with the last snapshot that uses them
+		lib::DynamicArray<assets_db::DeltaEntry> entries;
+		entries.reserve(snapshot->GetAssetsNum());
+
+		snapshot->ForEachAsset([&entries, &snapshot](const AssetMetaData& metaData)
+							   {
+								   entries.emplace_back(assets_db::DeltaEntry{ .pathID = metaData.pathID, .assetTypeKey = metaData.descriptor.assetTypeKey, .path = snapshot->GetPath(metaData.pathID) });
+							   });
+
+		m_detachedBase = snapshot->GetBaseStorage();
 
-	return m_descriptors.contains(pathID);
+		snapshot = std::make_shared<AssetsDBSnapshot>(nullptr, std::move(entries));
+		PublishSnapshot(snapshot);
+	}
+
+	if (!m_detachedBase.expired())
+	{
+		return false;
+	}
+
+	if (!WriteBaseStorage(std::move(snapshot)))
+	{
+		return false;
+	}
+
+	OpenBaseStorage();
+
+	return true;
 }
 
-ResourcePath AssetsDB::GetPath(ResourcePathID pathID) const
+Bool AssetsDB::WriteBaseStorage(AssetsDBSnapshotHandle snapshot)
 {
-	SPT_CHECK(ContainsPathsDB());
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(IsWritable());
+	SPT_CHECK(!!snapshot);
+
+	lib::DynamicArray<assets_db::AssetRecord> records;
+	records.reserve(snapshot->GetAssetsNum());
+
+	lib::String pathsPool;
+
+	snapshot->ForEachAsset([&](const AssetMetaData& metaData)
+						   {
+							   assets_db::AssetRecord record;
+							   record.pathID       = metaData.pathID;
+							   record.assetTypeKey = metaData.descriptor.assetTypeKey;
+
+							   const ResourcePath path = snapshot->GetPath(metaData.pathID);
+							   if (path.IsValid())
+							   {
+								   const lib::String utf8Path = priv::PathToUTF8(path.GetPath());
+								   record.pathOffset = static_cast<Uint32>(pathsPool.size());
+								   record.pathLength = static_cast<Uint32>(utf8Path.size());
+								   pathsPool += utf8Path;
+							   }
 
-	ResourcePath result;
+							   records.emplace_back(record);
+						   });
+
+	// Base files can't be rewritten while they are mapped
+	const lib::WeakPtr<const assets_db::BaseStorage> oldBase = snapshot->GetBaseStorage();
+	snapshot.reset();
+
+	// Retired snapshots that weren't released during publish (because they were read at that time) may still reference base files
+	m_snapshot.TryReclaim();
+
+	if (!oldBase.expired() || !m_detachedBase.expired())
+	{
+		SPT_LOG_WARN(AssetsDB, "Assets database is still referenced. Changes will be merged later");
+		return false;
+	}
 
 	{
-		const lib::ReadLockGuard lock(m_lock);
+		const assets_db::AssetsFileHeader header{ .magic = priv::assetsFileMagic, .version = priv::fileVersion, .descriptorsNum = static_cast<Uint32>(records.size()) };
 
-		auto it = m_paths.find(pathID);
-		if (it != m_paths.end())
+		const SizeType recordsSize = records.size() * sizeof(assets_db::AssetRecord);
+
+		DDCResourceHandle handle = m_ddc->CreateDerivedData(m_assetsDDCKey, sizeof(assets_db::AssetsFileHeader) + recordsSize);
+		std::memcpy(handle.GetMutablePtr(), &header, sizeof(assets_db::AssetsFileHeader));
+		if (recordsSize > 0u)
 		{
-			result = it->second;
+			std::memcpy(handle.GetMutablePtr() + sizeof(assets_db::AssetsFileHeader), records.data(), recordsSize);
 		}
+		handle.FlushWrites();
 	}
 
-	return result;
+	{
+		const assets_db::PathsFileHeader header{ .magic = priv::pathsFileMagic, .version = priv::fileVersion, .poolSize = static_cast<Uint32>(pathsPool.size()) };
+
+		DDCResourceHandle handle = m_ddc->CreateDerivedData(m_pathsDDCKey, sizeof(assets_db::PathsFileHeader) + pathsPool.size());
+		std::memcpy(handle.GetMutablePtr(), &header, sizeof(assets_db::PathsFileHeader));
+		if (!pathsPool.empty())
+		{
+			std::memcpy(handle.GetMutablePtr() + sizeof(assets_db::PathsFileHeader), pathsPool.data(), pathsPool.size());
+		}
+		handle.FlushWrites();
+	}
+
+	// Log can't be deleted while it's open
+	m_deltaLogStream.close();
+	m_ddc->DeleteDerivedData(m_deltaLogDDCKey);
+
+	m_deltaLogRecordsNum       = 0u;
+	m_nextCompactionRecordsNum = deltaLogCompactionThreshold;
+
+	return true;
 }
 
-void AssetsDB::ResizeStorage_Locked(SizeType newSize)
+Bool AssetsDB::ImportLegacyDatabase(lib::DynamicArray<assets_db::DeltaEntry>& outDelta)
 {
-	SPT_CHECK(IsWritable());
+	SPT_PROFILER_FUNCTION();
+
+	const DDCResourceHandle assetsHandle = m_ddc->GetResourceHandle(m_assetsDDCKey);
+	const lib::Span<const Byte> assetsData = assetsHandle.GetImmutableSpan();
 
-	AssetsDBHeader oldHeader = *m_ddcHeader;
-	lib::DynamicArray<PersistentAssetDescriptorData> oldDescriptors(m_ddcDescriptors.begin(), m_ddcDescriptors.begin() + oldHeader.descriptorsNum);
-	lib::DynamicArray<PersistentPathDescriptorData> oldPaths(m_ddcPaths.begin(), m_ddcPaths.begin() + oldHeader.descriptorsNum);
+	if (assetsData.size() < sizeof(priv::LegacyAssetsDBHeader))
+	{
+		return false;
+	}
+
+	priv::LegacyAssetsDBHeader header;
+	std::memcpy(&header, assetsData.data(), sizeof(priv::LegacyAssetsDBHeader));
+
+	if (assetsData.size() < sizeof(priv::LegacyAssetsDBHeader) + header.descriptorsNum * sizeof(priv::LegacyAssetDescriptorData))
+	{
+		return false;
+	}
+
+	DDCResourceHandle pathsHandle;
+	if (m_hasPathsDB && m_ddc->DoesKeyExist(m_pathsDDCKey))
+	{
+		pathsHandle = m_ddc->GetResourceHandle(m_pathsDDCKey);
+	}
 
-	SPT_CHECK(newSize >= oldHeader.descriptorsNum);
+	const SizeType legacyPathsNum = pathsHandle.IsValid() ? pathsHandle.GetSize() / sizeof(priv::LegacyPathDescriptorData) : 0u;
 
-	const DerivedDataKey assetsDDCKey = m_assetsDDCHandle.GetKey();
-	const DerivedDataKey pathsDDCKey  = m_pathsDDCHandle.GetKey();
+	for (Uint32 descriptorIdx = 0u; descriptorIdx < header.descriptorsNum; ++descriptorIdx)
+	{
+		priv::LegacyAssetDescriptorData descriptor;
+		std::memcpy(&descriptor, assetsData.data() + sizeof(priv::LegacyAssetsDBHeader) + descriptorIdx * sizeof(priv::LegacyAssetDescriptorData), sizeof(priv::LegacyAssetDescriptorData));
 
-	m_assetsDDCHandle.Release();
-	m_pathsDDCHandle.Release();
+		assets_db::DeltaEntry entry;
+		entry.pathID       = descriptor.pathID;
+		entry.assetTypeKey = descriptor.assetTypeKey;
 
-	const Uint64 newAssetsDCCTotalSize = sizeof(AssetsDBHeader) + sizeof(PersistentAssetDescriptorData) * newSize;
-	m_assetsDDCHandle = m_ddc->CreateDerivedData(assetsDDCKey, newAssetsDCCTotalSize);
+		if (descriptorIdx < legacyPathsNum)
+		{
+			priv::LegacyPathDescriptorData pathData;
+			std::memcpy(&pathData, pathsHandle.GetImmutablePtr() + descriptorIdx * sizeof(priv::LegacyPathDescriptorData), sizeof(priv::LegacyPathDescriptorData));
+			pathData.path[priv::LegacyPathDescriptorData::s_maxLength - 1u] = L'\0';
 
-	m_ddcHeader      = reinterpret_cast<AssetsDBHeader*>(m_assetsDDCHandle.GetMutablePtr());
-	m_ddcDescriptors = lib::Span<PersistentAssetDescriptorData>(reinterpret_cast<PersistentAssetDescriptorData*>(m_assetsDDCHandle.GetMutablePtr() + sizeof(AssetsDBHeader)), newSize);
+			entry.path = ResourcePath(lib::Path(pathData.path));
+		}
 
-	*m_ddcHeader = oldHeader;
-	std::memcpy(m_ddcDescriptors.data(), oldDescriptors.data(), sizeof(PersistentAssetDescriptorData) * oldHeader.descriptorsNum);
+		priv::UpsertDeltaEntry(outDelta, std::move(entry));
+	}
 
-	const Uint64 newPathsDCCTotalSize = sizeof(PersistentPathDescriptorData) * newSize;
-	m_pathsDDCHandle = m_ddc->CreateDerivedData(pathsDDCKey, newPathsDCCTotalSize);
+	SPT_LOG_INFO(AssetsDB, "Imported {} assets from legacy assets database", header.descriptorsNum);
 
-	m_ddcPaths = lib::Span<PersistentPathDescriptorData>(reinterpret_cast<PersistentPathDescriptorData*>(m_pathsDDCHandle.GetMutablePtr()), newSize);
+	return true;
+}
 
-	std::memcpy(m_ddcPaths.data(), oldPaths.data(), sizeof(PersistentPathDescriptorData) * oldHeader.descriptorsNum);
+void AssetsDB::PublishSnapshot(AssetsDBSnapshotHandle snapshot)
+{
+	m_snapshot.Publish(snapshot ? lib::MakeUnique<AssetsDBSnapshotHandle>(std::move(snapshot)) : nullptr);
+
+	// Retired snapshots keep base files mapped, so they are released as soon as readers can't see them
+	m_snapshot.TryReclaim();
+}
 
-	m_assetsDDCHandle.FlushWrites();
-	m_pathsDDCHandle.FlushWrites();
+AssetsDBSnapshotHandle AssetsDB::GetCurrentSnapshot() const
+{
+	const AssetsDBSnapshotHandle* currentSnapshot = m_snapshot.GetCurrent();
+	return currentSnapshot ? *currentSnapshot : nullptr;
 }
 
 } // spt::as
@@ -4,6 +4,9 @@
 #include "AssetsSystemMacros.h"
 #include "ResourcePath.h"
 #include "SculptorCoreTypes.h"
+#include "Utility/Threading/RCUData.h"
+
+#include <fstream>
 
 
 namespace spt::as
@@ -20,6 +23,8 @@ struct AssetsDBInitInfo
 	DDC&           ddc;
 	DerivedDataKey assetsDDCKey;
 	DerivedDataKey pathsDDCKey;
+	/** Log of changes made since the last compaction. Required for writable databases */
+	DerivedDataKey deltaLogDDCKey;
 };
 
 
@@ -30,34 +35,172 @@ struct AssetMetaData
 };
 
 
-class AssetsDB
+namespace assets_db
 {
-	struct AssetsDBHeader
-	{
-		Uint32 descriptorsNum;
-		Uint32 padding = 0u;
-	};
-	
-	struct PersistentAssetDescriptorData
-	{
-		ResourcePathID pathID;
-		AssetTypeKey   assetTypeKey = 0u;
-	};
 
-	struct RuntimeAssetDescriptor
-	{
-		AssetDescriptor descriptor;
-		Uint32 ddcDescriptorIdx = idxNone<Uint32>;
-	};
+/** Assets database file. Header is followed by records sorted by path ID */
+struct AssetsFileHeader
+{
+	Uint32 magic          = 0u;
+	Uint32 version        = 0u;
+	Uint32 descriptorsNum = 0u;
+	Uint32 padding        = 0u;
+};
 
-	struct PersistentPathDescriptorData
-	{
-		static constexpr Uint32 s_maxLength = 256u;
-		wchar_t path[s_maxLength];
-	};
+struct AssetRecord
+{
+	ResourcePathID pathID       = InvalidResourcePathID;
+	AssetTypeKey   assetTypeKey = 0u;
+	/** Location of UTF-8 path in paths pool */
+	Uint32         pathOffset   = 0u;
+	Uint32         pathLength   = 0u;
+};
+
+/** Paths database file. Header is followed by pool of UTF-8 paths referenced by asset records */
+struct PathsFileHeader
+{
+	Uint32 magic    = 0u;
+	Uint32 version  = 0u;
+	Uint32 poolSize = 0u;
+	Uint32 padding  = 0u;
+};
+
+/** Mapped database files. Shared by all snapshots created before the next compaction */
+struct BaseStorage
+{
+	DDCResourceHandle assetsHandle;
+	DDCResourceHandle pathsHandle;
+
+	lib::Span<const AssetRecord> records;
+	lib::StringView              pathsPool;
+};
+
+/** Change made after the last compaction */
+struct DeltaEntry
+{
+	ResourcePathID pathID       = InvalidResourcePathID;
+	AssetTypeKey   assetTypeKey = 0u;
+	ResourcePath   path;
+	Bool           isDeleted    = false;
+};
+
+/** Immutable run of delta entries sorted by path ID. Chunks are shared by snapshots, so writes don't copy the whole delta */
+struct DeltaChunk
+{
+	lib::DynamicArray<DeltaEntry> entries;
+};
+
+using DeltaChunkHandle = lib::SharedPtr<const DeltaChunk>;
+
+} // assets_db
+
+
+/**
+ * Immutable view of assets database. Queries don't take any locks.
+ * Consists of mapped base files (sorted records) and delta of changes made since they were written.
+ * Delta is stored in chunks that get smaller from the oldest to the newest. Entries in newer chunks override older ones
+ */
+class ASSETS_SYSTEM_API AssetsDBSnapshot
+{
+public:
+
+	AssetsDBSnapshot() = default;
+	AssetsDBSnapshot(lib::SharedPtr<const assets_db::BaseStorage> base, lib::DynamicArray<assets_db::DeltaEntry> delta);
+
+	/** Creates snapshot with entry applied on top of previous snapshot. Shares delta chunks with previous snapshot */
+	AssetsDBSnapshot(const AssetsDBSnapshot& previous, assets_db::DeltaEntry entry);
+
+	std::optional<AssetDescriptor> GetAssetDescriptor(ResourcePathID pathID) const;
 
+	Bool ContainsAsset(ResourcePathID pathID) const;
+
+	/** Returns invalid path if asset doesn't exist or database has no paths */
+	ResourcePath GetPath(ResourcePathID pathID) const;
+
+	SizeType GetAssetsNum() const { return m_assetsNum; }
+
+	/** Visits assets in order of path IDs */
+	template<typename TCallable>
+	void ForEachAsset(TCallable&& callable) const;
+
+	const lib::SharedPtr<const assets_db::BaseStorage>& GetBaseStorage() const { return m_base; }
+
+	Bool HasDelta() const { return !m_deltaChunks.empty(); }
+
+	/** Number of entries in all delta chunks (including entries overridden by newer chunks) */
+	SizeType GetDeltaEntriesNum() const;
+
+private:
+
+	const assets_db::AssetRecord* FindBaseRecord(ResourcePathID pathID) const;
+	const assets_db::DeltaEntry*  FindDeltaEntry(ResourcePathID pathID) const;
+
+	/** Returns the newest delta entry for each path ID, sorted by path ID */
+	lib::DynamicArray<const assets_db::DeltaEntry*> CollectDeltaEntries() const;
+
+	ResourcePath GetBaseRecordPath(const assets_db::AssetRecord& record) const;
+
+	lib::SharedPtr<const assets_db::BaseStorage>    m_base;
+	lib::DynamicArray<assets_db::DeltaChunkHandle> m_deltaChunks;
+
+	SizeType m_assetsNum = 0u;
+};
+
+
+template<typename TCallable>
+void AssetsDBSnapshot::ForEachAsset(TCallable&& callable) const
+{
+	const lib::Span<const assets_db::AssetRecord> baseRecords = m_base ? m_base->records : lib::Span<const assets_db::AssetRecord>{};
+
+	const lib::DynamicArray<const assets_db::DeltaEntry*> delta = CollectDeltaEntries();
+
+	// Merge of two sorted sequences. Delta entries override base records with the same path ID
+	SizeType baseIdx  = 0u;
+	SizeType deltaIdx = 0u;
+
+	while (baseIdx < baseRecords.size() || deltaIdx < delta.size())
+	{
+		const Bool takeDelta = deltaIdx < delta.size() && (baseIdx >= baseRecords.size() || delta[deltaIdx]->pathID <= baseRecords[baseIdx].pathID);
+
+		if (takeDelta)
+		{
+			const assets_db::DeltaEntry& entry = *delta[deltaIdx++];
+
+			if (baseIdx < baseRecords.size() && baseRecords[baseIdx].pathID == entry.pathID)
+			{
+				++baseIdx;
+			}
+
+			if (!entry.isDeleted)
+			{
+				callable(AssetMetaData{ .pathID = entry.pathID, .descriptor = AssetDescriptor{ .assetTypeKey = entry.assetTypeKey } });
+			}
+		}
+		else
+		{
+			const assets_db::AssetRecord& record = baseRecords[baseIdx++];
+			callable(AssetMetaData{ .pathID = record.pathID, .descriptor = AssetDescriptor{ .assetTypeKey = record.assetTypeKey } });
+		}
+	}
+}
+
+
+using AssetsDBSnapshotHandle = lib::SharedPtr<const AssetsDBSnapshot>;
+
+
+/**
+ * Persistent database of compiled assets.
+ * Reads go through immutable snapshots published with read-copy-update, so they never take locks or wait for writers.
+ * Writes append changes to delta log and publish new snapshot (that shares delta chunks with the previous one).
+ * Delta is merged to base files (sorted records and paths pool) on initialization, shutdown and when delta log gets too long
+ */
+class ASSETS_SYSTEM_API AssetsDB
+{
 public:
 
+	/** Number of delta log records after which delta is merged to base files */
+	static constexpr SizeType deltaLogCompactionThreshold = 4096u;
+
 	AssetsDB();
 
 	void Initalize(const AssetsDBInitInfo& initInfo);
@@ -66,6 +209,9 @@ public:
 	void SaveAssetDescriptor(const ResourcePath& assetPath, const AssetDescriptor& descriptor);
 	void DeleteAssetDescriptor(ResourcePathID pathID);
 
+	/** Snapshot stays valid and unchanged even if database is modified */
+	AssetsDBSnapshotHandle GetSnapshot() const;
+
 	std::optional<AssetDescriptor> GetAssetDescriptor(ResourcePathID pathID) const;
 
 	lib::DynamicArray<AssetMetaData> GetAllAssetsDescriptors() const;
@@ -75,29 +221,58 @@ public:
 	// Returns valid path only to compiled assets
 	ResourcePath GetPath(ResourcePathID pathID) const;
 
-	Bool ContainsPathsDB() const { return m_pathsDDCHandle.IsValid(); }
+	Bool ContainsPathsDB() const { return m_hasPathsDB; }
 
-	Bool IsWritable() const { return ContainsPathsDB(); }
+	Bool IsWritable() const { return ContainsPathsDB() && m_deltaLogDDCKey.IsValid(); }
 
 private:
 
-	void ResizeStorage_Locked(SizeType newSize);
+	void OpenBaseStorage();
+	void ReplayDeltaLog(lib::DynamicArray<assets_db::DeltaEntry>& outDelta) const;
+
+	/** Appends entry to delta log and publishes snapshot with the entry applied */
+	void ApplyDeltaEntry_Locked(AssetsDBSnapshotHandle snapshot, assets_db::DeltaEntry entry);
+	void AppendToDeltaLog_Locked(const assets_db::DeltaEntry& entry);
+
+	/**
+	 * Merges delta to base files.
+	 * Base files are detached from current snapshot, so they can be rewritten once older snapshots are released. Returns false if they are still referenced
+	 */
+	Bool CompactDeltaLog_Locked();
+
+	/** Writes all assets from snapshot to new base files and clears delta log. Skipped if base files are still referenced by other snapshots */
+	Bool WriteBaseStorage(AssetsDBSnapshotHandle snapshot);
+
+	/** Reads database written in format that used fixed size path records */
+	Bool ImportLegacyDatabase(lib::DynamicArray<assets_db::DeltaEntry>& outDelta);
+
+	/** Writers only. Publishes new snapshot and releases retired snapshots that can't be read anymore */
+	void PublishSnapshot(AssetsDBSnapshotHandle snapshot);
+
+	/** Writers only */
+	AssetsDBSnapshotHandle GetCurrentSnapshot() const;
 
-	mutable lib::ReadWriteLock m_lock;
+	/** Handle of the current snapshot. Readers copy handle (or query snapshot) in read scope, so retired handles are destroyed only after readers finish */
+	lib::RCUData<AssetsDBSnapshotHandle> m_snapshot;
 
-	lib::HashMap<ResourcePathID, RuntimeAssetDescriptor> m_descriptors;
+	/** Serializes writers. Readers never take it */
+	lib::Lock m_writeLock;
 
-	DDC*              m_ddc = nullptr;
-	DDCResourceHandle m_assetsDDCHandle;
+	DDC*           m_ddc = nullptr;
+	DerivedDataKey m_assetsDDCKey;
+	DerivedDataKey m_pathsDDCKey;
+	DerivedDataKey m_deltaLogDDCKey;
 
-	AssetsDBHeader*                          m_ddcHeader = nullptr;
-	lib::Span<PersistentAssetDescriptorData> m_ddcDescriptors;
+	/** Kept open between writes. Closed when log is deleted */
+	std::ofstream m_deltaLogStream;
 
+	SizeType m_deltaLogRecordsNum       = 0u;
+	SizeType m_nextCompactionRecordsNum = deltaLogCompactionThreshold;
 
-	lib::HashMap<ResourcePathID, ResourcePath> m_paths;
+	/** Base storage that isn't referenced by current snapshot anymore, but can be still mapped by older snapshots */
+	lib::WeakPtr<const assets_db::BaseStorage> m_detachedBase;
 
-	DDCResourceHandle                       m_pathsDDCHandle;
-	lib::Span<PersistentPathDescriptorData> m_ddcPaths;
+	Bool m_hasPathsDB = false;
 };
 
 } // spt::as
@@ -11,6 +11,128 @@ SPT_DEFINE_LOG_CATEGORY(AssetsSystem, true);
 namespace spt::as
 {
 
+namespace priv
+{
+
+static AssetDerivedDataKey CreateCompiledAssetDataKey(ResourcePathID pathID)
+{
+	static const lib::HashedString compiledAssetDataName = "CompiledAssetData";
+	return AssetDerivedDataKey(pathID, compiledAssetDataName);
+}
+
+
+struct BatchCompilationNode
+{
+	ResourcePath path;
+
+	/** Data is read when building dependency graph and reused by compilation */
+	std::optional<AssetInstanceData> assetData;
+
+	lib::DynamicArray<SizeType> dependencies;
+
+	Bool isMissing           = false;
+	Bool requiresCompilation = false;
+
+	js::Job job;
+
+	Bool   succeeded  = false;
+	Real32 durationMs = 0.f;
+};
+
+
+static lib::DynamicArray<SizeType> SortNodesTopologically(const lib::DynamicArray<BatchCompilationNode>& nodes)
+{
+	lib::DynamicArray<Uint32>                      remainingDependenciesNum(nodes.size(), 0u);
+	lib::DynamicArray<lib::DynamicArray<SizeType>> dependents(nodes.size());
+
+	for (SizeType nodeIdx = 0u; nodeIdx < nodes.size(); ++nodeIdx)
+	{
+		for (const SizeType dependencyIdx : nodes[nodeIdx].dependencies)
+		{
+			++remainingDependenciesNum[nodeIdx];
+			dependents[dependencyIdx].emplace_back(nodeIdx);
+		}
+	}
+
+	lib::DynamicArray<SizeType> order;
+	order.reserve(nodes.size());
+
+	for (SizeType nodeIdx = 0u; nodeIdx < nodes.size(); ++nodeIdx)
+	{
+		if (remainingDependenciesNum[nodeIdx] == 0u)
+		{
+			order.emplace_back(nodeIdx);
+		}
+	}
+
+	for (SizeType orderIdx = 0u; orderIdx < order.size(); ++orderIdx)
+	{
+		for (const SizeType dependentIdx : dependents[order[orderIdx]])
+		{
+			if (--remainingDependenciesNum[dependentIdx] == 0u)
+			{
+				order.emplace_back(dependentIdx);
+			}
+		}
+	}
+
+	// Nodes that are left are part of dependency cycle. They are still compiled, but order between them is not guaranteed
+	for (SizeType nodeIdx = 0u; nodeIdx < nodes.size(); ++nodeIdx)
+	{
+		if (remainingDependenciesNum[nodeIdx] > 0u)
+		{
+			SPT_LOG_ERROR(AssetsSystem, "Asset '{}' is part of compilation dependency cycle", nodes[nodeIdx].path.GetPath().generic_string());
+			order.emplace_back(nodeIdx);
+		}
+	}
+
+	return order;
+}
+
+} // priv
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// AssetLoadRequest ==============================================================================
+
+AssetLoadRequest::AssetLoadRequest(ResourcePathID pathID, Real32 priority)
+	: m_pathID(pathID)
+	, m_priority(priority)
+	, m_finished(false)
+	, m_finishedEvent(js::CreateEvent("Asset Load Request Finished"))
+	, m_result(ELoadError::DoesNotExist)
+{ }
+
+void AssetLoadRequest::Wait() const
+{
+	SPT_PROFILER_FUNCTION();
+
+	m_finishedEvent.Wait();
+}
+
+const LoadResult<>& AssetLoadRequest::GetResult() const
+{
+	SPT_CHECK(IsFinished());
+	return m_result;
+}
+
+const AssetLoadTimings& AssetLoadRequest::GetTimings() const
+{
+	SPT_CHECK(IsFinished());
+	return m_timings;
+}
+
+void AssetLoadRequest::Finish(LoadResult<> result)
+{
+	SPT_CHECK(!IsFinished());
+
+	m_result = std::move(result);
+	m_finished.store(true);
+	m_finishedEvent.Signal();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// AssetsSystem ==================================================================================
+
 AssetsSystem::AssetsSystem() = default;
 
 AssetsSystem::~AssetsSystem() = default;
@@ -22,14 +144,17 @@ Bool AssetsSystem::Initialize(const AssetsSystemInitializer& initializer)
 	m_contentPath = initializer.contentPath;
 	m_flags       = initializer.flags;
 
+	m_maxConcurrentLoads = std::max(initializer.maxConcurrentLoads, 1u);
+
 	m_ddc.Initialize({ .path = initializer.ddcPath });
 
 	AssetsDBInitInfo dbInitInfo
 	{
-		.ddc          = m_ddc,
+		.ddc            = m_ddc,
 
-		.assetsDDCKey = DerivedDataKey(idxNone<Uint64>, 0u),
-		.pathsDDCKey  = DerivedDataKey(idxNone<Uint64>, 1u)
+		.assetsDDCKey   = DerivedDataKey(idxNone<Uint64>, 0u),
+		.pathsDDCKey    = DerivedDataKey(idxNone<Uint64>, 1u),
+		.deltaLogDDCKey = DerivedDataKey(idxNone<Uint64>, 2u)
 	};
 
 	m_assetsDB.Initalize(dbInitInfo);
@@ -44,6 +169,8 @@ Bool AssetsSystem::Initialize(const AssetsSystemInitializer& initializer)
 
 void AssetsSystem::Shutdown()
 {
+	FlushLoadRequests();
+
 	UnloadPermanentAssets();
 
 	{
@@ -74,6 +201,7 @@ CreateResult AssetsSystem::CreateAsset(const AssetInitializer& initializer)
 		if (IsAssetCompiled(pathID))
 		{
 			m_ddc.DeleteDerivedData(AssetDerivedDataKey(pathID));
+			DeleteCompiledAssetData(pathID);
 			m_assetsDB.DeleteAssetDescriptor(pathID);
 		}
 
@@ -116,72 +244,8 @@ LoadResult<> AssetsSystem::LoadAsset(ResourcePathID pathID)
 {
 	SPT_PROFILER_FUNCTION();
 
-	if (pathID == InvalidResourcePathID)
-	{
-		return LoadResult(ELoadError::DoesNotExist);
-	}
-
-	AssetHandle assetInstance;
-
-	{
-		lib::LockGuard lock(m_assetsSystemLock);
-
-		{
-			const auto it = m_loadedAssets.find(pathID);
-			if (it != m_loadedAssets.end())
-			{
-				return LoadResult(AssetHandle(it->second));
-			}
-		}
-	
-		AssetInstanceData assetData;
-		if (IsCompiledOnlyMode())
-		{
-			const std::optional<AssetDescriptor> descriptor = m_assetsDB.GetAssetDescriptor(pathID);
-			if (!descriptor)
-			{
-				return LoadResult(ELoadError::DoesNotExist);
-			}
-	
-			assetData.type = AssetFactory::GetInstance().GetAssetTypeByKey(descriptor->assetTypeKey);
-		}
-		else
-		{
-			const ResourcePath path = ResolvePath(pathID);
-			SPT_CHECK(path.IsValid());
-
-			const lib::Path fullPath = m_contentPath / path.GetPath();
-	
-			if (!std::filesystem::exists(fullPath))
-			{
-				return LoadResult(ELoadError::DoesNotExist);
-			}
-	
-			assetData = ReadAssetData(fullPath);
-		}
-	
-		assetInstance = CreateAssetInstance(AssetInstanceDefinition
-											{
-												.type   = assetData.type,
-												.name   = CreateAssetName(pathID),
-												.pathID = pathID,
-											});
-	
-		if (!assetInstance.IsValid())
-		{
-			return ELoadError::FailedToCreateInstance;
-		}
-	
-		m_loadedAssets[pathID] = assetInstance.Get();
-	
-		assetInstance->AssignData(std::move(assetData));
-	}
-
-	SPT_CHECK(assetInstance.IsValid());
-
-	ScheduleAssetInitialization(assetInstance);
-
-	return LoadResult(AssetHandle(std::move(assetInstance)));
+	AssetLoadTimings timings;
+	return LoadAssetImpl(pathID, timings);
 }
 
 AssetHandle AssetsSystem::LoadAssetChecked(ResourcePathID pathID)
@@ -201,12 +265,67 @@ AssetHandle AssetsSystem::LoadAndInitAssetChecked(ResourcePathID pathID)
 	return asset;
 }
 
+AssetLoadRequestHandle AssetsSystem::RequestLoad(ResourcePathID pathID, Real32 priority /*= 0.f*/)
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lock(m_loadRequestsLock);
+
+	const auto it = m_activeLoadRequests.find(pathID);
+	if (it != m_activeLoadRequests.end())
+	{
+		// Asset is already being loaded. Merged request uses the most important priority
+		AssetLoadRequest& request = *it->second;
+		request.SetPriority(std::min(request.GetPriority(), priority));
+		return it->second;
+	}
+
+	AssetLoadRequestHandle request = new AssetLoadRequest(pathID, priority);
+
+	m_activeLoadRequests.emplace(pathID, request);
+	m_pendingLoadRequests.emplace_back(request);
+
+	DispatchLoadRequests_Locked();
+
+	return request;
+}
+
+void AssetsSystem::FlushLoadRequests()
+{
+	SPT_PROFILER_FUNCTION();
+
+	while (true)
+	{
+		lib::DynamicArray<AssetLoadRequestHandle> activeRequests;
+
+		{
+			const lib::LockGuard lock(m_loadRequestsLock);
+
+			activeRequests.reserve(m_activeLoadRequests.size());
+			for (const auto& [pathID, request] : m_activeLoadRequests)
+			{
+				activeRequests.emplace_back(request);
+			}
+		}
+
+		if (activeRequests.empty())
+		{
+			break;
+		}
+
+		for (const AssetLoadRequestHandle& request : activeRequests)
+		{
+			request->Wait();
+		}
+	}
+}
+
 AssetHandle AssetsSystem::GetLoadedAsset(ResourcePathID pathID) const
 {
 	AssetHandle result;
 
 	{
-		lib::LockGuard lock(m_assetsSystemLock);
+		const lib::ReadLockGuard lock(m_assetsSystemLock);
 
 		const auto it = m_loadedAssets.find(pathID);
 		if (it != m_loadedAssets.end())
@@ -235,6 +354,215 @@ Bool AssetsSystem::CompileAssetIfDeprecated(const ResourcePath& path)
 	return true;
 }
 
+Bool AssetsSystem::RecompileAsset(const AssetHandle& asset)
+{
+	SPT_CHECK(asset.IsValid());
+
+	if (IsCompiledOnlyMode())
+	{
+		return false;
+	}
+
+	return CompileAssetImpl(asset);
+}
+
+AssetsBatchCompilationResult AssetsSystem::CompileAssets(lib::Span<const ResourcePath> paths)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(!IsCompiledOnlyMode());
+
+	lib::TickingTimer timer;
+
+	lib::DynamicArray<priv::BatchCompilationNode> nodes;
+	lib::HashMap<ResourcePathID, SizeType>        pathToNodeIdx;
+
+	const auto getOrCreateNode = [&nodes, &pathToNodeIdx](const ResourcePath& path) -> SizeType
+	{
+		const auto [it, inserted] = pathToNodeIdx.emplace(path.GetID(), nodes.size());
+		if (inserted)
+		{
+			nodes.emplace_back().path = path;
+		}
+		return it->second;
+	};
+
+	for (const ResourcePath& path : paths)
+	{
+		getOrCreateNode(path);
+	}
+
+	{
+		SPT_PROFILER_SCOPE("Build Dependency Graph");
+
+		const AssetFactory& factory = AssetFactory::GetInstance();
+
+		lib::DynamicArray<ResourcePath> dependencies;
+
+		// Nodes created for dependencies are appended and processed by the same loop
+		for (SizeType nodeIdx = 0u; nodeIdx < nodes.size(); ++nodeIdx)
+		{
+			const ResourcePath path = nodes[nodeIdx].path;
+
+			if (!DoesAssetExist(path))
+			{
+				SPT_LOG_ERROR(AssetsSystem, "Failed to compile asset: {} (asset doesn't exist)", path.GetPath().string());
+				nodes[nodeIdx].isMissing = true;
+				continue;
+			}
+
+			if (IsAssetCompiled(path.GetID()) && IsAssetUpToDate(path))
+			{
+				continue;
+			}
+
+			AssetInstanceData assetData = ReadAssetData(m_contentPath / path.GetPath());
+
+			dependencies.clear();
+			factory.CollectCompilationDependencies(assetData.type, path, assetData, dependencies);
+
+			for (const ResourcePath& dependency : dependencies)
+			{
+				const SizeType dependencyIdx = getOrCreateNode(dependency);
+				if (dependencyIdx != nodeIdx)
+				{
+					nodes[nodeIdx].dependencies.emplace_back(dependencyIdx);
+				}
+			}
+
+			nodes[nodeIdx].requiresCompilation = true;
+			nodes[nodeIdx].assetData           = std::move(assetData);
+		}
+	}
+
+	const lib::DynamicArray<SizeType> order = priv::SortNodesTopologically(nodes);
+
+	for (const SizeType nodeIdx : order)
+	{
+		priv::BatchCompilationNode& node = nodes[nodeIdx];
+
+		if (!node.requiresCompilation)
+		{
+			continue;
+		}
+
+		lib::DynamicArray<lib::MTHandle<js::JobInstance>> prerequisites;
+		for (const SizeType dependencyIdx : node.dependencies)
+		{
+			if (nodes[dependencyIdx].job.IsValid())
+			{
+				prerequisites.emplace_back(nodes[dependencyIdx].job.GetJobInstance());
+			}
+		}
+
+		node.job = js::Launch("Compile Asset",
+							  [this, &node]
+							  {
+								  lib::TickingTimer compilationTimer;
+
+								  // Loading deprecated asset compiles it as part of its initialization
+								  AssetLoadTimings loadTimings;
+								  const LoadResult<> loadResult = LoadAssetImpl(node.path.GetID(), loadTimings, std::move(node.assetData));
+								  if (loadResult.HasValue())
+								  {
+									  loadResult.GetValue()->AwaitInitialization();
+								  }
+
+								  node.succeeded  = IsAssetCompiled(node.path.GetID()) && IsAssetUpToDate(node.path);
+								  node.durationMs = compilationTimer.Tick() * 1000.f;
+							  },
+							  std::move(prerequisites));
+	}
+
+	for (const priv::BatchCompilationNode& node : nodes)
+	{
+		node.job.Wait();
+	}
+
+	AssetsBatchCompilationResult result;
+
+	// Nodes are visited in topological order, so finish times of dependencies are already known
+	lib::DynamicArray<Real32>   finishTimesMs(nodes.size(), 0.f);
+	lib::DynamicArray<SizeType> criticalDependencies(nodes.size(), idxNone<SizeType>);
+	SizeType criticalPathEnd = idxNone<SizeType>;
+
+	for (const SizeType nodeIdx : order)
+	{
+		const priv::BatchCompilationNode& node = nodes[nodeIdx];
+
+		if (node.isMissing || (node.requiresCompilation && !node.succeeded))
+		{
+			++result.failedAssetsNum;
+		}
+		else if (node.requiresCompilation)
+		{
+			++result.compiledAssetsNum;
+		}
+		else
+		{
+			++result.upToDateAssetsNum;
+		}
+
+		Real32 startTimeMs = 0.f;
+		for (const SizeType dependencyIdx : node.dependencies)
+		{
+			if (finishTimesMs[dependencyIdx] > startTimeMs)
+			{
+				startTimeMs                   = finishTimesMs[dependencyIdx];
+				criticalDependencies[nodeIdx] = dependencyIdx;
+			}
+		}
+
+		finishTimesMs[nodeIdx] = startTimeMs + node.durationMs;
+
+		if (criticalPathEnd == idxNone<SizeType> || finishTimesMs[nodeIdx] > finishTimesMs[criticalPathEnd])
+		{
+			criticalPathEnd = nodeIdx;
+		}
+	}
+
+	if (criticalPathEnd != idxNone<SizeType>)
+	{
+		result.criticalPathMs = finishTimesMs[criticalPathEnd];
+
+		for (SizeType nodeIdx = criticalPathEnd; nodeIdx != idxNone<SizeType>; nodeIdx = criticalDependencies[nodeIdx])
+		{
+			result.criticalPath.emplace_back(nodes[nodeIdx].path);
+		}
+
+		std::reverse(result.criticalPath.begin(), result.criticalPath.end());
+	}
+
+	result.totalTimeMs = timer.Tick() * 1000.f;
+
+	SPT_LOG_INFO(AssetsSystem, "Batch compilation finished in {:.2f} ms (compiled: {}, up to date: {}, failed: {}). Critical path: {:.2f} ms ({} assets)",
+				 result.totalTimeMs, result.compiledAssetsNum, result.upToDateAssetsNum, result.failedAssetsNum, result.criticalPathMs, result.criticalPath.size());
+
+	return result;
+}
+
+lib::DynamicArray<ResourcePath> AssetsSystem::GetAllContentAssets() const
+{
+	SPT_PROFILER_FUNCTION();
+
+	lib::DynamicArray<ResourcePath> assets;
+
+	if (!std::filesystem::exists(m_contentPath))
+	{
+		return assets;
+	}
+
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(m_contentPath))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".sptasset")
+		{
+			assets.emplace_back(std::filesystem::relative(entry.path(), m_contentPath));
+		}
+	}
+
+	return assets;
+}
+
 EDeleteResult AssetsSystem::DeleteAsset(const ResourcePath& path)
 {
 	SPT_PROFILER_FUNCTION();
@@ -264,6 +592,7 @@ EDeleteResult AssetsSystem::DeleteAsset(const ResourcePath& path)
 	AssetFactory& factory = AssetFactory::GetInstance();
 	factory.DeleteAsset(assetData.type, *this, path, assetData);
 	m_ddc.DeleteDerivedData(AssetDerivedDataKey(path.GetID()));
+	DeleteCompiledAssetData(path.GetID());
 	m_assetsDB.DeleteAssetDescriptor(path);
 
 	SPT_CHECK(!IsAssetCompiled(path.GetID())); // Derived data left?
@@ -287,7 +616,7 @@ Bool AssetsSystem::DoesAssetExist(const ResourcePath& path) const
 
 Bool AssetsSystem::IsLoaded(ResourcePathID pathID) const
 {
-	lib::LockGuard lock(m_assetsSystemLock);
+	const lib::ReadLockGuard lock(m_assetsSystemLock);
 
 	return IsLoaded_Locked(pathID);
 }
@@ -367,6 +696,7 @@ void AssetsSystem::RemoveAssetCompiledData(ResourcePathID pathID)
 
 	m_assetsDB.DeleteAssetDescriptor(pathID);
 	m_ddc.DeleteDerivedData(AssetDerivedDataKey(pathID));
+	DeleteCompiledAssetData(pathID);
 }
 
 void AssetsSystem::RemoveAssetsCompiledDataByType(AssetType type)
@@ -490,6 +820,233 @@ AssetInstanceData AssetsSystem::ReadAssetData(const lib::Path& fullPath) const
 	return assetData;
 }
 
+std::optional<AssetInstanceData> AssetsSystem::ReadAssetDataForLoad(ResourcePathID pathID) const
+{
+	SPT_PROFILER_FUNCTION();
+
+	AssetInstanceData assetData;
+
+	if (IsCompiledOnlyMode())
+	{
+		const std::optional<AssetDescriptor> descriptor = m_assetsDB.GetAssetDescriptor(pathID);
+		if (!descriptor)
+		{
+			return std::nullopt;
+		}
+
+		if (std::optional<AssetInstanceData> compiledData = ReadCompiledAssetData(pathID))
+		{
+			assetData = std::move(*compiledData);
+		}
+
+		assetData.type = AssetFactory::GetInstance().GetAssetTypeByKey(descriptor->assetTypeKey);
+	}
+	else
+	{
+		const ResourcePath path = ResolvePath(pathID);
+		SPT_CHECK(path.IsValid());
+
+		const lib::Path fullPath = m_contentPath / path.GetPath();
+
+		if (!std::filesystem::exists(fullPath))
+		{
+			return std::nullopt;
+		}
+
+		assetData = ReadAssetData(fullPath);
+	}
+
+	return assetData;
+}
+
+void AssetsSystem::SaveCompiledAssetData(const AssetHandle& asset)
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::DynamicArray<Byte> data = srl::SerializationHelper::SerializeStructBinary(asset->GetInstanceData());
+	m_ddc.CreateDerivedData(priv::CreateCompiledAssetDataKey(asset->GetResourcePathID()), data);
+}
+
+std::optional<AssetInstanceData> AssetsSystem::ReadCompiledAssetData(ResourcePathID pathID) const
+{
+	SPT_PROFILER_FUNCTION();
+
+	const AssetDerivedDataKey key = priv::CreateCompiledAssetDataKey(pathID);
+
+	if (!m_ddc.DoesKeyExist(key))
+	{
+		return std::nullopt;
+	}
+
+	const DDCResourceHandle handle = m_ddc.GetResourceHandle(key);
+	if (!handle.IsValid())
+	{
+		return std::nullopt;
+	}
+
+	AssetInstanceData assetData;
+	if (!srl::SerializationHelper::DeserializeStructBinary(assetData, handle.GetImmutableSpan()))
+	{
+		SPT_LOG_WARN(AssetsSystem, "Compiled asset data has invalid format (path ID: {})", pathID);
+		return std::nullopt;
+	}
+
+	return assetData;
+}
+
+void AssetsSystem::DeleteCompiledAssetData(ResourcePathID pathID)
+{
+	m_ddc.DeleteDerivedData(priv::CreateCompiledAssetDataKey(pathID));
+}
+
+LoadResult<> AssetsSystem::LoadAssetImpl(ResourcePathID pathID, AssetLoadTimings& outTimings, std::optional<AssetInstanceData> assetData /*= std::nullopt*/)
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (pathID == InvalidResourcePathID)
+	{
+		return LoadResult(ELoadError::DoesNotExist);
+	}
+
+	{
+		AssetHandle loadedAsset = GetLoadedAsset(pathID);
+		if (loadedAsset.IsValid())
+		{
+			return LoadResult(std::move(loadedAsset));
+		}
+	}
+
+	lib::TickingTimer timer;
+
+	// Reading and parsing asset file is the most expensive part of loading, so it's done without holding the lock
+	if (!assetData)
+	{
+		assetData = ReadAssetDataForLoad(pathID);
+	}
+
+	outTimings.readMs = timer.Tick() * 1000.f;
+
+	if (!assetData)
+	{
+		return LoadResult(ELoadError::DoesNotExist);
+	}
+
+	AssetHandle assetInstance;
+
+	{
+		SPT_PROFILER_SCOPE("Create Asset Instance");
+
+		lib::LockGuard lock(m_assetsSystemLock);
+
+		// Asset could be loaded by other thread while its data was read
+		const auto it = m_loadedAssets.find(pathID);
+		if (it != m_loadedAssets.end())
+		{
+			return LoadResult(AssetHandle(it->second));
+		}
+
+		assetInstance = CreateAssetInstance(AssetInstanceDefinition
+											{
+												.type   = assetData->type,
+												.name   = CreateAssetName(pathID),
+												.pathID = pathID,
+											});
+
+		if (!assetInstance.IsValid())
+		{
+			return LoadResult(ELoadError::FailedToCreateInstance);
+		}
+
+		m_loadedAssets[pathID] = assetInstance.Get();
+
+		assetInstance->AssignData(std::move(*assetData));
+	}
+
+	SPT_CHECK(assetInstance.IsValid());
+
+	ScheduleAssetInitialization(assetInstance);
+
+	outTimings.createMs = timer.Tick() * 1000.f;
+
+	return LoadResult(AssetHandle(std::move(assetInstance)));
+}
+
+void AssetsSystem::DispatchLoadRequests_Locked()
+{
+	while (m_activeLoadsNum < m_maxConcurrentLoads && !m_pendingLoadRequests.empty())
+	{
+		// Priorities can change while requests are queued, so queue is not kept sorted
+		const auto mostImportantRequest = std::min_element(m_pendingLoadRequests.begin(), m_pendingLoadRequests.end(),
+														   [](const AssetLoadRequestHandle& lhs, const AssetLoadRequestHandle& rhs)
+														   {
+															   return lhs->GetPriority() < rhs->GetPriority();
+														   });
+
+		std::iter_swap(mostImportantRequest, std::prev(m_pendingLoadRequests.end()));
+		AssetLoadRequestHandle request = std::move(m_pendingLoadRequests.back());
+		m_pendingLoadRequests.pop_back();
+
+		++m_activeLoadsNum;
+
+		js::Launch("Load Asset",
+				   [this, request]
+				   {
+					   ProcessLoadRequest(request);
+				   });
+	}
+}
+
+void AssetsSystem::ProcessLoadRequest(const AssetLoadRequestHandle& request)
+{
+	SPT_PROFILER_FUNCTION();
+
+	request->m_timings.queuedMs = request->m_timer.Tick() * 1000.f;
+
+	LoadResult<> result = LoadAssetImpl(request->GetPathID(), request->m_timings);
+
+	// Load slot is released before initialization, as initialization is already scheduled as separate job
+	{
+		const lib::LockGuard lock(m_loadRequestsLock);
+		--m_activeLoadsNum;
+		DispatchLoadRequests_Locked();
+	}
+
+	request->m_timer.Tick();
+
+	const js::Job initializationJob = result.HasValue() ? result.GetValue()->GetInitializationJob() : js::Job();
+	if (initializationJob.IsValid())
+	{
+		js::Launch("Finish Asset Load Request",
+				   [this, request, result]
+				   {
+					   FinishLoadRequest(request, result);
+				   },
+				   js::Prerequisites(initializationJob));
+	}
+	else
+	{
+		FinishLoadRequest(request, std::move(result));
+	}
+}
+
+void AssetsSystem::FinishLoadRequest(const AssetLoadRequestHandle& request, LoadResult<> result)
+{
+	SPT_PROFILER_FUNCTION();
+
+	AssetLoadTimings& timings = request->m_timings;
+	timings.initializationMs = request->m_timer.Tick() * 1000.f;
+
+	SPT_LOG_TRACE(AssetsSystem, "Asset load request {} finished (queued: {:.2f} ms, read: {:.2f} ms, create: {:.2f} ms, initialization: {:.2f} ms)",
+				  request->GetPathID(), timings.queuedMs, timings.readMs, timings.createMs, timings.initializationMs);
+
+	{
+		const lib::LockGuard lock(m_loadRequestsLock);
+		m_activeLoadRequests.erase(request->GetPathID());
+	}
+
+	request->Finish(std::move(result));
+}
+
 AssetHandle AssetsSystem::CreateAssetInstance(const AssetInstanceDefinition& definition)
 {
 	AssetFactory& factory = AssetFactory::GetInstance();
@@ -552,13 +1109,16 @@ Bool AssetsSystem::CompileAssetImpl(const AssetHandle& asset)
 {
 	SPT_PROFILER_FUNCTION();
 
-	m_compilationInputCache.OnCompilationStarted();
+	// Inputs read by this compilation are released when it finishes, unless other compilations still use them
+	const CompilationInputCache::CompilationScope inputsScope(m_compilationInputCache);
+
 	SPT_LOG_INFO(AssetsSystem, "Compiling asset: {}", ResolvePath(asset->GetResourcePathID()).GetPath().string());
 
 	const Bool compilationResult = asset->Compile();
 
 	if (compilationResult)
 	{
+		SaveCompiledAssetData(asset);
 		m_assetsDB.SaveAssetDescriptor(ResolvePath(asset->GetResourcePathID()), AssetDescriptor{ .assetTypeKey = asset->GetTypeKey() });
 		SPT_LOG_INFO(AssetsSystem, "Successfully compiled asset: {}", ResolvePath(asset->GetResourcePathID()).GetPath().string());
 	}
@@ -567,8 +1127,6 @@ Bool AssetsSystem::CompileAssetImpl(const AssetHandle& asset)
 		SPT_LOG_ERROR(AssetsSystem, "Failed to compile asset: {}", ResolvePath(asset->GetResourcePathID()).GetPath().string());
 	}
 
-	m_compilationInputCache.OnCompilationFinished();
-
 	return compilationResult;
 }
 
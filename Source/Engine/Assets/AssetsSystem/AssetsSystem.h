@@ -9,6 +9,7 @@
 #include "DDC.h"
 #include "CompilationInputCache.h"
 #include "AssetsDB.h"
+#include "Timer/TickingTimer.h"
 
 
 namespace spt::as
@@ -33,6 +34,9 @@ struct AssetsSystemInitializer
 	lib::Path ddcPath;
 
 	EAssetsSystemFlags flags = EAssetsSystemFlags::Default;
+
+	/** Max number of asynchronous load requests that read asset data at the same time */
+	Uint32 maxConcurrentLoads = 4u;
 };
 
 
@@ -82,6 +86,73 @@ inline const char* AssetLoadErrorToString(ELoadError error)
 
 
 
+struct AssetLoadTimings
+{
+	/** Time spent in queue, waiting for free load slot */
+	Real32 queuedMs         = 0.f;
+	/** Reading and deserializing asset data. Done without holding assets system lock */
+	Real32 readMs           = 0.f;
+	/** Creating asset instance and registering it as loaded */
+	Real32 createMs         = 0.f;
+	/** Compilation (if asset was deprecated) and initialization */
+	Real32 initializationMs = 0.f;
+};
+
+
+struct AssetsBatchCompilationResult
+{
+	Uint32 compiledAssetsNum = 0u;
+	Uint32 upToDateAssetsNum = 0u;
+	Uint32 failedAssetsNum   = 0u;
+
+	Real32 totalTimeMs    = 0.f;
+	/** Duration of the longest chain of dependent compilations. Batch can't be finished faster regardless of number of workers */
+	Real32 criticalPathMs = 0.f;
+	/** Assets on critical path, starting with the one that was compiled first */
+	lib::DynamicArray<ResourcePath> criticalPath;
+};
+
+
+class ASSETS_SYSTEM_API AssetLoadRequest : public lib::MTRefCounted
+{
+public:
+
+	AssetLoadRequest(ResourcePathID pathID, Real32 priority);
+
+	ResourcePathID GetPathID() const { return m_pathID; }
+
+	/** Lower value means that asset is loaded earlier. Changing priority affects only requests that are still queued */
+	void   SetPriority(Real32 priority) { m_priority.store(priority); }
+	Real32 GetPriority() const          { return m_priority.load(); }
+
+	/** Request is finished when asset is loaded and initialized, or when load failed */
+	Bool IsFinished() const { return m_finished.load(); }
+	void Wait() const;
+
+	/** Can be accessed only when request is finished */
+	const LoadResult<>&     GetResult() const;
+	const AssetLoadTimings& GetTimings() const;
+
+private:
+
+	void Finish(LoadResult<> result);
+
+	ResourcePathID      m_pathID;
+	std::atomic<Real32> m_priority;
+	std::atomic<Bool>   m_finished;
+	js::Event           m_finishedEvent;
+
+	LoadResult<>        m_result;
+	AssetLoadTimings    m_timings;
+	lib::TickingTimer   m_timer;
+
+	friend class AssetsSystem;
+};
+
+using AssetLoadRequestHandle = lib::MTHandle<AssetLoadRequest>;
+
+
+
 class ASSETS_SYSTEM_API AssetsSystem
 {
 public:
@@ -117,6 +188,15 @@ public:
 
 	AssetHandle LoadAndInitAssetChecked(ResourcePathID pathID);
 
+	/**
+	 * Asynchronously loads and initializes asset. Requests are processed in priority order (lower value first) with limited number of concurrent loads.
+	 * Requesting asset that is already being loaded returns existing request
+	 */
+	AssetLoadRequestHandle RequestLoad(ResourcePathID pathID, Real32 priority = 0.f);
+
+	/** Waits until all asynchronous load requests are finished */
+	void FlushLoadRequests();
+
 	template<typename TAssetType>
 	TypedAssetHandle<TAssetType> LoadAndInitAssetChecked(ResourcePathID pathID)
 	{
@@ -137,6 +217,19 @@ public:
 
 	Bool CompileAssetIfDeprecated(const ResourcePath& path);
 
+	/** Compiles loaded asset again. Used by assets that detect outdated compiled data during initialization. Always fails in compiled only mode */
+	Bool RecompileAsset(const AssetHandle& asset);
+
+	/**
+	 * Compiles deprecated assets and all their dependencies.
+	 * Dependencies are compiled before assets that reference them, independent assets are compiled in parallel
+	 * Compilation inputs are shared by all compilations in the batch
+	 */
+	AssetsBatchCompilationResult CompileAssets(lib::Span<const ResourcePath> paths);
+
+	/** Returns all assets in content directory */
+	lib::DynamicArray<ResourcePath> GetAllContentAssets() const;
+
 	EDeleteResult DeleteAsset(const ResourcePath& path);
 
 	void SaveAsset(const AssetHandle& asset);
@@ -176,6 +269,21 @@ private:
 
 	AssetInstanceData ReadAssetData(const lib::Path& fullPath) const;
 
+	/** Doesn't require assets system lock. Returns nullopt if asset doesn't exist */
+	std::optional<AssetInstanceData> ReadAssetDataForLoad(ResourcePathID pathID) const;
+
+	/** Instance data of compiled assets is cooked to DDC in binary format, so that compiled only mode doesn't need source files */
+	void SaveCompiledAssetData(const AssetHandle& asset);
+	std::optional<AssetInstanceData> ReadCompiledAssetData(ResourcePathID pathID) const;
+	void DeleteCompiledAssetData(ResourcePathID pathID);
+
+	/** If asset data is provided, it's used instead of reading the asset */
+	LoadResult<> LoadAssetImpl(ResourcePathID pathID, AssetLoadTimings& outTimings, std::optional<AssetInstanceData> assetData = std::nullopt);
+
+	void DispatchLoadRequests_Locked();
+	void ProcessLoadRequest(const AssetLoadRequestHandle& request);
+	void FinishLoadRequest(const AssetLoadRequestHandle& request, LoadResult<> result);
+
 	AssetHandle CreateAssetInstance(const AssetInstanceDefinition& initializer);
 
 	void ScheduleAssetInitialization(const AssetHandle& assetInstance);
@@ -213,6 +321,12 @@ private:
 	lib::Lock m_reloadQueueLock;
 	lib::DynamicArray<AssetHandle> m_reloadQueue;
 	std::atomic<Bool> m_hasAssetsToReload = false;
+
+	lib::Lock m_loadRequestsLock;
+	lib::HashMap<ResourcePathID, AssetLoadRequestHandle> m_activeLoadRequests;
+	lib::DynamicArray<AssetLoadRequestHandle>            m_pendingLoadRequests;
+	Uint32 m_activeLoadsNum     = 0u;
+	Uint32 m_maxConcurrentLoads = 4u;
 };
 
 
@@ -0,0 +1,80 @@
+#include "CompilationInputCache.h"
+
+
+namespace spt::as
+{
+
+namespace priv
+{
+
+/** Compilation executed on this thread. Defined in translation unit, so that all modules see the same scope */
+thread_local CompilationInputCache::CompilationScope* tlsCurrentCompilationScope = nullptr;
+
+} // priv
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// CompilationScope ==============================================================================
+
+CompilationInputCache::CompilationScope::CompilationScope(CompilationInputCache& cache)
+	: m_cache(cache)
+	, m_previousScope(priv::tlsCurrentCompilationScope)
+{
+	priv::tlsCurrentCompilationScope = this;
+}
+
+CompilationInputCache::CompilationScope::~CompilationScope()
+{
+	SPT_CHECK(priv::tlsCurrentCompilationScope == this);
+
+	priv::tlsCurrentCompilationScope = m_previousScope;
+
+	m_cache.ReleaseEntries(m_acquiredKeys);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// CompilationInputCache =========================================================================
+
+lib::SharedPtr<CompilationInputCache::BaseEntry> CompilationInputCache::AcquireEntry(const lib::HashedString& key, EntryFactory createEntry)
+{
+	CompilationScope* scope = priv::tlsCurrentCompilationScope;
+	SPT_CHECK_MSG(!!scope && &scope->m_cache == this, "Compilation inputs can be read only by compilations");
+
+	lib::LockGuard lockGuard(m_lock);
+
+	lib::SharedPtr<BaseEntry>& cachedEntry = m_cachedData[key];
+	if (!cachedEntry)
+	{
+		cachedEntry = createEntry();
+	}
+
+	if (!lib::Contains(scope->m_acquiredKeys, key))
+	{
+		++cachedEntry->refCount;
+		scope->m_acquiredKeys.emplace_back(key);
+	}
+
+	return cachedEntry;
+}
+
+void CompilationInputCache::ReleaseEntries(lib::Span<const lib::HashedString> keys)
+{
+	if (keys.empty())
+	{
+		return;
+	}
+
+	lib::LockGuard lockGuard(m_lock);
+
+	for (const lib::HashedString& key : keys)
+	{
+		const auto it = m_cachedData.find(key);
+		SPT_CHECK(it != m_cachedData.cend() && it->second->refCount > 0u);
+
+		if (--it->second->refCount == 0u)
+		{
+			m_cachedData.erase(it);
+		}
+	}
+}
+
+} // spt::as
@@ -1,80 +1,101 @@
 #pragma once
 
+#include "AssetsSystemMacros.h"
 #include "SculptorCoreTypes.h"
 
+#include <mutex>
+
 
 namespace spt::as
 {
 
-class CompilationInputCache
+/**
+ * Caches inputs shared by multiple compilations (e.g. source model used by many meshes).
+ * Each input is reference counted. It's acquired by every compilation that reads it and released as soon as the last of these compilations finishes.
+ */
+class ASSETS_SYSTEM_API CompilationInputCache
 {
 public:
 
-	CompilationInputCache() = default;
-
-	template<typename TType, typename TLoader>
-	const TType& GetOrLoadData(const lib::HashedString& key, TLoader&& loader)
+	/**
+	 * Single compilation. Inputs can be read only on the thread that executes compilation while its scope is active.
+	 * Scopes can be nested (e.g. when dependency is compiled while waiting for other job)
+	 */
+	class ASSETS_SYSTEM_API CompilationScope
 	{
-		lib::LockGuard lockGuard(m_lock);
+	public:
 
-		const auto foundDataIt = m_cachedData.find(key);
-		if (foundDataIt != m_cachedData.cend())
-		{
-			const BaseEntry* entry = foundDataIt->second.get();
-			SPT_CHECK(lib::RuntimeTypeInfo(lib::TypeInfo<TType>()) == entry->type);
-			return reinterpret_cast<const Entry<TType>*>(entry)->data;
-		}
+		explicit CompilationScope(CompilationInputCache& cache);
+		~CompilationScope();
 
-		lib::UniquePtr<Entry<TType>> newEntry = lib::MakeUnique<Entry<TType>>();
-		newEntry->type = lib::TypeInfo<TType>();
-		newEntry->data = loader();
+		CompilationScope(const CompilationScope&)            = delete;
+		CompilationScope& operator=(const CompilationScope&) = delete;
 
-		const TType& data = newEntry->data;
+	private:
 
-		m_cachedData[key] = std::move(newEntry);
+		CompilationInputCache& m_cache;
+		CompilationScope*      m_previousScope = nullptr;
 
-		return data;
-	}
+		/** Inputs referenced by this compilation. Each input is acquired only once per compilation */
+		lib::DynamicArray<lib::HashedString> m_acquiredKeys;
 
-	void OnCompilationStarted()
-	{
-		// Lock is unfortunately necessary because we might be currently releasing data after last compilations batch
-		lib::LockGuard lockGuard(m_lock);
+		friend CompilationInputCache;
+	};
 
-		++m_compilationsInProgressNum;
-	}
+	CompilationInputCache() = default;
 
-	void OnCompilationFinished()
+	template<typename TType, typename TLoader>
+	const TType& GetOrLoadData(const lib::HashedString& key, TLoader&& loader)
 	{
-		lib::LockGuard lockGuard(m_lock);
+		const lib::SharedPtr<BaseEntry> entry = AcquireEntry(key, []() -> lib::SharedPtr<BaseEntry>
+															 {
+																 lib::SharedPtr<BaseEntry> newEntry = lib::MakeShared<Entry<TType>>();
+																 newEntry->type = lib::TypeInfo<TType>();
+																 return newEntry;
+															 });
+
+		SPT_CHECK(lib::RuntimeTypeInfo(lib::TypeInfo<TType>()) == entry->type);
 
-		SPT_CHECK(m_compilationsInProgressNum > 0u);
+		Entry<TType>& typedEntry = static_cast<Entry<TType>&>(*entry);
 
-		if (--m_compilationsInProgressNum == 0u)
+		// Data is loaded without holding cache lock, so that loading different inputs doesn't block other compilations
+		std::call_once(typedEntry.loadFlag, [&typedEntry, &loader]()
 		{
-			m_cachedData.clear();
-		}
+			typedEntry.data = loader();
+		});
+
+		// Entry stays in cache until current compilation finishes, so reference is valid for the whole compilation
+		return typedEntry.data;
 	}
 
 private:
 
-	lib::Lock m_lock;
-
-	Uint32 m_compilationsInProgressNum = 0u;
-
 	struct BaseEntry
 	{
 		virtual ~BaseEntry() = default;
 		lib::RuntimeTypeInfo type;
+
+		/** Number of compilations in progress that read this input. Guarded by cache lock */
+		Uint32 refCount = 0u;
 	};
 
 	template<typename TType>
 	struct Entry : public BaseEntry
 	{
-		TType data;
+		std::once_flag loadFlag;
+		TType          data;
 	};
 
-	lib::HashMap<lib::HashedString, lib::UniquePtr<BaseEntry>> m_cachedData;
+	using EntryFactory = lib::SharedPtr<BaseEntry>(*)();
+
+	/** Returns cached entry (creating it if necessary) and references it by compilation active on the calling thread */
+	lib::SharedPtr<BaseEntry> AcquireEntry(const lib::HashedString& key, EntryFactory createEntry);
+
+	void ReleaseEntries(lib::Span<const lib::HashedString> keys);
+
+	lib::Lock m_lock;
+
+	lib::HashMap<lib::HashedString, lib::SharedPtr<BaseEntry>> m_cachedData;
 };
 
 } // spt::as
@@ -60,6 +60,68 @@ public:
 SPT_REGISTER_ASSET_TYPE(TestAssetType);
 
 
+struct TestAssetDependency
+{
+	lib::Path path;
+
+	void Serialize(srl::Serializer& serializer)
+	{
+		serializer.Serialize("Path", path);
+	}
+};
+SPT_REGISTER_ASSET_DATA_TYPE(spt::as::tests::TestAssetDependency);
+
+
+class TestAssetDependencyInitializer : public AssetDataInitializer
+{
+public:
+
+	explicit TestAssetDependencyInitializer(lib::Path dependencyPath)
+		: m_dependencyPath(std::move(dependencyPath))
+	{ }
+
+	virtual void InitializeNewAsset(AssetInstance& asset) override
+	{
+		asset.GetBlackboard().Create<TestAssetDependency>(TestAssetDependency{ .path = m_dependencyPath });
+	}
+
+private:
+
+	lib::Path m_dependencyPath;
+};
+
+
+class TestDependentAssetType : public AssetInstance
+{
+	ASSET_TYPE_GENERATED_BODY(TestDependentAssetType, AssetInstance)
+
+	virtual Bool Compile() override
+	{
+		const ResourcePath dependencyPath = ResolveAssetRelativePath(GetBlackboard().Get<TestAssetDependency>().path);
+		s_compiledAfterDependency = GetOwningSystem().IsAssetCompiled(dependencyPath.GetID());
+
+		CreateDerivedData(*this, TestAssetCompiledHeader{}, lib::Span<const Byte>());
+		return true;
+	}
+
+public:
+
+	using AssetInstance::AssetInstance;
+
+	static void CollectCompilationDependencies(const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies)
+	{
+		const TestAssetDependency* dependency = data.blackboard.Find<TestAssetDependency>();
+		if (dependency)
+		{
+			outDependencies.emplace_back(path.GetPath().parent_path() / dependency->path);
+		}
+	}
+
+	static inline std::atomic<Bool> s_compiledAfterDependency = false;
+};
+SPT_REGISTER_ASSET_TYPE(TestDependentAssetType);
+
+
 class AssetsSystemTests : public testing::Test
 {
 protected:
@@ -194,6 +256,61 @@ TEST_F(AssetsSystemTests, AssetsLoadingAndUnloading)
 	EXPECT_TRUE(m_assetsSystem.GetLoadedAssetsList().size() == 0u);
 }
 
+TEST_F(AssetsSystemTests, AsyncLoadRequests)
+{
+	const ResourcePath asset1Path       = "AssetsLoadingAndUnloading/Asset1.sptasset";
+	const ResourcePath asset2Path       = "AssetsLoadingAndUnloading/Asset2.sptasset";
+	const ResourcePath missingAssetPath = "AsyncLoadRequests/MissingAsset.sptasset";
+
+	EXPECT_TRUE(m_assetsSystem.GetLoadedAssetsList().size() == 0u);
+
+	AssetLoadRequestHandle request1       = m_assetsSystem.RequestLoad(asset1Path, 10.f);
+	AssetLoadRequestHandle request2       = m_assetsSystem.RequestLoad(asset2Path, 5.f);
+	AssetLoadRequestHandle missingRequest = m_assetsSystem.RequestLoad(missingAssetPath);
+
+	// Requests for the same asset are merged and use the most important priority
+	AssetLoadRequestHandle request1Again = m_assetsSystem.RequestLoad(asset1Path, 1.f);
+	EXPECT_TRUE(request1 == request1Again || request1->IsFinished());
+	if (request1 == request1Again)
+	{
+		EXPECT_LE(request1->GetPriority(), 1.f);
+	}
+
+	request1->Wait();
+	request1Again->Wait();
+	request2->Wait();
+	missingRequest->Wait();
+
+	EXPECT_TRUE(request1->IsFinished());
+	ASSERT_TRUE(request1->GetResult().HasValue());
+	ASSERT_TRUE(request2->GetResult().HasValue());
+	ASSERT_TRUE(missingRequest->GetResult().HasError());
+	EXPECT_TRUE(missingRequest->GetResult().GetError() == ELoadError::DoesNotExist);
+
+	EXPECT_TRUE(request1->GetResult().GetValue()->IsInitialized());
+	EXPECT_TRUE(request2->GetResult().GetValue()->IsInitialized());
+	EXPECT_TRUE(request1Again->GetResult().GetValue() == request1->GetResult().GetValue());
+
+	EXPECT_GE(request1->GetTimings().readMs, 0.f);
+	EXPECT_GE(request1->GetTimings().initializationMs, 0.f);
+
+	EXPECT_TRUE(m_assetsSystem.GetLoadedAssetsList().size() == 2u);
+
+	// Synchronous load must return asset loaded by async request
+	AssetHandle asset1 = m_assetsSystem.LoadAndInitAssetChecked(asset1Path);
+	EXPECT_TRUE(asset1 == request1->GetResult().GetValue());
+
+	// Finished requests keep loaded assets alive
+	asset1.Reset();
+	request1.Reset();
+	request1Again.Reset();
+	EXPECT_TRUE(m_assetsSystem.GetLoadedAssetsList().size() == 1u);
+
+	request2.Reset();
+	missingRequest.Reset();
+	EXPECT_TRUE(m_assetsSystem.GetLoadedAssetsList().size() == 0u);
+}
+
 
 TEST_F(AssetsSystemTests, CreateAndLoadAssetWithData)
 {
@@ -241,6 +358,199 @@ TEST_F(AssetsSystemTests, CreateAndLoadAssetWithData)
 	EXPECT_TRUE(!m_assetsSystem.DoesAssetExist(assetPath));
 }
 
+
+TEST_F(AssetsSystemTests, CompileAssetsWithDependencies)
+{
+	const ResourcePath dependencyPath = "CompileAssetsWithDependencies/Dependency.sptasset";
+	const ResourcePath dependentPath  = "CompileAssetsWithDependencies/Dependent.sptasset";
+	m_assetsSystem.DeleteAsset(dependentPath); // Delete leftover assets if exist
+	m_assetsSystem.DeleteAsset(dependencyPath);
+
+	TestAssetDependencyInitializer dependencyInitializer("Dependency.sptasset");
+
+	EXPECT_TRUE(m_assetsSystem.CreateAsset(AssetInitializer{ .type = CreateAssetType<TestAssetType>(), .path = dependencyPath }).HasValue());
+	EXPECT_TRUE(m_assetsSystem.CreateAsset(AssetInitializer{ .type = CreateAssetType<TestDependentAssetType>(), .path = dependentPath, .dataInitializer = &dependencyInitializer }).HasValue());
+
+	m_assetsSystem.RemoveAssetCompiledData(dependentPath.GetID());
+	m_assetsSystem.RemoveAssetCompiledData(dependencyPath.GetID());
+	TestDependentAssetType::s_compiledAfterDependency = false;
+
+	// Only dependent asset is requested. Dependency must be found and compiled first
+	const ResourcePath requestedAssets[] = { dependentPath };
+	const AssetsBatchCompilationResult result = m_assetsSystem.CompileAssets(requestedAssets);
+
+	EXPECT_TRUE(result.compiledAssetsNum == 2u);
+	EXPECT_TRUE(result.failedAssetsNum == 0u);
+	EXPECT_TRUE(TestDependentAssetType::s_compiledAfterDependency);
+	EXPECT_TRUE(m_assetsSystem.IsAssetCompiled(dependencyPath.GetID()));
+	EXPECT_TRUE(m_assetsSystem.IsAssetCompiled(dependentPath.GetID()));
+
+	ASSERT_TRUE(result.criticalPath.size() == 2u);
+	EXPECT_TRUE(result.criticalPath[0] == dependencyPath);
+	EXPECT_TRUE(result.criticalPath[1] == dependentPath);
+
+	// Nothing to do when assets are up to date
+	const AssetsBatchCompilationResult secondResult = m_assetsSystem.CompileAssets(requestedAssets);
+	EXPECT_TRUE(secondResult.compiledAssetsNum == 0u);
+	EXPECT_TRUE(secondResult.upToDateAssetsNum == 1u);
+
+	m_assetsSystem.DeleteAsset(dependentPath);
+	m_assetsSystem.DeleteAsset(dependencyPath);
+}
+
+TEST_F(AssetsSystemTests, RecompileAllBenchmark)
+{
+	const lib::DynamicArray<ResourcePath> assets = m_assetsSystem.GetAllContentAssets();
+
+	// Compiled data is removed, so that all assets are compiled
+	m_assetsSystem.RemoveAllAssetsCompiledData();
+
+	const AssetsBatchCompilationResult result = m_assetsSystem.CompileAssets(assets);
+
+	// Assets of types that are not registered in this module fail to compile
+	EXPECT_TRUE(result.compiledAssetsNum + result.upToDateAssetsNum + result.failedAssetsNum >= assets.size());
+	EXPECT_TRUE(result.criticalPathMs <= result.totalTimeMs);
+
+	RecordProperty("AssetsNum",      std::to_string(assets.size()));
+	RecordProperty("TotalTimeMs",    std::to_string(result.totalTimeMs));
+	RecordProperty("CriticalPathMs", std::to_string(result.criticalPathMs));
+}
+
+class AssetsDBTests : public testing::Test
+{
+protected:
+
+	virtual void SetUp() override;
+	virtual void TearDown() override;
+
+	void InitializeDB();
+
+	DDC      m_ddc;
+	AssetsDB m_assetsDB;
+};
+
+void AssetsDBTests::SetUp()
+{
+	const lib::Path executablePath = platf::Platform::GetExecutablePath();
+	const lib::Path ddcPath        = executablePath.parent_path() / "../../Tests/DDC";
+
+	m_ddc.Initialize({ .path = ddcPath });
+
+	InitializeDB();
+}
+
+void AssetsDBTests::TearDown()
+{
+	m_assetsDB.Shutdown();
+}
+
+void AssetsDBTests::InitializeDB()
+{
+	// Keys different than ones used by assets system, so that tests don't modify its database
+	const AssetsDBInitInfo initInfo
+	{
+		.ddc            = m_ddc,
+		.assetsDDCKey   = DerivedDataKey(idxNone<Uint64> - 1u, 0u),
+		.pathsDDCKey    = DerivedDataKey(idxNone<Uint64> - 1u, 1u),
+		.deltaLogDDCKey = DerivedDataKey(idxNone<Uint64> - 1u, 2u)
+	};
+
+	m_assetsDB.Initalize(initInfo);
+}
+
+TEST_F(AssetsDBTests, SaveAndDeleteDescriptor)
+{
+	const ResourcePath assetPath = "AssetsDBTests/SaveAndDelete.sptasset";
+	m_assetsDB.DeleteAssetDescriptor(assetPath.GetID()); // Delete leftover descriptor if exists
+
+	EXPECT_TRUE(m_assetsDB.IsWritable());
+	EXPECT_FALSE(m_assetsDB.ContainsAsset(assetPath.GetID()));
+
+	m_assetsDB.SaveAssetDescriptor(assetPath, AssetDescriptor{ .assetTypeKey = 7u });
+
+	EXPECT_TRUE(m_assetsDB.ContainsAsset(assetPath.GetID()));
+	EXPECT_TRUE(m_assetsDB.GetAssetDescriptor(assetPath.GetID())->assetTypeKey == 7u);
+	EXPECT_TRUE(m_assetsDB.GetPath(assetPath.GetID()) == assetPath);
+
+	m_assetsDB.DeleteAssetDescriptor(assetPath.GetID());
+
+	EXPECT_FALSE(m_assetsDB.ContainsAsset(assetPath.GetID()));
+	EXPECT_FALSE(m_assetsDB.GetAssetDescriptor(assetPath.GetID()).has_value());
+}
+
+TEST_F(AssetsDBTests, SnapshotIsolation)
+{
+	const ResourcePath assetPath = "AssetsDBTests/SnapshotIsolation.sptasset";
+	m_assetsDB.DeleteAssetDescriptor(assetPath.GetID());
+
+	const AssetsDBSnapshotHandle snapshotBefore = m_assetsDB.GetSnapshot();
+
+	m_assetsDB.SaveAssetDescriptor(assetPath, AssetDescriptor{ .assetTypeKey = 1u });
+
+	const AssetsDBSnapshotHandle snapshotAfter = m_assetsDB.GetSnapshot();
+
+	m_assetsDB.DeleteAssetDescriptor(assetPath.GetID());
+
+	EXPECT_FALSE(snapshotBefore->ContainsAsset(assetPath.GetID()));
+	EXPECT_TRUE(snapshotAfter->ContainsAsset(assetPath.GetID()));
+	EXPECT_TRUE(snapshotAfter->GetAssetsNum() == snapshotBefore->GetAssetsNum() + 1u);
+	EXPECT_FALSE(m_assetsDB.ContainsAsset(assetPath.GetID()));
+}
+
+TEST_F(AssetsDBTests, PersistentAfterReopen)
+{
+	const ResourcePath firstPath  = "AssetsDBTests/PersistentA.sptasset";
+	const ResourcePath secondPath = "AssetsDBTests/PersistentB.sptasset";
+
+	m_assetsDB.SaveAssetDescriptor(firstPath, AssetDescriptor{ .assetTypeKey = 3u });
+	m_assetsDB.SaveAssetDescriptor(secondPath, AssetDescriptor{ .assetTypeKey = 4u });
+
+	// Shutdown merges delta to sorted base files
+	m_assetsDB.Shutdown();
+	InitializeDB();
+
+	EXPECT_TRUE(m_assetsDB.GetAssetDescriptor(firstPath.GetID())->assetTypeKey == 3u);
+	EXPECT_TRUE(m_assetsDB.GetAssetDescriptor(secondPath.GetID())->assetTypeKey == 4u);
+	EXPECT_TRUE(m_assetsDB.GetPath(secondPath.GetID()) == secondPath);
+
+	const lib::DynamicArray<AssetMetaData> allAssets = m_assetsDB.GetAllAssetsDescriptors();
+	EXPECT_TRUE(std::is_sorted(allAssets.cbegin(), allAssets.cend(), [](const AssetMetaData& lhs, const AssetMetaData& rhs) { return lhs.pathID < rhs.pathID; }));
+
+	m_assetsDB.DeleteAssetDescriptor(firstPath.GetID());
+	m_assetsDB.DeleteAssetDescriptor(secondPath.GetID());
+}
+
+TEST_F(AssetsDBTests, DeltaIsCompactedAtThreshold)
+{
+	constexpr SizeType assetsNum = AssetsDB::deltaLogCompactionThreshold + 16u;
+
+	lib::DynamicArray<ResourcePath> paths;
+	paths.reserve(assetsNum);
+
+	for (SizeType idx = 0u; idx < assetsNum; ++idx)
+	{
+		paths.emplace_back(lib::Path("AssetsDBTests/Compaction") / (std::to_string(idx) + ".sptasset"));
+		m_assetsDB.SaveAssetDescriptor(paths.back(), AssetDescriptor{ .assetTypeKey = static_cast<AssetTypeKey>(idx) });
+	}
+
+	// Delta must be merged to base files once log reaches the threshold
+	EXPECT_TRUE(m_assetsDB.GetSnapshot()->GetDeltaEntriesNum() < AssetsDB::deltaLogCompactionThreshold);
+
+	for (SizeType idx = 0u; idx < assetsNum; ++idx)
+	{
+		EXPECT_TRUE(m_assetsDB.GetAssetDescriptor(paths[idx].GetID())->assetTypeKey == static_cast<AssetTypeKey>(idx));
+	}
+
+	EXPECT_TRUE(m_assetsDB.GetPath(paths.back().GetID()) == paths.back());
+
+	for (const ResourcePath& path : paths)
+	{
+		m_assetsDB.DeleteAssetDescriptor(path.GetID());
+	}
+
+	EXPECT_FALSE(m_assetsDB.ContainsAsset(paths.front().GetID()));
+}
+
 } // spt::as::tests
 
 
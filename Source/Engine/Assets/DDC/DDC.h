@@ -177,6 +177,8 @@ public:
 
 	void Initialize(const DDCParams& params);
 
+	Bool IsInitialized() const { return !m_params.path.empty(); }
+
 	DerivedDataKey CreateDerivedData(const DerivedDataKey& key, lib::Span<const Byte> data) const;
 
 	DDCResourceHandle CreateDerivedData(const DerivedDataKey& key, Uint64 size) const;
@@ -38,6 +38,24 @@ const rsc::TerrainMaterialData& TerrainMaterialAsset::GetTerrainMaterialData() c
 	return m_terrainMaterialData;
 }
 
+void TerrainMaterialAsset::CollectCompilationDependencies(const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies)
+{
+	const TerrainMaterialDefinition* definition = data.blackboard.Find<TerrainMaterialDefinition>();
+	if (!definition)
+	{
+		return;
+	}
+
+	for (SizeType i = 0; i < definition->materialEntries.GetSize(); ++i)
+	{
+		const TerrainMaterialEntry& materialEntry = definition->materialEntries[i];
+		if (materialEntry.materialAsset.IsValid())
+		{
+			outDependencies.emplace_back(path.GetPath().parent_path() / materialEntry.materialAsset.GetPath());
+		}
+	}
+}
+
 Bool TerrainMaterialAsset::Compile()
 {
 	const TerrainMaterialDefinition& definition = GetBlackboard().Get<TerrainMaterialDefinition>();
@@ -62,6 +62,8 @@ public:
 
 	lib::Span<const MaterialAssetHandle> GetMaterialAssets() const { return m_materialAssets; }
 
+	static void CollectCompilationDependencies(const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies);
+
 protected:
 
 	// Begin AssetInstance overrides
@@ -3,7 +3,7 @@
 #include "DDC.h"
 #include "Engine.h"
 #include "Loaders/GLTFMeshBuilder.h"
-#include "Loaders/GLTF.h"
+#include "Loaders/GLTFGeometry.h"
 #include "ResourcePath.h"
 #include "Transfers/GPUDeferredCommandsQueueTypes.h"
 #include "StaticMeshes/RenderMesh.h"
@@ -119,23 +119,30 @@ Bool MeshAsset::Compile()
 	const lib::Path meshSourcePath = (GetDirectoryPath() / sourceDef.path);
 	const lib::String meshSourcePathAsString = meshSourcePath.generic_string();
 
-	const std::optional<rsc::GLTFModel>& gltfModel = GetOwningSystem().GetCompilationInputData<std::optional<rsc::GLTFModel>>(meshSourcePathAsString,
+	// Geometry is cached separately from full glTF model (used by materials and prefabs), because it only maps the file instead of copying buffers
+	const lib::String geometryCacheKey = meshSourcePathAsString + "#Geometry";
+
+	const std::optional<rsc::GLTFGeometry>& gltfGeometry = GetOwningSystem().GetCompilationInputData<std::optional<rsc::GLTFGeometry>>(geometryCacheKey,
 			[&meshSourcePathAsString]()
 			{
-				return rsc::LoadGLTFModel(meshSourcePathAsString);
+				return rsc::LoadGLTFGeometry(meshSourcePathAsString);
 			});
 
-	if (!gltfModel.has_value())
+	if (!gltfGeometry.has_value())
 	{
 		SPT_LOG_ERROR(MeshAsset, "Failed to load GLTF model from path '{}'", meshSourcePath.generic_string());
 		return false;
 	}
 
-	lib::MemoryArena memArena("Mesh Compilation Memory Arena", 8u * 1024u * 1024u, 2u * 1024u * 1024u * 1024u);
+	if (sourceDef.meshIdx >= gltfGeometry->GetMeshes().size())
+	{
+		SPT_LOG_ERROR(MeshAsset, "Invalid mesh index {} for GLTF model '{}'", sourceDef.meshIdx, meshSourcePath.generic_string());
+		return false;
+	}
 
 	rsc::MeshBuildParameters meshBuildParams{};
 	rsc::GLTFMeshBuilder meshBuilder(meshBuildParams);
-	meshBuilder.BuildMesh(memArena, gltfModel->meshes[sourceDef.meshIdx], *gltfModel);
+	meshBuilder.BuildMesh(gltfGeometry->GetMeshes()[sourceDef.meshIdx]);
 	meshBuilder.Build();
 
 	rsc::MeshDefinition meshDef = meshBuilder.CreateMeshDefinition();
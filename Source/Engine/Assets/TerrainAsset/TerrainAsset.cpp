@@ -7,6 +7,8 @@
 #include "Types/Texture.h"
 #include "ResourcesManager.h"
 #include "Utils/TransfersUtils.h"
+#include "Terrain/TerrainHeightMapStreamer.h"
+#include "GPUApi.h"
 
 
 SPT_DEFINE_LOG_CATEGORY(TerrainAsset, true);
@@ -16,11 +18,23 @@ namespace spt::as
 
 struct TerrainDerivedDataHeader
 {
-	Uint32 version = 0u;
+	/** Bump when layout of compiled terrain data changes */
+	static constexpr Uint32 currentVersion = 3u;
+
+	Uint32 version = currentVersion;
+
+	/** True if terrain was compiled without GPU, so far LOD is missing */
+	Bool requiresFarLODBake = false;
 
 	void Serialize(srl::Serializer& serializer)
 	{
-		serializer.Serialize("version", version);
+		serializer.Serialize("version",            version);
+		serializer.Serialize("requiresFarLODBake", requiresFarLODBake);
+	}
+
+	Bool RequiresRecompilation() const
+	{
+		return version != currentVersion || (requiresFarLODBake && rdr::GPUApi::IsInitialized());
 	}
 };
 
@@ -58,16 +72,18 @@ void TerrainTexturesUuploadRequest::EnqueueUploads()
 {
 	const CompiledTerrainHeader& terrainDataHeader = reinterpret_cast<const CompiledTerrainHeader&>(*blob->bin.data());
 
-	if (dstHeightMap && terrainDataHeader.heightMap.format != rhi::EFragmentFormat::None)
+	if (dstHeightMap && terrainDataHeader.heightMapFallback.format != rhi::EFragmentFormat::None)
 	{
 		const rhi::ETextureAspect textureAspect = dstHeightMap->GetRHI().GetAspect();
-		rdr::UploadDataToTexture(blob->bin.data() + terrainDataHeader.heightMap.dataOffset, terrainDataHeader.heightMap.dataSize, dstHeightMap->GetTexture(), textureAspect, dstHeightMap->GetResolution(), math::Vector3u::Zero(), 0u, 0u);
+		rdr::UploadDataToTexture(blob->bin.data() + terrainDataHeader.heightMapFallback.dataOffset, terrainDataHeader.heightMapFallback.dataSize, dstHeightMap->GetTexture(), textureAspect, dstHeightMap->GetResolution(), math::Vector3u::Zero(), 0u, 0u);
 	}
 
-	if (dstTileHeightMinMaxMap && terrainDataHeader.tileHeightMinMaxMap.format != rhi::EFragmentFormat::None)
+	if (dstTileHeightMinMaxMap && terrainDataHeader.tileHeightMinMaxLevelsNum > 0u)
 	{
+		const CompiledTerrainHeader::TextureInfo& minMaxLevel0 = terrainDataHeader.tileHeightMinMaxLevels[0];
+
 		const rhi::ETextureAspect textureAspect = dstTileHeightMinMaxMap->GetRHI().GetAspect();
-		rdr::UploadDataToTexture(blob->bin.data() + terrainDataHeader.tileHeightMinMaxMap.dataOffset, terrainDataHeader.tileHeightMinMaxMap.dataSize, dstTileHeightMinMaxMap->GetTexture(), textureAspect, dstTileHeightMinMaxMap->GetResolution(), math::Vector3u::Zero(), 0u, 0u);
+		rdr::UploadDataToTexture(blob->bin.data() + minMaxLevel0.dataOffset, minMaxLevel0.dataSize, dstTileHeightMinMaxMap->GetTexture(), textureAspect, dstTileHeightMinMaxMap->GetResolution(), math::Vector3u::Zero(), 0u, 0u);
 	}
 
 	if (dstFarLODBaseColor && terrainDataHeader.farLODBaseColor.format != rhi::EFragmentFormat::None)
@@ -89,6 +105,47 @@ void TerrainTexturesUuploadRequest::EnqueueUploads()
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// TerrainHeightMapTilesDataSource ===============================================================
+
+/** Reads height map tiles directly from compiled terrain data. Keeps DDC data mapped as long as streamer exists */
+class TerrainHeightMapTilesDataSource : public rsc::TerrainTilesDataSource
+{
+public:
+
+	explicit TerrainHeightMapTilesDataSource(lib::MTHandle<DDCLoadedBin> blob)
+		: m_blob(std::move(blob))
+	{
+		const CompiledTerrainHeader& terrainDataHeader = reinterpret_cast<const CompiledTerrainHeader&>(*m_blob->bin.data());
+
+		m_tilesNum  = terrainDataHeader.heightMap.tilesNum.x() * terrainDataHeader.heightMap.tilesNum.y();
+		m_tiles     = reinterpret_cast<const terrain_compiler::HeightMapTile*>(m_blob->bin.data() + terrainDataHeader.heightMap.tilesIndexOffset);
+		m_tilesData = m_blob->bin.data() + terrainDataHeader.heightMap.tilesDataOffset;
+	}
+
+	// Begin TerrainTilesDataSource overrides
+	virtual void ReadTileData(Uint32 tileIdx, lib::Span<Byte> destination) const override
+	{
+		SPT_PROFILER_FUNCTION();
+
+		SPT_CHECK(tileIdx < m_tilesNum);
+
+		const terrain_compiler::HeightMapTile& tile = m_tiles[tileIdx];
+		SPT_CHECK(destination.size() == tile.dataSize);
+
+		std::memcpy(destination.data(), m_tilesData + tile.dataOffset, tile.dataSize);
+	}
+	// End TerrainTilesDataSource overrides
+
+private:
+
+	lib::MTHandle<DDCLoadedBin> m_blob;
+
+	Uint32                                 m_tilesNum  = 0u;
+	const terrain_compiler::HeightMapTile* m_tiles     = nullptr;
+	const Byte*                            m_tilesData = nullptr;
+};
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // TerrainAsset ==================================================================================
 
@@ -108,6 +165,7 @@ rsc::TerrainDefinition TerrainAsset::GetTerrainDefinition() const
 
 	rsc::TerrainDefinition terrainDefinition;
 	terrainDefinition.heightMap       = m_heightMap;
+	terrainDefinition.heightMapStreamer = m_heightMapStreamer;
 	terrainDefinition.tileHeightMinMaxMap = m_tileHeightMinMaxMap;
 	terrainDefinition.farLODBaseColor = m_farLODBaseColor;
 	terrainDefinition.farLODProps     = m_farLODProps;
@@ -120,6 +178,15 @@ rsc::TerrainDefinition TerrainAsset::GetTerrainDefinition() const
 	return terrainDefinition;
 }
 
+void TerrainAsset::CollectCompilationDependencies(const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies)
+{
+	const TerrainAssetDefinition* definition = data.blackboard.Find<TerrainAssetDefinition>();
+	if (definition && !definition->terrainMaterial.empty())
+	{
+		outDependencies.emplace_back(path.GetPath().parent_path() / definition->terrainMaterial);
+	}
+}
+
 Bool TerrainAsset::Compile()
 {
 	SPT_PROFILER_FUNCTION();
@@ -134,6 +201,7 @@ Bool TerrainAsset::Compile()
 	}
 
 	TerrainDerivedDataHeader header;
+	header.requiresFarLODBake = compilationResult->skippedFarLODBake;
 
 	CreateDerivedData(*this, header, compilationResult->blob);
 
@@ -144,27 +212,61 @@ void TerrainAsset::OnInitialize()
 {
 	SPT_PROFILER_FUNCTION();
 
-	const lib::MTHandle<DDCLoadedData<TerrainDerivedDataHeader>> compiledData = LoadDerivedData<TerrainDerivedDataHeader>(*this);
+	lib::MTHandle<DDCLoadedData<TerrainDerivedDataHeader>> compiledData = LoadDerivedData<TerrainDerivedDataHeader>(*this);
 	SPT_CHECK(compiledData.IsValid());
 
+	if (compiledData->header.RequiresRecompilation())
+	{
+		SPT_LOG_INFO(TerrainAsset, "Compiled data of TerrainAsset '{}' is outdated. Recompiling", GetName().ToString());
+
+		// Release old data before it's overwritten by compilation
+		compiledData.Reset();
+
+		if (!GetOwningSystem().RecompileAsset(AssetHandle(this)))
+		{
+			SPT_LOG_ERROR(TerrainAsset, "Failed to recompile TerrainAsset '{}'", GetName().ToString());
+		}
+
+		compiledData = LoadDerivedData<TerrainDerivedDataHeader>(*this);
+		SPT_CHECK(compiledData.IsValid());
+	}
+
+	if (compiledData->header.version != TerrainDerivedDataHeader::currentVersion)
+	{
+		SPT_LOG_ERROR(TerrainAsset, "Compiled data of TerrainAsset '{}' is outdated (version: {}, expected: {}). Asset must be recompiled", GetName().ToString(), compiledData->header.version, TerrainDerivedDataHeader::currentVersion);
+		return;
+	}
+
 	const CompiledTerrainHeader& terrainDataHeader = reinterpret_cast<const CompiledTerrainHeader&>(*compiledData->bin.data());
 
-	if (terrainDataHeader.heightMap.format != rhi::EFragmentFormat::None)
+	if (terrainDataHeader.heightMapFallback.format != rhi::EFragmentFormat::None)
 	{
 		rhi::TextureDefinition heightMapDef;
-		heightMapDef.resolution = terrainDataHeader.heightMap.resolution;
-		heightMapDef.format     = terrainDataHeader.heightMap.format;
+		heightMapDef.resolution = terrainDataHeader.heightMapFallback.resolution;
+		heightMapDef.format     = terrainDataHeader.heightMapFallback.format;
 		heightMapDef.usage      = lib::Flags(rhi::ETextureUsage::SampledTexture, rhi::ETextureUsage::TransferDest);
 		heightMapDef.flags      = rhi::ETextureFlags::GloballyReadable;
 
 		m_heightMap = rdr::ResourcesManager::CreateTextureView(RENDERER_RESOURCE_NAME("TerrainAsset_HeightMap"), heightMapDef, rhi::EMemoryUsage::GPUOnly);
 	}
 
-	if (terrainDataHeader.tileHeightMinMaxMap.format != rhi::EFragmentFormat::None)
+	if (terrainDataHeader.heightMap.format != rhi::EFragmentFormat::None)
+	{
+		rsc::TerrainHeightMapStreamingDefinition streamingDef;
+		streamingDef.resolution     = terrainDataHeader.heightMap.resolution;
+		streamingDef.tileResolution = terrainDataHeader.heightMap.tileResolution;
+		streamingDef.tilesNum       = terrainDataHeader.heightMap.tilesNum;
+		streamingDef.format         = terrainDataHeader.heightMap.format;
+		streamingDef.dataSource     = lib::MakeShared<TerrainHeightMapTilesDataSource>(compiledData);
+
+		m_heightMapStreamer = lib::MakeShared<rsc::TerrainHeightMapStreamer>(std::move(streamingDef));
+	}
+
+	if (terrainDataHeader.tileHeightMinMaxLevelsNum > 0u)
 	{
 		rhi::TextureDefinition tileHeightMinMaxMapDef;
-		tileHeightMinMaxMapDef.resolution = terrainDataHeader.tileHeightMinMaxMap.resolution;
-		tileHeightMinMaxMapDef.format     = terrainDataHeader.tileHeightMinMaxMap.format;
+		tileHeightMinMaxMapDef.resolution = terrainDataHeader.tileHeightMinMaxLevels[0].resolution;
+		tileHeightMinMaxMapDef.format     = terrainDataHeader.tileHeightMinMaxLevels[0].format;
 		tileHeightMinMaxMapDef.usage      = lib::Flags(rhi::ETextureUsage::SampledTexture, rhi::ETextureUsage::TransferDest);
 		tileHeightMinMaxMapDef.flags      = rhi::ETextureFlags::GloballyReadable;
 
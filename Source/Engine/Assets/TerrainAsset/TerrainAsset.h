@@ -19,15 +19,24 @@ namespace spt::as
 
 struct TerrainAssetDefinition
 {
+	static inline const math::Vector2f defaultMinBounds = math::Vector2f(-1024.f, -1024.f);
+	static inline const math::Vector2f defaultMaxBounds = math::Vector2f(1024.f, 1024.f);
+
 	lib::Path heightMapTex;
 	lib::Path terrainMaterial;
 	lib::Path materialIDsTex;
 
+	/** World space XY bounds covered by height map */
+	math::Vector2f minBounds = defaultMinBounds;
+	math::Vector2f maxBounds = defaultMaxBounds;
+
 	void Serialize(srl::Serializer& serializer)
 	{
 		serializer.Serialize("HeightMapTex",    heightMapTex);
 		serializer.Serialize("TerrainMaterial", terrainMaterial);
 		serializer.Serialize("MaterialIDsTex",  materialIDsTex);
+		serializer.Serialize("MinBounds",       minBounds);
+		serializer.Serialize("MaxBounds",       maxBounds);
 	}
 };
 SPT_REGISTER_ASSET_DATA_TYPE(TerrainAssetDefinition);
@@ -58,6 +67,7 @@ public:
 	using AssetInstance::AssetInstance;
 
 	const lib::SharedPtr<rdr::TextureView>& GetHeightMap() const { return m_heightMap; }
+	const lib::SharedPtr<rsc::TerrainHeightMapStreamer>& GetHeightMapStreamer() const { return m_heightMapStreamer; }
 	const lib::SharedPtr<rdr::TextureView>& GetTileHeightMinMaxMap() const { return m_tileHeightMinMaxMap; }
 	const TerrainMaterialAssetHandle& GetTerrainMaterialAsset() const { return m_terrainMaterialAsset; }
 
@@ -65,6 +75,8 @@ public:
 
 	rsc::TerrainDefinition GetTerrainDefinition() const;
 
+	static void CollectCompilationDependencies(const ResourcePath& path, const AssetInstanceData& data, lib::DynamicArray<ResourcePath>& outDependencies);
+
 protected:
 
 	// Begin AssetInstance overrides
@@ -75,6 +87,7 @@ protected:
 private:
 
 	lib::SharedPtr<rdr::TextureView> m_heightMap;
+	lib::SharedPtr<rsc::TerrainHeightMapStreamer> m_heightMapStreamer;
 	lib::SharedPtr<rdr::TextureView> m_tileHeightMinMaxMap;
 	lib::SharedPtr<rdr::TextureView> m_farLODBaseColor;
 	lib::SharedPtr<rdr::TextureView> m_farLODProps;
@@ -21,20 +21,6 @@ SPT_DEFINE_LOG_CATEGORY(TerrainCompiler, true);
 namespace spt::as::terrain_compiler
 {
 
-namespace utils
-{
-
-math::Vector2u ComputeTerrainTilesResolution(const math::Vector2f minBounds, const math::Vector2f maxBounds)
-{
-	const math::Vector2f terrainSize = maxBounds - minBounds;
-
-	return math::Vector2u(
-		static_cast<Uint32>(std::ceil(terrainSize.x() / rsc::terrain_consts::tileSizeMeters)),
-		static_cast<Uint32>(std::ceil(terrainSize.y() / rsc::terrain_consts::tileSizeMeters)));
-}
-
-} // utils
-
 namespace bake_far_lod
 {
 
@@ -66,88 +52,18 @@ void Execute(rg::RenderGraphBuilder& graphBuilder, const BakeFarLODConstants& co
 
 } // bake_far_lod
 
-namespace compile_height_map
-{
-
-BEGIN_SHADER_STRUCT(CompileHeightMapConstants)
-	SHADER_STRUCT_FIELD(gfx::SRVTexture2D<math::Vector4f>, sourceHeightMap)
-	SHADER_STRUCT_FIELD(gfx::UAVTexture2D<Real32>,         rwHeightMap)
-END_SHADER_STRUCT()
-
-
-SIMPLE_COMPUTE_PSO(CompileHeightMapPSO, "Sculptor/Terrain/CompileHeightMap.hlsl", CompileHeightMapCS)
-
-
-rg::RGTextureViewHandle Execute(rg::RenderGraphBuilder& graphBuilder, rg::RGTextureViewHandle sourceHeightMap)
-{
-	SPT_PROFILER_FUNCTION();
-
-	const math::Vector2u resolution = sourceHeightMap->GetResolution2D();
-	const rg::RGTextureViewHandle compiledHeightMap = graphBuilder.CreateTextureView(RG_DEBUG_NAME("Terrain Height Map"), rg::TextureDef(resolution, rhi::EFragmentFormat::R16_UN_Float));
-
-	CompileHeightMapConstants constants{};
-	constants.sourceHeightMap = sourceHeightMap;
-	constants.rwHeightMap     = compiledHeightMap;
-
-	graphBuilder.Dispatch(RG_DEBUG_NAME("Compile Height Map"),
-						  CompileHeightMapPSO::pso,
-						  math::Utils::DivideCeil(resolution, math::Vector2u(16u, 16u)),
-						  rg::EmptyDescriptorSets(),
-						  constants);
-
-	return compiledHeightMap;
-}
-
-} // compile_height_map
-
-namespace compile_tile_height_min_max_map
-{
-
-BEGIN_SHADER_STRUCT(CompileTileHeightMinMaxMapConstants)
-	SHADER_STRUCT_FIELD(math::Vector2u,                    heightMapResolution)
-	SHADER_STRUCT_FIELD(math::Vector2f,                    minBounds)
-	SHADER_STRUCT_FIELD(math::Vector2f,                    maxBounds)
-	SHADER_STRUCT_FIELD(Real32,                            tileSizeMeters)
-	SHADER_STRUCT_FIELD(gfx::SRVTexture2D<Real32>,         heightMap)
-	SHADER_STRUCT_FIELD(gfx::UAVTexture2D<math::Vector2f>, rwTileHeightMinMaxMap)
-END_SHADER_STRUCT()
-
-
-SIMPLE_COMPUTE_PSO(CompileTileHeightMinMaxMapPSO, "Sculptor/Terrain/CompileTileHeightMinMaxMap.hlsl", CompileTileHeightMinMaxMapCS)
-
-
-rg::RGTextureViewHandle Execute(rg::RenderGraphBuilder& graphBuilder, rg::RGTextureViewHandle compiledHeightMap, const math::Vector2f minBounds, const math::Vector2f maxBounds)
-{
-	SPT_PROFILER_FUNCTION();
-
-	const math::Vector2u tileResolution = utils::ComputeTerrainTilesResolution(minBounds, maxBounds);
-	const rg::RGTextureViewHandle tileHeightMinMaxMap = graphBuilder.CreateTextureView(RG_DEBUG_NAME("Terrain Tile Height Min Max Map"), rg::TextureDef(tileResolution, rhi::EFragmentFormat::RG16_UN_Float));
-
-	CompileTileHeightMinMaxMapConstants constants{};
-	constants.heightMapResolution   = compiledHeightMap->GetResolution2D();
-	constants.minBounds             = minBounds;
-	constants.maxBounds             = maxBounds;
-	constants.tileSizeMeters        = rsc::terrain_consts::tileSizeMeters;
-	constants.heightMap             = compiledHeightMap;
-	constants.rwTileHeightMinMaxMap = tileHeightMinMaxMap;
-
-	graphBuilder.Dispatch(RG_DEBUG_NAME("Compile Terrain Tile Height Min Max Map"),
-						  CompileTileHeightMinMaxMapPSO::pso,
-						  math::Utils::DivideCeil(tileResolution, math::Vector2u(8u, 8u)),
-						  rg::EmptyDescriptorSets(),
-						  constants);
-
-	return tileHeightMinMaxMap;
-}
-
-} // compile_tile_height_min_max_map
-
 std::optional<TerrainCompilationResult> CompileTerrain(const AssetInstance& asset, const TerrainAssetDefinition& definition)
 {
 	SPT_PROFILER_FUNCTION();
 
-	const math::Vector2f minBounds = math::Vector2f(-1024.f, -1024.f);
-	const math::Vector2f maxBounds = math::Vector2f(1024.f, 1024.f);
+	const Bool hasValidBounds = (definition.maxBounds - definition.minBounds).minCoeff() > 0.f;
+	if (!hasValidBounds)
+	{
+		SPT_LOG_WARN(TerrainCompiler, "Invalid terrain bounds in asset '{}'. Using default bounds", asset.GetName().ToString());
+	}
+
+	const math::Vector2f minBounds = hasValidBounds ? definition.minBounds : TerrainAssetDefinition::defaultMinBounds;
+	const math::Vector2f maxBounds = hasValidBounds ? definition.maxBounds : TerrainAssetDefinition::defaultMaxBounds;
 
 	AssetsSystem& assetSystem = asset.GetOwningSystem();
 
@@ -161,52 +77,72 @@ std::optional<TerrainCompilationResult> CompileTerrain(const AssetInstance& asse
 	if (!definition.heightMapTex.empty())
 	{
 		const lib::Path heightMapPath = asset.GetDirectoryPath() / definition.heightMapTex;
-		const lib::SharedPtr<rdr::Texture> loadedHeightMap = gfx::TextureLoader::LoadTexture(heightMapPath.generic_string());
+		const gfx::LoadedTextureData loadedHeightMap = gfx::TextureLoader::LoadTextureData(heightMapPath.generic_string(), tempArena);
 
-		if (loadedHeightMap)
+		if (loadedHeightMap.IsValid() && IsSupportedHeightMapFormat(loadedHeightMap.format))
 		{
-			const math::Vector2u heightMapResolution = loadedHeightMap->GetResolution2D();
+			SPT_PROFILER_SCOPE("Terrain Height Map Compilation (CPU)");
+
+			const math::Vector2u heightMapResolution = loadedHeightMap.resolution.head<2>();
 			SPT_CHECK(heightMapResolution.x() % 4u == 0u && heightMapResolution.y() % 4u == 0u);
 
-			const lib::SharedRef<rdr::TextureView> sourceHeightMapView = loadedHeightMap->CreateView(RENDERER_RESOURCE_NAME("Terrain Height Map Source"));
+			const HeightMapSource source
+			{
+				.data       = loadedHeightMap.data,
+				.format     = loadedHeightMap.format,
+				.resolution = heightMapResolution
+			};
 
-			rdr::FlushPendingUploads();
+			const lib::DynamicArray<Uint16> heights = ConvertHeightMap(source);
 
-			rg::RenderGraphResourcesPool renderResourcesPool;
-			rg::RenderGraphBuilder graphBuilder(tempArena, renderResourcesPool);
+			const TiledHeightMap tiledHeightMap = BuildTiledHeightMap(heights, heightMapResolution, math::Vector2u::Constant(heightMapTileSize));
 
-			SPT_RG_DIAGNOSTICS_SCOPE(graphBuilder, "Terrain Height Map Compilation (GPU)");
+			header.heightMap.resolution       = tiledHeightMap.resolution;
+			header.heightMap.format           = rhi::EFragmentFormat::R16_UN_Float;
+			header.heightMap.tileResolution   = tiledHeightMap.tileResolution;
+			header.heightMap.tilesNum         = tiledHeightMap.tilesNum;
+			header.heightMap.tilesIndexOffset = static_cast<Uint32>(result.blob.size());
 
-			const rg::RGTextureViewHandle compiledHeightMap = compile_height_map::Execute(graphBuilder, graphBuilder.AcquireExternalTextureView(sourceHeightMapView.ToSharedPtr()));
-			const rg::RGTextureViewHandle tileHeightMinMaxMap = compile_tile_height_min_max_map::Execute(graphBuilder, compiledHeightMap, minBounds, maxBounds);
+			const lib::Span<const Byte> tilesIndex(reinterpret_cast<const Byte*>(tiledHeightMap.tiles.data()), tiledHeightMap.tiles.size() * sizeof(HeightMapTile));
+			result.blob.insert(result.blob.end(), tilesIndex.begin(), tilesIndex.end());
 
-			const lib::SharedRef<rdr::Buffer> heightMapData = graphBuilder.DownloadTextureToBuffer(RG_DEBUG_NAME("Download Height Map"), compiledHeightMap);
-			const lib::SharedRef<rdr::Buffer> tileHeightMinMaxMapData = graphBuilder.DownloadTextureToBuffer(RG_DEBUG_NAME("Download Tile Height Min Max Map"), tileHeightMinMaxMap);
+			header.heightMap.tilesDataOffset = static_cast<Uint32>(result.blob.size());
+			result.blob.insert(result.blob.end(), tiledHeightMap.tilesData.begin(), tiledHeightMap.tilesData.end());
 
-			graphBuilder.Execute();
-			rdr::GPUApi::WaitIdle();
+			math::Vector2u fallbackResolution = math::Vector2u::Zero();
+			const lib::DynamicArray<Uint16> fallbackHeights = BuildDownsampledHeightMap(heights, heightMapResolution, heightMapFallbackDownsampleFactor, fallbackResolution);
 
-			const rhi::RHIMappedByteBuffer heightMapMappedData(heightMapData->GetRHI());
-			const rhi::RHIMappedByteBuffer tileHeightMinMaxMapMappedData(tileHeightMinMaxMapData->GetRHI());
-			const math::Vector2u tileHeightMinMaxMapResolution = tileHeightMinMaxMap->GetResolution2D();
+			header.heightMapFallback.resolution = fallbackResolution;
+			header.heightMapFallback.format     = rhi::EFragmentFormat::R16_UN_Float;
+			header.heightMapFallback.dataOffset = static_cast<Uint32>(result.blob.size());
+			header.heightMapFallback.dataSize   = static_cast<Uint32>(fallbackHeights.size() * sizeof(Uint16));
 
-			header.heightMap.resolution = heightMapResolution;
-			header.heightMap.format     = rhi::EFragmentFormat::R16_UN_Float;
-			header.heightMap.dataOffset = static_cast<Uint32>(result.blob.size());
-			header.heightMap.dataSize   = static_cast<Uint32>(heightMapMappedData.GetSpan().size());
+			const lib::Span<const Byte> fallbackData(reinterpret_cast<const Byte*>(fallbackHeights.data()), fallbackHeights.size() * sizeof(Uint16));
+			result.blob.insert(result.blob.end(), fallbackData.begin(), fallbackData.end());
 
-			result.blob.insert(result.blob.end(), heightMapMappedData.GetSpan().begin(), heightMapMappedData.GetSpan().end());
+			const TileHeightMinMaxPyramid minMaxPyramid = BuildTileHeightMinMaxPyramid(heights, heightMapResolution, minBounds, maxBounds, rsc::terrain_consts::tileSizeMeters);
 
-			header.tileHeightMinMaxMap.resolution = tileHeightMinMaxMapResolution;
-			header.tileHeightMinMaxMap.format     = rhi::EFragmentFormat::RG16_UN_Float;
-			header.tileHeightMinMaxMap.dataOffset = static_cast<Uint32>(result.blob.size());
-			header.tileHeightMinMaxMap.dataSize   = static_cast<Uint32>(tileHeightMinMaxMapMappedData.GetSpan().size());
+			const Uint32 minMaxLevelsNum = std::min(static_cast<Uint32>(minMaxPyramid.levelResolutions.size()), CompiledTerrainHeader::maxTileHeightMinMaxLevelsNum);
+			const Uint32 minMaxDataOffset = static_cast<Uint32>(result.blob.size());
 
-			result.blob.insert(result.blob.end(), tileHeightMinMaxMapMappedData.GetSpan().begin(), tileHeightMinMaxMapMappedData.GetSpan().end());
+			for (Uint32 levelIdx = 0u; levelIdx < minMaxLevelsNum; ++levelIdx)
+			{
+				const math::Vector2u levelResolution = minMaxPyramid.levelResolutions[levelIdx];
+
+				CompiledTerrainHeader::TextureInfo& levelInfo = header.tileHeightMinMaxLevels[levelIdx];
+				levelInfo.resolution = levelResolution;
+				levelInfo.format     = TileHeightMinMaxPyramid::format;
+				levelInfo.dataOffset = minMaxDataOffset + minMaxPyramid.levelOffsets[levelIdx];
+				levelInfo.dataSize   = levelResolution.x() * levelResolution.y() * rhi::GetFragmentInfo(TileHeightMinMaxPyramid::format).bytesPerBlock;
+			}
+
+			header.tileHeightMinMaxLevelsNum = minMaxLevelsNum;
+
+			result.blob.insert(result.blob.end(), minMaxPyramid.data.begin(), minMaxPyramid.data.end());
 		}
 		else
 		{
-			SPT_LOG_ERROR(TerrainCompiler, "Failed to load terrain height map from path: {}", heightMapPath.generic_string());
+			SPT_LOG_ERROR(TerrainCompiler, "Failed to load terrain height map from path: {} (format: {})", heightMapPath.generic_string(), rhi::GetFormatName(loadedHeightMap.format));
 		}
 	}
 
@@ -263,7 +199,13 @@ std::optional<TerrainCompilationResult> CompileTerrain(const AssetInstance& asse
 			}
 		}
 
-		if (header.terrainMaterialAssetID != InvalidResourcePathID)
+		if (header.terrainMaterialAssetID != InvalidResourcePathID && !rdr::GPUApi::IsInitialized())
+		{
+			// Far LOD is baked using terrain material shaders, so it's skipped when compiling without GPU
+			SPT_LOG_WARN(TerrainCompiler, "GPU is not available. Skipping far LOD baking for terrain '{}'", asset.GetName().ToString());
+			result.skippedFarLODBake = true;
+		}
+		else if (header.terrainMaterialAssetID != InvalidResourcePathID)
 		{
 			rhi::TextureDefinition materialsMapDef;
 			materialsMapDef.resolution = header.materialIDs.resolution;
@@ -278,6 +220,7 @@ std::optional<TerrainCompilationResult> CompileTerrain(const AssetInstance& asse
 			// Flush terrain material uploads
 			gfx::GPUDeferredCommandsQueue& queue = engn::GetEngine().GetPluginsManager().GetPluginChecked<gfx::GPUDeferredCommandsQueue>();
 			queue.ForceFlushCommands(tempArena);
+			mat::MaterialsUnifiedData::Get().FlushPendingUpdates();
 			rdr::FlushPendingUploads();
 
 			rg::RenderGraphResourcesPool renderResourcesPool;
@@ -3,6 +3,7 @@
 #include "SculptorCoreTypes.h"
 #include "AssetTypes.h"
 #include "RHICore//RHITextureTypes.h"
+#include "TerrainHeightCompiler.h"
 
 
 namespace spt::rdr
@@ -19,6 +20,8 @@ struct TerrainAssetDefinition;
 
 struct CompiledTerrainHeader
 {
+	static constexpr Uint32 maxTileHeightMinMaxLevelsNum = 20u;
+
 	struct TextureInfo
 	{
 		math::Vector2u       resolution = math::Vector2u::Zero();
@@ -27,8 +30,28 @@ struct CompiledTerrainHeader
 		Uint32               dataSize   = 0u;
 	};
 
-	TextureInfo heightMap{};
-	TextureInfo tileHeightMinMaxMap{};
+	/**
+	 * Texture split to tiles that can be loaded independently.
+	 * Blob contains tiles index (array of HeightMapTile, row-major) followed by tiles data
+	 */
+	struct TiledTextureInfo
+	{
+		math::Vector2u       resolution      = math::Vector2u::Zero();
+		rhi::EFragmentFormat format          = rhi::EFragmentFormat::None;
+		math::Vector2u       tileResolution  = math::Vector2u::Zero();
+		math::Vector2u       tilesNum        = math::Vector2u::Zero();
+		Uint32               tilesIndexOffset = 0u;
+		Uint32               tilesDataOffset  = 0u;
+	};
+
+	TiledTextureInfo heightMap{};
+
+	/** Low resolution height map that is always resident. Used where streamed height map tiles are not loaded */
+	TextureInfo heightMapFallback{};
+
+	/** Min/max height of terrain tiles. Level 0 contains single terrain tiles, each next level reduces 2x2 texels of previous one */
+	lib::StaticArray<TextureInfo, maxTileHeightMinMaxLevelsNum> tileHeightMinMaxLevels{};
+	Uint32 tileHeightMinMaxLevelsNum = 0u;
 
 	TextureInfo farLODBaseColor;
 	TextureInfo farLODProps;
@@ -45,12 +68,21 @@ struct CompiledTerrainHeader
 struct TerrainCompilationResult
 {
 	lib::DynamicArray<Byte> blob;
+
+	/** Far LOD requires GPU to be baked. If it was skipped, terrain should be compiled again when GPU is available */
+	Bool skippedFarLODBake = false;
 };
 
 
 namespace terrain_compiler
 {
 
+/** Resolution of height map streaming tiles (in texels) */
+static constexpr Uint32 heightMapTileSize = 256u;
+
+/** Downsample factor of always resident fallback height map */
+static constexpr Uint32 heightMapFallbackDownsampleFactor = 8u;
+
 std::optional<TerrainCompilationResult> CompileTerrain(const AssetInstance& asset, const TerrainAssetDefinition& definition);
 
 } // terrain_compiler
@@ -0,0 +1,424 @@
+#include "TerrainHeightCompiler.h"
+#include "JobSystem.h"
+#include "MathUtils.h"
+
+
+namespace spt::as::terrain_compiler
+{
+
+namespace priv
+{
+
+static constexpr Uint32 rowsPerJob = 64u;
+
+
+struct RowsRange
+{
+	Uint32 begin = 0u;
+	Uint32 end   = 0u;
+};
+
+
+lib::DynamicArray<RowsRange> SplitRows(Uint32 rowsNum, Uint32 rowsPerRange)
+{
+	lib::DynamicArray<RowsRange> ranges;
+	ranges.reserve(math::Utils::DivideCeil(rowsNum, rowsPerRange));
+
+	for (Uint32 begin = 0u; begin < rowsNum; begin += rowsPerRange)
+	{
+		ranges.emplace_back(RowsRange{ begin, std::min(begin + rowsPerRange, rowsNum) });
+	}
+
+	return ranges;
+}
+
+
+Real32 HalfToFloat(Uint16 half)
+{
+	const Uint32 sign     = static_cast<Uint32>(half & 0x8000u) << 16;
+	const Uint32 exponent = (half >> 10) & 0x1Fu;
+	const Uint32 mantissa = half & 0x3FFu;
+
+	Uint32 bits = 0u;
+
+	if (exponent == 0u)
+	{
+		if (mantissa != 0u)
+		{
+			// Denormal - normalize it
+			Uint32 normalizedMantissa = mantissa;
+			Int32 normalizedExponent  = -1;
+			do
+			{
+				++normalizedExponent;
+				normalizedMantissa <<= 1;
+			} while ((normalizedMantissa & 0x400u) == 0u);
+
+			bits = sign | (static_cast<Uint32>(127 - 15 - normalizedExponent) << 23) | ((normalizedMantissa & 0x3FFu) << 13);
+		}
+		else
+		{
+			bits = sign;
+		}
+	}
+	else if (exponent == 0x1Fu)
+	{
+		bits = sign | 0x7F800000u | (mantissa << 13);
+	}
+	else
+	{
+		bits = sign | ((exponent + 127u - 15u) << 23) | (mantissa << 13);
+	}
+
+	Real32 result;
+	std::memcpy(&result, &bits, sizeof(Real32));
+	return result;
+}
+
+
+template<typename TType>
+TType ReadTexel(const Byte* data, SizeType texelIdx, SizeType texelSize)
+{
+	TType value;
+	std::memcpy(&value, data + texelIdx * texelSize, sizeof(TType));
+	return value;
+}
+
+
+Real32 ReadHeight(const HeightMapSource& source, SizeType texelIdx, SizeType texelSize)
+{
+	const Byte* data = source.data.data();
+
+	switch (source.format)
+	{
+	case rhi::EFragmentFormat::R8_UN_Float:
+	case rhi::EFragmentFormat::RG8_UN_Float:
+	case rhi::EFragmentFormat::RGBA8_UN_Float:
+		return static_cast<Real32>(ReadTexel<Uint8>(data, texelIdx, texelSize)) / 255.f;
+
+	case rhi::EFragmentFormat::R16_UN_Float:
+	case rhi::EFragmentFormat::RG16_UN_Float:
+	case rhi::EFragmentFormat::RGBA16_UN_Float:
+		return static_cast<Real32>(ReadTexel<Uint16>(data, texelIdx, texelSize)) / 65535.f;
+
+	case rhi::EFragmentFormat::R16_S_Float:
+	case rhi::EFragmentFormat::RG16_S_Float:
+	case rhi::EFragmentFormat::RGBA16_S_Float:
+		return HalfToFloat(ReadTexel<Uint16>(data, texelIdx, texelSize));
+
+	case rhi::EFragmentFormat::R32_S_Float:
+	case rhi::EFragmentFormat::RG32_S_Float:
+	case rhi::EFragmentFormat::RGBA32_S_Float:
+		return ReadTexel<Real32>(data, texelIdx, texelSize);
+
+	default:
+		SPT_CHECK_NO_ENTRY();
+		return 0.f;
+	}
+}
+
+
+Uint16 QuantizeHeight(Real32 height)
+{
+	// Same as UNorm conversion on GPU (round to nearest)
+	return static_cast<Uint16>(std::clamp(height, 0.f, 1.f) * 65535.f + 0.5f);
+}
+
+} // priv
+
+Bool IsSupportedHeightMapFormat(rhi::EFragmentFormat format)
+{
+	switch (format)
+	{
+	case rhi::EFragmentFormat::R8_UN_Float:
+	case rhi::EFragmentFormat::RG8_UN_Float:
+	case rhi::EFragmentFormat::RGBA8_UN_Float:
+	case rhi::EFragmentFormat::R16_UN_Float:
+	case rhi::EFragmentFormat::RG16_UN_Float:
+	case rhi::EFragmentFormat::RGBA16_UN_Float:
+	case rhi::EFragmentFormat::R16_S_Float:
+	case rhi::EFragmentFormat::RG16_S_Float:
+	case rhi::EFragmentFormat::RGBA16_S_Float:
+	case rhi::EFragmentFormat::R32_S_Float:
+	case rhi::EFragmentFormat::RG32_S_Float:
+	case rhi::EFragmentFormat::RGBA32_S_Float:
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+lib::DynamicArray<Uint16> ConvertHeightMap(const HeightMapSource& source)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(IsSupportedHeightMapFormat(source.format));
+
+	const SizeType texelSize = rhi::GetFragmentInfo(source.format).bytesPerBlock;
+	const math::Vector2u resolution = source.resolution;
+
+	SPT_CHECK(source.data.size() >= static_cast<SizeType>(resolution.x()) * resolution.y() * texelSize);
+
+	lib::DynamicArray<Uint16> heights(static_cast<SizeType>(resolution.x()) * resolution.y());
+
+	lib::DynamicArray<priv::RowsRange> ranges = priv::SplitRows(resolution.y(), priv::rowsPerJob);
+
+	js::InlineParallelForEach("Convert Terrain Height Map",
+							  ranges,
+							  [&source, &heights, texelSize, resolution](const priv::RowsRange& range)
+							  {
+								  for (Uint32 y = range.begin; y < range.end; ++y)
+								  {
+									  const SizeType rowOffset = static_cast<SizeType>(y) * resolution.x();
+									  for (Uint32 x = 0u; x < resolution.x(); ++x)
+									  {
+										  heights[rowOffset + x] = priv::QuantizeHeight(priv::ReadHeight(source, rowOffset + x, texelSize));
+									  }
+								  }
+							  });
+
+	return heights;
+}
+
+TiledHeightMap BuildTiledHeightMap(lib::Span<const Uint16> heights, math::Vector2u resolution, math::Vector2u tileResolution)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(heights.size() == static_cast<SizeType>(resolution.x()) * resolution.y());
+	SPT_CHECK(tileResolution.x() > 0u && tileResolution.y() > 0u);
+
+	TiledHeightMap tiledHeightMap;
+	tiledHeightMap.resolution     = resolution;
+	tiledHeightMap.tileResolution = tileResolution;
+	tiledHeightMap.tilesNum       = math::Utils::DivideCeil(resolution, tileResolution);
+
+	const Uint32 tilesNum = tiledHeightMap.tilesNum.x() * tiledHeightMap.tilesNum.y();
+	tiledHeightMap.tiles.resize(tilesNum);
+
+	// Compute layout first, so that tiles can be written in parallel
+	Uint32 dataOffset = 0u;
+	for (Uint32 tileY = 0u; tileY < tiledHeightMap.tilesNum.y(); ++tileY)
+	{
+		for (Uint32 tileX = 0u; tileX < tiledHeightMap.tilesNum.x(); ++tileX)
+		{
+			const math::Vector2u coords(tileX, tileY);
+			const math::Vector2u tileBegin = coords.cwiseProduct(tileResolution);
+			const math::Vector2u tileEnd   = (tileBegin + tileResolution).cwiseMin(resolution);
+
+			HeightMapTile& tile = tiledHeightMap.tiles[tileY * tiledHeightMap.tilesNum.x() + tileX];
+			tile.coords     = coords;
+			tile.resolution = tileEnd - tileBegin;
+			tile.dataOffset = dataOffset;
+			tile.dataSize   = tile.resolution.x() * tile.resolution.y() * sizeof(Uint16);
+
+			dataOffset += tile.dataSize;
+		}
+	}
+
+	tiledHeightMap.tilesData.resize(dataOffset);
+
+	js::InlineParallelForEach("Build Terrain Height Map Tiles",
+							  tiledHeightMap.tiles,
+							  [&tiledHeightMap, heights, resolution, tileResolution](HeightMapTile& tile)
+							  {
+								  const math::Vector2u tileBegin = tile.coords.cwiseProduct(tileResolution);
+
+								  Uint16* tileData = reinterpret_cast<Uint16*>(tiledHeightMap.tilesData.data() + tile.dataOffset);
+
+								  Uint16 minHeight = std::numeric_limits<Uint16>::max();
+								  Uint16 maxHeight = 0u;
+
+								  for (Uint32 y = 0u; y < tile.resolution.y(); ++y)
+								  {
+									  const Uint16* srcRow = heights.data() + static_cast<SizeType>(tileBegin.y() + y) * resolution.x() + tileBegin.x();
+									  Uint16* dstRow = tileData + y * tile.resolution.x();
+
+									  for (Uint32 x = 0u; x < tile.resolution.x(); ++x)
+									  {
+										  dstRow[x] = srcRow[x];
+										  minHeight = std::min(minHeight, srcRow[x]);
+										  maxHeight = std::max(maxHeight, srcRow[x]);
+									  }
+								  }
+
+								  tile.heightMinMax = math::Vector2f(static_cast<Real32>(minHeight), static_cast<Real32>(maxHeight)) / 65535.f;
+							  });
+
+	return tiledHeightMap;
+}
+
+lib::DynamicArray<Uint16> BuildDownsampledHeightMap(lib::Span<const Uint16> heights, math::Vector2u resolution, Uint32 downsampleFactor, math::Vector2u& outResolution)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(heights.size() == static_cast<SizeType>(resolution.x()) * resolution.y());
+	SPT_CHECK(downsampleFactor > 0u);
+
+	outResolution = math::Utils::DivideCeil(resolution, math::Vector2u::Constant(downsampleFactor));
+
+	const math::Vector2u dstResolution = outResolution;
+
+	lib::DynamicArray<Uint16> downsampled(static_cast<SizeType>(dstResolution.x()) * dstResolution.y());
+
+	lib::DynamicArray<priv::RowsRange> ranges = priv::SplitRows(dstResolution.y(), priv::rowsPerJob);
+
+	js::InlineParallelForEach("Downsample Terrain Height Map",
+							  ranges,
+							  [&downsampled, heights, resolution, dstResolution, downsampleFactor](const priv::RowsRange& range)
+							  {
+								  for (Uint32 y = range.begin; y < range.end; ++y)
+								  {
+									  const Uint32 srcYEnd = std::min((y + 1u) * downsampleFactor, resolution.y());
+
+									  for (Uint32 x = 0u; x < dstResolution.x(); ++x)
+									  {
+										  const Uint32 srcXEnd = std::min((x + 1u) * downsampleFactor, resolution.x());
+
+										  Uint64 heightsSum = 0u;
+										  Uint32 texelsNum  = 0u;
+
+										  for (Uint32 srcY = y * downsampleFactor; srcY < srcYEnd; ++srcY)
+										  {
+											  const Uint16* srcRow = heights.data() + static_cast<SizeType>(srcY) * resolution.x();
+											  for (Uint32 srcX = x * downsampleFactor; srcX < srcXEnd; ++srcX)
+											  {
+												  heightsSum += srcRow[srcX];
+												  ++texelsNum;
+											  }
+										  }
+
+										  downsampled[static_cast<SizeType>(y) * dstResolution.x() + x] = static_cast<Uint16>((heightsSum + texelsNum / 2u) / texelsNum);
+									  }
+								  }
+							  });
+
+	return downsampled;
+}
+
+TileHeightMinMaxPyramid BuildTileHeightMinMaxPyramid(lib::Span<const Uint16> heights, math::Vector2u resolution, math::Vector2f minBounds, math::Vector2f maxBounds, Real32 tileSizeMeters)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(heights.size() == static_cast<SizeType>(resolution.x()) * resolution.y());
+
+	using MinMax = lib::StaticArray<Uint16, 2u>;
+	static_assert(sizeof(MinMax) == 4u);
+
+	TileHeightMinMaxPyramid pyramid;
+
+	math::Vector2u levelResolution = ComputeTerrainTilesResolution(minBounds, maxBounds, tileSizeMeters);
+	Uint32 dataSize = 0u;
+	while (true)
+	{
+		pyramid.levelResolutions.emplace_back(levelResolution);
+		pyramid.levelOffsets.emplace_back(dataSize);
+		dataSize += levelResolution.x() * levelResolution.y() * sizeof(MinMax);
+
+		if (levelResolution == math::Vector2u::Ones())
+		{
+			break;
+		}
+
+		levelResolution = math::Utils::DivideCeil(levelResolution, math::Vector2u(2u, 2u));
+	}
+
+	pyramid.data.resize(dataSize);
+
+	const auto getLevelData = [&pyramid](SizeType levelIdx)
+	{
+		return reinterpret_cast<MinMax*>(pyramid.data.data() + pyramid.levelOffsets[levelIdx]);
+	};
+
+	// Level 0 - min/max of all height map texels that overlap terrain tile (including bilinear footprint)
+	{
+		const math::Vector2u tilesResolution = pyramid.levelResolutions[0];
+		MinMax* levelData = getLevelData(0u);
+
+		const math::Vector2f terrainSize       = maxBounds - minBounds;
+		const math::Vector2f heightMapRes      = resolution.cast<Real32>();
+		const math::Vector2i heightMapMaxTexel = resolution.cast<Int32>() - math::Vector2i::Ones();
+
+		lib::DynamicArray<priv::RowsRange> ranges = priv::SplitRows(tilesResolution.y(), 1u);
+
+		js::InlineParallelForEach("Compute Terrain Tiles Height Min Max",
+								  ranges,
+								  [&](const priv::RowsRange& range)
+								  {
+									  for (Uint32 tileY = range.begin; tileY < range.end; ++tileY)
+									  {
+										  for (Uint32 tileX = 0u; tileX < tilesResolution.x(); ++tileX)
+										  {
+											  const math::Vector2f tileMin = minBounds + math::Vector2f(static_cast<Real32>(tileX), static_cast<Real32>(tileY)) * tileSizeMeters;
+											  const math::Vector2f tileMax = (tileMin + math::Vector2f::Constant(tileSizeMeters)).cwiseMin(maxBounds);
+
+											  const math::Vector2f uvMin = (tileMin - minBounds).cwiseQuotient(terrainSize).cwiseMax(0.f).cwiseMin(1.f);
+											  const math::Vector2f uvMax = (tileMax - minBounds).cwiseQuotient(terrainSize).cwiseMax(0.f).cwiseMin(1.f);
+
+											  const math::Vector2i minTexel = (uvMin.cwiseProduct(heightMapRes) - math::Vector2f::Constant(0.5f)).array().floor().cast<Int32>().matrix()
+												  .cwiseMax(math::Vector2i::Zero()).cwiseMin(heightMapMaxTexel);
+											  const math::Vector2i maxTexel = ((uvMax.cwiseProduct(heightMapRes) - math::Vector2f::Constant(0.5f)).array().floor().cast<Int32>().matrix() + math::Vector2i::Ones())
+												  .cwiseMax(math::Vector2i::Zero()).cwiseMin(heightMapMaxTexel);
+
+											  Uint16 minHeight = std::numeric_limits<Uint16>::max();
+											  Uint16 maxHeight = 0u;
+
+											  for (Int32 y = minTexel.y(); y <= maxTexel.y(); ++y)
+											  {
+												  const Uint16* row = heights.data() + static_cast<SizeType>(y) * resolution.x();
+												  for (Int32 x = minTexel.x(); x <= maxTexel.x(); ++x)
+												  {
+													  minHeight = std::min(minHeight, row[x]);
+													  maxHeight = std::max(maxHeight, row[x]);
+												  }
+											  }
+
+											  levelData[tileY * tilesResolution.x() + tileX] = MinMax{ minHeight, maxHeight };
+										  }
+									  }
+								  });
+	}
+
+	// Next levels - reduce 2x2 texels of previous level. Levels are small, so they are built on single thread
+	for (SizeType levelIdx = 1u; levelIdx < pyramid.levelResolutions.size(); ++levelIdx)
+	{
+		const math::Vector2u prevResolution = pyramid.levelResolutions[levelIdx - 1u];
+		const math::Vector2u currResolution = pyramid.levelResolutions[levelIdx];
+
+		const MinMax* prevData = getLevelData(levelIdx - 1u);
+		MinMax* currData = getLevelData(levelIdx);
+
+		for (Uint32 y = 0u; y < currResolution.y(); ++y)
+		{
+			for (Uint32 x = 0u; x < currResolution.x(); ++x)
+			{
+				MinMax result{ std::numeric_limits<Uint16>::max(), Uint16(0u) };
+
+				for (Uint32 prevY = y * 2u; prevY < std::min(y * 2u + 2u, prevResolution.y()); ++prevY)
+				{
+					for (Uint32 prevX = x * 2u; prevX < std::min(x * 2u + 2u, prevResolution.x()); ++prevX)
+					{
+						const MinMax& prev = prevData[prevY * prevResolution.x() + prevX];
+						result[0] = std::min(result[0], prev[0]);
+						result[1] = std::max(result[1], prev[1]);
+					}
+				}
+
+				currData[y * currResolution.x() + x] = result;
+			}
+		}
+	}
+
+	return pyramid;
+}
+
+math::Vector2u ComputeTerrainTilesResolution(math::Vector2f minBounds, math::Vector2f maxBounds, Real32 tileSizeMeters)
+{
+	const math::Vector2f terrainSize = maxBounds - minBounds;
+
+	return math::Vector2u(
+		static_cast<Uint32>(std::ceil(terrainSize.x() / tileSizeMeters)),
+		static_cast<Uint32>(std::ceil(terrainSize.y() / tileSizeMeters)));
+}
+
+} // spt::as::terrain_compiler
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "TerrainAssetMacros.h"
+#include "SculptorCoreTypes.h"
+#include "RHICore/RHITextureTypes.h"
+
+
+namespace spt::as::terrain_compiler
+{
+
+/**
+ * CPU implementation of terrain height compilation. Doesn't require GPU, so terrains can be compiled on build machines.
+ * Heights are stored as normalized 16-bit values (R16_UN_Float)
+ */
+
+struct HeightMapSource
+{
+	/** Linear texels of source texture. Only first channel is used */
+	lib::Span<const Byte> data;
+	rhi::EFragmentFormat  format     = rhi::EFragmentFormat::None;
+	math::Vector2u        resolution = math::Vector2u::Zero();
+};
+
+
+struct HeightMapTile
+{
+	math::Vector2u coords     = math::Vector2u::Zero();
+	math::Vector2u resolution = math::Vector2u::Zero();
+
+	/** Offset of tile data, relative to beginning of tiles data */
+	Uint32 dataOffset = 0u;
+	Uint32 dataSize   = 0u;
+
+	/** Normalized min and max height of all texels in tile */
+	math::Vector2f heightMinMax = math::Vector2f::Zero();
+};
+
+
+struct TiledHeightMap
+{
+	math::Vector2u resolution     = math::Vector2u::Zero();
+	math::Vector2u tileResolution = math::Vector2u::Zero();
+	math::Vector2u tilesNum       = math::Vector2u::Zero();
+
+	/** Tiles are stored in row-major order. Data of each tile is stored linearly */
+	lib::DynamicArray<HeightMapTile> tiles;
+	lib::DynamicArray<Byte>          tilesData;
+};
+
+
+struct TileHeightMinMaxPyramid
+{
+	static constexpr rhi::EFragmentFormat format = rhi::EFragmentFormat::RG16_UN_Float;
+
+	/** Level 0 stores min/max heights of terrain tiles. Each next level stores min/max of 2x2 texels of previous level */
+	lib::DynamicArray<math::Vector2u> levelResolutions;
+	lib::DynamicArray<Uint32>         levelOffsets;
+	lib::DynamicArray<Byte>           data;
+};
+
+
+/** Returns true if height values can be read from textures of given format */
+TERRAIN_ASSET_API Bool IsSupportedHeightMapFormat(rhi::EFragmentFormat format);
+
+/** Converts source height map to normalized 16-bit heights. Returns linear array of heights */
+TERRAIN_ASSET_API lib::DynamicArray<Uint16> ConvertHeightMap(const HeightMapSource& source);
+
+/** Splits linear height map to tiles, that can be streamed independently */
+TERRAIN_ASSET_API TiledHeightMap BuildTiledHeightMap(lib::Span<const Uint16> heights, math::Vector2u resolution, math::Vector2u tileResolution);
+
+/** Builds low resolution height map (box filter). Used when streamed tiles are not resident. Returns linear array of heights */
+TERRAIN_ASSET_API lib::DynamicArray<Uint16> BuildDownsampledHeightMap(lib::Span<const Uint16> heights, math::Vector2u resolution, Uint32 downsampleFactor, math::Vector2u& outResolution);
+
+TERRAIN_ASSET_API TileHeightMinMaxPyramid BuildTileHeightMinMaxPyramid(lib::Span<const Uint16> heights, math::Vector2u resolution, math::Vector2f minBounds, math::Vector2f maxBounds, Real32 tileSizeMeters);
+
+TERRAIN_ASSET_API math::Vector2u ComputeTerrainTilesResolution(math::Vector2f minBounds, math::Vector2f maxBounds, Real32 tileSizeMeters);
+
+} // spt::as::terrain_compiler
@@ -1,6 +1,8 @@
 #include "gtest/gtest.h"
 #include "AssetsSystem.h"
 #include "TerrainAsset.h"
+#include "TerrainHeightCompiler.h"
+#include "Terrain/TerrainTilesResidency.h"
 #include "Engine.h"
 #include "GPUApi.h"
 #include "Transfers/GPUDeferredCommandsQueue.h"
@@ -91,6 +93,290 @@ TEST_F(TerrainAssetTests, CreateTerrainWithoutHeightMap)
 	EXPECT_TRUE(m_assetsSystem.DeleteAsset(terrainMaterialAssetPath) == EDeleteResult::Success);
 }
 
+TEST_F(TerrainAssetTests, CompileHeightMapOnCPU)
+{
+	const math::Vector2u resolution(600u, 520u);
+	const math::Vector2u tileResolution(256u, 256u);
+
+	const math::Vector2f minBounds(-64.f, -64.f);
+	const math::Vector2f maxBounds(64.f, 64.f);
+	const Real32 tileSizeMeters = 32.f;
+
+	lib::DynamicArray<Real32> sourceHeights(resolution.x() * resolution.y());
+	for (Uint32 y = 0u; y < resolution.y(); ++y)
+	{
+		for (Uint32 x = 0u; x < resolution.x(); ++x)
+		{
+			sourceHeights[y * resolution.x() + x] = static_cast<Real32>(x + y) / static_cast<Real32>(resolution.x() + resolution.y());
+		}
+	}
+
+	const terrain_compiler::HeightMapSource source
+	{
+		.data       = lib::Span<const Byte>(reinterpret_cast<const Byte*>(sourceHeights.data()), sourceHeights.size() * sizeof(Real32)),
+		.format     = rhi::EFragmentFormat::R32_S_Float,
+		.resolution = resolution
+	};
+
+	const lib::DynamicArray<Uint16> heights = terrain_compiler::ConvertHeightMap(source);
+	ASSERT_EQ(heights.size(), sourceHeights.size());
+	EXPECT_EQ(heights[0], 0u);
+	EXPECT_NEAR(static_cast<Real32>(heights[heights.size() - 1u]) / 65535.f, sourceHeights.back(), 1.f / 65535.f);
+
+	const terrain_compiler::TiledHeightMap tiledHeightMap = terrain_compiler::BuildTiledHeightMap(heights, resolution, tileResolution);
+	EXPECT_EQ(tiledHeightMap.tilesNum, math::Vector2u(3u, 3u));
+	ASSERT_EQ(tiledHeightMap.tiles.size(), 9u);
+	EXPECT_EQ(tiledHeightMap.tilesData.size(), heights.size() * sizeof(Uint16));
+
+	// Last tile is partial. Its data must match source texels
+	const terrain_compiler::HeightMapTile& lastTile = tiledHeightMap.tiles.back();
+	EXPECT_EQ(lastTile.coords, math::Vector2u(2u, 2u));
+	EXPECT_EQ(lastTile.resolution, math::Vector2u(600u - 512u, 520u - 512u));
+
+	const Uint16* lastTileData = reinterpret_cast<const Uint16*>(tiledHeightMap.tilesData.data() + lastTile.dataOffset);
+	for (Uint32 y = 0u; y < lastTile.resolution.y(); ++y)
+	{
+		for (Uint32 x = 0u; x < lastTile.resolution.x(); ++x)
+		{
+			EXPECT_EQ(lastTileData[y * lastTile.resolution.x() + x], heights[(512u + y) * resolution.x() + 512u + x]);
+		}
+	}
+
+	EXPECT_FLOAT_EQ(lastTile.heightMinMax.x(), static_cast<Real32>(heights[512u * resolution.x() + 512u]) / 65535.f);
+	EXPECT_FLOAT_EQ(lastTile.heightMinMax.y(), static_cast<Real32>(heights.back()) / 65535.f);
+
+	const terrain_compiler::TileHeightMinMaxPyramid pyramid = terrain_compiler::BuildTileHeightMinMaxPyramid(heights, resolution, minBounds, maxBounds, tileSizeMeters);
+	ASSERT_EQ(pyramid.levelResolutions.size(), 3u);
+	EXPECT_EQ(pyramid.levelResolutions[0], math::Vector2u(4u, 4u));
+	EXPECT_EQ(pyramid.levelResolutions[2], math::Vector2u(1u, 1u));
+
+	// Top level must contain min/max of the whole height map
+	const Uint16* topLevel = reinterpret_cast<const Uint16*>(pyramid.data.data() + pyramid.levelOffsets[2]);
+	EXPECT_EQ(topLevel[0], *std::min_element(heights.begin(), heights.end()));
+	EXPECT_EQ(topLevel[1], *std::max_element(heights.begin(), heights.end()));
+}
+
+namespace residency_tests
+{
+
+/** Completes all loads immediately, as if tile reads finished within the same frame */
+void CompleteAllLoads(rsc::TerrainTilesResidency& residency, const rsc::TerrainTilesResidencyUpdate& update)
+{
+	for (const rsc::TerrainTileLoadRequest& load : update.loads)
+	{
+		residency.CompleteLoad(load);
+	}
+}
+
+
+void ValidatePageTable(const rsc::TerrainTilesResidency& residency)
+{
+	lib::DynamicArray<Bool> usedSlots(residency.GetPhysicalSlotsNum(), false);
+
+	for (const Uint32 slot : residency.GetPageTable())
+	{
+		if (slot != rsc::TerrainTilesResidency::invalidSlot)
+		{
+			ASSERT_LT(slot, residency.GetPhysicalSlotsNum());
+			EXPECT_FALSE(usedSlots[slot]);
+			usedSlots[slot] = true;
+		}
+	}
+}
+
+} // residency_tests
+
+TEST(TerrainTilesResidencyTests, RespectsMemoryBudgetOnCameraPath)
+{
+	rsc::TerrainTilesResidencyDefinition definition;
+	definition.tilesNum        = math::Vector2u(16u, 16u);
+	definition.tileDataSize    = 1024u;
+	definition.memoryBudget    = 20u * 1024u;
+	definition.stagingSlotsNum = 4u;
+
+	rsc::TerrainTilesResidency residency(definition);
+	EXPECT_EQ(residency.GetPhysicalSlotsNum(), 20u);
+
+	const Real32 radius = 1.5f;
+
+	// Camera flies diagonally through the terrain and then back along the bottom edge
+	lib::DynamicArray<math::Vector2f> cameraPath;
+	for (Uint32 step = 0u; step < 64u; ++step)
+	{
+		cameraPath.emplace_back(math::Vector2f::Constant(static_cast<Real32>(step) * 0.25f));
+	}
+	for (Uint32 step = 0u; step < 64u; ++step)
+	{
+		cameraPath.emplace_back(math::Vector2f(16.f - static_cast<Real32>(step) * 0.25f, 0.5f));
+	}
+
+	Uint64 frameIdx = 1u;
+	for (const math::Vector2f& cameraLocation : cameraPath)
+	{
+		// Stay in the same location for few frames, so that all reads can finish
+		for (Uint32 frame = 0u; frame < 4u; ++frame)
+		{
+			residency.RequestTilesInRadius(cameraLocation, radius);
+			const rsc::TerrainTilesResidencyUpdate update = residency.Update(frameIdx++);
+
+			EXPECT_LE(update.loads.size(), definition.stagingSlotsNum);
+
+			residency_tests::CompleteAllLoads(residency, update);
+
+			const rsc::TerrainTilesResidencyStats& stats = residency.GetStats();
+			EXPECT_LE(stats.residentTilesNum + stats.pendingTilesNum, stats.physicalSlotsNum);
+			residency_tests::ValidatePageTable(residency);
+		}
+
+		// Tile under the camera must be resident
+		const math::Vector2u cameraTile = cameraLocation.cast<Uint32>().cwiseMin(definition.tilesNum - math::Vector2u::Ones());
+		EXPECT_NE(residency.GetPhysicalSlot(cameraTile), rsc::TerrainTilesResidency::invalidSlot);
+	}
+
+	EXPECT_GT(residency.GetStats().totalEvictionsNum, 0u);
+	EXPECT_EQ(residency.GetStats().pendingTilesNum, 0u);
+}
+
+TEST(TerrainTilesResidencyTests, EvictsLeastRecentlyUsedTiles)
+{
+	rsc::TerrainTilesResidencyDefinition definition;
+	definition.tilesNum        = math::Vector2u(8u, 1u);
+	definition.tileDataSize    = 256u;
+	definition.memoryBudget    = 4u * 256u;
+	definition.stagingSlotsNum = 8u;
+
+	rsc::TerrainTilesResidency residency(definition);
+
+	for (Uint32 tileX = 0u; tileX < 4u; ++tileX)
+	{
+		residency.RequestTile(math::Vector2u(tileX, 0u), 0.f);
+	}
+	residency_tests::CompleteAllLoads(residency, residency.Update(1u));
+	EXPECT_EQ(residency.GetStats().residentTilesNum, 4u);
+
+	// Tiles 2 and 3 are still used
+	residency.RequestTile(math::Vector2u(2u, 0u), 0.f);
+	residency.RequestTile(math::Vector2u(3u, 0u), 0.f);
+	residency_tests::CompleteAllLoads(residency, residency.Update(2u));
+
+	residency.RequestTile(math::Vector2u(4u, 0u), 0.f);
+	residency.RequestTile(math::Vector2u(5u, 0u), 1.f);
+	const rsc::TerrainTilesResidencyUpdate update = residency.Update(3u);
+
+	ASSERT_EQ(update.loads.size(), 2u);
+	ASSERT_EQ(update.evictedTiles.size(), 2u);
+	EXPECT_TRUE(std::find(update.evictedTiles.begin(), update.evictedTiles.end(), 0u) != update.evictedTiles.end());
+	EXPECT_TRUE(std::find(update.evictedTiles.begin(), update.evictedTiles.end(), 1u) != update.evictedTiles.end());
+
+	residency_tests::CompleteAllLoads(residency, update);
+
+	EXPECT_EQ(residency.GetPhysicalSlot(math::Vector2u(0u, 0u)), rsc::TerrainTilesResidency::invalidSlot);
+	EXPECT_EQ(residency.GetPhysicalSlot(math::Vector2u(1u, 0u)), rsc::TerrainTilesResidency::invalidSlot);
+	EXPECT_NE(residency.GetPhysicalSlot(math::Vector2u(2u, 0u)), rsc::TerrainTilesResidency::invalidSlot);
+	EXPECT_NE(residency.GetPhysicalSlot(math::Vector2u(3u, 0u)), rsc::TerrainTilesResidency::invalidSlot);
+	EXPECT_NE(residency.GetPhysicalSlot(math::Vector2u(4u, 0u)), rsc::TerrainTilesResidency::invalidSlot);
+	EXPECT_NE(residency.GetPhysicalSlot(math::Vector2u(5u, 0u)), rsc::TerrainTilesResidency::invalidSlot);
+	residency_tests::ValidatePageTable(residency);
+}
+
+TEST(TerrainTilesResidencyTests, NeverEvictsTilesRequestedInCurrentFrame)
+{
+	rsc::TerrainTilesResidencyDefinition definition;
+	definition.tilesNum        = math::Vector2u(4u, 1u);
+	definition.tileDataSize    = 256u;
+	definition.memoryBudget    = 2u * 256u;
+	definition.stagingSlotsNum = 4u;
+
+	rsc::TerrainTilesResidency residency(definition);
+
+	residency.RequestTile(math::Vector2u(0u, 0u), 0.f);
+	residency.RequestTile(math::Vector2u(1u, 0u), 0.f);
+	residency_tests::CompleteAllLoads(residency, residency.Update(1u));
+
+	// Tile 2 has lower priority than resident tiles, so it must wait until budget allows it
+	residency.RequestTile(math::Vector2u(0u, 0u), 0.f);
+	residency.RequestTile(math::Vector2u(1u, 0u), 1.f);
+	residency.RequestTile(math::Vector2u(2u, 0u), 2.f);
+	const rsc::TerrainTilesResidencyUpdate update = residency.Update(2u);
+
+	EXPECT_TRUE(update.loads.empty());
+	EXPECT_TRUE(update.evictedTiles.empty());
+	EXPECT_EQ(residency.GetStats().lastMissingNum, 1u);
+}
+
+TEST(TerrainTilesResidencyTests, LoadsMostImportantTilesFirst)
+{
+	rsc::TerrainTilesResidencyDefinition definition;
+	definition.tilesNum        = math::Vector2u(8u, 1u);
+	definition.tileDataSize    = 256u;
+	definition.memoryBudget    = 8u * 256u;
+	definition.stagingSlotsNum = 2u;
+
+	rsc::TerrainTilesResidency residency(definition);
+
+	for (Uint32 tileX = 0u; tileX < 6u; ++tileX)
+	{
+		residency.RequestTile(math::Vector2u(tileX, 0u), static_cast<Real32>(6u - tileX));
+	}
+	// Merged request keeps the most important priority
+	residency.RequestTile(math::Vector2u(0u, 0u), 0.5f);
+
+	const rsc::TerrainTilesResidencyUpdate update = residency.Update(1u);
+
+	// Only two reads can be in flight
+	ASSERT_EQ(update.loads.size(), 2u);
+	EXPECT_EQ(update.loads[0].tileIdx, 0u);
+	EXPECT_EQ(update.loads[1].tileIdx, 5u);
+	EXPECT_EQ(residency.GetStats().lastRequestedNum, 6u);
+	EXPECT_EQ(residency.GetStats().lastMissingNum, 6u);
+
+	// No staging slots until reads are completed
+	residency.RequestTile(math::Vector2u(4u, 0u), 0.f);
+	EXPECT_TRUE(residency.Update(2u).loads.empty());
+
+	residency_tests::CompleteAllLoads(residency, update);
+
+	residency.RequestTile(math::Vector2u(4u, 0u), 0.f);
+	const rsc::TerrainTilesResidencyUpdate nextUpdate = residency.Update(3u);
+	ASSERT_EQ(nextUpdate.loads.size(), 1u);
+	EXPECT_EQ(nextUpdate.loads[0].tileIdx, 4u);
+}
+
+TEST(TerrainTilesResidencyTests, PageTableChangesOnlyWhenLoadIsCompleted)
+{
+	rsc::TerrainTilesResidencyDefinition definition;
+	definition.tilesNum        = math::Vector2u(2u, 2u);
+	definition.tileDataSize    = 256u;
+	definition.memoryBudget    = 4u * 256u;
+	definition.stagingSlotsNum = 4u;
+
+	rsc::TerrainTilesResidency residency(definition);
+
+	// Initial page table must be uploaded
+	EXPECT_TRUE(residency.FlushPageTableChanges());
+	EXPECT_FALSE(residency.FlushPageTableChanges());
+
+	residency.RequestTile(math::Vector2u(1u, 1u), 0.f);
+	const rsc::TerrainTilesResidencyUpdate update = residency.Update(1u);
+	ASSERT_EQ(update.loads.size(), 1u);
+
+	// Tile is pending - shaders must not see it yet
+	EXPECT_EQ(residency.GetPhysicalSlot(math::Vector2u(1u, 1u)), rsc::TerrainTilesResidency::invalidSlot);
+	EXPECT_FALSE(residency.FlushPageTableChanges());
+	EXPECT_EQ(residency.GetStats().pendingTilesNum, 1u);
+
+	// Requesting pending tile again doesn't start another load
+	residency.RequestTile(math::Vector2u(1u, 1u), 0.f);
+	EXPECT_TRUE(residency.Update(2u).loads.empty());
+
+	residency.CompleteLoad(update.loads[0]);
+
+	EXPECT_EQ(residency.GetPhysicalSlot(math::Vector2u(1u, 1u)), update.loads[0].physicalSlot);
+	EXPECT_TRUE(residency.FlushPageTableChanges());
+	EXPECT_EQ(residency.GetStats().pendingTilesNum, 0u);
+	EXPECT_EQ(residency.GetStats().residentTilesNum, 1u);
+}
+
 } // spt::as::tests
 
 
@@ -78,6 +78,31 @@ TEST(BlackboardSerialization, BasicSerializationMultipleComponents)
 	EXPECT_EQ(copyData2->value2, originalData2.value2);
 }
 
+TEST(BlackboardSerialization, BinarySerializationMultipleComponents)
+{
+	lib::Blackboard originalBlackboard;
+	BBDataType1& originalData1 = originalBlackboard.Create<BBDataType1>(BBDataType1{ .value = 42u });
+	BBDataType2& originalData2 = originalBlackboard.Create<BBDataType2>(BBDataType2{ .value2 = 42u });
+
+	const lib::DynamicArray<Byte> data = srl::SerializationHelper::SerializeStructBinary(originalBlackboard);
+
+	EXPECT_TRUE(!data.empty());
+
+	lib::Blackboard copiedBlackboard;
+
+	EXPECT_TRUE(srl::SerializationHelper::DeserializeStructBinary(copiedBlackboard, data));
+
+	const BBDataType1* copyData1 = copiedBlackboard.Find<BBDataType1>();
+	const BBDataType2* copyData2 = copiedBlackboard.Find<BBDataType2>();
+
+	EXPECT_TRUE(copyData1 != nullptr);
+	EXPECT_EQ(copyData1->value, originalData1.value);
+
+	EXPECT_TRUE(copyData2 != nullptr);
+	EXPECT_EQ(copyData2->value1, originalData2.value1);
+	EXPECT_EQ(copyData2->value2, originalData2.value2);
+}
+
 } // spt::lib::tests
 
 
@@ -21,6 +21,7 @@ void Paths::Initialize(const CommandLineArguments& cmdLineArgs)
 	savedPath           = enginePath / "Saved";
 	tracesPath          = enginePath / "Saved/Traces";
 	gpuCrashDumpsPath   = enginePath / "Saved/GPUCrashDumps";
+	pipelineCachePath   = enginePath / "Saved/PipelineCache";
 	contentPath         = enginePath / "Content";
 	executablePath      = platf::Platform::GetExecutablePath();
 	executableDirectory = executablePath.parent_path().string();
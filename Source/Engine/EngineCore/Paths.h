@@ -22,6 +22,7 @@ public:
 	lib::Path savedPath;
 	lib::Path tracesPath;
 	lib::Path gpuCrashDumpsPath;
+	lib::Path pipelineCachePath;
 	lib::Path contentPath;
 	lib::Path executablePath;
 	lib::Path executableDirectory;
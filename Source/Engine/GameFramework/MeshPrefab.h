@@ -48,6 +48,9 @@ struct MeshEntity
 		rsc::MaterialSlotsChunkHandle renderMaterialSlots;
 		rsc::RetainedDrawHandle       draw;
 		rsc::RTInstanceHandle         rtInstance;
+
+		/** Set when owning prefab was moved after render instance was created */
+		Bool isTransformDirty = false;
 	} render;
 };
 
@@ -66,7 +69,7 @@ struct MeshesChunk
 struct WorldMeshes
 {
 	WorldMeshes()
-		: chunks("World_MeshesChunksPool")
+		: chunks("World_MeshesChunksPool", 128u, rsc::maxRenderInstancesNum)
 	{
 	}
 
@@ -20,6 +20,11 @@ void WorldPlacementSystem::SetBiome(const rsc::BiomeDefinition& biome, lib::Dyna
 
 		placementState.entries.resize(placementDef.resolution * placementDef.resolution);
 	}
+
+	m_recyclePools.clear();
+	m_recyclePools.resize(m_placementAssets.size());
+
+	m_totalStatistics = PlacementStatistics{};
 }
 
 void WorldPlacementSystem::ProcessPlacements(gf::World& world, rsc::SceneRendererHandle sceneRenderer)
@@ -36,35 +41,31 @@ void WorldPlacementSystem::ProcessPlacements(gf::World& world, rsc::SceneRendere
 
 	PlacementData placementData{ world, *this };
 
+	BeginPlacementsProcessing();
+
 	rsc::PlacementProcessor processor([](void* customData, const rsc::PlacementProcessData& processData)
 	{
 		const PlacementData& data = *reinterpret_cast<PlacementData*>(customData);
+		data.placementSystem.ApplyPlacements(data.world, processData);
+	});
 
-		PlacementState& placementState = data.placementSystem.m_placementStates[processData.placementDefIdx];
+	sceneRendererAPI->ProcessPlacements(sceneRenderer, processor, &placementData);
 
-		for (const rsc::PlacementEntry& placement : processData.placements)
-		{
-			PlacementEntryState& entryState = placementState.entries[placement.entryIdx];
-			if (entryState.prefabInstance.IsValid())
-			{
-				data.world.DestroyPrefabInstance(placementState.entries[placement.entryIdx].prefabInstance);
-				entryState.prefabInstance = PrefabInstanceHandle{};
-			}
+	EndPlacementsProcessing(world);
+}
 
-			if (placement.prefabIdx != idxNone<Uint32>)
-			{
-				const as::PrefabAssetHandle& prefabHandle = data.placementSystem.m_placementAssets[placement.prefabIdx];
-				entryState.prefabInstance = data.world.SpawnPrefab(prefabHandle,
-																   gf::PrefabSpawnParams
-																   {
-																	   .location = placement.location,
-																	   .scale = math::Vector3f::Constant(placement.scale),
-																   });
-			}
-		}
-	});
+void WorldPlacementSystem::ApplyPlacementResults(gf::World& world, lib::Span<const rsc::PlacementProcessData> results)
+{
+	SPT_PROFILER_FUNCTION();
 
-	sceneRendererAPI->ProcessPlacements(sceneRenderer, processor, &placementData);
+	BeginPlacementsProcessing();
+
+	for (const rsc::PlacementProcessData& processData : results)
+	{
+		ApplyPlacements(world, processData);
+	}
+
+	EndPlacementsProcessing(world);
 }
 
 rsc::PlacementCommand WorldPlacementSystem::CreatePlacementCommand(engn::FrameContext& frame, math::Vector3f location)
@@ -87,4 +88,126 @@ rsc::PlacementCommand WorldPlacementSystem::CreatePlacementCommand(engn::FrameCo
 	return placementCommand;
 }
 
+PrefabSpawnParams WorldPlacementSystem::CreateSpawnParams(const rsc::PlacementEntry& placement) const
+{
+	return PrefabSpawnParams
+	{
+		.location = placement.location,
+		.scale    = math::Vector3f::Constant(placement.scale),
+	};
+}
+
+void WorldPlacementSystem::BeginPlacementsProcessing()
+{
+	m_lastStatistics = PlacementStatistics{};
+}
+
+void WorldPlacementSystem::ApplyPlacements(gf::World& world, const rsc::PlacementProcessData& processData)
+{
+	// Placement results are processed in two steps. First, changed entries release their instances to per-prefab pools (or are moved in place if prefab didn't change)
+	// Then, pending spawns claim released instances of the same prefab, so only transforms have to be updated, and render scene objects (including material slots) are reused
+	PlacementState& placementState = m_placementStates[processData.placementDefIdx];
+
+	for (const rsc::PlacementEntry& placement : processData.placements)
+	{
+		PlacementEntryState& entryState = placementState.entries[placement.entryIdx];
+
+		if (entryState.prefabInstance.IsValid())
+		{
+			if (entryState.prefabIdx == placement.prefabIdx)
+			{
+				world.SetPrefabInstanceTransform(entryState.prefabInstance, CreateSpawnParams(placement));
+				++m_lastStatistics.movedInstancesNum;
+				continue;
+			}
+
+			ReleaseInstance(world, entryState.prefabInstance, entryState.prefabIdx);
+			entryState.prefabInstance = PrefabInstanceHandle{};
+			entryState.prefabIdx      = idxNone<Uint32>;
+		}
+
+		if (placement.prefabIdx != idxNone<Uint32>)
+		{
+			m_pendingSpawns.emplace_back(PendingSpawn{ processData.placementDefIdx, placement });
+		}
+	}
+}
+
+void WorldPlacementSystem::EndPlacementsProcessing(gf::World& world)
+{
+	ResolvePendingSpawns(world);
+
+	m_totalStatistics.spawnedInstancesNum   += m_lastStatistics.spawnedInstancesNum;
+	m_totalStatistics.recycledInstancesNum  += m_lastStatistics.recycledInstancesNum;
+	m_totalStatistics.movedInstancesNum     += m_lastStatistics.movedInstancesNum;
+	m_totalStatistics.destroyedInstancesNum += m_lastStatistics.destroyedInstancesNum;
+}
+
+void WorldPlacementSystem::ReleaseInstance(gf::World& world, PrefabInstanceHandle instance, Uint32 prefabIdx)
+{
+	if (prefabIdx < m_recyclePools.size())
+	{
+		m_recyclePools[prefabIdx].emplace_back(instance);
+	}
+	else
+	{
+		// Prefab is not part of current biome, so it can't be reused
+		world.DestroyPrefabInstance(instance);
+		++m_lastStatistics.destroyedInstancesNum;
+	}
+}
+
+void WorldPlacementSystem::ResolvePendingSpawns(gf::World& world)
+{
+	SPT_PROFILER_FUNCTION();
+
+	for (const PendingSpawn& spawn : m_pendingSpawns)
+	{
+		const rsc::PlacementEntry& placement = spawn.placement;
+
+		PlacementEntryState& entryState = m_placementStates[spawn.placementDefIdx].entries[placement.entryIdx];
+
+		// Entry could be placed multiple times during single call. In such case only the last placement is kept
+		if (entryState.prefabInstance.IsValid())
+		{
+			world.DestroyPrefabInstance(entryState.prefabInstance);
+			++m_lastStatistics.destroyedInstancesNum;
+		}
+
+		const PrefabSpawnParams spawnParams = CreateSpawnParams(placement);
+
+		lib::DynamicArray<PrefabInstanceHandle>& recyclePool = m_recyclePools[placement.prefabIdx];
+
+		if (!recyclePool.empty())
+		{
+			entryState.prefabInstance = recyclePool.back();
+			recyclePool.pop_back();
+
+			world.SetPrefabInstanceTransform(entryState.prefabInstance, spawnParams);
+			++m_lastStatistics.recycledInstancesNum;
+		}
+		else
+		{
+			entryState.prefabInstance = world.SpawnPrefab(m_placementAssets[placement.prefabIdx], spawnParams);
+			++m_lastStatistics.spawnedInstancesNum;
+		}
+
+		entryState.prefabIdx = placement.prefabIdx;
+	}
+
+	m_pendingSpawns.clear();
+
+	for (lib::DynamicArray<PrefabInstanceHandle>& recyclePool : m_recyclePools)
+	{
+		for (PrefabInstanceHandle instance : recyclePool)
+		{
+			world.DestroyPrefabInstance(instance);
+		}
+
+		m_lastStatistics.destroyedInstancesNum += static_cast<Uint32>(recyclePool.size());
+
+		recyclePool.clear();
+	}
+}
+
 } // spt::gf
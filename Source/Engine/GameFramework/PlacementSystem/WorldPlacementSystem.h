@@ -12,6 +12,21 @@ namespace spt::gf
 {
 
 class World;
+struct PrefabSpawnParams;
+
+
+struct PlacementStatistics
+{
+	Uint32 spawnedInstancesNum   = 0u;
+
+	/** Instances released by one entry and reused by other entry with the same prefab */
+	Uint32 recycledInstancesNum  = 0u;
+
+	/** Entries that were placed again with the same prefab, so their instance was only moved */
+	Uint32 movedInstancesNum     = 0u;
+
+	Uint32 destroyedInstancesNum = 0u;
+};
 
 
 class WorldPlacementSystem
@@ -24,14 +39,40 @@ public:
 	void                  ProcessPlacements(gf::World& world, rsc::SceneRendererHandle sceneRenderer);
 	rsc::PlacementCommand CreatePlacementCommand(engn::FrameContext& frame, math::Vector3f location);
 
+	/** Applies placement results to world. ProcessPlacements uses it with results generated by scene renderer */
+	void ApplyPlacementResults(gf::World& world, lib::Span<const rsc::PlacementProcessData> results);
+
+	/** Statistics of the last ProcessPlacements call */
+	const PlacementStatistics& GetLastStatistics() const { return m_lastStatistics; }
+
+	/** Statistics accumulated since biome was set */
+	const PlacementStatistics& GetTotalStatistics() const { return m_totalStatistics; }
+
 private:
 
+	struct PendingSpawn
+	{
+		Uint32              placementDefIdx;
+		rsc::PlacementEntry placement;
+	};
+
+	PrefabSpawnParams CreateSpawnParams(const rsc::PlacementEntry& placement) const;
+
+	void BeginPlacementsProcessing();
+	void ApplyPlacements(gf::World& world, const rsc::PlacementProcessData& processData);
+	void EndPlacementsProcessing(gf::World& world);
+
+	void ReleaseInstance(gf::World& world, PrefabInstanceHandle instance, Uint32 prefabIdx);
+
+	void ResolvePendingSpawns(gf::World& world);
+
 	rsc::BiomeDefinition                     m_biome;
 	lib::DynamicArray<as::PrefabAssetHandle> m_placementAssets;
 
 	struct PlacementEntryState
 	{
-		PrefabInstanceHandle prefabInstance; 
+		PrefabInstanceHandle prefabInstance;
+		Uint32               prefabIdx = idxNone<Uint32>;
 	};
 
 	struct PlacementState
@@ -41,6 +82,14 @@ private:
 	};
 
 	lib::DynamicArray<PlacementState> m_placementStates;
+
+	/** Instances released during current ProcessPlacements call, grouped by prefab. They are reused by spawns of the same prefab and destroyed if nothing claims them */
+	lib::DynamicArray<lib::DynamicArray<PrefabInstanceHandle>> m_recyclePools;
+
+	lib::DynamicArray<PendingSpawn> m_pendingSpawns;
+
+	PlacementStatistics m_lastStatistics;
+	PlacementStatistics m_totalStatistics;
 };
 
 } // spt::gf
@@ -29,7 +29,7 @@ using PrefabInstanceHandle = lib::PagedGenerationalPoolHandle<PrefabInstance>;
 struct WorldPrefabs
 {
 	WorldPrefabs()
-		: instances("World_PrefabInstancesPool")
+		: instances("World_PrefabInstancesPool", 128u, rsc::maxRenderInstancesNum)
 	{
 	}
 
@@ -11,6 +11,30 @@ SPT_DEFINE_LOG_CATEGORY(World, true);
 namespace spt::gf
 {
 
+namespace priv
+{
+
+/** Render scene changes of a single mesh. Updates are prepared in parallel and then committed to render scene in batches */
+struct MeshRenderUpdate
+{
+	MeshEntity*    mesh = nullptr;
+	math::Affine3f transform;
+
+	/** Range of material entities prepared for new material slots chain */
+	Uint32 materialsOffset = 0u;
+	Uint32 materialsNum    = 0u;
+
+	Bool createInstance      = false;
+	Bool updateTransform     = false;
+	Bool createMaterialSlots = false;
+};
+
+
+static constexpr SizeType meshesPerPrepareBatch = 1024u;
+
+} // priv
+
+
 World::World()
 	: prefabs(*(new WorldPrefabs()))
 	, meshes(*(new WorldMeshes()))
@@ -77,6 +101,31 @@ void World::DestroyPrefabInstance(PrefabInstanceHandle instanceHandle)
 	prefabs.instances.Delete(instanceHandle);
 }
 
+void World::SetPrefabInstanceTransform(PrefabInstanceHandle instanceHandle, const PrefabSpawnParams& params)
+{
+	SPT_PROFILER_FUNCTION();
+
+	PrefabInstance& instance = prefabs.instances.GetRef(instanceHandle);
+	instance.transform.location = params.location;
+	instance.transform.rotation = params.rotation;
+	instance.transform.scale    = params.scale;
+
+	MeshesChunkHandle currentChunk = instance.meshesChunk;
+
+	while (currentChunk.IsValid())
+	{
+		MeshesChunk& chunk = meshes.chunks.GetRef(currentChunk);
+		for (MeshEntity& mesh : chunk.meshes)
+		{
+			mesh.render.isTransformDirty = true;
+		}
+
+		meshes.chunks.MarkAsDirty(currentChunk);
+
+		currentChunk = chunk.next;
+	}
+}
+
 void World::SetBiome(const rsc::BiomeDefinition& biome, lib::DynamicArray<as::PrefabAssetHandle> placementAssets)
 {
 	m_placementSystem.SetBiome(biome, std::move(placementAssets));
@@ -92,6 +141,11 @@ rsc::PlacementCommand World::CreatePlacementCommand(engn::FrameContext& frame, m
 	return m_placementSystem.CreatePlacementCommand(frame, location);
 }
 
+void World::ApplyPlacementResults(lib::Span<const rsc::PlacementProcessData> results)
+{
+	m_placementSystem.ApplyPlacementResults(*this, results);
+}
+
 void World::SetTerrain(as::TerrainAssetHandle terrainAsset)
 {
 	m_terrainAsset = std::move(terrainAsset);
@@ -101,69 +155,20 @@ void World::UpdateRenderScene(engn::FrameContext& frame)
 {
 	SPT_PROFILER_FUNCTION();
 
-	rsc::RenderScene& renderScene = GetRenderSceneRef();
-
-	lib::MemoryArena perInstanceArena = frame.GetFrameMemoryArena().CreateSubArena("Update Render Instance", 1024u * 4u);
+	FlushRenderSceneChanges();
 
-	const auto updateRenderMesh = [this, &perInstanceArena, &renderScene](MeshesChunkHandle chunkHandle, MeshesChunk& chunk)
-	{
-		for (MeshEntity& mesh : chunk.meshes)
-		{
-			SPT_PROFILER_SCOPE("Update Render Mesh");
-
-			if (!mesh.render.instance.IsValid())
-			{
-				rsc::RenderInstanceDef instanceDef;
-				instanceDef.transform = mesh.def.owningPrefab->transform.GetAffineTransform() * mesh.def.transform.GetAffineTransform();
-
-				mesh.render.instance = renderScene.CreateInstance(instanceDef);
-			}
-
-			if (!mesh.render.renderMaterialSlots.IsValid())
-			{
-				const Uint32 materialsNum = static_cast<Uint32>(mesh.def.mesh->GetRenderMesh()->GetSubmeshes().size());
-				const lib::Span<ecs::EntityHandle> slotsArray = perInstanceArena.AllocateSpanUninitialized<ecs::EntityHandle>(materialsNum);
-
-				Uint32 slotIdx = 0u;
-				MaterialAssetSlotsChunkHandle currentChunk = mesh.def.materialSlots;
-				while (currentChunk.IsValid())
-				{
-					const MaterialAssetSlotsChunk& matsChunk = materials.slots.GetRef(currentChunk);
-					for (Uint32 idx = 0u; idx < matsChunk.slots.size(); ++idx)
-					{
-						slotsArray[slotIdx++] = matsChunk.slots[idx].material->GetMaterialEntity();
-					}
+	rsc::RenderScene& renderScene = GetRenderSceneRef();
 
-					currentChunk = matsChunk.next;
-				}
-				
-				mesh.render.renderMaterialSlots = renderScene.materials.CreateMaterialSlotsChain(slotsArray);
-			}
+	renderScene.PostFrameDataUpdate(frame);
 
-			if (!mesh.render.draw.IsValid())
-			{
-				mesh.render.draw = renderScene.draws.draws.Add(rsc::RetainedDraw
-					{
-						.instance      = mesh.render.instance,
-						.mesh          = *mesh.def.mesh->GetRenderMesh(),
-						.materialSlots = mesh.render.renderMaterialSlots
-					});
-			}
+	renderScene.SetTerrainDefinition(m_terrainAsset.IsValid() ? m_terrainAsset->GetTerrainDefinition() : rsc::TerrainDefinition{});
+}
 
-			if (!mesh.render.rtInstance.IsValid())
-			{
-				mesh.render.rtInstance = renderScene.rt.instances.Add(
-					rsc::RTInstance
-					{
-						.instance      = mesh.render.instance,
-						.rtGeometry    = *mesh.def.mesh->GetRenderMesh(),
-						.materialSlots = mesh.render.renderMaterialSlots
-					});
-			}
+void World::FlushRenderSceneChanges()
+{
+	SPT_PROFILER_FUNCTION();
 
-			perInstanceArena.Reset();
-		}
-	};
+	rsc::RenderScene& renderScene = GetRenderSceneRef();
 
 	const auto preDeleteInstance = [this, &renderScene](PrefabInstanceHandle instanceHandle, PrefabInstance& instance)
 	{
@@ -211,14 +216,178 @@ void World::UpdateRenderScene(engn::FrameContext& frame)
 
 	prefabs.instances.Flush(preDeleteInstance);
 
-	meshes.chunks.ForEachDirty(updateRenderMesh);
+	UpdateRenderMeshes();
 
 	meshes.chunks.Flush();
 	materials.slots.Flush();
+}
 
-	renderScene.PostFrameDataUpdate(frame);
+void World::UpdateRenderMeshes()
+{
+	SPT_PROFILER_FUNCTION();
 
-	renderScene.SetTerrainDefinition(m_terrainAsset.IsValid() ? m_terrainAsset->GetTerrainDefinition() : rsc::TerrainDefinition{});
+	rsc::RenderScene& renderScene = GetRenderSceneRef();
+
+	// Collect dirty meshes ===================================================
+
+	lib::DynamicArray<priv::MeshRenderUpdate> updates;
+	Uint32 materialsNum = 0u;
+
+	const auto collectDirtyMeshes = [this, &updates, &materialsNum](MeshesChunkHandle chunkHandle, MeshesChunk& chunk)
+	{
+		// Chunks of instances destroyed in this frame are still marked as dirty
+		if (!meshes.chunks.Get(chunkHandle))
+		{
+			return;
+		}
+
+		for (MeshEntity& mesh : chunk.meshes)
+		{
+			priv::MeshRenderUpdate& update = updates.emplace_back();
+			update.mesh            = &mesh;
+			update.createInstance  = !mesh.render.instance.IsValid();
+			update.updateTransform = !update.createInstance && mesh.render.isTransformDirty;
+
+			if (!mesh.render.renderMaterialSlots.IsValid())
+			{
+				update.createMaterialSlots = true;
+				update.materialsOffset     = materialsNum;
+				update.materialsNum        = static_cast<Uint32>(mesh.def.mesh->GetRenderMesh()->GetSubmeshes().size());
+
+				materialsNum += update.materialsNum;
+			}
+		}
+	};
+
+	meshes.chunks.ForEachDirty(collectDirtyMeshes);
+
+	if (updates.empty())
+	{
+		return;
+	}
+
+	// Prepare updates in parallel ============================================
+
+	lib::DynamicArray<ecs::EntityHandle> materialEntities(materialsNum);
+
+	lib::DynamicArray<lib::Span<priv::MeshRenderUpdate>> prepareBatches;
+	for (SizeType batchOffset = 0u; batchOffset < updates.size(); batchOffset += priv::meshesPerPrepareBatch)
+	{
+		prepareBatches.emplace_back(lib::Span<priv::MeshRenderUpdate>(updates).subspan(batchOffset, std::min(priv::meshesPerPrepareBatch, updates.size() - batchOffset)));
+	}
+
+	const auto prepareBatch = [this, &materialEntities](lib::Span<priv::MeshRenderUpdate> batch)
+	{
+		SPT_PROFILER_SCOPE("Prepare Render Meshes Batch");
+
+		for (priv::MeshRenderUpdate& update : batch)
+		{
+			const MeshEntity& mesh = *update.mesh;
+
+			if (update.createInstance || update.updateTransform)
+			{
+				update.transform = mesh.def.owningPrefab->transform.GetAffineTransform() * mesh.def.transform.GetAffineTransform();
+			}
+
+			if (update.createMaterialSlots)
+			{
+				Uint32 slotIdx = update.materialsOffset;
+				MaterialAssetSlotsChunkHandle currentChunk = mesh.def.materialSlots;
+				while (currentChunk.IsValid())
+				{
+					const MaterialAssetSlotsChunk& matsChunk = materials.slots.GetRef(currentChunk);
+					for (Uint32 idx = 0u; idx < matsChunk.slots.size(); ++idx)
+					{
+						materialEntities[slotIdx++] = matsChunk.slots[idx].material->GetMaterialEntity();
+					}
+
+					currentChunk = matsChunk.next;
+				}
+
+				SPT_CHECK(slotIdx == update.materialsOffset + update.materialsNum);
+			}
+		}
+	};
+
+	if (prepareBatches.size() > 1u)
+	{
+		js::InlineParallelForEach("Prepare Render Meshes", prepareBatches, prepareBatch);
+	}
+	else
+	{
+		prepareBatch(prepareBatches.front());
+	}
+
+	// Commit to render scene =================================================
+
+	SPT_PROFILER_SCOPE("Commit Render Meshes");
+
+	lib::DynamicArray<rsc::RenderInstanceDef> newInstancesDefs;
+	lib::DynamicArray<MeshEntity*>            newInstancesMeshes;
+
+	lib::DynamicArray<rsc::RenderInstanceHandle> movedInstances;
+	lib::DynamicArray<math::Affine3f>            movedInstancesTransforms;
+
+	for (const priv::MeshRenderUpdate& update : updates)
+	{
+		if (update.createInstance)
+		{
+			newInstancesDefs.emplace_back(rsc::RenderInstanceDef{ update.transform });
+			newInstancesMeshes.emplace_back(update.mesh);
+		}
+		else if (update.updateTransform)
+		{
+			movedInstances.emplace_back(update.mesh->render.instance);
+			movedInstancesTransforms.emplace_back(update.transform);
+		}
+
+		update.mesh->render.isTransformDirty = false;
+	}
+
+	if (!newInstancesDefs.empty())
+	{
+		lib::DynamicArray<rsc::RenderInstanceHandle> newInstances(newInstancesDefs.size());
+		renderScene.CreateInstances(newInstancesDefs, newInstances);
+
+		for (SizeType idx = 0u; idx < newInstances.size(); ++idx)
+		{
+			newInstancesMeshes[idx]->render.instance = newInstances[idx];
+		}
+	}
+
+	renderScene.UpdateInstancesTransforms(movedInstances, movedInstancesTransforms);
+
+	for (const priv::MeshRenderUpdate& update : updates)
+	{
+		MeshEntity& mesh = *update.mesh;
+
+		if (update.createMaterialSlots)
+		{
+			const lib::Span<const ecs::EntityHandle> slotsArray = lib::Span<const ecs::EntityHandle>(materialEntities).subspan(update.materialsOffset, update.materialsNum);
+			mesh.render.renderMaterialSlots = renderScene.materials.CreateMaterialSlotsChain(slotsArray);
+		}
+
+		if (!mesh.render.draw.IsValid())
+		{
+			mesh.render.draw = renderScene.draws.draws.Add(rsc::RetainedDraw
+				{
+					.instance      = mesh.render.instance,
+					.mesh          = *mesh.def.mesh->GetRenderMesh(),
+					.materialSlots = mesh.render.renderMaterialSlots
+				});
+		}
+
+		if (!mesh.render.rtInstance.IsValid())
+		{
+			mesh.render.rtInstance = renderScene.rt.instances.Add(
+				rsc::RTInstance
+				{
+					.instance      = mesh.render.instance,
+					.rtGeometry    = *mesh.def.mesh->GetRenderMesh(),
+					.materialSlots = mesh.render.renderMaterialSlots
+				});
+		}
+	}
 }
 
 } // spt::gf
@@ -42,13 +42,22 @@ public:
 	PrefabInstanceHandle SpawnPrefab(const as::PrefabAssetHandle& prefab, const PrefabSpawnParams& params);
 	void                 DestroyPrefabInstance(PrefabInstanceHandle instanceHandle);
 
+	/** Moves existing prefab instance. Render scene objects of the instance are reused and only their transforms are updated */
+	void SetPrefabInstanceTransform(PrefabInstanceHandle instanceHandle, const PrefabSpawnParams& params);
+
 	void                  SetBiome(const rsc::BiomeDefinition& biome, lib::DynamicArray<as::PrefabAssetHandle> placementAssets);
 	void                  ProcessPlacements(rsc::SceneRendererHandle sceneRenderer);
 	rsc::PlacementCommand CreatePlacementCommand(engn::FrameContext& frame, math::Vector3f location);
+	void                  ApplyPlacementResults(lib::Span<const rsc::PlacementProcessData> results);
+
+	const WorldPlacementSystem& GetPlacementSystem() const { return m_placementSystem; }
 
 	void                   SetTerrain(as::TerrainAssetHandle terrainAsset);
 	as::TerrainAssetHandle GetTerrainAsset() const { return m_terrainAsset; }
 
+	/** Applies pending changes of prefab instances (spawns, destroys, moves) to render scene. Called each frame before rendering */
+	void FlushRenderSceneChanges();
+
 	struct WorldPrefabs&       prefabs;
 	struct WorldMeshes&        meshes;
 	struct WorldMaterialSlots& materials;
@@ -57,6 +66,8 @@ private:
 
 	void UpdateRenderScene(engn::FrameContext& frame);
 
+	void UpdateRenderMeshes();
+
 	lib::SharedPtr<rsc::RenderScene> m_renderScene;
 
 	WorldPlacementSystem m_placementSystem;
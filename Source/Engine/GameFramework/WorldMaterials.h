@@ -4,6 +4,7 @@
 #include "Containers/PagedGenerationalPool.h"
 #include "MaterialAsset.h"
 #include "MathUtils.h"
+#include "RenderSceneTypes.h"
 
 
 namespace spt::gf
@@ -30,7 +31,7 @@ struct MaterialAssetSlotsChunk
 struct WorldMaterialSlots
 {
 	WorldMaterialSlots()
-		: slots("World_MaterialSlotsPool")
+		: slots("World_MaterialSlotsPool", 128u, rsc::maxRenderInstancesNum)
 	{
 	}
 
@@ -0,0 +1,334 @@
+#include "gtest/gtest.h"
+#include "AssetsSystem.h"
+#include "MeshAsset.h"
+#include "MaterialAsset.h"
+#include "MaterialInstance/PBRMaterialInstance.h"
+#include "PrefabAsset.h"
+#include "World.h"
+#include "RenderScene.h"
+#include "Engine.h"
+#include "GPUApi.h"
+#include "Graphics/Transfers/GPUDeferredCommandsQueue.h"
+
+#include <chrono>
+
+
+namespace spt::gf::tests
+{
+
+class WorldTests : public testing::Test
+{
+protected:
+
+	virtual void SetUp() override;
+	virtual void TearDown() override;
+
+	as::MeshAssetHandle     CreateMesh();
+	as::MaterialAssetHandle CreateMaterial();
+	as::PrefabAssetHandle   CreateEmptyPrefab(const as::ResourcePath& assetPath);
+
+	/** Spawns prefab instances with single mesh directly, without prefab asset */
+	lib::DynamicArray<PrefabInstanceHandle> SpawnMeshes(World& world, Uint32 meshesNum, const as::MeshAssetHandle& mesh, const as::MaterialAssetHandle& material);
+
+	as::AssetsSystem m_assetsSystem;
+};
+
+void WorldTests::SetUp()
+{
+	const lib::Path executablePath = platf::Platform::GetExecutablePath();
+	const lib::Path contentPath    = executablePath.parent_path() / "../../Tests/Content";
+	const lib::Path ddcPath        = executablePath.parent_path() / "../../Tests/DDC";
+
+	as::AssetsSystemInitializer initializer;
+	initializer.contentPath = contentPath;
+	initializer.ddcPath     = ddcPath;
+	const Bool initialized = m_assetsSystem.Initialize(initializer);
+
+	EXPECT_TRUE(initialized);
+}
+
+void WorldTests::TearDown()
+{
+	m_assetsSystem.Shutdown();
+}
+
+as::MeshAssetHandle WorldTests::CreateMesh()
+{
+	const as::ResourcePath assetPath = "Mesh/CreateMesh/WorldTestsMesh.sptasset";
+	m_assetsSystem.DeleteAsset(assetPath); // Delete leftover asset if exists
+
+	as::MeshDataInitializer meshInitializer
+	{
+		as::MeshSourceDefinition
+		{
+			.path    = "Source/Cube.gltf",
+			.meshIdx = 0u
+		}
+	};
+
+	as::CreateResult result = m_assetsSystem.CreateAsset(as::AssetInitializer
+														 {
+															 .type            = as::CreateAssetType<as::MeshAsset>(),
+															 .path            = assetPath,
+															 .dataInitializer = &meshInitializer
+														 });
+
+	EXPECT_TRUE(result);
+	result.GetValue().Reset();
+
+	return m_assetsSystem.LoadAndInitAssetChecked<as::MeshAsset>(assetPath);
+}
+
+as::MaterialAssetHandle WorldTests::CreateMaterial()
+{
+	const as::ResourcePath assetPath = "Material/CreateMaterial/WorldTestsMaterial.sptasset";
+	m_assetsSystem.DeleteAsset(assetPath); // Delete leftover asset if exists
+
+	as::PBRMaterialInitializer materialInitializer
+	{
+		as::PBRMaterialDefinition
+		{
+			.baseColorFactor = math::Vector3f(0.8f, 0.8f, 0.8f),
+			.metallicFactor  = 0.f,
+			.roughnessFactor = 1.f
+		}
+	};
+
+	as::CreateResult result = m_assetsSystem.CreateAsset(as::AssetInitializer
+														 {
+															 .type            = as::CreateAssetType<as::MaterialAsset>(),
+															 .path            = assetPath,
+															 .dataInitializer = &materialInitializer
+														 });
+
+	EXPECT_TRUE(result);
+	result.GetValue().Reset();
+
+	return m_assetsSystem.LoadAndInitAssetChecked<as::MaterialAsset>(assetPath);
+}
+
+as::PrefabAssetHandle WorldTests::CreateEmptyPrefab(const as::ResourcePath& assetPath)
+{
+	m_assetsSystem.DeleteAsset(assetPath); // Delete leftover asset if exists
+
+	as::PrefabDataInitializer prefabInitializer{ as::PrefabDefinition{} };
+
+	as::CreateResult result = m_assetsSystem.CreateAsset(as::AssetInitializer
+														 {
+															 .type            = as::CreateAssetType<as::PrefabAsset>(),
+															 .path            = assetPath,
+															 .dataInitializer = &prefabInitializer
+														 });
+
+	EXPECT_TRUE(result);
+	result.GetValue().Reset();
+
+	return m_assetsSystem.LoadAndInitAssetChecked<as::PrefabAsset>(assetPath);
+}
+
+lib::DynamicArray<PrefabInstanceHandle> WorldTests::SpawnMeshes(World& world, Uint32 meshesNum, const as::MeshAssetHandle& mesh, const as::MaterialAssetHandle& material)
+{
+	lib::DynamicArray<as::MaterialAssetHandle> materialsArray(mesh->GetSubmeshesNum(), material);
+
+	const Uint32 gridSize = static_cast<Uint32>(std::ceil(std::sqrt(static_cast<Real32>(meshesNum))));
+
+	lib::DynamicArray<PrefabInstanceHandle> instances;
+	instances.reserve(meshesNum);
+
+	for (Uint32 meshIdx = 0u; meshIdx < meshesNum; ++meshIdx)
+	{
+		const PrefabInstanceHandle instanceHandle = world.prefabs.instances.Add();
+		PrefabInstance& instance = world.prefabs.instances.GetRef(instanceHandle);
+		instance.transform.location = math::Vector3f(static_cast<Real32>(meshIdx % gridSize), static_cast<Real32>(meshIdx / gridSize), 0.f) * 2.f;
+
+		MeshesChunk chunk;
+		chunk.meshes[0] = MeshEntity
+		{
+			.def =
+			{
+				.mesh          = mesh,
+				.materialSlots = world.materials.CreateMaterialSlotsChain(materialsArray),
+				.owningPrefab  = &instance
+			}
+		};
+
+		instance.meshesChunk = world.meshes.chunks.Add(chunk);
+
+		instances.emplace_back(instanceHandle);
+	}
+
+	return instances;
+}
+
+TEST_F(WorldTests, SpawnMeshesBenchmark)
+{
+	constexpr Uint32 meshesNum = 100000u;
+
+	lib::MemoryArena tempArena("WorldTestsTempArena", 8u * 1024u, 512u * 1024u * 1024u);
+
+	gfx::GPUDeferredCommandsQueue& queue = engn::GetEngine().GetPluginsManager().GetPluginChecked<gfx::GPUDeferredCommandsQueue>();
+
+	as::MeshAssetHandle     mesh     = CreateMesh();
+	as::MaterialAssetHandle material = CreateMaterial();
+
+	ASSERT_TRUE(mesh.IsValid());
+	ASSERT_TRUE(material.IsValid());
+
+	queue.ForceFlushCommands(tempArena);
+
+	{
+		World world;
+
+		const lib::DynamicArray<PrefabInstanceHandle> instances = SpawnMeshes(world, meshesNum, mesh, material);
+
+		const auto spawnBeginTime = std::chrono::high_resolution_clock::now();
+
+		world.FlushRenderSceneChanges();
+
+		const Real64 spawnTimeMs = std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - spawnBeginTime).count();
+
+		EXPECT_EQ(world.GetRenderSceneRef().GetInstances().GetNum(), meshesNum);
+		EXPECT_EQ(world.GetRenderSceneRef().draws.draws.GetNum(), meshesNum);
+
+		for (PrefabInstanceHandle instance : instances)
+		{
+			world.SetPrefabInstanceTransform(instance, PrefabSpawnParams{ .location = world.prefabs.instances.GetRef(instance).transform.location + math::Vector3f::UnitZ() });
+		}
+
+		const auto moveBeginTime = std::chrono::high_resolution_clock::now();
+
+		world.FlushRenderSceneChanges();
+
+		const Real64 moveTimeMs = std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - moveBeginTime).count();
+
+		EXPECT_EQ(world.GetRenderSceneRef().GetInstances().GetNum(), meshesNum);
+
+		RecordProperty("SpawnTimeMs", std::to_string(spawnTimeMs));
+		RecordProperty("MoveTimeMs",  std::to_string(moveTimeMs));
+
+		for (PrefabInstanceHandle instance : instances)
+		{
+			world.DestroyPrefabInstance(instance);
+		}
+
+		world.FlushRenderSceneChanges();
+
+		queue.ForceFlushCommands(tempArena);
+	}
+
+	mesh.Reset();
+	material.Reset();
+
+	queue.ForceFlushCommands(tempArena);
+
+	EXPECT_TRUE(m_assetsSystem.DeleteAsset("Mesh/CreateMesh/WorldTestsMesh.sptasset") == as::EDeleteResult::Success);
+	EXPECT_TRUE(m_assetsSystem.DeleteAsset("Material/CreateMaterial/WorldTestsMaterial.sptasset") == as::EDeleteResult::Success);
+}
+
+TEST_F(WorldTests, PlacementRecyclingStatistics)
+{
+	const as::ResourcePath firstPrefabPath  = "Prefab/CreatePrefab/WorldTestsPrefabA.sptasset";
+	const as::ResourcePath secondPrefabPath = "Prefab/CreatePrefab/WorldTestsPrefabB.sptasset";
+
+	as::PrefabAssetHandle firstPrefab  = CreateEmptyPrefab(firstPrefabPath);
+	as::PrefabAssetHandle secondPrefab = CreateEmptyPrefab(secondPrefabPath);
+
+	ASSERT_TRUE(firstPrefab.IsValid());
+	ASSERT_TRUE(secondPrefab.IsValid());
+
+	{
+		World world;
+
+		rsc::BiomeDefinition biome;
+		rsc::PlacementDefinition& placementDef = biome.placementDefinitions.emplace_back();
+		placementDef.resolution = 2u;
+
+		world.SetBiome(biome, { firstPrefab, secondPrefab });
+
+		const auto applyPlacements = [&world](lib::Span<const rsc::PlacementEntry> placements)
+		{
+			const rsc::PlacementProcessData processData{ .placements = placements, .placementDefIdx = 0u };
+			world.ApplyPlacementResults(lib::Span<const rsc::PlacementProcessData>(&processData, 1u));
+			return world.GetPlacementSystem().GetLastStatistics();
+		};
+
+		const auto createEntry = [](Uint32 entryIdx, Uint32 prefabIdx, Real32 height)
+		{
+			return rsc::PlacementEntry{ .location = math::Vector3f(static_cast<Real32>(entryIdx), 0.f, height), .scale = 1.f, .seed = 0u, .prefabIdx = prefabIdx, .entryIdx = entryIdx };
+		};
+
+		// All entries are new, so all instances are spawned
+		{
+			const rsc::PlacementEntry placements[] = { createEntry(0u, 0u, 0.f), createEntry(1u, 0u, 0.f), createEntry(2u, 1u, 0.f) };
+			const PlacementStatistics stats = applyPlacements(placements);
+
+			EXPECT_EQ(stats.spawnedInstancesNum, 3u);
+			EXPECT_EQ(stats.recycledInstancesNum, 0u);
+			EXPECT_EQ(stats.movedInstancesNum, 0u);
+			EXPECT_EQ(stats.destroyedInstancesNum, 0u);
+		}
+
+		// Entry 0 keeps its prefab, so it's only moved. Entries 1 and 2 swap prefabs, so they reuse each other's instances
+		{
+			const rsc::PlacementEntry placements[] = { createEntry(0u, 0u, 1.f), createEntry(1u, 1u, 1.f), createEntry(2u, 0u, 1.f) };
+			const PlacementStatistics stats = applyPlacements(placements);
+
+			EXPECT_EQ(stats.spawnedInstancesNum, 0u);
+			EXPECT_EQ(stats.recycledInstancesNum, 2u);
+			EXPECT_EQ(stats.movedInstancesNum, 1u);
+			EXPECT_EQ(stats.destroyedInstancesNum, 0u);
+		}
+
+		// Entry 0 is cleared and its instance is reused by new entry 3. Instance of cleared entry 1 is not claimed, so it's destroyed
+		{
+			const rsc::PlacementEntry placements[] = { createEntry(0u, idxNone<Uint32>, 0.f), createEntry(1u, idxNone<Uint32>, 0.f), createEntry(3u, 0u, 0.f) };
+			const PlacementStatistics stats = applyPlacements(placements);
+
+			EXPECT_EQ(stats.spawnedInstancesNum, 0u);
+			EXPECT_EQ(stats.recycledInstancesNum, 1u);
+			EXPECT_EQ(stats.movedInstancesNum, 0u);
+			EXPECT_EQ(stats.destroyedInstancesNum, 1u);
+		}
+
+		const PlacementStatistics totalStats = world.GetPlacementSystem().GetTotalStatistics();
+		EXPECT_EQ(totalStats.spawnedInstancesNum, 3u);
+		EXPECT_EQ(totalStats.recycledInstancesNum, 3u);
+		EXPECT_EQ(totalStats.movedInstancesNum, 1u);
+		EXPECT_EQ(totalStats.destroyedInstancesNum, 1u);
+	}
+
+	firstPrefab.Reset();
+	secondPrefab.Reset();
+
+	EXPECT_TRUE(m_assetsSystem.DeleteAsset(firstPrefabPath) == as::EDeleteResult::Success);
+	EXPECT_TRUE(m_assetsSystem.DeleteAsset(secondPrefabPath) == as::EDeleteResult::Success);
+}
+
+} // spt::gf::tests
+
+
+int main(int argc, char** argv)
+{
+	using namespace spt;
+
+	const lib::Path executablePath = platf::Platform::GetExecutablePath();
+	const lib::Path enginePath = executablePath.parent_path() / "../../../";
+
+	const lib::String engineRelativePath = std::filesystem::relative(enginePath, executablePath).generic_string();
+	const lib::String engineRelativePathArg = "-EngineRelativePath=" + engineRelativePath;
+
+	engn::EngineInitializationParams engineInitializationParams;
+	engineInitializationParams.additionalArgs.emplace_back(engineRelativePathArg);
+
+	engn::Engine::Get().Initialize(engineInitializationParams);
+
+	rdr::GPUApi::Initialize();
+
+	testing::InitGoogleTest(&argc, argv);
+
+	const auto testsResult = RUN_ALL_TESTS();
+
+	rdr::GPUApi::Uninitialize();
+
+	return testsResult;
+}
@@ -0,0 +1,11 @@
+GameFrameworkTests = Project:CreateProject("GameFrameworkTests", ETargetType.Application)
+
+function GameFrameworkTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("GameFramework")
+    self:AddPrivateDependency("MeshAsset")
+    self:AddPrivateDependency("MaterialAsset")
+    self:AddPrivateDependency("GoogleTest")
+    self:AddPrivateDependency("EngineCore")
+end
+
+GameFrameworkTests:SetupProject()
@@ -56,6 +56,12 @@ public:
 		rdr::bindings_refl::BuildAdditionalShaderCompilationArgs<TDescriptorSet>(builder);
 	}
 
+	// Changes of bound descriptor set don't mark this binding as dirty
+	static constexpr Bool IsUpdatedOnEveryFlush()
+	{
+		return true;
+	}
+
 	void Set(lib::MTHandle<TDescriptorSet> ds)
 	{
 		if(m_boundDS != ds)
@@ -3,8 +3,10 @@
 #include "ResourcesManager.h"
 #include "RenderGraphBuilder.h"
 #include "FileSystem/File.h"
+#include "FileSystem/MappedFile.h"
 #include "RHICore/SculptorDXGIFormats.h"
 #include "Utils/TransfersManager.h"
+#include "JobSystem.h"
 
 #pragma warning(push)
 #pragma warning(disable: 4244)
@@ -34,6 +36,7 @@
 #include "tinytiffreader.h"
 
 #include <limits>
+#include <condition_variable>
 
 
 SPT_DEFINE_LOG_CATEGORY(ImageLoader, true);
@@ -74,7 +77,7 @@ struct STBTextureDataView : public TextureDataView
 	}
 	// End TextureDataView overrides
 
-	stbi_uc* imageData   = nullptr;
+	void*  imageData     = nullptr;
 	Uint64 imageDataSize = 0u;
 };
 
@@ -90,7 +93,9 @@ Bool LoadTextureImpl(TCallback&& callback, lib::StringView path)
 
 	const int requiredComonents = 4;
 
-	stbi_uc* imageData = stbi_load(path.data(), OUT &width, OUT &height, OUT &components, requiredComonents);
+	// HDR images must be loaded as floats, otherwise stb converts them to 8 bits per component
+	void* imageData = isHDR ? static_cast<void*>(stbi_loadf(path.data(), OUT &width, OUT &height, OUT &components, requiredComonents))
+							: static_cast<void*>(stbi_load(path.data(), OUT &width, OUT &height, OUT &components, requiredComonents));
 
 	if (!imageData)
 	{
@@ -652,6 +657,161 @@ Bool LoadTextureImpl(TCallback&& callback, lib::StringView path, EFormatMode for
 
 } // tiff
 
+namespace streaming
+{
+
+/** Limits memory used by decoded images that weren't consumed yet */
+class DecodedMemoryBudget
+{
+public:
+
+	explicit DecodedMemoryBudget(Uint64 maxBytes)
+		: m_maxBytes(maxBytes)
+	{ }
+
+	void Acquire(Uint64 size)
+	{
+		lib::UnlockableLockGuard<lib::Lock> lock(m_lock);
+
+		// Image larger than the whole budget would never fit, so it's allowed when nothing else is in flight
+		m_releasedCondition.wait(lock, [this, size] { return m_usedBytes == 0u || m_usedBytes + size <= m_maxBytes; });
+
+		m_usedBytes += size;
+		m_peakBytes = std::max(m_peakBytes, m_usedBytes);
+	}
+
+	void Release(Uint64 size)
+	{
+		{
+			const lib::LockGuard<lib::Lock> lock(m_lock);
+			SPT_CHECK(m_usedBytes >= size);
+			m_usedBytes -= size;
+		}
+
+		m_releasedCondition.notify_all();
+	}
+
+	Uint64 GetPeakBytes() const
+	{
+		const lib::LockGuard<lib::Lock> lock(m_lock);
+		return m_peakBytes;
+	}
+
+private:
+
+	const Uint64 m_maxBytes;
+
+	Uint64 m_usedBytes = 0u;
+	Uint64 m_peakBytes = 0u;
+
+	mutable lib::Lock       m_lock;
+	std::condition_variable m_releasedCondition;
+};
+
+
+struct ImageDecodeRequest
+{
+	Uint32          imageIdx = idxNone<Uint32>;
+	lib::MappedFile file;
+	Bool            isHDR    = false;
+	Uint64          decodedSize = 0u;
+};
+
+
+static Bool IsSupportedExtension(lib::StringView extension)
+{
+	return extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "tga" || extension == "hdr";
+}
+
+
+/** Maps file and reads image header to find decoded size without decoding the image */
+static Bool PrepareRequest(const lib::String& path, ImageDecodeRequest& request)
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (!IsSupportedExtension(lib::File::GetExtension(path)))
+	{
+		SPT_LOG_ERROR(ImageLoader, "Unsupported texture format for streaming decode (path: {})", path);
+		return false;
+	}
+
+	if (!request.file.Open(path) || request.file.GetSize() > static_cast<SizeType>(std::numeric_limits<int>::max()))
+	{
+		SPT_LOG_ERROR(ImageLoader, "Failed to open texture: {}", path);
+		return false;
+	}
+
+	const stbi_uc* fileData = reinterpret_cast<const stbi_uc*>(request.file.GetData().data());
+	const int fileSize      = static_cast<int>(request.file.GetSize());
+
+	int width      = 0;
+	int height     = 0;
+	int components = 0;
+
+	if (!stbi_info_from_memory(fileData, fileSize, OUT &width, OUT &height, OUT &components))
+	{
+		SPT_LOG_ERROR(ImageLoader, "Failed to read texture header: {} (path: {})", stbi_failure_reason(), path);
+		return false;
+	}
+
+	constexpr Uint64 componentsNum = 4u;
+
+	request.isHDR       = stbi_is_hdr_from_memory(fileData, fileSize) != 0;
+	request.decodedSize = static_cast<Uint64>(width) * static_cast<Uint64>(height) * componentsNum * (request.isHDR ? sizeof(Real32) : 1u);
+
+	return true;
+}
+
+
+/** Decodes image and passes it to consumer. Returns decoded size or 0 if image couldn't be decoded */
+static Uint64 DecodeImage(ImageDecodeRequest& request, DecodedTextureConsumer& consumer, Uint32 rowsPerChunk)
+{
+	SPT_PROFILER_FUNCTION();
+
+	const stbi_uc* fileData = reinterpret_cast<const stbi_uc*>(request.file.GetData().data());
+	const int fileSize      = static_cast<int>(request.file.GetSize());
+
+	int width      = 0;
+	int height     = 0;
+	int components = 0;
+
+	const int requiredComponents = 4;
+
+	void* imageData = request.isHDR ? static_cast<void*>(stbi_loadf_from_memory(fileData, fileSize, OUT &width, OUT &height, OUT &components, requiredComponents))
+									: static_cast<void*>(stbi_load_from_memory(fileData, fileSize, OUT &width, OUT &height, OUT &components, requiredComponents));
+
+	// Source file is not needed anymore, so it can be unmapped before the image is consumed
+	request.file.Close();
+
+	if (!imageData)
+	{
+		return 0u;
+	}
+
+	DecodedTextureChunk chunk;
+	chunk.imageIdx   = request.imageIdx;
+	chunk.format     = request.isHDR ? rhi::EFragmentFormat::RGBA32_S_Float : rhi::EFragmentFormat::RGBA8_UN_Float;
+	chunk.resolution = math::Vector3u(static_cast<Uint32>(width), static_cast<Uint32>(height), 1u);
+	chunk.rowPitch   = static_cast<Uint64>(width) * requiredComponents * (request.isHDR ? sizeof(Real32) : 1u);
+
+	const Byte* imageBytes = static_cast<const Byte*>(imageData);
+
+	for (Uint32 firstRow = 0u; firstRow < chunk.resolution.y(); firstRow += rowsPerChunk)
+	{
+		chunk.firstRow = firstRow;
+		chunk.rowsNum  = std::min(rowsPerChunk, chunk.resolution.y() - firstRow);
+		chunk.data     = lib::Span<const Byte>(imageBytes + chunk.rowPitch * firstRow, chunk.rowPitch * chunk.rowsNum);
+
+		consumer.ConsumeChunk(chunk);
+	}
+
+	stbi_image_free(imageData);
+
+	return chunk.rowPitch * chunk.resolution.y();
+}
+
+} // streaming
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // TextureLoader =================================================================================
 
@@ -660,7 +820,7 @@ Bool LoadTextureWithKnownExtension(TCallback&& callback, lib::StringView path)
 {
 	const lib::StringView extension = lib::File::GetExtension(path);
 
-	if (extension == "png" || extension == "jpg" || extension == "jpeg")
+	if (extension == "png" || extension == "jpg" || extension == "jpeg" || extension == "tga" || extension == "hdr")
 	{
 		return png_jpg::LoadTextureImpl(callback, path);
 	}
@@ -760,6 +920,73 @@ LoadedTextureData TextureLoader::LoadTextureData(lib::StringView path, lib::Memo
 	return loadedData;
 }
 
+TextureDecodeStreamStats TextureLoader::DecodeTexturesStreaming(lib::Span<const lib::String> paths, DecodedTextureConsumer& consumer, const TextureDecodeStreamParams& params /*= TextureDecodeStreamParams()*/)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(params.rowsPerChunk > 0u);
+
+	streaming::DecodedMemoryBudget budget(params.maxDecodedBytes);
+
+	std::atomic<Uint32> decodedImagesNum = 0u;
+	std::atomic<Uint32> failedImagesNum  = 0u;
+	std::atomic<Uint64> decodedBytes     = 0u;
+
+	lib::DynamicArray<streaming::ImageDecodeRequest> requests(paths.size());
+	lib::DynamicArray<js::Job> decodeJobs;
+	decodeJobs.reserve(paths.size());
+
+	// Jobs are launched in order, and calling thread waits for memory before launching the next one, so workers are never blocked by the budget
+	for (SizeType imageIdx = 0u; imageIdx < paths.size(); ++imageIdx)
+	{
+		streaming::ImageDecodeRequest& request = requests[imageIdx];
+		request.imageIdx = static_cast<Uint32>(imageIdx);
+
+		if (!streaming::PrepareRequest(paths[imageIdx], request))
+		{
+			++failedImagesNum;
+			consumer.OnImageFinished(request.imageIdx, false);
+			continue;
+		}
+
+		budget.Acquire(request.decodedSize);
+
+		decodeJobs.emplace_back(js::Launch("Decode Texture",
+										   [&request, &consumer, &budget, &decodedImagesNum, &failedImagesNum, &decodedBytes, rowsPerChunk = params.rowsPerChunk]
+										   {
+											   const Uint64 imageDecodedBytes = streaming::DecodeImage(request, consumer, rowsPerChunk);
+
+											   if (imageDecodedBytes > 0u)
+											   {
+												   ++decodedImagesNum;
+												   decodedBytes += imageDecodedBytes;
+											   }
+											   else
+											   {
+												   ++failedImagesNum;
+											   }
+
+											   consumer.OnImageFinished(request.imageIdx, imageDecodedBytes > 0u);
+
+											   // Memory is released only after consumer finished processing the image
+											   budget.Release(request.decodedSize);
+										   }));
+	}
+
+	for (const js::Job& job : decodeJobs)
+	{
+		job.Wait();
+	}
+
+	TextureDecodeStreamStats stats;
+	stats.decodedImagesNum = decodedImagesNum.load();
+	stats.failedImagesNum  = failedImagesNum.load();
+	stats.decodedBytes     = decodedBytes.load();
+	stats.peakDecodedBytes = budget.GetPeakBytes();
+
+	return stats;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // TextureWriter =================================================================================
 
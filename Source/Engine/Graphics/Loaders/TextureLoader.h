@@ -46,6 +46,60 @@ struct LoadedTextureData
 };
 
 
+/** Part of decoded image. Chunks of single image are passed in order and together cover all rows of the image */
+struct DecodedTextureChunk
+{
+	Uint32                imageIdx   = idxNone<Uint32>;
+	rhi::EFragmentFormat  format     = rhi::EFragmentFormat::None;
+	math::Vector3u        resolution = {};
+	Uint32                firstRow   = 0u;
+	Uint32                rowsNum    = 0u;
+	Uint64                rowPitch   = 0u;
+	lib::Span<const Byte> data;
+
+	Bool IsLastChunk() const
+	{
+		return firstRow + rowsNum == resolution.y();
+	}
+};
+
+
+/** Receives decoded images. Functions are called from job workers, chunks of different images may be passed concurrently */
+class GRAPHICS_API DecodedTextureConsumer
+{
+public:
+
+	virtual ~DecodedTextureConsumer() = default;
+
+	/** Chunk data is valid only during this call */
+	virtual void ConsumeChunk(const DecodedTextureChunk& chunk) = 0;
+
+	/** Called once for each image, after its last chunk or when it couldn't be decoded */
+	virtual void OnImageFinished(Uint32 imageIdx, Bool success) {}
+};
+
+
+struct TextureDecodeStreamParams
+{
+	/**
+	 * Maximal size of decoded images that weren't consumed yet. Decoding of next images waits until memory is released.
+	 * Image larger than the limit is decoded only when no other image is in flight.
+	 */
+	Uint64 maxDecodedBytes = 512u * 1024u * 1024u;
+
+	Uint32 rowsPerChunk = 64u;
+};
+
+
+struct TextureDecodeStreamStats
+{
+	Uint32 decodedImagesNum = 0u;
+	Uint32 failedImagesNum  = 0u;
+	Uint64 decodedBytes     = 0u;
+	Uint64 peakDecodedBytes = 0u;
+};
+
+
 class GRAPHICS_API TextureLoader
 {
 public:
@@ -56,6 +110,13 @@ public:
 
 	static LoadedTextureData            LoadTextureData(lib::StringView path, lib::MemoryArena& arena);
 
+	/**
+	 * Decodes images in parallel on job workers and passes them to consumer in chunks of rows as soon as each image is decoded.
+	 * Supports formats decoded by stb_image (png, jpg, tga, hdr). Doesn't use GPU.
+	 * Blocks until all images are decoded and consumed.
+	 */
+	static TextureDecodeStreamStats     DecodeTexturesStreaming(lib::Span<const lib::String> paths, DecodedTextureConsumer& consumer, const TextureDecodeStreamParams& params = TextureDecodeStreamParams());
+
 private:
 
 	TextureLoader() = delete;
@@ -0,0 +1,9 @@
+GraphicsTests = Project:CreateProject("GraphicsTests", ETargetType.Application)
+
+function GraphicsTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("Graphics")
+    self:AddPrivateDependency("STB")
+    self:AddPrivateDependency("GoogleTest")
+end
+
+GraphicsTests:SetupProject()
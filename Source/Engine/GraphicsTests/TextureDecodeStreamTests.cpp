@@ -0,0 +1,427 @@
+#include "gtest/gtest.h"
+#include "Loaders/TextureLoader.h"
+#include "JobSystem.h"
+
+#include "stb_image_write.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+
+
+namespace spt::gfx::tests
+{
+
+namespace priv
+{
+
+class TempDirectory
+{
+public:
+
+	TempDirectory()
+	{
+		std::random_device randomDevice;
+		m_path = std::filesystem::temp_directory_path() / ("SculptorTextureDecodeStreamTests_" + std::to_string(randomDevice()));
+		std::filesystem::create_directories(m_path);
+	}
+
+	~TempDirectory()
+	{
+		std::error_code errorCode;
+		std::filesystem::remove_all(m_path, errorCode);
+	}
+
+	const lib::Path& GetPath() const { return m_path; }
+
+private:
+
+	lib::Path m_path;
+};
+
+
+enum class ETestImageFormat
+{
+	PNG,
+	TGA,
+	HDR
+};
+
+
+static Uint8 GetPixelValue(Uint32 x, Uint32 y, Uint32 component, Uint32 seed)
+{
+	// Smooth gradients with some noise, so that images are compressible but not trivial
+	const Uint32 noise = ((x * 73856093u) ^ (y * 19349663u) ^ (seed * 83492791u)) & 0x7u;
+	return static_cast<Uint8>((x + y * (component + 1u) + seed * 17u + noise) & 0xFFu);
+}
+
+
+static lib::String WriteTestImage(const lib::Path& directory, ETestImageFormat format, Uint32 width, Uint32 height, Uint32 seed)
+{
+	constexpr Uint32 componentsNum = 4u;
+
+	lib::DynamicArray<Uint8> pixels(static_cast<SizeType>(width) * height * componentsNum);
+	for (Uint32 y = 0u; y < height; ++y)
+	{
+		for (Uint32 x = 0u; x < width; ++x)
+		{
+			for (Uint32 component = 0u; component < componentsNum; ++component)
+			{
+				pixels[(static_cast<SizeType>(y) * width + x) * componentsNum + component] = GetPixelValue(x, y, component, seed);
+			}
+		}
+	}
+
+	const int w    = static_cast<int>(width);
+	const int h    = static_cast<int>(height);
+	const int comp = static_cast<int>(componentsNum);
+
+	lib::String path;
+
+	switch (format)
+	{
+	case ETestImageFormat::PNG:
+		path = (directory / ("Image_" + std::to_string(seed) + ".png")).string();
+		EXPECT_NE(stbi_write_png(path.c_str(), w, h, comp, pixels.data(), w * comp), 0);
+		break;
+
+	case ETestImageFormat::TGA:
+		path = (directory / ("Image_" + std::to_string(seed) + ".tga")).string();
+		EXPECT_NE(stbi_write_tga(path.c_str(), w, h, comp, pixels.data()), 0);
+		break;
+
+	case ETestImageFormat::HDR:
+		{
+			lib::DynamicArray<Real32> hdrPixels(pixels.size());
+			std::transform(pixels.cbegin(), pixels.cend(), hdrPixels.begin(), [](Uint8 value) { return static_cast<Real32>(value) / 16.f; });
+
+			path = (directory / ("Image_" + std::to_string(seed) + ".hdr")).string();
+			EXPECT_NE(stbi_write_hdr(path.c_str(), w, h, comp, hdrPixels.data()), 0);
+			break;
+		}
+	}
+
+	return path;
+}
+
+
+/** Assembles decoded images from chunks and validates order of chunks */
+class CollectingConsumer : public DecodedTextureConsumer
+{
+public:
+
+	struct Image
+	{
+		lib::DynamicArray<Byte> data;
+		rhi::EFragmentFormat    format     = rhi::EFragmentFormat::None;
+		math::Vector3u          resolution = math::Vector3u::Zero();
+		Uint32                  rowsNum    = 0u;
+		Uint32                  chunksNum  = 0u;
+		Bool                    finished   = false;
+		Bool                    success    = false;
+	};
+
+	explicit CollectingConsumer(SizeType imagesNum)
+		: images(imagesNum)
+	{ }
+
+	// Begin DecodedTextureConsumer overrides
+	virtual void ConsumeChunk(const DecodedTextureChunk& chunk) override
+	{
+		// Chunks of single image are passed sequentially, so each image can be accessed without synchronization
+		Image& image = images[chunk.imageIdx];
+
+		EXPECT_FALSE(image.finished);
+		EXPECT_EQ(chunk.firstRow, image.rowsNum);
+		EXPECT_EQ(chunk.data.size(), chunk.rowPitch * chunk.rowsNum);
+
+		if (image.chunksNum == 0u)
+		{
+			const Uint32 imagesInFlight = ++m_imagesInFlight;
+			Uint32 maxImagesInFlight = m_maxImagesInFlight.load();
+			while (imagesInFlight > maxImagesInFlight && !m_maxImagesInFlight.compare_exchange_weak(maxImagesInFlight, imagesInFlight)) {}
+		}
+
+		image.format     = chunk.format;
+		image.resolution = chunk.resolution;
+		image.rowsNum   += chunk.rowsNum;
+		++image.chunksNum;
+		image.data.insert(image.data.end(), chunk.data.begin(), chunk.data.end());
+	}
+
+	virtual void OnImageFinished(Uint32 imageIdx, Bool success) override
+	{
+		Image& image = images[imageIdx];
+
+		EXPECT_FALSE(image.finished);
+		image.finished = true;
+		image.success  = success;
+
+		if (image.chunksNum > 0u)
+		{
+			--m_imagesInFlight;
+		}
+	}
+	// End DecodedTextureConsumer overrides
+
+	Uint32 GetMaxImagesInFlight() const
+	{
+		return m_maxImagesInFlight.load();
+	}
+
+	lib::DynamicArray<Image> images;
+
+private:
+
+	std::atomic<Uint32> m_imagesInFlight    = 0u;
+	std::atomic<Uint32> m_maxImagesInFlight = 0u;
+};
+
+
+/** Simulates work done on decoded rows (f.e. mips generation) */
+class ChecksumConsumer : public DecodedTextureConsumer
+{
+public:
+
+	// Begin DecodedTextureConsumer overrides
+	virtual void ConsumeChunk(const DecodedTextureChunk& chunk) override
+	{
+		// Sum doesn't depend on chunks size, so results of different paths can be compared
+		Uint64 checksum = 0u;
+		for (const Byte value : chunk.data)
+		{
+			checksum += static_cast<Uint64>(value);
+		}
+
+		m_checksum += checksum;
+	}
+	// End DecodedTextureConsumer overrides
+
+	Uint64 GetChecksum() const
+	{
+		return m_checksum.load();
+	}
+
+private:
+
+	std::atomic<Uint64> m_checksum = 0u;
+};
+
+
+template<typename TCallable>
+Real64 MeasureTimeMs(TCallable&& callable)
+{
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+	callable();
+	return std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+}
+
+} // priv
+
+
+TEST(TextureDecodeStreamTests, DecodesImagesInChunks)
+{
+	const priv::TempDirectory directory;
+
+	constexpr Uint32 width  = 37u;
+	constexpr Uint32 height = 29u;
+
+	const lib::DynamicArray<lib::String> paths =
+	{
+		priv::WriteTestImage(directory.GetPath(), priv::ETestImageFormat::PNG, width, height, 0u),
+		priv::WriteTestImage(directory.GetPath(), priv::ETestImageFormat::TGA, width, height, 1u),
+		priv::WriteTestImage(directory.GetPath(), priv::ETestImageFormat::HDR, width, height, 2u)
+	};
+
+	TextureDecodeStreamParams params;
+	params.rowsPerChunk = 8u;
+
+	priv::CollectingConsumer consumer(paths.size());
+	const TextureDecodeStreamStats stats = TextureLoader::DecodeTexturesStreaming(paths, consumer, params);
+
+	EXPECT_EQ(stats.decodedImagesNum, 3u);
+	EXPECT_EQ(stats.failedImagesNum, 0u);
+	EXPECT_EQ(stats.decodedBytes, 2u * width * height * 4u + width * height * 4u * sizeof(Real32));
+
+	for (const priv::CollectingConsumer::Image& image : consumer.images)
+	{
+		EXPECT_TRUE(image.finished);
+		EXPECT_TRUE(image.success);
+		EXPECT_EQ(image.resolution, math::Vector3u(width, height, 1u));
+		EXPECT_EQ(image.rowsNum, height);
+		EXPECT_EQ(image.chunksNum, 4u);
+	}
+
+	const priv::CollectingConsumer::Image& pngImage = consumer.images[0];
+	const priv::CollectingConsumer::Image& tgaImage = consumer.images[1];
+	const priv::CollectingConsumer::Image& hdrImage = consumer.images[2];
+
+	EXPECT_EQ(pngImage.format, rhi::EFragmentFormat::RGBA8_UN_Float);
+	EXPECT_EQ(tgaImage.format, rhi::EFragmentFormat::RGBA8_UN_Float);
+	EXPECT_EQ(hdrImage.format, rhi::EFragmentFormat::RGBA32_S_Float);
+
+	const Uint32 x = 11u;
+	const Uint32 y = 23u;
+	const SizeType pixelIdx = static_cast<SizeType>(y) * width + x;
+
+	EXPECT_EQ(static_cast<Uint8>(pngImage.data[pixelIdx * 4u + 1u]), priv::GetPixelValue(x, y, 1u, 0u));
+	EXPECT_EQ(static_cast<Uint8>(tgaImage.data[pixelIdx * 4u + 2u]), priv::GetPixelValue(x, y, 2u, 1u));
+
+	// Radiance HDR stores shared exponent, so values are not exact
+	const Real32* hdrPixels = reinterpret_cast<const Real32*>(hdrImage.data.data());
+	EXPECT_NEAR(hdrPixels[pixelIdx * 4u], static_cast<Real32>(priv::GetPixelValue(x, y, 0u, 2u)) / 16.f, 0.1f);
+}
+
+TEST(TextureDecodeStreamTests, DecodedMemoryStaysUnderLimit)
+{
+	const priv::TempDirectory directory;
+
+	constexpr Uint32 imagesNum   = 16u;
+	constexpr Uint32 resolution  = 128u;
+	constexpr Uint64 decodedSize = resolution * resolution * 4u;
+
+	lib::DynamicArray<lib::String> paths;
+	for (Uint32 imageIdx = 0u; imageIdx < imagesNum; ++imageIdx)
+	{
+		paths.emplace_back(priv::WriteTestImage(directory.GetPath(), priv::ETestImageFormat::PNG, resolution, resolution, imageIdx));
+	}
+
+	TextureDecodeStreamParams params;
+	params.maxDecodedBytes = 2u * decodedSize;
+	params.rowsPerChunk    = 16u;
+
+	priv::CollectingConsumer consumer(paths.size());
+	const TextureDecodeStreamStats stats = TextureLoader::DecodeTexturesStreaming(paths, consumer, params);
+
+	EXPECT_EQ(stats.decodedImagesNum, imagesNum);
+	EXPECT_EQ(stats.decodedBytes, imagesNum * decodedSize);
+	EXPECT_LE(stats.peakDecodedBytes, params.maxDecodedBytes);
+	EXPECT_LE(consumer.GetMaxImagesInFlight(), 2u);
+
+	// Image larger than the limit must still be decoded
+	params.maxDecodedBytes = decodedSize / 2u;
+
+	priv::CollectingConsumer singleImageConsumer(1u);
+	const TextureDecodeStreamStats singleImageStats = TextureLoader::DecodeTexturesStreaming(lib::Span<const lib::String>(paths.data(), 1u), singleImageConsumer, params);
+
+	EXPECT_EQ(singleImageStats.decodedImagesNum, 1u);
+	EXPECT_EQ(singleImageStats.peakDecodedBytes, decodedSize);
+}
+
+TEST(TextureDecodeStreamTests, FailedImagesAreReported)
+{
+	const priv::TempDirectory directory;
+
+	const lib::String invalidImagePath = (directory.GetPath() / "Invalid.png").string();
+	std::ofstream(invalidImagePath) << "Not a png file";
+
+	const lib::DynamicArray<lib::String> paths =
+	{
+		(directory.GetPath() / "Missing.png").string(),
+		invalidImagePath,
+		priv::WriteTestImage(directory.GetPath(), priv::ETestImageFormat::TGA, 16u, 16u, 0u),
+		(directory.GetPath() / "Unsupported.exr").string()
+	};
+
+	priv::CollectingConsumer consumer(paths.size());
+	const TextureDecodeStreamStats stats = TextureLoader::DecodeTexturesStreaming(paths, consumer);
+
+	EXPECT_EQ(stats.decodedImagesNum, 1u);
+	EXPECT_EQ(stats.failedImagesNum, 3u);
+
+	for (SizeType imageIdx = 0u; imageIdx < paths.size(); ++imageIdx)
+	{
+		EXPECT_TRUE(consumer.images[imageIdx].finished);
+		EXPECT_EQ(consumer.images[imageIdx].success, imageIdx == 2u);
+	}
+}
+
+TEST(TextureDecodeStreamTests, ThroughputBenchmark)
+{
+	constexpr Uint32 imagesNum  = 48u;
+	constexpr Uint32 resolution = 512u;
+
+	const priv::TempDirectory directory;
+
+	lib::DynamicArray<lib::String> paths;
+	for (Uint32 imageIdx = 0u; imageIdx < imagesNum; ++imageIdx)
+	{
+		const priv::ETestImageFormat format = imageIdx % 4u == 3u ? priv::ETestImageFormat::HDR
+											: imageIdx % 4u == 2u ? priv::ETestImageFormat::TGA
+											: priv::ETestImageFormat::PNG;
+
+		paths.emplace_back(priv::WriteTestImage(directory.GetPath(), format, resolution, resolution, imageIdx));
+	}
+
+	// Previous path - each image is decoded in full on calling thread, then processed
+	lib::MemoryArena arena("TextureDecodeBenchmarkArena", 64u * 1024u * 1024u, 256u * 1024u * 1024u);
+
+	priv::ChecksumConsumer sequentialConsumer;
+	Uint64 sequentialDecodedBytes = 0u;
+
+	const Real64 sequentialMs = priv::MeasureTimeMs([&]
+													{
+														for (Uint32 imageIdx = 0u; imageIdx < imagesNum; ++imageIdx)
+														{
+															lib::MemoryArenaScope arenaScope(arena);
+
+															const LoadedTextureData textureData = TextureLoader::LoadTextureData(paths[imageIdx], arena);
+															ASSERT_TRUE(textureData.IsValid());
+
+															DecodedTextureChunk chunk;
+															chunk.imageIdx   = imageIdx;
+															chunk.format     = textureData.format;
+															chunk.resolution = textureData.resolution;
+															chunk.rowsNum    = textureData.resolution.y();
+															chunk.rowPitch   = textureData.data.size() / textureData.resolution.y();
+															chunk.data       = textureData.data;
+															sequentialConsumer.ConsumeChunk(chunk);
+
+															sequentialDecodedBytes += textureData.data.size();
+														}
+													});
+
+	TextureDecodeStreamParams params;
+	params.maxDecodedBytes = 64u * 1024u * 1024u;
+
+	priv::ChecksumConsumer streamingConsumer;
+	TextureDecodeStreamStats stats;
+
+	const Real64 streamingMs = priv::MeasureTimeMs([&] { stats = TextureLoader::DecodeTexturesStreaming(paths, streamingConsumer, params); });
+
+	EXPECT_EQ(stats.decodedImagesNum, imagesNum);
+	EXPECT_EQ(stats.decodedBytes, sequentialDecodedBytes);
+	EXPECT_EQ(streamingConsumer.GetChecksum(), sequentialConsumer.GetChecksum());
+	EXPECT_LE(stats.peakDecodedBytes, params.maxDecodedBytes);
+
+	const Real64 decodedMB            = static_cast<Real64>(stats.decodedBytes) / (1024.0 * 1024.0);
+	const Real64 sequentialThroughput = decodedMB / (sequentialMs / 1000.0);
+	const Real64 streamingThroughput  = decodedMB / (streamingMs / 1000.0);
+	const Real64 peakMB               = static_cast<Real64>(stats.peakDecodedBytes) / (1024.0 * 1024.0);
+
+	RecordProperty("SequentialMBs", std::to_string(sequentialThroughput));
+	RecordProperty("StreamingMBs",  std::to_string(streamingThroughput));
+	RecordProperty("PeakDecodedMB", std::to_string(peakMB));
+}
+
+} // spt::gfx::tests
+
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	using namespace spt;
+
+	js::JobSystemInitializationParams jobSystemInitParams;
+	jobSystemInitParams.workerThreadsNum = static_cast<SizeType>(std::thread::hardware_concurrency() - 1u);
+	js::JobSystem::Initialize(jobSystemInitParams);
+
+	const auto testsResult = RUN_ALL_TESTS();
+
+	js::JobSystem::Shutdown();
+
+	return testsResult;
+}
@@ -2,7 +2,6 @@
 
 #include "MaterialsMacros.h"
 #include "SculptorCoreTypes.h"
-#include "RHICore/RHIAllocationTypes.h"
 #include "Utility/NamedType.h"
 #include "MaterialTypes.h"
 #include "ComponentsRegistry.h"
@@ -99,7 +98,7 @@ struct MaterialProxyComponent
 		return MaterialDataHandle{ materialDataID };
 	}
 
-	rhi::RHIVirtualAllocation materialDataSuballocation;
+	MaterialDataSuballocation materialDataSuballocation;
 
 	MaterialStaticParameters params;
 };
@@ -2,7 +2,6 @@
 
 #include "SculptorCoreTypes.h"
 #include "ECSRegistry.h"
-#include "RHICore/RHIBufferTypes.h"
 #include "Material.h"
 
 
@@ -29,7 +28,7 @@ struct MaterialDefinition
 
 struct MaterialDataParameters
 {
-	rhi::RHIVirtualAllocation suballocation;
+	MaterialDataSuballocation suballocation;
 	lib::HashedString         materialDataStructName;
 
 	MaterialFeatures features;
@@ -15,4 +15,27 @@ constexpr Uint64 materialDataAlignmentMask = materialDataAlignment - 1u;
 
 } // constants
 
+
+/** Location of material data in materials unified buffer */
+struct MaterialDataSuballocation
+{
+	Bool IsValid() const
+	{
+		return offset != idxNone<Uint64>;
+	}
+
+	Uint64 GetOffset() const
+	{
+		return offset;
+	}
+
+	Uint64 GetSize() const
+	{
+		return size;
+	}
+
+	Uint64 offset = idxNone<Uint64>;
+	Uint64 size   = 0u;
+};
+
 } // namespace spt::mat
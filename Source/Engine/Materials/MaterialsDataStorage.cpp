@@ -0,0 +1,267 @@
+#include "MaterialsDataStorage.h"
+#include "MathUtils.h"
+
+
+namespace spt::mat
+{
+
+MaterialsDataStorage::MaterialsDataStorage(Uint64 capacity, Uint64 alignment, Uint64 maxMergedGapSize)
+	: m_alignment(alignment)
+	, m_maxMergedGapSize(maxMergedGapSize)
+	, m_allocatedSize(0u)
+	, m_stagedWritesNum(0u)
+{
+	SPT_CHECK(math::Utils::IsPowerOf2(alignment));
+	SPT_CHECK(capacity % alignment == 0u);
+
+	m_data.resize(capacity, Byte(0));
+
+	m_freeRanges.emplace_back(MaterialsDataUploadRange{ 0u, capacity });
+}
+
+MaterialDataSuballocation MaterialsDataStorage::Allocate(Uint64 dataSize)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(dataSize > 0u);
+
+	const Uint64 allocationSize = math::Utils::RoundUp(dataSize, m_alignment);
+
+	// First fit keeps allocations close to the beginning of the storage, so uploads of newly created materials can be merged
+	const auto freeRangeIt = std::find_if(std::begin(m_freeRanges), std::end(m_freeRanges),
+										  [allocationSize](const MaterialsDataUploadRange& range)
+										  {
+											  return range.size >= allocationSize;
+										  });
+
+	if (freeRangeIt == std::end(m_freeRanges))
+	{
+		return MaterialDataSuballocation{};
+	}
+
+	MaterialDataSuballocation suballocation;
+	suballocation.offset = freeRangeIt->offset;
+	suballocation.size   = allocationSize;
+
+	if (freeRangeIt->size == allocationSize)
+	{
+		m_freeRanges.erase(freeRangeIt);
+	}
+	else
+	{
+		freeRangeIt->offset += allocationSize;
+		freeRangeIt->size   -= allocationSize;
+	}
+
+	m_allocations.emplace(suballocation.offset, allocationSize);
+	m_allocatedSize += allocationSize;
+
+	return suballocation;
+}
+
+void MaterialsDataStorage::Release(const MaterialDataSuballocation& suballocation)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(suballocation.IsValid());
+
+	const auto allocationIt = m_allocations.find(suballocation.GetOffset());
+	SPT_CHECK(allocationIt != std::cend(m_allocations));
+
+	const Uint64 allocationSize = allocationIt->second;
+	m_allocations.erase(allocationIt);
+	m_allocatedSize -= allocationSize;
+
+	AddFreeRange(suballocation.GetOffset(), allocationSize);
+}
+
+void MaterialsDataStorage::Write(const MaterialDataSuballocation& suballocation, const Byte* data, Uint64 dataSize)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(suballocation.IsValid());
+	SPT_CHECK(!!data);
+	SPT_CHECK(dataSize <= suballocation.GetSize());
+	SPT_CHECK(suballocation.GetOffset() + dataSize <= m_data.size());
+
+	std::memcpy(m_data.data() + suballocation.GetOffset(), data, dataSize);
+
+	MarkDirty(suballocation.GetOffset(), dataSize);
+
+	++m_stagedWritesNum;
+}
+
+lib::DynamicArray<MaterialsDataUploadRange> MaterialsDataStorage::FlushDirtyRanges()
+{
+	SPT_PROFILER_FUNCTION();
+
+	std::sort(std::begin(m_dirtyRanges), std::end(m_dirtyRanges),
+			  [](const MaterialsDataUploadRange& lhs, const MaterialsDataUploadRange& rhs)
+			  {
+				  return lhs.offset < rhs.offset;
+			  });
+
+	lib::DynamicArray<MaterialsDataUploadRange> uploadRanges;
+
+	for (const MaterialsDataUploadRange& dirtyRange : m_dirtyRanges)
+	{
+		if (!uploadRanges.empty())
+		{
+			MaterialsDataUploadRange& lastRange = uploadRanges.back();
+			const Uint64 lastRangeEnd = lastRange.offset + lastRange.size;
+
+			// Uploading small gap is cheaper than recording separate copy
+			if (dirtyRange.offset <= lastRangeEnd + m_maxMergedGapSize)
+			{
+				lastRange.size = std::max(lastRangeEnd, dirtyRange.offset + dirtyRange.size) - lastRange.offset;
+				continue;
+			}
+		}
+
+		uploadRanges.emplace_back(dirtyRange);
+	}
+
+	m_lastFlushStats.stagedWritesNum = m_stagedWritesNum;
+	m_lastFlushStats.uploadsNum      = static_cast<Uint32>(uploadRanges.size());
+	m_lastFlushStats.uploadedBytes   = std::accumulate(std::cbegin(uploadRanges), std::cend(uploadRanges),
+													   Uint64(0u),
+													   [](Uint64 bytes, const MaterialsDataUploadRange& range)
+													   {
+														   return bytes + range.size;
+													   });
+
+	m_dirtyRanges.clear();
+	m_stagedWritesNum = 0u;
+
+	return uploadRanges;
+}
+
+lib::DynamicArray<MaterialDataRelocation> MaterialsDataStorage::Compact()
+{
+	SPT_PROFILER_FUNCTION();
+
+	lib::DynamicArray<MaterialsDataUploadRange> allocations;
+	allocations.reserve(m_allocations.size());
+	for (const auto& [offset, size] : m_allocations)
+	{
+		allocations.emplace_back(MaterialsDataUploadRange{ offset, size });
+	}
+
+	std::sort(std::begin(allocations), std::end(allocations),
+			  [](const MaterialsDataUploadRange& lhs, const MaterialsDataUploadRange& rhs)
+			  {
+				  return lhs.offset < rhs.offset;
+			  });
+
+	lib::DynamicArray<MaterialDataRelocation> relocations;
+
+	m_allocations.clear();
+
+	Uint64 currentOffset = 0u;
+
+	// Allocations are processed in ascending order and are only moved towards the beginning, so data that wasn't moved yet is never overwritten
+	for (const MaterialsDataUploadRange& allocation : allocations)
+	{
+		if (allocation.offset != currentOffset)
+		{
+			SPT_CHECK(currentOffset < allocation.offset);
+
+			std::memmove(m_data.data() + currentOffset, m_data.data() + allocation.offset, allocation.size);
+
+			relocations.emplace_back(MaterialDataRelocation{ allocation.offset, currentOffset });
+
+			MarkDirty(currentOffset, allocation.size);
+		}
+
+		m_allocations.emplace(currentOffset, allocation.size);
+
+		currentOffset += allocation.size;
+	}
+
+	m_freeRanges.clear();
+	if (currentOffset < m_data.size())
+	{
+		m_freeRanges.emplace_back(MaterialsDataUploadRange{ currentOffset, m_data.size() - currentOffset });
+	}
+
+	return relocations;
+}
+
+const Byte* MaterialsDataStorage::GetData() const
+{
+	return m_data.data();
+}
+
+Uint64 MaterialsDataStorage::GetCapacity() const
+{
+	return m_data.size();
+}
+
+Uint64 MaterialsDataStorage::GetAllocatedSize() const
+{
+	return m_allocatedSize;
+}
+
+Uint64 MaterialsDataStorage::GetUsedSize() const
+{
+	if (m_freeRanges.empty())
+	{
+		return m_data.size();
+	}
+
+	const MaterialsDataUploadRange& lastFreeRange = m_freeRanges.back();
+	return lastFreeRange.offset + lastFreeRange.size == m_data.size() ? lastFreeRange.offset : m_data.size();
+}
+
+const MaterialsDataUploadStats& MaterialsDataStorage::GetLastFlushStats() const
+{
+	return m_lastFlushStats;
+}
+
+void MaterialsDataStorage::AddFreeRange(Uint64 offset, Uint64 size)
+{
+	const auto nextRangeIt = std::upper_bound(std::begin(m_freeRanges), std::end(m_freeRanges), offset,
+											  [](Uint64 value, const MaterialsDataUploadRange& range)
+											  {
+												  return value < range.offset;
+											  });
+
+	auto rangeIt = m_freeRanges.insert(nextRangeIt, MaterialsDataUploadRange{ offset, size });
+
+	// Merge with next range
+	const auto nextIt = std::next(rangeIt);
+	if (nextIt != std::end(m_freeRanges) && rangeIt->offset + rangeIt->size == nextIt->offset)
+	{
+		rangeIt->size += nextIt->size;
+		rangeIt = std::prev(m_freeRanges.erase(nextIt));
+	}
+
+	// Merge with previous range
+	if (rangeIt != std::begin(m_freeRanges))
+	{
+		const auto prevIt = std::prev(rangeIt);
+		if (prevIt->offset + prevIt->size == rangeIt->offset)
+		{
+			prevIt->size += rangeIt->size;
+			m_freeRanges.erase(rangeIt);
+		}
+	}
+}
+
+void MaterialsDataStorage::MarkDirty(Uint64 offset, Uint64 size)
+{
+	// Materials are usually created in batches, so in most cases new range directly follows the previous one
+	if (!m_dirtyRanges.empty())
+	{
+		MaterialsDataUploadRange& lastRange = m_dirtyRanges.back();
+		if (offset >= lastRange.offset && offset <= lastRange.offset + lastRange.size)
+		{
+			lastRange.size = std::max(lastRange.offset + lastRange.size, offset + size) - lastRange.offset;
+			return;
+		}
+	}
+
+	m_dirtyRanges.emplace_back(MaterialsDataUploadRange{ offset, size });
+}
+
+} // spt::mat
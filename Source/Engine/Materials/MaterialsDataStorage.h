@@ -0,0 +1,99 @@
+#pragma once
+
+#include "MaterialsMacros.h"
+#include "SculptorCoreTypes.h"
+#include "MaterialTypes.h"
+
+
+namespace spt::mat
+{
+
+struct MaterialsDataUploadRange
+{
+	Uint64 offset = 0u;
+	Uint64 size   = 0u;
+};
+
+
+struct MaterialDataRelocation
+{
+	Uint64 sourceOffset = 0u;
+	Uint64 destOffset   = 0u;
+};
+
+
+struct MaterialsDataUploadStats
+{
+	/** Number of material data writes that were staged since previous flush */
+	Uint32 stagedWritesNum = 0u;
+
+	/** Number of copies required to upload all staged writes */
+	Uint32 uploadsNum = 0u;
+
+	Uint64 uploadedBytes = 0u;
+};
+
+
+/**
+ * CPU mirror of materials unified buffer.
+ * Material data writes are staged in the mirror and only dirty ranges are uploaded to the GPU.
+ * Dirty ranges are merged during flush, so writes to neighbouring materials are uploaded with a single copy.
+ * This class doesn't access GPU resources and isn't thread safe.
+ */
+class MATERIALS_API MaterialsDataStorage
+{
+public:
+
+	/** Dirty ranges separated by gaps that aren't larger than maxMergedGapSize are uploaded as single range */
+	MaterialsDataStorage(Uint64 capacity, Uint64 alignment, Uint64 maxMergedGapSize);
+
+	/** Returns invalid suballocation if there's no free range that is large enough */
+	MaterialDataSuballocation Allocate(Uint64 dataSize);
+	void                      Release(const MaterialDataSuballocation& suballocation);
+
+	void Write(const MaterialDataSuballocation& suballocation, const Byte* data, Uint64 dataSize);
+
+	/** Returns minimal set of ranges that must be uploaded to the GPU and clears dirty state */
+	lib::DynamicArray<MaterialsDataUploadRange> FlushDirtyRanges();
+
+	/**
+	 * Moves all allocations to the beginning of the storage, so free space is not fragmented.
+	 * Moved ranges are marked as dirty. Returns relocations of all moved allocations, sorted by source offset.
+	 */
+	lib::DynamicArray<MaterialDataRelocation> Compact();
+
+	const Byte* GetData() const;
+
+	Uint64 GetCapacity() const;
+	Uint64 GetAllocatedSize() const;
+
+	/** Returns end of the last allocation. Difference between this and allocated size is wasted due to fragmentation */
+	Uint64 GetUsedSize() const;
+
+	const MaterialsDataUploadStats& GetLastFlushStats() const;
+
+private:
+
+	void AddFreeRange(Uint64 offset, Uint64 size);
+
+	void MarkDirty(Uint64 offset, Uint64 size);
+
+	lib::DynamicArray<Byte> m_data;
+
+	Uint64 m_alignment;
+	Uint64 m_maxMergedGapSize;
+
+	/** Free ranges sorted by offset. Neighbouring ranges are always merged */
+	lib::DynamicArray<MaterialsDataUploadRange> m_freeRanges;
+
+	/** Offset to size of all alive allocations */
+	lib::HashMap<Uint64, Uint64> m_allocations;
+	Uint64                       m_allocatedSize;
+
+	lib::DynamicArray<MaterialsDataUploadRange> m_dirtyRanges;
+	Uint32                                      m_stagedWritesNum;
+
+	MaterialsDataUploadStats m_lastFlushStats;
+};
+
+} // spt::mat
@@ -59,6 +59,48 @@ void MaterialsSubsystem::UpdateMaterialDefinition(ecs::EntityHandle material, co
 	materialProxy.params.emissive      = materialDef.emissive;
 }
 
+void MaterialsSubsystem::DestroyMaterial(ecs::EntityHandle material)
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	const MaterialProxyComponent& materialProxy = material.get<MaterialProxyComponent>();
+	MaterialsUnifiedData::Get().ReleaseMaterialDataSuballocation(materialProxy.materialDataSuballocation);
+
+	material.destroy();
+}
+
+void MaterialsSubsystem::CompactMaterialsData()
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	const lib::DynamicArray<MaterialDataRelocation> relocations = MaterialsUnifiedData::Get().CompactMaterialsData();
+
+	if (relocations.empty())
+	{
+		return;
+	}
+
+	lib::HashMap<Uint64, Uint64> offsetsRemapping;
+	offsetsRemapping.reserve(relocations.size());
+	for (const MaterialDataRelocation& relocation : relocations)
+	{
+		offsetsRemapping.emplace(relocation.sourceOffset, relocation.destOffset);
+	}
+
+	ecs::GetRegistry().view<MaterialProxyComponent>().each([&offsetsRemapping](MaterialProxyComponent& materialProxy)
+														   {
+															   const auto it = offsetsRemapping.find(materialProxy.materialDataSuballocation.offset);
+															   if (it != std::cend(offsetsRemapping))
+															   {
+																   materialProxy.materialDataSuballocation.offset = it->second;
+															   }
+														   });
+}
+
 const lib::DynamicArray<MaterialShader>& MaterialsSubsystem::GetMaterialShaders() const
 {
 	return m_materialShaders;
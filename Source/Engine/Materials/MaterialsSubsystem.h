@@ -67,6 +67,15 @@ public:
 
 	void UpdateMaterialDefinition(ecs::EntityHandle material, const MaterialDefinition& materialDef);
 
+	/** Releases material data and destroys material entity. Material must not be used by any render entity */
+	void DestroyMaterial(ecs::EntityHandle material);
+
+	/**
+	 * Compacts materials unified data and updates suballocations of all materials.
+	 * Material data handles cached outside of material proxies (e.g. in geometry batches) must be rebuilt after this call.
+	 */
+	void CompactMaterialsData();
+
 	template<typename TMaterialData>
 	void UpdateMaterialData(ecs::EntityHandle material, const TMaterialData& materialData);
 
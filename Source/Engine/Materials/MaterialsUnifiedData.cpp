@@ -8,6 +8,16 @@
 namespace spt::mat
 {
 
+namespace priv
+{
+
+static constexpr Uint64 materialsDataBufferSize = 1024u * 1024u;
+
+/** Gaps between dirty ranges smaller than this are uploaded together with the ranges, to avoid recording many tiny copies */
+static constexpr Uint64 maxMergedUploadGapSize = 256u;
+
+} // priv
+
 MaterialsUnifiedData& MaterialsUnifiedData::Get()
 {
 	static engn::TEngineSingleton<MaterialsUnifiedData> instance;
@@ -28,38 +38,82 @@ void MaterialsUnifiedData::AddMaterialTexture(const lib::SharedRef<rdr::TextureV
 	m_materialTextures.emplace_back(textureView);
 }
 
-rhi::RHIVirtualAllocation MaterialsUnifiedData::CreateMaterialDataSuballocation(Uint64 dataSize)
+MaterialDataSuballocation MaterialsUnifiedData::CreateMaterialDataSuballocation(Uint64 dataSize)
 {
 	SPT_PROFILER_FUNCTION();
 
-	const rhi::VirtualAllocationDefinition virtualAllocationDef(dataSize, constants::materialDataAlignment, rhi::EVirtualAllocationFlags::PreferMinMemory);
+	const lib::LockGuard lockGuard(m_lock);
 
-	return m_materialsUnifiedBuffer->GetRHI().CreateSuballocation(virtualAllocationDef);
+	return m_dataStorage.Allocate(dataSize);
 }
 
-rhi::RHIVirtualAllocation MaterialsUnifiedData::CreateMaterialDataSuballocation(const Byte* materialData, Uint64 dataSize)
+MaterialDataSuballocation MaterialsUnifiedData::CreateMaterialDataSuballocation(const Byte* materialData, Uint64 dataSize)
 {
 	SPT_PROFILER_FUNCTION();
 
-	const rhi::RHIVirtualAllocation suballocation = CreateMaterialDataSuballocation(dataSize);
+	const lib::LockGuard lockGuard(m_lock);
+
+	const MaterialDataSuballocation suballocation = m_dataStorage.Allocate(dataSize);
 	SPT_CHECK(suballocation.IsValid());
 
-	rdr::UploadDataToBuffer(lib::Ref(m_materialsUnifiedBuffer), suballocation.GetOffset(), materialData, dataSize);
+	m_dataStorage.Write(suballocation, materialData, dataSize);
 	
 	return suballocation;
 }
 
-void MaterialsUnifiedData::UpdateMaterialData(const rhi::RHIVirtualAllocation& suballocation, const Byte* materialData, Uint64 dataSize)
+void MaterialsUnifiedData::ReleaseMaterialDataSuballocation(const MaterialDataSuballocation& suballocation)
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	m_dataStorage.Release(suballocation);
+}
+
+void MaterialsUnifiedData::UpdateMaterialData(const MaterialDataSuballocation& suballocation, const Byte* materialData, Uint64 dataSize)
 {
 	SPT_PROFILER_FUNCTION();
 
 	SPT_CHECK(suballocation.IsValid());
 
-	rdr::UploadDataToBuffer(lib::Ref(m_materialsUnifiedBuffer), suballocation.GetOffset(), materialData, dataSize);
+	const lib::LockGuard lockGuard(m_lock);
+
+	m_dataStorage.Write(suballocation, materialData, dataSize);
+}
+
+void MaterialsUnifiedData::FlushPendingUpdates()
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	const lib::DynamicArray<MaterialsDataUploadRange> uploadRanges = m_dataStorage.FlushDirtyRanges();
+
+	for (const MaterialsDataUploadRange& range : uploadRanges)
+	{
+		rdr::UploadDataToBuffer(lib::Ref(m_materialsUnifiedBuffer), range.offset, m_dataStorage.GetData() + range.offset, range.size);
+	}
+}
+
+lib::DynamicArray<MaterialDataRelocation> MaterialsUnifiedData::CompactMaterialsData()
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	return m_dataStorage.Compact();
+}
+
+MaterialsDataUploadStats MaterialsUnifiedData::GetLastFlushStats() const
+{
+	const lib::LockGuard lockGuard(m_lock);
+
+	return m_dataStorage.GetLastFlushStats();
 }
 
 MaterialsUnifiedData::MaterialsUnifiedData()
 	: m_materialsUnifiedBuffer(CreateMaterialsUnifiedBuffer())
+	, m_dataStorage(priv::materialsDataBufferSize, constants::materialDataAlignment, priv::maxMergedUploadGapSize)
 {
 	rdr::GPUApi::GetOnRendererCleanupDelegate().AddLambda([this]
 															{
@@ -72,7 +126,7 @@ lib::SharedRef<rdr::Buffer> MaterialsUnifiedData::CreateMaterialsUnifiedBuffer()
 {
 	const rhi::RHIAllocationInfo allocationInfo(rhi::EMemoryUsage::GPUOnly);
 
-	const rhi::BufferDefinition bufferDefinition(1024 * 1024, lib::Flags(rhi::EBufferUsage::Storage, rhi::EBufferUsage::TransferDst), rhi::EBufferFlags::WithVirtualSuballocations);
+	const rhi::BufferDefinition bufferDefinition(priv::materialsDataBufferSize, lib::Flags(rhi::EBufferUsage::Storage, rhi::EBufferUsage::TransferDst));
 
 	return rdr::ResourcesManager::CreateBuffer(RENDERER_RESOURCE_NAME("MaterialsUnifiedData"), bufferDefinition, allocationInfo);
 }
@@ -4,6 +4,7 @@
 #include "SculptorCoreTypes.h"
 #include "ShaderStructs.h"
 #include "Bindless/BindlessTypes.h"
+#include "MaterialsDataStorage.h"
 
 
 namespace spt::mat
@@ -24,10 +25,24 @@ public:
 
 	void AddMaterialTexture(const lib::SharedRef<rdr::TextureView>& texture);
 
-	rhi::RHIVirtualAllocation CreateMaterialDataSuballocation(Uint64 dataSize);
-	rhi::RHIVirtualAllocation CreateMaterialDataSuballocation(const Byte* materialData, Uint64 dataSize);
+	MaterialDataSuballocation CreateMaterialDataSuballocation(Uint64 dataSize);
+	MaterialDataSuballocation CreateMaterialDataSuballocation(const Byte* materialData, Uint64 dataSize);
 
-	void UpdateMaterialData(const rhi::RHIVirtualAllocation& suballocation, const Byte* materialData, Uint64 dataSize);
+	void ReleaseMaterialDataSuballocation(const MaterialDataSuballocation& suballocation);
+
+	/** Data is staged on CPU and uploaded during next FlushPendingUpdates call */
+	void UpdateMaterialData(const MaterialDataSuballocation& suballocation, const Byte* materialData, Uint64 dataSize);
+
+	/** Uploads all material data changes since previous flush. Should be called once per frame before materials data is used on GPU */
+	void FlushPendingUpdates();
+
+	/**
+	 * Moves material data to the beginning of the buffer to reduce fragmentation after materials were released.
+	 * Suballocations and material data handles cached by caller become invalid and must be updated using returned relocations.
+	 */
+	lib::DynamicArray<MaterialDataRelocation> CompactMaterialsData();
+
+	MaterialsDataUploadStats GetLastFlushStats() const;
 
 	MaterialUnifiedData GetMaterialUnifiedData() const;
 
@@ -37,6 +52,10 @@ private:
 
 	lib::SharedPtr<rdr::Buffer> m_materialsUnifiedBuffer;
 
+	MaterialsDataStorage m_dataStorage;
+
+	mutable lib::Lock m_lock;
+
 	lib::DynamicArray<lib::SharedPtr<rdr::TextureView>> m_materialTextures;
 };
 
@@ -0,0 +1,208 @@
+#include "gtest/gtest.h"
+#include "MaterialsDataStorage.h"
+
+
+namespace spt::mat::tests
+{
+
+namespace priv
+{
+
+static constexpr Uint64 capacity         = 4096u;
+static constexpr Uint64 alignment        = 32u;
+static constexpr Uint64 maxMergedGapSize = 64u;
+
+
+struct TestMaterialData
+{
+	explicit TestMaterialData(Uint32 value)
+	{
+		std::fill(std::begin(data), std::end(data), value);
+	}
+
+	Uint32 data[8];
+};
+static_assert(sizeof(TestMaterialData) == alignment);
+
+
+static MaterialDataSuballocation CreateMaterial(MaterialsDataStorage& storage, Uint32 value)
+{
+	const TestMaterialData materialData(value);
+
+	const MaterialDataSuballocation suballocation = storage.Allocate(sizeof(TestMaterialData));
+	EXPECT_TRUE(suballocation.IsValid());
+
+	storage.Write(suballocation, reinterpret_cast<const Byte*>(&materialData), sizeof(TestMaterialData));
+
+	return suballocation;
+}
+
+
+static Uint32 ReadMaterialValue(const MaterialsDataStorage& storage, Uint64 offset)
+{
+	return reinterpret_cast<const TestMaterialData*>(storage.GetData() + offset)->data[0];
+}
+
+} // priv
+
+
+TEST(MaterialsDataStorageTests, CreatingManyMaterialsResultsInSingleUpload)
+{
+	MaterialsDataStorage storage(priv::capacity, priv::alignment, priv::maxMergedGapSize);
+
+	for (Uint32 materialIdx = 0u; materialIdx < 100u; ++materialIdx)
+	{
+		priv::CreateMaterial(storage, materialIdx);
+	}
+
+	const lib::DynamicArray<MaterialsDataUploadRange> uploadRanges = storage.FlushDirtyRanges();
+
+	ASSERT_EQ(uploadRanges.size(), 1u);
+	EXPECT_EQ(uploadRanges[0].offset, 0u);
+	EXPECT_EQ(uploadRanges[0].size, 100u * sizeof(priv::TestMaterialData));
+
+	const MaterialsDataUploadStats& stats = storage.GetLastFlushStats();
+	EXPECT_EQ(stats.stagedWritesNum, 100u);
+	EXPECT_EQ(stats.uploadsNum, 1u);
+	EXPECT_EQ(stats.uploadedBytes, 100u * sizeof(priv::TestMaterialData));
+}
+
+TEST(MaterialsDataStorageTests, FlushWithoutChangesDoesNotUploadAnything)
+{
+	MaterialsDataStorage storage(priv::capacity, priv::alignment, priv::maxMergedGapSize);
+
+	priv::CreateMaterial(storage, 1u);
+	storage.FlushDirtyRanges();
+
+	EXPECT_TRUE(storage.FlushDirtyRanges().empty());
+
+	const MaterialsDataUploadStats& stats = storage.GetLastFlushStats();
+	EXPECT_EQ(stats.stagedWritesNum, 0u);
+	EXPECT_EQ(stats.uploadsNum, 0u);
+	EXPECT_EQ(stats.uploadedBytes, 0u);
+}
+
+TEST(MaterialsDataStorageTests, DirtyRangesAreMergedOnlyIfGapIsSmall)
+{
+	MaterialsDataStorage storage(priv::capacity, priv::alignment, priv::maxMergedGapSize);
+
+	lib::DynamicArray<MaterialDataSuballocation> materials;
+	for (Uint32 materialIdx = 0u; materialIdx < 16u; ++materialIdx)
+	{
+		materials.emplace_back(priv::CreateMaterial(storage, materialIdx));
+	}
+	storage.FlushDirtyRanges();
+
+	const priv::TestMaterialData newData(100u);
+
+	// Updated out of order. Materials 0 and 2 are separated by single material, so they can be uploaded together, material 10 is too far
+	storage.Write(materials[10], reinterpret_cast<const Byte*>(&newData), sizeof(newData));
+	storage.Write(materials[2], reinterpret_cast<const Byte*>(&newData), sizeof(newData));
+	storage.Write(materials[0], reinterpret_cast<const Byte*>(&newData), sizeof(newData));
+	storage.Write(materials[2], reinterpret_cast<const Byte*>(&newData), sizeof(newData));
+
+	const lib::DynamicArray<MaterialsDataUploadRange> uploadRanges = storage.FlushDirtyRanges();
+
+	ASSERT_EQ(uploadRanges.size(), 2u);
+	EXPECT_EQ(uploadRanges[0].offset, materials[0].GetOffset());
+	EXPECT_EQ(uploadRanges[0].size, 3u * sizeof(priv::TestMaterialData));
+	EXPECT_EQ(uploadRanges[1].offset, materials[10].GetOffset());
+	EXPECT_EQ(uploadRanges[1].size, sizeof(priv::TestMaterialData));
+
+	const MaterialsDataUploadStats& stats = storage.GetLastFlushStats();
+	EXPECT_EQ(stats.stagedWritesNum, 4u);
+	EXPECT_EQ(stats.uploadsNum, 2u);
+	EXPECT_EQ(stats.uploadedBytes, 4u * sizeof(priv::TestMaterialData));
+}
+
+TEST(MaterialsDataStorageTests, ReleasedRangesAreReused)
+{
+	MaterialsDataStorage storage(priv::capacity, priv::alignment, priv::maxMergedGapSize);
+
+	const MaterialDataSuballocation first  = priv::CreateMaterial(storage, 1u);
+	const MaterialDataSuballocation second = priv::CreateMaterial(storage, 2u);
+	const MaterialDataSuballocation third  = priv::CreateMaterial(storage, 3u);
+
+	storage.Release(first);
+	storage.Release(second);
+
+	EXPECT_EQ(storage.GetAllocatedSize(), sizeof(priv::TestMaterialData));
+
+	// Released neighbouring ranges must be merged, so larger allocation fits there
+	const MaterialDataSuballocation large = storage.Allocate(2u * sizeof(priv::TestMaterialData));
+	ASSERT_TRUE(large.IsValid());
+	EXPECT_EQ(large.GetOffset(), first.GetOffset());
+
+	EXPECT_EQ(storage.GetUsedSize(), third.GetOffset() + third.GetSize());
+}
+
+TEST(MaterialsDataStorageTests, AllocationFailsWhenStorageIsFull)
+{
+	MaterialsDataStorage storage(4u * priv::alignment, priv::alignment, priv::maxMergedGapSize);
+
+	EXPECT_TRUE(storage.Allocate(3u * priv::alignment).IsValid());
+	EXPECT_FALSE(storage.Allocate(2u * priv::alignment).IsValid());
+	EXPECT_TRUE(storage.Allocate(1u).IsValid());
+	EXPECT_FALSE(storage.Allocate(1u).IsValid());
+}
+
+TEST(MaterialsDataStorageTests, CompactionMovesMaterialsAndPreservesData)
+{
+	MaterialsDataStorage storage(priv::capacity, priv::alignment, priv::maxMergedGapSize);
+
+	lib::DynamicArray<MaterialDataSuballocation> materials;
+	for (Uint32 materialIdx = 0u; materialIdx < 8u; ++materialIdx)
+	{
+		materials.emplace_back(priv::CreateMaterial(storage, materialIdx));
+	}
+
+	// Release every other material
+	for (Uint32 materialIdx = 0u; materialIdx < 8u; materialIdx += 2u)
+	{
+		storage.Release(materials[materialIdx]);
+	}
+
+	storage.FlushDirtyRanges();
+
+	EXPECT_EQ(storage.GetUsedSize(), 8u * sizeof(priv::TestMaterialData));
+
+	const lib::DynamicArray<MaterialDataRelocation> relocations = storage.Compact();
+
+	ASSERT_EQ(relocations.size(), 4u);
+	for (SizeType relocationIdx = 0u; relocationIdx < relocations.size(); ++relocationIdx)
+	{
+		const MaterialDataRelocation& relocation = relocations[relocationIdx];
+		EXPECT_EQ(relocation.sourceOffset, materials[relocationIdx * 2u + 1u].GetOffset());
+		EXPECT_EQ(relocation.destOffset, relocationIdx * sizeof(priv::TestMaterialData));
+		EXPECT_EQ(priv::ReadMaterialValue(storage, relocation.destOffset), static_cast<Uint32>(relocationIdx * 2u + 1u));
+	}
+
+	EXPECT_EQ(storage.GetUsedSize(), 4u * sizeof(priv::TestMaterialData));
+	EXPECT_EQ(storage.GetAllocatedSize(), 4u * sizeof(priv::TestMaterialData));
+
+	// Moved data must be uploaded
+	const lib::DynamicArray<MaterialsDataUploadRange> uploadRanges = storage.FlushDirtyRanges();
+	ASSERT_EQ(uploadRanges.size(), 1u);
+	EXPECT_EQ(uploadRanges[0].offset, 0u);
+	EXPECT_EQ(uploadRanges[0].size, 4u * sizeof(priv::TestMaterialData));
+
+	// Compacted storage is not fragmented, so new material is placed right after the last one
+	const MaterialDataSuballocation newMaterial = priv::CreateMaterial(storage, 100u);
+	EXPECT_EQ(newMaterial.GetOffset(), 4u * sizeof(priv::TestMaterialData));
+
+	// Relocated allocation can be released using new offset
+	storage.Release(MaterialDataSuballocation{ relocations[0].destOffset, sizeof(priv::TestMaterialData) });
+	EXPECT_EQ(storage.GetAllocatedSize(), 4u * sizeof(priv::TestMaterialData));
+}
+
+} // spt::mat::tests
+
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	const auto testsResult = RUN_ALL_TESTS();
+
+	return testsResult;
+}
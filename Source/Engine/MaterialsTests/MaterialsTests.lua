@@ -0,0 +1,8 @@
+MaterialsTests = Project:CreateProject("MaterialsTests", ETargetType.Application)
+
+function MaterialsTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("Materials")
+    self:AddPrivateDependency("GoogleTest")
+end
+
+MaterialsTests:SetupProject()
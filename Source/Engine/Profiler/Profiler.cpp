@@ -9,6 +9,32 @@
 namespace spt::prf
 {
 
+namespace priv
+{
+
+static void WriteJSONString(std::ostream& stream, std::string_view string)
+{
+	stream << '"';
+	for (const char c : string)
+	{
+		switch (c)
+		{
+		case '"':  stream << "\\\""; break;
+		case '\\': stream << "\\\\"; break;
+		case '\n': stream << "\\n"; break;
+		case '\t': stream << "\\t"; break;
+		default:
+			if (static_cast<unsigned char>(c) >= 0x20)
+			{
+				stream << c;
+			}
+		}
+	}
+	stream << '"';
+}
+
+} // priv
+
 Profiler& Profiler::Get()
 {
 	static Profiler instance;
@@ -30,9 +56,15 @@ ScopeMetrics Profiler::GetScopeMetrics(const lib::HashedString& scopeName) const
 
 void Profiler::ResetScopeMetrics()
 {
-	const lib::LockGuard lockGuard(m_scopeMetricsLock);
+	{
+		const lib::LockGuard lockGuard(m_scopeMetricsLock);
+		m_scopeMetrics.clear();
+	}
 
-	m_scopeMetrics.clear();
+	{
+		const lib::LockGuard lockGuard(m_cpuDataLock);
+		m_cpuScopeMetrics.clear();
+	}
 }
 
 Real32 Profiler::GetFrameTime(SizeType idx) const
@@ -79,6 +111,136 @@ const GPUProfilerStatistics& Profiler::GetGPUFrameStatistics() const
 	return m_gpuFrameStatistics;
 }
 
+Bool Profiler::IsCPUProfilerAvailable() const
+{
+	return ProfilerCore::GetInstance().GetNativeBackend() != nullptr;
+}
+
+CPUScopeMetrics Profiler::GetCPUScopeMetrics(const lib::HashedString& scopeName) const
+{
+	const lib::LockGuard lockGuard(m_cpuDataLock);
+
+	const auto it = m_cpuScopeMetrics.find(scopeName);
+	return it != m_cpuScopeMetrics.cend() ? it->second : CPUScopeMetrics{};
+}
+
+lib::DynamicArray<std::pair<lib::HashedString, CPUScopeMetrics>> Profiler::GetAllCPUScopeMetrics() const
+{
+	lib::DynamicArray<std::pair<lib::HashedString, CPUScopeMetrics>> metrics;
+
+	{
+		const lib::LockGuard lockGuard(m_cpuDataLock);
+		metrics.assign(std::cbegin(m_cpuScopeMetrics), std::cend(m_cpuScopeMetrics));
+	}
+
+	std::sort(std::begin(metrics), std::end(metrics),
+			  [](const auto& lhs, const auto& rhs)
+			  {
+				  return lhs.second.durationSumMs > rhs.second.durationSumMs;
+			  });
+
+	return metrics;
+}
+
+CPUProfilerFrame Profiler::GetLastCPUFrame() const
+{
+	const lib::LockGuard lockGuard(m_cpuDataLock);
+
+	return !m_cpuFrames.empty() ? m_cpuFrames.back() : CPUProfilerFrame{};
+}
+
+Real64 Profiler::CPUTicksToMs(Uint64 ticks) const
+{
+	const NativeProfilerBackend* nativeBackend = ProfilerCore::GetInstance().GetNativeBackend();
+	const Real64 ticksPerSecond = nativeBackend ? nativeBackend->GetTicksPerSecond() : 0.0;
+
+	return ticksPerSecond > 0.0 ? static_cast<Real64>(ticks) * 1000.0 / ticksPerSecond : 0.0;
+}
+
+Bool Profiler::SaveCPUTrace(const lib::String& path) const
+{
+	SPT_PROFILER_FUNCTION();
+
+	lib::DynamicArray<CPUProfilerFrame> frames;
+	{
+		const lib::LockGuard lockGuard(m_cpuDataLock);
+		frames = m_cpuFrames;
+	}
+
+	if (frames.empty())
+	{
+		return false;
+	}
+
+	std::ofstream stream = lib::File::OpenOutputStream(path, lib::Flags(lib::EFileOpenFlags::ForceCreate, lib::EFileOpenFlags::DiscardContent));
+	if (!stream.is_open())
+	{
+		return false;
+	}
+
+	const Uint64 traceBeginTicks = frames.front().beginTicks;
+	const auto ticksToUs = [this, traceBeginTicks](Uint64 ticks)
+	{
+		return CPUTicksToMs(ticks - std::min(ticks, traceBeginTicks)) * 1000.0;
+	};
+
+	stream << std::fixed << std::setprecision(3);
+	stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+	Bool isFirstEvent = true;
+	const auto beginEvent = [&stream, &isFirstEvent]()
+	{
+		if (!isFirstEvent)
+		{
+			stream << ",\n";
+		}
+		isFirstEvent = false;
+	};
+
+	lib::HashMap<Uint32, std::string_view> threadNames;
+
+	for (const CPUProfilerFrame& frame : frames)
+	{
+		beginEvent();
+		stream << "{\"name\":\"Frame " << frame.frameIdx << "\",\"ph\":\"X\",\"pid\":0,\"tid\":\"Frames\",\"ts\":" << ticksToUs(frame.beginTicks)
+			   << ",\"dur\":" << ticksToUs(frame.endTicks) - ticksToUs(frame.beginTicks) << "}";
+
+		for (const CPUProfilerThreadTimeline& thread : frame.threads)
+		{
+			threadNames[thread.threadIdx] = thread.threadName;
+
+			for (const CPUProfilerScope& scope : thread.scopes)
+			{
+				beginEvent();
+				stream << "{\"name\":";
+				priv::WriteJSONString(stream, scope.name);
+				stream << ",\"ph\":\"X\",\"pid\":0,\"tid\":" << thread.threadIdx << ",\"ts\":" << ticksToUs(scope.beginTicks)
+					   << ",\"dur\":" << ticksToUs(scope.endTicks) - ticksToUs(scope.beginTicks) << "}";
+			}
+		}
+	}
+
+	for (const auto& [threadIdx, threadName] : threadNames)
+	{
+		beginEvent();
+		stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << threadIdx << ",\"args\":{\"name\":";
+		priv::WriteJSONString(stream, threadName);
+		stream << "}}";
+	}
+
+	stream << "]}\n";
+
+	return stream.good();
+}
+
+Bool Profiler::SaveCPUTrace() const
+{
+	const engn::Paths& paths = engn::Engine::Get().GetPaths();
+	const lib::String path = (paths.tracesPath / lib::File::Utils::CreateFileNameFromTime("json")).generic_string();
+
+	return SaveCPUTrace(path);
+}
+
 Profiler::Profiler()
 	: m_startedCapture(false)
 	, m_recentFrameTimesNum(0)
@@ -107,6 +269,8 @@ void Profiler::OnBeginNewFrame()
 	
 	m_recentFrameTimes[newFrameTimeIdx] = deltaTime;
 	m_recentFrameTimesSum += deltaTime;
+
+	FlushCPUFrames();
 }
 
 void Profiler::FlushScopeMetrics(const rdr::GPUStatisticsScopeData& scope)
@@ -122,4 +286,57 @@ void Profiler::FlushScopeMetrics(const rdr::GPUStatisticsScopeData& scope)
 	}
 }
 
+void Profiler::FlushCPUFrames()
+{
+	SPT_PROFILER_FUNCTION();
+
+	NativeProfilerBackend* nativeBackend = ProfilerCore::GetInstance().GetNativeBackend();
+	if (!nativeBackend)
+	{
+		return;
+	}
+
+	std::vector<CPUProfilerFrame> newFrames = nativeBackend->ConsumeCollectedFrames();
+	if (newFrames.empty())
+	{
+		return;
+	}
+
+	const lib::LockGuard lockGuard(m_cpuDataLock);
+
+	for (CPUProfilerFrame& frame : newFrames)
+	{
+		for (const CPUProfilerThreadTimeline& thread : frame.threads)
+		{
+			for (const CPUProfilerScope& scope : thread.scopes)
+			{
+				const Real64 durationMs = CPUTicksToMs(scope.endTicks - scope.beginTicks);
+
+				CPUScopeMetrics& metrics = m_cpuScopeMetrics[GetCPUScopeName(scope)];
+				metrics.invocationsNum += 1u;
+				metrics.durationSumMs  += durationMs;
+				metrics.maxDurationMs  = std::max(metrics.maxDurationMs, durationMs);
+			}
+		}
+
+		m_cpuFrames.emplace_back(std::move(frame));
+	}
+
+	if (m_cpuFrames.size() > maxRetainedCPUFramesNum)
+	{
+		m_cpuFrames.erase(std::begin(m_cpuFrames), std::begin(m_cpuFrames) + (m_cpuFrames.size() - maxRetainedCPUFramesNum));
+	}
+}
+
+const lib::HashedString& Profiler::GetCPUScopeName(const CPUProfilerScope& scope)
+{
+	const auto [it, inserted] = m_cpuScopeNames.try_emplace(scope.nameHash);
+	if (inserted)
+	{
+		it->second = lib::HashedString(scope.name);
+	}
+
+	return it->second;
+}
+
 } // spt::prf
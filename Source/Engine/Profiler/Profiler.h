@@ -4,6 +4,7 @@
 #include "SculptorCoreTypes.h"
 #include "Delegates/MulticastDelegate.h"
 #include "GPUDiagnose/Profiler/GPUStatisticsCollector.h"
+#include "Backends/NativeBackend.h"
 
 
 namespace spt::rdr
@@ -42,6 +43,19 @@ struct ScopeMetrics
 };
 
 
+struct CPUScopeMetrics
+{
+	Real64 GetAverageDurationMs() const
+	{
+		return invocationsNum > 0u ? durationSumMs / static_cast<Real64>(invocationsNum) : 0.0;
+	}
+
+	Uint64 invocationsNum = 0u;
+	Real64 durationSumMs  = 0.0;
+	Real64 maxDurationMs  = 0.0;
+};
+
+
 class PROFILER_API Profiler
 {
 public:
@@ -69,6 +83,27 @@ public:
 
 	const GPUProfilerStatistics& GetGPUFrameStatistics() const;
 
+	// CPU ========================================================
+
+	/** Returns false if native CPU profiler backend is not used */
+	Bool IsCPUProfilerAvailable() const;
+
+	CPUScopeMetrics GetCPUScopeMetrics(const lib::HashedString& scopeName) const;
+
+	/** Returns metrics of all scopes, sorted by total duration */
+	lib::DynamicArray<std::pair<lib::HashedString, CPUScopeMetrics>> GetAllCPUScopeMetrics() const;
+
+	/** Returns most recent collected frame. Frame is empty if there are no collected frames */
+	CPUProfilerFrame GetLastCPUFrame() const;
+
+	Real64 CPUTicksToMs(Uint64 ticks) const;
+
+	/** Saves recently collected frames in Chrome trace event format (can be opened in chrome://tracing or Perfetto) */
+	Bool SaveCPUTrace(const lib::String& path) const;
+
+	/** Saves CPU trace to traces directory, with file name created from current time */
+	Bool SaveCPUTrace() const;
+
 private:
 
 	Profiler();
@@ -77,6 +112,10 @@ private:
 
 	void FlushScopeMetrics(const rdr::GPUStatisticsScopeData& scope);
 
+	void FlushCPUFrames();
+
+	const lib::HashedString& GetCPUScopeName(const CPUProfilerScope& scope);
+
 	Bool m_startedCapture;
 
 	lib::StaticArray<Real32, 100> m_recentFrameTimes;
@@ -94,6 +133,17 @@ private:
 
 	lib::HashMap<lib::HashedString, ScopeMetrics> m_scopeMetrics;
 	mutable lib::Lock                             m_scopeMetricsLock;
+
+	static constexpr SizeType maxRetainedCPUFramesNum = 120u;
+
+	/** Recent frames, used for timeline and trace export */
+	lib::DynamicArray<CPUProfilerFrame> m_cpuFrames;
+
+	lib::HashMap<lib::HashedString, CPUScopeMetrics> m_cpuScopeMetrics;
+	mutable lib::Lock                                m_cpuDataLock;
+
+	/** Hashed names are cached by hash of interned name computed by backend, to avoid hashing each recorded scope */
+	lib::HashMap<Uint64, lib::HashedString> m_cpuScopeNames;
 };
 
 } // spt::prf
\ No newline at end of file
@@ -56,6 +56,10 @@ void ProfilerUIView::DrawUI()
 
 	DrawGPUProfilerUI();
 
+	ImGui::Separator();
+
+	DrawCPUProfilerUI();
+
 	ImGui::End();
 }
 
@@ -180,4 +184,135 @@ void ProfilerUIView::DrawGPUScopeStatistics(const rdr::GPUStatisticsScopeData& s
 	ImGui::PopID();
 }
 
+void ProfilerUIView::DrawCPUProfilerUI()
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (ImGui::CollapsingHeader("CPU Stats", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const Profiler& profiler = Profiler::Get();
+
+		if (!profiler.IsCPUProfilerAvailable())
+		{
+			ImGui::Text("Native CPU profiler is not available");
+			return;
+		}
+
+		if (ImGui::Button("Save Chrome Trace"))
+		{
+			profiler.SaveCPUTrace();
+		}
+
+		const CPUProfilerFrame lastFrame = profiler.GetLastCPUFrame();
+
+		ImGui::Text("Frame %llu: %fms", lastFrame.frameIdx, profiler.CPUTicksToMs(lastFrame.endTicks - lastFrame.beginTicks));
+		if (lastFrame.droppedEventsNum > 0u)
+		{
+			ImGui::Text("Dropped events: %u", lastFrame.droppedEventsNum);
+		}
+
+		if (ImGui::CollapsingHeader("Timeline", ImGuiTreeNodeFlags_DefaultOpen))
+		{
+			DrawCPUTimeline(lastFrame);
+		}
+
+		if (ImGui::CollapsingHeader("Scopes"))
+		{
+			DrawCPUScopeStatistics();
+		}
+	}
+}
+
+void ProfilerUIView::DrawCPUTimeline(const CPUProfilerFrame& frame)
+{
+	const Profiler& profiler = Profiler::Get();
+
+	const Real32 rowHeight = ImGui::GetTextLineHeightWithSpacing();
+	const Real32 width     = ImGui::GetContentRegionAvail().x;
+
+	const Uint64 frameDurationTicks = std::max<Uint64>(frame.endTicks - frame.beginTicks, 1u);
+
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+	for (const CPUProfilerThreadTimeline& thread : frame.threads)
+	{
+		if (thread.scopes.empty())
+		{
+			continue;
+		}
+
+		Uint32 maxDepth = 0u;
+		for (const CPUProfilerScope& scope : thread.scopes)
+		{
+			maxDepth = std::max(maxDepth, scope.depth);
+		}
+
+		ImGui::Text("%s", thread.threadName.c_str());
+
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		const Real32 height = static_cast<Real32>(maxDepth + 1u) * rowHeight;
+
+		ImGui::PushID(static_cast<int>(thread.threadIdx));
+		ImGui::InvisibleButton("Timeline", ImVec2(width, height));
+		const Bool isTimelineHovered = ImGui::IsItemHovered();
+		ImGui::PopID();
+
+		const ImVec2 mousePosition = ImGui::GetMousePos();
+
+		for (const CPUProfilerScope& scope : thread.scopes)
+		{
+			// Scopes that started in previous frames are clamped to frame begin
+			const Uint64 beginTicks = std::clamp(scope.beginTicks, frame.beginTicks, frame.endTicks);
+			const Uint64 endTicks   = std::clamp(scope.endTicks, frame.beginTicks, frame.endTicks);
+
+			const Real32 beginX = origin.x + width * static_cast<Real32>(static_cast<Real64>(beginTicks - frame.beginTicks) / frameDurationTicks);
+			const Real32 endX   = origin.x + width * static_cast<Real32>(static_cast<Real64>(endTicks - frame.beginTicks) / frameDurationTicks);
+			const Real32 beginY = origin.y + static_cast<Real32>(scope.depth) * rowHeight;
+
+			const ImVec2 min(beginX, beginY);
+			const ImVec2 max(std::max(endX, beginX + 1.f), beginY + rowHeight - 1.f);
+
+			const lib::Color color(static_cast<Uint32>(std::hash<std::string_view>{}(scope.name)));
+			drawList->AddRectFilled(min, max, ImGui::ColorConvertFloat4ToU32(ImVec4(color.r, color.g, color.b, 1.f)));
+
+			if (max.x - min.x > ImGui::CalcTextSize(scope.name).x)
+			{
+				drawList->AddText(min, IM_COL32_WHITE, scope.name);
+			}
+
+			if (isTimelineHovered && mousePosition.x >= min.x && mousePosition.x < max.x && mousePosition.y >= min.y && mousePosition.y < max.y)
+			{
+				ImGui::BeginTooltip();
+				ImGui::Text("%s", scope.name);
+				ImGui::Text("%fms", profiler.CPUTicksToMs(scope.endTicks - scope.beginTicks));
+				ImGui::EndTooltip();
+			}
+		}
+	}
+}
+
+void ProfilerUIView::DrawCPUScopeStatistics()
+{
+	const lib::DynamicArray<std::pair<lib::HashedString, CPUScopeMetrics>> allMetrics = Profiler::Get().GetAllCPUScopeMetrics();
+
+	ImGui::Columns(5);
+	ImGui::Text("Scope");         ImGui::NextColumn();
+	ImGui::Text("Invocations");   ImGui::NextColumn();
+	ImGui::Text("Total Time");    ImGui::NextColumn();
+	ImGui::Text("Average Time");  ImGui::NextColumn();
+	ImGui::Text("Max Time");      ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (const auto& [scopeName, metrics] : allMetrics)
+	{
+		ImGui::Text("%s", scopeName.GetData());                   ImGui::NextColumn();
+		ImGui::Text("%llu", metrics.invocationsNum);              ImGui::NextColumn();
+		ImGui::Text("%f ms", metrics.durationSumMs);              ImGui::NextColumn();
+		ImGui::Text("%f ms", metrics.GetAverageDurationMs());     ImGui::NextColumn();
+		ImGui::Text("%f ms", metrics.maxDurationMs);              ImGui::NextColumn();
+	}
+
+	ImGui::EndColumns();
+}
+
 } // spt::prf
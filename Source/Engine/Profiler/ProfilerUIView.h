@@ -15,6 +15,7 @@ namespace spt::prf
 {
 
 struct GPUProfilerStatistics;
+struct CPUProfilerFrame;
 
 
 class PROFILER_API ProfilerUIView : public scui::UIView
@@ -41,6 +42,11 @@ private:
 	void DrawGPUScopeStatistics(const GPUProfilerStatistics& profilerStats);
 	void DrawGPUScopeStatistics(const rdr::GPUStatisticsScopeData& scopeStats, rdr::GPUDurationMs frameDuration);
 
+	void DrawCPUProfilerUI();
+
+	void DrawCPUTimeline(const CPUProfilerFrame& frame);
+	void DrawCPUScopeStatistics();
+
 	lib::StaticArray<float, 64>	m_lastFrameTimes;
 	SizeType					m_oldestFrameTimeIdx;
 
@@ -0,0 +1,378 @@
+#include "NativeBackend.h"
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
+#include <utility>
+
+#if defined(_M_X64) || defined(__x86_64__)
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <x86intrin.h>
+	#endif
+	#define SPT_NATIVE_PROFILER_USE_RDTSC 1
+#else
+	#define SPT_NATIVE_PROFILER_USE_RDTSC 0
+#endif
+
+
+namespace spt::prf
+{
+
+namespace priv
+{
+
+static Uint64 ReadTicks()
+{
+#if SPT_NATIVE_PROFILER_USE_RDTSC
+	return __rdtsc();
+#else
+	return static_cast<Uint64>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif // SPT_NATIVE_PROFILER_USE_RDTSC
+}
+
+static Uint64 ReadTimeNs()
+{
+	return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+
+struct InternedScopeName
+{
+	const char* name = nullptr;
+	Uint64      hash = 0u;
+};
+
+
+struct EventRecord
+{
+	/** Interned name. nullptr for end events */
+	InternedScopeName name;
+	Uint64            ticks = 0u;
+};
+
+
+/** Entry of per thread cache keyed by name pointer. Most scope names are string literals, so the same pointer is passed by every call */
+struct CachedNamePointer
+{
+	const char*       pointer = nullptr;
+	InternedScopeName name;
+};
+
+
+static constexpr SizeType namePointersCacheSize = 256u;
+
+
+static SizeType GetNamePointerCacheIdx(const char* name)
+{
+	// Literals are at least few bytes apart, so low bits don't carry information
+	return (reinterpret_cast<std::uintptr_t>(name) >> 3u) & (namePointersCacheSize - 1u);
+}
+
+
+struct ThreadBufferBinding
+{
+	NativeThreadEventsBuffer* buffer    = nullptr;
+	Uint32                    backendID = 0u;
+};
+
+static thread_local ThreadBufferBinding tlsThreadBuffer;
+
+static std::atomic<Uint32> backendIDCounter = 1u;
+
+} // priv
+
+
+/**
+ * Single producer (owning thread), single consumer (frame collector) ring buffer
+ */
+struct NativeThreadEventsBuffer
+{
+	static constexpr Uint64 capacity = NativeProfilerBackend::eventsBufferCapacity;
+	static constexpr Uint64 mask     = capacity - 1u;
+
+	static_assert((capacity & mask) == 0u, "Capacity must be power of 2");
+
+	explicit NativeThreadEventsBuffer(Uint32 inThreadIdx)
+		: events(std::make_unique<priv::EventRecord[]>(capacity))
+		, writeIdx(0u)
+		, readIdx(0u)
+		, droppedEventsNum(0u)
+		, droppedScopesDepth(0u)
+		, threadIdx(inThreadIdx)
+	{ }
+
+	void Push(priv::InternedScopeName name, Uint64 ticks)
+	{
+		const Bool isBeginEvent = name.name != nullptr;
+
+		// End of scope which begin was dropped must be dropped too, otherwise collector would pair it with wrong begin
+		if (!isBeginEvent && droppedScopesDepth > 0u)
+		{
+			--droppedScopesDepth;
+			droppedEventsNum.fetch_add(1u, std::memory_order_relaxed);
+			return;
+		}
+
+		const Uint64 currentWriteIdx = writeIdx.load(std::memory_order_relaxed);
+
+		// Once any begin event is dropped, all nested events are dropped as well
+		if (droppedScopesDepth > 0u || currentWriteIdx - readIdx.load(std::memory_order_acquire) >= capacity)
+		{
+			if (isBeginEvent)
+			{
+				++droppedScopesDepth;
+			}
+
+			droppedEventsNum.fetch_add(1u, std::memory_order_relaxed);
+			return;
+		}
+
+		events[currentWriteIdx & mask] = priv::EventRecord{ name, ticks };
+		writeIdx.store(currentWriteIdx + 1u, std::memory_order_release);
+	}
+
+	std::unique_ptr<priv::EventRecord[]> events;
+
+	std::atomic<Uint64> writeIdx;
+	std::atomic<Uint64> readIdx;
+
+	std::atomic<Uint32> droppedEventsNum;
+
+	// Owning thread only
+	Uint32 droppedScopesDepth;
+
+	/** Names already interned by this thread, keyed by content (views point to interned names) */
+	std::unordered_map<std::string_view, priv::InternedScopeName> internedNames;
+
+	/** Recently used name pointers. Checked before internedNames, so that scopes with literal names don't have to hash them */
+	std::array<priv::CachedNamePointer, priv::namePointersCacheSize> namePointers;
+
+	// Collector only (guarded by threads buffers lock)
+	Uint32                                                  threadIdx;
+	std::string                                             threadName;
+	std::vector<std::pair<priv::InternedScopeName, Uint64>> openScopes;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// NativeProfilerBackend =========================================================================
+
+NativeProfilerBackend::NativeProfilerBackend(ProfilerImpl* forwardedBackend /*= nullptr*/)
+	: m_forwardedBackend(forwardedBackend)
+	, m_backendID(priv::backendIDCounter.fetch_add(1u))
+	, m_frameIdx(0u)
+	, m_frameBeginTicks(priv::ReadTicks())
+	, m_calibrationBeginTicks(priv::ReadTicks())
+	, m_calibrationBeginTimeNs(priv::ReadTimeNs())
+#if SPT_NATIVE_PROFILER_USE_RDTSC
+	, m_ticksPerSecond(0.0)
+#else
+	, m_ticksPerSecond(static_cast<Real64>(std::chrono::steady_clock::period::den) / static_cast<Real64>(std::chrono::steady_clock::period::num))
+#endif // SPT_NATIVE_PROFILER_USE_RDTSC
+{ }
+
+NativeProfilerBackend::~NativeProfilerBackend()
+{
+	delete m_forwardedBackend;
+}
+
+void NativeProfilerBackend::BeginFrame()
+{
+	m_frameBeginTicks = priv::ReadTicks();
+
+	if (m_forwardedBackend)
+	{
+		m_forwardedBackend->BeginFrame();
+	}
+}
+
+void NativeProfilerBackend::EndFrame()
+{
+	if (m_forwardedBackend)
+	{
+		m_forwardedBackend->EndFrame();
+	}
+
+	const Uint64 frameEndTicks = priv::ReadTicks();
+
+	UpdateTicksFrequency(frameEndTicks);
+	CollectFrame(frameEndTicks);
+}
+
+void NativeProfilerBackend::BeginEvent(const char* name)
+{
+	NativeThreadEventsBuffer& buffer = GetThreadEventsBuffer();
+
+	// Names are read only when frame is collected, and callers may pass temporary strings, so each name is interned.
+	// Interned names are cached per thread, so shared names table is locked only when thread sees name for the first time
+	priv::CachedNamePointer& cachedPointer = buffer.namePointers[priv::GetNamePointerCacheIdx(name)];
+
+	// Pointer may be reused by temporary string with different content, so content is compared before cached name is used
+	if (cachedPointer.pointer != name || std::strcmp(cachedPointer.name.name, name) != 0)
+	{
+		const std::string_view nameView(name);
+
+		auto foundName = buffer.internedNames.find(nameView);
+		if (foundName == std::end(buffer.internedNames))
+		{
+			const char* internedName = InternScopeName(nameView);
+			foundName = buffer.internedNames.emplace(std::string_view(internedName), priv::InternedScopeName{ internedName, std::hash<std::string_view>{}(nameView) }).first;
+		}
+
+		cachedPointer.pointer = name;
+		cachedPointer.name    = foundName->second;
+	}
+
+	buffer.Push(cachedPointer.name, priv::ReadTicks());
+
+	if (m_forwardedBackend)
+	{
+		m_forwardedBackend->BeginEvent(name);
+	}
+}
+
+void NativeProfilerBackend::EndEvent()
+{
+	if (m_forwardedBackend)
+	{
+		m_forwardedBackend->EndEvent();
+	}
+
+	GetThreadEventsBuffer().Push(priv::InternedScopeName{}, priv::ReadTicks());
+}
+
+void NativeProfilerBackend::BeginThread(const char* name)
+{
+	NativeThreadEventsBuffer& buffer = GetThreadEventsBuffer();
+
+	{
+		const std::lock_guard<std::mutex> lock(m_threadBuffersLock);
+		buffer.threadName = name;
+	}
+
+	if (m_forwardedBackend)
+	{
+		m_forwardedBackend->BeginThread(name);
+	}
+}
+
+void NativeProfilerBackend::EndThread()
+{
+	if (m_forwardedBackend)
+	{
+		m_forwardedBackend->EndThread();
+	}
+}
+
+std::vector<CPUProfilerFrame> NativeProfilerBackend::ConsumeCollectedFrames()
+{
+	const std::lock_guard<std::mutex> lock(m_pendingFramesLock);
+	return std::exchange(m_pendingFrames, {});
+}
+
+Real64 NativeProfilerBackend::GetTicksPerSecond() const
+{
+	return m_ticksPerSecond.load(std::memory_order_relaxed);
+}
+
+NativeThreadEventsBuffer& NativeProfilerBackend::GetThreadEventsBuffer()
+{
+	priv::ThreadBufferBinding& binding = priv::tlsThreadBuffer;
+
+	if (binding.backendID != m_backendID)
+	{
+		const std::lock_guard<std::mutex> lock(m_threadBuffersLock);
+
+		const Uint32 threadIdx = static_cast<Uint32>(m_threadBuffers.size());
+		binding.buffer    = m_threadBuffers.emplace_back(std::make_unique<NativeThreadEventsBuffer>(threadIdx)).get();
+		binding.backendID = m_backendID;
+
+		binding.buffer->threadName = "Thread " + std::to_string(threadIdx);
+	}
+
+	return *binding.buffer;
+}
+
+const char* NativeProfilerBackend::InternScopeName(std::string_view name)
+{
+	const std::lock_guard<std::mutex> lock(m_scopeNamesLock);
+
+	return m_scopeNames.emplace(name).first->c_str();
+}
+
+void NativeProfilerBackend::CollectFrame(Uint64 frameEndTicks)
+{
+	CPUProfilerFrame frame;
+	frame.frameIdx   = m_frameIdx++;
+	frame.beginTicks = m_frameBeginTicks;
+	frame.endTicks   = frameEndTicks;
+
+	{
+		const std::lock_guard<std::mutex> lock(m_threadBuffersLock);
+
+		frame.threads.reserve(m_threadBuffers.size());
+
+		for (const std::unique_ptr<NativeThreadEventsBuffer>& buffer : m_threadBuffers)
+		{
+			CPUProfilerThreadTimeline& timeline = frame.threads.emplace_back();
+			timeline.threadName = buffer->threadName;
+			timeline.threadIdx  = buffer->threadIdx;
+
+			const Uint64 writeIdx = buffer->writeIdx.load(std::memory_order_acquire);
+			Uint64 readIdx        = buffer->readIdx.load(std::memory_order_relaxed);
+
+			for (; readIdx < writeIdx; ++readIdx)
+			{
+				const priv::EventRecord& event = buffer->events[readIdx & NativeThreadEventsBuffer::mask];
+
+				if (event.name.name)
+				{
+					buffer->openScopes.emplace_back(event.name, event.ticks);
+				}
+				else if (!buffer->openScopes.empty()) // scope could begin before thread buffer was created
+				{
+					const auto [name, beginTicks] = buffer->openScopes.back();
+					buffer->openScopes.pop_back();
+
+					timeline.scopes.emplace_back(CPUProfilerScope{ name.name, name.hash, beginTicks, event.ticks, static_cast<Uint32>(buffer->openScopes.size()) });
+				}
+			}
+
+			buffer->readIdx.store(readIdx, std::memory_order_release);
+
+			frame.droppedEventsNum += buffer->droppedEventsNum.exchange(0u, std::memory_order_relaxed);
+		}
+	}
+
+	const std::lock_guard<std::mutex> lock(m_pendingFramesLock);
+
+	if (m_pendingFrames.size() >= maxPendingFramesNum)
+	{
+		m_pendingFrames.erase(std::begin(m_pendingFrames));
+	}
+
+	m_pendingFrames.emplace_back(std::move(frame));
+}
+
+void NativeProfilerBackend::UpdateTicksFrequency(Uint64 currentTicks)
+{
+#if SPT_NATIVE_PROFILER_USE_RDTSC
+	const Uint64 elapsedTimeNs = priv::ReadTimeNs() - m_calibrationBeginTimeNs;
+
+	// Longer calibration period gives more precise results, so we're always measuring from backend creation
+	if (elapsedTimeNs > 0u)
+	{
+		const Real64 elapsedTicks = static_cast<Real64>(currentTicks - m_calibrationBeginTicks);
+		m_ticksPerSecond.store(elapsedTicks * 1e9 / static_cast<Real64>(elapsedTimeNs), std::memory_order_relaxed);
+	}
+#endif // SPT_NATIVE_PROFILER_USE_RDTSC
+}
+
+ProfilerImpl* CreateNativeBackend(ProfilerImpl* forwardedBackend)
+{
+	return new NativeProfilerBackend(forwardedBackend);
+}
+
+} // spt::prf
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "ProfilerCore.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+
+namespace spt::prf
+{
+
+/** Scope recorded by native profiler. Names are interned by backend, so they are valid as long as the backend */
+struct CPUProfilerScope
+{
+	const char* name       = nullptr;
+	Uint64      nameHash   = 0u;
+	Uint64      beginTicks = 0u;
+	Uint64      endTicks   = 0u;
+	Uint32      depth      = 0u;
+};
+
+
+struct CPUProfilerThreadTimeline
+{
+	std::string                   threadName;
+	Uint32                        threadIdx = 0u;
+	std::vector<CPUProfilerScope> scopes;
+};
+
+
+struct CPUProfilerFrame
+{
+	Uint64 frameIdx   = 0u;
+	Uint64 beginTicks = 0u;
+	Uint64 endTicks   = 0u;
+
+	/** Scopes that ended during this frame. Scopes are ordered by end time */
+	std::vector<CPUProfilerThreadTimeline> threads;
+
+	/** Events that were not recorded because ring buffer of thread was full */
+	Uint32 droppedEventsNum = 0u;
+};
+
+
+struct NativeThreadEventsBuffer;
+
+
+/**
+ * Profiler backend that doesn't depend on external tools.
+ * Each thread writes timestamped events to its own lock-free ring buffer, which is drained by frame collector at the end of each frame.
+ * Optionally forwards all events to other backend, so it can be used together with external profilers
+ */
+class NativeProfilerBackend : public ProfilerImpl
+{
+public:
+
+	static constexpr SizeType eventsBufferCapacity = 1u << 15;
+	static constexpr SizeType maxPendingFramesNum  = 128u;
+
+	explicit NativeProfilerBackend(ProfilerImpl* forwardedBackend = nullptr);
+	virtual ~NativeProfilerBackend();
+
+	// Begin ProfilerImpl overrides
+	virtual void BeginFrame() override;
+	virtual void EndFrame() override;
+	virtual void BeginEvent(const char* name) override;
+	virtual void EndEvent() override;
+	virtual void BeginThread(const char* name) override;
+	virtual void EndThread() override;
+	virtual NativeProfilerBackend* GetNativeBackend() override { return this; }
+	// End ProfilerImpl overrides
+
+	/** Returns frames collected since last call. If frames are not consumed, only the most recent maxPendingFramesNum frames are kept */
+	std::vector<CPUProfilerFrame> ConsumeCollectedFrames();
+
+	/** Frequency of timestamps used in collected frames. It's refined with each collected frame */
+	Real64 GetTicksPerSecond() const;
+
+private:
+
+	NativeThreadEventsBuffer& GetThreadEventsBuffer();
+
+	/** Returns copy of name owned by backend. Callers may pass temporary strings, so names cannot be stored by pointer */
+	const char* InternScopeName(std::string_view name);
+
+	void CollectFrame(Uint64 frameEndTicks);
+
+	void UpdateTicksFrequency(Uint64 currentTicks);
+
+	ProfilerImpl* m_forwardedBackend;
+
+	Uint32 m_backendID;
+
+	std::vector<std::unique_ptr<NativeThreadEventsBuffer>> m_threadBuffers;
+	mutable std::mutex                                     m_threadBuffersLock;
+
+	/** Node based set, so interned names are never moved */
+	std::unordered_set<std::string> m_scopeNames;
+	std::mutex                      m_scopeNamesLock;
+
+	std::vector<CPUProfilerFrame> m_pendingFrames;
+	mutable std::mutex            m_pendingFramesLock;
+
+	Uint64 m_frameIdx;
+	Uint64 m_frameBeginTicks;
+
+	Uint64 m_calibrationBeginTicks;
+	Uint64 m_calibrationBeginTimeNs;
+
+	std::atomic<Real64> m_ticksPerSecond;
+};
+
+
+ProfilerImpl* CreateNativeBackend(ProfilerImpl* forwardedBackend);
+
+} // spt::prf
@@ -1,6 +1,7 @@
 #include "ProfilerCore.h"
 #include "Backends/PerformanceAPIBackend.h"
 #include "Backends/PIXBackend.h"
+#include "Backends/NativeBackend.h"
 
 
 namespace spt::prf
@@ -14,11 +15,14 @@ ProfilerCore& ProfilerCore::GetInstance()
 
 void ProfilerCore::Initialize()
 {
+	// Native backend is always used, so CPU timings are available without external tools. External backend is optional
 #if 1
-	m_impl = CreatePIXBackend();
+	ProfilerImpl* externalBackend = CreatePIXBackend();
 #else
-	m_impl = CreatePerformanceAPIBackend();
+	ProfilerImpl* externalBackend = CreatePerformanceAPIBackend();
 #endif
+
+	m_impl = CreateNativeBackend(externalBackend);
 }
 
 void ProfilerCore::InitializeModule(ProfilerImpl* impl)
@@ -6,6 +6,9 @@
 namespace spt::prf
 {
 
+class NativeProfilerBackend;
+
+
 class ProfilerImpl
 {
 public:
@@ -21,6 +24,9 @@ public:
 
 	virtual void BeginThread(const char* name) = 0;
 	virtual void EndThread() = 0;
+
+	/** Returns native backend if it's used, so that collected data can be accessed */
+	virtual NativeProfilerBackend* GetNativeBackend() { return nullptr; }
 };
 
 
@@ -36,6 +42,11 @@ public:
 	void          InitializeModule(ProfilerImpl* impl);
 	ProfilerImpl* GetProfiler() const { return m_impl; }
 
+	NativeProfilerBackend* GetNativeBackend() const
+	{
+		return m_impl ? m_impl->GetNativeBackend() : nullptr;
+	}
+
 	void BeginFrame()
 	{
 		if (m_impl)
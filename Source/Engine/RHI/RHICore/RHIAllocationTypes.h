@@ -254,6 +254,9 @@ struct RHIPlacedAllocationDefinition
 {
 	RHIGPUMemoryPool*       pool  = nullptr;
 	EVirtualAllocationFlags flags = EVirtualAllocationFlags::None;
+
+	/** If set, resource is bound at this offset and pool's virtual allocator is not used. Caller is responsible for handling overlapping resources */
+	Uint64                  offset = idxNone<Uint64>;
 };
 
 
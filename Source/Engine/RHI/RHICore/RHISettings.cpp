@@ -22,6 +22,8 @@ void RHISettings::Initialize()
 	enableGPUCrashDumps = cmdLineArgs.Contains(enableGPUCrashDumpsCmdArgName);
 	
 	enablePersistentDebugNames = cmdLineArgs.Contains(enablePersistentDebugNamesCmdArgName);
+
+	enablePersistentPipelineCache = !cmdLineArgs.Contains(disablePersistentPipelineCacheCmdArgName);
 }
 
 } // spt::rhi
@@ -19,6 +19,7 @@ public:
 	Bool IsRayTracingEnabled() const { return enableRayTracing; }
 	Bool AreGPUCrashDumpsEnabled() const { return enableGPUCrashDumps; }
 	Bool ArePersistentDebugNamesEnabled() const { return enablePersistentDebugNames; }
+	Bool IsPersistentPipelineCacheEnabled() const { return enablePersistentPipelineCache; }
 
 private:
 
@@ -40,6 +41,10 @@ private:
 	 */
 	static inline const char* enablePersistentDebugNamesCmdArgName = "-RHIPersistentNames";
 	Bool enablePersistentDebugNames = false;
+
+	/** If it's set, pipeline cache isn't loaded from and saved to disk (useful when investigating driver issues) */
+	static inline const char* disablePersistentPipelineCacheCmdArgName = "-DisablePipelineCache";
+	Bool enablePersistentPipelineCache = true;
 };
 
 } // spt::rhi
@@ -486,6 +486,8 @@ struct TextureDefinition
 	Uint32				arrayLayers;
 	ETextureFlags		flags;
 	ETextureType		type;
+
+	Bool operator==(const TextureDefinition& rhs) const = default;
 };
 
 
@@ -728,3 +730,30 @@ inline Uint32 ComputeBlockCompressedMipsNumForResolution(math::Vector2u resoluti
 } // texture_utils
 
 } // spt::rhi
+
+
+namespace spt::lib
+{
+
+template<>
+struct Hasher<rhi::TextureDefinition>
+{
+	size_t operator()(const rhi::TextureDefinition& textureDef) const
+	{
+		const math::Vector3u& resolution = textureDef.resolution.AsVector();
+
+		return HashCombine(resolution.x(),
+						   resolution.y(),
+						   resolution.z(),
+						   textureDef.usage,
+						   textureDef.format,
+						   textureDef.samples,
+						   textureDef.tiling,
+						   textureDef.mipLevels,
+						   textureDef.arrayLayers,
+						   textureDef.flags,
+						   textureDef.type);
+	}
+};
+
+} // spt::lib
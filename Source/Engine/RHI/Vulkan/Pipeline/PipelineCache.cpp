@@ -0,0 +1,202 @@
+#include "PipelineCache.h"
+#include "Vulkan/VulkanRHI.h"
+#include "Vulkan/VulkanRHIUtils.h"
+#include "Vulkan/Device/PhysicalDevice.h"
+#include "Logging/Log.h"
+
+
+namespace spt::vulkan
+{
+
+SPT_DEFINE_LOG_CATEGORY(VulkanPipelineCache, true);
+
+namespace priv
+{
+
+static constexpr Uint32 pipelineCacheFileMagic   = 0x43505053u; // "SPPC"
+static constexpr Uint32 pipelineCacheFileVersion = 1u;
+
+
+struct PipelineCacheFileHeader
+{
+	Uint32				magic    = pipelineCacheFileMagic;
+	Uint32				version  = pipelineCacheFileVersion;
+	PipelineCacheKey	key;
+	Uint64				dataSize = 0u;
+	Uint64				dataHash = 0u;
+};
+
+
+static Uint64 HashCacheData(const Byte* data, SizeType dataSize)
+{
+	SPT_PROFILER_FUNCTION();
+
+	return lib::FNV1a::Hash({ reinterpret_cast<const char*>(data), dataSize });
+}
+
+} // priv
+
+void PipelineCache::InitializeRHI(VkDevice device, VkPhysicalDevice physicalDevice, const lib::Path& cacheFilePath)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(m_handle == VK_NULL_HANDLE);
+
+	m_cacheFilePath = cacheFilePath;
+
+	const VkPhysicalDeviceProperties deviceProps = PhysicalDevice::GetDeviceProperties(physicalDevice).properties;
+	m_key.vendorID      = deviceProps.vendorID;
+	m_key.deviceID      = deviceProps.deviceID;
+	m_key.driverVersion = deviceProps.driverVersion;
+	std::copy_n(deviceProps.pipelineCacheUUID, VK_UUID_SIZE, m_key.pipelineCacheUUID.data());
+
+	const lib::DynamicArray<Byte> cacheData = LoadCacheData();
+
+	VkPipelineCacheCreateInfo cacheInfo{ VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+	cacheInfo.initialDataSize = cacheData.size();
+	cacheInfo.pInitialData    = !cacheData.empty() ? cacheData.data() : nullptr;
+
+	SPT_VK_CHECK(vkCreatePipelineCache(device, &cacheInfo, VulkanRHI::GetAllocationCallbacks(), &m_handle));
+}
+
+void PipelineCache::ReleaseRHI(VkDevice device)
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (m_handle != VK_NULL_HANDLE)
+	{
+		SaveToFile(device);
+
+		vkDestroyPipelineCache(device, m_handle, VulkanRHI::GetAllocationCallbacks());
+		m_handle = VK_NULL_HANDLE;
+	}
+}
+
+void PipelineCache::SaveToFile(VkDevice device) const
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(m_handle != VK_NULL_HANDLE);
+
+	if (m_cacheFilePath.empty())
+	{
+		return;
+	}
+
+	size_t dataSize = 0u;
+	SPT_VK_CHECK(vkGetPipelineCacheData(device, m_handle, &dataSize, nullptr));
+
+	if (dataSize == 0u)
+	{
+		return;
+	}
+
+	lib::DynamicArray<Byte> cacheData(dataSize);
+	const VkResult result = vkGetPipelineCacheData(device, m_handle, &dataSize, cacheData.data());
+	if (result != VK_SUCCESS) // VK_INCOMPLETE if pipelines were created in the meantime
+	{
+		SPT_LOG_WARN(VulkanPipelineCache, "Failed to get pipeline cache data (result: {})", static_cast<Int32>(result));
+		return;
+	}
+
+	priv::PipelineCacheFileHeader header;
+	header.key      = m_key;
+	header.dataSize = dataSize;
+	header.dataHash = priv::HashCacheData(cacheData.data(), dataSize);
+
+	// Write to temporary file first, so cache from previous session is not lost if writing fails
+	lib::Path tempFilePath = m_cacheFilePath;
+	tempFilePath += ".tmp";
+
+	{
+		std::ofstream stream = lib::File::OpenOutputStream(tempFilePath, lib::Flags(lib::EFileOpenFlags::ForceCreate, lib::EFileOpenFlags::DiscardContent, lib::EFileOpenFlags::Binary));
+		if (!stream.is_open())
+		{
+			SPT_LOG_WARN(VulkanPipelineCache, "Failed to open file {} for writing", tempFilePath.generic_string());
+			return;
+		}
+
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.write(reinterpret_cast<const char*>(cacheData.data()), dataSize);
+
+		if (!stream.good())
+		{
+			SPT_LOG_WARN(VulkanPipelineCache, "Failed to write pipeline cache to {}", tempFilePath.generic_string());
+			return;
+		}
+	}
+
+	std::error_code errorCode;
+	std::filesystem::rename(tempFilePath, m_cacheFilePath, errorCode);
+
+	if (errorCode)
+	{
+		SPT_LOG_WARN(VulkanPipelineCache, "Failed to save pipeline cache to {}: {}", m_cacheFilePath.generic_string(), errorCode.message());
+	}
+	else
+	{
+		SPT_LOG_INFO(VulkanPipelineCache, "Saved pipeline cache ({} bytes)", dataSize);
+	}
+}
+
+VkPipelineCache PipelineCache::GetHandle() const
+{
+	return m_handle;
+}
+
+lib::DynamicArray<Byte> PipelineCache::LoadCacheData() const
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (m_cacheFilePath.empty())
+	{
+		return {};
+	}
+
+	std::error_code errorCode;
+	const Uint64 fileSize = std::filesystem::file_size(m_cacheFilePath, errorCode);
+	if (errorCode)
+	{
+		return {};
+	}
+
+	std::ifstream stream = lib::File::OpenInputStream(m_cacheFilePath, lib::EFileOpenFlags::Binary);
+	if (!stream.is_open())
+	{
+		return {};
+	}
+
+	priv::PipelineCacheFileHeader header;
+	stream.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+	if (!stream.good()
+		|| header.magic != priv::pipelineCacheFileMagic
+		|| header.version != priv::pipelineCacheFileVersion
+		|| header.dataSize != fileSize - sizeof(priv::PipelineCacheFileHeader))
+	{
+		SPT_LOG_WARN(VulkanPipelineCache, "Pipeline cache {} has invalid header and will be discarded", m_cacheFilePath.generic_string());
+		return {};
+	}
+
+	// Cache created by different device or driver would be rejected by the driver anyway, but some drivers don't validate it properly
+	if (header.key != m_key)
+	{
+		SPT_LOG_INFO(VulkanPipelineCache, "Pipeline cache was created for different device or driver and will be discarded");
+		return {};
+	}
+
+	lib::DynamicArray<Byte> cacheData(header.dataSize);
+	stream.read(reinterpret_cast<char*>(cacheData.data()), header.dataSize);
+
+	if (!stream.good() || priv::HashCacheData(cacheData.data(), cacheData.size()) != header.dataHash)
+	{
+		SPT_LOG_WARN(VulkanPipelineCache, "Pipeline cache {} is corrupted and will be discarded", m_cacheFilePath.generic_string());
+		return {};
+	}
+
+	SPT_LOG_INFO(VulkanPipelineCache, "Loaded pipeline cache ({} bytes)", cacheData.size());
+
+	return cacheData;
+}
+
+} // spt::vulkan
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "SculptorCoreTypes.h"
+#include "Vulkan/VulkanCore.h"
+#include "FileSystem/File.h"
+
+
+namespace spt::vulkan
+{
+
+/** Identifies device and driver for which pipeline cache data was created */
+struct PipelineCacheKey
+{
+	Uint32									vendorID      = 0u;
+	Uint32									deviceID      = 0u;
+	Uint32									driverVersion = 0u;
+	lib::StaticArray<Uint8, VK_UUID_SIZE>	pipelineCacheUUID{};
+
+	Bool operator==(const PipelineCacheKey& rhs) const = default;
+};
+
+
+/**
+ * VkPipelineCache that is persisted between runs, so pipelines compiled in previous sessions are created much faster.
+ * Saved data is discarded if it was created for different device or driver, or if it's corrupted.
+ */
+class PipelineCache
+{
+public:
+
+	PipelineCache() = default;
+
+	void			InitializeRHI(VkDevice device, VkPhysicalDevice physicalDevice, const lib::Path& cacheFilePath);
+	void			ReleaseRHI(VkDevice device);
+
+	void			SaveToFile(VkDevice device) const;
+
+	VkPipelineCache	GetHandle() const;
+
+private:
+
+	lib::DynamicArray<Byte>	LoadCacheData() const;
+
+	VkPipelineCache		m_handle = VK_NULL_HANDLE;
+
+	lib::Path			m_cacheFilePath;
+
+	PipelineCacheKey	m_key;
+};
+
+} // spt::vulkan
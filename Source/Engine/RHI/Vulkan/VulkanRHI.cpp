@@ -9,6 +9,7 @@
 #include "VulkanTypes/RHICommandBuffer.h"
 #include "VulkanUtils.h"
 #include "Pipeline/PipelineLayoutsManager.h"
+#include "Pipeline/PipelineCache.h"
 #include "Engine.h"
 
 #include "RHICore/RHIInitialization.h"
@@ -53,6 +54,8 @@ public:
 
 	PipelineLayoutsManager      pipelineLayoutsManager;
 
+	PipelineCache               pipelineCache;
+
 	rhi::RHISettings            rhiSettings;
 };
 
@@ -229,6 +232,11 @@ void VulkanRHI::Initialize(const rhi::RHIInitializationInfo& initInfo)
 	VulkanRHILimits::Initialize(GetLogicalDevice(), GetPhysicalDeviceHandle());
 
 	priv::g_data->memoryManager.Initialize(priv::g_data->instance, priv::g_data->device.GetHandle(), priv::g_data->physicalDevice, GetAllocationCallbacks());
+
+	const lib::Path pipelineCacheFilePath = GetSettings().IsPersistentPipelineCacheEnabled()
+										  ? engn::GetEngine().GetPaths().pipelineCachePath / "VulkanPipelineCache.bin"
+										  : lib::Path();
+	priv::g_data->pipelineCache.InitializeRHI(priv::g_data->device.GetHandle(), priv::g_data->physicalDevice, pipelineCacheFilePath);
 }
 
 void VulkanRHI::Uninitialize()
@@ -237,6 +245,8 @@ void VulkanRHI::Uninitialize()
 
 	priv::g_data->pipelineLayoutsManager.ReleaseRHI();
 
+	priv::g_data->pipelineCache.ReleaseRHI(priv::g_data->device.GetHandle());
+
 	if (priv::g_data->memoryManager.IsValid())
 	{
 		priv::g_data->memoryManager.Destroy();
@@ -348,6 +358,11 @@ PipelineLayoutsManager& VulkanRHI::GetPipelineLayoutsManager()
 	return priv::g_data->pipelineLayoutsManager;
 }
 
+VkPipelineCache VulkanRHI::GetPipelineCacheHandle()
+{
+	return priv::g_data->pipelineCache.GetHandle();
+}
+
 const LogicalDevice& VulkanRHI::GetLogicalDevice()
 {
 	return priv::g_data->device;
@@ -87,6 +87,8 @@ public:
 
 	static PipelineLayoutsManager&			GetPipelineLayoutsManager();
 
+	static VkPipelineCache					GetPipelineCacheHandle();
+
 	static const LogicalDevice&				GetLogicalDevice();
 
 	static VulkanMemoryManager&				GetMemoryManager();
@@ -474,6 +474,7 @@ rhi::RHIResourceAllocationHandle RHIBuffer::DoPlacedAllocation(const rhi::RHIPla
 {
 	SPT_CHECK(!!placedAllocationDef.pool);
 	SPT_CHECK(placedAllocationDef.pool->IsValid());
+	SPT_CHECK_MSG(placedAllocationDef.offset == idxNone<Uint64>, "Explicit offsets are supported only for textures");
 
 	VkMemoryRequirements memoryRequirements{};
 	vkGetBufferMemoryRequirements(VulkanRHI::GetDeviceHandle(), m_bufferHandle, OUT &memoryRequirements);
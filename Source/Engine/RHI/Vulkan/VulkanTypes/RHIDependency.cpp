@@ -318,6 +318,14 @@ void RHIDependency::WaitEvent(const RHICommandBuffer& cmdBuffer, const RHIEvent&
 	vkCmdWaitEvents2(cmdBuffer, 1, &eventHandle, &dependencyInfo);
 }
 
+void RHIDependency::ResetEvent(const RHICommandBuffer& cmdBuffer, const RHIEvent& event) const
+{
+	SPT_CHECK(event.IsValid());
+
+	// Reset is done after stages that waited for the event, so that it can be signaled again by next users
+	vkCmdResetEvent2(cmdBuffer.GetHandle(), event.GetHandle(), m_memoryBarrier.dstStageMask);
+}
+
 VkDependencyInfo RHIDependency::GetDependencyInfo() const
 {
 #if DO_CHECKS
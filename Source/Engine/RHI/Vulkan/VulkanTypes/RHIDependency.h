@@ -44,6 +44,7 @@ public:
 
 	void SetEvent(const RHICommandBuffer& cmdBuffer, const RHIEvent& event);
 	void WaitEvent(const RHICommandBuffer& cmdBuffer, const RHIEvent& event);
+	void ResetEvent(const RHICommandBuffer& cmdBuffer, const RHIEvent& event) const;
 
 	// Vulkan Only ============================================================
 
@@ -334,7 +334,7 @@ static VkPipeline BuildGraphicsPipeline(const GraphicsPipelineBuildDefinition& p
 
 	VkPipeline pipelineHandle = VK_NULL_HANDLE;
 
-	const VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+	const VkPipelineCache pipelineCache = VulkanRHI::GetPipelineCacheHandle();
 
 	SPT_VK_CHECK(vkCreateGraphicsPipelines(VulkanRHI::GetDeviceHandle(),
 										   pipelineCache,
@@ -378,7 +378,7 @@ static VkPipeline BuildComputePipeline(const ComputePipelineBuildDefinition& pip
 	pipelineInfo.basePipelineHandle	= VK_NULL_HANDLE;
 	pipelineInfo.basePipelineIndex	= 0;
 
-	const VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+	const VkPipelineCache pipelineCache = VulkanRHI::GetPipelineCacheHandle();
 
 	VkPipeline pipelineHandle = VK_NULL_HANDLE;
 
@@ -510,7 +510,7 @@ static VkPipeline BuildRayTracingPipeline(const RayTracingPipelineBuildDefinitio
 	pipelineInfo.maxPipelineRayRecursionDepth	= pipelineDef.maxRayRecursionDepth;
 	pipelineInfo.layout							= pipelineBuildDef.layout.GetHandle();
 
-	const VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+	const VkPipelineCache pipelineCache = VulkanRHI::GetPipelineCacheHandle();
 
 	VkPipeline pipelineHandle = VK_NULL_HANDLE;
 
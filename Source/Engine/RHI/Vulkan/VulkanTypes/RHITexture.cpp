@@ -624,6 +624,23 @@ rhi::RHIResourceAllocationHandle RHITexture::DoPlacedAllocation(const rhi::RHIPl
 	VkMemoryRequirements memoryRequirements{};
 	vkGetImageMemoryRequirements(VulkanRHI::GetDeviceHandle(), m_imageHandle, OUT &memoryRequirements);
 
+	const VmaAllocation poolMemoryAllocation = placedAllocationDef.pool->GetAllocation();
+
+	if (placedAllocationDef.offset != idxNone<Uint64>)
+	{
+		SPT_CHECK(placedAllocationDef.offset % memoryRequirements.alignment == 0u);
+
+		if (placedAllocationDef.offset + memoryRequirements.size > placedAllocationDef.pool->GetSize())
+		{
+			return rhi::RHINullAllocation{};
+		}
+
+		vmaBindImageMemory2(VulkanRHI::GetAllocatorHandle(), poolMemoryAllocation, placedAllocationDef.offset, m_imageHandle, nullptr);
+
+		// Explicitly placed resources don't own virtual allocation, so suballocation handle is invalid
+		return rhi::RHIPlacedAllocation(rhi::RHICommittedAllocation(reinterpret_cast<Uint64>(poolMemoryAllocation)), rhi::RHIVirtualAllocation(rhi::RHIVirtualAllocationHandle{ 0 }, placedAllocationDef.offset));
+	}
+
 	rhi::VirtualAllocationDefinition suballocationDefinition{};
 	suballocationDefinition.size      = memoryRequirements.size;
 	suballocationDefinition.alignment = memoryRequirements.alignment;
@@ -635,8 +652,6 @@ rhi::RHIResourceAllocationHandle RHITexture::DoPlacedAllocation(const rhi::RHIPl
 		return rhi::RHINullAllocation{};
 	}
 
-	const VmaAllocation poolMemoryAllocation = placedAllocationDef.pool->GetAllocation();
-
 	vmaBindImageMemory2(VulkanRHI::GetAllocatorHandle(), poolMemoryAllocation, suballocation.GetOffset(), m_imageHandle, nullptr);
 
 	return rhi::RHIPlacedAllocation(rhi::RHICommittedAllocation(reinterpret_cast<Uint64>(poolMemoryAllocation)), suballocation);
@@ -40,7 +40,7 @@ void RHIUIBackend::InitializeRHI(ui::UIContext context, const RHIWindow& window)
     initInfo.Device = device.GetHandle();
     initInfo.QueueFamily = device.GetGfxQueueFamilyIdx();
     initInfo.Queue = device.GetGfxQueue().GetHandleChecked();
-    initInfo.PipelineCache = VK_NULL_HANDLE;
+    initInfo.PipelineCache = VulkanRHI::GetPipelineCacheHandle();
 	initInfo.DescriptorPool = m_uiDescriptorPools[0];
     initInfo.MinImageCount = imagesNum;
     initInfo.ImageCount = imagesNum;
@@ -0,0 +1,255 @@
+#include "RGCompilation.h"
+#include "MathUtils.h"
+
+
+namespace spt::rg
+{
+
+namespace priv
+{
+
+struct RGResourceSynchronizationState
+{
+	Bool HasWrite() const
+	{
+		return writeStage != rhi::EPipelineStage::None || writeAccess != rhi::EAccessType::None;
+	}
+
+	Bool HasReadsSinceWrite() const
+	{
+		return lastReadNodeIdx != idxNone<Uint32>;
+	}
+
+	Uint32              writeNodeIdx = idxNone<Uint32>;
+	rhi::EPipelineStage writeStage   = rhi::EPipelineStage::None;
+	rhi::EAccessType    writeAccess  = rhi::EAccessType::None;
+
+	/** Stages that read resource since last write. Last write is already visible for all of them */
+	rhi::EPipelineStage readStages      = rhi::EPipelineStage::None;
+	rhi::EPipelineStage lastReadStage   = rhi::EPipelineStage::None;
+	Uint32              lastReadNodeIdx = idxNone<Uint32>;
+};
+
+
+static void AddDependency(lib::DynamicArray<RGPlannedDependency>& nodeDependencies, Uint32 sourceNodeIdx, Uint32 destNodeIdx,
+						  rhi::EPipelineStage sourceStage, rhi::EAccessType sourceAccess, rhi::EPipelineStage destStage, rhi::EAccessType destAccess)
+{
+	const auto foundDependency = std::find_if(std::begin(nodeDependencies), std::end(nodeDependencies),
+											  [sourceNodeIdx](const RGPlannedDependency& dependency)
+											  {
+												  return dependency.sourceNodeIdx == sourceNodeIdx;
+											  });
+
+	RGPlannedDependency& dependency = foundDependency != std::end(nodeDependencies) ? *foundDependency : nodeDependencies.emplace_back();
+	dependency.sourceNodeIdx = sourceNodeIdx;
+	dependency.destNodeIdx   = destNodeIdx;
+	lib::AddFlag(dependency.sourceStage, sourceStage);
+	lib::AddFlag(dependency.sourceAccess, sourceAccess);
+	lib::AddFlag(dependency.destStage, destStage);
+	lib::AddFlag(dependency.destAccess, destAccess);
+}
+
+} // priv
+
+lib::DynamicArray<Bool> ComputeAliveNodes(lib::Span<const RGCompilationNode> nodes, const lib::DynamicArray<Bool>& observableResources)
+{
+	SPT_PROFILER_FUNCTION();
+
+	lib::DynamicArray<Bool> aliveNodes(nodes.size(), false);
+
+	// Resources that are accessed by alive nodes that were already visited (we're iterating from the last node)
+	lib::DynamicArray<Bool> accessedResources(observableResources.size(), false);
+
+	for (SizeType nodeIdx = nodes.size(); nodeIdx-- > 0u;)
+	{
+		const RGCompilationNode& node = nodes[nodeIdx];
+
+		Bool isAlive   = node.hasSideEffects;
+		Bool hasWrites = false;
+
+		for (const RGCompilationResourceAccess& access : node.accesses)
+		{
+			SPT_CHECK(access.resourceIdx < observableResources.size());
+
+			if (access.isWrite)
+			{
+				hasWrites = true;
+				isAlive |= observableResources[access.resourceIdx] || accessedResources[access.resourceIdx];
+			}
+		}
+
+		// We cannot prove that node without tracked writes has no outputs
+		isAlive |= !hasWrites;
+
+		if (isAlive)
+		{
+			for (const RGCompilationResourceAccess& access : node.accesses)
+			{
+				accessedResources[access.resourceIdx] = true;
+			}
+		}
+
+		aliveNodes[nodeIdx] = isAlive;
+	}
+
+	return aliveNodes;
+}
+
+RGTransientMemoryPlacement PlaceTransientAllocations(lib::Span<const RGTransientAllocationRequest> requests)
+{
+	SPT_PROFILER_FUNCTION();
+
+	RGTransientMemoryPlacement placement;
+	placement.offsets.resize(requests.size(), 0u);
+
+	lib::DynamicArray<SizeType> placementOrder(requests.size());
+	std::iota(std::begin(placementOrder), std::end(placementOrder), SizeType(0u));
+
+	std::sort(std::begin(placementOrder), std::end(placementOrder),
+			  [requests](SizeType lhs, SizeType rhs)
+			  {
+				  if (requests[lhs].size != requests[rhs].size)
+				  {
+					  return requests[lhs].size > requests[rhs].size;
+				  }
+				  return requests[lhs].firstNodeIdx < requests[rhs].firstNodeIdx;
+			  });
+
+	lib::DynamicArray<SizeType> placedRequests;
+	placedRequests.reserve(requests.size());
+
+	lib::DynamicArray<SizeType> collidingRequests;
+
+	for (const SizeType requestIdx : placementOrder)
+	{
+		const RGTransientAllocationRequest& request = requests[requestIdx];
+		SPT_CHECK(request.firstNodeIdx <= request.lastNodeIdx);
+		SPT_CHECK(request.alignment > 0u);
+
+		collidingRequests.clear();
+		for (const SizeType placedIdx : placedRequests)
+		{
+			const RGTransientAllocationRequest& placedRequest = requests[placedIdx];
+			if (placedRequest.firstNodeIdx <= request.lastNodeIdx && request.firstNodeIdx <= placedRequest.lastNodeIdx)
+			{
+				collidingRequests.emplace_back(placedIdx);
+			}
+		}
+
+		std::sort(std::begin(collidingRequests), std::end(collidingRequests),
+				  [&placement](SizeType lhs, SizeType rhs)
+				  {
+					  return placement.offsets[lhs] < placement.offsets[rhs];
+				  });
+
+		Uint64 offset = 0u;
+		for (const SizeType collidingIdx : collidingRequests)
+		{
+			const Uint64 collidingBegin = placement.offsets[collidingIdx];
+			const Uint64 collidingEnd   = collidingBegin + requests[collidingIdx].size;
+
+			if (math::Utils::RoundUp(offset, request.alignment) + request.size <= collidingBegin)
+			{
+				break;
+			}
+
+			offset = std::max(offset, collidingEnd);
+		}
+
+		offset = math::Utils::RoundUp(offset, request.alignment);
+
+		placement.offsets[requestIdx] = offset;
+		placement.requiredMemorySize   = std::max(placement.requiredMemorySize, offset + request.size);
+		placement.nonAliasedMemorySize += request.size;
+
+		placedRequests.emplace_back(requestIdx);
+	}
+
+	return placement;
+}
+
+RGBarriersPlan PlanBarriers(lib::Span<const RGSynchronizationNode> nodes, lib::Span<const RGResourceInitialAccess> initialAccesses)
+{
+	SPT_PROFILER_FUNCTION();
+
+	RGBarriersPlan plan;
+
+	lib::DynamicArray<priv::RGResourceSynchronizationState> states(initialAccesses.size());
+	for (SizeType resourceIdx = 0u; resourceIdx < initialAccesses.size(); ++resourceIdx)
+	{
+		states[resourceIdx].writeStage  = initialAccesses[resourceIdx].stage;
+		states[resourceIdx].writeAccess = initialAccesses[resourceIdx].access;
+	}
+
+	lib::DynamicArray<RGSynchronizationAccess> nodeAccesses;
+	lib::DynamicArray<RGPlannedDependency> nodeDependencies;
+
+	for (Uint32 nodeIdx = 0u; nodeIdx < static_cast<Uint32>(nodes.size()); ++nodeIdx)
+	{
+		// Merge all accesses to the same resource in this node
+		nodeAccesses.assign(std::cbegin(nodes[nodeIdx].accesses), std::cend(nodes[nodeIdx].accesses));
+		std::sort(std::begin(nodeAccesses), std::end(nodeAccesses),
+				  [](const RGSynchronizationAccess& lhs, const RGSynchronizationAccess& rhs)
+				  {
+					  return lhs.resourceIdx < rhs.resourceIdx;
+				  });
+
+		nodeDependencies.clear();
+
+		SizeType accessIdx = 0u;
+		while (accessIdx < nodeAccesses.size())
+		{
+			const Uint32 resourceIdx = nodeAccesses[accessIdx].resourceIdx;
+			SPT_CHECK(resourceIdx < states.size());
+
+			rhi::EPipelineStage stage = rhi::EPipelineStage::None;
+			rhi::EAccessType access   = rhi::EAccessType::None;
+			for (; accessIdx < nodeAccesses.size() && nodeAccesses[accessIdx].resourceIdx == resourceIdx; ++accessIdx)
+			{
+				lib::AddFlag(stage, nodeAccesses[accessIdx].stage);
+				lib::AddFlag(access, nodeAccesses[accessIdx].access);
+			}
+
+			priv::RGResourceSynchronizationState& state = states[resourceIdx];
+
+			if (lib::HasAnyFlag(access, rhi::EAccessType::Write))
+			{
+				if (state.HasReadsSinceWrite())
+				{
+					// Write after read - last write was already synchronized with reads, so execution dependency on reads is enough
+					priv::AddDependency(nodeDependencies, state.lastReadNodeIdx, nodeIdx, state.readStages, rhi::EAccessType::None, stage, access);
+				}
+				else if (state.HasWrite())
+				{
+					priv::AddDependency(nodeDependencies, state.writeNodeIdx, nodeIdx, state.writeStage, state.writeAccess, stage, access);
+				}
+
+				state = priv::RGResourceSynchronizationState{};
+				state.writeNodeIdx = nodeIdx;
+				state.writeStage   = stage;
+				state.writeAccess  = access;
+			}
+			else
+			{
+				if (state.HasWrite() && !lib::HasAllFlags(state.readStages, stage))
+				{
+					priv::AddDependency(nodeDependencies, state.writeNodeIdx, nodeIdx, state.writeStage, state.writeAccess, stage, access);
+				}
+				else if (state.HasReadsSinceWrite() && state.lastReadStage != stage)
+				{
+					++plan.droppedReadToReadNum;
+				}
+
+				lib::AddFlag(state.readStages, stage);
+				state.lastReadStage   = stage;
+				state.lastReadNodeIdx = nodeIdx;
+			}
+		}
+
+		plan.dependencies.insert(std::end(plan.dependencies), std::cbegin(nodeDependencies), std::cend(nodeDependencies));
+	}
+
+	return plan;
+}
+
+} // spt::rg
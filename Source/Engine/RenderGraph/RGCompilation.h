@@ -0,0 +1,117 @@
+#pragma once
+
+#include "RenderGraphMacros.h"
+#include "SculptorCoreTypes.h"
+#include "RHICore/RHITextureTypes.h"
+
+
+namespace spt::rg
+{
+
+struct RGCompilationResourceAccess
+{
+	Uint32 resourceIdx = idxNone<Uint32>;
+	Bool   isWrite     = false;
+};
+
+
+struct RGCompilationNode
+{
+	lib::Span<const RGCompilationResourceAccess> accesses;
+
+	/** True if node has outputs that are not tracked by render graph (for example writes to acceleration structures) */
+	Bool hasSideEffects = false;
+};
+
+
+/**
+ * Computes which nodes must be executed.
+ * Node is alive if it has side effects, doesn't write any tracked resource, writes observable (external or extracted) resource
+ * or writes resource that is accessed by any later alive node.
+ */
+RENDER_GRAPH_API lib::DynamicArray<Bool> ComputeAliveNodes(lib::Span<const RGCompilationNode> nodes, const lib::DynamicArray<Bool>& observableResources);
+
+
+struct RGTransientAllocationRequest
+{
+	Uint32 firstNodeIdx = 0u;
+	Uint32 lastNodeIdx  = 0u;
+
+	Uint64 size      = 0u;
+	Uint64 alignment = 1u;
+};
+
+
+struct RGTransientMemoryPlacement
+{
+	/** Offset for each request, in requests order */
+	lib::DynamicArray<Uint64> offsets;
+
+	/** Memory required to place all requests */
+	Uint64 requiredMemorySize = 0u;
+
+	/** Memory that would be required without aliasing */
+	Uint64 nonAliasedMemorySize = 0u;
+};
+
+
+/**
+ * Places allocations with known lifetimes in single memory block. Allocations with overlapping lifetimes never overlap in memory.
+ * Allocations are placed from the largest one, each at the lowest offset that doesn't collide with already placed allocations
+ */
+RENDER_GRAPH_API RGTransientMemoryPlacement PlaceTransientAllocations(lib::Span<const RGTransientAllocationRequest> requests);
+
+
+struct RGSynchronizationAccess
+{
+	Uint32              resourceIdx = idxNone<Uint32>;
+	rhi::EPipelineStage stage       = rhi::EPipelineStage::None;
+	rhi::EAccessType    access      = rhi::EAccessType::None;
+};
+
+
+struct RGSynchronizationNode
+{
+	lib::Span<const RGSynchronizationAccess> accesses;
+};
+
+
+/** Access to resource that was done before the graph. Resources without initial write don't require synchronization on first access */
+struct RGResourceInitialAccess
+{
+	rhi::EPipelineStage stage  = rhi::EPipelineStage::None;
+	rhi::EAccessType    access = rhi::EAccessType::None;
+};
+
+
+struct RGPlannedDependency
+{
+	/** idxNone if source access was done before the graph */
+	Uint32 sourceNodeIdx = idxNone<Uint32>;
+	Uint32 destNodeIdx   = idxNone<Uint32>;
+
+	rhi::EPipelineStage sourceStage  = rhi::EPipelineStage::None;
+	rhi::EAccessType    sourceAccess = rhi::EAccessType::None;
+	rhi::EPipelineStage destStage    = rhi::EPipelineStage::None;
+	rhi::EAccessType    destAccess   = rhi::EAccessType::None;
+};
+
+
+struct RGBarriersPlan
+{
+	/** Dependencies ordered by destination node. There is at most one dependency for each pair of source and destination nodes */
+	lib::DynamicArray<RGPlannedDependency> dependencies;
+
+	/** Reads that followed reads in different stages and didn't require synchronization */
+	Uint32 droppedReadToReadNum = 0u;
+};
+
+
+/**
+ * Computes synchronization for whole graph.
+ * Reads are synchronized directly with last write (or with all reads since last write in case of writes), so read -> read transitions are never needed.
+ * All accesses of single node are merged, so each node requires at most one dependency for each source node
+ */
+RENDER_GRAPH_API RGBarriersPlan PlanBarriers(lib::Span<const RGSynchronizationNode> nodes, lib::Span<const RGResourceInitialAccess> initialAccesses);
+
+} // spt::rg
@@ -32,6 +32,16 @@ RGDiagnosticsPlayback::RGDiagnosticsPlayback()
 {
 }
 
+void RGDiagnosticsPlayback::ResumeScopes(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, const RGDiagnosticsRecord& record)
+{
+	SPT_CHECK(m_recordState.empty());
+
+	for (const lib::HashedString& scopeName : record)
+	{
+		PlaybackPush(recorder, statisticsCollector, scopeName, true);
+	}
+}
+
 void RGDiagnosticsPlayback::Playback(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, const RGDiagnosticsRecord& record)
 {
 	const auto areScopesMatching = [this, &record](SizeType idx)
@@ -72,7 +82,7 @@ void RGDiagnosticsPlayback::PopRemainingScopes(rdr::CommandRecorder& recorder, c
 	}
 }
 
-void RGDiagnosticsPlayback::PlaybackPush(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, lib::HashedString scopeName)
+void RGDiagnosticsPlayback::PlaybackPush(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, lib::HashedString scopeName, Bool isContinuation /*= false*/)
 {
 #if RENDERER_VALIDATION
 	recorder.BeginDebugRegion(scopeName, lib::Color(static_cast<Uint32>(scopeName.GetKey())));
@@ -80,7 +90,14 @@ void RGDiagnosticsPlayback::PlaybackPush(rdr::CommandRecorder& recorder, const l
 
 	if (statisticsCollector)
 	{
-		statisticsCollector->BeginScope(recorder, scopeName, rdr::EQueryFlags::Default);
+		if (isContinuation)
+		{
+			statisticsCollector->BeginContinuationScope(recorder, scopeName);
+		}
+		else
+		{
+			statisticsCollector->BeginScope(recorder, scopeName, rdr::EQueryFlags::Default);
+		}
 	}
 
 	m_recordState.emplace_back(scopeName);
@@ -14,6 +14,43 @@ class GPUStatisticsCollector;
 } // spt::rdr
 
 
+namespace spt::rg
+{
+
+/** Results of render graph compilation. Allocation statistics are valid after graph execution */
+struct RGCompilationStatistics
+{
+	Uint32 nodesNum = 0u;
+
+	lib::DynamicArray<lib::HashedString> culledNodes;
+
+	Uint32 transientTexturesNum = 0u;
+
+	/** Size of memory required by transient textures after aliasing */
+	Uint64 transientMemorySize           = 0u;
+	Uint64 nonAliasedTransientMemorySize = 0u;
+
+	/** Textures that couldn't be placed in transient memory and used committed allocations */
+	Uint32 fallbackAllocationsNum = 0u;
+
+	/** Transient textures that were reused from previous graphs instead of being created */
+	Uint32 reusedTexturesNum = 0u;
+
+	/** Barriers resolved incrementally, while nodes were added. Batches are nodes with at least one barrier */
+	Uint32 incrementalTransitionsNum    = 0u;
+	Uint32 incrementalBarrierBatchesNum = 0u;
+
+	/** Barriers after planning for whole graph. Equal to incremental barriers if planning is disabled */
+	Uint32 plannedTransitionsNum    = 0u;
+	Uint32 plannedBarrierBatchesNum = 0u;
+	Uint32 splitBarriersNum         = 0u;
+
+	Uint32 droppedReadToReadTransitionsNum = 0u;
+};
+
+} // spt::rg
+
+
 #if RG_ENABLE_DIAGNOSTICS
 
 namespace spt::rg
@@ -47,13 +84,16 @@ class RGDiagnosticsPlayback
 public:
 
 	RGDiagnosticsPlayback();
+
+	/** Reopens scopes that were left open by playback of previous recording range. Statistics of these scopes are merged with original scopes */
+	void ResumeScopes(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, const RGDiagnosticsRecord& record);
 	
 	void Playback(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, const RGDiagnosticsRecord& record);
 	void PopRemainingScopes(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector);
 
 private:
 
-	void PlaybackPush(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, lib::HashedString scopeName);
+	void PlaybackPush(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector, lib::HashedString scopeName, Bool isContinuation = false);
 	void PlaybackPop(rdr::CommandRecorder& recorder, const lib::SharedPtr<rdr::GPUStatisticsCollector>& statisticsCollector);
 
 	RGDiagnosticsRecord m_recordState;
@@ -7,6 +7,7 @@
 #include "RGResources.h"
 #include "GPUDiagnose/Profiler/GPUStatisticsCollector.h"
 #include "RenderGraphBuilder.h"
+#include "Types/GPUEvent.h"
 
 
 namespace spt::rg
@@ -43,7 +44,15 @@ RGNode::RGNode(RenderGraphBuilder& owningGraphBuilder, const RenderGraphDebugNam
 	, m_buffersToAcquire(owningGraphBuilder.GetMemoryArena())
 	, m_buffersToRelease(owningGraphBuilder.GetMemoryArena())
 	, m_textureViewsToAcquire(owningGraphBuilder.GetMemoryArena())
+	, m_textureAccesses(owningGraphBuilder.GetMemoryArena())
+	, m_bufferAccesses(owningGraphBuilder.GetMemoryArena())
+	, m_preExecutionBarriersNum(0u)
+	, m_splitBarriersToWait(owningGraphBuilder.GetMemoryArena())
+	, m_splitBarriersToSignal(owningGraphBuilder.GetMemoryArena())
 	, m_dsStates(owningGraphBuilder.GetMemoryArena())
+	, m_hasSideEffects(false)
+	, m_isCulled(false)
+	, m_preparedForExecution(false)
 	, m_executed(false)
 { }
 
@@ -96,6 +105,22 @@ const RGDiagnosticsRecord& RGNode::GetDiagnosticsRecord() const
 }
 #endif // RG_ENABLE_DIAGNOSTICS
 
+void RGNode::AddTextureAccess(RGTextureView& textureView, Bool isWrite, rhi::EPipelineStage stage, rhi::EAccessType access)
+{
+	m_textureAccesses.EmplaceBack(RGNodeTextureAccess{ textureView.GetTexture().Get(), &textureView, isWrite, stage, access });
+}
+
+void RGNode::AddTextureAccess(RGTexture& texture, rhi::EPipelineStage stage, rhi::EAccessType access)
+{
+	// Transitions don't produce any data, so they are never considered as writes when culling nodes
+	m_textureAccesses.EmplaceBack(RGNodeTextureAccess{ &texture, nullptr, false, stage, access });
+}
+
+void RGNode::AddBufferAccess(RGBuffer& buffer, Bool isWrite, rhi::EPipelineStage stage, rhi::EAccessType access)
+{
+	m_bufferAccesses.EmplaceBack(RGNodeBufferAccess{ &buffer, isWrite, stage, access });
+}
+
 void RGNode::AddTextureToAcquire(RGTexture& texture)
 {
 	SPT_CHECK(!texture.GetAcquireNode().IsValid());
@@ -139,6 +164,23 @@ void RGNode::AddBufferToRelease(RGBuffer& buffer)
 void RGNode::AddPreExecutionBarrier(rhi::EPipelineStage sourceStage, rhi::EAccessType sourceAccess, rhi::EPipelineStage destStage, rhi::EAccessType destAccess)
 {
 	m_preExecuteDependency.StageBarrier(sourceStage, sourceAccess, destStage, destAccess);
+	++m_preExecutionBarriersNum;
+}
+
+void RGNode::ClearPreExecutionBarriers()
+{
+	m_preExecuteDependency   = rhi::RHIDependency();
+	m_preExecutionBarriersNum = 0u;
+}
+
+void RGNode::AddSplitBarrierToSignal(RGSplitBarrier& splitBarrier)
+{
+	m_splitBarriersToSignal.EmplaceBack(&splitBarrier);
+}
+
+void RGNode::AddSplitBarrierToWait(RGSplitBarrier& splitBarrier)
+{
+	m_splitBarriersToWait.EmplaceBack(&splitBarrier);
 }
 
 void RGNode::AddDescriptorSetState(lib::MTHandle<rdr::DescriptorSetState> dsState)
@@ -151,8 +193,43 @@ void RGNode::SetShaderParamsDescriptors(const rhi::RHIDescriptorRange& range)
 	m_shaderParamsDescriptorHeapOffset = range.heapOffset;
 }
 
+void RGNode::PrepareForExecution()
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(!m_preparedForExecution);
+
+	m_preparedForExecution = true;
+
+	if (IsCulled())
+	{
+		return;
+	}
+
+	AcquireResources();
+
+	FlushDescriptorSetStates();
+	OnPrepareForExecution();
+
+	// Memory of textures released by this node may be aliased by textures acquired by next nodes.
+	// This is safe because all command buffers of the graph are submitted in order to the same queue
+	ReturnReleasedMemory();
+}
+
 void RGNode::Execute(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder, const RGExecutionContext& context)
 {
+	SPT_CHECK(m_preparedForExecution);
+	SPT_CHECK(!m_executed);
+
+	if (IsCulled())
+	{
+		// Barriers of culled node are still required, because synchronization of following nodes was resolved with this node in mind
+		PreExecuteBarrier(recorder);
+		SignalSplitBarriers(recorder);
+		m_executed = true;
+		return;
+	}
+
 	SPT_PROFILER_SCOPE(GetName().GetData());
 	SPT_GPU_DEBUG_REGION(recorder, GetName().GetData(), lib::Color(static_cast<Uint32>(GetName().GetKey())));
 	SPT_GPU_STATISTICS_SCOPE_FLAGS(recorder, context.statisticsCollector, GetName().GetData(), helpers::GetQueryFlags(GetType()));
@@ -161,10 +238,6 @@ void RGNode::Execute(const lib::SharedRef<rdr::RenderContext>& renderContext, rd
 	recorder.SetDebugCheckpoint(GetName());
 #endif // SPT_ENABLE_GPU_CRASH_DUMPS
 
-	SPT_CHECK(!m_executed);
-
-	AcquireResources();
-
 	PreExecuteBarrier(recorder);
 
 	BindDescriptorSetStates(recorder);
@@ -172,6 +245,8 @@ void RGNode::Execute(const lib::SharedRef<rdr::RenderContext>& renderContext, rd
 	OnExecute(renderContext, recorder, context);
 	UnbindDescriptorSetStates(recorder);
 
+	SignalSplitBarriers(recorder);
+
 	ReleaseResources();
 
 	m_executed = true;
@@ -184,6 +259,25 @@ void RGNode::AcquireResources()
 	AcquireBuffers();
 }
 
+void RGNode::FlushDescriptorSetStates()
+{
+	for (const lib::MTHandle<rdr::DescriptorSetState>& dsState : m_dsStates)
+	{
+		dsState->Flush();
+	}
+}
+
+void RGNode::ReturnReleasedMemory()
+{
+	const RenderGraphBuilder& graphBuilder = GetOwningGraphBuilder();
+	RenderGraphResourcesPool& resourcesPool = graphBuilder.GetResourcesPool();
+
+	for (RGTextureHandle textureToRelease : m_texturesToRelease)
+	{
+		resourcesPool.ReleaseTexture(textureToRelease->GetResource());
+	}
+}
+
 void RGNode::PreExecuteBarrier(rdr::CommandRecorder& recorder)
 {
 	for (RGTextureHandle textureToAcquire : m_texturesToAcquire)
@@ -193,7 +287,26 @@ void RGNode::PreExecuteBarrier(rdr::CommandRecorder& recorder)
 		m_preExecuteDependency.SetLayoutTransition(depIdx, rhi::TextureTransition::Undefined, rhi::TextureTransition::Generic);
 	}
 
-	recorder.ExecuteBarrier(m_preExecuteDependency);
+	for (RGSplitBarrier* splitBarrier : m_splitBarriersToWait)
+	{
+		recorder.WaitEvent(splitBarrier->event, splitBarrier->dependency);
+
+		// Events are pooled and reused in next frames, so they must be unsignaled after use
+		recorder.ResetEvent(splitBarrier->event, splitBarrier->dependency);
+	}
+
+	if (m_preExecutionBarriersNum > 0u || !m_texturesToAcquire.IsEmpty())
+	{
+		recorder.ExecuteBarrier(m_preExecuteDependency);
+	}
+}
+
+void RGNode::SignalSplitBarriers(rdr::CommandRecorder& recorder)
+{
+	for (RGSplitBarrier* splitBarrier : m_splitBarriersToSignal)
+	{
+		recorder.SetEvent(splitBarrier->event, splitBarrier->dependency);
+	}
 }
 
 void RGNode::ReleaseResources()
@@ -227,10 +340,10 @@ void RGNode::AcquireTextures()
 
 	for (RGTextureHandle textureToAcquire : m_texturesToAcquire)
 	{
-		rhi::TextureDefinition textureRHIDef = textureToAcquire->GetTextureRHIDefinition();
-		lib::AddFlag(textureRHIDef.flags, rhi::ETextureFlags::SkipAutoGPUInit);
-
-		lib::SharedPtr<rdr::Texture> acquiredTexture = resourcesPool.AcquireTexture(RG_DEBUG_NAME(textureToAcquire->GetName()), textureRHIDef, textureToAcquire->GetAllocationInfo());
+		lib::SharedPtr<rdr::Texture> acquiredTexture = resourcesPool.AcquireTexture(RG_DEBUG_NAME(textureToAcquire->GetName()),
+																					textureToAcquire->GetTextureRHIDefinition(),
+																					textureToAcquire->GetAllocationInfo(),
+																					textureToAcquire->GetTransientMemoryOffset());
 		SPT_CHECK(!!acquiredTexture);
 
 		textureToAcquire->AcquireResource(std::move(acquiredTexture));
@@ -239,12 +352,10 @@ void RGNode::AcquireTextures()
 
 void RGNode::ReleaseTextures()
 {
-	const RenderGraphBuilder& graphBuilder = GetOwningGraphBuilder();
-	RenderGraphResourcesPool& resourcesPool = graphBuilder.GetResourcesPool();
-
+	// Memory was already returned to the pool in PrepareForExecution
 	for (RGTextureHandle textureToRelease : m_texturesToRelease)
 	{
-		resourcesPool.ReleaseTexture(textureToRelease->ReleaseResource());
+		textureToRelease->ReleaseResource();
 	}
 }
 
@@ -296,6 +407,14 @@ void RGSubpass::AddDescriptorSetState(lib::MTHandle<rdr::DescriptorSetState> dsS
 	m_dsStatesToBind.EmplaceBack(std::move(dsState));
 }
 
+void RGSubpass::PrepareForExecution()
+{
+	for (const lib::MTHandle<rdr::DescriptorSetState>& ds : m_dsStatesToBind)
+	{
+		ds->Flush();
+	}
+}
+
 void RGSubpass::Execute(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder, const RGExecutionContext& context)
 {
 	SPT_PROFILER_FUNCTION();
@@ -335,6 +454,14 @@ void RGRenderPassNodeBase::AppendSubpass(RGSubpassHandle subpass)
 	m_subpasses.EmplaceBack(subpass);
 }
 
+void RGRenderPassNodeBase::OnPrepareForExecution()
+{
+	for (RGSubpassHandle subpass : m_subpasses)
+	{
+		subpass->PrepareForExecution();
+	}
+}
+
 void RGRenderPassNodeBase::OnExecute(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder, const RGExecutionContext& context)
 {
 	const rdr::RenderingDefinition renderingDefinition = m_renderPassDef.CreateRenderingDefinition();
@@ -21,6 +21,7 @@ struct BarrierTextureTransitionDefinition;
 
 namespace spt::rdr
 {
+class GPUEvent;
 class RenderContext;
 class CommandRecorder;
 class GPUStatisticsCollector;
@@ -37,6 +38,9 @@ class RenderGraphBuilder;
 struct RGExecutionContext
 {
 	lib::SharedPtr<rdr::GPUStatisticsCollector> statisticsCollector;
+
+	/** Arena owned by recording job that executes node. The same arena is used by render context passed to node */
+	lib::MemoryArena* memoryArena = nullptr;
 };
 
 
@@ -50,6 +54,36 @@ struct RGNodeComputeDebugMetaData
 using RGNodeDebugMetaData = std::variant<RGNodeNullDebugMetaData, RGNodeComputeDebugMetaData>;
 
 
+struct RGNodeTextureAccess
+{
+	RGTexture*     texture     = nullptr;
+	/** Null for accesses that don't require texture to be alive (f.e. transitions of extracted textures) */
+	RGTextureView* textureView = nullptr;
+	Bool           isWrite     = false;
+
+	rhi::EPipelineStage stage  = rhi::EPipelineStage::None;
+	rhi::EAccessType    access = rhi::EAccessType::None;
+};
+
+
+struct RGNodeBufferAccess
+{
+	RGBuffer* buffer  = nullptr;
+	Bool      isWrite = false;
+
+	rhi::EPipelineStage stage  = rhi::EPipelineStage::None;
+	rhi::EAccessType    access = rhi::EAccessType::None;
+};
+
+
+/** Barrier that is signaled after execution of source node and waited before execution of destination node */
+struct RGSplitBarrier
+{
+	lib::SharedRef<rdr::GPUEvent> event;
+	rhi::RHIDependency            dependency;
+};
+
+
 class RENDER_GRAPH_API RGNode
 {
 public:
@@ -72,6 +106,26 @@ public:
 	const RGDiagnosticsRecord& GetDiagnosticsRecord() const;
 #endif // RG_ENABLE_DIAGNOSTICS
 
+	// Compilation ======================================================
+
+	void AddTextureAccess(RGTextureView& textureView, Bool isWrite, rhi::EPipelineStage stage, rhi::EAccessType access);
+	/** Access that only transitions texture. It's used for synchronization, but doesn't affect texture lifetime */
+	void AddTextureAccess(RGTexture& texture, rhi::EPipelineStage stage, rhi::EAccessType access);
+	void AddBufferAccess(RGBuffer& buffer, Bool isWrite, rhi::EPipelineStage stage, rhi::EAccessType access);
+
+	const lib::DynamicPushArray<RGNodeTextureAccess>& GetTextureAccesses() const { return m_textureAccesses; }
+	const lib::DynamicPushArray<RGNodeBufferAccess>&  GetBufferAccesses() const { return m_bufferAccesses; }
+
+	/** Nodes with side effects that are not tracked by render graph are never culled */
+	void MarkHasSideEffects() { m_hasSideEffects = true; }
+	Bool HasSideEffects() const { return m_hasSideEffects; }
+
+	/** Culled nodes execute only their barriers, because following nodes synchronization may depend on them */
+	void MarkCulled() { m_isCulled = true; }
+	Bool IsCulled() const { return m_isCulled; }
+
+	// Resources ========================================================
+
 	void AddTextureToAcquire(RGTexture& texture);
 	void AddTextureToRelease(RGTexture& texture);
 
@@ -83,14 +137,31 @@ public:
 
 	void AddPreExecutionBarrier(rhi::EPipelineStage sourceStage, rhi::EAccessType sourceAccess, rhi::EPipelineStage destStage, rhi::EAccessType destAccess);
 
+	/** Removes barriers added during graph building. Used when barriers are planned for whole graph */
+	void ClearPreExecutionBarriers();
+
+	/** Number of barriers merged into pre-execution barrier of this node */
+	Uint32 GetPreExecutionBarriersNum() const { return m_preExecutionBarriersNum; }
+
+	void AddSplitBarrierToSignal(RGSplitBarrier& splitBarrier);
+	void AddSplitBarrierToWait(RGSplitBarrier& splitBarrier);
+
 	void AddDescriptorSetState(lib::MTHandle<rdr::DescriptorSetState> dsState);
 
 	void SetShaderParamsDescriptors(const rhi::RHIDescriptorRange& range);
 
+	/**
+	 * Acquires resources and flushes descriptor sets of this node. Must be called serially, in nodes order, before Execute.
+	 * After all nodes are prepared, Execute may be called for different nodes from different threads
+	 */
+	void PrepareForExecution();
+
 	void Execute(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder, const RGExecutionContext& context);
 
 protected:
 
+	virtual void OnPrepareForExecution() {}
+
 	virtual void OnExecute(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder, const RGExecutionContext& context) = 0;
 
 private:
@@ -98,7 +169,10 @@ private:
 	// Node Execution ===================================================
 
 	void AcquireResources();
+	void FlushDescriptorSetStates();
+	void ReturnReleasedMemory();
 	void PreExecuteBarrier(rdr::CommandRecorder& recorder);
+	void SignalSplitBarriers(rdr::CommandRecorder& recorder);
 	void ReleaseResources();
 
 	void BindDescriptorSetStates(rdr::CommandRecorder& recorder);
@@ -131,7 +205,14 @@ private:
 	
 	lib::DynamicPushArray<RGTextureView*> m_textureViewsToAcquire;
 
+	lib::DynamicPushArray<RGNodeTextureAccess> m_textureAccesses;
+	lib::DynamicPushArray<RGNodeBufferAccess>  m_bufferAccesses;
+
 	rhi::RHIDependency m_preExecuteDependency;
+	Uint32             m_preExecutionBarriersNum;
+
+	lib::DynamicPushArray<RGSplitBarrier*> m_splitBarriersToWait;
+	lib::DynamicPushArray<RGSplitBarrier*> m_splitBarriersToSignal;
 
 	lib::DynamicPushArray<lib::MTHandle<rdr::DescriptorSetState>> m_dsStates;
 
@@ -145,6 +226,10 @@ private:
 	RGDiagnosticsRecord m_diagnosticsRecord;
 #endif // RG_ENABLE_DIAGNOSTICS
 
+	Bool m_hasSideEffects;
+	Bool m_isCulled;
+
+	Bool m_preparedForExecution;
 	Bool m_executed;
 };
 
@@ -189,6 +274,8 @@ public:
 
 	void AddDescriptorSetState(lib::MTHandle<rdr::DescriptorSetState> dsState);
 
+	void PrepareForExecution();
+
 	void Execute(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder, const RGExecutionContext& context);
 
 protected:
@@ -245,6 +332,8 @@ public:
 
 protected:
 
+	virtual void OnPrepareForExecution() final;
+
 	virtual void OnExecute(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder, const RGExecutionContext& context) final;
 
 	virtual void ExecuteRenderPass(const lib::SharedRef<rdr::RenderContext>& renderContext, rdr::CommandRecorder& recorder) = 0;
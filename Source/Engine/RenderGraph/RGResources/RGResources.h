@@ -148,6 +148,7 @@ public:
 		, m_accessState(textureDefinition.mipLevels, textureDefinition.arrayLayers)
 		, m_extractionDest(nullptr)
 		, m_releaseTransitionTarget(nullptr)
+		, m_transientMemoryOffset(idxNone<Uint64>)
 	{ }
 
 	RGTexture(const RGResourceDef& resourceDefinition, lib::SharedPtr<rdr::Texture> texture)
@@ -159,6 +160,7 @@ public:
 		, m_accessState(texture->GetRHI().GetDefinition().mipLevels, texture->GetRHI().GetDefinition().arrayLayers)
 		, m_extractionDest(nullptr)
 		, m_releaseTransitionTarget(nullptr)
+		, m_transientMemoryOffset(idxNone<Uint64>)
 	{
 		SPT_CHECK(IsExternal());
 	}
@@ -317,6 +319,25 @@ public:
 		return m_releaseTransitionTarget;
 	}
 
+	// Transient Memory ====================================================
+
+	/** Offset in render graph transient memory pool, resolved during graph compilation. idxNone if texture is not placed in transient memory */
+	void SetTransientMemoryOffset(Uint64 offset)
+	{
+		SPT_CHECK(!IsExternal());
+		m_transientMemoryOffset = offset;
+	}
+
+	Uint64 GetTransientMemoryOffset() const
+	{
+		return m_transientMemoryOffset;
+	}
+
+	Bool IsPlacedInTransientMemory() const
+	{
+		return m_transientMemoryOffset != idxNone<Uint64>;
+	}
+
 	// Properties ==========================================================
 
 	void AddUsageForAccess(ERGTextureAccess access)
@@ -367,6 +388,8 @@ private:
 
 	lib::SharedPtr<rdr::Texture>*					m_extractionDest;
 	const rhi::BarrierTextureTransitionDefinition*	m_releaseTransitionTarget;
+
+	Uint64 m_transientMemoryOffset;
 };
 
 
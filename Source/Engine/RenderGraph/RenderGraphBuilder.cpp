@@ -10,6 +10,11 @@
 #include "RenderGraphResourcesPool.h"
 #include "Types/Pipeline/Pipeline.h"
 #include "GPUDiagnose/Debug/GPUDebug.h"
+#include "GPUDiagnose/Profiler/GPUStatisticsCollector.h"
+#include "RendererSettings.h"
+#include "Scheduler.h"
+#include "RGCompilation.h"
+#include "Types/GPUEvent.h"
 
 SPT_DEFINE_LOG_CATEGORY(RenderGraph, true);
 SPT_DEFINE_LOG_CATEGORY(RenderGraph_Synchronization, false);
@@ -21,12 +26,120 @@ SPT_DEFINE_LOG_CATEGORY(RenderGraph_Synchronization, false);
 namespace spt::rg
 {
 
+namespace priv
+{
+
+static Bool IsWriteAccess(ERGTextureAccess access)
+{
+	return access != ERGTextureAccess::ShaderRead;
+}
+
+
+static Bool IsWriteAccess(ERGBufferAccess access)
+{
+	return access != ERGBufferAccess::Read;
+}
+
+
+struct RGRecordingRange
+{
+	lib::Span<const RGNodeHandle> nodes;
+
+	lib::MemoryArena* memoryArena = nullptr;
+
+	lib::SharedPtr<rdr::GPUStatisticsCollector> statisticsCollector;
+
+	lib::SharedPtr<rdr::GPUWorkload> workload;
+
+#if RG_ENABLE_DIAGNOSTICS
+	/** Diagnostics scopes that were opened in previous range and must be continued in this range */
+	const RGDiagnosticsRecord* resumedScopes = nullptr;
+#endif // RG_ENABLE_DIAGNOSTICS
+
+#if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+	lib::DynamicArray<Uint32> checkpoints;
+#endif // SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+};
+
+
+#if RG_ENABLE_DIAGNOSTICS
+static SizeType ComputeCommonScopesNum(const RGDiagnosticsRecord& lhs, const RGDiagnosticsRecord& rhs)
+{
+	SizeType commonScopesNum = 0u;
+	while (commonScopesNum < lhs.size() && commonScopesNum < rhs.size() && lhs[commonScopesNum] == rhs[commonScopesNum])
+	{
+		++commonScopesNum;
+	}
+	return commonScopesNum;
+}
+#endif // RG_ENABLE_DIAGNOSTICS
+
+
+/**
+ * Splits nodes into contiguous ranges that can be recorded to separate command buffers.
+ * Node barriers are recorded as part of node, so splitting is valid between any two nodes,
+ * but we prefer to split where diagnostics scopes end, so that less scopes have to be continued in the next command buffer
+ */
+static lib::DynamicArray<RGRecordingRange> BuildRecordingRanges(lib::Span<const RGNodeHandle> nodes)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(!nodes.empty());
+
+	const rdr::RendererSettings& settings = rdr::RendererSettings::Get();
+
+	const SizeType minNodesPerRange = std::max<SizeType>(settings.minNodesPerRecordingRange, 1u);
+	const SizeType maxRangesNum     = settings.parallelRenderGraphRecording ? js::Scheduler::GetWorkerThreadsNum() + 1u : 1u;
+	const SizeType rangesNum        = std::clamp<SizeType>(nodes.size() / minNodesPerRange, 1u, maxRangesNum);
+
+	const SizeType idealRangeSize = (nodes.size() + rangesNum - 1u) / rangesNum;
+
+	lib::DynamicArray<RGRecordingRange> ranges;
+	ranges.reserve(rangesNum);
+
+	SizeType rangeBegin = 0u;
+
+	for (SizeType nodeIdx = 1u; nodeIdx < nodes.size() && ranges.size() + 1u < rangesNum; ++nodeIdx)
+	{
+		const SizeType currentRangeSize = nodeIdx - rangeBegin;
+
+		if (currentRangeSize < idealRangeSize)
+		{
+			continue;
+		}
+
+#if RG_ENABLE_DIAGNOSTICS
+		const RGDiagnosticsRecord& prevRecord = nodes[nodeIdx - 1u]->GetDiagnosticsRecord();
+		const Bool isScopeBoundary = ComputeCommonScopesNum(prevRecord, nodes[nodeIdx]->GetDiagnosticsRecord()) < prevRecord.size();
+		const Bool isGoodSplitPoint = isScopeBoundary || currentRangeSize >= idealRangeSize + idealRangeSize / 4u;
+#else
+		const Bool isGoodSplitPoint = true;
+#endif // RG_ENABLE_DIAGNOSTICS
+
+		if (isGoodSplitPoint)
+		{
+			RGRecordingRange& range = ranges.emplace_back();
+			range.nodes = nodes.subspan(rangeBegin, currentRangeSize);
+			rangeBegin = nodeIdx;
+		}
+	}
+
+	RGRecordingRange& lastRange = ranges.emplace_back();
+	lastRange.nodes = nodes.subspan(rangeBegin);
+
+	return ranges;
+}
+
+} // priv
+
+
 RenderGraphBuilder::RenderGraphBuilder(lib::MemoryArena& memoryArena, RenderGraphResourcesPool& resourcesPool)
 	: m_textures(memoryArena)
 	, m_textureViews(memoryArena)
 	, m_buffers(memoryArena)
 	, m_bufferViews(memoryArena)
 	, m_nodes(memoryArena)
+	, m_splitBarriers(memoryArena)
 	, m_onGraphExecutionFinished(js::CreateEvent("Render Graph Execution Finished Event"))
 	, m_preGPUWorkSubmittedEvent(js::CreateEvent("Render Graph Pre GPU Work Submitted Event"))
 	, m_resourcesPool(resourcesPool)
@@ -51,6 +164,11 @@ RenderGraphBuilder::~RenderGraphBuilder()
 		SPT_CHECK_MSG(ds->GetRefCount() == 1, "Descriptor set {0} is still in use!", ds->GetName().GetData());
 	}
 #endif // SPT_RG_DEBUG_DESCRIPTOR_SETS_LIFETIME
+
+	for (lib::MemoryArena* recordingArena : m_recordingArenas)
+	{
+		m_resourcesPool.ReleaseRecordingArena(*recordingArena);
+	}
 }
 
 void RenderGraphBuilder::BindGPUStatisticsCollector(const lib::SharedRef<rdr::GPUStatisticsCollector>& collector)
@@ -333,6 +451,9 @@ void RenderGraphBuilder::BuildBLASes(const RenderGraphDebugName& commandName, li
 		dependenciesBuilder.AddBufferAccess(command.scratchBufferView, ERGBufferAccess::ReadWrite, rhi::EPipelineStage::ASBuild);
 	}
 
+	// Acceleration structures are not tracked by render graph
+	node.MarkHasSideEffects();
+
 	AddNodeInternal(node, dependencies);
 }
 
@@ -375,6 +496,9 @@ void RenderGraphBuilder::BuildTLAS(const RenderGraphDebugName& commandName, cons
 	dependenciesBuilder.AddBufferAccess(buildCommand.instanceDefsBufferView, ERGBufferAccess::Read, rhi::EPipelineStage::ASBuild);
 	dependenciesBuilder.AddBufferAccess(buildCommand.scratchBufferView, ERGBufferAccess::ReadWrite, rhi::EPipelineStage::ASBuild);
 
+	// Acceleration structures are not tracked by render graph
+	node.MarkHasSideEffects();
+
 	AddNodeInternal(node, dependencies);
 }
 
@@ -943,18 +1067,11 @@ void RenderGraphBuilder::ResolveNodeTextureAccesses(RGNode& node, const RGDepend
 
 		accessedTexture->AddUsageForAccess(textureAccessDef.access);
 
-		if (!accessedTexture->IsExternal() && !accessedTexture->HasAcquireNode())
-		{
-			node.AddTextureToAcquire(*accessedTexture);
-		}
-		
-		if (!accessedTextureView->IsExternal() && !accessedTextureView->HasAcquireNode())
-		{
-			node.AddTextureViewToAcquire(*accessedTextureView);
-		}
-
 		const rhi::BarrierTextureTransitionDefinition& transitionTarget = GetTransitionDefForAccess(&node, accessedTexture, textureAccessDef.access);
 
+		// Resources are acquired after culling, when we know which nodes will be executed
+		node.AddTextureAccess(*accessedTextureView, priv::IsWriteAccess(textureAccessDef.access), transitionTarget.stage, transitionTarget.accessType);
+
 		AppendTextureTransitionToNode(node, accessedTexture, accessedSubresourceRange, transitionTarget);
 
 		RGTextureAccessState& textureAccessState = accessedTexture->GetAccessState();
@@ -972,6 +1089,10 @@ void RenderGraphBuilder::ResolveNodeTextureAccesses(RGNode& node, const RGDepend
 		const RGTextureHandle textureToRevert = textureViewToRevert->GetTexture();
 		const rhi::TextureSubresourceRange& subresourceRangeToRevert = textureViewToRevert->GetSubresourceRange();
 		RevertGloballyReadableState(node, textureToRevert, subresourceRangeToRevert);
+
+		// Globally readable textures may be read by following nodes without tracked access, so this transition cannot be culled
+		node.AddTextureAccess(*textureToRevert, rhi::TextureTransition::ShaderRead.stage, rhi::TextureTransition::ShaderRead.accessType);
+		node.MarkHasSideEffects();
 	}
 }
 
@@ -1077,21 +1198,19 @@ void RenderGraphBuilder::ResolveNodeBufferAccesses(RGNode& node, const RGDepende
 		const RGBufferHandle accessedBuffer = accessedBufferView->GetBuffer();
 		SPT_CHECK(accessedBuffer.IsValid());
 
-		if (!accessedBuffer->IsExternal() && !accessedBuffer->GetAcquireNode().IsValid())
-		{
-			node.AddBufferToAcquire(*accessedBuffer);
-		}
-			
 		const ERGBufferAccess nextAccess			= bufferAccess.access;
 		const rhi::EPipelineStage nextAccessStages	= bufferAccess.pipelineStages;
 
+		rhi::EAccessType nextAccessType = rhi::EAccessType::None;
+		GetSynchronizationParamsForBuffer(nextAccess, OUT nextAccessType);
+
+		node.AddBufferAccess(*accessedBuffer, priv::IsWriteAccess(bufferAccess.access), nextAccessStages, nextAccessType);
+
 		// Buffers may be used in multiple ways in the same node, for example as a indirect buffer and storage buffer
 		// Because of that, we need to merge transitions of same buffer views
 		if (accessedBuffer->GetLastAccessNode() == &node)
 		{
-			rhi::EAccessType destAccessType = rhi::EAccessType::None;
-			GetSynchronizationParamsForBuffer(nextAccess, destAccessType);
-			node.AddPreExecutionBarrier(rhi::EPipelineStage::None, rhi::EAccessType::None, nextAccessStages, destAccessType);
+			node.AddPreExecutionBarrier(rhi::EPipelineStage::None, rhi::EAccessType::None, nextAccessStages, nextAccessType);
 			continue;
 		}
 
@@ -1102,11 +1221,8 @@ void RenderGraphBuilder::ResolveNodeBufferAccesses(RGNode& node, const RGDepende
 		{
 			rhi::EAccessType sourceAccessType = rhi::EAccessType::None;
 			GetSynchronizationParamsForBuffer(prevAccess, OUT sourceAccessType);
-			
-			rhi::EAccessType destAccessType = rhi::EAccessType::None;
-			GetSynchronizationParamsForBuffer(nextAccess, OUT destAccessType);
 
-			node.AddPreExecutionBarrier(prevAccessStages, sourceAccessType, nextAccessStages, destAccessType);
+			node.AddPreExecutionBarrier(prevAccessStages, sourceAccessType, nextAccessStages, nextAccessType);
 		}
 		
 		accessedBuffer->SetLastAccessNode(&node);
@@ -1213,64 +1329,192 @@ Bool RenderGraphBuilder::RequiresSynchronization(RGBufferHandle buffer, rhi::EPi
 
 void RenderGraphBuilder::PostBuild()
 {
+	SPT_PROFILER_FUNCTION();
+
 	AddReleaseResourcesNode();
 
-	ResolveTextureProperties();
+	CullNodes();
+
+	ResolveResourceLifetimes();
+
+	PlaceTransientTextures();
+
+	ResolveBarriers();
+
+	SPT_LOG_TRACE(RenderGraph, "Compiled render graph: {} nodes ({} culled), {} transient textures, transient memory: {} bytes (without aliasing: {} bytes)",
+				  m_compilationStatistics.nodesNum,
+				  m_compilationStatistics.culledNodes.size(),
+				  m_compilationStatistics.transientTexturesNum,
+				  m_compilationStatistics.transientMemorySize,
+				  m_compilationStatistics.nonAliasedTransientMemorySize);
+
+	SPT_LOG_TRACE(RenderGraph, "Render graph barriers: {} transitions in {} batches before planning, {} transitions in {} batches ({} split barriers) after planning, {} read to read transitions dropped",
+				  m_compilationStatistics.incrementalTransitionsNum,
+				  m_compilationStatistics.incrementalBarrierBatchesNum,
+				  m_compilationStatistics.plannedTransitionsNum,
+				  m_compilationStatistics.plannedBarrierBatchesNum,
+				  m_compilationStatistics.splitBarriersNum,
+				  m_compilationStatistics.droppedReadToReadTransitionsNum);
+
+	for (const lib::SharedPtr<RenderGraphDebugDecorator>& decorator : m_debugDecorators)
+	{
+		decorator->PostGraphCompiled(*this);
+	}
 }
 
 void RenderGraphBuilder::ExecuteGraph()
 {
 	SPT_PROFILER_FUNCTION();
 
-	RGExecutionContext graphExecutionContext;
-	graphExecutionContext.statisticsCollector = m_statisticsCollector;
+	lib::DynamicArray<RGNodeHandle> nodes;
+	nodes.reserve(m_nodes.GetSize());
+
+	// Resources acquisition and descriptors flush are not thread safe, so they are done in order, before recording
+	for (RGNodeHandle node : m_nodes)
+	{
+		node->PrepareForExecution();
+		nodes.emplace_back(node);
+	}
 
-	rhi::ContextDefinition renderContextDefinition(GetMemoryArena());
-	const lib::SharedRef<rdr::RenderContext> renderContext = rdr::ResourcesManager::CreateContext(RENDERER_RESOURCE_NAME("Render Graph Context"), renderContextDefinition);
+	m_compilationStatistics.fallbackAllocationsNum = m_resourcesPool.GetFallbackAllocationsNum();
+	m_compilationStatistics.reusedTexturesNum      = m_resourcesPool.GetReusedTexturesNum();
 
-	const rhi::CommandBufferDefinition cmdBufferDef(rhi::EDeviceCommandQueueType::Graphics, rhi::ECommandBufferType::Primary, rhi::ECommandBufferComplexityClass::Default);
-	lib::UniquePtr<rdr::CommandRecorder> commandRecorder = rdr::ResourcesManager::CreateCommandRecorder(RENDERER_RESOURCE_NAME("RenderGraphCommandBuffer"),
-																										renderContext,
-																										cmdBufferDef);
+	lib::DynamicArray<priv::RGRecordingRange> recordingRanges = priv::BuildRecordingRanges(lib::Span<const RGNodeHandle>(nodes));
+
+#if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+	rdr::GPUCheckpointValidator checkpointValidator;
+	const Uint32 beginCheckpoint = checkpointValidator.RegisterCheckpoint("RENDER GRAPH BEGIN");
+#endif // SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+
+	for (SizeType rangeIdx = 0u; rangeIdx < recordingRanges.size(); ++rangeIdx)
+	{
+		priv::RGRecordingRange& range = recordingRanges[rangeIdx];
+
+		// Graph arena is not thread safe, so each range records with its own arena. Arenas are returned to the pool when graph is destroyed
+		lib::MemoryArena& rangeArena = m_resourcesPool.AcquireRecordingArena();
+		m_recordingArenas.emplace_back(&rangeArena);
+		range.memoryArena = &rangeArena;
+
+		if (m_statisticsCollector)
+		{
+			range.statisticsCollector = lib::MakeShared<rdr::GPUStatisticsCollector>(*m_statisticsCollector);
+		}
 
 #if RG_ENABLE_DIAGNOSTICS
-	RGDiagnosticsPlayback diagnosticsPlayback;
+		if (rangeIdx > 0u)
+		{
+			range.resumedScopes = &recordingRanges[rangeIdx - 1u].nodes.back()->GetDiagnosticsRecord();
+		}
 #endif // RG_ENABLE_DIAGNOSTICS
 
 #if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
-	rdr::GPUCheckpointValidator checkpointValidator;
-	checkpointValidator.AddCheckpoint(*commandRecorder, "RENDER GRAPH BEGIN");
+		range.checkpoints.reserve(range.nodes.size());
+		for (RGNodeHandle node : range.nodes)
+		{
+			range.checkpoints.emplace_back(checkpointValidator.RegisterCheckpoint(node->GetName()));
+		}
 #endif // SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+	}
 
-	for (RGNodeHandle node : m_nodes)
+#if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+	const Uint32 endCheckpoint = checkpointValidator.RegisterCheckpoint("RENDER GRAPH END");
+#endif // SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+
+	const auto recordRange = [&](priv::RGRecordingRange& range)
 	{
+		SPT_PROFILER_SCOPE("Record Render Graph Range");
+
+		RGExecutionContext rangeExecutionContext;
+		rangeExecutionContext.statisticsCollector = range.statisticsCollector;
+		rangeExecutionContext.memoryArena         = range.memoryArena;
+
+		// Each range has its own render context, so command buffers are acquired from separate command pools library,
+		// which is taken from command pools manager on first acquire and returned to it when context is released
+		rhi::ContextDefinition renderContextDefinition(*range.memoryArena);
+		const lib::SharedRef<rdr::RenderContext> renderContext = rdr::ResourcesManager::CreateContext(RENDERER_RESOURCE_NAME("Render Graph Context"), renderContextDefinition);
+
+		const rhi::CommandBufferDefinition cmdBufferDef(rhi::EDeviceCommandQueueType::Graphics, rhi::ECommandBufferType::Primary, rhi::ECommandBufferComplexityClass::Default);
+		lib::UniquePtr<rdr::CommandRecorder> commandRecorder = rdr::ResourcesManager::CreateCommandRecorder(RENDERER_RESOURCE_NAME("RenderGraphCommandBuffer"),
+																											renderContext,
+																											cmdBufferDef);
+
+#if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+		if (&range == &recordingRanges.front())
+		{
+			checkpointValidator.WriteCheckpoint(*commandRecorder, beginCheckpoint);
+		}
+#endif // SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
+
 #if RG_ENABLE_DIAGNOSTICS
-		diagnosticsPlayback.Playback(*commandRecorder, m_statisticsCollector, node->GetDiagnosticsRecord());
+		RGDiagnosticsPlayback diagnosticsPlayback;
+		if (range.resumedScopes)
+		{
+			diagnosticsPlayback.ResumeScopes(*commandRecorder, range.statisticsCollector, *range.resumedScopes);
+		}
 #endif // RG_ENABLE_DIAGNOSTICS
 
-		node->Execute(renderContext, *commandRecorder, graphExecutionContext);
+		for (SizeType nodeIdx = 0u; nodeIdx < range.nodes.size(); ++nodeIdx)
+		{
+			const RGNodeHandle node = range.nodes[nodeIdx];
+
+#if RG_ENABLE_DIAGNOSTICS
+			diagnosticsPlayback.Playback(*commandRecorder, range.statisticsCollector, node->GetDiagnosticsRecord());
+#endif // RG_ENABLE_DIAGNOSTICS
+
+			node->Execute(renderContext, *commandRecorder, rangeExecutionContext);
 
 #if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
-		checkpointValidator.AddCheckpoint(*commandRecorder, node->GetName());
+			checkpointValidator.WriteCheckpoint(*commandRecorder, range.checkpoints[nodeIdx]);
 #endif // SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
-	}
+		}
 
 #if RG_ENABLE_DIAGNOSTICS
-	diagnosticsPlayback.PopRemainingScopes(*commandRecorder, m_statisticsCollector);
+		diagnosticsPlayback.PopRemainingScopes(*commandRecorder, range.statisticsCollector);
 #endif // RG_ENABLE_DIAGNOSTICS
 
 #if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
-	checkpointValidator.AddCheckpoint(*commandRecorder, "RENDER GRAPH END");
+		if (&range == &recordingRanges.back())
+		{
+			checkpointValidator.WriteCheckpoint(*commandRecorder, endCheckpoint);
+		}
 #endif // SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
 
-	lib::SharedRef<rdr::GPUWorkload> workload = commandRecorder->FinishRecording();
+		range.workload = commandRecorder->FinishRecording();
+	};
 
-	workload->BindEvent(m_onGraphExecutionFinished);
+	m_isRecordingNodes = true;
+
+	if (recordingRanges.size() > 1u)
+	{
+		js::InlineParallelForEach("Record Render Graph Ranges", recordingRanges, recordRange);
+	}
+	else
+	{
+		recordRange(recordingRanges.front());
+	}
+
+	m_isRecordingNodes = false;
+
+	if (m_statisticsCollector)
+	{
+		for (priv::RGRecordingRange& range : recordingRanges)
+		{
+			m_statisticsCollector->MergeRangeCollector(*range.statisticsCollector);
+		}
+	}
+
+	recordingRanges.back().workload->BindEvent(m_onGraphExecutionFinished);
 
 	m_preGPUWorkSubmittedEvent.Signal();
 	m_preGPUWorkSubmittedEvent.Wait();
 
-	rdr::GPUApi::GetDeviceQueuesManager().Submit(workload, lib::Flags(rdr::EGPUWorkloadSubmitFlags::MemoryTransfersWait, rdr::EGPUWorkloadSubmitFlags::CorePipe));
+	rdr::DeviceQueuesManager& queuesManager = rdr::GPUApi::GetDeviceQueuesManager();
+
+	// Ranges must be submitted in order, because synchronization between nodes is recorded as pipeline barriers
+	for (const priv::RGRecordingRange& range : recordingRanges)
+	{
+		queuesManager.Submit(lib::Ref(range.workload), lib::Flags(rdr::EGPUWorkloadSubmitFlags::MemoryTransfersWait, rdr::EGPUWorkloadSubmitFlags::CorePipe));
+	}
 
 #if SPT_ENABLE_RENDER_GRAPH_CHECKPOINTS_VALIDATION
 	rdr::GPUApi::WaitIdle(false);
@@ -1293,6 +1537,7 @@ void RenderGraphBuilder::AddReleaseResourcesNode()
 			const rhi::TextureSubresourceRange transitionRange(rhi::GetFullAspectForFormat(textureFormat));
 
 			AppendTextureTransitionToNode(barrierNode, &texture, transitionRange, *transitionTarget);
+			barrierNode.AddTextureAccess(texture, transitionTarget->stage, transitionTarget->accessType);
 		}
 		else
 		{
@@ -1304,56 +1549,334 @@ void RenderGraphBuilder::AddReleaseResourcesNode()
 				const rhi::EFragmentFormat textureFormat = texture.GetTextureDefinition().format;
 				const rhi::TextureSubresourceRange transitionRange(rhi::GetFullAspectForFormat(textureFormat));
 				AppendTextureTransitionToNode(barrierNode, &texture, transitionRange, rhi::TextureTransition::ShaderRead);
+				barrierNode.AddTextureAccess(texture, rhi::TextureTransition::ShaderRead.stage, rhi::TextureTransition::ShaderRead.accessType);
 				accessState.SetSubresourcesAccess(RGTextureSubresourceAccessState(ERGTextureAccess::ShaderWrite, &barrierNode), transitionRange);
 			}
 		}
 	}
 }
 
-void RenderGraphBuilder::ResolveResourceProperties()
+void RenderGraphBuilder::CullNodes()
 {
-	ResolveTextureProperties();
-	ResolveBufferReleases();
+	SPT_PROFILER_FUNCTION();
+
+	m_compilationStatistics.nodesNum = m_nodes.GetSize();
+
+	if (!rdr::RendererSettings::Get().renderGraphPassCulling)
+	{
+		return;
+	}
+
+	// Textures and buffers share indices. Accesses to texture views are tracked as accesses to whole texture
+	lib::HashMap<const RGResource*, Uint32> resourceIndices;
+	lib::DynamicArray<Bool> observableResources;
+
+	const auto getResourceIdx = [&resourceIndices, &observableResources](const RGResource& resource, Bool isObservable) -> Uint32
+	{
+		const auto [resourceIt, inserted] = resourceIndices.emplace(&resource, static_cast<Uint32>(observableResources.size()));
+		if (inserted)
+		{
+			observableResources.emplace_back(isObservable);
+		}
+		return resourceIt->second;
+	};
+
+	lib::DynamicArray<RGCompilationResourceAccess> accesses;
+	lib::DynamicArray<SizeType> nodeAccessesBegin;
+	nodeAccessesBegin.reserve(m_nodes.GetSize() + 1u);
+
+	for (RGNodeHandle node : m_nodes)
+	{
+		nodeAccessesBegin.emplace_back(accesses.size());
+
+		for (const RGNodeTextureAccess& textureAccess : node->GetTextureAccesses())
+		{
+			const RGTexture& texture = *textureAccess.texture;
+			const Bool isObservable = texture.IsExternal() || texture.IsExtracted();
+			accesses.emplace_back(RGCompilationResourceAccess{ getResourceIdx(texture, isObservable), textureAccess.isWrite });
+		}
+
+		for (const RGNodeBufferAccess& bufferAccess : node->GetBufferAccesses())
+		{
+			const RGBuffer& buffer = *bufferAccess.buffer;
+			const Bool isObservable = buffer.IsExternal() || buffer.IsExtracted();
+			accesses.emplace_back(RGCompilationResourceAccess{ getResourceIdx(buffer, isObservable), bufferAccess.isWrite });
+		}
+	}
+
+	nodeAccessesBegin.emplace_back(accesses.size());
+
+	lib::DynamicArray<RGCompilationNode> compilationNodes;
+	compilationNodes.reserve(m_nodes.GetSize());
+
+	for (RGNodeHandle node : m_nodes)
+	{
+		const SizeType nodeIdx = compilationNodes.size();
+
+		RGCompilationNode& compilationNode = compilationNodes.emplace_back();
+		compilationNode.accesses       = lib::Span<const RGCompilationResourceAccess>(accesses.data() + nodeAccessesBegin[nodeIdx], nodeAccessesBegin[nodeIdx + 1u] - nodeAccessesBegin[nodeIdx]);
+		compilationNode.hasSideEffects = node->HasSideEffects();
+	}
+
+	const lib::DynamicArray<Bool> aliveNodes = ComputeAliveNodes(compilationNodes, observableResources);
+
+	SizeType nodeIdx = 0u;
+	for (RGNodeHandle node : m_nodes)
+	{
+		if (!aliveNodes[nodeIdx++])
+		{
+			node->MarkCulled();
+			m_compilationStatistics.culledNodes.emplace_back(node->GetName());
+		}
+	}
 }
 
-void RenderGraphBuilder::ResolveTextureProperties()
+void RenderGraphBuilder::ResolveResourceLifetimes()
 {
-	for (RGTexture& texture : m_textures)
+	SPT_PROFILER_FUNCTION();
+
+	lib::HashMap<const RGTexture*, RGNodeHandle> texturesLastAccessNodes;
+
+	for (RGNodeHandle node : m_nodes)
 	{
-		if (!texture.IsExternal() && !texture.IsExtracted())
+		if (node->IsCulled())
+		{
+			continue;
+		}
+
+		for (const RGNodeTextureAccess& textureAccess : node->GetTextureAccesses())
 		{
-			RGTextureAccessState& textureAccesses = texture.GetAccessState();
+			// Accesses without view are only transitions of textures that outlive the graph, so they don't extend lifetime
+			if (!textureAccess.textureView)
+			{
+				continue;
+			}
 
-			RGNodeHandle lastAccessNode;
+			RGTextureView& textureView = *textureAccess.textureView;
+			RGTexture& texture         = *textureView.GetTexture();
 
-			if (textureAccesses.IsFullResource())
+			if (!texture.IsExternal())
 			{
-				const RGTextureSubresourceAccessState& accessState = textureAccesses.GetForFullResource();
-				lastAccessNode = accessState.lastAccessNode;
+				if (!texture.HasAcquireNode())
+				{
+					node->AddTextureToAcquire(texture);
+				}
+
+				texturesLastAccessNodes[&texture] = node;
 			}
-			else
+
+			if (!textureView.IsExternal() && !textureView.HasAcquireNode())
 			{
-				// find last accessed subresource
-				textureAccesses.ForEachSubresource([&](RGTextureSubresource subresource)
-												   {
-													   const RGTextureSubresourceAccessState& accessState = textureAccesses.GetForSubresource(subresource);
-													   if (!lastAccessNode.IsValid() || lastAccessNode->GetID() < accessState.lastAccessNode->GetID())
-													   {
-														   lastAccessNode = accessState.lastAccessNode; 
-													   }
-												   });
+				node->AddTextureViewToAcquire(textureView);
 			}
+		}
+
+		for (const RGNodeBufferAccess& bufferAccess : node->GetBufferAccesses())
+		{
+			RGBuffer& buffer = *bufferAccess.buffer;
 
-			if (lastAccessNode)
+			if (!buffer.IsExternal() && !buffer.HasAcquireNode())
 			{
-				lastAccessNode->AddTextureToRelease(texture);
+				node->AddBufferToAcquire(buffer);
+			}
+		}
+	}
 
-				texture.SelectAllocationStrategy();
+	for (RGTexture& texture : m_textures)
+	{
+		const auto lastAccessNode = texturesLastAccessNodes.find(&texture);
+		if (lastAccessNode != std::cend(texturesLastAccessNodes))
+		{
+			texture.SelectAllocationStrategy();
+
+			if (!texture.IsExtracted())
+			{
+				lastAccessNode->second->AddTextureToRelease(texture);
 			}
 		}
 	}
 }
 
+void RenderGraphBuilder::PlaceTransientTextures()
+{
+	SPT_PROFILER_FUNCTION();
+
+	struct TransientTexturesGroup
+	{
+		lib::DynamicArray<RGTexture*>                   textures;
+		lib::DynamicArray<RGTransientAllocationRequest> requests;
+	};
+
+	lib::HashMap<rhi::EMemoryUsage, TransientTexturesGroup> groups;
+
+	for (RGTexture& texture : m_textures)
+	{
+		// Extracted textures outlive graph, so they cannot alias with other textures
+		if (texture.IsExternal() || texture.IsExtracted() || !texture.HasAcquireNode())
+		{
+			continue;
+		}
+
+		SPT_CHECK(texture.HasReleaseNode());
+
+		const rhi::RHIMemoryRequirements memoryRequirements = m_resourcesPool.GetTextureMemoryRequirements(texture.GetTextureRHIDefinition());
+
+		TransientTexturesGroup& group = groups[texture.GetAllocationInfo().memoryUsage];
+		group.textures.emplace_back(&texture);
+
+		RGTransientAllocationRequest& request = group.requests.emplace_back();
+		request.firstNodeIdx = static_cast<Uint32>(texture.GetAcquireNode()->GetID());
+		request.lastNodeIdx  = static_cast<Uint32>(texture.GetReleaseNode()->GetID());
+		request.size         = memoryRequirements.size;
+		request.alignment    = memoryRequirements.alignment;
+	}
+
+	for (const auto& [memoryUsage, group] : groups)
+	{
+		const RGTransientMemoryPlacement placement = PlaceTransientAllocations(group.requests);
+
+		m_resourcesPool.ReserveTransientMemory(memoryUsage, placement.requiredMemorySize);
+
+		for (SizeType textureIdx = 0u; textureIdx < group.textures.size(); ++textureIdx)
+		{
+			group.textures[textureIdx]->SetTransientMemoryOffset(placement.offsets[textureIdx]);
+		}
+
+		m_compilationStatistics.transientTexturesNum          += static_cast<Uint32>(group.textures.size());
+		m_compilationStatistics.transientMemorySize           += placement.requiredMemorySize;
+		m_compilationStatistics.nonAliasedTransientMemorySize += placement.nonAliasedMemorySize;
+	}
+}
+
+void RenderGraphBuilder::ResolveBarriers()
+{
+	SPT_PROFILER_FUNCTION();
+
+	const auto countBarriers = [this](Uint32& outTransitionsNum, Uint32& outBatchesNum)
+	{
+		outTransitionsNum = 0u;
+		outBatchesNum     = 0u;
+
+		for (RGNodeHandle node : m_nodes)
+		{
+			const Uint32 nodeBarriersNum = node->GetPreExecutionBarriersNum();
+			outTransitionsNum += nodeBarriersNum;
+			outBatchesNum     += nodeBarriersNum > 0u ? 1u : 0u;
+		}
+	};
+
+	countBarriers(OUT m_compilationStatistics.incrementalTransitionsNum, OUT m_compilationStatistics.incrementalBarrierBatchesNum);
+
+	const rdr::RendererSettings& settings = rdr::RendererSettings::Get();
+
+	if (!settings.renderGraphBarrierPlanning)
+	{
+		m_compilationStatistics.plannedTransitionsNum    = m_compilationStatistics.incrementalTransitionsNum;
+		m_compilationStatistics.plannedBarrierBatchesNum = m_compilationStatistics.incrementalBarrierBatchesNum;
+		return;
+	}
+
+	// Textures and buffers share indices. Synchronization uses global memory barriers, so accesses to texture views are tracked as accesses to whole texture
+	lib::HashMap<const RGResource*, Uint32> resourceIndices;
+	lib::DynamicArray<RGResourceInitialAccess> initialAccesses;
+
+	const auto getResourceIdx = [&resourceIndices, &initialAccesses](const RGResource& resource, const RGResourceInitialAccess& initialAccess) -> Uint32
+	{
+		const auto [resourceIt, inserted] = resourceIndices.emplace(&resource, static_cast<Uint32>(initialAccesses.size()));
+		if (inserted)
+		{
+			initialAccesses.emplace_back(initialAccess);
+		}
+		return resourceIt->second;
+	};
+
+	// External textures may be in any state, and host may write to buffers before graph is executed
+	const RGResourceInitialAccess externalTextureInitialAccess{ rhi::TextureTransition::Generic.stage, rhi::TextureTransition::Generic.accessType };
+	const RGResourceInitialAccess hostWrittenBufferInitialAccess{ rhi::EPipelineStage::Host, rhi::EAccessType::Write };
+
+	lib::DynamicArray<RGNodeHandle> executedNodes;
+	lib::DynamicArray<RGSynchronizationAccess> accesses;
+	lib::DynamicArray<SizeType> nodeAccessesBegin;
+	executedNodes.reserve(m_nodes.GetSize());
+	nodeAccessesBegin.reserve(m_nodes.GetSize() + 1u);
+
+	for (RGNodeHandle node : m_nodes)
+	{
+		if (node->IsCulled())
+		{
+			continue;
+		}
+
+		executedNodes.emplace_back(node);
+		nodeAccessesBegin.emplace_back(accesses.size());
+
+		for (const RGNodeTextureAccess& textureAccess : node->GetTextureAccesses())
+		{
+			const RGTexture& texture = *textureAccess.texture;
+			const RGResourceInitialAccess initialAccess = texture.IsExternal() ? externalTextureInitialAccess : RGResourceInitialAccess{};
+			accesses.emplace_back(RGSynchronizationAccess{ getResourceIdx(texture, initialAccess), textureAccess.stage, textureAccess.access });
+		}
+
+		for (const RGNodeBufferAccess& bufferAccess : node->GetBufferAccesses())
+		{
+			const RGBuffer& buffer = *bufferAccess.buffer;
+			const RGResourceInitialAccess initialAccess = buffer.AllowsHostAccess() ? hostWrittenBufferInitialAccess : RGResourceInitialAccess{};
+			accesses.emplace_back(RGSynchronizationAccess{ getResourceIdx(buffer, initialAccess), bufferAccess.stage, bufferAccess.access });
+		}
+	}
+
+	nodeAccessesBegin.emplace_back(accesses.size());
+
+	lib::DynamicArray<RGSynchronizationNode> synchronizationNodes(executedNodes.size());
+	for (SizeType nodeIdx = 0u; nodeIdx < executedNodes.size(); ++nodeIdx)
+	{
+		const SizeType accessesNum = nodeAccessesBegin[nodeIdx + 1u] - nodeAccessesBegin[nodeIdx];
+		synchronizationNodes[nodeIdx].accesses = lib::Span<const RGSynchronizationAccess>(accesses.data() + nodeAccessesBegin[nodeIdx], accessesNum);
+	}
+
+	const RGBarriersPlan plan = PlanBarriers(synchronizationNodes, initialAccesses);
+
+	for (RGNodeHandle node : m_nodes)
+	{
+		node->ClearPreExecutionBarriers();
+	}
+
+	Uint32 splitBarriersNum = 0u;
+
+	for (const RGPlannedDependency& dependency : plan.dependencies)
+	{
+		RGNode& destNode = *executedNodes[dependency.destNodeIdx];
+
+		// Split barriers are used only if there is enough work between source and destination nodes to hide the latency of the event
+		const Bool useSplitBarrier = settings.splitBarrierMinNodesDistance > 0u
+								  && dependency.sourceNodeIdx != idxNone<Uint32>
+								  && dependency.destNodeIdx - dependency.sourceNodeIdx >= settings.splitBarrierMinNodesDistance;
+
+		if (useSplitBarrier)
+		{
+			RGNode& sourceNode = *executedNodes[dependency.sourceNodeIdx];
+
+			RGSplitBarrier& splitBarrier = m_splitBarriers.EmplaceBack(RGSplitBarrier{ m_resourcesPool.AcquireSplitBarrierEvent(), rhi::RHIDependency() });
+			splitBarrier.dependency.StageBarrier(dependency.sourceStage, dependency.sourceAccess, dependency.destStage, dependency.destAccess);
+
+			sourceNode.AddSplitBarrierToSignal(splitBarrier);
+			destNode.AddSplitBarrierToWait(splitBarrier);
+
+			++splitBarriersNum;
+		}
+		else
+		{
+			destNode.AddPreExecutionBarrier(dependency.sourceStage, dependency.sourceAccess, dependency.destStage, dependency.destAccess);
+		}
+	}
+
+	countBarriers(OUT m_compilationStatistics.plannedTransitionsNum, OUT m_compilationStatistics.plannedBarrierBatchesNum);
+
+	m_compilationStatistics.plannedTransitionsNum           += splitBarriersNum;
+	m_compilationStatistics.splitBarriersNum                = splitBarriersNum;
+	m_compilationStatistics.droppedReadToReadTransitionsNum = plan.droppedReadToReadNum;
+}
+
 void RenderGraphBuilder::ResolveBufferReleases()
 {
 	SPT_PROFILER_FUNCTION();
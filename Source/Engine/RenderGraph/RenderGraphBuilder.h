@@ -149,13 +149,20 @@ public:
 
 	RGAllocator& GetAllocator() { return m_allocator; }
 
-	lib::MemoryArena& GetMemoryArena() { return m_memoryArena; }
+	/** Graph arena is not thread safe. Node callables are recorded in parallel, so they must use RGExecutionContext::memoryArena instead */
+	lib::MemoryArena& GetMemoryArena()
+	{
+		SPT_CHECK_MSG(!m_isRecordingNodes, "Graph memory arena cannot be used during nodes recording");
+		return m_memoryArena;
+	}
 
 	template<typename TDSType>
 	lib::MTHandle<TDSType> CreateDescriptorSet(const rdr::RendererResourceName& name);
 
 	// Diagnostics ============================================
 
+	const RGCompilationStatistics& GetCompilationStatistics() const { return m_compilationStatistics; }
+
 #if RG_ENABLE_DIAGNOSTICS
 	void PushProfilerScope(lib::HashedString name);
 	void PopProfilerScope();
@@ -288,8 +295,18 @@ private:
 
 	void AddReleaseResourcesNode();
 
-	void ResolveResourceProperties();
-	void ResolveTextureProperties();
+	/** Marks nodes that don't contribute to any observable output as culled */
+	void CullNodes();
+
+	/** Resolves acquire and release nodes of resources, based on accesses of nodes that weren't culled */
+	void ResolveResourceLifetimes();
+
+	/** Computes offsets of transient textures in memory pool. Textures with disjoint lifetimes may alias */
+	void PlaceTransientTextures();
+
+	/** Replaces barriers resolved while building with barriers planned for whole graph (if enabled) */
+	void ResolveBarriers();
+
 	void ResolveBufferReleases();
 
 	rdr::PipelineStateID GetOrCreateComputePipelineStateID(rdr::ShaderID shader) const;
@@ -312,6 +329,8 @@ private:
 	lib::DynamicPushArray<RGNodeHandle> m_nodes;
 	RGNodeID m_nodeCounter = 0u;
 
+	lib::DynamicPushArray<RGSplitBarrier> m_splitBarriers;
+
 	lib::InlineDynamicArray<lib::MTHandle<RGDescriptorSetStateBase>, 32u> m_boundDSStates;
 
 	lib::InlineDynamicArray<lib::SharedPtr<RenderGraphDebugDecorator>, 4u> m_debugDecorators;
@@ -331,6 +350,8 @@ private:
 
 	RenderGraphResourcesPool& m_resourcesPool;
 
+	RGCompilationStatistics m_compilationStatistics;
+
 #if RG_ENABLE_DIAGNOSTICS
 	RGProfilerRecorder m_profilerRecorder;
 #endif // RG_ENABLE_DIAGNOSTICS
@@ -340,6 +361,11 @@ private:
 	RGAllocator m_allocator;
 
 	lib::MemoryArena& m_memoryArena;
+
+	/** Arenas acquired from resources pool for recording ranges */
+	lib::DynamicArray<lib::MemoryArena*> m_recordingArenas;
+
+	Bool m_isRecordingNodes = false;
 };
 
 template<typename TType, typename... TArgs>
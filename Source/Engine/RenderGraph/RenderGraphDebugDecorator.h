@@ -25,6 +25,9 @@ public:
 
 	virtual void PostNodeAdded(RenderGraphBuilder& graphBuilder, RGNode& node, const RGDependeciesContainer& dependencies) {};
 	virtual void PostSubpassAdded(RenderGraphBuilder& graphBuilder, RGNode& node, const RGDependeciesContainer& dependencies) {};
+
+	/** Called after graph was built and compiled, before its execution */
+	virtual void PostGraphCompiled(RenderGraphBuilder& graphBuilder) {};
 };
 
 } // spt::rg
\ No newline at end of file
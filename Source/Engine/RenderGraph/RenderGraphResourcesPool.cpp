@@ -3,6 +3,7 @@
 #include "GPUApi.h"
 #include "Types/DescriptorSetState/DescriptorSetStateTypes.h"
 #include "Types/GPUMemoryPool.h"
+#include "Types/GPUEvent.h"
 #include "Types/Texture.h"
 
 namespace spt::rg
@@ -10,27 +11,68 @@ namespace spt::rg
 
 static constexpr Uint32 allocatorSize = 1u * 1024u * 1024u;
 
+namespace priv
+{
+
+static constexpr Real32 transientMemoryPoolSizeMultiplier = 1.2f;
+
+/** Recording ranges use separate arenas that commit memory on demand, so heavy passes don't overflow them */
+static constexpr Uint64 recordingRangeArenaCommitedSize = 256u * 1024u;
+static constexpr Uint64 recordingRangeArenaReservedSize = 256u * 1024u * 1024u;
+
+
+static rhi::TextureDefinition GetRenderGraphTextureDefinition(const rhi::TextureDefinition& definition)
+{
+	// Render graph textures are initialized by graph transitions
+	rhi::TextureDefinition rgDefinition = definition;
+	lib::AddFlag(rgDefinition.flags, rhi::ETextureFlags::SkipAutoGPUInit);
+	return rgDefinition;
+}
+
+} // priv
+
 RenderGraphResourcesPool::RenderGraphResourcesPool()
 	: m_constantsAllocators{ rdr::ConstantsAllocator(allocatorSize), rdr::ConstantsAllocator(allocatorSize) }
 {
 }
 
+RenderGraphResourcesPool::~RenderGraphResourcesPool()
+{
+	DestroyResources();
+}
+
 void RenderGraphResourcesPool::Prepare()
 {
 	SPT_PROFILER_FUNCTION();
 
 	for (auto& [memoryUsage, poolData] : m_memoryPools)
 	{
-		SPT_CHECK(poolData.currentMemoryUsage == 0u);
+		SPT_CHECK(poolData.texturesInUse.empty());
 
-		const Uint64 poolSize       = poolData.memoryPool ? poolData.memoryPool->GetRHI().GetSize() : 0u;
-		const Uint64 requiredMemory = static_cast<Uint64>(poolData.maxMemoryUsage * 1.2);
-		if (poolSize < requiredMemory)
+		// Evict textures that weren't used during last frame, as they would keep descriptors and memory bindings alive
+		for (auto& [key, textures] : poolData.cachedTextures)
 		{
-			poolData.memoryPool = rdr::ResourcesManager::CreateGPUMemoryPool(RENDERER_RESOURCE_NAME("Render Graph GPU Memory Pool"), rhi::RHIMemoryPoolDefinition(requiredMemory), rhi::EMemoryUsage::GPUOnly);
+			for (CachedTexture& cachedTexture : textures)
+			{
+				if (!cachedTexture.wasUsedInCurrentFrame)
+				{
+					cachedTexture.texture->ReleasePlacedAllocation();
+					cachedTexture.texture.reset();
+				}
+				cachedTexture.wasUsedInCurrentFrame = false;
+			}
+
+			std::erase_if(textures, [](const CachedTexture& cachedTexture) { return !cachedTexture.texture; });
 		}
+
+		std::erase_if(poolData.cachedTextures, [](const auto& cachedTexturesEntry) { return cachedTexturesEntry.second.empty(); });
 	}
 
+	m_fallbackAllocationsNum = 0u;
+	m_reusedTexturesNum      = 0u;
+
+	RecycleEvents();
+
 	const rdr::DeviceQueuesManager& queuesManager = rdr::GPUApi::GetDeviceQueuesManager();
 	const rdr::GPUTimelineSection currentlyRecordedSection = queuesManager.GetRecordedSection();
 
@@ -42,28 +84,92 @@ void RenderGraphResourcesPool::Prepare()
 	}
 }
 
-lib::SharedPtr<rdr::Texture> RenderGraphResourcesPool::AcquireTexture(const RenderGraphDebugName& name, const rhi::TextureDefinition& definition, const rhi::RHIAllocationInfo& allocationInfo)
+rhi::RHIMemoryRequirements RenderGraphResourcesPool::GetTextureMemoryRequirements(const rhi::TextureDefinition& definition)
 {
-	MemoryPoolData& poolData = GetMemoryPoolData(allocationInfo);
+	const rhi::TextureDefinition rgDefinition = priv::GetRenderGraphTextureDefinition(definition);
 
-	rdr::AllocationDefinition allocationDefinition;
-	if (poolData.memoryPool)
+	const auto foundRequirements = m_memoryRequirementsCache.find(rgDefinition);
+	if (foundRequirements != std::cend(m_memoryRequirementsCache))
 	{
-		allocationDefinition.SetAllocationDef(rdr::PlacedAllocationDef(lib::Ref(poolData.memoryPool)));
+		return foundRequirements->second;
 	}
 
-	const lib::SharedRef<rdr::Texture> texture = rdr::ResourcesManager::CreateTexture(RENDERER_RESOURCE_NAME(name.Get()), definition, allocationDefinition);
+	// Requirements are queried from texture without bound memory. It's done only once for each definition
+	const lib::SharedRef<rdr::Texture> texture = rdr::ResourcesManager::CreateTexture(RENDERER_RESOURCE_NAME("Render Graph Memory Requirements Query"), rgDefinition, rdr::AllocationDefinition());
+	const rhi::RHIMemoryRequirements memoryRequirements = texture->GetRHI().GetMemoryRequirements();
+
+	m_memoryRequirementsCache.emplace(rgDefinition, memoryRequirements);
+
+	return memoryRequirements;
+}
+
+void RenderGraphResourcesPool::ReserveTransientMemory(rhi::EMemoryUsage memoryUsage, Uint64 requiredSize)
+{
+	SPT_PROFILER_FUNCTION();
+
+	MemoryPoolData& poolData = m_memoryPools[memoryUsage];
+	SPT_CHECK(poolData.texturesInUse.empty());
 
-	rhi::RHIMemoryRequirements memoryRequirements = texture->GetRHI().GetMemoryRequirements();
-	poolData.currentMemoryUsage += memoryRequirements.size;
-	poolData.maxMemoryUsage      = std::max(poolData.maxMemoryUsage, poolData.currentMemoryUsage);
+	const Uint64 poolSize = poolData.memoryPool ? poolData.memoryPool->GetRHI().GetSize() : 0u;
+	if (poolSize < requiredSize)
+	{
+		// Cached textures are bound to old pool, so they cannot be reused anymore
+		ReleaseCachedTextures(poolData);
+
+		const Uint64 newPoolSize = static_cast<Uint64>(requiredSize * priv::transientMemoryPoolSizeMultiplier);
+		poolData.memoryPool = rdr::ResourcesManager::CreateGPUMemoryPool(RENDERER_RESOURCE_NAME("Render Graph GPU Memory Pool"), rhi::RHIMemoryPoolDefinition(newPoolSize), memoryUsage);
+	}
+}
+
+lib::SharedPtr<rdr::Texture> RenderGraphResourcesPool::AcquireTexture(const RenderGraphDebugName& name, const rhi::TextureDefinition& definition, const rhi::RHIAllocationInfo& allocationInfo, Uint64 transientMemoryOffset)
+{
+	const rhi::TextureDefinition rgDefinition = priv::GetRenderGraphTextureDefinition(definition);
 
-	if (!texture->HasBoundMemory())
+	if (transientMemoryOffset != idxNone<Uint64>)
 	{
-		// If placed failed, do committed allocation
+		MemoryPoolData& poolData = m_memoryPools[allocationInfo.memoryUsage];
+		SPT_CHECK_MSG(!!poolData.memoryPool, "Transient memory must be reserved before acquiring placed textures");
+
+		const PlacedTextureKey cachedTextureKey{ rgDefinition, transientMemoryOffset };
+		lib::DynamicArray<CachedTexture>& cachedTextures = poolData.cachedTextures[cachedTextureKey];
+
+		const auto reusedTexture = std::find_if(std::begin(cachedTextures), std::end(cachedTextures), [](const CachedTexture& cachedTexture) { return !cachedTexture.isInUse; });
+		if (reusedTexture != std::end(cachedTextures))
+		{
+			reusedTexture->isInUse               = true;
+			reusedTexture->wasUsedInCurrentFrame = true;
+			reusedTexture->texture->Rename(RENDERER_RESOURCE_NAME(name.Get()));
+
+			poolData.texturesInUse.emplace(reusedTexture->texture.get(), cachedTextureKey);
+
+			++m_reusedTexturesNum;
+
+			return reusedTexture->texture;
+		}
+
+		const lib::SharedRef<rdr::Texture> texture = rdr::ResourcesManager::CreateTexture(RENDERER_RESOURCE_NAME(name.Get()), rgDefinition, rdr::AllocationDefinition());
+		texture->BindMemory(rdr::PlacedAllocationDef(lib::Ref(poolData.memoryPool), transientMemoryOffset));
+
+		if (texture->HasBoundMemory())
+		{
+			CachedTexture& cachedTexture = cachedTextures.emplace_back();
+			cachedTexture.texture               = texture;
+			cachedTexture.isInUse               = true;
+			cachedTexture.wasUsedInCurrentFrame = true;
+
+			poolData.texturesInUse.emplace(texture.Get(), cachedTextureKey);
+
+			return texture;
+		}
+
+		// If placement failed, do committed allocation
+		++m_fallbackAllocationsNum;
 		texture->BindMemory(allocationInfo);
+
+		return texture;
 	}
 
+	const lib::SharedRef<rdr::Texture> texture = rdr::ResourcesManager::CreateTexture(RENDERER_RESOURCE_NAME(name.Get()), rgDefinition, allocationInfo);
 	SPT_CHECK(texture->HasBoundMemory());
 
 	return texture;
@@ -71,28 +177,128 @@ lib::SharedPtr<rdr::Texture> RenderGraphResourcesPool::AcquireTexture(const Rend
 
 void RenderGraphResourcesPool::ReleaseTexture(lib::SharedPtr<rdr::Texture> texture)
 {
-	const rhi::RHIMemoryRequirements memoryRequirements = texture->GetRHI().GetMemoryRequirements();
+	SPT_CHECK(!!texture);
 
-	MemoryPoolData& poolData = GetMemoryPoolData(texture->GetRHI().GetAllocationInfo());
+	MemoryPoolData& poolData = m_memoryPools[texture->GetRHI().GetAllocationInfo().memoryUsage];
 
-	SPT_CHECK(poolData.currentMemoryUsage >= memoryRequirements.size);
-	poolData.currentMemoryUsage -= memoryRequirements.size;
+	const auto foundTextureInUse = poolData.texturesInUse.find(texture.get());
+	if (foundTextureInUse == std::cend(poolData.texturesInUse))
+	{
+		// Committed allocations are released with texture
+		return;
+	}
 
-	if (texture->GetRHI().IsPlacedAllocation())
+	lib::DynamicArray<CachedTexture>& cachedTextures = poolData.cachedTextures.at(foundTextureInUse->second);
+
+	const auto cachedTexture = std::find_if(std::begin(cachedTextures), std::end(cachedTextures), [&texture](const CachedTexture& cached) { return cached.texture == texture; });
+	SPT_CHECK(cachedTexture != std::end(cachedTextures));
+	SPT_CHECK(cachedTexture->isInUse);
+
+	// Texture keeps its placement, so it can be reused by texture with the same definition and offset
+	cachedTexture->isInUse = false;
+
+	poolData.texturesInUse.erase(foundTextureInUse);
+}
+
+lib::SharedRef<rdr::GPUEvent> RenderGraphResourcesPool::AcquireSplitBarrierEvent()
+{
+	if (m_availableEvents.empty())
+	{
+		m_availableEvents.emplace_back(rdr::ResourcesManager::CreateGPUEvent(RENDERER_RESOURCE_NAME("Render Graph Split Barrier"), rhi::EventDefinition(rhi::EEventFlags::GPUOnly)));
+	}
+
+	lib::SharedRef<rdr::GPUEvent> event = std::move(m_availableEvents.back());
+	m_availableEvents.pop_back();
+
+	m_acquiredEvents.emplace_back(event);
+
+	return event;
+}
+
+lib::MemoryArena& RenderGraphResourcesPool::AcquireRecordingArena()
+{
+	if (m_availableRecordingArenas.empty())
 	{
-		texture->ReleasePlacedAllocation();
+		const lib::UniquePtr<lib::MemoryArena>& arena = m_recordingArenas.emplace_back(lib::MakeUnique<lib::MemoryArena>("Render Graph Recording Range Arena",
+																														 priv::recordingRangeArenaCommitedSize,
+																														 priv::recordingRangeArenaReservedSize));
+		m_availableRecordingArenas.emplace_back(arena.get());
 	}
+
+	lib::MemoryArena* arena = m_availableRecordingArenas.back();
+	m_availableRecordingArenas.pop_back();
+
+	return *arena;
 }
 
-RenderGraphResourcesPool::MemoryPoolData& RenderGraphResourcesPool::GetMemoryPoolData(const rhi::RHIAllocationInfo& allocationInfo)
+void RenderGraphResourcesPool::ReleaseRecordingArena(lib::MemoryArena& arena)
 {
-	MemoryPoolData& poolData = m_memoryPools[allocationInfo.memoryUsage];
-	return poolData;
+	SPT_CHECK(!lib::Contains(m_availableRecordingArenas, &arena));
+
+	// Memory committed by arena stays committed, so it doesn't have to grow again in next frames
+	arena.Reset();
+
+	m_availableRecordingArenas.emplace_back(&arena);
+}
+
+void RenderGraphResourcesPool::RecycleEvents()
+{
+	SPT_PROFILER_FUNCTION();
+
+	// Events acquired since last Prepare were used by graph recorded in last recorded section
+	if (!m_acquiredEvents.empty())
+	{
+		PendingEvents& pendingEvents = m_pendingEvents.emplace_back();
+		pendingEvents.section = m_lastRecordedSection;
+		pendingEvents.events  = std::move(m_acquiredEvents);
+		m_acquiredEvents.clear();
+	}
+
+	const rdr::DeviceQueuesManager& queuesManager = rdr::GPUApi::GetDeviceQueuesManager();
+
+	// Sections are executed in order, so we can stop at first section that is still executed
+	const auto firstInFlight = std::find_if(std::begin(m_pendingEvents), std::end(m_pendingEvents),
+											[&queuesManager](const PendingEvents& pendingEvents) { return !queuesManager.IsExecuted(pendingEvents.section); });
+
+	for (auto it = std::begin(m_pendingEvents); it != firstInFlight; ++it)
+	{
+		std::move(std::begin(it->events), std::end(it->events), std::back_inserter(m_availableEvents));
+	}
+
+	m_pendingEvents.erase(std::begin(m_pendingEvents), firstInFlight);
+}
+
+void RenderGraphResourcesPool::ReleaseCachedTextures(MemoryPoolData& poolData)
+{
+	SPT_CHECK(poolData.texturesInUse.empty());
+
+	for (auto& [key, textures] : poolData.cachedTextures)
+	{
+		for (CachedTexture& cachedTexture : textures)
+		{
+			cachedTexture.texture->ReleasePlacedAllocation();
+		}
+	}
+
+	poolData.cachedTextures.clear();
 }
 
 void RenderGraphResourcesPool::DestroyResources()
 {
+	for (auto& [memoryUsage, poolData] : m_memoryPools)
+	{
+		ReleaseCachedTextures(poolData);
+	}
+
 	m_memoryPools.clear();
+
+	m_availableEvents.clear();
+	m_acquiredEvents.clear();
+	m_pendingEvents.clear();
+
+	SPT_CHECK_MSG(m_availableRecordingArenas.size() == m_recordingArenas.size(), "Recording arenas are still used by render graph");
+	m_availableRecordingArenas.clear();
+	m_recordingArenas.clear();
 }
 
 } // spt::rg
@@ -11,6 +11,7 @@
 namespace spt::rdr
 {
 class Buffer;
+class GPUEvent;
 } // spt::rdr
 
 
@@ -22,34 +23,122 @@ class RENDER_GRAPH_API RenderGraphResourcesPool
 public:
 
 	RenderGraphResourcesPool();
+	~RenderGraphResourcesPool();
 
 	void Prepare();
 
-	lib::SharedPtr<rdr::Texture> AcquireTexture(const RenderGraphDebugName& name, const rhi::TextureDefinition& definition, const rhi::RHIAllocationInfo& allocationInfo);
+	/** Returns memory requirements of texture with given definition. Results are cached, so this is cheap for definitions that were already used */
+	rhi::RHIMemoryRequirements GetTextureMemoryRequirements(const rhi::TextureDefinition& definition);
+
+	/**
+	 * Makes sure that transient memory pool for given memory usage can contain requiredSize bytes.
+	 * Must be called before any texture with this memory usage is acquired from the pool in current frame, as pool may be recreated
+	 */
+	void ReserveTransientMemory(rhi::EMemoryUsage memoryUsage, Uint64 requiredSize);
+
+	/**
+	 * Acquires texture for render graph.
+	 * If transientMemoryOffset is valid, texture is placed at this offset in transient memory pool and texture object may be reused from previous frames
+	 * Otherwise texture uses committed allocation
+	 */
+	lib::SharedPtr<rdr::Texture> AcquireTexture(const RenderGraphDebugName& name, const rhi::TextureDefinition& definition, const rhi::RHIAllocationInfo& allocationInfo, Uint64 transientMemoryOffset);
 	void ReleaseTexture(lib::SharedPtr<rdr::Texture> texture);
 
+	/** Number of textures that were placed in transient memory, but placement failed and committed allocation was used instead */
+	Uint32 GetFallbackAllocationsNum() const { return m_fallbackAllocationsNum; }
+
+	/** Number of textures that were reused from previous frames in current frame */
+	Uint32 GetReusedTexturesNum() const { return m_reusedTexturesNum; }
+
 	rdr::ConstantsAllocator& GetConstantsAllocator() { return m_constantsAllocators[m_constantsAllocatorIdx]; }
 
+	/**
+	 * Returns GPU only event for split barrier. Events are reused after GPU finished execution of graph that used them.
+	 * Event must be reset on GPU after it was waited
+	 */
+	lib::SharedRef<rdr::GPUEvent> AcquireSplitBarrierEvent();
+
+	/** Returns arena for recording single range of graph nodes. Arenas are reused between frames, so their memory is reserved only once */
+	lib::MemoryArena& AcquireRecordingArena();
+
+	/** Resets arena and makes it available for next acquire. Memory allocated from arena must not be used after it's released */
+	void ReleaseRecordingArena(lib::MemoryArena& arena);
+
 private:
 
+	struct CachedTexture
+	{
+		lib::SharedPtr<rdr::Texture> texture;
+
+		Bool isInUse               = false;
+		Bool wasUsedInCurrentFrame = false;
+	};
+
+	struct PlacedTextureKey
+	{
+		rhi::TextureDefinition definition;
+		Uint64                 offset = 0u;
+
+		Bool operator==(const PlacedTextureKey& rhs) const = default;
+	};
+
+	struct PlacedTextureKeyHasher
+	{
+		SizeType operator()(const PlacedTextureKey& key) const
+		{
+			return lib::HashCombine(lib::GetHash(key.definition), key.offset);
+		}
+	};
+
 	struct MemoryPoolData
 	{
 		lib::SharedPtr<rdr::GPUMemoryPool> memoryPool;
 
-		Uint64 currentMemoryUsage = 0u;
-		Uint64 maxMemoryUsage     = 0u;
+		/** Textures placed in this pool, keyed by definition and offset. Textures cannot be rebound to other memory, so we cache them with placement */
+		lib::HashMap<PlacedTextureKey, lib::DynamicArray<CachedTexture>, PlacedTextureKeyHasher> cachedTextures;
+
+		/** Cache keys of textures that are currently acquired */
+		lib::HashMap<const rdr::Texture*, PlacedTextureKey> texturesInUse;
 	};
 
-	MemoryPoolData& GetMemoryPoolData(const rhi::RHIAllocationInfo& allocationInfo);
+	struct PendingEvents
+	{
+		rdr::GPUTimelineSection                          section;
+		lib::DynamicArray<lib::SharedRef<rdr::GPUEvent>> events;
+	};
+
+	void ReleaseCachedTextures(MemoryPoolData& poolData);
+
+	void RecycleEvents();
 
 	void DestroyResources();
 
 	lib::HashMap<rhi::EMemoryUsage, MemoryPoolData> m_memoryPools;
 
+	lib::HashMap<rhi::TextureDefinition, rhi::RHIMemoryRequirements> m_memoryRequirementsCache;
+
+	Uint32 m_fallbackAllocationsNum = 0u;
+	Uint32 m_reusedTexturesNum      = 0u;
+
+	/** Events that can be acquired */
+	lib::DynamicArray<lib::SharedRef<rdr::GPUEvent>> m_availableEvents;
+
+	/** Events acquired in current frame */
+	lib::DynamicArray<lib::SharedRef<rdr::GPUEvent>> m_acquiredEvents;
+
+	/** Events used by frames that are still executed on GPU */
+	lib::DynamicArray<PendingEvents> m_pendingEvents;
+
 	rdr::ConstantsAllocator m_constantsAllocators[2];
 	Uint32 m_constantsAllocatorIdx = 0u;
 
 	rdr::GPUTimelineSection m_lastRecordedSection = {};
+
+	/** All arenas created for recording ranges */
+	lib::DynamicArray<lib::UniquePtr<lib::MemoryArena>> m_recordingArenas;
+
+	/** Arenas that are not used by any graph */
+	lib::DynamicArray<lib::MemoryArena*> m_availableRecordingArenas;
 };
 
 } // spt::rg
@@ -3,6 +3,7 @@
 #include "SculptorCoreTypes.h"
 #include "RHI/RHICore/RHIPipelineTypes.h"
 #include "Types/Texture.h"
+#include "RGDiagnostics.h"
 
 
 namespace spt::rg::capture
@@ -137,6 +138,8 @@ struct RGCapture
 	lib::HashMap<Uint32, CapturedTexture*> descriptorIdxToTexture;
 	lib::HashMap<Uint32, CapturedBuffer*>  descriptorIdxToBuffer;
 
+	RGCompilationStatistics compilationStatistics;
+
 	Bool wantsClose = false;
 };
 
@@ -411,6 +411,8 @@ void RenderGraphCaptureViewer::DrawNodesList(const RGCapture& capture)
 
 	m_nodesListFilter.Draw();
 
+	DrawCompilationStatistics(capture.compilationStatistics);
+
 	ImGui::Dummy(ImVec2(0.f, 30.f));
 
 	ImGui::BeginChild("Nodes", ImVec2{}, true);
@@ -507,4 +509,13 @@ void RenderGraphCaptureViewer::DrawNodesList(const RGCapture& capture)
 	ImGui::End();
 }
 
+void RenderGraphCaptureViewer::DrawCompilationStatistics(const RGCompilationStatistics& statistics)
+{
+	ImGui::Text("Nodes: %u (culled: %u)", statistics.nodesNum, static_cast<Uint32>(statistics.culledNodes.size()));
+	ImGui::Text("Barriers before planning: %u transitions in %u batches", statistics.incrementalTransitionsNum, statistics.incrementalBarrierBatchesNum);
+	ImGui::Text("Barriers after planning: %u transitions in %u batches (%u split barriers)", statistics.plannedTransitionsNum, statistics.plannedBarrierBatchesNum, statistics.splitBarriersNum);
+	ImGui::Text("Dropped read to read transitions: %u", statistics.droppedReadToReadTransitionsNum);
+	ImGui::Text("Transient memory: %llu bytes (without aliasing: %llu bytes)", statistics.transientMemorySize, statistics.nonAliasedTransientMemorySize);
+}
+
 } // spt::rg::capture
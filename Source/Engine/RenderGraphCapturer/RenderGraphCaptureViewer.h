@@ -15,6 +15,12 @@ class TextureView;
 } // spt::rdr
 
 
+namespace spt::rg
+{
+struct RGCompilationStatistics;
+} // spt::rg
+
+
 namespace spt::rg::capture
 {
 
@@ -95,6 +101,7 @@ public:
 private:
 
 	void DrawNodesList(const RGCapture& capture);
+	void DrawCompilationStatistics(const RGCompilationStatistics& statistics);
 
 	lib::HashedString m_nodesListPanelName;
 
@@ -26,6 +26,7 @@ public:
 	// Begin RenderGraphDebugDecorator interface
 	virtual void PostNodeAdded(RenderGraphBuilder& graphBuilder, RGNode& node, const RGDependeciesContainer& dependencies) override;
 	virtual void PostSubpassAdded(RenderGraphBuilder& graphBuilder, RGNode& node, const RGDependeciesContainer& dependencies) override;
+	virtual void PostGraphCompiled(RenderGraphBuilder& graphBuilder) override;
 	// End RenderGraphDebugDecorator interface
 
 	const lib::SharedRef<RGCapture>& GetCapture() const;
@@ -123,6 +124,11 @@ void RGCapturerDecorator::PostSubpassAdded(RenderGraphBuilder& graphBuilder, RGN
 	AddDependenciesToPass(graphBuilder, pass, dependencies);
 }
 
+void RGCapturerDecorator::PostGraphCompiled(RenderGraphBuilder& graphBuilder)
+{
+	m_capture->compilationStatistics = graphBuilder.GetCompilationStatistics();
+}
+
 void RGCapturerDecorator::AddDependenciesToPass(RenderGraphBuilder& graphBuilder, CapturedPass& pass, const RGDependeciesContainer& dependencies)
 {
 	if (m_captureParams.captureTextures)
@@ -0,0 +1,248 @@
+#include "gtest/gtest.h"
+#include "RGCompilation.h"
+
+namespace spt::rg::tests
+{
+
+namespace utils
+{
+
+static Bool Overlaps(const RGTransientAllocationRequest& lhs, Uint64 lhsOffset, const RGTransientAllocationRequest& rhs, Uint64 rhsOffset)
+{
+	const Bool lifetimesOverlap = lhs.firstNodeIdx <= rhs.lastNodeIdx && rhs.firstNodeIdx <= lhs.lastNodeIdx;
+	const Bool memoryOverlaps   = lhsOffset < rhsOffset + rhs.size && rhsOffset < lhsOffset + lhs.size;
+	return lifetimesOverlap && memoryOverlaps;
+}
+
+} // utils
+
+
+TEST(RGCompilationTest, NodesWritingObservableResourcesAreAlive)
+{
+	// Resource 0 is observable, resource 1 is transient
+	const lib::DynamicArray<Bool> observableResources = { true, false };
+
+	const RGCompilationResourceAccess writeTransient[]               = { { 1u, true } };
+	const RGCompilationResourceAccess readTransientWriteObservable[] = { { 1u, false }, { 0u, true } };
+
+	const RGCompilationNode nodes[] =
+	{
+		RGCompilationNode{ writeTransient },
+		RGCompilationNode{ readTransientWriteObservable }
+	};
+
+	const lib::DynamicArray<Bool> aliveNodes = ComputeAliveNodes(nodes, observableResources);
+
+	EXPECT_TRUE(aliveNodes[0]);
+	EXPECT_TRUE(aliveNodes[1]);
+}
+
+
+TEST(RGCompilationTest, NodesWithUnusedOutputsAreCulled)
+{
+	const lib::DynamicArray<Bool> observableResources = { true, false, false };
+
+	const RGCompilationResourceAccess writeFirst[]           = { { 1u, true } };
+	const RGCompilationResourceAccess readFirstWriteSecond[] = { { 1u, false }, { 2u, true } };
+	const RGCompilationResourceAccess writeObservable[]      = { { 0u, true } };
+
+	const RGCompilationNode nodes[] =
+	{
+		RGCompilationNode{ writeFirst },
+		RGCompilationNode{ readFirstWriteSecond },
+		RGCompilationNode{ writeObservable }
+	};
+
+	const lib::DynamicArray<Bool> aliveNodes = ComputeAliveNodes(nodes, observableResources);
+
+	EXPECT_FALSE(aliveNodes[0]);
+	EXPECT_FALSE(aliveNodes[1]);
+	EXPECT_TRUE(aliveNodes[2]);
+}
+
+
+TEST(RGCompilationTest, NodesWithSideEffectsOrWithoutWritesAreAlive)
+{
+	const lib::DynamicArray<Bool> observableResources = { false, false };
+
+	const RGCompilationResourceAccess writeFirst[]  = { { 0u, true } };
+	const RGCompilationResourceAccess writeSecond[] = { { 1u, true } };
+	const RGCompilationResourceAccess readFirst[]   = { { 0u, false } };
+
+	const RGCompilationNode nodes[] =
+	{
+		RGCompilationNode{ writeFirst },
+		RGCompilationNode{ writeSecond, true },
+		RGCompilationNode{ readFirst }
+	};
+
+	const lib::DynamicArray<Bool> aliveNodes = ComputeAliveNodes(nodes, observableResources);
+
+	// First node is alive, because its output is read by node without tracked writes
+	EXPECT_TRUE(aliveNodes[0]);
+	EXPECT_TRUE(aliveNodes[1]);
+	EXPECT_TRUE(aliveNodes[2]);
+}
+
+
+TEST(RGCompilationTest, DisjointLifetimesAlias)
+{
+	const RGTransientAllocationRequest requests[] =
+	{
+		RGTransientAllocationRequest{ 0u, 1u, 1024u, 256u },
+		RGTransientAllocationRequest{ 2u, 3u, 1024u, 256u },
+		RGTransientAllocationRequest{ 4u, 5u, 512u, 256u }
+	};
+
+	const RGTransientMemoryPlacement placement = PlaceTransientAllocations(requests);
+
+	EXPECT_EQ(placement.requiredMemorySize, 1024u);
+	EXPECT_EQ(placement.nonAliasedMemorySize, 2560u);
+
+	for (const Uint64 offset : placement.offsets)
+	{
+		EXPECT_EQ(offset, 0u);
+	}
+}
+
+
+TEST(RGCompilationTest, OverlappingLifetimesDontAlias)
+{
+	const RGTransientAllocationRequest requests[] =
+	{
+		RGTransientAllocationRequest{ 0u, 4u, 1000u, 256u },
+		RGTransientAllocationRequest{ 1u, 2u, 300u, 512u },
+		RGTransientAllocationRequest{ 2u, 6u, 2000u, 1024u },
+		RGTransientAllocationRequest{ 3u, 5u, 100u, 64u },
+		RGTransientAllocationRequest{ 5u, 7u, 700u, 256u }
+	};
+
+	const RGTransientMemoryPlacement placement = PlaceTransientAllocations(requests);
+
+	ASSERT_EQ(placement.offsets.size(), std::size(requests));
+
+	for (SizeType lhsIdx = 0u; lhsIdx < std::size(requests); ++lhsIdx)
+	{
+		EXPECT_EQ(placement.offsets[lhsIdx] % requests[lhsIdx].alignment, 0u);
+		EXPECT_LE(placement.offsets[lhsIdx] + requests[lhsIdx].size, placement.requiredMemorySize);
+
+		for (SizeType rhsIdx = lhsIdx + 1u; rhsIdx < std::size(requests); ++rhsIdx)
+		{
+			EXPECT_FALSE(utils::Overlaps(requests[lhsIdx], placement.offsets[lhsIdx], requests[rhsIdx], placement.offsets[rhsIdx]));
+		}
+	}
+
+	EXPECT_LT(placement.requiredMemorySize, placement.nonAliasedMemorySize);
+}
+
+
+TEST(RGCompilationTest, ReadsAfterWriteShareSingleDependency)
+{
+	const RGSynchronizationAccess writeNodeAccesses[] = { RGSynchronizationAccess{ 0u, rhi::EPipelineStage::ComputeShader, lib::Flags(rhi::EAccessType::Read, rhi::EAccessType::Write) } };
+	const RGSynchronizationAccess firstReadAccesses[] = { RGSynchronizationAccess{ 0u, rhi::EPipelineStage::FragmentShader, rhi::EAccessType::Read } };
+	const RGSynchronizationAccess secondReadAccesses[] = { RGSynchronizationAccess{ 0u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Read } };
+	const RGSynchronizationAccess thirdReadAccesses[] = { RGSynchronizationAccess{ 0u, rhi::EPipelineStage::FragmentShader, rhi::EAccessType::Read } };
+
+	const RGSynchronizationNode nodes[] =
+	{
+		RGSynchronizationNode{ writeNodeAccesses },
+		RGSynchronizationNode{ firstReadAccesses },
+		RGSynchronizationNode{ secondReadAccesses },
+		RGSynchronizationNode{ thirdReadAccesses }
+	};
+
+	const RGResourceInitialAccess initialAccesses[] = { RGResourceInitialAccess{} };
+
+	const RGBarriersPlan plan = PlanBarriers(nodes, initialAccesses);
+
+	ASSERT_EQ(plan.dependencies.size(), 2u);
+	EXPECT_EQ(plan.dependencies[0].sourceNodeIdx, 0u);
+	EXPECT_EQ(plan.dependencies[0].destNodeIdx, 1u);
+	EXPECT_EQ(plan.dependencies[1].sourceNodeIdx, 0u);
+	EXPECT_EQ(plan.dependencies[1].destNodeIdx, 2u);
+
+	// Last read is done in stage that already waited for the write
+	EXPECT_EQ(plan.droppedReadToReadNum, 1u);
+}
+
+
+TEST(RGCompilationTest, WriteAfterReadsWaitsForAllReadStages)
+{
+	const RGSynchronizationAccess writeAccesses[] = { RGSynchronizationAccess{ 0u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Write } };
+	const RGSynchronizationAccess fragmentReadAccesses[] = { RGSynchronizationAccess{ 0u, rhi::EPipelineStage::FragmentShader, rhi::EAccessType::Read } };
+	const RGSynchronizationAccess computeReadAccesses[] = { RGSynchronizationAccess{ 0u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Read } };
+
+	const RGSynchronizationNode nodes[] =
+	{
+		RGSynchronizationNode{ writeAccesses },
+		RGSynchronizationNode{ fragmentReadAccesses },
+		RGSynchronizationNode{ computeReadAccesses },
+		RGSynchronizationNode{ writeAccesses }
+	};
+
+	const RGResourceInitialAccess initialAccesses[] = { RGResourceInitialAccess{} };
+
+	const RGBarriersPlan plan = PlanBarriers(nodes, initialAccesses);
+
+	ASSERT_EQ(plan.dependencies.size(), 3u);
+
+	const RGPlannedDependency& writeAfterRead = plan.dependencies[2];
+	EXPECT_EQ(writeAfterRead.sourceNodeIdx, 2u);
+	EXPECT_EQ(writeAfterRead.destNodeIdx, 3u);
+	EXPECT_TRUE(lib::HasAllFlags(writeAfterRead.sourceStage, lib::Flags(rhi::EPipelineStage::FragmentShader, rhi::EPipelineStage::ComputeShader)));
+	EXPECT_EQ(writeAfterRead.sourceAccess, rhi::EAccessType::None);
+}
+
+
+TEST(RGCompilationTest, AccessesToManyResourcesAreMergedPerSourceNode)
+{
+	const RGSynchronizationAccess producerAccesses[] =
+	{
+		RGSynchronizationAccess{ 0u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Write },
+		RGSynchronizationAccess{ 1u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Write },
+		RGSynchronizationAccess{ 2u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Write }
+	};
+	const RGSynchronizationAccess consumerAccesses[] =
+	{
+		RGSynchronizationAccess{ 2u, rhi::EPipelineStage::FragmentShader, rhi::EAccessType::Read },
+		RGSynchronizationAccess{ 0u, rhi::EPipelineStage::FragmentShader, rhi::EAccessType::Read },
+		RGSynchronizationAccess{ 1u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Read },
+		RGSynchronizationAccess{ 3u, rhi::EPipelineStage::ComputeShader, rhi::EAccessType::Read }
+	};
+
+	const RGSynchronizationNode nodes[] =
+	{
+		RGSynchronizationNode{ producerAccesses },
+		RGSynchronizationNode{ consumerAccesses }
+	};
+
+	const RGResourceInitialAccess initialAccesses[] =
+	{
+		RGResourceInitialAccess{},
+		RGResourceInitialAccess{},
+		RGResourceInitialAccess{},
+		RGResourceInitialAccess{ rhi::EPipelineStage::Transfer, rhi::EAccessType::Write }
+	};
+
+	const RGBarriersPlan plan = PlanBarriers(nodes, initialAccesses);
+
+	// Resource 3 was written before the graph
+	ASSERT_EQ(plan.dependencies.size(), 2u);
+
+	const RGPlannedDependency& fromProducer = plan.dependencies[0].sourceNodeIdx == 0u ? plan.dependencies[0] : plan.dependencies[1];
+	const RGPlannedDependency& fromInitial  = plan.dependencies[0].sourceNodeIdx == 0u ? plan.dependencies[1] : plan.dependencies[0];
+
+	EXPECT_EQ(fromProducer.destNodeIdx, 1u);
+	EXPECT_EQ(fromProducer.destStage, lib::Flags(rhi::EPipelineStage::FragmentShader, rhi::EPipelineStage::ComputeShader));
+	EXPECT_EQ(fromInitial.sourceNodeIdx, idxNone<Uint32>);
+	EXPECT_EQ(fromInitial.sourceStage, rhi::EPipelineStage::Transfer);
+}
+
+} // spt::rg::tests
+
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,8 @@
+RenderGraphTests = Project:CreateProject("RenderGraphTests", ETargetType.Application)
+
+function RenderGraphTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("RenderGraph")
+    self:AddPrivateDependency("GoogleTest")
+end
+
+RenderGraphTests:SetupProject()
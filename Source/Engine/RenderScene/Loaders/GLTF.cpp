@@ -1,5 +1,6 @@
 #include "GLTF.h"
 #include "Paths.h"
+#include "FileSystem/MappedFile.h"
 
 
 namespace spt::rsc
@@ -22,8 +23,22 @@ std::optional<GLTFModel> LoadGLTFModel(const lib::String& path)
 
 	const Bool isBinary = fileExtension == ".glb";
 
-	const Bool loaded = isBinary ? loader.LoadBinaryFromFile(&model, &error, &warning, path)
-								 : loader.LoadASCIIFromFile(&model, &error, &warning, path);
+	Bool loaded = false;
+
+	if (isBinary)
+	{
+		// Parse binary file directly from mapped memory to avoid reading whole file to temporary buffer
+		lib::MappedFile file;
+		if (file.Open(path))
+		{
+			const lib::String baseDirectory = lib::Path(path).parent_path().generic_string();
+			loaded = loader.LoadBinaryFromMemory(&model, &error, &warning, reinterpret_cast<const unsigned char*>(file.GetData().data()), static_cast<unsigned int>(file.GetSize()), baseDirectory);
+		}
+	}
+	else
+	{
+		loaded = loader.LoadASCIIFromFile(&model, &error, &warning, path);
+	}
 
 	return loaded ? std::optional<GLTFModel>(std::move(model)) : std::nullopt;
 }
@@ -0,0 +1,411 @@
+#include "GLTFGeometry.h"
+#include "Utility/Base64.h"
+
+#include "nlohmann/json.hpp"
+
+
+namespace spt::rsc
+{
+
+SPT_DEFINE_LOG_CATEGORY(GLTFLoader, true);
+
+namespace priv
+{
+
+static constexpr Uint32 glbMagic         = 0x46546C67u; // "glTF"
+static constexpr Uint32 glbVersion       = 2u;
+static constexpr Uint32 glbChunkTypeJSON = 0x4E4F534Au; // "JSON"
+static constexpr Uint32 glbChunkTypeBIN  = 0x004E4942u; // "BIN"
+
+static constexpr Int32 primitiveModeTriangles = 4;
+
+
+struct GLBHeader
+{
+	Uint32 magic;
+	Uint32 version;
+	Uint32 length;
+};
+
+
+struct GLBChunkHeader
+{
+	Uint32 length;
+	Uint32 type;
+};
+
+
+struct GLBChunks
+{
+	lib::Span<const Byte> json;
+	lib::Span<const Byte> bin;
+};
+
+
+static std::optional<GLBChunks> ParseGLBChunks(lib::Span<const Byte> data)
+{
+	GLBHeader header{};
+	if (data.size() < sizeof(GLBHeader))
+	{
+		return std::nullopt;
+	}
+
+	std::memcpy(&header, data.data(), sizeof(GLBHeader));
+
+	if (header.magic != glbMagic || header.version != glbVersion || header.length > data.size())
+	{
+		return std::nullopt;
+	}
+
+	GLBChunks chunks;
+
+	SizeType offset = sizeof(GLBHeader);
+	while (offset + sizeof(GLBChunkHeader) <= header.length)
+	{
+		GLBChunkHeader chunkHeader{};
+		std::memcpy(&chunkHeader, data.data() + offset, sizeof(GLBChunkHeader));
+		offset += sizeof(GLBChunkHeader);
+
+		if (offset + chunkHeader.length > header.length)
+		{
+			return std::nullopt;
+		}
+
+		const lib::Span<const Byte> chunkData = data.subspan(offset, chunkHeader.length);
+
+		// First JSON and BIN chunks are used, other chunks must be ignored
+		if (chunkHeader.type == glbChunkTypeJSON && chunks.json.empty())
+		{
+			chunks.json = chunkData;
+		}
+		else if (chunkHeader.type == glbChunkTypeBIN && chunks.bin.empty())
+		{
+			chunks.bin = chunkData;
+		}
+
+		offset += chunkHeader.length;
+	}
+
+	if (chunks.json.empty())
+	{
+		return std::nullopt;
+	}
+
+	return chunks;
+}
+
+
+static Uint32 GetComponentsNum(const lib::String& type)
+{
+	if (type == "SCALAR") { return 1u; }
+	if (type == "VEC2")   { return 2u; }
+	if (type == "VEC3")   { return 3u; }
+	if (type == "VEC4")   { return 4u; }
+	if (type == "MAT2")   { return 4u; }
+	if (type == "MAT3")   { return 9u; }
+	if (type == "MAT4")   { return 16u; }
+
+	return 0u;
+}
+
+
+static Uint32 GetComponentSize(EGLTFComponentType componentType)
+{
+	switch (componentType)
+	{
+	case EGLTFComponentType::Byte:
+	case EGLTFComponentType::UnsignedByte:
+		return 1u;
+	case EGLTFComponentType::Short:
+	case EGLTFComponentType::UnsignedShort:
+		return 2u;
+	case EGLTFComponentType::UnsignedInt:
+	case EGLTFComponentType::Float:
+		return 4u;
+	default:
+		return 0u;
+	}
+}
+
+
+/** Decodes percent-encoded characters (e.g. spaces in file names) */
+static lib::String DecodeURI(const lib::String& uri)
+{
+	lib::String decoded;
+	decoded.reserve(uri.size());
+
+	for (SizeType idx = 0u; idx < uri.size(); ++idx)
+	{
+		if (uri[idx] == '%' && idx + 2u < uri.size() && std::isxdigit(static_cast<unsigned char>(uri[idx + 1u])) && std::isxdigit(static_cast<unsigned char>(uri[idx + 2u])))
+		{
+			decoded += static_cast<char>(std::stoi(uri.substr(idx + 1u, 2u), nullptr, 16));
+			idx += 2u;
+		}
+		else
+		{
+			decoded += uri[idx];
+		}
+	}
+
+	return decoded;
+}
+
+
+struct BufferViewData
+{
+	lib::Span<const Byte> data;
+	Uint32                stride = 0u;
+};
+
+
+template<typename TType>
+static TType GetValue(const nlohmann::json& object, const char* name, TType defaultValue)
+{
+	const auto it = object.find(name);
+	return it != object.end() && it->is_number() ? it->get<TType>() : defaultValue;
+}
+
+
+static GLTFAccessorView GetAccessorView(const lib::DynamicArray<GLTFAccessorView>& accessors, const nlohmann::json& object, const char* name)
+{
+	const Int32 accessorIdx = GetValue<Int32>(object, name, -1);
+	return accessorIdx >= 0 && accessorIdx < static_cast<Int32>(accessors.size()) ? accessors[accessorIdx] : GLTFAccessorView{};
+}
+
+} // priv
+
+Bool GLTFGeometry::LoadFromFile(const lib::Path& path)
+{
+	SPT_PROFILER_FUNCTION();
+
+	*this = GLTFGeometry();
+
+	lib::MappedFile file;
+	if (!file.Open(path))
+	{
+		SPT_LOG_ERROR(GLTFLoader, "Failed to open file '{}'", path.generic_string());
+		return false;
+	}
+
+	lib::Span<const Byte> jsonData = file.GetData();
+	lib::Span<const Byte> binChunk;
+
+	if (path.extension() == ".glb")
+	{
+		const std::optional<priv::GLBChunks> chunks = priv::ParseGLBChunks(file.GetData());
+		if (!chunks)
+		{
+			SPT_LOG_ERROR(GLTFLoader, "'{}' is not valid binary glTF file", path.generic_string());
+			return false;
+		}
+
+		jsonData = chunks->json;
+		binChunk = chunks->bin;
+	}
+
+	const char* jsonBegin = reinterpret_cast<const char*>(jsonData.data());
+	const nlohmann::json document = nlohmann::json::parse(jsonBegin, jsonBegin + jsonData.size(), nullptr, false);
+	if (document.is_discarded() || !document.is_object())
+	{
+		SPT_LOG_ERROR(GLTFLoader, "Failed to parse glTF document '{}'", path.generic_string());
+		return false;
+	}
+
+	m_mappedFiles.emplace_back(std::move(file));
+
+	const nlohmann::json emptyArray  = nlohmann::json::array();
+	const nlohmann::json emptyObject = nlohmann::json::object();
+	const auto getArray = [&document, &emptyArray](const char* name) -> const nlohmann::json&
+	{
+		const auto it = document.find(name);
+		return it != document.end() && it->is_array() ? *it : emptyArray;
+	};
+
+	const lib::Path baseDirectory = path.parent_path();
+
+	// Buffers ==================================================================================
+
+	lib::DynamicArray<lib::Span<const Byte>> buffers;
+
+	for (const nlohmann::json& buffer : getArray("buffers"))
+	{
+		const Uint64 byteLength = priv::GetValue<Uint64>(buffer, "byteLength", 0u);
+
+		lib::Span<const Byte> bufferData;
+
+		const auto uriIt = buffer.find("uri");
+		if (uriIt != buffer.end() && uriIt->is_string())
+		{
+			bufferData = LoadBuffer(baseDirectory, uriIt->get<lib::String>());
+		}
+		else if (buffers.empty())
+		{
+			// Only first buffer of binary glTF can reference BIN chunk
+			bufferData = binChunk;
+		}
+
+		if (bufferData.size() < byteLength)
+		{
+			SPT_LOG_ERROR(GLTFLoader, "Failed to load buffer {} of '{}'", buffers.size(), path.generic_string());
+			return false;
+		}
+
+		buffers.emplace_back(bufferData.first(byteLength));
+	}
+
+	// Buffer Views =============================================================================
+
+	lib::DynamicArray<priv::BufferViewData> bufferViews;
+
+	for (const nlohmann::json& bufferView : getArray("bufferViews"))
+	{
+		const Int32  bufferIdx  = priv::GetValue<Int32>(bufferView, "buffer", -1);
+		const Uint64 byteOffset = priv::GetValue<Uint64>(bufferView, "byteOffset", 0u);
+		const Uint64 byteLength = priv::GetValue<Uint64>(bufferView, "byteLength", 0u);
+
+		if (bufferIdx < 0 || bufferIdx >= static_cast<Int32>(buffers.size()) || byteOffset + byteLength > buffers[bufferIdx].size())
+		{
+			SPT_LOG_ERROR(GLTFLoader, "Buffer view {} of '{}' is out of buffer bounds", bufferViews.size(), path.generic_string());
+			return false;
+		}
+
+		priv::BufferViewData& viewData = bufferViews.emplace_back();
+		viewData.data   = buffers[bufferIdx].subspan(byteOffset, byteLength);
+		viewData.stride = priv::GetValue<Uint32>(bufferView, "byteStride", 0u);
+	}
+
+	// Accessors ================================================================================
+
+	lib::DynamicArray<GLTFAccessorView> accessors;
+	accessors.reserve(getArray("accessors").size());
+
+	for (const nlohmann::json& accessor : getArray("accessors"))
+	{
+		GLTFAccessorView& accessorView = accessors.emplace_back();
+
+		const Int32 bufferViewIdx = priv::GetValue<Int32>(accessor, "bufferView", -1);
+
+		// Accessors without buffer view (all zeros) and sparse accessors are not used by meshes in practice, so they are left invalid
+		if (bufferViewIdx < 0 || bufferViewIdx >= static_cast<Int32>(bufferViews.size()) || accessor.contains("sparse"))
+		{
+			continue;
+		}
+
+		const auto typeIt = accessor.find("type");
+
+		const EGLTFComponentType componentType = static_cast<EGLTFComponentType>(priv::GetValue<Uint32>(accessor, "componentType", 0u));
+		const Uint32 componentSize = priv::GetComponentSize(componentType);
+		const Uint32 componentsNum = typeIt != accessor.end() && typeIt->is_string() ? priv::GetComponentsNum(typeIt->get<lib::String>()) : 0u;
+
+		if (componentSize == 0u || componentsNum == 0u)
+		{
+			SPT_LOG_ERROR(GLTFLoader, "Accessor {} of '{}' has invalid type", accessors.size() - 1u, path.generic_string());
+			return false;
+		}
+
+		const priv::BufferViewData& bufferView = bufferViews[bufferViewIdx];
+
+		const Uint32 elementSize = componentSize * componentsNum;
+		const Uint32 stride      = bufferView.stride != 0u ? bufferView.stride : elementSize;
+		const Uint64 byteOffset  = priv::GetValue<Uint64>(accessor, "byteOffset", 0u);
+		const Uint32 count       = priv::GetValue<Uint32>(accessor, "count", 0u);
+
+		const Uint64 requiredSize = count > 0u ? byteOffset + static_cast<Uint64>(stride) * (count - 1u) + elementSize : byteOffset;
+		if (requiredSize > bufferView.data.size())
+		{
+			SPT_LOG_ERROR(GLTFLoader, "Accessor {} of '{}' is out of buffer view bounds", accessors.size() - 1u, path.generic_string());
+			return false;
+		}
+
+		accessorView.data          = bufferView.data.data() + byteOffset;
+		accessorView.count         = count;
+		accessorView.componentsNum = componentsNum;
+		accessorView.componentType = componentType;
+		accessorView.stride        = stride;
+
+		const auto normalizedIt = accessor.find("normalized");
+		accessorView.normalized = normalizedIt != accessor.end() && normalizedIt->is_boolean() && normalizedIt->get<Bool>();
+	}
+
+	// Meshes ===================================================================================
+
+	const nlohmann::json& meshes = getArray("meshes");
+	m_meshes.reserve(meshes.size());
+
+	for (const nlohmann::json& mesh : meshes)
+	{
+		GLTFMeshGeometry& meshGeometry = m_meshes.emplace_back();
+
+		const auto nameIt = mesh.find("name");
+		if (nameIt != mesh.end() && nameIt->is_string())
+		{
+			meshGeometry.name = nameIt->get<lib::String>();
+		}
+
+		const auto primitivesIt = mesh.find("primitives");
+		if (primitivesIt == mesh.end() || !primitivesIt->is_array())
+		{
+			continue;
+		}
+
+		meshGeometry.primitives.reserve(primitivesIt->size());
+
+		for (const nlohmann::json& primitive : *primitivesIt)
+		{
+			if (priv::GetValue<Int32>(primitive, "mode", priv::primitiveModeTriangles) != priv::primitiveModeTriangles)
+			{
+				SPT_LOG_WARN(GLTFLoader, "Skipping non-triangle primitive of mesh '{}' in '{}'", meshGeometry.name, path.generic_string());
+				continue;
+			}
+
+			const auto attributesIt = primitive.find("attributes");
+			const nlohmann::json& attributes = attributesIt != primitive.end() && attributesIt->is_object() ? *attributesIt : emptyObject;
+
+			GLTFPrimitiveGeometry& primitiveGeometry = meshGeometry.primitives.emplace_back();
+			primitiveGeometry.material  = priv::GetValue<Int32>(primitive, "material", -1);
+			primitiveGeometry.indices   = priv::GetAccessorView(accessors, primitive, "indices");
+			primitiveGeometry.locations = priv::GetAccessorView(accessors, attributes, "POSITION");
+			primitiveGeometry.normals   = priv::GetAccessorView(accessors, attributes, "NORMAL");
+			primitiveGeometry.tangents  = priv::GetAccessorView(accessors, attributes, "TANGENT");
+			primitiveGeometry.uvs       = priv::GetAccessorView(accessors, attributes, "TEXCOORD_0");
+		}
+	}
+
+	return true;
+}
+
+lib::Span<const Byte> GLTFGeometry::LoadBuffer(const lib::Path& baseDirectory, const lib::String& uri)
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (uri.starts_with("data:"))
+	{
+		const lib::String base64Marker = ";base64,";
+		const SizeType dataOffset = uri.find(base64Marker);
+		if (dataOffset == lib::String::npos)
+		{
+			return {};
+		}
+
+		const lib::DynamicArray<Byte>& decodedBuffer = m_decodedBuffers.emplace_back(lib::DecodeBase64(uri.substr(dataOffset + base64Marker.size())));
+		return decodedBuffer;
+	}
+
+	lib::MappedFile bufferFile;
+	if (!bufferFile.Open(baseDirectory / priv::DecodeURI(uri)))
+	{
+		return {};
+	}
+
+	return m_mappedFiles.emplace_back(std::move(bufferFile)).GetData();
+}
+
+std::optional<GLTFGeometry> LoadGLTFGeometry(const lib::String& path)
+{
+	SPT_PROFILER_FUNCTION();
+
+	GLTFGeometry geometry;
+	return geometry.LoadFromFile(path) ? std::optional<GLTFGeometry>(std::move(geometry)) : std::nullopt;
+}
+
+} // spt::rsc
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "SculptorCoreTypes.h"
+#include "FileSystem/MappedFile.h"
+
+
+namespace spt::rsc
+{
+
+enum class EGLTFComponentType : Uint32
+{
+	Byte          = 5120,
+	UnsignedByte  = 5121,
+	Short         = 5122,
+	UnsignedShort = 5123,
+	UnsignedInt   = 5125,
+	Float         = 5126
+};
+
+
+namespace priv
+{
+
+template<typename TType>
+constexpr EGLTFComponentType GetGLTFComponentType()
+{
+	if constexpr (std::is_same_v<TType, Int8>)        { return EGLTFComponentType::Byte; }
+	else if constexpr (std::is_same_v<TType, Uint8>)  { return EGLTFComponentType::UnsignedByte; }
+	else if constexpr (std::is_same_v<TType, Int16>)  { return EGLTFComponentType::Short; }
+	else if constexpr (std::is_same_v<TType, Uint16>) { return EGLTFComponentType::UnsignedShort; }
+	else if constexpr (std::is_same_v<TType, Uint32>) { return EGLTFComponentType::UnsignedInt; }
+	else if constexpr (std::is_same_v<TType, Real32>) { return EGLTFComponentType::Float; }
+	else { static_assert(sizeof(TType) == 0, "Unsupported component type"); }
+}
+
+
+template<typename TDestType, typename TSourceType>
+TDestType ConvertGLTFComponent(TSourceType value, Bool normalized)
+{
+	if constexpr (std::is_floating_point_v<TDestType> && std::is_integral_v<TSourceType>)
+	{
+		if (normalized)
+		{
+			// Normalized integers conversion as defined by glTF specification
+			const TDestType normalizedValue = static_cast<TDestType>(value) / static_cast<TDestType>(std::numeric_limits<TSourceType>::max());
+			return std::max(normalizedValue, TDestType(-1));
+		}
+	}
+
+	return static_cast<TDestType>(value);
+}
+
+} // priv
+
+
+/** View of accessor data. Data is not owned by the view, it points directly to mapped (or decoded) buffer */
+struct GLTFAccessorView
+{
+	Bool IsValid() const
+	{
+		return data != nullptr;
+	}
+
+	SizeType GetValuesNum() const
+	{
+		return static_cast<SizeType>(count) * componentsNum;
+	}
+
+	/**
+	 * Returns data as span of TType if accessor elements are tightly packed and stored exactly as TType (no conversion is needed).
+	 * Returns empty span otherwise.
+	 */
+	template<typename TType, typename TComponentType = TType>
+	lib::Span<const TType> TryGetPackedSpan() const
+	{
+		const Bool isPacked = IsValid()
+			&& componentType == priv::GetGLTFComponentType<TComponentType>()
+			&& componentsNum * sizeof(TComponentType) == sizeof(TType)
+			&& stride == sizeof(TType)
+			&& reinterpret_cast<std::uintptr_t>(data) % alignof(TType) == 0u;
+
+		return isPacked ? lib::Span<const TType>(reinterpret_cast<const TType*>(data), count) : lib::Span<const TType>();
+	}
+
+	/** Converts all values to TDestType. outValues must have GetValuesNum() elements */
+	template<typename TDestType>
+	void ReadValues(lib::Span<TDestType> outValues) const
+	{
+		SPT_CHECK(IsValid());
+		SPT_CHECK(outValues.size() == GetValuesNum());
+
+		switch (componentType)
+		{
+		case EGLTFComponentType::Byte:          ReadValuesImpl<TDestType, Int8>(outValues);   break;
+		case EGLTFComponentType::UnsignedByte:  ReadValuesImpl<TDestType, Uint8>(outValues);  break;
+		case EGLTFComponentType::Short:         ReadValuesImpl<TDestType, Int16>(outValues);  break;
+		case EGLTFComponentType::UnsignedShort: ReadValuesImpl<TDestType, Uint16>(outValues); break;
+		case EGLTFComponentType::UnsignedInt:   ReadValuesImpl<TDestType, Uint32>(outValues); break;
+		case EGLTFComponentType::Float:         ReadValuesImpl<TDestType, Real32>(outValues); break;
+		default:
+			SPT_CHECK_NO_ENTRY();
+		}
+	}
+
+	const Byte*        data          = nullptr;
+	Uint32             count         = 0u;
+	Uint32             componentsNum = 0u;
+	EGLTFComponentType componentType = EGLTFComponentType::Float;
+	/** Distance between elements in bytes */
+	Uint32             stride        = 0u;
+	Bool               normalized    = false;
+
+private:
+
+	template<typename TDestType, typename TSourceType>
+	void ReadValuesImpl(lib::Span<TDestType> outValues) const
+	{
+		SizeType valueIdx = 0u;
+
+		for (Uint32 elementIdx = 0u; elementIdx < count; ++elementIdx)
+		{
+			const Byte* elementData = data + static_cast<SizeType>(elementIdx) * stride;
+
+			for (Uint32 componentIdx = 0u; componentIdx < componentsNum; ++componentIdx)
+			{
+				// Data in buffers is not guaranteed to be aligned to component size
+				TSourceType value;
+				std::memcpy(&value, elementData + componentIdx * sizeof(TSourceType), sizeof(TSourceType));
+
+				outValues[valueIdx++] = priv::ConvertGLTFComponent<TDestType>(value, normalized);
+			}
+		}
+	}
+};
+
+
+struct GLTFPrimitiveGeometry
+{
+	Int32 material = -1;
+
+	GLTFAccessorView indices;
+	GLTFAccessorView locations;
+	GLTFAccessorView normals;
+	GLTFAccessorView tangents;
+	GLTFAccessorView uvs;
+};
+
+
+struct GLTFMeshGeometry
+{
+	lib::String                              name;
+	lib::DynamicArray<GLTFPrimitiveGeometry> primitives;
+};
+
+
+/**
+ * Geometry of glTF model (.gltf or .glb).
+ * Binary buffers (.glb BIN chunk and external .bin files) are memory mapped and accessor views point directly to mapped memory, so geometry data is never copied.
+ * Only triangle list primitives are loaded.
+ */
+class GLTFGeometry
+{
+public:
+
+	GLTFGeometry() = default;
+
+	GLTFGeometry(GLTFGeometry&& rhs) = default;
+	GLTFGeometry& operator=(GLTFGeometry&& rhs) = default;
+
+	/** Returns false if file cannot be opened or isn't valid glTF file */
+	Bool LoadFromFile(const lib::Path& path);
+
+	const lib::DynamicArray<GLTFMeshGeometry>& GetMeshes() const
+	{
+		return m_meshes;
+	}
+
+private:
+
+	lib::Span<const Byte> LoadBuffer(const lib::Path& baseDirectory, const lib::String& uri);
+
+	lib::DynamicArray<GLTFMeshGeometry> m_meshes;
+
+	lib::DynamicArray<lib::MappedFile>          m_mappedFiles;
+	/** Buffers embedded as data URIs must be decoded */
+	lib::DynamicArray<lib::DynamicArray<Byte>> m_decodedBuffers;
+};
+
+
+std::optional<GLTFGeometry> LoadGLTFGeometry(const lib::String& path);
+
+} // spt::rsc
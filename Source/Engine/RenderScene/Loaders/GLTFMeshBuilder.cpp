@@ -1,191 +1,198 @@
 #include "GLTFMeshBuilder.h"
 #include "MathUtils.h"
+#include "JobSystem.h"
 
 
 namespace spt::rsc
 {
 
+SPT_DEFINE_LOG_CATEGORY(GLTFMeshBuilder, true);
+
 namespace priv
 {
 
-template<typename TDestType, typename TSourceType>
-void CopyData(lib::Span<TDestType> dst, lib::Span<TSourceType> src)
+/** Primitives are grouped into batches of at least this many vertices, so that small primitives don't create separate jobs */
+static constexpr SizeType minVerticesPerDecodeBatch = 16u * 1024u;
+
+
+struct PrimitivesDecodeBatch
+{
+	SizeType beginIdx = 0u;
+	SizeType endIdx   = 0u;
+};
+
+
+template<typename TType, typename TComponentType>
+static lib::Span<const TType> GetAccessorData(const GLTFAccessorView& accessor, lib::DynamicArray<TType>& storage)
 {
-	SPT_CHECK(dst.size() == src.size());
+	constexpr Uint32 expectedComponentsNum = static_cast<Uint32>(sizeof(TType) / sizeof(TComponentType));
 
-	if constexpr (std::is_same_v<TDestType, TSourceType>)
+	if (!accessor.IsValid() || accessor.componentsNum != expectedComponentsNum)
 	{
-		memcpy(dst.data(), src.data(), src.size() * sizeof(TDestType));
+		return {};
 	}
-	else
+
+	// Source data can be used directly only if it's already stored in the destination format
+	const lib::Span<const TType> packedData = accessor.TryGetPackedSpan<TType, TComponentType>();
+	if (!packedData.empty())
 	{
-		for (SizeType idx = 0; idx < src.size(); ++idx)
-		{
-			dst[idx] = static_cast<TDestType>(src[idx]);
-		}
+		return packedData;
 	}
+
+	storage.resize(accessor.count);
+	accessor.ReadValues(lib::Span<TComponentType>(reinterpret_cast<TComponentType*>(storage.data()), accessor.GetValuesNum()));
+
+	return storage;
 }
 
-template<typename TDestType>
-static lib::Span<TDestType> CopyAccessorData(lib::MemoryArena& memoryArena, const tinygltf::Accessor& accessor, const tinygltf::Model& model)
+
+static Bool ShouldBuildPrimitive(const GLTFPrimitiveGeometry& primitive)
+{
+	return primitive.material != -1 && primitive.indices.IsValid();
+}
+
+} // priv
+
+void DecodeGLTFPrimitive(const GLTFPrimitiveGeometry& primitive, GLTFDecodedPrimitive& outDecoded)
 {
 	SPT_PROFILER_FUNCTION();
 
-	const Int32 bufferViewIdx = accessor.bufferView;
-	SPT_CHECK(bufferViewIdx != -1);
+	outDecoded.indices = priv::GetAccessorData<Uint32, Uint32>(primitive.indices, outDecoded.indicesStorage);
 
-	const tinygltf::BufferView& bufferView = model.bufferViews[bufferViewIdx];
-	const Int32 bufferIdx = bufferView.buffer;
-	SPT_CHECK(bufferIdx != -1);
+	// value must be lower because maxValue is reserved for "invalid"
+	SPT_CHECK(outDecoded.indices.size() < maxValue<Uint32>);
 
-	const tinygltf::Buffer& buffer = model.buffers[bufferIdx];
+	outDecoded.locations = priv::GetAccessorData<math::Vector3f, Real32>(primitive.locations, outDecoded.locationsStorage);
 
-	const unsigned char* srcData = buffer.data.data() + accessor.byteOffset + bufferView.byteOffset;
+	{
+		lib::DynamicArray<math::Vector3f> normalsStorage;
+		const lib::Span<const math::Vector3f> normals = priv::GetAccessorData<math::Vector3f, Real32>(primitive.normals, normalsStorage);
+		if (!normals.empty())
+		{
+			outDecoded.encodedNormals.resize(normals.size());
+			mesh_encoding::EncodeMeshNormals(outDecoded.encodedNormals, normals);
+		}
+	}
+
+	{
+		lib::DynamicArray<math::Vector4f> tangentsStorage;
+		const lib::Span<const math::Vector4f> tangents = priv::GetAccessorData<math::Vector4f, Real32>(primitive.tangents, tangentsStorage);
+		if (!tangents.empty())
+		{
+			outDecoded.encodedTangents.resize(tangents.size());
+			mesh_encoding::EncodeMeshTangents(outDecoded.encodedTangents, tangents);
+		}
+	}
+
+	{
+		lib::DynamicArray<math::Vector2f> uvsStorage;
+		const lib::Span<const math::Vector2f> uvs = priv::GetAccessorData<math::Vector2f, Real32>(primitive.uvs, uvsStorage);
+		if (!uvs.empty())
+		{
+			outDecoded.encodedUVs.resize(uvs.size());
+			mesh_encoding::EncodeMeshUVs(outDecoded.encodedUVs, uvs, outDecoded.uvsMin, outDecoded.uvsRange);
+		}
+	}
+}
 
-	const SizeType elementsNum = accessor.count;
-	const SizeType componentsNum = tinygltf::GetNumComponentsInType(accessor.type);
-	const Int32 componentType = accessor.componentType;
+void DecodeGLTFPrimitives(lib::Span<const GLTFPrimitiveGeometry* const> primitives, lib::Span<GLTFDecodedPrimitive> outDecoded)
+{
+	SPT_PROFILER_FUNCTION();
 
-	const SizeType valuesNum = elementsNum * componentsNum;
+	SPT_CHECK(primitives.size() == outDecoded.size());
 
-	lib::Span<TDestType> outData = memoryArena.AllocateSpanUninitialized<TDestType>(valuesNum);
+	lib::DynamicArray<priv::PrimitivesDecodeBatch> batches;
 
-	const auto copyImpl = [outData, valuesNum]<typename TSourceType>(const TSourceType* srcPtr)
+	SizeType batchVerticesNum = 0u;
+	for (SizeType primitiveIdx = 0u; primitiveIdx < primitives.size(); ++primitiveIdx)
 	{
-		CopyData(outData, lib::Span<const TSourceType>(reinterpret_cast<const TSourceType*>(srcPtr), valuesNum));
+		if (batches.empty() || batchVerticesNum >= priv::minVerticesPerDecodeBatch)
+		{
+			batches.emplace_back(priv::PrimitivesDecodeBatch{ primitiveIdx, primitiveIdx });
+			batchVerticesNum = 0u;
+		}
+
+		batches.back().endIdx = primitiveIdx + 1u;
+		batchVerticesNum += primitives[primitiveIdx]->locations.count;
+	}
+
+	const auto decodeBatch = [primitives, outDecoded](const priv::PrimitivesDecodeBatch& batch)
+	{
+		for (SizeType primitiveIdx = batch.beginIdx; primitiveIdx < batch.endIdx; ++primitiveIdx)
+		{
+			DecodeGLTFPrimitive(*primitives[primitiveIdx], outDecoded[primitiveIdx]);
+		}
 	};
 
-	switch (componentType)
+	if (batches.size() > 1u)
 	{
-	case TINYGLTF_COMPONENT_TYPE_BYTE:
-		copyImpl(reinterpret_cast<const char*>(srcData));
-		break;
-	case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-		copyImpl(reinterpret_cast<const unsigned char*>(srcData));
-		break;
-	case TINYGLTF_COMPONENT_TYPE_SHORT:
-		copyImpl(reinterpret_cast<const short*>(srcData));
-		break;
-	case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-		copyImpl(reinterpret_cast<const unsigned short*>(srcData));
-		break;
-	case TINYGLTF_COMPONENT_TYPE_INT:
-		copyImpl(reinterpret_cast<const Int32*>(srcData));
-		break;
-	case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
-		copyImpl(reinterpret_cast<const Uint32*>(srcData));
-		break;
-	case TINYGLTF_COMPONENT_TYPE_FLOAT:
-		copyImpl(reinterpret_cast<const Real32*>(srcData));
-		break;
-	case TINYGLTF_COMPONENT_TYPE_DOUBLE:
-		copyImpl(reinterpret_cast<const Real64*>(srcData));
-		break;
-	default:
-		SPT_CHECK_NO_ENTRY();
+		js::InlineParallelForEach("Decode GLTF Primitives", batches, decodeBatch);
+	}
+	else if (!batches.empty())
+	{
+		decodeBatch(batches.front());
 	}
-
-	// value must be lower because maxValue is reserved for "invalid"
-	SPT_CHECK(elementsNum < maxValue<Uint32>);
-	return outData;
 }
 
-} // priv
-
 GLTFMeshBuilder::GLTFMeshBuilder(const MeshBuildParameters& parameters) : Super(parameters)
 {
 }
 
-void GLTFMeshBuilder::BuildMesh(lib::MemoryArena& memoryArena, const tinygltf::Mesh& mesh, const tinygltf::Model& model)
+void GLTFMeshBuilder::BuildMesh(const GLTFMeshGeometry& mesh)
 {
 	SPT_PROFILER_FUNCTION();
 
+	lib::DynamicArray<const GLTFPrimitiveGeometry*> primitives;
+	primitives.reserve(mesh.primitives.size());
 
-	for (const tinygltf::Primitive& prim : mesh.primitives)
+	for (const GLTFPrimitiveGeometry& primitive : mesh.primitives)
 	{
-		if (prim.material == -1)
+		if (priv::ShouldBuildPrimitive(primitive))
 		{
-			continue;
+			primitives.emplace_back(&primitive);
 		}
+	}
 
-		SubmeshDefinition& submesh = BeginNewSubmesh();
+	lib::DynamicArray<GLTFDecodedPrimitive> decodedPrimitives(primitives.size());
+	DecodeGLTFPrimitives(primitives, decodedPrimitives);
 
+	// Geometry data must be appended in order, so this part is sequential
+	for (const GLTFDecodedPrimitive& decoded : decodedPrimitives)
+	{
+		if (decoded.indices.empty())
 		{
-			lib::MemoryArenaScope memScope(memoryArena);
+			SPT_LOG_WARN(GLTFMeshBuilder, "Skipping primitive with invalid indices in mesh '{}'", mesh.name);
+			continue;
+		}
 
-			const lib::Span<Uint32> indices = priv::CopyAccessorData<Uint32>(memoryArena, model.accessors[prim.indices], model);
+		SubmeshDefinition& submesh = BeginNewSubmesh();
 
-			submesh.indicesNum = static_cast<Uint32>(indices.size());
-			submesh.indicesOffset = AppendData(indices);
-		}
+		submesh.indicesNum    = static_cast<Uint32>(decoded.indices.size());
+		submesh.indicesOffset = AppendData(decoded.indices);
 
-		const static lib::String locationsAccessorName = "POSITION";
-		if (const tinygltf::Accessor* locationsAccessor = GetAttributeAccessor(prim, model, locationsAccessorName))
+		if (!decoded.locations.empty())
 		{
-			lib::MemoryArenaScope memScope(memoryArena);
-
-			const lib::Span<Real32> locationsVals = priv::CopyAccessorData<Real32>(memoryArena, *locationsAccessor, model);
-			const lib::Span<math::Vector3f> locations = lib::Span<math::Vector3f>(reinterpret_cast<math::Vector3f*>(locationsVals.data()), locationsVals.size() / 3);
-			submesh.verticesNum     = static_cast<Uint32>(locations.size());
-			submesh.locationsOffset = AppendData(locations);
+			submesh.verticesNum     = static_cast<Uint32>(decoded.locations.size());
+			submesh.locationsOffset = AppendData(decoded.locations);
 		}
 
-		const static lib::String normalsAccessorName = "NORMAL";
-		if (const tinygltf::Accessor* normalsAccessor = GetAttributeAccessor(prim, model, normalsAccessorName))
+		if (!decoded.encodedNormals.empty())
 		{
-			lib::MemoryArenaScope memScope(memoryArena);
-
-			const lib::Span<Real32> normalVals = priv::CopyAccessorData<Real32>(memoryArena, *normalsAccessor, model);
-			const lib::Span<math::Vector3f> normals = lib::Span<math::Vector3f>(reinterpret_cast<math::Vector3f*>(normalVals.data()), normalVals.size() / 3);
-
-			lib::Span<Uint32> encodedNormals = memoryArena.AllocateSpanUninitialized<Uint32>(normals.size());
-
-			mesh_encoding::EncodeMeshNormals(encodedNormals, normals);
-
-			submesh.normalsOffset = AppendData(encodedNormals);
+			submesh.normalsOffset = AppendData(lib::Span<const Uint32>(decoded.encodedNormals));
 		}
 
-		const static lib::String tangentsAccessorName = "TANGENT";
-		if (const tinygltf::Accessor* tangentsAccessor = GetAttributeAccessor(prim, model, tangentsAccessorName))
+		if (!decoded.encodedTangents.empty())
 		{
-			lib::MemoryArenaScope memScope(memoryArena);
-
-			const lib::Span<Real32> tangentVals = priv::CopyAccessorData<Real32>(memoryArena, *tangentsAccessor, model);
-			const lib::Span<math::Vector4f> tangents = lib::Span<math::Vector4f>(reinterpret_cast<math::Vector4f*>(tangentVals.data()), tangentVals.size() / 4);
-
-			lib::Span<Uint32> encodedTangents = memoryArena.AllocateSpanUninitialized<Uint32>(tangents.size());
-
-			mesh_encoding::EncodeMeshTangents(encodedTangents, tangents);
-
-			submesh.tangentsOffset = AppendData(encodedTangents);
+			submesh.tangentsOffset = AppendData(lib::Span<const Uint32>(decoded.encodedTangents));
 		}
 
-		const static lib::String uvsAccessorName = "TEXCOORD_0";
-		if (const tinygltf::Accessor* uvsAccessor = GetAttributeAccessor(prim, model, uvsAccessorName))
+		if (!decoded.encodedUVs.empty())
 		{
-			lib::MemoryArenaScope memScope(memoryArena);
-
-			const lib::Span<Real32> uvsVals = priv::CopyAccessorData<Real32>(memoryArena, *uvsAccessor, model);
-			const lib::Span<math::Vector2f> uvs = lib::Span<math::Vector2f>(reinterpret_cast<math::Vector2f*>(uvsVals.data()), uvsVals.size() / 2);
-
-			const lib::Span<Uint32> encodedUVs = memoryArena.AllocateSpanUninitialized<Uint32>(uvs.size());
-
-			math::Vector2f minUVs;
-			math::Vector2f maxRange;
-			mesh_encoding::EncodeMeshUVs(encodedUVs, uvs, minUVs, maxRange);
-
-			submesh.uvsMin    = minUVs;
-			submesh.uvsRange  = maxRange;
-			submesh.uvsOffset = AppendData(encodedUVs);
+			submesh.uvsMin    = decoded.uvsMin;
+			submesh.uvsRange  = decoded.uvsRange;
+			submesh.uvsOffset = AppendData(lib::Span<const Uint32>(decoded.encodedUVs));
 		}
 	}
 }
 
-const tinygltf::Accessor* GLTFMeshBuilder::GetAttributeAccessor(const tinygltf::Primitive& prim, const tinygltf::Model& model, const lib::String& name)
-{
-	const auto foundAccessorIdxIt = prim.attributes.find(name);
-	const Int32 foundAccessorIdx = foundAccessorIdxIt != std::cend(prim.attributes) ? foundAccessorIdxIt->second : -1;
-	return foundAccessorIdx != -1 ? &model.accessors[foundAccessorIdx] : nullptr;
-}
-
 } // spt::rsc
@@ -1,13 +1,39 @@
 #pragma once
 
 #include "MeshBuilder.h"
-
-#include "TinyGLTF.h"
+#include "GLTFGeometry.h"
 
 
 namespace spt::rsc
 {
 
+/**
+ * Primitive converted to format stored by mesh builder.
+ * Indices and locations that are already tightly packed in source buffer are referenced directly instead of being copied.
+ */
+struct GLTFDecodedPrimitive
+{
+	lib::Span<const Uint32>         indices;
+	lib::Span<const math::Vector3f> locations;
+
+	lib::DynamicArray<Uint32> encodedNormals;
+	lib::DynamicArray<Uint32> encodedTangents;
+	lib::DynamicArray<Uint32> encodedUVs;
+
+	math::Vector2f uvsMin   = math::Vector2f::Zero();
+	math::Vector2f uvsRange = math::Vector2f::Zero();
+
+	lib::DynamicArray<Uint32>         indicesStorage;
+	lib::DynamicArray<math::Vector3f> locationsStorage;
+};
+
+
+void DecodeGLTFPrimitive(const GLTFPrimitiveGeometry& primitive, GLTFDecodedPrimitive& outDecoded);
+
+/** Decodes primitives in parallel on job system workers. outDecoded must have the same size as primitives */
+void DecodeGLTFPrimitives(lib::Span<const GLTFPrimitiveGeometry* const> primitives, lib::Span<GLTFDecodedPrimitive> outDecoded);
+
+
 class GLTFMeshBuilder : public MeshBuilder
 {
 protected:
@@ -18,11 +44,7 @@ public:
 
 	explicit GLTFMeshBuilder(const MeshBuildParameters& parameters);
 
-	void BuildMesh(lib::MemoryArena& memoryArena, const tinygltf::Mesh& mesh, const tinygltf::Model& model);
-
-private:
-
-	const tinygltf::Accessor* GetAttributeAccessor(const tinygltf::Primitive& prim, const tinygltf::Model& model, const lib::String& name);
+	void BuildMesh(const GLTFMeshGeometry& mesh);
 };
 
 } // spt::rsc
@@ -3,6 +3,7 @@
 #include "Material.h"
 #include "MaterialFeatures.h"
 #include "RenderSceneRegistry.h"
+#include "RenderSceneTypes.h"
 #include "ShaderStructs.h"
 #include "Bindless/BindlessTypes.h"
 #include "Containers/PagedGenerationalPool.h"
@@ -39,7 +40,7 @@ struct MaterialSlotsChunk
 struct SceneMaterials
 {
 	SceneMaterials()
-		: slots("SceneMaterials_MaterialSlotsPool")
+		: slots("SceneMaterials_MaterialSlotsPool", 128u, maxRenderInstancesNum)
 	{
 	}
 
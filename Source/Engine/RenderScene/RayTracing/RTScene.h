@@ -33,7 +33,8 @@ using RTInstanceHandle = lib::PagedGenerationalPool<RTInstance>::Handle;
 struct RTScene
 {
 	static constexpr Uint32 committedInstancesNum = 1024u;
-	static constexpr Uint32 maxInstancesNum       = 32u * 1024u;
+	/** Maximal number of instances in TLAS. Every render instance may have ray tracing instance, so limits must match */
+	static constexpr Uint32 maxInstancesNum       = maxRenderInstancesNum;
 
 	RTScene()
 		: instances("RTScene_InstancesPool", committedInstancesNum, maxInstancesNum)
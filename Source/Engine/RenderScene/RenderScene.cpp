@@ -11,7 +11,7 @@ namespace spt::rsc
 // RenderScene ===================================================================================
 
 RenderScene::RenderScene()
-	: m_instances("RenderSceneInstancesPool")
+	: m_instances("RenderSceneInstancesPool", 128u, maxRenderInstancesNum)
 	, m_renderEntitiesBuffer(CreateInstancesBuffer())
 {
 }
@@ -57,30 +57,64 @@ RenderInstanceHandle RenderScene::CreateInstance(const RenderInstanceDef& def)
 	instanceData.transform = def.transform;
 	const RenderInstanceHandle instanceHandle = m_instances.Add(instanceData);
 
-	const Uint32 idx = instanceHandle.idx;
+	UploadInstancesGPUData({ &instanceHandle, 1u }, { &def.transform, 1u });
 
-	const math::Matrix4f& transformMatrix = def.transform.matrix();
+	return instanceHandle;
+}
 
-	const Real32 scaleX2 = transformMatrix.row(0).head<3>().squaredNorm();
-	const Real32 scaleY2 = transformMatrix.row(1).head<3>().squaredNorm();
-	const Real32 scaleZ2 = transformMatrix.row(2).head<3>().squaredNorm();
+void RenderScene::DeleteInstance(RenderInstanceHandle instanceHandle)
+{
+	m_instances.Delete(instanceHandle);
+}
 
-	const Real32 maxScale = std::max(std::max(scaleX2, scaleY2), scaleZ2);
-	const Real32 uniformScale = std::sqrt(maxScale);
+void RenderScene::UpdateInstanceTransform(RenderInstanceHandle instanceHandle, const math::Affine3f& transform)
+{
+	SPT_PROFILER_FUNCTION();
 
-	RenderEntityGPUData entityGPUData;
-	entityGPUData.transform    = transformMatrix;
-	entityGPUData.uniformScale = uniformScale;
+	RenderInstance* instance = m_instances.Get(instanceHandle);
+	SPT_CHECK(!!instance);
 
-	const Byte* entityDataPtr = reinterpret_cast<const Byte*>(&entityGPUData);
-	rdr::UploadDataToBuffer(m_renderEntitiesBuffer, idx * sizeof(RenderEntityGPUData), entityDataPtr, sizeof(RenderEntityGPUData));
+	instance->transform = transform;
 
-	return instanceHandle;
+	UploadInstancesGPUData({ &instanceHandle, 1u }, { &transform, 1u });
 }
 
-void RenderScene::DeleteInstance(RenderInstanceHandle instanceHandle)
+void RenderScene::CreateInstances(lib::Span<const RenderInstanceDef> defs, lib::Span<RenderInstanceHandle> outHandles)
 {
-	m_instances.Delete(instanceHandle);
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(defs.size() == outHandles.size());
+
+	lib::DynamicArray<math::Affine3f> transforms;
+	transforms.reserve(defs.size());
+
+	for (SizeType idx = 0u; idx < defs.size(); ++idx)
+	{
+		RenderInstance instanceData;
+		instanceData.transform = defs[idx].transform;
+		outHandles[idx] = m_instances.Add(instanceData);
+
+		transforms.emplace_back(defs[idx].transform);
+	}
+
+	UploadInstancesGPUData(outHandles, transforms);
+}
+
+void RenderScene::UpdateInstancesTransforms(lib::Span<const RenderInstanceHandle> instanceHandles, lib::Span<const math::Affine3f> transforms)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(instanceHandles.size() == transforms.size());
+
+	for (SizeType idx = 0u; idx < instanceHandles.size(); ++idx)
+	{
+		RenderInstance* instance = m_instances.Get(instanceHandles[idx]);
+		SPT_CHECK(!!instance);
+
+		instance->transform = transforms[idx];
+	}
+
+	UploadInstancesGPUData(instanceHandles, transforms);
 }
 
 const lib::SharedRef<rdr::Buffer>& RenderScene::GetRenderEntitiesBuffer() const
@@ -103,14 +137,74 @@ lib::SharedRef<rdr::Buffer> RenderScene::CreateInstancesBuffer() const
 	rhi::RHIAllocationInfo renderEntitiesAllocationInfo;
 	renderEntitiesAllocationInfo.memoryUsage = rhi::EMemoryUsage::GPUOnly;
 
-	const Uint64 maxInstancesNum = 32384u;
-
 	rhi::BufferDefinition renderEntitiesBufferDef;
-	renderEntitiesBufferDef.size = maxInstancesNum * sizeof(RenderEntityGPUData);
+	renderEntitiesBufferDef.size = maxRenderInstancesNum * sizeof(RenderEntityGPUData);
 	renderEntitiesBufferDef.usage = lib::Flags(rhi::EBufferUsage::Storage, rhi::EBufferUsage::TransferDst);
 	renderEntitiesBufferDef.flags = rhi::EBufferFlags::WithVirtualSuballocations;
 
 	return rdr::ResourcesManager::CreateBuffer(RENDERER_RESOURCE_NAME("RenderEntitiesGPUDataBuffer"), renderEntitiesBufferDef, renderEntitiesAllocationInfo);
 }
 
+void RenderScene::UploadInstancesGPUData(lib::Span<const RenderInstanceHandle> instanceHandles, lib::Span<const math::Affine3f> transforms)
+{
+	SPT_CHECK(instanceHandles.size() == transforms.size());
+
+	const SizeType instancesNum = instanceHandles.size();
+	if (instancesNum == 0u)
+	{
+		return;
+	}
+
+	// Sort by index, so that neighbouring instances (which are common, as pool allocates lowest free slots) are uploaded with single copy
+	// Sort is stable, so if the same instance is updated multiple times, the last update wins
+	lib::DynamicArray<Uint32> order(instancesNum);
+	for (Uint32 idx = 0u; idx < instancesNum; ++idx)
+	{
+		order[idx] = idx;
+	}
+
+	std::stable_sort(std::begin(order), std::end(order),
+					 [instanceHandles](Uint32 lhs, Uint32 rhs)
+					 {
+						 return instanceHandles[lhs].idx < instanceHandles[rhs].idx;
+					 });
+
+	lib::DynamicArray<RenderEntityGPUData> entitiesGPUData(instancesNum);
+
+	SizeType rangeBegin = 0u;
+
+	for (SizeType idx = 0u; idx < instancesNum; ++idx)
+	{
+		const Uint32 sourceIdx = order[idx];
+
+		const math::Matrix4f& transformMatrix = transforms[sourceIdx].matrix();
+
+		const Real32 scaleX2 = transformMatrix.row(0).head<3>().squaredNorm();
+		const Real32 scaleY2 = transformMatrix.row(1).head<3>().squaredNorm();
+		const Real32 scaleZ2 = transformMatrix.row(2).head<3>().squaredNorm();
+
+		const Real32 maxScale = std::max(std::max(scaleX2, scaleY2), scaleZ2);
+		const Real32 uniformScale = std::sqrt(maxScale);
+
+		RenderEntityGPUData& entityGPUData = entitiesGPUData[idx];
+		entityGPUData.transform    = transformMatrix;
+		entityGPUData.uniformScale = uniformScale;
+
+		const Bool isRangeEnd = (idx + 1u == instancesNum) || (instanceHandles[order[idx + 1u]].idx != instanceHandles[sourceIdx].idx + 1u);
+
+		if (isRangeEnd)
+		{
+			const Uint32 firstInstanceIdx = instanceHandles[order[rangeBegin]].idx;
+			const SizeType rangeSize      = idx + 1u - rangeBegin;
+
+			SPT_CHECK(firstInstanceIdx + rangeSize <= maxRenderInstancesNum);
+
+			const Byte* entitiesDataPtr = reinterpret_cast<const Byte*>(&entitiesGPUData[rangeBegin]);
+			rdr::UploadDataToBuffer(m_renderEntitiesBuffer, firstInstanceIdx * sizeof(RenderEntityGPUData), entitiesDataPtr, rangeSize * sizeof(RenderEntityGPUData));
+
+			rangeBegin = idx + 1u;
+		}
+	}
+}
+
 } // spt::rsc
@@ -47,6 +47,13 @@ public:
 	RenderInstanceHandle CreateInstance(const RenderInstanceDef& def);
 	void                 DeleteInstance(RenderInstanceHandle instanceHandle);
 
+	/** Updates transform of existing instance. Allows moving instances without recreating draws and RT instances that reference them */
+	void UpdateInstanceTransform(RenderInstanceHandle instanceHandle, const math::Affine3f& transform);
+
+	/** Batched versions of functions above. GPU data of all instances is uploaded at once, with single copy for each range of neighbouring instances */
+	void CreateInstances(lib::Span<const RenderInstanceDef> defs, lib::Span<RenderInstanceHandle> outHandles);
+	void UpdateInstancesTransforms(lib::Span<const RenderInstanceHandle> instanceHandles, lib::Span<const math::Affine3f> transforms);
+
 	// Terrain ==============================================================
 
 	void SetTerrainDefinition(const TerrainDefinition& definition);
@@ -72,6 +79,8 @@ private:
 
 	lib::SharedRef<rdr::Buffer> CreateInstancesBuffer() const;
 
+	void UploadInstancesGPUData(lib::Span<const RenderInstanceHandle> instanceHandles, lib::Span<const math::Affine3f> transforms);
+
 	TerrainDefinition m_terrainDefinition;
 
 	RenderInstances m_instances;
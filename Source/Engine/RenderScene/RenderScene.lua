@@ -9,6 +9,8 @@ function RenderScene:SetupConfiguration(configuration, platform)
     self:AddPublicDependency("TinyGLTF")
 
     self:AddPrivateDependency("MeshOptimizer")
+
+    self:AddPrivateDependency("JSON")
     
     self:AddPrivateDependency("JobSystem")
 
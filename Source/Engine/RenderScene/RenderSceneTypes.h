@@ -18,6 +18,10 @@ namespace spt::rsc
 class RenderScene;
 
 
+/** Maximal number of render instances in scene. Pools of objects referencing instances (draws, RT instances, material slots) reserve the same capacity */
+static constexpr Uint32 maxRenderInstancesNum = 128u * 1024u;
+
+
 struct RenderInstance
 {
 	math::Affine3f transform;
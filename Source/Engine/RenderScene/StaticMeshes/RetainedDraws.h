@@ -24,7 +24,7 @@ using RetainedDrawHandle = lib::PagedGenerationalPool<RetainedDraw>::Handle;
 struct RetainedDraws
 {
 	RetainedDraws()
-		: draws("RetainedDraws_DrawsPool")
+		: draws("RetainedDraws_DrawsPool", 128u, maxRenderInstancesNum)
 	{ }
 
 	lib::PagedGenerationalPool<RetainedDraw> draws;
@@ -86,15 +86,8 @@ StaticMeshGeometryData StaticMeshUnifiedData::BuildStaticMeshData(lib::DynamicAr
 	lib::DynamicArray<rdr::HLSLStorage<MeshletGPUData>> hlslMeshlets(meshlets.size());
 	lib::DynamicArray<rdr::HLSLStorage<SubmeshGPUData>> hlslSubmeshes(submeshes.size());
 
-	for (SizeType meshletIdx = 0; meshletIdx < meshlets.size(); ++meshletIdx)
-	{
-		hlslMeshlets[meshletIdx] = meshlets[meshletIdx];
-	}
-
-	for (SizeType submeshIdx = 0; submeshIdx < submeshes.size(); ++submeshIdx)
-	{
-		hlslSubmeshes[submeshIdx] = submeshes[submeshIdx];
-	}
+	rdr::CopyCPPToHLSLArray<MeshletGPUData>(meshlets, hlslMeshlets);
+	rdr::CopyCPPToHLSLArray<SubmeshGPUData>(submeshes, hlslSubmeshes);
 
 	rdr::UploadDataToBuffer(lib::Ref(m_meshletsBuffer),		meshletsSuballocation.GetOffset(),		reinterpret_cast<const Byte*>(hlslMeshlets.data()),		meshletsDataSize);
 	rdr::UploadDataToBuffer(lib::Ref(m_submeshesBuffer),	submeshesSuballocation.GetOffset(),		reinterpret_cast<const Byte*>(hlslSubmeshes.data()),	submeshesDataSize);
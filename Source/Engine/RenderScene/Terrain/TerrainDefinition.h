@@ -15,6 +15,9 @@ class TextureView;
 namespace spt::rsc
 {
 
+class TerrainHeightMapStreamer;
+
+
 namespace terrain_material_props
 {
 static constexpr Uint32 maxMaterialEntries = 64u;
@@ -49,7 +52,10 @@ END_SHADER_STRUCT();
 
 struct TerrainDefinition
 {
+	/** Low resolution height map, always resident. Used where streamed tiles are not loaded */
 	lib::SharedPtr<rdr::TextureView> heightMap;
+	/** Streams full resolution height map tiles. May be null if terrain has no height map */
+	lib::SharedPtr<TerrainHeightMapStreamer> heightMapStreamer;
 	lib::SharedPtr<rdr::TextureView> tileHeightMinMaxMap;
 	lib::SharedPtr<rdr::TextureView> farLODBaseColor;
 	lib::SharedPtr<rdr::TextureView> farLODProps;
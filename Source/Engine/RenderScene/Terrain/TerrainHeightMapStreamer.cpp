@@ -0,0 +1,185 @@
+#include "TerrainHeightMapStreamer.h"
+#include "ResourcesManager.h"
+#include "Types/Texture.h"
+#include "Types/Buffer.h"
+#include "Utils/TransfersUtils.h"
+#include "JobSystem.h"
+
+
+namespace spt::rsc
+{
+
+namespace priv
+{
+
+static TerrainTilesResidencyDefinition CreateResidencyDefinition(const TerrainHeightMapStreamingDefinition& definition)
+{
+	SPT_CHECK_MSG(definition.format == rhi::EFragmentFormat::R16_UN_Float, "Only 16-bit height maps can be streamed");
+
+	TerrainTilesResidencyDefinition residencyDef;
+	residencyDef.tilesNum        = definition.tilesNum;
+	residencyDef.tileDataSize    = static_cast<Uint64>(definition.tileResolution.x()) * definition.tileResolution.y() * sizeof(Uint16);
+	residencyDef.memoryBudget    = definition.params.memoryBudget;
+	residencyDef.stagingSlotsNum = definition.params.stagingSlotsNum;
+
+	return residencyDef;
+}
+
+} // priv
+
+TerrainHeightMapStreamer::TerrainHeightMapStreamer(TerrainHeightMapStreamingDefinition definition)
+	: m_definition(std::move(definition))
+	, m_residency(priv::CreateResidencyDefinition(m_definition))
+{
+	SPT_CHECK(!!m_definition.dataSource);
+
+	const TerrainTilesResidencyDefinition& residencyDef = m_residency.GetDefinition();
+
+	m_tileDataSize = residencyDef.tileDataSize;
+
+	m_stagingRing.resize(residencyDef.stagingSlotsNum * m_tileDataSize);
+
+	const Uint32 physicalSlotsNum = m_residency.GetPhysicalSlotsNum();
+	m_physicalSlotsPerRow = static_cast<Uint32>(std::ceil(std::sqrt(static_cast<Real32>(physicalSlotsNum))));
+	const Uint32 physicalSlotsRows = math::Utils::DivideCeil(physicalSlotsNum, m_physicalSlotsPerRow);
+
+	rhi::TextureDefinition physicalTextureDef;
+	physicalTextureDef.resolution = math::Vector3u(m_physicalSlotsPerRow * m_definition.tileResolution.x(), physicalSlotsRows * m_definition.tileResolution.y(), 1u);
+	physicalTextureDef.format     = m_definition.format;
+	physicalTextureDef.usage      = lib::Flags(rhi::ETextureUsage::SampledTexture, rhi::ETextureUsage::TransferDest);
+	physicalTextureDef.flags      = rhi::ETextureFlags::GloballyReadable;
+	m_physicalTexture = rdr::ResourcesManager::CreateTextureView(RENDERER_RESOURCE_NAME("Terrain Height Map Physical Tiles"), physicalTextureDef, rhi::EMemoryUsage::GPUOnly);
+
+	const rhi::BufferDefinition pageTableDef(m_residency.GetPageTable().size_bytes(), lib::Flags(rhi::EBufferUsage::Storage, rhi::EBufferUsage::TransferDst));
+	m_pageTable = rdr::ResourcesManager::CreateBuffer(RENDERER_RESOURCE_NAME("Terrain Height Map Page Table"), pageTableDef, rhi::EMemoryUsage::GPUOnly);
+
+	UploadPageTable();
+}
+
+TerrainHeightMapStreamer::~TerrainHeightMapStreamer()
+{
+	// Reads write to staging ring, so they must finish before it's released
+	for (const InFlightRead& read : m_inFlightReads)
+	{
+		read.job.Wait();
+	}
+}
+
+void TerrainHeightMapStreamer::RequestTile(math::Vector2u tileCoords, Real32 priority)
+{
+	m_residency.RequestTile(tileCoords, priority);
+}
+
+void TerrainHeightMapStreamer::RequestTileAtUV(math::Vector2f heightMapUV, Real32 priority)
+{
+	if (heightMapUV.x() < 0.f || heightMapUV.y() < 0.f || heightMapUV.x() >= 1.f || heightMapUV.y() >= 1.f)
+	{
+		return;
+	}
+
+	const math::Vector2u texel = heightMapUV.cwiseProduct(m_definition.resolution.cast<Real32>()).cast<Uint32>();
+	m_residency.RequestTile(texel.cwiseQuotient(m_definition.tileResolution), priority);
+}
+
+void TerrainHeightMapStreamer::RequestTilesAroundLocation(math::Vector2f heightMapUV, Real32 radiusMeters, math::Vector2f metersPerTexel)
+{
+	const math::Vector2f tilesNum = m_definition.tilesNum.cast<Real32>();
+	const math::Vector2f tileSizeMeters = m_definition.tileResolution.cast<Real32>().cwiseProduct(metersPerTexel);
+
+	const math::Vector2f location = heightMapUV.cwiseProduct(m_definition.resolution.cast<Real32>()).cwiseQuotient(m_definition.tileResolution.cast<Real32>());
+	const Real32 radius = radiusMeters / tileSizeMeters.minCoeff();
+
+	if (location.x() + radius < 0.f || location.y() + radius < 0.f || location.x() - radius > tilesNum.x() || location.y() - radius > tilesNum.y())
+	{
+		return;
+	}
+
+	m_residency.RequestTilesInRadius(location, radius);
+}
+
+void TerrainHeightMapStreamer::Update(Uint64 frameIdx)
+{
+	SPT_PROFILER_FUNCTION();
+
+	FinishCompletedReads();
+
+	const TerrainTilesResidencyUpdate update = m_residency.Update(frameIdx);
+
+	for (const TerrainTileLoadRequest& load : update.loads)
+	{
+		const lib::Span<Byte> stagingData = GetStagingSlot(load.stagingSlot, GetTileResolution(load.tileIdx));
+
+		js::Job readJob = js::Launch("Read Terrain Height Map Tile",
+									 [dataSource = m_definition.dataSource, tileIdx = load.tileIdx, stagingData]
+									 {
+										 dataSource->ReadTileData(tileIdx, stagingData);
+									 },
+									 js::JobDef().SetPriority(js::EJobPriority::Low));
+
+		m_inFlightReads.emplace_back(InFlightRead{ load, std::move(readJob) });
+	}
+
+	// Must be enqueued after tile copies from FinishCompletedReads, so mappings are never visible before tile data
+	if (m_residency.FlushPageTableChanges())
+	{
+		UploadPageTable();
+	}
+}
+
+math::Vector2u TerrainHeightMapStreamer::GetTileResolution(Uint32 tileIdx) const
+{
+	const math::Vector2u tileCoords(tileIdx % m_definition.tilesNum.x(), tileIdx / m_definition.tilesNum.x());
+	const math::Vector2u tileOffset = tileCoords.cwiseProduct(m_definition.tileResolution);
+
+	// Tiles at the edges of height map may be smaller
+	return m_definition.tileResolution.cwiseMin(m_definition.resolution - tileOffset);
+}
+
+lib::Span<Byte> TerrainHeightMapStreamer::GetStagingSlot(Uint32 stagingSlot, math::Vector2u tileResolution)
+{
+	const Uint64 dataSize = static_cast<Uint64>(tileResolution.x()) * tileResolution.y() * sizeof(Uint16);
+	SPT_CHECK(dataSize <= m_tileDataSize);
+
+	return lib::Span<Byte>(m_stagingRing.data() + stagingSlot * m_tileDataSize, dataSize);
+}
+
+void TerrainHeightMapStreamer::FinishCompletedReads()
+{
+	SPT_PROFILER_FUNCTION();
+
+	const rhi::ETextureAspect textureAspect = m_physicalTexture->GetRHI().GetAspect();
+
+	for (SizeType readIdx = 0u; readIdx < m_inFlightReads.size();)
+	{
+		const InFlightRead& read = m_inFlightReads[readIdx];
+		if (!read.job.IsFinished())
+		{
+			++readIdx;
+			continue;
+		}
+
+		const TerrainTileLoadRequest& load = read.load;
+
+		const math::Vector2u tileResolution = GetTileResolution(load.tileIdx);
+		const lib::Span<Byte> stagingData = GetStagingSlot(load.stagingSlot, tileResolution);
+
+		const math::Vector2u slotCoords(load.physicalSlot % m_physicalSlotsPerRow, load.physicalSlot / m_physicalSlotsPerRow);
+		const math::Vector2u slotOffset = slotCoords.cwiseProduct(m_definition.tileResolution);
+
+		// Upload copies data to staging buffer immediately, so staging slot can be released right after that
+		rdr::UploadDataToTexture(stagingData.data(), stagingData.size(), m_physicalTexture->GetTexture(), textureAspect, math::Vector3u(tileResolution.x(), tileResolution.y(), 1u), math::Vector3u(slotOffset.x(), slotOffset.y(), 0u));
+
+		m_residency.CompleteLoad(load);
+
+		m_inFlightReads[readIdx] = std::move(m_inFlightReads.back());
+		m_inFlightReads.pop_back();
+	}
+}
+
+void TerrainHeightMapStreamer::UploadPageTable()
+{
+	const lib::Span<const Uint32> pageTable = m_residency.GetPageTable();
+	rdr::UploadDataToBuffer(lib::Ref(m_pageTable), 0u, reinterpret_cast<const Byte*>(pageTable.data()), pageTable.size_bytes());
+}
+
+} // spt::rsc
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "RenderSceneMacros.h"
+#include "SculptorCoreTypes.h"
+#include "RHICore/RHITextureTypes.h"
+#include "Terrain/TerrainTilesResidency.h"
+#include "Job.h"
+
+
+namespace spt::rdr
+{
+class TextureView;
+class Buffer;
+} // spt::rdr
+
+
+namespace spt::rsc
+{
+
+class TerrainTilesDataSource
+{
+public:
+
+	virtual ~TerrainTilesDataSource() = default;
+
+	/** Called from worker threads. Must copy linear data of the tile to destination */
+	virtual void ReadTileData(Uint32 tileIdx, lib::Span<Byte> destination) const = 0;
+};
+
+
+struct TerrainHeightMapStreamingParams
+{
+	Uint64 memoryBudget          = 64u * 1024u * 1024u;
+	Uint32 stagingSlotsNum       = 16u;
+	Real32 residencyRadiusMeters = 768.f;
+};
+
+
+struct TerrainHeightMapStreamingDefinition
+{
+	math::Vector2u       resolution     = math::Vector2u::Zero();
+	math::Vector2u       tileResolution = math::Vector2u::Zero();
+	math::Vector2u       tilesNum       = math::Vector2u::Zero();
+	rhi::EFragmentFormat format         = rhi::EFragmentFormat::None;
+
+	lib::SharedPtr<const TerrainTilesDataSource> dataSource;
+
+	TerrainHeightMapStreamingParams params;
+};
+
+
+/**
+ * Streams height map tiles to physical texture (array of tiles in 2D atlas).
+ * Page table buffer maps each tile to its physical slot (or IDX_NONE_32 if tile isn't resident).
+ * Tiles are read asynchronously to staging ring and uploaded to physical texture when read is finished.
+ * Page table is uploaded with the same transfers as tiles and after them, so GPU never sees mapping to a slot without its data
+ */
+class RENDER_SCENE_API TerrainHeightMapStreamer
+{
+public:
+
+	explicit TerrainHeightMapStreamer(TerrainHeightMapStreamingDefinition definition);
+	~TerrainHeightMapStreamer();
+
+	TerrainHeightMapStreamer(const TerrainHeightMapStreamer&) = delete;
+	TerrainHeightMapStreamer& operator=(const TerrainHeightMapStreamer&) = delete;
+
+	/** Lower priority value means more important tile */
+	void RequestTile(math::Vector2u tileCoords, Real32 priority);
+
+	/** Requests tile that contains given normalized height map UV */
+	void RequestTileAtUV(math::Vector2f heightMapUV, Real32 priority);
+
+	/** Requests tiles around location. Location is normalized height map UV. Priority is distance in tiles */
+	void RequestTilesAroundLocation(math::Vector2f heightMapUV, Real32 radiusMeters, math::Vector2f metersPerTexel);
+
+	/** Finishes completed reads, processes requests and starts new reads */
+	void Update(Uint64 frameIdx);
+
+	const lib::SharedPtr<rdr::TextureView>& GetPhysicalTexture() const { return m_physicalTexture; }
+	const lib::SharedPtr<rdr::Buffer>&      GetPageTable() const       { return m_pageTable; }
+
+	Uint32 GetPhysicalSlotsPerRow() const { return m_physicalSlotsPerRow; }
+
+	const TerrainHeightMapStreamingDefinition& GetDefinition() const { return m_definition; }
+	const TerrainTilesResidencyStats&          GetStats() const      { return m_residency.GetStats(); }
+
+private:
+
+	struct InFlightRead
+	{
+		TerrainTileLoadRequest load;
+		js::Job                job;
+	};
+
+	math::Vector2u GetTileResolution(Uint32 tileIdx) const;
+	lib::Span<Byte> GetStagingSlot(Uint32 stagingSlot, math::Vector2u tileResolution);
+
+	void FinishCompletedReads();
+	void UploadPageTable();
+
+	TerrainHeightMapStreamingDefinition m_definition;
+
+	TerrainTilesResidency m_residency;
+
+	Uint64 m_tileDataSize = 0u;
+
+	lib::DynamicArray<Byte>         m_stagingRing;
+	lib::DynamicArray<InFlightRead> m_inFlightReads;
+
+	lib::SharedPtr<rdr::TextureView> m_physicalTexture;
+	lib::SharedPtr<rdr::Buffer>      m_pageTable;
+	Uint32                           m_physicalSlotsPerRow = 0u;
+};
+
+} // spt::rsc
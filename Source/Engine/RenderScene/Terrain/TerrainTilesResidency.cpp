@@ -0,0 +1,232 @@
+#include "TerrainTilesResidency.h"
+
+
+namespace spt::rsc
+{
+
+TerrainTilesResidency::TerrainTilesResidency(const TerrainTilesResidencyDefinition& definition)
+	: m_definition(definition)
+{
+	SPT_CHECK(definition.tilesNum.x() > 0u && definition.tilesNum.y() > 0u);
+	SPT_CHECK(definition.tileDataSize > 0u);
+	SPT_CHECK(definition.stagingSlotsNum > 0u);
+
+	const Uint32 tilesNum = definition.tilesNum.x() * definition.tilesNum.y();
+
+	const Uint32 physicalSlotsNum = static_cast<Uint32>(std::clamp<Uint64>(definition.memoryBudget / definition.tileDataSize, 1u, tilesNum));
+
+	m_pageTable.resize(tilesNum, invalidSlot);
+	m_tilesStates.resize(tilesNum, ETileState::NotResident);
+	m_tilesRequestPriorities.resize(tilesNum, maxValue<Real32>);
+
+	m_slots.resize(physicalSlotsNum);
+
+	// Free lists are used as stacks. Store indices in reverse order, so that lower slots are used first
+	m_freeSlots.reserve(physicalSlotsNum);
+	for (Uint32 slotIdx = physicalSlotsNum; slotIdx > 0u; --slotIdx)
+	{
+		m_freeSlots.emplace_back(slotIdx - 1u);
+	}
+
+	m_freeStagingSlots.reserve(definition.stagingSlotsNum);
+	for (Uint32 slotIdx = definition.stagingSlotsNum; slotIdx > 0u; --slotIdx)
+	{
+		m_freeStagingSlots.emplace_back(slotIdx - 1u);
+	}
+
+	m_stats.physicalSlotsNum = physicalSlotsNum;
+}
+
+void TerrainTilesResidency::RequestTile(math::Vector2u tileCoords, Real32 priority)
+{
+	if (tileCoords.x() >= m_definition.tilesNum.x() || tileCoords.y() >= m_definition.tilesNum.y())
+	{
+		return;
+	}
+
+	const Uint32 tileIdx = TileCoordsToIdx(tileCoords);
+
+	Real32& requestPriority = m_tilesRequestPriorities[tileIdx];
+	if (requestPriority == maxValue<Real32>)
+	{
+		m_requests.emplace_back(TileRequest{ tileIdx, priority });
+	}
+
+	requestPriority = std::min(requestPriority, priority);
+}
+
+void TerrainTilesResidency::RequestTilesInRadius(math::Vector2f location, Real32 radius)
+{
+	const math::Vector2i maxTile = m_definition.tilesNum.cast<Int32>() - math::Vector2i::Ones();
+
+	const math::Vector2i minCoords = (location - math::Vector2f::Constant(radius)).array().floor().cast<Int32>().matrix().cwiseMax(math::Vector2i::Zero());
+	const math::Vector2i maxCoords = (location + math::Vector2f::Constant(radius)).array().floor().cast<Int32>().matrix().cwiseMin(maxTile);
+
+	for (Int32 y = minCoords.y(); y <= maxCoords.y(); ++y)
+	{
+		for (Int32 x = minCoords.x(); x <= maxCoords.x(); ++x)
+		{
+			// Distance from location to the closest point of tile
+			const math::Vector2f tileMin(static_cast<Real32>(x), static_cast<Real32>(y));
+			const math::Vector2f closestPoint = location.cwiseMax(tileMin).cwiseMin(tileMin + math::Vector2f::Ones());
+			const Real32 distance = (closestPoint - location).norm();
+
+			if (distance <= radius)
+			{
+				RequestTile(math::Vector2u(static_cast<Uint32>(x), static_cast<Uint32>(y)), distance);
+			}
+		}
+	}
+}
+
+TerrainTilesResidencyUpdate TerrainTilesResidency::Update(Uint64 frameIdx)
+{
+	SPT_PROFILER_FUNCTION();
+
+	TerrainTilesResidencyUpdate update;
+
+	std::sort(m_requests.begin(), m_requests.end(),
+			  [this](const TileRequest& lhs, const TileRequest& rhs)
+			  {
+				  return m_tilesRequestPriorities[lhs.tileIdx] < m_tilesRequestPriorities[rhs.tileIdx];
+			  });
+
+	// First mark all requested resident tiles as used, so that they are not evicted by loads of missing tiles
+	for (const TileRequest& request : m_requests)
+	{
+		const Uint32 slotIdx = m_pageTable[request.tileIdx];
+		if (slotIdx != invalidSlot)
+		{
+			m_slots[slotIdx].lastUsedFrameIdx = frameIdx;
+		}
+	}
+
+	Uint32 missingTilesNum = 0u;
+
+	for (const TileRequest& request : m_requests)
+	{
+		if (m_tilesStates[request.tileIdx] != ETileState::NotResident)
+		{
+			continue;
+		}
+
+		++missingTilesNum;
+
+		if (m_freeStagingSlots.empty())
+		{
+			continue;
+		}
+
+		const Uint32 physicalSlot = AcquirePhysicalSlot(frameIdx, update);
+		if (physicalSlot == invalidSlot)
+		{
+			// All slots are used by more important tiles
+			continue;
+		}
+
+		const Uint32 stagingSlot = m_freeStagingSlots.back();
+		m_freeStagingSlots.pop_back();
+
+		PhysicalSlot& slot = m_slots[physicalSlot];
+		slot.tileIdx          = request.tileIdx;
+		slot.lastUsedFrameIdx = frameIdx;
+		slot.isPending        = true;
+
+		m_tilesStates[request.tileIdx] = ETileState::Pending;
+
+		update.loads.emplace_back(TerrainTileLoadRequest{ request.tileIdx, physicalSlot, stagingSlot });
+
+		++m_stats.pendingTilesNum;
+		++m_stats.totalLoadsNum;
+	}
+
+	for (const TileRequest& request : m_requests)
+	{
+		m_tilesRequestPriorities[request.tileIdx] = maxValue<Real32>;
+	}
+
+	m_stats.lastRequestedNum = static_cast<Uint32>(m_requests.size());
+	m_stats.lastMissingNum   = missingTilesNum;
+
+	m_requests.clear();
+
+	return update;
+}
+
+void TerrainTilesResidency::CompleteLoad(const TerrainTileLoadRequest& load)
+{
+	SPT_CHECK(load.tileIdx < m_tilesStates.size());
+	SPT_CHECK(m_tilesStates[load.tileIdx] == ETileState::Pending);
+
+	PhysicalSlot& slot = m_slots[load.physicalSlot];
+	SPT_CHECK(slot.tileIdx == load.tileIdx);
+	SPT_CHECK(slot.isPending);
+
+	slot.isPending = false;
+
+	m_tilesStates[load.tileIdx] = ETileState::Resident;
+	m_pageTable[load.tileIdx]   = load.physicalSlot;
+	m_pageTableDirty            = true;
+
+	m_freeStagingSlots.emplace_back(load.stagingSlot);
+
+	--m_stats.pendingTilesNum;
+	++m_stats.residentTilesNum;
+}
+
+Uint32 TerrainTilesResidency::GetPhysicalSlot(math::Vector2u tileCoords) const
+{
+	return m_pageTable[TileCoordsToIdx(tileCoords)];
+}
+
+Bool TerrainTilesResidency::FlushPageTableChanges()
+{
+	const Bool wasDirty = m_pageTableDirty;
+	m_pageTableDirty = false;
+	return wasDirty;
+}
+
+Uint32 TerrainTilesResidency::AcquirePhysicalSlot(Uint64 frameIdx, TerrainTilesResidencyUpdate& outUpdate)
+{
+	if (!m_freeSlots.empty())
+	{
+		const Uint32 slotIdx = m_freeSlots.back();
+		m_freeSlots.pop_back();
+		return slotIdx;
+	}
+
+	// Find least recently used tile that wasn't requested in this frame
+	Uint32 lruSlotIdx = invalidSlot;
+	Uint64 lruFrameIdx = frameIdx;
+
+	for (Uint32 slotIdx = 0u; slotIdx < static_cast<Uint32>(m_slots.size()); ++slotIdx)
+	{
+		const PhysicalSlot& slot = m_slots[slotIdx];
+		if (!slot.isPending && slot.lastUsedFrameIdx < lruFrameIdx)
+		{
+			lruSlotIdx  = slotIdx;
+			lruFrameIdx = slot.lastUsedFrameIdx;
+		}
+	}
+
+	if (lruSlotIdx != invalidSlot)
+	{
+		PhysicalSlot& slot = m_slots[lruSlotIdx];
+		SPT_CHECK(m_tilesStates[slot.tileIdx] == ETileState::Resident);
+
+		m_tilesStates[slot.tileIdx] = ETileState::NotResident;
+		m_pageTable[slot.tileIdx]   = invalidSlot;
+		m_pageTableDirty            = true;
+
+		outUpdate.evictedTiles.emplace_back(slot.tileIdx);
+
+		slot.tileIdx = idxNone<Uint32>;
+
+		--m_stats.residentTilesNum;
+		++m_stats.totalEvictionsNum;
+	}
+
+	return lruSlotIdx;
+}
+
+} // spt::rsc
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "RenderSceneMacros.h"
+#include "SculptorCoreTypes.h"
+
+
+namespace spt::rsc
+{
+
+struct TerrainTilesResidencyDefinition
+{
+	math::Vector2u tilesNum     = math::Vector2u::Zero();
+	Uint64         tileDataSize = 0u;
+
+	/** Memory budget for resident tiles. Number of physical slots is derived from it */
+	Uint64 memoryBudget = 0u;
+
+	/** Max number of tile reads in flight (number of entries in staging ring) */
+	Uint32 stagingSlotsNum = 8u;
+};
+
+
+struct TerrainTileLoadRequest
+{
+	Uint32 tileIdx      = idxNone<Uint32>;
+	Uint32 physicalSlot = idxNone<Uint32>;
+	Uint32 stagingSlot  = idxNone<Uint32>;
+};
+
+
+struct TerrainTilesResidencyUpdate
+{
+	/** Tiles that should be read to staging slots and then copied to physical slots */
+	lib::DynamicArray<TerrainTileLoadRequest> loads;
+	/** Tiles evicted from physical slots in this update */
+	lib::DynamicArray<Uint32> evictedTiles;
+};
+
+
+struct TerrainTilesResidencyStats
+{
+	Uint32 physicalSlotsNum    = 0u;
+	Uint32 residentTilesNum    = 0u;
+	Uint32 pendingTilesNum     = 0u;
+	Uint32 lastRequestedNum    = 0u;
+	Uint32 lastMissingNum      = 0u;
+	Uint64 totalLoadsNum       = 0u;
+	Uint64 totalEvictionsNum   = 0u;
+};
+
+
+/**
+ * CPU side of terrain tiles streaming. Doesn't own any GPU resources or tiles data.
+ * Each frame, tiles that are needed are requested with priority. Update picks the most important missing tiles,
+ * assigns them physical slots (evicting least recently used tiles if budget is exceeded) and staging slots for reads.
+ * Page table is updated only when load is completed, so it never points to slot with incomplete data
+ */
+class RENDER_SCENE_API TerrainTilesResidency
+{
+public:
+
+	static constexpr Uint32 invalidSlot = idxNone<Uint32>;
+
+	explicit TerrainTilesResidency(const TerrainTilesResidencyDefinition& definition);
+
+	/** Lower priority value means more important tile. Multiple requests of the same tile are merged */
+	void RequestTile(math::Vector2u tileCoords, Real32 priority);
+
+	/** Requests all tiles that overlap circle. Location and radius are in tile units. Priority is distance to the center */
+	void RequestTilesInRadius(math::Vector2f location, Real32 radius);
+
+	/** Processes requests made since last update */
+	TerrainTilesResidencyUpdate Update(Uint64 frameIdx);
+
+	/** Must be called after tile data was copied to its physical slot. Releases staging slot and makes tile visible in page table */
+	void CompleteLoad(const TerrainTileLoadRequest& load);
+
+	Uint32 GetPhysicalSlot(math::Vector2u tileCoords) const;
+
+	/** Maps tile index to physical slot (or invalidSlot if tile is not resident) */
+	lib::Span<const Uint32> GetPageTable() const { return m_pageTable; }
+
+	/** Returns true if page table changed since last call */
+	Bool FlushPageTableChanges();
+
+	const TerrainTilesResidencyDefinition& GetDefinition() const { return m_definition; }
+	const TerrainTilesResidencyStats&      GetStats() const      { return m_stats; }
+
+	Uint32 GetPhysicalSlotsNum() const { return static_cast<Uint32>(m_slots.size()); }
+
+private:
+
+	enum class ETileState : Uint8
+	{
+		NotResident,
+		Pending,
+		Resident
+	};
+
+	struct PhysicalSlot
+	{
+		Uint32 tileIdx          = idxNone<Uint32>;
+		Uint64 lastUsedFrameIdx = 0u;
+		Bool   isPending        = false;
+	};
+
+	struct TileRequest
+	{
+		Uint32 tileIdx  = idxNone<Uint32>;
+		Real32 priority = 0.f;
+	};
+
+	Uint32 TileCoordsToIdx(math::Vector2u tileCoords) const { return tileCoords.y() * m_definition.tilesNum.x() + tileCoords.x(); }
+
+	Uint32 AcquirePhysicalSlot(Uint64 frameIdx, TerrainTilesResidencyUpdate& outUpdate);
+
+	TerrainTilesResidencyDefinition m_definition;
+
+	lib::DynamicArray<Uint32>     m_pageTable;
+	lib::DynamicArray<ETileState> m_tilesStates;
+	lib::DynamicArray<Real32>     m_tilesRequestPriorities;
+
+	lib::DynamicArray<PhysicalSlot> m_slots;
+	lib::DynamicArray<Uint32>       m_freeSlots;
+	lib::DynamicArray<Uint32>       m_freeStagingSlots;
+
+	lib::DynamicArray<TileRequest> m_requests;
+
+	Bool m_pageTableDirty = true;
+
+	TerrainTilesResidencyStats m_stats;
+};
+
+} // spt::rsc
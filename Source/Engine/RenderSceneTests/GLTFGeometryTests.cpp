@@ -0,0 +1,480 @@
+#include "gtest/gtest.h"
+#include "Loaders/GLTFGeometry.h"
+#include "Loaders/GLTFMeshBuilder.h"
+#include "JobSystem.h"
+#include "MathUtils.h"
+
+#include "nlohmann/json.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+
+
+namespace spt::rsc::tests
+{
+
+namespace priv
+{
+
+class TempDirectory
+{
+public:
+
+	TempDirectory()
+	{
+		std::random_device randomDevice;
+		m_path = std::filesystem::temp_directory_path() / ("SculptorGLTFGeometryTests_" + std::to_string(randomDevice()));
+		std::filesystem::create_directories(m_path);
+	}
+
+	~TempDirectory()
+	{
+		std::error_code errorCode;
+		std::filesystem::remove_all(m_path, errorCode);
+	}
+
+	const lib::Path& GetPath() const { return m_path; }
+
+private:
+
+	lib::Path m_path;
+};
+
+
+/** Writes glTF files with geometry only. Used to generate test data procedurally */
+class GLTFWriter
+{
+public:
+
+	GLTFWriter()
+	{
+		m_document["asset"]       = { { "version", "2.0" } };
+		m_document["bufferViews"] = nlohmann::json::array();
+		m_document["accessors"]   = nlohmann::json::array();
+		m_document["meshes"]      = nlohmann::json::array();
+	}
+
+	template<typename TType>
+	Uint32 AddBufferView(lib::Span<const TType> data, Uint32 stride = 0u)
+	{
+		AlignBinaryData();
+
+		nlohmann::json bufferView = { { "buffer", 0 }, { "byteOffset", m_binaryData.size() }, { "byteLength", data.size_bytes() } };
+		if (stride != 0u)
+		{
+			bufferView["byteStride"] = stride;
+		}
+
+		const Byte* bytes = reinterpret_cast<const Byte*>(data.data());
+		m_binaryData.insert(m_binaryData.end(), bytes, bytes + data.size_bytes());
+
+		return AddElement("bufferViews", std::move(bufferView));
+	}
+
+	Uint32 AddAccessor(Uint32 bufferView, SizeType byteOffset, EGLTFComponentType componentType, Uint32 count, const char* type, Bool normalized = false)
+	{
+		return AddElement("accessors",
+						  {
+							  { "bufferView", bufferView },
+							  { "byteOffset", byteOffset },
+							  { "componentType", static_cast<Uint32>(componentType) },
+							  { "count", count },
+							  { "type", type },
+							  { "normalized", normalized }
+						  });
+	}
+
+	void AddMesh(const lib::String& name, nlohmann::json primitives)
+	{
+		AddElement("meshes", { { "name", name }, { "primitives", std::move(primitives) } });
+	}
+
+	void WriteGLB(const lib::Path& path)
+	{
+		AlignBinaryData();
+
+		nlohmann::json document = m_document;
+		document["buffers"] = nlohmann::json::array({ { { "byteLength", m_binaryData.size() } } });
+
+		lib::String json = document.dump();
+		json.resize(math::Utils::RoundUp<SizeType>(json.size(), 4u), ' ');
+
+		const Uint32 jsonChunkHeader[] = { static_cast<Uint32>(json.size()), 0x4E4F534Au };
+		const Uint32 binChunkHeader[]  = { static_cast<Uint32>(m_binaryData.size()), 0x004E4942u };
+		const Uint32 headerSize        = 3u * sizeof(Uint32);
+		const Uint32 header[]          = { 0x46546C67u, 2u, static_cast<Uint32>(headerSize + sizeof(jsonChunkHeader) + json.size() + sizeof(binChunkHeader) + m_binaryData.size()) };
+
+		std::ofstream stream(path, std::ios::binary);
+		stream.write(reinterpret_cast<const char*>(header), sizeof(header));
+		stream.write(reinterpret_cast<const char*>(jsonChunkHeader), sizeof(jsonChunkHeader));
+		stream.write(json.data(), json.size());
+		stream.write(reinterpret_cast<const char*>(binChunkHeader), sizeof(binChunkHeader));
+		stream.write(reinterpret_cast<const char*>(m_binaryData.data()), m_binaryData.size());
+	}
+
+	/** Writes .gltf file which references binary data stored in separate file */
+	void WriteGLTF(const lib::Path& path, const lib::String& binaryFileName, const lib::String& binaryURI)
+	{
+		nlohmann::json document = m_document;
+		document["buffers"] = nlohmann::json::array({ { { "uri", binaryURI }, { "byteLength", m_binaryData.size() } } });
+
+		std::ofstream(path) << document.dump();
+
+		std::ofstream binaryStream(path.parent_path() / binaryFileName, std::ios::binary);
+		binaryStream.write(reinterpret_cast<const char*>(m_binaryData.data()), m_binaryData.size());
+	}
+
+private:
+
+	Uint32 AddElement(const char* arrayName, nlohmann::json element)
+	{
+		nlohmann::json& array = m_document[arrayName];
+		array.push_back(std::move(element));
+		return static_cast<Uint32>(array.size() - 1u);
+	}
+
+	void AlignBinaryData()
+	{
+		m_binaryData.resize(math::Utils::RoundUp<SizeType>(m_binaryData.size(), 4u), Byte(0));
+	}
+
+	nlohmann::json          m_document;
+	lib::DynamicArray<Byte> m_binaryData;
+};
+
+
+static nlohmann::json CreatePrimitive(Int32 indices, Int32 locations, Int32 normals = -1, Int32 tangents = -1, Int32 uvs = -1)
+{
+	nlohmann::json attributes = { { "POSITION", locations } };
+
+	if (normals >= 0)  { attributes["NORMAL"]     = normals; }
+	if (tangents >= 0) { attributes["TANGENT"]    = tangents; }
+	if (uvs >= 0)      { attributes["TEXCOORD_0"] = uvs; }
+
+	return { { "indices", indices }, { "material", 0 }, { "attributes", std::move(attributes) } };
+}
+
+
+struct Vertex
+{
+	math::Vector3f location;
+	math::Vector3f normal;
+};
+
+
+template<typename TCallable>
+Real64 MeasureTimeMs(TCallable&& callable)
+{
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+	callable();
+	return std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+}
+
+} // priv
+
+
+TEST(GLTFGeometryTests, PackedDataIsNotCopied)
+{
+	const priv::TempDirectory directory;
+	const lib::Path path = directory.GetPath() / "Triangle.glb";
+
+	const Uint32         indices[]   = { 0u, 1u, 2u };
+	const math::Vector3f locations[] = { math::Vector3f(0.f, 0.f, 0.f), math::Vector3f(1.f, 0.f, 0.f), math::Vector3f(0.f, 1.f, 0.f) };
+
+	priv::GLTFWriter writer;
+	const Uint32 indicesView   = writer.AddBufferView(lib::Span<const Uint32>(indices));
+	const Uint32 locationsView = writer.AddBufferView(lib::Span<const math::Vector3f>(locations));
+	const Uint32 indicesAccessor   = writer.AddAccessor(indicesView, 0u, EGLTFComponentType::UnsignedInt, 3u, "SCALAR");
+	const Uint32 locationsAccessor = writer.AddAccessor(locationsView, 0u, EGLTFComponentType::Float, 3u, "VEC3");
+	writer.AddMesh("Triangle", nlohmann::json::array({ priv::CreatePrimitive(indicesAccessor, locationsAccessor) }));
+	writer.WriteGLB(path);
+
+	const std::optional<GLTFGeometry> geometry = LoadGLTFGeometry(path.string());
+	ASSERT_TRUE(geometry.has_value());
+	ASSERT_EQ(geometry->GetMeshes().size(), 1u);
+	EXPECT_EQ(geometry->GetMeshes()[0].name, "Triangle");
+	ASSERT_EQ(geometry->GetMeshes()[0].primitives.size(), 1u);
+
+	const GLTFPrimitiveGeometry& primitive = geometry->GetMeshes()[0].primitives[0];
+	EXPECT_EQ(primitive.material, 0);
+	EXPECT_FALSE(primitive.normals.IsValid());
+
+	GLTFDecodedPrimitive decoded;
+	DecodeGLTFPrimitive(primitive, decoded);
+
+	// Decoded data must point directly to mapped file
+	EXPECT_EQ(reinterpret_cast<const Byte*>(decoded.indices.data()), primitive.indices.data);
+	EXPECT_EQ(reinterpret_cast<const Byte*>(decoded.locations.data()), primitive.locations.data);
+	EXPECT_TRUE(decoded.indicesStorage.empty());
+	EXPECT_TRUE(decoded.locationsStorage.empty());
+
+	ASSERT_EQ(decoded.indices.size(), 3u);
+	ASSERT_EQ(decoded.locations.size(), 3u);
+	EXPECT_EQ(decoded.indices[2], 2u);
+	EXPECT_EQ(decoded.locations[1], locations[1]);
+}
+
+TEST(GLTFGeometryTests, InterleavedAttributesAreConverted)
+{
+	const priv::TempDirectory directory;
+	const lib::Path path = directory.GetPath() / "Interleaved.glb";
+
+	const Uint16 indices[] = { 0u, 1u, 2u, 2u, 1u, 3u };
+
+	const priv::Vertex vertices[] =
+	{
+		{ math::Vector3f(0.f, 0.f, 0.f), math::Vector3f(0.f, 0.f, 1.f) },
+		{ math::Vector3f(1.f, 0.f, 0.f), math::Vector3f(0.f, 0.f, 1.f) },
+		{ math::Vector3f(0.f, 1.f, 0.f), math::Vector3f(0.f, 1.f, 0.f) },
+		{ math::Vector3f(1.f, 1.f, 0.f), math::Vector3f(1.f, 0.f, 0.f) }
+	};
+
+	const Uint8 uvs[] = { 0u, 0u, 255u, 0u, 0u, 255u, 255u, 255u };
+
+	priv::GLTFWriter writer;
+	const Uint32 indicesView  = writer.AddBufferView(lib::Span<const Uint16>(indices));
+	const Uint32 verticesView = writer.AddBufferView(lib::Span<const priv::Vertex>(vertices), sizeof(priv::Vertex));
+	const Uint32 uvsView      = writer.AddBufferView(lib::Span<const Uint8>(uvs));
+
+	const Uint32 indicesAccessor   = writer.AddAccessor(indicesView, 0u, EGLTFComponentType::UnsignedShort, 6u, "SCALAR");
+	const Uint32 locationsAccessor = writer.AddAccessor(verticesView, offsetof(priv::Vertex, location), EGLTFComponentType::Float, 4u, "VEC3");
+	const Uint32 normalsAccessor   = writer.AddAccessor(verticesView, offsetof(priv::Vertex, normal), EGLTFComponentType::Float, 4u, "VEC3");
+	const Uint32 uvsAccessor       = writer.AddAccessor(uvsView, 0u, EGLTFComponentType::UnsignedByte, 4u, "VEC2", true);
+
+	writer.AddMesh("Quad", nlohmann::json::array({ priv::CreatePrimitive(indicesAccessor, locationsAccessor, normalsAccessor, -1, uvsAccessor) }));
+	writer.WriteGLB(path);
+
+	const std::optional<GLTFGeometry> geometry = LoadGLTFGeometry(path.string());
+	ASSERT_TRUE(geometry.has_value());
+
+	const GLTFPrimitiveGeometry& primitive = geometry->GetMeshes()[0].primitives[0];
+	EXPECT_EQ(primitive.locations.stride, sizeof(priv::Vertex));
+	EXPECT_TRUE((primitive.locations.TryGetPackedSpan<math::Vector3f, Real32>().empty()));
+
+	lib::DynamicArray<Real32> normalValues(primitive.normals.GetValuesNum());
+	primitive.normals.ReadValues<Real32>(normalValues);
+	EXPECT_EQ(normalValues[7], 1.f);
+	EXPECT_EQ(normalValues[9], 1.f);
+
+	lib::DynamicArray<Real32> uvValues(primitive.uvs.GetValuesNum());
+	primitive.uvs.ReadValues<Real32>(uvValues);
+	EXPECT_EQ(uvValues[0], 0.f);
+	EXPECT_EQ(uvValues[2], 1.f);
+
+	GLTFDecodedPrimitive decoded;
+	DecodeGLTFPrimitive(primitive, decoded);
+
+	ASSERT_EQ(decoded.indices.size(), 6u);
+	EXPECT_EQ(decoded.indices[5], 3u);
+	EXPECT_EQ(decoded.indicesStorage.size(), 6u);
+
+	ASSERT_EQ(decoded.locations.size(), 4u);
+	EXPECT_EQ(decoded.locations[3], vertices[3].location);
+
+	EXPECT_EQ(decoded.encodedNormals.size(), 4u);
+	EXPECT_EQ(decoded.encodedUVs.size(), 4u);
+	EXPECT_EQ(decoded.uvsMin, math::Vector2f(0.f, 0.f));
+	EXPECT_EQ(decoded.uvsRange, math::Vector2f(1.f, 1.f));
+}
+
+TEST(GLTFGeometryTests, ExternalBufferIsMapped)
+{
+	const priv::TempDirectory directory;
+	const lib::Path path = directory.GetPath() / "External.gltf";
+
+	const Uint32         indices[]   = { 0u, 2u, 1u };
+	const math::Vector3f locations[] = { math::Vector3f(0.f, 0.f, 0.f), math::Vector3f(0.f, 0.f, 1.f), math::Vector3f(0.f, 1.f, 0.f) };
+
+	priv::GLTFWriter writer;
+	const Uint32 indicesView   = writer.AddBufferView(lib::Span<const Uint32>(indices));
+	const Uint32 locationsView = writer.AddBufferView(lib::Span<const math::Vector3f>(locations));
+	const Uint32 indicesAccessor   = writer.AddAccessor(indicesView, 0u, EGLTFComponentType::UnsignedInt, 3u, "SCALAR");
+	const Uint32 locationsAccessor = writer.AddAccessor(locationsView, 0u, EGLTFComponentType::Float, 3u, "VEC3");
+	writer.AddMesh("Triangle", nlohmann::json::array({ priv::CreatePrimitive(indicesAccessor, locationsAccessor) }));
+	writer.WriteGLTF(path, "External Data.bin", "External%20Data.bin");
+
+	const std::optional<GLTFGeometry> geometry = LoadGLTFGeometry(path.string());
+	ASSERT_TRUE(geometry.has_value());
+
+	const GLTFPrimitiveGeometry& primitive = geometry->GetMeshes()[0].primitives[0];
+
+	const lib::Span<const Uint32> loadedIndices = primitive.indices.TryGetPackedSpan<Uint32>();
+	ASSERT_EQ(loadedIndices.size(), 3u);
+	EXPECT_EQ(loadedIndices[1], 2u);
+
+	const lib::Span<const math::Vector3f> loadedLocations = primitive.locations.TryGetPackedSpan<math::Vector3f, Real32>();
+	ASSERT_EQ(loadedLocations.size(), 3u);
+	EXPECT_EQ(loadedLocations[1], locations[1]);
+}
+
+TEST(GLTFGeometryTests, InvalidFilesAreRejected)
+{
+	const priv::TempDirectory directory;
+
+	const Uint32 indices[] = { 0u, 1u, 2u };
+
+	// Accessor reads more elements than buffer view contains
+	priv::GLTFWriter writer;
+	const Uint32 indicesView = writer.AddBufferView(lib::Span<const Uint32>(indices));
+	writer.AddAccessor(indicesView, 0u, EGLTFComponentType::UnsignedInt, 4u, "SCALAR");
+	writer.WriteGLB(directory.GetPath() / "OutOfBounds.glb");
+
+	EXPECT_FALSE(LoadGLTFGeometry((directory.GetPath() / "OutOfBounds.glb").string()).has_value());
+
+	std::ofstream(directory.GetPath() / "InvalidHeader.glb") << "Not a glTF file";
+	EXPECT_FALSE(LoadGLTFGeometry((directory.GetPath() / "InvalidHeader.glb").string()).has_value());
+
+	std::ofstream(directory.GetPath() / "InvalidJSON.gltf") << "{ \"meshes\": [";
+	EXPECT_FALSE(LoadGLTFGeometry((directory.GetPath() / "InvalidJSON.gltf").string()).has_value());
+
+	EXPECT_FALSE(LoadGLTFGeometry((directory.GetPath() / "Missing.glb").string()).has_value());
+}
+
+TEST(GLTFGeometryTests, LargeSceneDecodeBenchmark)
+{
+	constexpr Uint32 primitivesNum           = 8192u;
+	constexpr Uint32 verticesPerPrimitiveDim = 12u;
+	constexpr Uint32 verticesPerPrimitive    = verticesPerPrimitiveDim * verticesPerPrimitiveDim;
+	constexpr Uint32 quadsPerPrimitive       = (verticesPerPrimitiveDim - 1u) * (verticesPerPrimitiveDim - 1u);
+	constexpr Uint32 indicesPerPrimitive     = quadsPerPrimitive * 6u;
+
+	const priv::TempDirectory directory;
+	const lib::Path path = directory.GetPath() / "LargeScene.glb";
+
+	// Generate grid patches. All primitives share buffer views, each has its own accessors, as in typical exported scenes
+	{
+		lib::DynamicArray<Uint16>         indices;
+		lib::DynamicArray<math::Vector3f> locations;
+		lib::DynamicArray<math::Vector3f> normals;
+		lib::DynamicArray<math::Vector4f> tangents;
+		lib::DynamicArray<math::Vector2f> uvs;
+
+		indices.reserve(static_cast<SizeType>(primitivesNum) * indicesPerPrimitive);
+		locations.reserve(static_cast<SizeType>(primitivesNum) * verticesPerPrimitive);
+
+		for (Uint32 primitiveIdx = 0u; primitiveIdx < primitivesNum; ++primitiveIdx)
+		{
+			const Real32 height = static_cast<Real32>(primitiveIdx % 64u);
+
+			for (Uint32 y = 0u; y < verticesPerPrimitiveDim; ++y)
+			{
+				for (Uint32 x = 0u; x < verticesPerPrimitiveDim; ++x)
+				{
+					const math::Vector2f uv = math::Vector2f(static_cast<Real32>(x), static_cast<Real32>(y)) / static_cast<Real32>(verticesPerPrimitiveDim - 1u);
+					locations.emplace_back(uv.x(), height + std::sin(uv.x() * 3.f), uv.y());
+					normals.emplace_back(math::Vector3f(-std::cos(uv.x() * 3.f), 1.f, 0.f).normalized());
+					tangents.emplace_back(1.f, 0.f, 0.f, 1.f);
+					uvs.emplace_back(uv);
+				}
+			}
+
+			for (Uint32 y = 0u; y + 1u < verticesPerPrimitiveDim; ++y)
+			{
+				for (Uint32 x = 0u; x + 1u < verticesPerPrimitiveDim; ++x)
+				{
+					const Uint16 v0 = static_cast<Uint16>(y * verticesPerPrimitiveDim + x);
+					const Uint16 v1 = static_cast<Uint16>(v0 + 1u);
+					const Uint16 v2 = static_cast<Uint16>(v0 + verticesPerPrimitiveDim);
+					const Uint16 v3 = static_cast<Uint16>(v2 + 1u);
+					indices.insert(indices.end(), { v0, v2, v1, v1, v2, v3 });
+				}
+			}
+		}
+
+		priv::GLTFWriter writer;
+		const Uint32 indicesView   = writer.AddBufferView(lib::Span<const Uint16>(indices));
+		const Uint32 locationsView = writer.AddBufferView(lib::Span<const math::Vector3f>(locations));
+		const Uint32 normalsView   = writer.AddBufferView(lib::Span<const math::Vector3f>(normals));
+		const Uint32 tangentsView  = writer.AddBufferView(lib::Span<const math::Vector4f>(tangents));
+		const Uint32 uvsView       = writer.AddBufferView(lib::Span<const math::Vector2f>(uvs));
+
+		nlohmann::json primitives = nlohmann::json::array();
+
+		for (Uint32 primitiveIdx = 0u; primitiveIdx < primitivesNum; ++primitiveIdx)
+		{
+			const SizeType firstIndex  = static_cast<SizeType>(primitiveIdx) * indicesPerPrimitive;
+			const SizeType firstVertex = static_cast<SizeType>(primitiveIdx) * verticesPerPrimitive;
+
+			primitives.push_back(priv::CreatePrimitive(writer.AddAccessor(indicesView, firstIndex * sizeof(Uint16), EGLTFComponentType::UnsignedShort, indicesPerPrimitive, "SCALAR"),
+													   writer.AddAccessor(locationsView, firstVertex * sizeof(math::Vector3f), EGLTFComponentType::Float, verticesPerPrimitive, "VEC3"),
+													   writer.AddAccessor(normalsView, firstVertex * sizeof(math::Vector3f), EGLTFComponentType::Float, verticesPerPrimitive, "VEC3"),
+													   writer.AddAccessor(tangentsView, firstVertex * sizeof(math::Vector4f), EGLTFComponentType::Float, verticesPerPrimitive, "VEC4"),
+													   writer.AddAccessor(uvsView, firstVertex * sizeof(math::Vector2f), EGLTFComponentType::Float, verticesPerPrimitive, "VEC2")));
+		}
+
+		writer.AddMesh("LargeScene", std::move(primitives));
+		writer.WriteGLB(path);
+	}
+
+	const SizeType fileSize = std::filesystem::file_size(path);
+
+	std::optional<GLTFGeometry> geometry;
+	const Real64 loadMs = priv::MeasureTimeMs([&] { geometry = LoadGLTFGeometry(path.string()); });
+
+	ASSERT_TRUE(geometry.has_value());
+	ASSERT_EQ(geometry->GetMeshes()[0].primitives.size(), primitivesNum);
+
+	const lib::DynamicArray<GLTFPrimitiveGeometry>& primitives = geometry->GetMeshes()[0].primitives;
+
+	lib::DynamicArray<const GLTFPrimitiveGeometry*> primitivePtrs;
+	for (const GLTFPrimitiveGeometry& primitive : primitives)
+	{
+		primitivePtrs.emplace_back(&primitive);
+	}
+
+	// Previous path - primitives are converted one after another on calling thread
+	lib::DynamicArray<GLTFDecodedPrimitive> sequentialDecoded(primitivesNum);
+	const Real64 sequentialDecodeMs = priv::MeasureTimeMs([&]
+														  {
+															  for (Uint32 primitiveIdx = 0u; primitiveIdx < primitivesNum; ++primitiveIdx)
+															  {
+																  DecodeGLTFPrimitive(primitives[primitiveIdx], sequentialDecoded[primitiveIdx]);
+															  }
+														  });
+
+	lib::DynamicArray<GLTFDecodedPrimitive> parallelDecoded(primitivesNum);
+	const Real64 parallelDecodeMs = priv::MeasureTimeMs([&] { DecodeGLTFPrimitives(primitivePtrs, parallelDecoded); });
+
+	for (Uint32 primitiveIdx = 0u; primitiveIdx < primitivesNum; primitiveIdx += 97u)
+	{
+		const GLTFDecodedPrimitive& sequential = sequentialDecoded[primitiveIdx];
+		const GLTFDecodedPrimitive& parallel   = parallelDecoded[primitiveIdx];
+
+		ASSERT_EQ(parallel.indices.size(), indicesPerPrimitive);
+		EXPECT_TRUE(std::equal(sequential.indices.begin(), sequential.indices.end(), parallel.indices.begin()));
+		EXPECT_EQ(parallel.locations.data(), sequential.locations.data());
+		EXPECT_EQ(parallel.encodedNormals, sequential.encodedNormals);
+		EXPECT_EQ(parallel.encodedTangents, sequential.encodedTangents);
+		EXPECT_EQ(parallel.encodedUVs, sequential.encodedUVs);
+	}
+
+	const Real64 fileSizeMB = static_cast<Real64>(fileSize) / (1024.0 * 1024.0);
+
+	RecordProperty("FileSizeMB",         std::to_string(fileSizeMB));
+	RecordProperty("LoadMs",             std::to_string(loadMs));
+	RecordProperty("SequentialDecodeMs", std::to_string(sequentialDecodeMs));
+	RecordProperty("ParallelDecodeMs",   std::to_string(parallelDecodeMs));
+}
+
+} // spt::rsc::tests
+
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	using namespace spt;
+
+	js::JobSystemInitializationParams jobSystemInitParams;
+	jobSystemInitParams.workerThreadsNum = static_cast<SizeType>(std::thread::hardware_concurrency() - 1u);
+	js::JobSystem::Initialize(jobSystemInitParams);
+
+	const auto testsResult = RUN_ALL_TESTS();
+
+	js::JobSystem::Shutdown();
+
+	return testsResult;
+}
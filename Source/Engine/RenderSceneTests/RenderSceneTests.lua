@@ -0,0 +1,10 @@
+RenderSceneTests = Project:CreateProject("RenderSceneTests", ETargetType.Application)
+
+function RenderSceneTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("RenderScene")
+    self:AddPrivateDependency("JobSystem")
+    self:AddPrivateDependency("JSON")
+    self:AddPrivateDependency("GoogleTest")
+end
+
+RenderSceneTests:SetupProject()
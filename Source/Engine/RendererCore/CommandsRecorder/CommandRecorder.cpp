@@ -57,6 +57,11 @@ void CommandRecorder::WaitEvent(const lib::SharedRef<GPUEvent>& event, rhi::RHID
 	dependency.WaitEvent(GetCommandBufferRHI(), event->GetRHI());
 }
 
+void CommandRecorder::ResetEvent(const lib::SharedRef<GPUEvent>& event, const rhi::RHIDependency& dependency)
+{
+	dependency.ResetEvent(GetCommandBufferRHI(), event->GetRHI());
+}
+
 void CommandRecorder::BindDescriptorHeap(const DescriptorHeap& descriptorHeap)
 {
 	GetCommandBufferRHI().BindDescriptorHeap(descriptorHeap.GetRHI());
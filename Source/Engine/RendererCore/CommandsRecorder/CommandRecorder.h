@@ -42,6 +42,7 @@ public:
 
 	void									SetEvent(const lib::SharedRef<GPUEvent>& event, rhi::RHIDependency& dependency);
 	void									WaitEvent(const lib::SharedRef<GPUEvent>& event, rhi::RHIDependency& dependency);
+	void									ResetEvent(const lib::SharedRef<GPUEvent>& event, const rhi::RHIDependency& dependency);
 
 	void									BindDescriptorHeap(const DescriptorHeap& descriptorHeap);
 
@@ -12,6 +12,7 @@
 #include "JobSystem.h"
 #include "ResourcesManager.h"
 #include "Types/DescriptorSetState/DescriptorManager.h"
+#include "Types/DescriptorSetState/DescriptorSetRangesCache.h"
 #include "Pipelines/PSOsLibrary.h"
 #include "Utils/TransfersManager.h"
 
@@ -36,6 +37,8 @@ struct GPUApiData
 	GPUReleaseQueue releasesQueue;
 
 	DescriptorSetStateLayoutsRegistry dsLayoutsRegistry;
+
+	DescriptorSetRangesCache dsRangesCache;
 	
 	lib::SharedPtr<DescriptorHeap> descriptorHeap;
 	
@@ -165,8 +168,12 @@ void GPUApi::Uninitialize()
 
 	GetPipelinesCache().ClearCachedPipelines();
 
+	PSOsLibrary::GetInstance().SaveWarmList();
+
 	GetShadersManager().Uninitialize();
 
+	g_GPUApiData->dsRangesCache.Uninitialize();
+
 	ScheduleFlushDeferredReleases(EDeferredReleasesFlushFlags::Immediate);
 
 	g_GPUApiData->descriptorsManager.reset();
@@ -178,6 +185,11 @@ void GPUApi::Uninitialize()
 	rhi::RHI::Uninitialize();
 }
 
+Bool GPUApi::IsInitialized()
+{
+	return !!g_GPUApiData;
+}
+
 GPUApiData* GPUApi::GetGPUApiData()
 {
 	SPT_CHECK(!!g_GPUApiData);
@@ -263,6 +275,11 @@ DescriptorSetStateLayoutsRegistry& GPUApi::GetDSLayoutsRegistry()
 	return g_GPUApiData->dsLayoutsRegistry;
 }
 
+DescriptorSetRangesCache& GPUApi::GetDescriptorSetRangesCache()
+{
+	return g_GPUApiData->dsRangesCache;
+}
+
 const lib::SharedPtr<DescriptorSetLayout>& GPUApi::GetShaderParamsDSLayout()
 {
 	return g_GPUApiData->shaderParamsDSLayout;
@@ -314,6 +331,12 @@ void GPUApi::FlushReadyReleases()
 	{
 		queue.Broadcast();
 	}
+
+	// Descriptors released by executed entries are returned to allocator at once
+	if (g_GPUApiData->descriptorsManager)
+	{
+		g_GPUApiData->descriptorsManager->FlushDeferredDescriptorFrees();
+	}
 }
 
 void GPUApi::FlushPendingEvents()
@@ -26,6 +26,7 @@ class DescriptorManager;
 class DescriptorSetLayout;
 class TransfersManager;
 class DescriptorSetStateLayoutsRegistry;
+class DescriptorSetRangesCache;
 
 struct GPUApiData;
 
@@ -49,6 +50,9 @@ public:
 	static void									Initialize();
 	static void									Uninitialize();
 
+	/** Returns false when running without GPU (e.g. headless tools) */
+	static Bool									IsInitialized();
+
 	static GPUApiData*							GetGPUApiData();
 	static void									InitializeModule(GPUApiData& data);
 
@@ -69,6 +73,8 @@ public:
 
 	static DescriptorSetStateLayoutsRegistry&	GetDSLayoutsRegistry();
 
+	static DescriptorSetRangesCache&			GetDescriptorSetRangesCache();
+
 	static const lib::SharedPtr<DescriptorSetLayout>&	GetShaderParamsDSLayout();
 
 	static void									ReleaseDeferred(GPUReleaseQueue::ReleaseEntry entry);
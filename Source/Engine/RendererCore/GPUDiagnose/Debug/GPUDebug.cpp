@@ -35,6 +35,19 @@ GPUCheckpointValidator::GPUCheckpointValidator()
 
 void GPUCheckpointValidator::AddCheckpoint(CommandRecorder& recorder, const lib::HashedString& marker)
 {
+	WriteCheckpoint(recorder, RegisterCheckpoint(marker));
+}
+
+Uint32 GPUCheckpointValidator::RegisterCheckpoint(const lib::HashedString& marker)
+{
+	m_checkpointNames.emplace_back(marker);
+	return static_cast<Uint32>(m_checkpointNames.size());
+}
+
+void GPUCheckpointValidator::WriteCheckpoint(CommandRecorder& recorder, Uint32 checkpointValue)
+{
+	SPT_CHECK(checkpointValue > 0u && checkpointValue <= m_checkpointNames.size());
+
 	const auto pipelineFlush = [this, &recorder]()
 	{
 		rhi::RHIDependency dependency;
@@ -45,8 +58,7 @@ void GPUCheckpointValidator::AddCheckpoint(CommandRecorder& recorder, const lib:
 
 	pipelineFlush();
 
-	m_checkpointNames.emplace_back(marker);
-	recorder.FillBuffer(m_checkpointsBuffer, 0u, sizeof(Uint32), static_cast<Uint32>(m_checkpointNames.size()));
+	recorder.FillBuffer(m_checkpointsBuffer, 0u, sizeof(Uint32), checkpointValue);
 
 	pipelineFlush();
 }
@@ -32,6 +32,11 @@ public:
 	explicit GPUCheckpointValidator();
 
 	void AddCheckpoint(CommandRecorder& recorder, const lib::HashedString& marker);
+
+	/** Registers checkpoint without recording it. Allows reserving checkpoints in order, before they are recorded to multiple command buffers */
+	Uint32 RegisterCheckpoint(const lib::HashedString& marker);
+	void   WriteCheckpoint(CommandRecorder& recorder, Uint32 checkpointValue);
+
 	void ValidateExecution();
 
 private:
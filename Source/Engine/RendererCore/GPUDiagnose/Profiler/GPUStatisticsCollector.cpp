@@ -10,7 +10,8 @@ namespace spt::rdr
 // GPUStatisticsCollector ========================================================================
 
 GPUStatisticsCollector::GPUStatisticsCollector()
-	: m_timestampsQueryPool(CreateQueryPool(rhi::EQueryType::Timestamp, 16384u))
+	: m_rootCollector(nullptr)
+	, m_timestampsQueryPool(CreateQueryPool(rhi::EQueryType::Timestamp, 16384u))
 	, m_timestampsQueryPoolIndex(0)
 	, m_pipelineStatsQueryPool(CreateQueryPool(rhi::EQueryType::Statistics, 16384u, rhi::EQueryStatisticsType::All))
 	, m_pipelineStatsQueryPoolIndex(0)
@@ -20,24 +21,28 @@ GPUStatisticsCollector::GPUStatisticsCollector()
 	m_pipelineStatsQueryPool->Reset();
 }
 
+GPUStatisticsCollector::GPUStatisticsCollector(GPUStatisticsCollector& rootCollector)
+	: m_rootCollector(&rootCollector.GetRootCollector())
+	, m_timestampsQueryPool(rootCollector.m_timestampsQueryPool)
+	, m_timestampsQueryPoolIndex(0)
+	, m_pipelineStatsQueryPool(rootCollector.m_pipelineStatsQueryPool)
+	, m_pipelineStatsQueryPoolIndex(0)
+{ }
+
 void GPUStatisticsCollector::BeginScope(CommandRecorder& recoder, const lib::HashedString& scopeName, EQueryFlags queryFlags)
 {
-	lib::DynamicArray<GPUStatisticsScopeDefinition>& currentLevelScopes = !m_scopesInProgressStack.empty() ? m_scopesInProgressStack.back()->children : m_scopeDefinitions;
-	
-	const Uint32 beginTimestampIndex = m_timestampsQueryPoolIndex++;
-
-	recoder.WriteTimestamp(m_timestampsQueryPool, beginTimestampIndex, rhi::EPipelineStage::TopOfPipe);
-
-	GPUStatisticsScopeDefinition& newScope = currentLevelScopes.emplace_back(GPUStatisticsScopeDefinition(scopeName, beginTimestampIndex));
+	GPUStatisticsScopeDefinition& newScope = PushScopeDefinition(recoder, scopeName);
 
 	if (queryFlags != EQueryFlags::None)
 	{
 		constexpr Uint32 statisticsNum = 5;
+
+		const Uint32 pipelineStatsQueryIdx = GetRootCollector().m_pipelineStatsQueryPoolIndex.fetch_add(1u, std::memory_order_relaxed);
 		
-		const Uint32 statisticsBeginIndex = m_pipelineStatsQueryPoolIndex * statisticsNum;
-		recoder.BeginQuery(m_pipelineStatsQueryPool, m_pipelineStatsQueryPoolIndex);
+		const Uint32 statisticsBeginIndex = pipelineStatsQueryIdx * statisticsNum;
+		recoder.BeginQuery(m_pipelineStatsQueryPool, pipelineStatsQueryIdx);
 
-		newScope.pipelineStatisticsQueryIdx = m_pipelineStatsQueryPoolIndex++;
+		newScope.pipelineStatisticsQueryIdx = pipelineStatsQueryIdx;
 
 		if (lib::HasAnyFlag(queryFlags, EQueryFlags::Rasterization))
 		{
@@ -52,8 +57,6 @@ void GPUStatisticsCollector::BeginScope(CommandRecorder& recoder, const lib::Has
 			newScope.computeShaderInvocationsIdx = statisticsBeginIndex + 4;
 		}
 	}
-
-	m_scopesInProgressStack.emplace_back(&newScope);
 }
 
 void GPUStatisticsCollector::EndScope(CommandRecorder& recoder)
@@ -62,7 +65,7 @@ void GPUStatisticsCollector::EndScope(CommandRecorder& recoder)
 
 	GPUStatisticsScopeDefinition& currentScope = *m_scopesInProgressStack.back();
 
-	const Uint32 endTimestampIndex = m_timestampsQueryPoolIndex++;
+	const Uint32 endTimestampIndex = GetRootCollector().m_timestampsQueryPoolIndex.fetch_add(1u, std::memory_order_relaxed);
 	recoder.WriteTimestamp(m_timestampsQueryPool, endTimestampIndex, rhi::EPipelineStage::BottomOfPipe);
 
 	currentScope.endTimestampIndex = endTimestampIndex;
@@ -75,17 +78,36 @@ void GPUStatisticsCollector::EndScope(CommandRecorder& recoder)
 	m_scopesInProgressStack.pop_back();
 }
 
+void GPUStatisticsCollector::BeginContinuationScope(CommandRecorder& recoder, const lib::HashedString& scopeName)
+{
+	GPUStatisticsScopeDefinition& newScope = PushScopeDefinition(recoder, scopeName);
+	newScope.isContinuation = true;
+}
+
+void GPUStatisticsCollector::MergeRangeCollector(GPUStatisticsCollector& rangeCollector)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(rangeCollector.m_rootCollector == &GetRootCollector());
+	SPT_CHECK(m_scopesInProgressStack.empty());
+	SPT_CHECK(rangeCollector.m_scopesInProgressStack.empty());
+
+	MergeScopes(INOUT m_scopeDefinitions, std::move(rangeCollector.m_scopeDefinitions));
+	rangeCollector.m_scopeDefinitions.clear();
+}
+
 GPUStatisticsScopeData GPUStatisticsCollector::CollectStatistics()
 {
 	SPT_PROFILER_FUNCTION();
 
+	SPT_CHECK(!m_rootCollector);
 	SPT_CHECK(m_scopesInProgressStack.empty());
 
 	GPUStatisticsScopeData result;
 
 	StatisticsContext context;
-	context.timestamps			= m_timestampsQueryPool->GetRHI().GetResults(m_timestampsQueryPoolIndex);
-	context.pipelineStatistics	= m_pipelineStatsQueryPool->GetRHI().GetResults(m_pipelineStatsQueryPoolIndex);
+	context.timestamps			= m_timestampsQueryPool->GetRHI().GetResults(m_timestampsQueryPoolIndex.load());
+	context.pipelineStatistics	= m_pipelineStatsQueryPool->GetRHI().GetResults(m_pipelineStatsQueryPoolIndex.load());
 
 	if (!context.timestamps.empty())
 	{
@@ -124,6 +146,47 @@ lib::SharedRef<QueryPool> GPUStatisticsCollector::CreateQueryPool(rhi::EQueryTyp
 	return rdr::ResourcesManager::CreateQueryPool(queryPoolDef);
 }
 
+GPUStatisticsCollector& GPUStatisticsCollector::GetRootCollector()
+{
+	return m_rootCollector ? *m_rootCollector : *this;
+}
+
+GPUStatisticsScopeDefinition& GPUStatisticsCollector::PushScopeDefinition(CommandRecorder& recoder, const lib::HashedString& scopeName)
+{
+	lib::DynamicArray<GPUStatisticsScopeDefinition>& currentLevelScopes = !m_scopesInProgressStack.empty() ? m_scopesInProgressStack.back()->children : m_scopeDefinitions;
+
+	const Uint32 beginTimestampIndex = GetRootCollector().m_timestampsQueryPoolIndex.fetch_add(1u, std::memory_order_relaxed);
+
+	recoder.WriteTimestamp(m_timestampsQueryPool, beginTimestampIndex, rhi::EPipelineStage::TopOfPipe);
+
+	GPUStatisticsScopeDefinition& newScope = currentLevelScopes.emplace_back(GPUStatisticsScopeDefinition(scopeName, beginTimestampIndex));
+
+	m_scopesInProgressStack.emplace_back(&newScope);
+
+	return newScope;
+}
+
+void GPUStatisticsCollector::MergeScopes(INOUT lib::DynamicArray<GPUStatisticsScopeDefinition>& destScopes, lib::DynamicArray<GPUStatisticsScopeDefinition>&& srcScopes)
+{
+	auto srcIt = std::begin(srcScopes);
+
+	// Continuation scope extends scope that was opened in previous range, so we keep begin timestamp of the original scope
+	if (srcIt != std::end(srcScopes) && srcIt->isContinuation)
+	{
+		SPT_CHECK(!destScopes.empty());
+
+		GPUStatisticsScopeDefinition& continuedScope = destScopes.back();
+		SPT_CHECK(continuedScope.name == srcIt->name);
+
+		continuedScope.endTimestampIndex = srcIt->endTimestampIndex;
+		MergeScopes(INOUT continuedScope.children, std::move(srcIt->children));
+
+		++srcIt;
+	}
+
+	std::move(srcIt, std::end(srcScopes), std::back_inserter(destScopes));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // GPUStatisticsScope ============================================================================
 
@@ -96,6 +96,9 @@ struct GPUStatisticsScopeDefinition
 	Uint32 beginTimestampIndex;
 	Uint32 endTimestampIndex;
 
+	/** True if this scope continues scope that was opened by previous range collector */
+	Bool isContinuation = false;
+
 	std::optional<Uint32> pipelineStatisticsQueryIdx;
 
 	std::optional<Uint32> inputAsseblyVerticesIdx;
@@ -151,20 +154,40 @@ public:
 
 	GPUStatisticsCollector();
 
+	/**
+	 * Creates range collector that shares query pools with root collector.
+	 * Range collectors can be used to record statistics from different threads (single range collector is still not thread safe).
+	 * Recorded scopes must be merged back to the root using MergeRangeCollector in order of ranges submission
+	 */
+	explicit GPUStatisticsCollector(GPUStatisticsCollector& rootCollector);
+
 	void BeginScope(CommandRecorder& recoder, const lib::HashedString& scopeName, EQueryFlags queryFlags);
 	void EndScope(CommandRecorder& recoder);
 
+	/** Begins scope that continues the last scope on the same level that was recorded in the previous range */
+	void BeginContinuationScope(CommandRecorder& recoder, const lib::HashedString& scopeName);
+
+	void MergeRangeCollector(GPUStatisticsCollector& rangeCollector);
+
 	GPUStatisticsScopeData CollectStatistics();
 
 private:
 
 	lib::SharedRef<QueryPool> CreateQueryPool(rhi::EQueryType type, Uint32 queryCount, rhi::EQueryStatisticsType statisticsType = rhi::EQueryStatisticsType::None) const;
 
+	GPUStatisticsCollector& GetRootCollector();
+
+	GPUStatisticsScopeDefinition& PushScopeDefinition(CommandRecorder& recoder, const lib::HashedString& scopeName);
+
+	static void MergeScopes(INOUT lib::DynamicArray<GPUStatisticsScopeDefinition>& destScopes, lib::DynamicArray<GPUStatisticsScopeDefinition>&& srcScopes);
+
+	GPUStatisticsCollector* m_rootCollector;
+
 	lib::SharedRef<QueryPool> m_timestampsQueryPool;
-	Uint32 m_timestampsQueryPoolIndex;
+	std::atomic<Uint32> m_timestampsQueryPoolIndex;
 
 	lib::SharedRef<QueryPool> m_pipelineStatsQueryPool;
-	Uint32 m_pipelineStatsQueryPoolIndex;
+	std::atomic<Uint32> m_pipelineStatsQueryPoolIndex;
 
 	lib::DynamicArray<GPUStatisticsScopeDefinition> m_scopeDefinitions;
 
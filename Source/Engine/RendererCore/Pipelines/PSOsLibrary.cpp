@@ -1,6 +1,8 @@
 #include "PSOsLibrary.h"
 #include "ResourcesManager.h"
 #include "JobSystem.h"
+#include "Engine.h"
+#include "Common/ShaderCompilationEnvironment.h"
 
 
 SPT_DEFINE_LOG_CATEGORY(PSOsLibrary, true);
@@ -8,6 +10,16 @@ SPT_DEFINE_LOG_CATEGORY(PSOsLibrary, true);
 namespace spt::rdr
 {
 
+namespace priv
+{
+
+static lib::Path GetWarmListFilePath()
+{
+	return engn::GetEngine().GetPaths().pipelineCachePath / "PSOsWarmList.bin";
+}
+
+} // priv
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // PSOsPrecachingCompiler ========================================================================
 
@@ -164,7 +176,40 @@ void PSOsLibrary::PrecachePSOs(const PSOPrecacheParams& precacheParams)
 		precache(compiler, precacheParams);
 	}
 
+	if (!m_isWarmListLoaded)
+	{
+		m_isWarmListLoaded = true;
+
+		if (m_warmList.LoadFromFile(priv::GetWarmListFilePath()))
+		{
+			// Compiling shader that doesn't exist anymore would block startup
+			const SizeType removedPipelinesNum = m_warmList.RemovePipelinesWithMissingShaders(sc::ShaderCompilationEnvironment::GetShadersPath());
+
+			SPT_LOG_INFO(PSOsLibrary, "Loaded PSOs warm list: {} compute PSOs, {} graphics PSOs ({} removed)",
+						 m_warmList.GetComputePipelinesNum(),
+						 m_warmList.GetGraphicsPipelinesNum(),
+						 removedPipelinesNum);
+
+			m_warmList.ScheduleCompilation(compiler);
+		}
+	}
+
 	compiler.ExecutePrecaching();
 }
 
+PSOsWarmList& PSOsLibrary::GetWarmList()
+{
+	return m_warmList;
+}
+
+void PSOsLibrary::SaveWarmList() const
+{
+	SPT_PROFILER_FUNCTION();
+
+	if (m_warmList.GetComputePipelinesNum() > 0u || m_warmList.GetGraphicsPipelinesNum() > 0u)
+	{
+		m_warmList.SaveToFile(priv::GetWarmListFilePath());
+	}
+}
+
 } // spt::rdr
\ No newline at end of file
@@ -16,11 +16,18 @@ public:
 
 	void PrecachePSOs(const PSOPrecacheParams& precacheParams);
 
+	PSOsWarmList& GetWarmList();
+
+	void SaveWarmList() const;
+
 private:
 
 	PSOsLibrary() = default;
 
 	lib::DynamicArray<PSOPrecacheFunction> m_registeredPSOs;
+
+	PSOsWarmList m_warmList;
+	Bool         m_isWarmListLoaded = false;
 };
 
 } // spt::rdr
@@ -8,16 +8,34 @@ namespace spt::rdr
 
 ShaderID PSOImmediateCompiler::CompileShader(const lib::String& shaderRelativePath, const sc::ShaderStageCompilationDef& shaderStageDef, const sc::ShaderCompilationSettings& compilationSettings)
 {
-	return ResourcesManager::CreateShader(shaderRelativePath, shaderStageDef, compilationSettings);
+	const ShaderID shader = ResourcesManager::CreateShader(shaderRelativePath, shaderStageDef, compilationSettings);
+
+	m_compiledShaders[shader] = PSOWarmListShader{ shaderRelativePath, shaderStageDef, compilationSettings };
+
+	return shader;
 }
 
 PipelineStateID PSOImmediateCompiler::CreateComputePipeline(const RendererResourceName& name, const rdr::ShaderID& shader)
 {
+	PSOWarmListComputePipeline warmListPipeline;
+	warmListPipeline.name          = name.Get();
+	warmListPipeline.computeShader = GetWarmListShader(shader);
+	PSOsLibrary::GetInstance().GetWarmList().RecordComputePipeline(std::move(warmListPipeline));
+
 	return ResourcesManager::CreateComputePipeline(name, shader);
 }
 
 PipelineStateID PSOImmediateCompiler::CreateGraphicsPipeline(const RendererResourceName& name, const GraphicsPipelineShaders& shaders, const rhi::GraphicsPipelineDefinition& pipelineDef)
 {
+	PSOWarmListGraphicsPipeline warmListPipeline;
+	warmListPipeline.name           = name.Get();
+	warmListPipeline.vertexShader   = GetWarmListShader(shaders.vertexShader);
+	warmListPipeline.taskShader     = GetWarmListShader(shaders.taskShader);
+	warmListPipeline.meshShader     = GetWarmListShader(shaders.meshShader);
+	warmListPipeline.fragmentShader = GetWarmListShader(shaders.fragmentShader);
+	warmListPipeline.pipelineDef    = pipelineDef;
+	PSOsLibrary::GetInstance().GetWarmList().RecordGraphicsPipeline(std::move(warmListPipeline));
+
 	return ResourcesManager::CreateGfxPipeline(name, shaders, pipelineDef);
 }
 
@@ -26,6 +44,20 @@ PipelineStateID PSOImmediateCompiler::CreateRayTracingPipeline(const RendererRes
 	return ResourcesManager::CreateRayTracingPipeline(name, shaders, pipelineDef);
 }
 
+PSOWarmListShader PSOImmediateCompiler::GetWarmListShader(ShaderID shader) const
+{
+	if (!shader.IsValid())
+	{
+		return PSOWarmListShader{};
+	}
+
+	// All shaders used by pipelines must be compiled by the same compiler
+	const auto foundShader = m_compiledShaders.find(shader);
+	SPT_CHECK(foundShader != std::cend(m_compiledShaders));
+
+	return foundShader->second;
+}
+
 void RegisterPSO(PSOPrecacheFunction callable)
 {
 	PSOsLibrary::GetInstance().RegisterPSO(callable);
@@ -2,6 +2,7 @@
 
 #include "SculptorCoreTypes.h"
 #include "PipelineState.h"
+#include "PSOsWarmList.h"
 #include "Common/ShaderCompilationInput.h"
 #include "Utility/Templates/Callable.h"
 #include "ShaderStructs.h"
@@ -177,6 +178,7 @@ public:
 };
 
 
+/** Compiles pipelines at runtime. Compiled pipelines are recorded in the warm list, so they are precached in next sessions */
 class PSOImmediateCompiler : public PSOCompilerInterface
 {
 public:
@@ -186,6 +188,12 @@ public:
 	virtual PipelineStateID CreateComputePipeline(const RendererResourceName& name, const rdr::ShaderID& shader) override;
 	virtual PipelineStateID CreateGraphicsPipeline(const RendererResourceName& name, const GraphicsPipelineShaders& shaders, const rhi::GraphicsPipelineDefinition& pipelineDef) override;
 	virtual PipelineStateID CreateRayTracingPipeline(const RendererResourceName& name, const RayTracingPipelineShaders& shaders, const rhi::RayTracingPipelineDefinition& pipelineDef) override;
+
+private:
+
+	PSOWarmListShader GetWarmListShader(ShaderID shader) const;
+
+	lib::HashMap<ShaderID, PSOWarmListShader> m_compiledShaders;
 };
 
 
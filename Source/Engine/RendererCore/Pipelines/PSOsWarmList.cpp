@@ -0,0 +1,374 @@
+#include "PSOsWarmList.h"
+#include "PSOsLibraryTypes.h"
+#include "SerializationHelper.h"
+
+
+namespace spt::rdr
+{
+
+namespace priv
+{
+
+/** Must be increased whenever serialized data changes */
+static constexpr Uint32 warmListVersion = 1u;
+
+
+template<typename TEnum>
+static void SerializeEnum(srl::Serializer& serializer, const char* name, TEnum& value)
+{
+	Uint32 serializedValue = static_cast<Uint32>(value);
+	serializer.Serialize(name, serializedValue);
+	value = static_cast<TEnum>(serializedValue);
+}
+
+
+struct SerializedColorRenderTarget
+{
+	void Serialize(srl::Serializer& serializer)
+	{
+		SerializeEnum(serializer, "Format", definition.format);
+		SerializeEnum(serializer, "ColorBlendType", definition.colorBlendType);
+		SerializeEnum(serializer, "AlphaBlendType", definition.alphaBlendType);
+		SerializeEnum(serializer, "ColorWriteMask", definition.colorWriteMask);
+	}
+
+	rhi::ColorRenderTargetDefinition definition;
+};
+
+
+static void SerializePipelineDefinition(srl::Serializer& serializer, rhi::GraphicsPipelineDefinition& pipelineDef)
+{
+	SerializeEnum(serializer, "PrimitiveTopology", pipelineDef.primitiveTopology);
+
+	SerializeEnum(serializer, "PolygonMode", pipelineDef.rasterizationDefinition.polygonMode);
+	SerializeEnum(serializer, "CullMode", pipelineDef.rasterizationDefinition.cullMode);
+	SerializeEnum(serializer, "RasterizationType", pipelineDef.rasterizationDefinition.rasterizationType);
+
+	serializer.Serialize("SamplesNum", pipelineDef.multisamplingDefinition.samplesNum);
+
+	rhi::PipelineRenderTargetsDefinition& renderTargetsDef = pipelineDef.renderTargetsDefinition;
+
+	lib::DynamicArray<SerializedColorRenderTarget> colorRTs;
+	if (serializer.IsSaving())
+	{
+		std::transform(std::cbegin(renderTargetsDef.colorRTsDefinition), std::cend(renderTargetsDef.colorRTsDefinition),
+					   std::back_inserter(colorRTs),
+					   [](const rhi::ColorRenderTargetDefinition& definition)
+					   {
+						   return SerializedColorRenderTarget{ definition };
+					   });
+	}
+
+	serializer.Serialize("ColorRTs", colorRTs);
+
+	if (serializer.IsLoading())
+	{
+		renderTargetsDef.colorRTsDefinition.clear();
+		std::transform(std::cbegin(colorRTs), std::cend(colorRTs),
+					   std::back_inserter(renderTargetsDef.colorRTsDefinition),
+					   [](const SerializedColorRenderTarget& colorRT)
+					   {
+						   return colorRT.definition;
+					   });
+	}
+
+	SerializeEnum(serializer, "DepthFormat", renderTargetsDef.depthRTDefinition.format);
+	SerializeEnum(serializer, "DepthCompareOp", renderTargetsDef.depthRTDefinition.depthCompareOp);
+	serializer.Serialize("DepthWrite", renderTargetsDef.depthRTDefinition.enableDepthWrite);
+
+	SerializeEnum(serializer, "StencilFormat", renderTargetsDef.stencilRTDefinition.format);
+}
+
+
+struct WarmListData
+{
+	void Serialize(srl::Serializer& serializer)
+	{
+		serializer.Serialize("Version", version);
+		serializer.Serialize("ComputePipelines", computePipelines);
+		serializer.Serialize("GraphicsPipelines", graphicsPipelines);
+	}
+
+	Uint32                                         version = 0u;
+	lib::DynamicArray<PSOWarmListComputePipeline>  computePipelines;
+	lib::DynamicArray<PSOWarmListGraphicsPipeline> graphicsPipelines;
+};
+
+} // priv
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// PSOWarmListShader =============================================================================
+
+SizeType PSOWarmListShader::Hash() const
+{
+	return lib::HashCombine(shaderRelativePath, stageDef, compilationSettings.Hash());
+}
+
+void PSOWarmListShader::Serialize(srl::Serializer& serializer)
+{
+	serializer.Serialize("Path", shaderRelativePath);
+
+	priv::SerializeEnum(serializer, "Stage", stageDef.stage);
+	serializer.Serialize("EntryPoint", stageDef.entryPoint);
+
+	lib::DynamicArray<lib::HashedString> macros;
+	Bool generateDebugSource = true;
+
+	if (serializer.IsSaving())
+	{
+		macros              = compilationSettings.GetMacros();
+		generateDebugSource = compilationSettings.ShouldGenerateDebugSource();
+	}
+
+	serializer.Serialize("Macros", macros);
+	serializer.Serialize("GenerateDebugSource", generateDebugSource);
+
+	if (serializer.IsLoading())
+	{
+		compilationSettings = sc::ShaderCompilationSettings();
+		for (const lib::HashedString& macro : macros)
+		{
+			compilationSettings.AddMacroDefinition(sc::MacroDefinition(macro));
+		}
+
+		if (!generateDebugSource)
+		{
+			compilationSettings.DisableGeneratingDebugSource();
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// PSOWarmListComputePipeline ====================================================================
+
+SizeType PSOWarmListComputePipeline::Hash() const
+{
+	return computeShader.Hash();
+}
+
+void PSOWarmListComputePipeline::Serialize(srl::Serializer& serializer)
+{
+	serializer.Serialize("Name", name);
+	serializer.Serialize("ComputeShader", computeShader);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// PSOWarmListGraphicsPipeline ===================================================================
+
+SizeType PSOWarmListGraphicsPipeline::Hash() const
+{
+	return lib::HashCombine(vertexShader.Hash(), taskShader.Hash(), meshShader.Hash(), fragmentShader.Hash(), pipelineDef);
+}
+
+void PSOWarmListGraphicsPipeline::Serialize(srl::Serializer& serializer)
+{
+	serializer.Serialize("Name", name);
+	serializer.Serialize("VertexShader", vertexShader);
+	serializer.Serialize("TaskShader", taskShader);
+	serializer.Serialize("MeshShader", meshShader);
+	serializer.Serialize("FragmentShader", fragmentShader);
+	priv::SerializePipelineDefinition(serializer, pipelineDef);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// PSOsWarmList ==================================================================================
+
+void PSOsWarmList::RecordComputePipeline(PSOWarmListComputePipeline pipeline)
+{
+	SPT_CHECK(pipeline.computeShader.IsValid());
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	if (m_recordedPipelines.emplace(pipeline.Hash()).second)
+	{
+		m_computePipelines.emplace_back(std::move(pipeline));
+	}
+}
+
+void PSOsWarmList::RecordGraphicsPipeline(PSOWarmListGraphicsPipeline pipeline)
+{
+	SPT_CHECK(pipeline.fragmentShader.IsValid());
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	if (m_recordedPipelines.emplace(pipeline.Hash()).second)
+	{
+		m_graphicsPipelines.emplace_back(std::move(pipeline));
+	}
+}
+
+SizeType PSOsWarmList::GetComputePipelinesNum() const
+{
+	const lib::LockGuard lockGuard(m_lock);
+
+	return m_computePipelines.size();
+}
+
+SizeType PSOsWarmList::GetGraphicsPipelinesNum() const
+{
+	const lib::LockGuard lockGuard(m_lock);
+
+	return m_graphicsPipelines.size();
+}
+
+SizeType PSOsWarmList::RemovePipelinesWithMissingShaders(const lib::Path& shadersPath)
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	const auto isShaderMissing = [&shadersPath](const PSOWarmListShader& shader)
+	{
+		return shader.IsValid() && !lib::File::Exists(shadersPath / shader.shaderRelativePath);
+	};
+
+	const SizeType removedComputePipelinesNum = std::erase_if(m_computePipelines,
+															  [&](const PSOWarmListComputePipeline& pipeline)
+															  {
+																  return isShaderMissing(pipeline.computeShader);
+															  });
+
+	const SizeType removedGraphicsPipelinesNum = std::erase_if(m_graphicsPipelines,
+															   [&](const PSOWarmListGraphicsPipeline& pipeline)
+															   {
+																   return isShaderMissing(pipeline.vertexShader)
+																	   || isShaderMissing(pipeline.taskShader)
+																	   || isShaderMissing(pipeline.meshShader)
+																	   || isShaderMissing(pipeline.fragmentShader);
+															   });
+
+	const SizeType removedPipelinesNum = removedComputePipelinesNum + removedGraphicsPipelinesNum;
+
+	if (removedPipelinesNum > 0u)
+	{
+		m_recordedPipelines.clear();
+
+		for (const PSOWarmListComputePipeline& pipeline : m_computePipelines)
+		{
+			m_recordedPipelines.emplace(pipeline.Hash());
+		}
+
+		for (const PSOWarmListGraphicsPipeline& pipeline : m_graphicsPipelines)
+		{
+			m_recordedPipelines.emplace(pipeline.Hash());
+		}
+	}
+
+	return removedPipelinesNum;
+}
+
+void PSOsWarmList::ScheduleCompilation(PSOCompilerInterface& compiler) const
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	const auto compileShader = [&compiler](const PSOWarmListShader& shader)
+	{
+		return shader.IsValid() ? compiler.CompileShader(shader.shaderRelativePath, shader.stageDef, shader.compilationSettings) : ShaderID();
+	};
+
+	for (const PSOWarmListComputePipeline& pipeline : m_computePipelines)
+	{
+		const ShaderID computeShader = compileShader(pipeline.computeShader);
+		SPT_MAYBE_UNUSED
+		const PipelineStateID pipelineID = compiler.CreateComputePipeline(RENDERER_RESOURCE_NAME(pipeline.name), computeShader);
+	}
+
+	for (const PSOWarmListGraphicsPipeline& pipeline : m_graphicsPipelines)
+	{
+		GraphicsPipelineShaders shaders;
+		shaders.vertexShader   = compileShader(pipeline.vertexShader);
+		shaders.taskShader     = compileShader(pipeline.taskShader);
+		shaders.meshShader     = compileShader(pipeline.meshShader);
+		shaders.fragmentShader = compileShader(pipeline.fragmentShader);
+
+		SPT_MAYBE_UNUSED
+		const PipelineStateID pipelineID = compiler.CreateGraphicsPipeline(RENDERER_RESOURCE_NAME(pipeline.name), shaders, pipeline.pipelineDef);
+	}
+}
+
+lib::DynamicArray<Byte> PSOsWarmList::SaveBinary() const
+{
+	SPT_PROFILER_FUNCTION();
+
+	priv::WarmListData data;
+	data.version = priv::warmListVersion;
+
+	{
+		const lib::LockGuard lockGuard(m_lock);
+
+		data.computePipelines  = m_computePipelines;
+		data.graphicsPipelines = m_graphicsPipelines;
+	}
+
+	return srl::SerializationHelper::SerializeStructBinary(data);
+}
+
+Bool PSOsWarmList::LoadBinary(lib::Span<const Byte> data)
+{
+	SPT_PROFILER_FUNCTION();
+
+	priv::WarmListData loadedData;
+	if (!srl::SerializationHelper::DeserializeStructBinary(loadedData, data) || loadedData.version != priv::warmListVersion)
+	{
+		return false;
+	}
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	m_computePipelines.clear();
+	m_graphicsPipelines.clear();
+	m_recordedPipelines.clear();
+
+	for (PSOWarmListComputePipeline& pipeline : loadedData.computePipelines)
+	{
+		if (pipeline.computeShader.IsValid() && m_recordedPipelines.emplace(pipeline.Hash()).second)
+		{
+			m_computePipelines.emplace_back(std::move(pipeline));
+		}
+	}
+
+	for (PSOWarmListGraphicsPipeline& pipeline : loadedData.graphicsPipelines)
+	{
+		if (pipeline.fragmentShader.IsValid() && m_recordedPipelines.emplace(pipeline.Hash()).second)
+		{
+			m_graphicsPipelines.emplace_back(std::move(pipeline));
+		}
+	}
+
+	return true;
+}
+
+void PSOsWarmList::SaveToFile(const lib::Path& filePath) const
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::DynamicArray<Byte> data = SaveBinary();
+	srl::SerializationHelper::SaveBinaryToFile(data.data(), data.size(), filePath.generic_string());
+}
+
+Bool PSOsWarmList::LoadFromFile(const lib::Path& filePath)
+{
+	SPT_PROFILER_FUNCTION();
+
+	std::ifstream stream = lib::File::OpenInputStream(filePath, lib::EFileOpenFlags::Binary);
+	if (stream.fail())
+	{
+		return false;
+	}
+
+	stream.seekg(0, std::ios::end);
+	const SizeType size = stream.tellg();
+
+	stream.seekg(0, std::ios::beg);
+
+	lib::DynamicArray<Byte> data(size);
+
+	stream.read(reinterpret_cast<char*>(data.data()), size);
+	stream.close();
+
+	return LoadBinary(data);
+}
+
+} // spt::rdr
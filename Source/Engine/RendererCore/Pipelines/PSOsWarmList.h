@@ -0,0 +1,106 @@
+#pragma once
+
+#include "RendererCoreMacros.h"
+#include "SculptorCoreTypes.h"
+#include "Common/ShaderCompilationInput.h"
+#include "RHICore/RHIPipelineDefinitionTypes.h"
+#include "FileSystem/File.h"
+
+
+namespace spt::srl
+{
+class Serializer;
+} // spt::srl
+
+
+namespace spt::rdr
+{
+
+class PSOCompilerInterface;
+
+
+struct RENDERER_CORE_API PSOWarmListShader
+{
+	Bool IsValid() const
+	{
+		return !shaderRelativePath.empty();
+	}
+
+	SizeType Hash() const;
+
+	void Serialize(srl::Serializer& serializer);
+
+	lib::String                   shaderRelativePath;
+	sc::ShaderStageCompilationDef stageDef;
+	sc::ShaderCompilationSettings compilationSettings;
+};
+
+
+struct RENDERER_CORE_API PSOWarmListComputePipeline
+{
+	SizeType Hash() const;
+
+	void Serialize(srl::Serializer& serializer);
+
+	lib::HashedString name;
+	PSOWarmListShader computeShader;
+};
+
+
+struct RENDERER_CORE_API PSOWarmListGraphicsPipeline
+{
+	SizeType Hash() const;
+
+	void Serialize(srl::Serializer& serializer);
+
+	lib::HashedString               name;
+	PSOWarmListShader               vertexShader;
+	PSOWarmListShader               taskShader;
+	PSOWarmListShader               meshShader;
+	PSOWarmListShader               fragmentShader;
+	rhi::GraphicsPipelineDefinition pipelineDef;
+};
+
+
+/**
+ * List of pipelines that were compiled at runtime (weren't precached) during previous sessions.
+ * Pipelines from the warm list are compiled together with precached pipelines during startup, so their first use doesn't cause a hitch.
+ * Ray tracing pipelines are not recorded, as all of them must be precached.
+ */
+class RENDERER_CORE_API PSOsWarmList
+{
+public:
+
+	PSOsWarmList() = default;
+
+	void RecordComputePipeline(PSOWarmListComputePipeline pipeline);
+	void RecordGraphicsPipeline(PSOWarmListGraphicsPipeline pipeline);
+
+	SizeType GetComputePipelinesNum() const;
+	SizeType GetGraphicsPipelinesNum() const;
+
+	/** Removes pipelines that use shaders which source files don't exist anymore. Returns number of removed pipelines */
+	SizeType RemovePipelinesWithMissingShaders(const lib::Path& shadersPath);
+
+	/** Requests compilation of all pipelines from the list. Precaching compiler compiles them in parallel on job system workers */
+	void ScheduleCompilation(PSOCompilerInterface& compiler) const;
+
+	lib::DynamicArray<Byte> SaveBinary() const;
+
+	/** Replaces current content with loaded data. Returns false if data is not valid warm list of the current version */
+	Bool LoadBinary(lib::Span<const Byte> data);
+
+	void SaveToFile(const lib::Path& filePath) const;
+	Bool LoadFromFile(const lib::Path& filePath);
+
+private:
+
+	lib::DynamicArray<PSOWarmListComputePipeline>  m_computePipelines;
+	lib::DynamicArray<PSOWarmListGraphicsPipeline> m_graphicsPipelines;
+
+	lib::HashSet<SizeType> m_recordedPipelines;
+
+	mutable lib::Lock m_lock;
+};
+
+} // spt::rdr
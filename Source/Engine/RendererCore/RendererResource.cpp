@@ -65,7 +65,7 @@ rhi::RHIResourceAllocationDefinition AllocationDefinition::GetRHIAllocationDef()
 									  },
 									  [](const PlacedAllocationDef& def) -> rhi::RHIResourceAllocationDefinition
 									  {
-										  return rhi::RHIPlacedAllocationDefinition(&def.memoryPool->GetRHI(), def.allocationFlags);
+										  return rhi::RHIPlacedAllocationDefinition(&def.memoryPool->GetRHI(), def.allocationFlags, def.offset);
 									  }
 								  },
 								  m_allocationDef);
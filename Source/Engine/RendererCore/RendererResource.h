@@ -117,8 +117,17 @@ struct PlacedAllocationDef
 		, allocationFlags(allocationFlags)
 	{ }
 
+	PlacedAllocationDef(lib::SharedRef<GPUMemoryPool> memoryPool, Uint64 offset)
+		: memoryPool(memoryPool)
+		, allocationFlags(rhi::EVirtualAllocationFlags::None)
+		, offset(offset)
+	{ }
+
 	lib::SharedRef<GPUMemoryPool> memoryPool;
 	rhi::EVirtualAllocationFlags  allocationFlags;
+
+	/** Explicit offset in memory pool. If not set, pool's virtual allocator is used to find memory for resource */
+	Uint64                        offset = idxNone<Uint64>;
 };
 
 
@@ -17,6 +17,11 @@ struct StaticRendererSettings
 
 RendererSettings::RendererSettings()
 	: framesInFlight(2)
+	, parallelRenderGraphRecording(false)
+	, minNodesPerRecordingRange(32u)
+	, renderGraphPassCulling(true)
+	, renderGraphBarrierPlanning(true)
+	, splitBarrierMinNodesDistance(3u)
 { }
 
 const RendererSettings& RendererSettings::Get()
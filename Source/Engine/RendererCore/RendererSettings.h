@@ -17,9 +17,23 @@ public:
 
 	Uint32 framesInFlight;
 
+	/** If enabled, render graph nodes are recorded to multiple command buffers in parallel. Disabled by default, as node callables must be thread safe */
+	Bool   parallelRenderGraphRecording;
+	Uint32 minNodesPerRecordingRange;
+	Bool   renderGraphPassCulling;
+	/** If enabled, barriers are planned for whole render graph after it's built */
+	Bool   renderGraphBarrierPlanning;
+	/** Minimal distance between nodes to use split barrier instead of regular barrier. 0 disables split barriers */
+	Uint32 splitBarrierMinNodesDistance;
+
 	void Serialize(srl::Serializer& serializer)
 	{
 		serializer.Serialize("FramesInFlightNum", framesInFlight);
+		serializer.Serialize("ParallelRenderGraphRecording", parallelRenderGraphRecording);
+		serializer.Serialize("MinNodesPerRecordingRange", minNodesPerRecordingRange);
+		serializer.Serialize("RenderGraphPassCulling", renderGraphPassCulling);
+		serializer.Serialize("RenderGraphBarrierPlanning", renderGraphBarrierPlanning);
+		serializer.Serialize("SplitBarrierMinNodesDistance", splitBarrierMinNodesDistance);
 	}
 };
 
@@ -53,7 +53,7 @@ TopLevelAS::~TopLevelAS()
 	{
 		if (srvDescriptor.IsValid())
 		{
-			GPUApi::GetDescriptorManager().FreeResourceDescriptor(std::move(srvDescriptor));
+			GPUApi::GetDescriptorManager().FreeResourceDescriptorDeferred(std::move(srvDescriptor));
 		}
 
 		releaseTicket.ExecuteReleaseRHI();
@@ -60,7 +60,7 @@ BindableBufferView::~BindableBufferView()
 		GPUApi::ReleaseDeferred(GPUReleaseQueue::ReleaseEntry::CreateLambda(
 		[uavDescriptor = std::move(m_uavDescriptor)]() mutable
 		{
-			GPUApi::GetDescriptorManager().FreeResourceDescriptor(std::move(uavDescriptor));
+			GPUApi::GetDescriptorManager().FreeResourceDescriptorDeferred(std::move(uavDescriptor));
 		}));
 	}
 }
@@ -20,14 +20,8 @@ SPT_DEFINE_LOG_CATEGORY(DescriptorManager, true);
 
 DescriptorAllocator::DescriptorAllocator(const rhi::RHIDescriptorRange& range, const DescriptorSetLayout& layout, Uint32 binding)
 	: m_descriptorsIndexer(DescriptorSetIndexer(range.data, layout)[binding])
-	, m_freeDescriptorsNum(m_descriptorsIndexer.GetSize())
-	, m_freeStack(m_descriptorsIndexer.GetSize(), idxNone<Uint32>)
+	, m_indicesAllocator(m_descriptorsIndexer.GetSize())
 {
-	for (Uint32 idx = 0u; idx < m_descriptorsIndexer.GetSize(); ++idx)
-	{
-		m_freeStack[idx] = idx; // next free descriptor index
-	}
-
 #if SPT_DESCRIPTOR_MANAGER_DEBUG
 	m_descriptorsOccupation.resize(m_descriptorsIndexer.GetSize(), false);
 #endif // SPT_DESCRIPTOR_MANAGER_DEBUG
@@ -35,22 +29,18 @@ DescriptorAllocator::DescriptorAllocator(const rhi::RHIDescriptorRange& range, c
 
 Uint32 DescriptorAllocator::AllocateDescriptor()
 {
-	Uint32 descriptorIdx = idxNone<Uint32>;
-
-	{
-		const lib::LockGuard lockGuard(m_lock);
-
-		SPT_CHECK(m_freeDescriptorsNum > 0u);
+	const Uint32 descriptorIdx = m_indicesAllocator.Allocate();
 
-		descriptorIdx = m_freeStack[--m_freeDescriptorsNum];
+	SPT_CHECK_MSG(descriptorIdx != idxNone<Uint32>, "No free descriptors");
+	SPT_CHECK(descriptorIdx < m_descriptorsIndexer.GetSize());
 
 #if SPT_DESCRIPTOR_MANAGER_DEBUG
+	{
+		const lib::LockGuard lockGuard(m_debugLock);
 		SPT_CHECK(m_descriptorsOccupation[descriptorIdx] == false);
 		m_descriptorsOccupation[descriptorIdx] = true;
-#endif // SPT_DESCRIPTOR_MANAGER_DEBUG
 	}
-
-	SPT_CHECK(descriptorIdx < m_descriptorsIndexer.GetSize());
+#endif // SPT_DESCRIPTOR_MANAGER_DEBUG
 
 	const lib::Span<Byte> descriptorData = GetDescriptorData(descriptorIdx);
 
@@ -63,14 +53,31 @@ void DescriptorAllocator::FreeDescriptor(Uint32 idx)
 {
 	SPT_CHECK(idx != idxNone<Uint32>);
 
-	const lib::LockGuard lockGuard(m_lock);
+#if SPT_DESCRIPTOR_MANAGER_DEBUG
+	{
+		const lib::LockGuard lockGuard(m_debugLock);
+		SPT_CHECK(m_descriptorsOccupation[idx] == true);
+		m_descriptorsOccupation[idx] = false;
+	}
+#endif // SPT_DESCRIPTOR_MANAGER_DEBUG
 
-	m_freeStack[m_freeDescriptorsNum++] = idx;
+	m_indicesAllocator.Free(idx);
+}
 
+void DescriptorAllocator::FreeDescriptors(lib::Span<const Uint32> indices)
+{
 #if SPT_DESCRIPTOR_MANAGER_DEBUG
-	SPT_CHECK(m_descriptorsOccupation[idx] == true);
-	m_descriptorsOccupation[idx] = false;
+	{
+		const lib::LockGuard lockGuard(m_debugLock);
+		for (const Uint32 idx : indices)
+		{
+			SPT_CHECK(m_descriptorsOccupation[idx] == true);
+			m_descriptorsOccupation[idx] = false;
+		}
+	}
 #endif // SPT_DESCRIPTOR_MANAGER_DEBUG
+
+	m_indicesAllocator.FreeBulk(indices);
 }
 
 #if SPT_DESCRIPTOR_MANAGER_DEBUG
@@ -99,6 +106,7 @@ DescriptorManager::~DescriptorManager()
 	SPT_PROFILER_FUNCTION();
 
 	SPT_CHECK(m_descriptorRange.IsValid());
+	SPT_CHECK(m_deferredFrees.empty());
 
 #if SPT_DESCRIPTOR_MANAGER_DEBUG
 	if (!m_resourceDescriptorAllocator.IsFull())
@@ -140,6 +148,48 @@ void DescriptorManager::FreeResourceDescriptor(ResourceDescriptorHandle&& handle
 	SPT_CHECK(!handle.IsValid());
 }
 
+void DescriptorManager::FreeResourceDescriptors(lib::Span<ResourceDescriptorHandle> handles)
+{
+	lib::DynamicArray<Uint32> descriptorIndices;
+	descriptorIndices.reserve(handles.size());
+
+	for (ResourceDescriptorHandle& handle : handles)
+	{
+		SPT_CHECK(handle.IsValid());
+
+		descriptorIndices.emplace_back(handle.Get());
+		handle.Reset();
+	}
+
+	m_resourceDescriptorAllocator.FreeDescriptors(descriptorIndices);
+}
+
+void DescriptorManager::FreeResourceDescriptorDeferred(ResourceDescriptorHandle&& handle)
+{
+	SPT_CHECK(handle.IsValid());
+
+	const lib::LockGuard lockGuard(m_deferredFreesLock);
+
+	m_deferredFrees.emplace_back(std::move(handle));
+}
+
+void DescriptorManager::FlushDeferredDescriptorFrees()
+{
+	SPT_PROFILER_FUNCTION();
+
+	lib::DynamicArray<ResourceDescriptorHandle> descriptorsToFree;
+
+	{
+		const lib::LockGuard lockGuard(m_deferredFreesLock);
+		std::swap(descriptorsToFree, m_deferredFrees);
+	}
+
+	if (!descriptorsToFree.empty())
+	{
+		FreeResourceDescriptors(descriptorsToFree);
+	}
+}
+
 void DescriptorManager::UploadSRVDescriptor(ResourceDescriptorIdx idx, TextureView& textureView)
 {
 	SPT_CHECK(idx != rdr::invalidResourceDescriptorIdx);
@@ -4,6 +4,7 @@
 #include "RHICore/RHIDescriptorTypes.h"
 #include "DescriptorTypes.h"
 #include "DescriptorSetStateTypes.h"
+#include "Allocators/ConcurrentIndexAllocator.h"
 
 
 namespace spt::rdr
@@ -29,15 +30,19 @@ public:
 	Uint32 AllocateDescriptor();
 	void   FreeDescriptor(Uint32 idx);
 
+	/** Frees multiple descriptors at once (e.g. all descriptors released at the end of frame) */
+	void FreeDescriptors(lib::Span<const Uint32> indices);
+
 	lib::Span<Byte> GetDescriptorData(Uint32 idx) const
 	{
 		SPT_CHECK(idx != idxNone<Uint32>);
 		return lib::Span<Byte>{ m_descriptorsIndexer[idx], m_descriptorsIndexer.GetDescriptorSize() };
 	}
 
+	/** Not thread safe - must not be called concurrently with allocations and frees */
 	Bool IsFull() const
 	{
-		return m_freeDescriptorsNum == m_descriptorsIndexer.GetSize();
+		return m_indicesAllocator.GetFreeIndicesNum() == m_descriptorsIndexer.GetSize();
 	}
 
 	Uint32 GetDescriptorsNum() const
@@ -53,12 +58,10 @@ private:
 
 	DescriptorArrayIndexer m_descriptorsIndexer;
 
-	lib::Spinlock m_lock;
-	Uint32 m_freeDescriptorsNum = 0u;
-
-	lib::DynamicArray<Uint32> m_freeStack;
+	lib::ConcurrentIndexAllocator m_indicesAllocator;
 
 #if SPT_DESCRIPTOR_MANAGER_DEBUG
+	lib::Spinlock m_debugLock;
 	lib::DynamicArray<Bool> m_descriptorsOccupation;
 #endif // SPT_DESCRIPTOR_MANAGER_DEBUG
 };
@@ -182,6 +185,13 @@ public:
 
 	ResourceDescriptorHandle AllocateResourceDescriptor();
 	void                     FreeResourceDescriptor(ResourceDescriptorHandle&& handle);
+	void                     FreeResourceDescriptors(lib::Span<ResourceDescriptorHandle> handles);
+
+	/** Descriptor is freed in bulk with all descriptors released during the same flush of deferred releases */
+	void FreeResourceDescriptorDeferred(ResourceDescriptorHandle&& handle);
+
+	/** Called after ready deferred releases are executed */
+	void FlushDeferredDescriptorFrees();
 
 	void UploadSRVDescriptor(ResourceDescriptorIdx idx, TextureView& textureView);
 	void UploadUAVDescriptor(ResourceDescriptorIdx idx, TextureView& textureView);
@@ -220,6 +230,9 @@ private:
 	DescriptorAllocator m_resourceDescriptorAllocator;
 	lib::DynamicArray<DescriptorInfo> m_resourceDescriptorInfos;
 
+	lib::Lock                                   m_deferredFreesLock;
+	lib::DynamicArray<ResourceDescriptorHandle> m_deferredFrees;
+
 	DescriptorArrayIndexer m_samplerDescriptorsIndexer;
 };
 
@@ -0,0 +1,276 @@
+#include "DescriptorSetRangesCache.h"
+#include "GPUApi.h"
+#include "Types/DescriptorHeap.h"
+
+
+namespace spt::rdr
+{
+
+namespace priv
+{
+
+/** Number of ranges that are not used by any state, but are kept in cache, so they can be reused */
+static constexpr Uint32 maxUnusedRangesNum = 2048u;
+
+
+class DescriptorHeapRangesAllocator : public DescriptorRangesAllocatorInterface
+{
+public:
+
+	virtual rhi::RHIDescriptorRange AllocateRange(SizeType size) override
+	{
+		DescriptorHeap& descriptorHeap = GPUApi::GetDescriptorHeap();
+		return descriptorHeap.GetRHI().AllocateRange(size);
+	}
+
+	virtual void DeallocateRange(const rhi::RHIDescriptorRange& range) override
+	{
+		GPUApi::ReleaseDeferred(GPUReleaseQueue::ReleaseEntry::CreateLambda(
+			[range]
+			{
+				rdr::DescriptorHeap& descriptorHeap = GPUApi::GetDescriptorHeap();
+				descriptorHeap.GetRHI().DeallocateRange(range);
+			}));
+	}
+};
+
+
+static DescriptorHeapRangesAllocator& GetDescriptorHeapRangesAllocator()
+{
+	static DescriptorHeapRangesAllocator instance;
+	return instance;
+}
+
+
+static SizeType HashDescriptorsData(const void* layout, lib::Span<const Byte> descriptorsData)
+{
+	const SizeType dataHash = lib::FNV1a::Hash(lib::Span<const char>(reinterpret_cast<const char*>(descriptorsData.data()), descriptorsData.size()));
+	return lib::HashCombine(reinterpret_cast<SizeType>(layout), dataHash);
+}
+
+
+static Bool HasSameContents(const CachedDescriptorRange& cachedRange, const void* layout, lib::Span<const Byte> descriptorsData)
+{
+	return cachedRange.layout.get() == layout
+		&& cachedRange.descriptorsData.size() == descriptorsData.size()
+		&& std::memcmp(cachedRange.descriptorsData.data(), descriptorsData.data(), descriptorsData.size()) == 0;
+}
+
+} // priv
+
+DescriptorSetRangesCache::DescriptorSetRangesCache()
+	: DescriptorSetRangesCache(priv::GetDescriptorHeapRangesAllocator())
+{ }
+
+DescriptorSetRangesCache::DescriptorSetRangesCache(DescriptorRangesAllocatorInterface& allocator)
+	: m_allocator(allocator)
+{ }
+
+void DescriptorSetRangesCache::Uninitialize()
+{
+	SPT_PROFILER_FUNCTION();
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	for (auto it = std::begin(m_cachedRanges); it != std::end(m_cachedRanges);)
+	{
+		CachedDescriptorRange& cachedRange = *it->second;
+
+		if (cachedRange.refCount == 0u)
+		{
+			DestroyRange(cachedRange);
+			it = m_cachedRanges.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	m_unusedRangesNum = 0u;
+}
+
+CachedDescriptorRange* DescriptorSetRangesCache::AcquireRange(const lib::SharedPtr<const void>& layout, lib::Span<const Byte> descriptorsData)
+{
+	SPT_PROFILER_FUNCTION();
+
+	SPT_CHECK(!!layout);
+
+	const SizeType hash = priv::HashDescriptorsData(layout.get(), descriptorsData);
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	const auto foundRange = m_cachedRanges.find(hash);
+	if (foundRange != std::cend(m_cachedRanges))
+	{
+		CachedDescriptorRange& cachedRange = *foundRange->second;
+
+		if (priv::HasSameContents(cachedRange, layout.get(), descriptorsData))
+		{
+			if (cachedRange.refCount++ == 0u)
+			{
+				SPT_CHECK(m_unusedRangesNum > 0u);
+				--m_unusedRangesNum;
+			}
+
+			m_reusedRangesNum.fetch_add(1u, std::memory_order_relaxed);
+
+			return &cachedRange;
+		}
+
+		// Hash collision - range is created, but it's not cached, so existing range isn't evicted while it may be used
+		CachedDescriptorRange* uncachedRange = CreateRange(layout, descriptorsData, hash);
+		uncachedRange->isCached = false;
+		return uncachedRange;
+	}
+
+	CachedDescriptorRange* newRange = CreateRange(layout, descriptorsData, hash);
+	newRange->isCached = true;
+	m_cachedRanges.emplace(hash, lib::UniquePtr<CachedDescriptorRange>(newRange));
+
+	return newRange;
+}
+
+void DescriptorSetRangesCache::ReleaseRange(CachedDescriptorRange* cachedRange)
+{
+	SPT_CHECK(!!cachedRange);
+
+	const lib::LockGuard lockGuard(m_lock);
+
+	SPT_CHECK(cachedRange->refCount > 0u);
+
+	if (--cachedRange->refCount > 0u)
+	{
+		return;
+	}
+
+	if (!cachedRange->isCached)
+	{
+		DestroyRange(*cachedRange);
+		delete cachedRange;
+		return;
+	}
+
+	cachedRange->lastReleaseIdx = m_nextReleaseIdx++;
+	++m_unusedRangesNum;
+
+	if (m_unusedRangesNum > priv::maxUnusedRangesNum)
+	{
+		EvictUnusedRanges();
+	}
+}
+
+void DescriptorSetRangesCache::RecordFlush(Uint32 writtenBindingsNum, Bool isPartialFlush)
+{
+	m_flushesNum.fetch_add(1u, std::memory_order_relaxed);
+	m_bindingWritesNum.fetch_add(writtenBindingsNum, std::memory_order_relaxed);
+
+	if (isPartialFlush)
+	{
+		m_partialFlushesNum.fetch_add(1u, std::memory_order_relaxed);
+	}
+}
+
+void DescriptorSetRangesCache::RecordUncachedRangeUpload(Uint64 bytesNum)
+{
+	m_rangeAllocationsNum.fetch_add(1u, std::memory_order_relaxed);
+	m_uploadedBytes.fetch_add(bytesNum, std::memory_order_relaxed);
+}
+
+DescriptorSetRangesCacheStatistics DescriptorSetRangesCache::GetStatistics() const
+{
+	DescriptorSetRangesCacheStatistics statistics;
+	statistics.flushesNum          = m_flushesNum.load(std::memory_order_relaxed);
+	statistics.partialFlushesNum   = m_partialFlushesNum.load(std::memory_order_relaxed);
+	statistics.bindingWritesNum    = m_bindingWritesNum.load(std::memory_order_relaxed);
+	statistics.rangeAllocationsNum = m_rangeAllocationsNum.load(std::memory_order_relaxed);
+	statistics.reusedRangesNum     = m_reusedRangesNum.load(std::memory_order_relaxed);
+	statistics.uploadedBytes       = m_uploadedBytes.load(std::memory_order_relaxed);
+
+	{
+		const lib::LockGuard lockGuard(m_lock);
+		statistics.cachedRangesNum       = static_cast<Uint32>(m_cachedRanges.size());
+		statistics.unusedCachedRangesNum = m_unusedRangesNum;
+	}
+
+	return statistics;
+}
+
+void DescriptorSetRangesCache::ResetStatistics()
+{
+	m_flushesNum.store(0u, std::memory_order_relaxed);
+	m_partialFlushesNum.store(0u, std::memory_order_relaxed);
+	m_bindingWritesNum.store(0u, std::memory_order_relaxed);
+	m_rangeAllocationsNum.store(0u, std::memory_order_relaxed);
+	m_reusedRangesNum.store(0u, std::memory_order_relaxed);
+	m_uploadedBytes.store(0u, std::memory_order_relaxed);
+}
+
+CachedDescriptorRange* DescriptorSetRangesCache::CreateRange(const lib::SharedPtr<const void>& layout, lib::Span<const Byte> descriptorsData, SizeType hash)
+{
+	SPT_PROFILER_FUNCTION();
+
+	CachedDescriptorRange* cachedRange = new CachedDescriptorRange();
+	cachedRange->range           = m_allocator.AllocateRange(descriptorsData.size());
+	cachedRange->layout          = layout;
+	cachedRange->descriptorsData = lib::DynamicArray<Byte>(std::cbegin(descriptorsData), std::cend(descriptorsData));
+	cachedRange->hash            = hash;
+	cachedRange->refCount        = 1u;
+
+	SPT_CHECK(cachedRange->range.data.size() == descriptorsData.size());
+	std::memcpy(cachedRange->range.data.data(), descriptorsData.data(), descriptorsData.size());
+
+	m_rangeAllocationsNum.fetch_add(1u, std::memory_order_relaxed);
+	m_uploadedBytes.fetch_add(descriptorsData.size(), std::memory_order_relaxed);
+
+	return cachedRange;
+}
+
+void DescriptorSetRangesCache::DestroyRange(CachedDescriptorRange& cachedRange)
+{
+	SPT_CHECK(cachedRange.refCount == 0u);
+
+	m_allocator.DeallocateRange(cachedRange.range);
+
+	cachedRange.range = rhi::RHIDescriptorRange{};
+}
+
+void DescriptorSetRangesCache::EvictUnusedRanges()
+{
+	SPT_PROFILER_FUNCTION();
+
+	// Evict half of the budget at once, so eviction isn't done on every release
+	lib::DynamicArray<CachedDescriptorRange*> unusedRanges;
+	unusedRanges.reserve(m_unusedRangesNum);
+
+	for (const auto& [hash, cachedRange] : m_cachedRanges)
+	{
+		if (cachedRange->refCount == 0u)
+		{
+			unusedRanges.emplace_back(cachedRange.get());
+		}
+	}
+
+	const SizeType rangesToEvictNum = std::min<SizeType>(unusedRanges.size(), priv::maxUnusedRangesNum / 2u);
+
+	std::nth_element(std::begin(unusedRanges), std::begin(unusedRanges) + rangesToEvictNum, std::end(unusedRanges),
+					 [](const CachedDescriptorRange* lhs, const CachedDescriptorRange* rhs)
+					 {
+						 return lhs->lastReleaseIdx < rhs->lastReleaseIdx;
+					 });
+
+	for (SizeType idx = 0u; idx < rangesToEvictNum; ++idx)
+	{
+		CachedDescriptorRange& rangeToEvict = *unusedRanges[idx];
+
+		DestroyRange(rangeToEvict);
+
+		const SizeType hash = rangeToEvict.hash;
+		m_cachedRanges.erase(hash);
+	}
+
+	SPT_CHECK(m_unusedRangesNum >= rangesToEvictNum);
+	m_unusedRangesNum -= static_cast<Uint32>(rangesToEvictNum);
+}
+
+} // spt::rdr
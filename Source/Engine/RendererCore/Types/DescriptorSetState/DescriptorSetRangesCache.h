@@ -0,0 +1,108 @@
+#pragma once
+
+#include "RendererCoreMacros.h"
+#include "SculptorCoreTypes.h"
+#include "RHICore/RHIDescriptorTypes.h"
+
+
+namespace spt::rdr
+{
+
+/** Descriptors range written for descriptor set states. Ranges are immutable, so they can be shared by all states with the same contents */
+struct CachedDescriptorRange
+{
+	rhi::RHIDescriptorRange range;
+
+	/** Layout of descriptors. It's used only as part of range identity (and kept alive as long as range exists) */
+	lib::SharedPtr<const void> layout;
+	lib::DynamicArray<Byte>    descriptorsData;
+
+	SizeType hash = 0u;
+
+	Uint32 refCount = 0u;
+	Uint64 lastReleaseIdx = 0u;
+
+	/** False if range couldn't be added to the cache because of hash collision */
+	Bool isCached = false;
+};
+
+
+struct DescriptorSetRangesCacheStatistics
+{
+	Uint64 flushesNum          = 0u;
+	Uint64 partialFlushesNum   = 0u;
+	Uint64 bindingWritesNum    = 0u;
+	Uint64 rangeAllocationsNum = 0u;
+	Uint64 reusedRangesNum     = 0u;
+	Uint64 uploadedBytes       = 0u;
+
+	Uint32 cachedRangesNum       = 0u;
+	Uint32 unusedCachedRangesNum = 0u;
+};
+
+
+/** Provides memory for cached ranges. Default implementation allocates them from GPU descriptor heap */
+class RENDERER_CORE_API DescriptorRangesAllocatorInterface
+{
+public:
+
+	virtual ~DescriptorRangesAllocatorInterface() = default;
+
+	virtual rhi::RHIDescriptorRange AllocateRange(SizeType size) = 0;
+
+	/** Range may still be used by GPU, so it must not be reused before GPU finishes using it */
+	virtual void DeallocateRange(const rhi::RHIDescriptorRange& range) = 0;
+};
+
+
+/**
+ * Content-addressed cache of descriptor ranges allocated from descriptor heap.
+ * States with the same layout and descriptors data share single range, so flushing state, that was already written, doesn't write to the heap.
+ * Ranges that are no longer used by any state stay in cache (up to the budget), so they can be reused in next frames.
+ */
+class RENDERER_CORE_API DescriptorSetRangesCache
+{
+public:
+
+	/** Allocates ranges from GPU descriptor heap */
+	DescriptorSetRangesCache();
+
+	explicit DescriptorSetRangesCache(DescriptorRangesAllocatorInterface& allocator);
+
+	void Uninitialize();
+
+	/** Returns range with given contents. Returned range must be released using ReleaseRange */
+	CachedDescriptorRange* AcquireRange(const lib::SharedPtr<const void>& layout, lib::Span<const Byte> descriptorsData);
+	void                   ReleaseRange(CachedDescriptorRange* cachedRange);
+
+	void RecordFlush(Uint32 writtenBindingsNum, Bool isPartialFlush);
+	void RecordUncachedRangeUpload(Uint64 bytesNum);
+
+	DescriptorSetRangesCacheStatistics GetStatistics() const;
+	void                               ResetStatistics();
+
+private:
+
+	CachedDescriptorRange* CreateRange(const lib::SharedPtr<const void>& layout, lib::Span<const Byte> descriptorsData, SizeType hash);
+	void                   DestroyRange(CachedDescriptorRange& cachedRange);
+
+	void EvictUnusedRanges();
+
+	DescriptorRangesAllocatorInterface& m_allocator;
+
+	mutable lib::Lock m_lock;
+
+	lib::HashMap<SizeType, lib::UniquePtr<CachedDescriptorRange>> m_cachedRanges;
+
+	Uint32 m_unusedRangesNum  = 0u;
+	Uint64 m_nextReleaseIdx   = 0u;
+
+	std::atomic<Uint64> m_flushesNum          = 0u;
+	std::atomic<Uint64> m_partialFlushesNum   = 0u;
+	std::atomic<Uint64> m_bindingWritesNum    = 0u;
+	std::atomic<Uint64> m_rangeAllocationsNum = 0u;
+	std::atomic<Uint64> m_reusedRangesNum     = 0u;
+	std::atomic<Uint64> m_uploadedBytes       = 0u;
+};
+
+} // spt::rdr
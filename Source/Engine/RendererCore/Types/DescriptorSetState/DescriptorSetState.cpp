@@ -3,6 +3,7 @@
 #include "ShaderMetaData.h"
 #include "Types/DescriptorSetLayout.h"
 #include "Types/DescriptorHeap.h"
+#include "DescriptorSetRangesCache.h"
 
 namespace spt::rdr
 {
@@ -45,7 +46,7 @@ void DescriptorSetBinding::PreInit(DescriptorSetState& state, Uint32 baseBinding
 void DescriptorSetBinding::MarkAsDirty()
 {
 	SPT_CHECK(!!m_owningState);
-	m_owningState->SetDirty();
+	m_owningState->SetBindingDirty(m_baseBindingIdx);
 }
 
 Uint32 DescriptorSetBinding::GetBaseBindingIdx() const
@@ -64,16 +65,17 @@ lib::HashedString DescriptorSetBinding::GetDescriptorSetName() const
 DescriptorSetState::DescriptorSetState(const RendererResourceName& name, const DescriptorSetStateParams& params)
 	: m_id(utils::GenerateStateID())
 	, m_typeID(DSStateTypeID(idxNone<SizeType>))
-	, m_dirty(true)
+	, m_dirtyBindings(allBindingsDirtyMask)
 	, m_flags(params.flags)
 	, m_descriptorsAllocator(params.descriptorsAllocator)
 	, m_constantsAllocator(params.constantsAllocator)
+	, m_cachedRange(nullptr)
 	, m_name(name)
 { }
 
 DescriptorSetState::~DescriptorSetState()
 {
-	SwapDescriptorRange(rhi::RHIDescriptorRange{});
+	ReleaseDescriptorRange();
 }
 
 DSStateID DescriptorSetState::GetID() const
@@ -88,27 +90,36 @@ DSStateTypeID DescriptorSetState::GetTypeID() const
 
 Bool DescriptorSetState::IsDirty() const
 {
-	return m_dirty;
+	return m_dirtyBindings != 0u;
 }
 
 void DescriptorSetState::SetDirty()
 {
-	m_dirty = true;
+	m_dirtyBindings = allBindingsDirtyMask;
+}
+
+void DescriptorSetState::SetBindingDirty(Uint32 baseBindingIdx)
+{
+	m_dirtyBindings |= GetBindingDirtyMask(baseBindingIdx);
 }
 
 void DescriptorSetState::Flush()
 {
-	if (m_dirty)
+	if (IsDirty())
 	{
-		rhi::RHIDescriptorRange descriptorRange = AllocateDescriptorRange();
+		SPT_PROFILER_FUNCTION();
+
+		const Bool isPartialUpdate = m_dirtyBindings != allBindingsDirtyMask;
+
+		DescriptorSetIndexer indexer(lib::Span<Byte>(m_descriptorsData), *m_layout);
 
-		DescriptorSetIndexer indexer(descriptorRange.data, *m_layout);
+		const Uint32 updatedBindingsNum = UpdateDirtyDescriptors(indexer, m_dirtyBindings);
 
-		UpdateDescriptors(indexer);
+		GPUApi::GetDescriptorSetRangesCache().RecordFlush(updatedBindingsNum, isPartialUpdate);
 
-		SwapDescriptorRange(descriptorRange);
+		UploadDescriptors();
 
-		m_dirty = false;
+		m_dirtyBindings = 0u;
 	}
 }
 
@@ -138,39 +149,41 @@ void DescriptorSetState::SetTypeID(DSStateTypeID id, const DescriptorSetStatePar
 	m_typeID = id;
 
 	m_layout = GPUApi::GetDSLayoutsRegistry().GetLayoutChecked(m_typeID);
+
+	m_descriptorsData.resize(m_layout->GetRHI().GetDescriptorsDataSize(), Byte(0));
 }
 
-rhi::RHIDescriptorRange DescriptorSetState::AllocateDescriptorRange() const
+void DescriptorSetState::UploadDescriptors()
 {
-	const Uint64 size = m_layout->GetRHI().GetDescriptorsDataSize();
-
 	if (m_descriptorsAllocator)
 	{
-		return m_descriptorsAllocator->AllocateRange(static_cast<Uint32>(size));
+		// Ranges from custom allocators are released together with allocator, so they are not cached
+		m_descriptorRange = m_descriptorsAllocator->AllocateRange(static_cast<Uint32>(m_descriptorsData.size()));
+		std::memcpy(m_descriptorRange.data.data(), m_descriptorsData.data(), m_descriptorsData.size());
+
+		GPUApi::GetDescriptorSetRangesCache().RecordUncachedRangeUpload(m_descriptorsData.size());
 	}
 	else
 	{
-		DescriptorHeap& descriptorHeap = GPUApi::GetDescriptorHeap();
-		return descriptorHeap.GetRHI().AllocateRange(m_layout->GetRHI().GetDescriptorsDataSize());
+		// Acquire new range before releasing the previous one, so range with unchanged contents is not evicted from cache
+		CachedDescriptorRange* newCachedRange = GPUApi::GetDescriptorSetRangesCache().AcquireRange(m_layout, m_descriptorsData);
+
+		ReleaseDescriptorRange();
+
+		m_cachedRange     = newCachedRange;
+		m_descriptorRange = newCachedRange->range;
 	}
 }
 
-void DescriptorSetState::SwapDescriptorRange(rhi::RHIDescriptorRange newDescriptorRange)
+void DescriptorSetState::ReleaseDescriptorRange()
 {
-	if (m_descriptorRange.IsValid())
+	if (m_cachedRange)
 	{
-		if (!m_descriptorsAllocator)
-		{
-			GPUApi::ReleaseDeferred(GPUReleaseQueue::ReleaseEntry::CreateLambda(
-				[ds = m_descriptorRange]
-				{
-					rdr::DescriptorHeap& descriptorHeap = GPUApi::GetDescriptorHeap();
-					descriptorHeap.GetRHI().DeallocateRange(ds);
-				}));
-		}
+		GPUApi::GetDescriptorSetRangesCache().ReleaseRange(m_cachedRange);
+		m_cachedRange = nullptr;
 	}
 
-	m_descriptorRange = newDescriptorRange;
+	m_descriptorRange = rhi::RHIDescriptorRange{};
 }
 
 } // spt::rdr
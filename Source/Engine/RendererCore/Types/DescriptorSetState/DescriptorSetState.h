@@ -13,6 +13,7 @@ namespace spt::rdr
 class DescriptorSetState;
 class DescriptorSetStackAllocator;
 class Buffer;
+struct CachedDescriptorRange;
 
 
 class RENDERER_CORE_API DescriptorSetBinding abstract
@@ -34,6 +35,9 @@ public:
 
 	static void BuildAdditionalShaderCompilationArgs(ShaderCompilationAdditionalArgsBuilder& builder) {}
 
+	/** Bindings which descriptors can change without marking owning state as dirty must be updated on every flush of the state */
+	static constexpr Bool IsUpdatedOnEveryFlush() { return false; }
+
 	// Children classes MUST also define this function (with arbitrary N)
 	//static constexpr std::array<ShaderBindingMetaData, N> GetShaderBindingsMetaData();
 
@@ -91,11 +95,15 @@ public:
 
 	virtual void UpdateDescriptors(DescriptorSetIndexer& indexer) const = 0;
 
+	/** Updates only dirty bindings. Returns number of updated bindings */
+	virtual Uint32 UpdateDirtyDescriptors(DescriptorSetIndexer& indexer, DSBindingsMask dirtyBindings) const = 0;
+
 	DSStateID     GetID() const;
 	DSStateTypeID GetTypeID() const;
 
 	Bool IsDirty() const;
 	void SetDirty();
+	void SetBindingDirty(Uint32 baseBindingIdx);
 
 	void Flush();
 
@@ -115,14 +123,14 @@ protected:
 
 private:
 
-	rhi::RHIDescriptorRange AllocateDescriptorRange() const;
-	void                    SwapDescriptorRange(rhi::RHIDescriptorRange newDescriptorRange);
+	void UploadDescriptors();
+	void ReleaseDescriptorRange();
 
 	const DSStateID m_id;
 
 	DSStateTypeID m_typeID;
 
-	Bool m_dirty;
+	DSBindingsMask m_dirtyBindings;
 
 	EDescriptorSetStateFlags m_flags;
 
@@ -131,8 +139,14 @@ private:
 
 	lib::SharedPtr<DescriptorSetLayout> m_layout;
 
+	/** CPU copy of descriptors. Only dirty bindings are written to it, and then it's copied to a new range (ranges in use by GPU are never modified) */
+	lib::DynamicArray<Byte> m_descriptorsData;
+
 	rhi::RHIDescriptorRange m_descriptorRange;
 
+	/** Valid if range was acquired from descriptor set ranges cache (states that don't use custom descriptors allocator) */
+	CachedDescriptorRange* m_cachedRange;
+
 	RendererResourceName m_name;
 };
 
@@ -351,6 +365,10 @@ virtual void UpdateDescriptors(rdr::DescriptorSetIndexer& indexer) const final
 										   binding.UpdateDescriptors(indexer);													\
 									   });																						\
 }																																\
+virtual Uint32 UpdateDirtyDescriptors(rdr::DescriptorSetIndexer& indexer, rdr::DSBindingsMask dirtyBindings) const final		\
+{																																\
+	return rdr::bindings_refl::UpdateDirtyBindings(GetBindingsBegin(), indexer, dirtyBindings);									\
+}																																\
 private:																														\
 inline static rdr::DescriptorSetStateCompilationDefRegistration<ThisClass> CompilationRegistration;								\
 inline static rdr::DescriptorSetStateLayoutRegistration<ThisClass> layoutFactoryRegistration;									\
@@ -485,6 +503,28 @@ void InitializeBindings(TBindingHandle& bindingHandle, DescriptorSetState& ownin
 				   });
 }
 
+template<typename TBindingHandle>
+Uint32 UpdateDirtyBindings(const TBindingHandle& bindingHandle, DescriptorSetIndexer& indexer, DSBindingsMask dirtyBindings)
+{
+	Uint32 updatedBindingsNum = 0u;
+
+	ForEachBinding(bindingHandle,
+				   [&indexer, &updatedBindingsNum, dirtyBindings, bindingIdx = 0u](const auto& binding) mutable
+				   {
+					   using BindingType = std::decay_t<decltype(binding)>;
+
+					   if (BindingType::IsUpdatedOnEveryFlush() || (dirtyBindings & GetBindingDirtyMask(bindingIdx)) != 0u)
+					   {
+						   binding.UpdateDescriptors(indexer);
+						   ++updatedBindingsNum;
+					   }
+
+					   bindingIdx += GetShaderBindingsNumForBinding<BindingType>();
+				   });
+
+	return updatedBindingsNum;
+}
+
 template<typename TBindingHandle>
 constexpr lib::String BuildBindingsShaderCode(Uint32 shaderBindingIdx = 0)
 {
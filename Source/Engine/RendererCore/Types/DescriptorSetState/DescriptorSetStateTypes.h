@@ -33,6 +33,16 @@ class BindableBufferView;
 using DSStateID     = SizeType;
 using DSStateTypeID = lib::TypeID;
 
+/** Dirty bindings of descriptor set state. Each bit represents base shader binding index of binding (indices above 63 share last bit) */
+using DSBindingsMask = Uint64;
+
+static constexpr DSBindingsMask allBindingsDirtyMask = idxNone<DSBindingsMask>;
+
+constexpr DSBindingsMask GetBindingDirtyMask(Uint32 baseBindingIdx)
+{
+	return DSBindingsMask(1u) << std::min<Uint32>(baseBindingIdx, 63u);
+}
+
 
 enum class EDescriptorSetStateFlags
 {
@@ -57,7 +57,12 @@ void Texture::ReleasePlacedAllocation()
 	SPT_CHECK(std::holds_alternative<rhi::RHIPlacedAllocation>(allocation) || std::holds_alternative<rhi::RHINullAllocation>(allocation))
 	if (std::holds_alternative<rhi::RHIPlacedAllocation>(allocation))
 	{
-		memoryPool.Free(std::get<rhi::RHIPlacedAllocation>(allocation).GetSuballocation());
+		// Suballocation is invalid if texture was placed at explicit offset
+		const rhi::RHIVirtualAllocation& suballocation = std::get<rhi::RHIPlacedAllocation>(allocation).GetSuballocation();
+		if (suballocation.IsValid())
+		{
+			memoryPool.Free(suballocation);
+		}
 	}
 
 	m_owningMemoryPool.reset();
@@ -126,11 +131,11 @@ TextureView::~TextureView()
 
 			if (srvDescriptor.IsValid())
 			{
-				descriptorManager.FreeResourceDescriptor(std::move(srvDescriptor));
+				descriptorManager.FreeResourceDescriptorDeferred(std::move(srvDescriptor));
 			}
 			if (uavDescriptor.IsValid())
 			{
-				descriptorManager.FreeResourceDescriptor(std::move(uavDescriptor));
+				descriptorManager.FreeResourceDescriptorDeferred(std::move(uavDescriptor));
 			}
 
 			releaseTicket.ExecuteReleaseRHI();
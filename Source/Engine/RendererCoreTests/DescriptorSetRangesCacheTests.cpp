@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+#include "Types/DescriptorSetState/DescriptorSetRangesCache.h"
+
+
+namespace spt::rdr::tests
+{
+
+namespace priv
+{
+
+/** Allocates ranges in CPU memory, so cache can be tested without GPU */
+class CPURangesAllocator : public DescriptorRangesAllocatorInterface
+{
+public:
+
+	virtual rhi::RHIDescriptorRange AllocateRange(SizeType size) override
+	{
+		lib::DynamicArray<Byte>& storage = *allocations.emplace_back(std::make_unique<lib::DynamicArray<Byte>>(size));
+
+		rhi::RHIDescriptorRange range;
+		range.data       = lib::Span<Byte>(storage);
+		range.heapOffset = static_cast<Uint32>(allocations.size() - 1u);
+		return range;
+	}
+
+	virtual void DeallocateRange(const rhi::RHIDescriptorRange& range) override
+	{
+		++deallocationsNum;
+	}
+
+	lib::DynamicArray<lib::UniquePtr<lib::DynamicArray<Byte>>> allocations;
+	Uint32 deallocationsNum = 0u;
+};
+
+
+static lib::DynamicArray<Byte> CreateDescriptorsData(SizeType size, Byte value)
+{
+	return lib::DynamicArray<Byte>(size, value);
+}
+
+} // priv
+
+TEST(DescriptorSetRangesCacheTests, IdenticalContentsShareRange)
+{
+	priv::CPURangesAllocator allocator;
+	DescriptorSetRangesCache cache(allocator);
+
+	const lib::SharedPtr<const void> layout = std::make_shared<Uint32>(0u);
+	const lib::DynamicArray<Byte> data      = priv::CreateDescriptorsData(64u, Byte(1));
+
+	CachedDescriptorRange* firstRange  = cache.AcquireRange(layout, data);
+	CachedDescriptorRange* secondRange = cache.AcquireRange(layout, data);
+
+	EXPECT_EQ(firstRange, secondRange);
+	EXPECT_EQ(allocator.allocations.size(), 1u);
+	EXPECT_EQ(std::memcmp(firstRange->range.data.data(), data.data(), data.size()), 0);
+
+	const DescriptorSetRangesCacheStatistics statistics = cache.GetStatistics();
+	EXPECT_EQ(statistics.rangeAllocationsNum, 1u);
+	EXPECT_EQ(statistics.reusedRangesNum, 1u);
+	EXPECT_EQ(statistics.uploadedBytes, 64u);
+	EXPECT_EQ(statistics.cachedRangesNum, 1u);
+	EXPECT_EQ(statistics.unusedCachedRangesNum, 0u);
+
+	cache.ReleaseRange(firstRange);
+	cache.ReleaseRange(secondRange);
+
+	EXPECT_EQ(cache.GetStatistics().unusedCachedRangesNum, 1u);
+
+	cache.Uninitialize();
+
+	EXPECT_EQ(allocator.deallocationsNum, 1u);
+}
+
+TEST(DescriptorSetRangesCacheTests, DifferentContentsAllocateNewRanges)
+{
+	priv::CPURangesAllocator allocator;
+	DescriptorSetRangesCache cache(allocator);
+
+	const lib::SharedPtr<const void> firstLayout  = std::make_shared<Uint32>(0u);
+	const lib::SharedPtr<const void> secondLayout = std::make_shared<Uint32>(0u);
+
+	const lib::DynamicArray<Byte> firstData  = priv::CreateDescriptorsData(64u, Byte(1));
+	const lib::DynamicArray<Byte> secondData = priv::CreateDescriptorsData(64u, Byte(2));
+
+	CachedDescriptorRange* firstRange  = cache.AcquireRange(firstLayout, firstData);
+	CachedDescriptorRange* secondRange = cache.AcquireRange(firstLayout, secondData);
+	// The same data used with different layout must not share range
+	CachedDescriptorRange* thirdRange  = cache.AcquireRange(secondLayout, firstData);
+
+	EXPECT_NE(firstRange, secondRange);
+	EXPECT_NE(firstRange, thirdRange);
+
+	DescriptorSetRangesCacheStatistics statistics = cache.GetStatistics();
+	EXPECT_EQ(statistics.rangeAllocationsNum, 3u);
+	EXPECT_EQ(statistics.reusedRangesNum, 0u);
+	EXPECT_EQ(statistics.cachedRangesNum, 3u);
+
+	// Released range stays in cache, so state that returns to previous contents reuses it
+	cache.ReleaseRange(firstRange);
+	CachedDescriptorRange* reacquiredRange = cache.AcquireRange(firstLayout, firstData);
+
+	EXPECT_EQ(reacquiredRange, firstRange);
+
+	statistics = cache.GetStatistics();
+	EXPECT_EQ(statistics.rangeAllocationsNum, 3u);
+	EXPECT_EQ(statistics.reusedRangesNum, 1u);
+
+	cache.ReleaseRange(reacquiredRange);
+	cache.ReleaseRange(secondRange);
+	cache.ReleaseRange(thirdRange);
+
+	cache.Uninitialize();
+
+	EXPECT_EQ(allocator.deallocationsNum, 3u);
+}
+
+TEST(DescriptorSetRangesCacheTests, FlushesCountDirtyBindings)
+{
+	priv::CPURangesAllocator allocator;
+	DescriptorSetRangesCache cache(allocator);
+
+	cache.RecordFlush(8u, false);
+	cache.RecordFlush(1u, true);
+	cache.RecordFlush(2u, true);
+	cache.RecordUncachedRangeUpload(32u);
+
+	DescriptorSetRangesCacheStatistics statistics = cache.GetStatistics();
+	EXPECT_EQ(statistics.flushesNum, 3u);
+	EXPECT_EQ(statistics.partialFlushesNum, 2u);
+	EXPECT_EQ(statistics.bindingWritesNum, 11u);
+	EXPECT_EQ(statistics.rangeAllocationsNum, 1u);
+	EXPECT_EQ(statistics.uploadedBytes, 32u);
+
+	cache.ResetStatistics();
+
+	statistics = cache.GetStatistics();
+	EXPECT_EQ(statistics.flushesNum, 0u);
+	EXPECT_EQ(statistics.bindingWritesNum, 0u);
+	EXPECT_EQ(statistics.rangeAllocationsNum, 0u);
+}
+
+} // spt::rdr::tests
@@ -0,0 +1,236 @@
+#include "gtest/gtest.h"
+#include "Pipelines/PSOsWarmList.h"
+#include "Pipelines/PSOsLibraryTypes.h"
+
+#include <fstream>
+#include <random>
+
+
+namespace spt::rdr::tests
+{
+
+namespace priv
+{
+
+/** Doesn't create any GPU resources, only records requested shaders and pipelines */
+class RecordingPSOCompiler : public PSOCompilerInterface
+{
+public:
+
+	virtual ShaderID CompileShader(const lib::String& shaderRelativePath, const sc::ShaderStageCompilationDef& shaderStageDef, const sc::ShaderCompilationSettings& compilationSettings) override
+	{
+		compiledShaders.emplace_back(shaderRelativePath);
+		return ShaderID(compiledShaders.size() - 1u, RENDERER_RESOURCE_NAME(shaderRelativePath));
+	}
+
+	virtual PipelineStateID CreateComputePipeline(const RendererResourceName& name, const rdr::ShaderID& shader) override
+	{
+		computePipelineShaders.emplace_back(shader);
+		return PipelineStateID(computePipelineShaders.size() - 1u, rhi::EPipelineType::Compute);
+	}
+
+	virtual PipelineStateID CreateGraphicsPipeline(const RendererResourceName& name, const GraphicsPipelineShaders& shaders, const rhi::GraphicsPipelineDefinition& pipelineDef) override
+	{
+		graphicsPipelineShaders.emplace_back(shaders);
+		graphicsPipelineDefs.emplace_back(pipelineDef);
+		return PipelineStateID(graphicsPipelineShaders.size() - 1u, rhi::EPipelineType::Graphics);
+	}
+
+	virtual PipelineStateID CreateRayTracingPipeline(const RendererResourceName& name, const RayTracingPipelineShaders& shaders, const rhi::RayTracingPipelineDefinition& pipelineDef) override
+	{
+		ADD_FAILURE() << "Ray tracing pipelines are not recorded in warm list";
+		return PipelineStateID();
+	}
+
+	lib::DynamicArray<lib::String>                      compiledShaders;
+	lib::DynamicArray<ShaderID>                         computePipelineShaders;
+	lib::DynamicArray<GraphicsPipelineShaders>          graphicsPipelineShaders;
+	lib::DynamicArray<rhi::GraphicsPipelineDefinition>  graphicsPipelineDefs;
+};
+
+
+static PSOWarmListShader CreateShader(const lib::String& path, rhi::EShaderStage stage, const lib::HashedString& entryPoint, const lib::HashedString& macro = lib::HashedString())
+{
+	PSOWarmListShader shader;
+	shader.shaderRelativePath = path;
+	shader.stageDef           = sc::ShaderStageCompilationDef(stage, entryPoint);
+
+	if (macro.IsValid())
+	{
+		shader.compilationSettings.AddMacroDefinition(sc::MacroDefinition(macro));
+	}
+
+	return shader;
+}
+
+
+static PSOWarmListComputePipeline CreateComputePipeline(const lib::String& path, const lib::HashedString& macro = lib::HashedString())
+{
+	PSOWarmListComputePipeline pipeline;
+	pipeline.name          = lib::HashedString(path);
+	pipeline.computeShader = CreateShader(path, rhi::EShaderStage::Compute, "Main", macro);
+	return pipeline;
+}
+
+
+static PSOWarmListGraphicsPipeline CreateGraphicsPipeline(const lib::String& path, rhi::EFragmentFormat colorFormat)
+{
+	PSOWarmListGraphicsPipeline pipeline;
+	pipeline.name           = lib::HashedString(path);
+	pipeline.vertexShader   = CreateShader(path, rhi::EShaderStage::Vertex, "VSMain");
+	pipeline.fragmentShader = CreateShader(path, rhi::EShaderStage::Fragment, "PSMain");
+
+	pipeline.pipelineDef.rasterizationDefinition.cullMode = rhi::ECullMode::None;
+
+	rhi::ColorRenderTargetDefinition colorRT;
+	colorRT.format         = colorFormat;
+	colorRT.colorBlendType = rhi::ERenderTargetBlendType::Add;
+	colorRT.colorWriteMask = rhi::ERenderTargetComponentFlags::R;
+	pipeline.pipelineDef.renderTargetsDefinition.colorRTsDefinition.emplace_back(colorRT);
+
+	pipeline.pipelineDef.renderTargetsDefinition.depthRTDefinition.format           = rhi::EFragmentFormat::D32_S_Float;
+	pipeline.pipelineDef.renderTargetsDefinition.depthRTDefinition.enableDepthWrite = false;
+
+	return pipeline;
+}
+
+
+/** Creates empty temporary directory and removes it at the end of the test */
+class TempDirectory
+{
+public:
+
+	TempDirectory()
+	{
+		std::random_device randomDevice;
+		m_path = std::filesystem::temp_directory_path() / ("SculptorPSOsWarmListTests_" + std::to_string(randomDevice()));
+		std::filesystem::create_directories(m_path);
+	}
+
+	~TempDirectory()
+	{
+		std::error_code errorCode;
+		std::filesystem::remove_all(m_path, errorCode);
+	}
+
+	const lib::Path& GetPath() const { return m_path; }
+
+private:
+
+	lib::Path m_path;
+};
+
+} // priv
+
+
+TEST(PSOsWarmListTests, RecordingDeduplicatesPipelines)
+{
+	PSOsWarmList warmList;
+
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Sculptor/Blur.hlsl"));
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Sculptor/Blur.hlsl"));
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Sculptor/Blur.hlsl", "HORIZONTAL"));
+
+	warmList.RecordGraphicsPipeline(priv::CreateGraphicsPipeline("Sculptor/Forward.hlsl", rhi::EFragmentFormat::RGBA8_UN_Float));
+	warmList.RecordGraphicsPipeline(priv::CreateGraphicsPipeline("Sculptor/Forward.hlsl", rhi::EFragmentFormat::RGBA8_UN_Float));
+	warmList.RecordGraphicsPipeline(priv::CreateGraphicsPipeline("Sculptor/Forward.hlsl", rhi::EFragmentFormat::RGBA16_S_Float));
+
+	EXPECT_EQ(warmList.GetComputePipelinesNum(), 2u);
+	EXPECT_EQ(warmList.GetGraphicsPipelinesNum(), 2u);
+}
+
+TEST(PSOsWarmListTests, BinaryRoundTripPreservesPipelines)
+{
+	PSOsWarmList warmList;
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Sculptor/Blur.hlsl", "HORIZONTAL"));
+	warmList.RecordGraphicsPipeline(priv::CreateGraphicsPipeline("Sculptor/Forward.hlsl", rhi::EFragmentFormat::RGBA8_UN_Float));
+
+	const lib::DynamicArray<Byte> data = warmList.SaveBinary();
+
+	PSOsWarmList loadedWarmList;
+	ASSERT_TRUE(loadedWarmList.LoadBinary(data));
+
+	EXPECT_EQ(loadedWarmList.GetComputePipelinesNum(), 1u);
+	EXPECT_EQ(loadedWarmList.GetGraphicsPipelinesNum(), 1u);
+
+	// Loaded pipelines must be recognized as already recorded
+	loadedWarmList.RecordComputePipeline(priv::CreateComputePipeline("Sculptor/Blur.hlsl", "HORIZONTAL"));
+	loadedWarmList.RecordGraphicsPipeline(priv::CreateGraphicsPipeline("Sculptor/Forward.hlsl", rhi::EFragmentFormat::RGBA8_UN_Float));
+
+	EXPECT_EQ(loadedWarmList.GetComputePipelinesNum(), 1u);
+	EXPECT_EQ(loadedWarmList.GetGraphicsPipelinesNum(), 1u);
+
+	priv::RecordingPSOCompiler compiler;
+	loadedWarmList.ScheduleCompilation(compiler);
+
+	ASSERT_EQ(compiler.graphicsPipelineDefs.size(), 1u);
+
+	const rhi::GraphicsPipelineDefinition& pipelineDef = compiler.graphicsPipelineDefs[0];
+	EXPECT_EQ(pipelineDef.rasterizationDefinition.cullMode, rhi::ECullMode::None);
+	ASSERT_EQ(pipelineDef.renderTargetsDefinition.colorRTsDefinition.size(), 1u);
+	EXPECT_EQ(pipelineDef.renderTargetsDefinition.colorRTsDefinition[0].format, rhi::EFragmentFormat::RGBA8_UN_Float);
+	EXPECT_EQ(pipelineDef.renderTargetsDefinition.colorRTsDefinition[0].colorBlendType, rhi::ERenderTargetBlendType::Add);
+	EXPECT_EQ(pipelineDef.renderTargetsDefinition.colorRTsDefinition[0].colorWriteMask, rhi::ERenderTargetComponentFlags::R);
+	EXPECT_EQ(pipelineDef.renderTargetsDefinition.depthRTDefinition.format, rhi::EFragmentFormat::D32_S_Float);
+	EXPECT_FALSE(pipelineDef.renderTargetsDefinition.depthRTDefinition.enableDepthWrite);
+}
+
+TEST(PSOsWarmListTests, ScheduleCompilationRequestsShadersAndPipelines)
+{
+	PSOsWarmList warmList;
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Sculptor/Blur.hlsl"));
+	warmList.RecordGraphicsPipeline(priv::CreateGraphicsPipeline("Sculptor/Forward.hlsl", rhi::EFragmentFormat::RGBA8_UN_Float));
+
+	priv::RecordingPSOCompiler compiler;
+	warmList.ScheduleCompilation(compiler);
+
+	// Task and mesh shaders are not used by the graphics pipeline, so they must not be compiled
+	EXPECT_EQ(compiler.compiledShaders.size(), 3u);
+
+	ASSERT_EQ(compiler.computePipelineShaders.size(), 1u);
+	EXPECT_TRUE(compiler.computePipelineShaders[0].IsValid());
+
+	ASSERT_EQ(compiler.graphicsPipelineShaders.size(), 1u);
+	const GraphicsPipelineShaders& shaders = compiler.graphicsPipelineShaders[0];
+	EXPECT_TRUE(shaders.vertexShader.IsValid());
+	EXPECT_FALSE(shaders.taskShader.IsValid());
+	EXPECT_FALSE(shaders.meshShader.IsValid());
+	EXPECT_TRUE(shaders.fragmentShader.IsValid());
+}
+
+TEST(PSOsWarmListTests, LoadRejectsInvalidData)
+{
+	PSOsWarmList warmList;
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Sculptor/Blur.hlsl"));
+
+	const lib::DynamicArray<Byte> garbage = { Byte(0x12), Byte(0x34), Byte(0x56) };
+
+	EXPECT_FALSE(warmList.LoadBinary(garbage));
+	EXPECT_FALSE(warmList.LoadBinary(lib::Span<const Byte>()));
+
+	// Content must not be changed if loading failed
+	EXPECT_EQ(warmList.GetComputePipelinesNum(), 1u);
+}
+
+TEST(PSOsWarmListTests, RemovesPipelinesWithMissingShaders)
+{
+	const priv::TempDirectory shadersDirectory;
+
+	std::ofstream(shadersDirectory.GetPath() / "Existing.hlsl") << "[numthreads(1, 1, 1)] void Main() {}";
+
+	PSOsWarmList warmList;
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Existing.hlsl"));
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Removed.hlsl"));
+	warmList.RecordGraphicsPipeline(priv::CreateGraphicsPipeline("Removed.hlsl", rhi::EFragmentFormat::RGBA8_UN_Float));
+
+	EXPECT_EQ(warmList.RemovePipelinesWithMissingShaders(shadersDirectory.GetPath()), 2u);
+
+	EXPECT_EQ(warmList.GetComputePipelinesNum(), 1u);
+	EXPECT_EQ(warmList.GetGraphicsPipelinesNum(), 0u);
+
+	// Removed pipelines can be recorded again
+	warmList.RecordComputePipeline(priv::CreateComputePipeline("Removed.hlsl"));
+	EXPECT_EQ(warmList.GetComputePipelinesNum(), 2u);
+}
+
+} // spt::rdr::tests
@@ -0,0 +1,14 @@
+#include "gtest/gtest.h"
+#include "Utility/String/HashedStringDB.h"
+
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	spt::lib::HashedStringDB::Initialize();
+
+	const auto testsResult = RUN_ALL_TESTS();
+
+	return testsResult;
+}
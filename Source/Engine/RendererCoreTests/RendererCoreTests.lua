@@ -0,0 +1,8 @@
+RendererCoreTests = Project:CreateProject("RendererCoreTests", ETargetType.Application)
+
+function RendererCoreTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("RendererCore")
+    self:AddPrivateDependency("GoogleTest")
+end
+
+RendererCoreTests:SetupProject()
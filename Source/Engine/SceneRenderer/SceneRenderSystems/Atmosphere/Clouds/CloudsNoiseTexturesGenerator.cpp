@@ -3,171 +3,262 @@
 #include "Types/Texture.h"
 #include "JobSystem.h"
 #include "Utility/Noise.h"
+#include "Utility/Hash.h"
 #include "MathUtils.h"
+#include "Engine.h"
+#include "DDC.h"
+
+
+SPT_DEFINE_LOG_CATEGORY(CloudsNoiseTexturesGenerator, true);
 
 
 namespace spt::rsc::clouds
 {
 
-CloudsNoiseData ComputeBaseShapeNoiseTextureWorley()
+namespace priv
+{
+
+/**
+ * Must be bumped whenever generation algorithms change, to invalidate volumes cached in DDC.
+ * Version 2: volumes are generated using batched noise (lib::noise::Generate*Batch) instead of TileableVolumeNoise.
+ * Frequencies and value ranges are the same, but noise patterns are different, so clouds shapes don't match shapes generated by previous versions
+ */
+static constexpr Uint64 noiseGeneratorVersion = 2u;
+
+static constexpr Uint32 rowsPerGenerationJob = 64u;
+
+
+struct NoiseRowsRange
+{
+	Uint32 firstRow = 0u;
+	Uint32 rowsNum  = 0u;
+};
+
+
+/**
+ * Generates volume row by row. Rows are split to ranges that are generated in parallel
+ * Row generator is called with normalized coordinates of all texels in row and must write normalized noise values
+ */
+template<typename TRowGenerator>
+lib::DynamicArray<Byte> GenerateNoiseVolume(math::Vector3u resolution, TRowGenerator&& rowGenerator)
 {
 	SPT_PROFILER_FUNCTION();
 
-	const math::Vector3u resolution(128u, 128u, 128u);
-	const rhi::EFragmentFormat format = rhi::EFragmentFormat::R8_UN_Float;
+	const Uint32 rowsNum = resolution.y() * resolution.z();
 
-	rhi::TextureDefinition textureDef;
-	textureDef.resolution = resolution;
-	textureDef.format     = format;
+	lib::DynamicArray<Byte> data(resolution.x() * rowsNum);
 
-	lib::DynamicArray<Byte> data(resolution.x() * resolution.y() * resolution.z());
+	lib::DynamicArray<NoiseRowsRange> ranges;
+	for (Uint32 firstRow = 0u; firstRow < rowsNum; firstRow += rowsPerGenerationJob)
+	{
+		ranges.emplace_back(NoiseRowsRange{ firstRow, std::min(rowsPerGenerationJob, rowsNum - firstRow) });
+	}
 
-	js::LaunchInline(SPT_GENERIC_JOB_NAME,
-					 [&data, resolution]()
-					 {
-						const Uint32 rowStride   = resolution.x() * sizeof(Uint8);
-						const Uint32 depthStride = resolution.y() * rowStride;
+	const auto generateRange = [&data, &rowGenerator, resolution](const NoiseRowsRange& range)
+	{
+		SPT_PROFILER_SCOPE("Generate Noise Rows");
 
-						 for (Uint32 z = 0u; z < resolution.z(); ++z)
-						 {
-							 for (Uint32 y = 0u; y < resolution.y(); ++y)
-							 {
-								 js::AddNested(SPT_GENERIC_JOB_NAME,
-											   [&data, z, y, resolution, rowStride, depthStride]()
-											   {
-												   for (Uint32 x = 0u; x < resolution.x(); ++x)
-												   {
-													   const math::Vector3f coords = (math::Vector3u(x, y, z).cast<Real32>() + math::Vector3f::Constant(0.5f)).cwiseQuotient(resolution.cast<Real32>());
+		lib::DynamicArray<math::Vector3f> coords(resolution.x());
+		lib::DynamicArray<Real32>         values(resolution.x());
 
-													   const Int32 octaveNum = 3;
-													   const Real32 frequency = 8.f;
-													   const Real32 perlinNoise = lib::noise::GenerateTileablePerlineNoise3D(coords, frequency, octaveNum);
+		const math::Vector3f rcpResolution = resolution.cast<Real32>().cwiseInverse();
 
-													   Real32 perlinWorleyNoise = 0.f;
-													   {
-														   const Real32 worleyCellCount     = 4.f;
-														   constexpr Uint32 worleyOctaveNum = 3u;
+		for (Uint32 rowIdx = range.firstRow; rowIdx < range.firstRow + range.rowsNum; ++rowIdx)
+		{
+			const Uint32 y = rowIdx % resolution.y();
+			const Uint32 z = rowIdx / resolution.y();
 
-														   const Real32 worleyFrequencies[worleyOctaveNum] = { 2.f, 8.f, 14.f };
+			for (Uint32 x = 0u; x < resolution.x(); ++x)
+			{
+				coords[x] = (math::Vector3u(x, y, z).cast<Real32>() + math::Vector3f::Constant(0.5f)).cwiseProduct(rcpResolution);
+			}
 
-														   Real32 worleyOctaves[worleyOctaveNum] = {};
-														   for (Uint32 i = 0u; i < worleyOctaveNum; ++i)
-														   {
-															   const Real32 worleyFrequency = worleyFrequencies[i];
+			rowGenerator(lib::Span<const math::Vector3f>(coords), lib::Span<Real32>(values));
 
-															   worleyOctaves[i] = (1.f - lib::noise::GenerateTileableWorleyNoise3D(coords, worleyCellCount * worleyFrequency));
-														   }
+			Byte* rowData = data.data() + static_cast<SizeType>(rowIdx) * resolution.x();
+			for (Uint32 x = 0u; x < resolution.x(); ++x)
+			{
+				rowData[x] = static_cast<Byte>(std::clamp(values[x], 0.f, 1.f) * 255.0f);
+			}
+		}
+	};
 
-														   const Real32 worleyFBM = worleyOctaves[0] * 0.625f + worleyOctaves[1] * 0.25f + worleyOctaves[2] * 0.125f;
+	js::InlineParallelForEach("Generate Noise Volume", ranges, generateRange);
 
-														   perlinWorleyNoise = math::Utils::Remap(perlinNoise, 1.f - worleyFBM, 1.f, 0.f, 1.f);
-													   }
+	return data;
+}
 
-													   const Real32 worleyCellCount = 4.f;
-													   constexpr Uint32 worleyOctaveNum = 4u;
 
-													   const Real32 worleyFrequencies[worleyOctaveNum] = { 2.f, 4.f, 8.f, 16.f };
+/** Loads volume from DDC if it was already generated with the same parameters. Otherwise generates it and stores in DDC */
+template<typename TGenerator>
+CloudsNoiseData LoadOrGenerateNoiseVolume(const char* name, math::Vector3u resolution, rhi::EFragmentFormat format, SizeType paramsHash, TGenerator&& generator)
+{
+	SPT_PROFILER_FUNCTION();
 
-													   Real32 worleyOctaves[worleyOctaveNum] = {};
-													   for (Uint32 i = 0u; i < worleyOctaveNum; ++i)
-													   {
-														   const Real32 worleyFrequency = worleyFrequencies[i];
+	CloudsNoiseData noiseData
+	{
+		.resolution = resolution,
+		.format     = format
+	};
 
-														   worleyOctaves[i] = (1.f - lib::noise::GenerateTileableWorleyNoise3D(coords, worleyCellCount * worleyFrequency));
-													   }
+	const SizeType dataSize = static_cast<SizeType>(resolution.x()) * resolution.y() * resolution.z();
 
-													   const Real32 worleyFBM0 = worleyOctaves[0] * 0.625f + worleyOctaves[1] * 0.25f + worleyOctaves[2] * 0.125f;
-													   const Real32 worleyFBM1 = worleyOctaves[1] * 0.625f + worleyOctaves[2] * 0.25f + worleyOctaves[3] * 0.125f;
-													   const Real32 worleyFBM2 = worleyOctaves[2] * 0.75f + worleyOctaves[3] * 0.25f;
+	const as::DDC& ddc = engn::GetEngine().GetAssetsSystem().GetDDC();
 
-													   const Real32 lowFreqFBM = worleyFBM0 * 0.625f + worleyFBM1 * 0.25f + worleyFBM2 * 0.125f;
-													   const Real32 baseCloud = perlinWorleyNoise;
+	const as::DerivedDataKey key(lib::HashCombine(lib::String(name), noiseGeneratorVersion, lib::noise::batchNoiseVersion), lib::HashCombine(paramsHash, resolution.x(), resolution.y(), resolution.z(), static_cast<Uint32>(format)));
 
-													   Real32 noiseValue = math::Utils::Remap(baseCloud, -(1.f - lowFreqFBM), 1.f, 0.f, 1.f);
+	const Bool canUseDDC = ddc.IsInitialized();
+
+	if (canUseDDC && ddc.DoesKeyExist(key))
+	{
+		const as::DDCResourceHandle handle = ddc.GetResourceHandle(key);
+		if (handle.IsValid() && handle.GetSize() == dataSize)
+		{
+			const lib::Span<const Byte> cachedData = handle.GetImmutableSpan();
+			noiseData.linearData.assign(std::cbegin(cachedData), std::cend(cachedData));
 
-													   noiseValue = std::min(1.f, std::max(0.f, noiseValue));
+			SPT_LOG_TRACE(CloudsNoiseTexturesGenerator, "Loaded {} from DDC", name);
 
-													   const Byte noiseValueUint8 = static_cast<Byte>(noiseValue * 255.0f);
+			return noiseData;
+		}
+	}
 
-													   data[z * depthStride + rowStride * y + x] = noiseValueUint8;
-												   }
-											   });
-							 }
-						 }
-					 });
+	noiseData.linearData = generator();
+	SPT_CHECK(noiseData.linearData.size() == dataSize);
 
-	return CloudsNoiseData
+	if (canUseDDC)
 	{
-		.resolution = resolution,
-		.format     = format,
-		.linearData = std::move(data)
-	};
+		ddc.CreateDerivedData(key, noiseData.linearData);
+	}
+
+	return noiseData;
 }
 
-CloudsNoiseData ComputeDetailShapeNoiseTextureWorley()
+
+struct BaseShapeNoiseParams
 {
+	math::Vector3u resolution = math::Vector3u::Constant(128u);
 
-	SPT_PROFILER_FUNCTION();
+	Real32 perlinFrequency  = 8.f;
+	Int32  perlinOctavesNum = 3;
 
-	const math::Vector3u resolution(32u, 32u, 32u);
-	const rhi::EFragmentFormat format = rhi::EFragmentFormat::R8_UN_Float;
+	Real32 worleyCellCount = 4.f;
 
-	rhi::TextureDefinition textureDef;
-	textureDef.resolution = resolution;
-	textureDef.format     = format;
+	SizeType Hash() const
+	{
+		return lib::HashCombine(perlinFrequency, perlinOctavesNum, worleyCellCount);
+	}
+};
 
-	lib::DynamicArray<Byte> data(resolution.x() * resolution.y() * resolution.z());
 
-	js::LaunchInline(SPT_GENERIC_JOB_NAME,
-					 [&data, resolution]()
-					 {
-						const Uint32 rowStride   = resolution.x() * sizeof(Uint8);
-						const Uint32 depthStride = resolution.y() * rowStride;
+struct DetailShapeNoiseParams
+{
+	math::Vector3u resolution = math::Vector3u::Constant(32u);
 
-						 for (Uint32 z = 0u; z < resolution.z(); ++z)
-						 {
-							 for (Uint32 y = 0u; y < resolution.y(); ++y)
-							 {
-								 js::AddNested(SPT_GENERIC_JOB_NAME,
-											   [&data, z, y, resolution, rowStride, depthStride]()
-											   {
-												   for (Uint32 x = 0u; x < resolution.x(); ++x)
-												   {
-													   const math::Vector3f coords = (math::Vector3u(x, y, z).cast<Real32>() + math::Vector3f::Constant(0.5f)).cwiseQuotient(resolution.cast<Real32>());
+	Real32 worleyCellCount = 2.f;
 
-													   const Real32 cellCount = 2.f;
+	SizeType Hash() const
+	{
+		return lib::HashCombine(worleyCellCount);
+	}
+};
 
-													   constexpr Uint32 worleyOctaveNum = 4u;
-													   const Real32 worleyFrequencies[worleyOctaveNum] = { 1.f, 2.f, 4.f, 8.f };
+} // priv
 
-													   Real32 worleyOctaves[worleyOctaveNum] = {};
-													   for (Uint32 octaveIdx = 0u; octaveIdx < worleyOctaveNum; ++octaveIdx)
-													   {
-														   const Real32 freq = worleyFrequencies[octaveIdx];
-														   worleyOctaves[octaveIdx] = (1.f - lib::noise::GenerateTileableWorleyNoise3D(coords, cellCount * freq));
-													   }
+CloudsNoiseData ComputeBaseShapeNoiseTextureWorley()
+{
+	SPT_PROFILER_FUNCTION();
 
-													   const Real32 worleyFBM0 = worleyOctaves[0] * 0.625f + worleyOctaves[1] * 0.25f + worleyOctaves[2] * 0.125f;
-													   const Real32 worleyFBM1 = worleyOctaves[1] * 0.625f + worleyOctaves[2] * 0.25f + worleyOctaves[3] * 0.125f;
-													   const Real32 worleyFBM2 = worleyOctaves[2] * 0.750f + worleyOctaves[3] * 0.25f;
+	const priv::BaseShapeNoiseParams params;
 
-													   Real32 noiseValue = worleyFBM0 * 0.625f + worleyFBM1 * 0.25f + worleyFBM2 * 0.125f;
+	const auto generateRow = [&params](lib::Span<const math::Vector3f> coords, lib::Span<Real32> outValues)
+	{
+		const SizeType texelsNum = coords.size();
+
+		lib::DynamicArray<Real32> perlinNoise(texelsNum);
+		lib::noise::GenerateTileablePerlinNoise3DBatch(coords, params.perlinFrequency, params.perlinOctavesNum, perlinNoise);
+
+		// Worley octaves used by both perlin-worley and low frequency fBm. Each unique frequency is evaluated once
+		constexpr Uint32 worleyOctavesNum = 5u;
+		const Real32 worleyFrequencies[worleyOctavesNum] = { 2.f, 4.f, 8.f, 14.f, 16.f };
+
+		lib::StaticArray<lib::DynamicArray<Real32>, worleyOctavesNum> worleyNoise;
+		for (Uint32 octaveIdx = 0u; octaveIdx < worleyOctavesNum; ++octaveIdx)
+		{
+			worleyNoise[octaveIdx].resize(texelsNum);
+			lib::noise::GenerateTileableWorleyNoise3DBatch(coords, params.worleyCellCount * worleyFrequencies[octaveIdx], worleyNoise[octaveIdx]);
+		}
+
+		for (SizeType idx = 0u; idx < texelsNum; ++idx)
+		{
+			const Real32 worley2  = 1.f - worleyNoise[0][idx];
+			const Real32 worley4  = 1.f - worleyNoise[1][idx];
+			const Real32 worley8  = 1.f - worleyNoise[2][idx];
+			const Real32 worley14 = 1.f - worleyNoise[3][idx];
+			const Real32 worley16 = 1.f - worleyNoise[4][idx];
+
+			const Real32 perlinWorleyFBM  = worley2 * 0.625f + worley8 * 0.25f + worley14 * 0.125f;
+			const Real32 perlinWorleyNoise = math::Utils::Remap(perlinNoise[idx], 1.f - perlinWorleyFBM, 1.f, 0.f, 1.f);
+
+			const Real32 worleyFBM0 = worley2 * 0.625f + worley4 * 0.25f + worley8 * 0.125f;
+			const Real32 worleyFBM1 = worley4 * 0.625f + worley8 * 0.25f + worley16 * 0.125f;
+			const Real32 worleyFBM2 = worley8 * 0.75f + worley16 * 0.25f;
+
+			const Real32 lowFreqFBM = worleyFBM0 * 0.625f + worleyFBM1 * 0.25f + worleyFBM2 * 0.125f;
+			const Real32 baseCloud = perlinWorleyNoise;
+
+			outValues[idx] = math::Utils::Remap(baseCloud, -(1.f - lowFreqFBM), 1.f, 0.f, 1.f);
+		}
+	};
+
+	return priv::LoadOrGenerateNoiseVolume("CloudsBaseShapeNoise", params.resolution, rhi::EFragmentFormat::R8_UN_Float, params.Hash(),
+										   [&params, &generateRow]()
+										   {
+											   return priv::GenerateNoiseVolume(params.resolution, generateRow);
+										   });
+}
 
-													   const Byte noiseValueUint8 = static_cast<Byte>(noiseValue * 255.0f);
+CloudsNoiseData ComputeDetailShapeNoiseTextureWorley()
+{
+	SPT_PROFILER_FUNCTION();
 
-													   data[z * depthStride + rowStride * y + x] = noiseValueUint8;
-												   }
-											   });
-							 }
-						 }
-					 });
+	const priv::DetailShapeNoiseParams params;
 
-	return CloudsNoiseData
+	const auto generateRow = [&params](lib::Span<const math::Vector3f> coords, lib::Span<Real32> outValues)
 	{
-		.resolution = resolution,
-		.format     = format,
-		.linearData = std::move(data)
+		const SizeType texelsNum = coords.size();
+
+		constexpr Uint32 worleyOctavesNum = 4u;
+		const Real32 worleyFrequencies[worleyOctavesNum] = { 1.f, 2.f, 4.f, 8.f };
+
+		lib::StaticArray<lib::DynamicArray<Real32>, worleyOctavesNum> worleyNoise;
+		for (Uint32 octaveIdx = 0u; octaveIdx < worleyOctavesNum; ++octaveIdx)
+		{
+			worleyNoise[octaveIdx].resize(texelsNum);
+			lib::noise::GenerateTileableWorleyNoise3DBatch(coords, params.worleyCellCount * worleyFrequencies[octaveIdx], worleyNoise[octaveIdx]);
+		}
+
+		for (SizeType idx = 0u; idx < texelsNum; ++idx)
+		{
+			Real32 worleyOctaves[worleyOctavesNum] = {};
+			for (Uint32 octaveIdx = 0u; octaveIdx < worleyOctavesNum; ++octaveIdx)
+			{
+				worleyOctaves[octaveIdx] = 1.f - worleyNoise[octaveIdx][idx];
+			}
+
+			const Real32 worleyFBM0 = worleyOctaves[0] * 0.625f + worleyOctaves[1] * 0.25f + worleyOctaves[2] * 0.125f;
+			const Real32 worleyFBM1 = worleyOctaves[1] * 0.625f + worleyOctaves[2] * 0.25f + worleyOctaves[3] * 0.125f;
+			const Real32 worleyFBM2 = worleyOctaves[2] * 0.750f + worleyOctaves[3] * 0.25f;
+
+			outValues[idx] = worleyFBM0 * 0.625f + worleyFBM1 * 0.25f + worleyFBM2 * 0.125f;
+		}
 	};
+
+	return priv::LoadOrGenerateNoiseVolume("CloudsDetailShapeNoise", params.resolution, rhi::EFragmentFormat::R8_UN_Float, params.Hash(),
+										   [&params, &generateRow]()
+										   {
+											   return priv::GenerateNoiseVolume(params.resolution, generateRow);
+										   });
 }
 
 } // spt::rsc::clouds
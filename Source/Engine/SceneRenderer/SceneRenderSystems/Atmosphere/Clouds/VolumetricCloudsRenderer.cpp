@@ -1025,6 +1025,7 @@ void VolumetricCloudsRenderer::LoadOrCreateBaseShapeNoiseTexture()
 		const Bool saveResult = gfx::TextureWriter::SaveTexture(baseShapeNoiseData.resolution, baseShapeNoiseData.format, baseShapeNoiseData.linearData, texturePath);
 		SPT_CHECK(saveResult);
 
+		texture = gfx::TextureLoader::LoadTexture(texturePath);
 		SPT_CHECK(!!texture);
 	}
 
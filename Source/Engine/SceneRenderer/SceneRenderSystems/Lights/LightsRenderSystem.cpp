@@ -372,15 +372,14 @@ static LightsInfo CreateLocalLightsData(rg::RenderGraphBuilder& graphBuilder, co
 
 	if (!localLights.empty())
 	{
-		lib::DynamicArray<rdr::HLSLStorage<LocalLightGPUData>> hlslLocalLights(localLights.size());
-		for (SizeType idx = 0; idx < localLights.size(); ++idx)
-		{
-			hlslLocalLights[idx] = localLights[idx];
-		}
-
 		const rhi::BufferDefinition lightsBufferDefinition(localLights.size() * sizeof(rdr::HLSLStorage<LocalLightGPUData>), rhi::EBufferUsage::Storage);
 		const lib::SharedRef<rdr::Buffer> localLightsBuffer = rdr::ResourcesManager::CreateBuffer(RENDERER_RESOURCE_NAME("SceneLocalLights"), lightsBufferDefinition, rhi::EMemoryUsage::CPUToGPU);
-		rdr::UploadDataToBuffer(localLightsBuffer, 0, reinterpret_cast<const Byte*>(hlslLocalLights.data()), hlslLocalLights.size() * sizeof(rdr::HLSLStorage<LocalLightGPUData>));
+
+		{
+			// Write lights directly to mapped memory, without intermediate HLSL array
+			const rhi::RHIMappedBuffer<rdr::HLSLStorage<LocalLightGPUData>> mappedLocalLights(localLightsBuffer->GetRHI());
+			rdr::CopyCPPToHLSLArray<LocalLightGPUData>(localLights, lib::Span<rdr::HLSLStorage<LocalLightGPUData>>(mappedLocalLights.Get(), localLights.size()));
+		}
 		localLightsRGBuffer = graphBuilder.AcquireExternalBufferView(localLightsBuffer->GetFullView());
 
 		const rhi::BufferDefinition lightZRangesBufferDefinition(localLightsZRanges.size() * sizeof(math::Vector2f), rhi::EBufferUsage::Storage);
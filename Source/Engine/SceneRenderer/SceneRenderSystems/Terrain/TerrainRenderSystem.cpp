@@ -10,6 +10,7 @@
 #include "Engine.h"
 #include "MaterialsSubsystem.h"
 #include "TerrainEditorRenderer.h"
+#include "Terrain/TerrainHeightMapStreamer.h"
 
 
 namespace spt::rsc
@@ -40,6 +41,8 @@ namespace renderer_params
 RendererBoolParameter enableTerrain("Enable Terrain", { "Terrain" }, false);
 RendererBoolParameter enableGrass("Enable Grass", { "Terrain" }, true);
 RendererBoolParameter enableTerrainPOM("Enable Terrain POM", { "Terrain" }, false);
+RendererFloatParameter heightMapStreamingRadius("Height Map Streaming Radius", { "Terrain", "Streaming" }, 768.f, 0.f, 2048.f);
+RendererIntParameter heightMapStreamingMaxLOD("Height Map Streaming Max LOD", { "Terrain", "Streaming" }, 3, 0, 7);
 } // renderer_params
 
 
@@ -1142,6 +1145,34 @@ void WriteTilesLODState(const lib::SharedPtr<rdr::Buffer>& buffer, const LODStat
 	}
 }
 
+/** Requests full resolution height map for tiles that are rendered with detailed LODs. Finer LODs and closer tiles get higher priority */
+void RequestHeightMapTiles(TerrainHeightMapStreamer& streamer, const LODState& state, math::Vector2i cameraTileCoord, Uint8 maxStreamedLOD)
+{
+	SPT_PROFILER_FUNCTION();
+
+	const Real32 heightMapSpanMeters = terrain_consts::clipmapExtentMeters * 2.f;
+
+	for (Uint32 tileY = 0u; tileY < state.tileRes.y(); ++tileY)
+	{
+		for (Uint32 tileX = 0u; tileX < state.tileRes.x(); ++tileX)
+		{
+			const math::Vector2i tileCoord = math::Vector2i(tileX, tileY);
+
+			const Uint8 lod = state.tiles[state.CoordToIdx(tileCoord)].lod;
+			if (lod == idxNone<Uint8> || lod > maxStreamedLOD)
+			{
+				continue;
+			}
+
+			const math::Vector2f tileCenter = (tileCoord.cast<Real32>() + math::Vector2f::Constant(0.5f)) * terrain_consts::tileSizeMeters;
+			const math::Vector2f heightMapUV = tileCenter / heightMapSpanMeters;
+
+			const Real32 priority = static_cast<Real32>(lod) + static_cast<Real32>(TileDistance(tileCoord, cameraTileCoord));
+			streamer.RequestTileAtUV(heightMapUV, priority);
+		}
+	}
+}
+
 } // lod
 
 struct TerrainRenderInstance
@@ -1293,6 +1324,21 @@ void TerrainRenderSystem::Update(const SceneUpdateContext& context)
 	lod::UpdateLODState(m_renderInstance->lodState, cameraTileCoord, *lodTransactions);
 	m_renderInstance->lodTransactions = lodTransactions;
 
+	const TerrainDefinition& terrainDef = GetOwningScene().GetTerrainDefinition();
+	if (terrainDef.heightMapStreamer)
+	{
+		TerrainHeightMapStreamer& streamer = *terrainDef.heightMapStreamer;
+
+		const math::Vector2f heightMapSpanMeters = math::Vector2f::Constant(terrain_consts::clipmapExtentMeters * 2.f);
+		const math::Vector2f cameraHeightMapUV   = cameraLocation.cwiseQuotient(heightMapSpanMeters) + math::Vector2f::Constant(0.5f);
+		const math::Vector2f metersPerTexel      = heightMapSpanMeters.cwiseQuotient(streamer.GetDefinition().resolution.cast<Real32>());
+
+		streamer.RequestTilesAroundLocation(cameraHeightMapUV, renderer_params::heightMapStreamingRadius, metersPerTexel);
+		lod::RequestHeightMapTiles(streamer, m_renderInstance->lodState, cameraTileCoord, static_cast<Uint8>(renderer_params::heightMapStreamingMaxLOD));
+
+		streamer.Update(context.rendererSettings.frame.GetFrameIdx());
+	}
+
 	const math::Vector2i cameraGrassTile = grass_utils::GetTileCoord(cameraLocation);
 	m_grassFieldDef.originTile      = cameraGrassTile - math::Vector2i::Constant(static_cast<Int32>(terrain_consts::grassTilesExtent));
 	m_grassFieldDef.tilesResolution = math::Vector2i::Constant(terrain_consts::grassTilesExtent * 2);
@@ -1310,17 +1356,35 @@ void TerrainRenderSystem::UpdateGPUSceneData(const SceneUpdateContext& context,
 
 	const TerrainDefinition& terrainDef = GetOwningScene().GetTerrainDefinition();
 	const lib::SharedPtr<rdr::TextureView>& heightMap = terrainDef.heightMap;
+	const lib::SharedPtr<TerrainHeightMapStreamer>& heightMapStreamer = terrainDef.heightMapStreamer;
 
 	TerrainHeightMap heightMapData;
 	heightMapData.texture        = heightMap;
-	heightMapData.res            = heightMap ? heightMap->GetResolution2D() : math::Vector2u{0u, 0u};
-	heightMapData.invRes         = heightMap ? math::Vector2f::Ones().cwiseQuotient(heightMapData.res.cast<Real32>()) : math::Vector2f{0.f, 0.f};
 	heightMapData.spanMeters     = math::Vector2f::Constant(terrain_consts::clipmapExtentMeters * 2.f);
 	heightMapData.invSpanMeters  = math::Vector2f::Ones().cwiseQuotient(heightMapData.spanMeters);
-	heightMapData.metersPerTexel = heightMap ? heightMapData.spanMeters.cwiseQuotient(heightMapData.res.cast<Real32>()) : math::Vector2f{0.f, 0.f};
 	heightMapData.minHeight      = 0.f;
 	heightMapData.maxHeight      = 1200.f;
 
+	if (heightMapStreamer)
+	{
+		const TerrainHeightMapStreamingDefinition& streamingDef = heightMapStreamer->GetDefinition();
+
+		heightMapData.physicalTiles       = heightMapStreamer->GetPhysicalTexture();
+		heightMapData.pageTable           = heightMapStreamer->GetPageTable()->GetFullView();
+		heightMapData.streamingTilesNum   = streamingDef.tilesNum;
+		heightMapData.streamingTileRes    = streamingDef.tileResolution.x();
+		heightMapData.physicalSlotsPerRow = heightMapStreamer->GetPhysicalSlotsPerRow();
+		heightMapData.res                 = streamingDef.resolution;
+	}
+	else
+	{
+		heightMapData.streamingTilesNum = math::Vector2u::Zero();
+		heightMapData.res               = heightMap ? heightMap->GetResolution2D() : math::Vector2u{0u, 0u};
+	}
+
+	heightMapData.invRes         = heightMapData.res.x() > 0u ? math::Vector2f::Ones().cwiseQuotient(heightMapData.res.cast<Real32>()) : math::Vector2f{0.f, 0.f};
+	heightMapData.metersPerTexel = heightMapData.res.x() > 0u ? heightMapData.spanMeters.cwiseQuotient(heightMapData.res.cast<Real32>()) : math::Vector2f{0.f, 0.f};
+
 	TerrrainMaterialCache matCache;
 	for (Uint32 i = 0u; i < terrain_consts::materialCacheLODsNum; ++i)
 	{
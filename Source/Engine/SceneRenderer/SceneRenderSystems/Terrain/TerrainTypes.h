@@ -22,7 +22,12 @@ END_SHADER_STRUCT();
 
 
 BEGIN_SHADER_STRUCT(TerrainHeightMap)
-	SHADER_STRUCT_FIELD(gfx::ConstSRVTexture2D<Real32>, texture)
+	SHADER_STRUCT_FIELD(gfx::ConstSRVTexture2D<Real32>, texture) // low resolution fallback, always resident
+	SHADER_STRUCT_FIELD(gfx::ConstSRVTexture2D<Real32>, physicalTiles)
+	SHADER_STRUCT_FIELD(gfx::TypedBuffer<Uint32>,       pageTable)
+	SHADER_STRUCT_FIELD(math::Vector2u,                 streamingTilesNum) // zero if height map is not streamed
+	SHADER_STRUCT_FIELD(Uint32,                         streamingTileRes)
+	SHADER_STRUCT_FIELD(Uint32,                         physicalSlotsPerRow)
 	SHADER_STRUCT_FIELD(math::Vector2u,                 res)
 	SHADER_STRUCT_FIELD(math::Vector2f,                 invRes)
 	SHADER_STRUCT_FIELD(math::Vector2f,                 spanMeters)
@@ -191,6 +191,9 @@ lib::MTHandle<RenderSceneDS> UpdateRenderSystemsPerFrame(SceneRendererData& rend
 	geometryData.staticMeshGeometryBuffers = StaticMeshUnifiedData::Get().GetGeometryBuffers();
 	geometryData.ugb                       = GeometryManager::Get().GetUnifiedGeometryBuffer();
 
+	// Upload all material changes that happened since previous frame
+	mat::MaterialsUnifiedData::Get().FlushPendingUpdates();
+
 	GPUMaterialsData gpuMaterials;
 	gpuMaterials.data = mat::MaterialsUnifiedData::Get().GetMaterialUnifiedData();
 
@@ -0,0 +1,284 @@
+#include "ConcurrentIndexAllocator.h"
+#include "Assertions/Assertions.h"
+
+#include <algorithm>
+
+
+namespace spt::lib
+{
+
+namespace priv
+{
+
+static Uint32 CreateAllocatorID()
+{
+	static std::atomic<Uint32> nextID = 0u;
+	return nextID.fetch_add(1u, std::memory_order_relaxed);
+}
+
+
+/** Caches created by this thread. Allocator is identified by ID, because addresses of allocators can be reused */
+struct ThreadCaches
+{
+	lib::DynamicArray<std::pair<Uint32, std::shared_ptr<index_allocator_impl::ThreadCache>>> caches;
+};
+
+thread_local ThreadCaches tlsThreadCaches;
+
+} // priv
+
+namespace index_allocator_impl
+{
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// BatchesStack ==================================================================================
+
+void BatchesStack::Push(lib::Span<IndicesBatch> batches, Uint32 batchIdx)
+{
+	SPT_CHECK(batchIdx < batches.size());
+
+	Uint64 head = m_head.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		batches[batchIdx].next.store(static_cast<Uint32>(head), std::memory_order_relaxed);
+
+		const Uint32 newTag = static_cast<Uint32>(head >> 32) + 1u;
+		if (m_head.compare_exchange_weak(head, PackHead(batchIdx, newTag), std::memory_order_release, std::memory_order_relaxed))
+		{
+			break;
+		}
+	}
+}
+
+Uint32 BatchesStack::Pop(lib::Span<IndicesBatch> batches)
+{
+	Uint64 head = m_head.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		const Uint32 batchIdx = static_cast<Uint32>(head);
+		if (batchIdx == idxNone<Uint32>)
+		{
+			return idxNone<Uint32>;
+		}
+
+		// Next may be already changed if batch was popped by other thread, but then tag doesn't match and exchange fails
+		const Uint32 nextBatchIdx = batches[batchIdx].next.load(std::memory_order_relaxed);
+
+		const Uint32 newTag = static_cast<Uint32>(head >> 32) + 1u;
+		if (m_head.compare_exchange_weak(head, PackHead(nextBatchIdx, newTag), std::memory_order_acquire, std::memory_order_acquire))
+		{
+			return batchIdx;
+		}
+	}
+}
+
+} // index_allocator_impl
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// ConcurrentIndexAllocator ======================================================================
+
+ConcurrentIndexAllocator::ConcurrentIndexAllocator(Uint32 size)
+	: m_id(priv::CreateAllocatorID())
+	, m_size(size)
+{
+	using namespace index_allocator_impl;
+
+	// Full batches always contain batchSize indices (except initial last batch), so this is enough batches to store all indices and free batches are never missing
+	const Uint32 batchesNum = (size + batchSize - 1u) / batchSize + 1u;
+	m_batches = lib::DynamicArray<IndicesBatch>(batchesNum);
+
+	Uint32 nextIdx = 0u;
+
+	// Push batches in reversed order, so indices are initially allocated from 0
+	const Uint32 fullBatchesNum = (size + batchSize - 1u) / batchSize;
+	for (Uint32 batchIdx = 0u; batchIdx < fullBatchesNum; ++batchIdx)
+	{
+		IndicesBatch& batch = m_batches[batchIdx];
+		batch.indicesNum = std::min(batchSize, size - nextIdx);
+
+		// Indices are allocated from the end of the batch
+		for (Uint32 idx = 0u; idx < batch.indicesNum; ++idx)
+		{
+			batch.indices[batch.indicesNum - idx - 1u] = nextIdx++;
+		}
+	}
+
+	for (Uint32 batchIdx = fullBatchesNum; batchIdx > 0u; --batchIdx)
+	{
+		m_fullBatches.Push(m_batches, batchIdx - 1u);
+	}
+
+	for (Uint32 batchIdx = fullBatchesNum; batchIdx < batchesNum; ++batchIdx)
+	{
+		m_emptyBatches.Push(m_batches, batchIdx);
+	}
+}
+
+ConcurrentIndexAllocator::~ConcurrentIndexAllocator()
+{
+	const lib::LockGuard lockGuard(m_threadCachesLock);
+
+	for (const std::shared_ptr<index_allocator_impl::ThreadCache>& cache : m_threadCaches)
+	{
+		cache->isAllocatorAlive.store(false, std::memory_order_relaxed);
+	}
+}
+
+Uint32 ConcurrentIndexAllocator::Allocate()
+{
+	index_allocator_impl::ThreadCache& cache = GetThreadCache();
+
+	{
+		const lib::LockGuard lockGuard(cache.lock);
+
+		if (cache.indicesNum > 0u || RefillCache(cache))
+		{
+			return cache.indices[--cache.indicesNum];
+		}
+	}
+
+	return StealIndex();
+}
+
+void ConcurrentIndexAllocator::Free(Uint32 idx)
+{
+	SPT_CHECK(idx < m_size);
+
+	index_allocator_impl::ThreadCache& cache = GetThreadCache();
+
+	const lib::LockGuard lockGuard(cache.lock);
+
+	if (cache.indicesNum == cache.indices.size())
+	{
+		// Return half of the cache, so next allocations and frees still don't have to access shared pool
+		cache.indicesNum -= index_allocator_impl::batchSize;
+		ReturnBatch(lib::Span<const Uint32>(cache.indices.data() + cache.indicesNum, index_allocator_impl::batchSize));
+	}
+
+	cache.indices[cache.indicesNum++] = idx;
+}
+
+void ConcurrentIndexAllocator::FreeBulk(lib::Span<const Uint32> indices)
+{
+	using namespace index_allocator_impl;
+
+	SizeType currentIdx = 0u;
+
+	for (; currentIdx + batchSize <= indices.size(); currentIdx += batchSize)
+	{
+		ReturnBatch(indices.subspan(currentIdx, batchSize));
+	}
+
+	for (; currentIdx < indices.size(); ++currentIdx)
+	{
+		Free(indices[currentIdx]);
+	}
+}
+
+Uint32 ConcurrentIndexAllocator::GetFreeIndicesNum() const
+{
+	Uint32 freeIndicesNum = 0u;
+
+	m_fullBatches.ForEachBatch(m_batches,
+							   [&freeIndicesNum](const index_allocator_impl::IndicesBatch& batch)
+							   {
+								   freeIndicesNum += batch.indicesNum;
+							   });
+
+	const lib::LockGuard lockGuard(m_threadCachesLock);
+
+	for (const std::shared_ptr<index_allocator_impl::ThreadCache>& cache : m_threadCaches)
+	{
+		// Cache may be still used by its thread
+		const lib::LockGuard cacheLockGuard(cache->lock);
+		freeIndicesNum += cache->indicesNum;
+	}
+
+	return freeIndicesNum;
+}
+
+index_allocator_impl::ThreadCache& ConcurrentIndexAllocator::GetThreadCache()
+{
+	priv::ThreadCaches& threadCaches = priv::tlsThreadCaches;
+
+	for (const auto& [allocatorID, cache] : threadCaches.caches)
+	{
+		if (allocatorID == m_id)
+		{
+			return *cache;
+		}
+	}
+
+	// Release caches of destroyed allocators
+	std::erase_if(threadCaches.caches,
+				  [](const auto& entry)
+				  {
+					  return !entry.second->isAllocatorAlive.load(std::memory_order_relaxed);
+				  });
+
+	std::shared_ptr<index_allocator_impl::ThreadCache> cache = std::make_shared<index_allocator_impl::ThreadCache>();
+
+	{
+		const lib::LockGuard lockGuard(m_threadCachesLock);
+		m_threadCaches.emplace_back(cache);
+	}
+
+	threadCaches.caches.emplace_back(m_id, cache);
+
+	return *cache;
+}
+
+Bool ConcurrentIndexAllocator::RefillCache(index_allocator_impl::ThreadCache& cache)
+{
+	const Uint32 batchIdx = m_fullBatches.Pop(m_batches);
+	if (batchIdx == idxNone<Uint32>)
+	{
+		return false;
+	}
+
+	const index_allocator_impl::IndicesBatch& batch = m_batches[batchIdx];
+
+	SPT_CHECK(cache.indicesNum + batch.indicesNum <= cache.indices.size());
+	std::copy_n(batch.indices.data(), batch.indicesNum, cache.indices.data() + cache.indicesNum);
+	cache.indicesNum += batch.indicesNum;
+
+	m_emptyBatches.Push(m_batches, batchIdx);
+
+	return cache.indicesNum > 0u;
+}
+
+void ConcurrentIndexAllocator::ReturnBatch(lib::Span<const Uint32> indices)
+{
+	SPT_CHECK(indices.size() <= index_allocator_impl::batchSize);
+
+	const Uint32 batchIdx = m_emptyBatches.Pop(m_batches);
+	SPT_CHECK_MSG(batchIdx != idxNone<Uint32>, "No free batches (index was freed multiple times?)");
+
+	index_allocator_impl::IndicesBatch& batch = m_batches[batchIdx];
+	std::copy(std::cbegin(indices), std::cend(indices), batch.indices.data());
+	batch.indicesNum = static_cast<Uint32>(indices.size());
+
+	m_fullBatches.Push(m_batches, batchIdx);
+}
+
+Uint32 ConcurrentIndexAllocator::StealIndex()
+{
+	// Shared pool is empty, so the only free indices may be in caches of other threads
+	const lib::LockGuard lockGuard(m_threadCachesLock);
+
+	for (const std::shared_ptr<index_allocator_impl::ThreadCache>& cache : m_threadCaches)
+	{
+		const lib::LockGuard cacheLockGuard(cache->lock);
+
+		if (cache->indicesNum > 0u || RefillCache(*cache))
+		{
+			return cache->indices[--cache->indicesNum];
+		}
+	}
+
+	return idxNone<Uint32>;
+}
+
+} // spt::lib
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "SculptorAliases.h"
+#include "SculptorLibMacros.h"
+#include "Utility/Threading/Lock.h"
+#include "Utility/Threading/Spinlock.h"
+#include "Containers/DynamicArray.h"
+#include "Containers/StaticArray.h"
+#include "Containers/Span.h"
+
+#include <atomic>
+#include <memory>
+
+
+namespace spt::lib
+{
+
+namespace index_allocator_impl
+{
+
+static constexpr Uint32 batchSize = 64u;
+
+
+/** Batch of free indices. Batches are moved between thread caches and shared pool as a whole */
+struct IndicesBatch
+{
+	lib::StaticArray<Uint32, batchSize> indices;
+	Uint32                              indicesNum = 0u;
+	std::atomic<Uint32>                 next       = idxNone<Uint32>;
+};
+
+
+/** Lock-free stack of batches. Batches are referenced by index, head is tagged to prevent ABA problem */
+class BatchesStack
+{
+public:
+
+	BatchesStack() = default;
+
+	void   Push(lib::Span<IndicesBatch> batches, Uint32 batchIdx);
+	Uint32 Pop(lib::Span<IndicesBatch> batches);
+
+	/** Not thread safe */
+	template<typename TCallable>
+	void ForEachBatch(lib::Span<const IndicesBatch> batches, TCallable&& callable) const
+	{
+		Uint32 batchIdx = static_cast<Uint32>(m_head.load(std::memory_order_acquire));
+		while (batchIdx != idxNone<Uint32>)
+		{
+			callable(batches[batchIdx]);
+			batchIdx = batches[batchIdx].next.load(std::memory_order_relaxed);
+		}
+	}
+
+private:
+
+	static Uint64 PackHead(Uint32 batchIdx, Uint32 tag) { return (static_cast<Uint64>(tag) << 32) | batchIdx; }
+
+	std::atomic<Uint64> m_head = idxNone<Uint32>;
+};
+
+
+struct ThreadCache
+{
+	lib::Spinlock lock;
+
+	lib::StaticArray<Uint32, batchSize * 2u> indices;
+	Uint32                                   indicesNum = 0u;
+
+	std::atomic<Bool> isAllocatorAlive = true;
+};
+
+} // index_allocator_impl
+
+
+/**
+ * Allocates indices in range [0, size) from multiple threads.
+ * Each thread has its own cache of free indices, which is refilled from (and returned to) shared pool of batches using lock-free operations.
+ * Indices cached by other threads are used only when shared pool is empty.
+ */
+class SCULPTOR_LIB_API ConcurrentIndexAllocator
+{
+public:
+
+	explicit ConcurrentIndexAllocator(Uint32 size);
+	~ConcurrentIndexAllocator();
+
+	ConcurrentIndexAllocator(const ConcurrentIndexAllocator& rhs) = delete;
+	ConcurrentIndexAllocator& operator=(const ConcurrentIndexAllocator& rhs) = delete;
+
+	/** Returns idxNone<Uint32> if all indices are allocated */
+	Uint32 Allocate();
+
+	void Free(Uint32 idx);
+	void FreeBulk(lib::Span<const Uint32> indices);
+
+	Uint32 GetSize() const { return m_size; }
+
+	/** Thread caches are read under their locks, but shared pool isn't, so result is exact only if there are no concurrent allocations and frees */
+	Uint32 GetFreeIndicesNum() const;
+
+private:
+
+	index_allocator_impl::ThreadCache& GetThreadCache();
+
+	Bool RefillCache(index_allocator_impl::ThreadCache& cache);
+	void ReturnBatch(lib::Span<const Uint32> indices);
+
+	Uint32 StealIndex();
+
+	const Uint32 m_id;
+	const Uint32 m_size;
+
+	lib::DynamicArray<index_allocator_impl::IndicesBatch> m_batches;
+
+	index_allocator_impl::BatchesStack m_fullBatches;
+	index_allocator_impl::BatchesStack m_emptyBatches;
+
+	mutable lib::Lock m_threadCachesLock;
+	lib::DynamicArray<std::shared_ptr<index_allocator_impl::ThreadCache>> m_threadCaches;
+};
+
+} // spt::lib
@@ -4,6 +4,7 @@
 #include "SculptorCoreTypes.h"
 #include "Delegate.h"
 #include "Utility/ValueGuard.h"
+#include "Utility/Threading/RCUData.h"
 
 #include <vector>
 
@@ -96,15 +97,13 @@ public:
 
 	MulticastDelegateBase(MulticastDelegateBase<true, TReturnType(TArgs...)>&& rhs) requires !isThreadSafe
 	{
-		const auto lock = rhs.LockIfNecessary();
-		m_delegates = std::move(rhs.m_delegates);
+		m_delegates = rhs.ExtractDelegates();
 		m_handleCounter = rhs.m_handleCounter;
 	}
 
 	MulticastDelegateBase& operator=(MulticastDelegateBase<true, TReturnType(TArgs...)>&& rhs) requires !isThreadSafe
 	{
-		const auto lock = rhs.LockIfNecessary();
-		m_delegates = std::move(rhs.m_delegates);
+		m_delegates = rhs.ExtractDelegates();
 		m_handleCounter = std::max(rhs.m_handleCounter, m_handleCounter);
 		return *this;
 	}
@@ -306,6 +305,378 @@ void MulticastDelegateBase<isThreadSafe, TReturnType(TArgs...)>::ResetAndBroadca
 	}
 }
 
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Thread Safe Multicast Delegate ================================================================
+
+namespace priv
+{
+
+template<typename TDelegate>
+struct SharedDelegateInfo
+{
+	SharedDelegateInfo(DelegateHandle inHandle, TDelegate inDelegate)
+		: delegate(std::move(inDelegate))
+		, handle(inHandle)
+	{ }
+
+	TDelegate		delegate;
+	DelegateHandle	handle;
+
+	/** Set when delegate is unbound, so broadcasts that still use older snapshot skip it */
+	std::atomic<Bool> isUnbound = false;
+};
+
+
+template<typename TDelegate>
+struct DelegatesSnapshot
+{
+	lib::DynamicArray<lib::SharedPtr<SharedDelegateInfo<TDelegate>>> delegates;
+};
+
+} // priv
+
+
+/**
+ * Thread safe multicast delegate.
+ * Broadcasts don't take any lock - they iterate over immutable snapshot of delegates.
+ * Binds and unbinds are serialized with lock and publish new snapshot. Old snapshots are destroyed when all broadcasts that use them are finished.
+ * Delegate unbound during broadcast won't be executed by that broadcast, but it may still be executing on other threads when Unbind returns.
+ */
+template<typename TReturnType, typename... TArgs>
+class MulticastDelegateBase<true, TReturnType(TArgs...)>
+{
+public:
+
+	using Delegate = DelegateBase<false, TReturnType(TArgs...)>;
+
+private:
+
+	using DelegateInfo       = priv::DelegateInfo<Delegate>;
+	using SharedDelegateInfo = priv::SharedDelegateInfo<Delegate>;
+	using DelegatesSnapshot  = priv::DelegatesSnapshot<Delegate>;
+
+public:
+
+	using ThisType = MulticastDelegateBase<true, TReturnType(TArgs...)>;
+
+	MulticastDelegateBase()
+		: m_handleCounter(1)
+	{ }
+
+	MulticastDelegateBase(const ThisType& rhs) = delete;
+	ThisType& operator=(const ThisType& rhs) = delete;
+
+	~MulticastDelegateBase() = default;
+
+	DelegateHandle		Add(Delegate delegate);
+
+	template<typename TFuncType, typename... TPayload>
+	DelegateHandle		AddRaw(TFuncType function, TPayload&&... payload);
+
+	template<typename TObjectType, typename TFuncType, typename... TPayload>
+	DelegateHandle		AddRawMember(TObjectType* object, TFuncType function, TPayload&&... payload);
+
+	template<typename TObjectType, typename TFuncType, typename... TPayload>
+	DelegateHandle		AddSharedMember(lib::SharedPtr<TObjectType> object, TFuncType function, TPayload&&... payload);
+
+	template<typename TObjectType, typename TFuncType, typename... TPayload>
+	DelegateHandle		AddWeakMember(const lib::SharedPtr<TObjectType>& object, TFuncType function, TPayload&&... payload);
+
+	template<typename TLambda, typename... TPayload>
+	DelegateHandle		AddLambda(TLambda&& callable, TPayload&&... payload);
+
+	void				Unbind(DelegateHandle handle);
+
+	void				Reset();
+
+	Bool				IsBound() const;
+
+	void				Broadcast(TArgs... arguments);
+	void				ResetAndBroadcast(TArgs... arguments);
+
+	/** Moves out all bound delegates. Must not be called concurrently with broadcasts */
+	lib::DynamicArray<DelegateInfo> ExtractDelegates();
+
+private:
+
+	/** Copies current snapshot, so it can be modified and published. Must be called with write lock */
+	lib::UniquePtr<DelegatesSnapshot> CopySnapshot() const;
+
+	void PublishSnapshot(lib::UniquePtr<DelegatesSnapshot> snapshot);
+
+	void RemoveInvalidDelegates();
+	void TryReclaimSnapshots();
+
+	lib::RCUData<DelegatesSnapshot>		m_snapshot;
+
+	mutable lib::RecursiveLock			m_writeLock;
+	DelegateIDType						m_handleCounter;
+
+	friend MulticastDelegateBase<false, TReturnType(TArgs...)>;
+};
+
+template<typename TReturnType, typename... TArgs>
+DelegateHandle MulticastDelegateBase<true, TReturnType(TArgs...)>::Add(Delegate delegate)
+{
+	const lib::LockGuard lockGuard(m_writeLock);
+
+	const DelegateHandle handle = m_handleCounter++;
+
+	lib::UniquePtr<DelegatesSnapshot> newSnapshot = CopySnapshot();
+	newSnapshot->delegates.emplace_back(std::make_shared<SharedDelegateInfo>(handle, std::move(delegate)));
+	PublishSnapshot(std::move(newSnapshot));
+
+	return handle;
+}
+
+template<typename TReturnType, typename... TArgs>
+template<typename TFuncType, typename... TPayload>
+DelegateHandle MulticastDelegateBase<true, TReturnType(TArgs...)>::AddRaw(TFuncType function, TPayload&&... payload)
+{
+	Delegate delegate;
+	delegate.BindRaw(function, std::forward<TPayload>(payload)...);
+	return Add(std::move(delegate));
+}
+
+template<typename TReturnType, typename... TArgs>
+template<typename TObjectType, typename TFuncType, typename... TPayload>
+DelegateHandle MulticastDelegateBase<true, TReturnType(TArgs...)>::AddRawMember(TObjectType* object, TFuncType function, TPayload&&... payload)
+{
+	Delegate delegate;
+	delegate.BindRawMember(object, function, std::forward<TPayload>(payload)...);
+	return Add(std::move(delegate));
+}
+
+template<typename TReturnType, typename... TArgs>
+template<typename TObjectType, typename TFuncType, typename... TPayload>
+DelegateHandle MulticastDelegateBase<true, TReturnType(TArgs...)>::AddSharedMember(lib::SharedPtr<TObjectType> object, TFuncType function, TPayload&&... payload)
+{
+	Delegate delegate;
+	delegate.BindSharedMember(std::move(object), function, std::forward<TPayload>(payload)...);
+	return Add(std::move(delegate));
+}
+
+template<typename TReturnType, typename... TArgs>
+template<typename TObjectType, typename TFuncType, typename... TPayload>
+DelegateHandle MulticastDelegateBase<true, TReturnType(TArgs...)>::AddWeakMember(const lib::SharedPtr<TObjectType>& object, TFuncType function, TPayload&&... payload)
+{
+	Delegate delegate;
+	delegate.BindWeakMember(object, function, std::forward<TPayload>(payload)...);
+	return Add(std::move(delegate));
+}
+
+template<typename TReturnType, typename... TArgs>
+template<typename TLambda, typename... TPayload>
+DelegateHandle MulticastDelegateBase<true, TReturnType(TArgs...)>::AddLambda(TLambda&& callable, TPayload&&... payload)
+{
+	Delegate delegate;
+	delegate.BindLambda(std::forward<TLambda>(callable), std::forward<TPayload>(payload)...);
+	return Add(std::move(delegate));
+}
+
+template<typename TReturnType, typename... TArgs>
+void MulticastDelegateBase<true, TReturnType(TArgs...)>::Unbind(DelegateHandle handle)
+{
+	const lib::LockGuard lockGuard(m_writeLock);
+
+	const DelegatesSnapshot* currentSnapshot = m_snapshot.GetCurrent();
+	if (!currentSnapshot)
+	{
+		return;
+	}
+
+	const auto foundDelegate = std::find_if(std::cbegin(currentSnapshot->delegates), std::cend(currentSnapshot->delegates),
+											[handle](const lib::SharedPtr<SharedDelegateInfo>& info)
+											{
+												return info->handle == handle;
+											});
+
+	if (foundDelegate == std::cend(currentSnapshot->delegates))
+	{
+		return;
+	}
+
+	(*foundDelegate)->isUnbound.store(true, std::memory_order_release);
+
+	lib::UniquePtr<DelegatesSnapshot> newSnapshot = CopySnapshot();
+	std::erase_if(newSnapshot->delegates, [handle](const lib::SharedPtr<SharedDelegateInfo>& info) { return info->handle == handle; });
+	PublishSnapshot(std::move(newSnapshot));
+}
+
+template<typename TReturnType, typename... TArgs>
+void MulticastDelegateBase<true, TReturnType(TArgs...)>::Reset()
+{
+	const lib::LockGuard lockGuard(m_writeLock);
+
+	if (const DelegatesSnapshot* currentSnapshot = m_snapshot.GetCurrent())
+	{
+		for (const lib::SharedPtr<SharedDelegateInfo>& info : currentSnapshot->delegates)
+		{
+			info->isUnbound.store(true, std::memory_order_release);
+		}
+
+		PublishSnapshot(nullptr);
+	}
+}
+
+template<typename TReturnType, typename... TArgs>
+Bool MulticastDelegateBase<true, TReturnType(TArgs...)>::IsBound() const
+{
+	const auto readScope = m_snapshot.Read();
+	const DelegatesSnapshot* snapshot = readScope.Get();
+	return snapshot && !snapshot->delegates.empty();
+}
+
+template<typename TReturnType, typename... TArgs>
+void MulticastDelegateBase<true, TReturnType(TArgs...)>::Broadcast(TArgs... arguments)
+{
+	Bool foundInvalid = false;
+
+	{
+		const auto readScope = m_snapshot.Read();
+
+		if (const DelegatesSnapshot* snapshot = readScope.Get())
+		{
+			for (const lib::SharedPtr<SharedDelegateInfo>& info : snapshot->delegates)
+			{
+				if (info->isUnbound.load(std::memory_order_acquire))
+				{
+					continue;
+				}
+
+				if (!info->delegate.IsBound())
+				{
+					foundInvalid = true;
+					continue;
+				}
+
+				info->delegate.ExecuteIfBound(arguments...);
+			}
+		}
+	}
+
+	if (foundInvalid)
+	{
+		RemoveInvalidDelegates();
+	}
+	else if (m_snapshot.HasRetiredData())
+	{
+		TryReclaimSnapshots();
+	}
+}
+
+template<typename TReturnType, typename... TArgs>
+void MulticastDelegateBase<true, TReturnType(TArgs...)>::ResetAndBroadcast(TArgs... arguments)
+{
+	{
+		// Read scope is entered before snapshot is unpublished, so it won't be destroyed until end of the scope
+		const auto readScope = m_snapshot.Read();
+
+		const DelegatesSnapshot* snapshot = nullptr;
+
+		{
+			const lib::LockGuard lockGuard(m_writeLock);
+
+			snapshot = m_snapshot.GetCurrent();
+
+			if (snapshot)
+			{
+				m_snapshot.Publish(nullptr);
+			}
+		}
+
+		if (snapshot)
+		{
+			for (const lib::SharedPtr<SharedDelegateInfo>& info : snapshot->delegates)
+			{
+				if (!info->isUnbound.exchange(true, std::memory_order_acq_rel))
+				{
+					info->delegate.ExecuteIfBound(arguments...);
+				}
+			}
+		}
+	}
+
+	TryReclaimSnapshots();
+}
+
+template<typename TReturnType, typename... TArgs>
+lib::DynamicArray<priv::DelegateInfo<typename MulticastDelegateBase<true, TReturnType(TArgs...)>::Delegate>> MulticastDelegateBase<true, TReturnType(TArgs...)>::ExtractDelegates()
+{
+	const lib::LockGuard lockGuard(m_writeLock);
+
+	lib::DynamicArray<DelegateInfo> delegates;
+
+	if (const DelegatesSnapshot* currentSnapshot = m_snapshot.GetCurrent())
+	{
+		delegates.reserve(currentSnapshot->delegates.size());
+
+		for (const lib::SharedPtr<SharedDelegateInfo>& info : currentSnapshot->delegates)
+		{
+			delegates.emplace_back(DelegateInfo(info->handle)).delegate = std::move(info->delegate);
+			info->isUnbound.store(true, std::memory_order_release);
+		}
+
+		PublishSnapshot(nullptr);
+	}
+
+	return delegates;
+}
+
+template<typename TReturnType, typename... TArgs>
+lib::UniquePtr<typename MulticastDelegateBase<true, TReturnType(TArgs...)>::DelegatesSnapshot> MulticastDelegateBase<true, TReturnType(TArgs...)>::CopySnapshot() const
+{
+	lib::UniquePtr<DelegatesSnapshot> newSnapshot = std::make_unique<DelegatesSnapshot>();
+
+	if (const DelegatesSnapshot* currentSnapshot = m_snapshot.GetCurrent())
+	{
+		newSnapshot->delegates = currentSnapshot->delegates;
+	}
+
+	return newSnapshot;
+}
+
+template<typename TReturnType, typename... TArgs>
+void MulticastDelegateBase<true, TReturnType(TArgs...)>::PublishSnapshot(lib::UniquePtr<DelegatesSnapshot> snapshot)
+{
+	m_snapshot.Publish(std::move(snapshot));
+	m_snapshot.TryReclaim();
+}
+
+template<typename TReturnType, typename... TArgs>
+void MulticastDelegateBase<true, TReturnType(TArgs...)>::RemoveInvalidDelegates()
+{
+	const lib::LockGuard lockGuard(m_writeLock);
+
+	lib::UniquePtr<DelegatesSnapshot> newSnapshot = CopySnapshot();
+
+	const SizeType removedNum = std::erase_if(newSnapshot->delegates,
+											  [](const lib::SharedPtr<SharedDelegateInfo>& info)
+											  {
+												  return !info->delegate.IsBound();
+											  });
+
+	if (removedNum > 0u)
+	{
+		PublishSnapshot(std::move(newSnapshot));
+	}
+	else
+	{
+		m_snapshot.TryReclaim();
+	}
+}
+
+template<typename TReturnType, typename... TArgs>
+void MulticastDelegateBase<true, TReturnType(TArgs...)>::TryReclaimSnapshots()
+{
+	// Broadcasts don't wait for writers - if other thread modifies delegate, it will reclaim snapshots
+	const std::unique_lock<lib::RecursiveLock> lock(m_writeLock, std::try_to_lock);
+	if (lock.owns_lock())
+	{
+		m_snapshot.TryReclaim();
+	}
+}
+
 template<typename... TArgs>
 using MulticastDelegate = MulticastDelegateBase<false, TArgs...>;
 
@@ -1,8 +1,17 @@
 #include "DirectoryWatcher.h"
 #include "Utility/String/StringUtils.h"
 
+#include <chrono>
+#include <thread>
+
 #ifdef SPT_PLATFORM_WINDOWS
 #include <Windows.h>
+#elif defined(SPT_PLATFORM_LINUX)
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#include <unistd.h>
+#include <cerrno>
 #endif // SPT_PLATFORM_WINDOWS
 
 
@@ -11,65 +20,255 @@ namespace spt::lib
 
 namespace priv
 {
-#ifdef SPT_PLATFORM_WINDOWS
 
-struct FileWatcherContext
+using CoalescingClock = std::chrono::steady_clock;
+
+
+/** Files modified shortly before notifications were lost are also reported, because their modification time may be older than last sync time */
+static constexpr std::chrono::seconds overflowRescanSlack = std::chrono::seconds(1);
+
+
+/**
+ * Merges notifications about the same file.
+ * Editors often save files in multiple steps (truncate, write, rename), so single save can trigger many notifications.
+ * File is reported after no notification about it was received during coalescing window.
+ */
+class FileEventsCoalescer
+{
+public:
+
+	FileEventsCoalescer(const FileModifiedCallback& callback, Uint32 coalescingWindowMs)
+		: m_callback(callback)
+		, m_coalescingWindow(std::chrono::milliseconds(coalescingWindowMs))
+	{ }
+
+	void AddEvent(const lib::Path& relativePath)
+	{
+		if (m_coalescingWindow == CoalescingClock::duration::zero())
+		{
+			ReportModification(relativePath);
+			return;
+		}
+
+		const CoalescingClock::time_point now = CoalescingClock::now();
+
+		const auto pendingEvent = std::find_if(std::begin(m_pendingEvents), std::end(m_pendingEvents),
+											   [&relativePath](const PendingEvent& event)
+											   {
+												   return event.relativePath == relativePath;
+											   });
+
+		if (pendingEvent != std::end(m_pendingEvents))
+		{
+			pendingEvent->lastEventTime = now;
+		}
+		else
+		{
+			m_pendingEvents.emplace_back(PendingEvent{ relativePath, now });
+		}
+	}
+
+	/** Reports files that weren't modified during last coalescing window */
+	void FlushReady()
+	{
+		const CoalescingClock::time_point now = CoalescingClock::now();
+
+		lib::DynamicArray<lib::Path> readyFiles;
+
+		std::erase_if(m_pendingEvents,
+					  [&](PendingEvent& event)
+					  {
+						  const Bool isReady = now - event.lastEventTime >= m_coalescingWindow;
+						  if (isReady)
+						  {
+							  readyFiles.emplace_back(std::move(event.relativePath));
+						  }
+						  return isReady;
+					  });
+
+		for (const lib::Path& relativePath : readyFiles)
+		{
+			ReportModification(relativePath);
+		}
+	}
+
+	/** Returns time until next pending file should be reported, or idxNone<Uint32> if there are no pending files */
+	Uint32 GetTimeToNextFlushMs() const
+	{
+		if (m_pendingEvents.empty())
+		{
+			return idxNone<Uint32>;
+		}
+
+		CoalescingClock::time_point oldestEventTime = m_pendingEvents[0].lastEventTime;
+		for (const PendingEvent& event : m_pendingEvents)
+		{
+			oldestEventTime = std::min(oldestEventTime, event.lastEventTime);
+		}
+
+		const CoalescingClock::duration timeToFlush = oldestEventTime + m_coalescingWindow - CoalescingClock::now();
+
+		// Round up, so waiting doesn't finish just before file is ready
+		const Int64 timeToFlushMs = std::chrono::ceil<std::chrono::milliseconds>(timeToFlush).count();
+		return static_cast<Uint32>(std::max<Int64>(timeToFlushMs, 0));
+	}
+
+private:
+
+	void ReportModification(const lib::Path& relativePath) const
+	{
+		FileModifiedPayload payload;
+		payload.relativePath = relativePath;
+		payload.fileName     = relativePath.filename().string();
+		m_callback.ExecuteIfBound(payload);
+	}
+
+	struct PendingEvent
+	{
+		lib::Path                   relativePath;
+		CoalescingClock::time_point lastEventTime;
+	};
+
+	const FileModifiedCallback& m_callback;
+
+	const CoalescingClock::duration m_coalescingWindow;
+
+	lib::DynamicArray<PendingEvent> m_pendingEvents;
+};
+
+
+struct FileWatcherContextBase
 {
 	FileModifiedCallback callback;
-	HANDLE               stopEvent = INVALID_HANDLE_VALUE;
+	lib::Path            directory;
+	Bool                 watchSubdirectories = false;
+	Uint32               coalescingWindowMs  = 0u;
 	std::thread          thread;
 };
 
 
-void WatcherThreadProc(FileWatcherContext* context, HANDLE hDir, Bool watchSubdirectories)
+/** Used to recover after notifications were lost. Reports all files in relativeDirectory that were modified after given time */
+static void ReportFilesModifiedSince(const FileWatcherContextBase& context, const lib::Path& relativeDirectory, std::filesystem::file_time_type sinceTime, FileEventsCoalescer& coalescer)
 {
-	alignas(FILE_NOTIFY_INFORMATION) Byte buffer[1024];
+	std::error_code errorCode;
 
-	OVERLAPPED overlapped{};
-	overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	const auto reportFileIfModified = [&](const std::filesystem::directory_entry& entry)
+	{
+		if (entry.is_regular_file(errorCode) && entry.last_write_time(errorCode) >= sinceTime)
+		{
+			coalescer.AddEvent(std::filesystem::relative(entry.path(), context.directory, errorCode));
+		}
+	};
 
-	HANDLE handles[] = { overlapped.hEvent, context->stopEvent };
+	const lib::Path directory = context.directory / relativeDirectory;
 
-	while (true)
+	if (context.watchSubdirectories)
 	{
-		if (!ReadDirectoryChangesW(hDir, buffer, sizeof(buffer), watchSubdirectories, FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &overlapped, NULL))
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, errorCode))
 		{
-			break;
+			reportFileIfModified(entry);
 		}
+	}
+	else
+	{
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory, errorCode))
+		{
+			reportFileIfModified(entry);
+		}
+	}
+}
+
+#ifdef SPT_PLATFORM_WINDOWS
+
+struct FileWatcherContext : public FileWatcherContextBase
+{
+	HANDLE     directoryHandle = INVALID_HANDLE_VALUE;
+	HANDLE     stopEvent       = INVALID_HANDLE_VALUE;
+	OVERLAPPED overlapped{};
+
+	// Large buffer, so notifications aren't lost when many files are modified at once (64 KB is limit for network drives)
+	alignas(DWORD) Byte buffer[64 * 1024];
+};
+
+
+static Bool ReadDirectoryChanges(FileWatcherContext& context)
+{
+	return ReadDirectoryChangesW(context.directoryHandle, context.buffer, sizeof(context.buffer), context.watchSubdirectories, FILE_NOTIFY_CHANGE_LAST_WRITE, NULL, &context.overlapped, NULL);
+}
+
+
+void WatcherThreadProc(FileWatcherContext* context)
+{
+	FileEventsCoalescer coalescer(context->callback, context->coalescingWindowMs);
+
+	std::filesystem::file_time_type lastSyncTime = std::filesystem::file_time_type::clock::now();
+
+	HANDLE handles[] = { context->overlapped.hEvent, context->stopEvent };
+
+	while (true)
+	{
+		const Uint32 timeToFlushMs = coalescer.GetTimeToNextFlushMs();
 
-		DWORD waitResult = WaitForMultipleObjects(2, handles, FALSE, INFINITE);
+		const DWORD waitResult = WaitForMultipleObjects(2, handles, FALSE, timeToFlushMs != idxNone<Uint32> ? timeToFlushMs : INFINITE);
 		if (waitResult == WAIT_OBJECT_0 + 1) // context->stopEvent
 		{
-			CancelIo(hDir);
+			CancelIoEx(context->directoryHandle, &context->overlapped);
 			break;
 		}
 
 		if (waitResult == WAIT_OBJECT_0) // overlapped.hEvent
 		{
+			const std::filesystem::file_time_type syncTime = std::filesystem::file_time_type::clock::now();
+
 			DWORD bytesReturned = 0;
-			if (GetOverlappedResult(hDir, &overlapped, &bytesReturned, FALSE) && bytesReturned > 0)
+			const Bool succeeded = GetOverlappedResult(context->directoryHandle, &context->overlapped, &bytesReturned, FALSE);
+			const Bool overflowed = succeeded ? bytesReturned == 0 : GetLastError() == ERROR_NOTIFY_ENUM_DIR;
+
+			if (!succeeded && !overflowed)
+			{
+				break;
+			}
+
+			if (overflowed)
+			{
+				// Notifications didn't fit in the buffer and were lost
+				ReportFilesModifiedSince(*context, lib::Path(), lastSyncTime - overflowRescanSlack, coalescer);
+			}
+			else
 			{
-				FILE_NOTIFY_INFORMATION* notify = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(buffer);
+				std::error_code errorCode;
+
+				const FILE_NOTIFY_INFORMATION* notify = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(context->buffer);
 				while (notify)
 				{
-					const lib::String relativePath = lib::StringUtils::ToMultibyteString({ notify->FileName, notify->FileNameLength / sizeof(WCHAR) });
+					const lib::Path relativePath = lib::StringUtils::ToMultibyteString({ notify->FileName, notify->FileNameLength / sizeof(WCHAR) });
 
-					FileModifiedPayload payload;
-					payload.relativePath = lib::Path(relativePath);
-					payload.fileName     = lib::Path(relativePath).filename().string();
-					context->callback.ExecuteIfBound(payload);
+					// Last write time of directory changes when its content is modified, so directories are reported together with files inside them
+					if (!std::filesystem::is_directory(context->directory / relativePath, errorCode))
+					{
+						coalescer.AddEvent(relativePath);
+					}
 
 					if (notify->NextEntryOffset == 0)
 					{
 						break;
 					}
 
-					notify = reinterpret_cast<FILE_NOTIFY_INFORMATION*>(reinterpret_cast<Byte*>(notify) + notify->NextEntryOffset);
+					notify = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(reinterpret_cast<const Byte*>(notify) + notify->NextEntryOffset);
 				}
 			}
 
-			ResetEvent(overlapped.hEvent);
+			lastSyncTime = syncTime;
+
+			ResetEvent(context->overlapped.hEvent);
+
+			if (!ReadDirectoryChanges(*context))
+			{
+				break;
+			}
 		}
+
+		coalescer.FlushReady();
 	}
 }
 
@@ -91,10 +290,25 @@ FileWatcherHandle StartWatchingDirectoryImpl(WatchParams params)
 	}
 
 	FileWatcherContext* context = new FileWatcherContext();
-	context->callback  = std::move(params.callback);
-	context->stopEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+	context->callback            = std::move(params.callback);
+	context->directory           = std::move(params.directory);
+	context->watchSubdirectories = params.watchSubdirectories;
+	context->coalescingWindowMs  = params.coalescingWindowMs;
+	context->directoryHandle     = hDir;
+	context->stopEvent           = CreateEvent(NULL, TRUE, FALSE, NULL);
+	context->overlapped.hEvent   = CreateEvent(NULL, TRUE, FALSE, NULL);
+
+	// First read is issued before returning, so modifications done right after this call are not missed
+	if (!ReadDirectoryChanges(*context))
+	{
+		CloseHandle(context->overlapped.hEvent);
+		CloseHandle(context->stopEvent);
+		CloseHandle(hDir);
+		delete context;
+		return 0u;
+	}
 
-	context->thread = std::thread(WatcherThreadProc, context, hDir, params.watchSubdirectories);
+	context->thread = std::thread(WatcherThreadProc, context);
 
 	return reinterpret_cast<FileWatcherHandle>(context);
 }
@@ -110,7 +324,212 @@ void StopWatchingDirectoryImpl(FileWatcherHandle handle)
 		{
 			context->thread.join();
 		}
+		CloseHandle(context->overlapped.hEvent);
 		CloseHandle(context->stopEvent);
+		CloseHandle(context->directoryHandle);
+		delete context;
+	}
+}
+
+#elif defined(SPT_PLATFORM_LINUX)
+
+static constexpr Uint32 inotifyWatchMask = IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+
+struct FileWatcherContext : public FileWatcherContextBase
+{
+	int inotifyFd   = -1;
+	int stopEventFd = -1;
+
+	/** Watch descriptor to watched directory (relative to watched root) */
+	lib::HashMap<int, lib::Path> watchedDirectories;
+};
+
+
+/** inotify isn't recursive, so each subdirectory needs its own watch */
+static void AddDirectoryWatches(FileWatcherContext& context, const lib::Path& relativeDirectory)
+{
+	const int watchDescriptor = inotify_add_watch(context.inotifyFd, (context.directory / relativeDirectory).c_str(), inotifyWatchMask | IN_ONLYDIR);
+	if (watchDescriptor < 0)
+	{
+		return;
+	}
+
+	context.watchedDirectories[watchDescriptor] = relativeDirectory;
+
+	if (context.watchSubdirectories)
+	{
+		std::error_code errorCode;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(context.directory / relativeDirectory, errorCode))
+		{
+			if (entry.is_directory(errorCode) && !entry.is_symlink(errorCode))
+			{
+				AddDirectoryWatches(context, relativeDirectory / entry.path().filename());
+			}
+		}
+	}
+}
+
+
+/** Returns false if events were lost */
+static Bool ProcessEvents(FileWatcherContext& context, const Byte* buffer, SizeType size, FileEventsCoalescer& coalescer)
+{
+	Bool overflowed = false;
+
+	SizeType offset = 0u;
+	while (offset < size)
+	{
+		const inotify_event* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+		offset += sizeof(inotify_event) + event->len;
+
+		if (event->mask & IN_Q_OVERFLOW)
+		{
+			overflowed = true;
+			continue;
+		}
+
+		if (event->mask & IN_IGNORED)
+		{
+			// Directory was removed (or moved out of watched tree)
+			context.watchedDirectories.erase(event->wd);
+			continue;
+		}
+
+		const auto watchedDirectory = context.watchedDirectories.find(event->wd);
+		if (watchedDirectory == std::cend(context.watchedDirectories) || event->len == 0u)
+		{
+			continue;
+		}
+
+		const lib::Path relativePath = watchedDirectory->second / event->name;
+
+		if (event->mask & IN_ISDIR)
+		{
+			if (context.watchSubdirectories && (event->mask & (IN_CREATE | IN_MOVED_TO)))
+			{
+				AddDirectoryWatches(context, relativePath);
+
+				// Files could be written before watch was added
+				ReportFilesModifiedSince(context, relativePath, std::filesystem::file_time_type::min(), coalescer);
+			}
+		}
+		else if (event->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_TO))
+		{
+			coalescer.AddEvent(relativePath);
+		}
+	}
+
+	return !overflowed;
+}
+
+
+void WatcherThreadProc(FileWatcherContext* context)
+{
+	FileEventsCoalescer coalescer(context->callback, context->coalescingWindowMs);
+
+	std::filesystem::file_time_type lastSyncTime = std::filesystem::file_time_type::clock::now();
+
+	alignas(inotify_event) Byte buffer[64 * 1024];
+
+	pollfd pollFds[2]{};
+	pollFds[0].fd     = context->inotifyFd;
+	pollFds[0].events = POLLIN;
+	pollFds[1].fd     = context->stopEventFd;
+	pollFds[1].events = POLLIN;
+
+	while (true)
+	{
+		const Uint32 timeToFlushMs = coalescer.GetTimeToNextFlushMs();
+
+		const int pollResult = poll(pollFds, 2, timeToFlushMs != idxNone<Uint32> ? static_cast<int>(timeToFlushMs) : -1);
+		if (pollResult < 0 && errno != EINTR)
+		{
+			break;
+		}
+
+		if (pollFds[1].revents & POLLIN) // stop event
+		{
+			break;
+		}
+
+		if (pollFds[0].revents & POLLIN)
+		{
+			const std::filesystem::file_time_type syncTime = std::filesystem::file_time_type::clock::now();
+
+			Bool overflowed = false;
+
+			ssize_t bytesRead = 0;
+			while ((bytesRead = read(context->inotifyFd, buffer, sizeof(buffer))) > 0)
+			{
+				overflowed |= !ProcessEvents(*context, buffer, static_cast<SizeType>(bytesRead), coalescer);
+			}
+
+			if (overflowed)
+			{
+				// Kernel queue overflowed and events were lost. Directories created in the meantime may also be not watched
+				AddDirectoryWatches(*context, lib::Path());
+				ReportFilesModifiedSince(*context, lib::Path(), lastSyncTime - overflowRescanSlack, coalescer);
+			}
+
+			lastSyncTime = syncTime;
+		}
+
+		coalescer.FlushReady();
+	}
+}
+
+
+FileWatcherHandle StartWatchingDirectoryImpl(WatchParams params)
+{
+	const int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0)
+	{
+		return 0u;
+	}
+
+	FileWatcherContext* context = new FileWatcherContext();
+	context->callback            = std::move(params.callback);
+	context->directory           = std::move(params.directory);
+	context->watchSubdirectories = params.watchSubdirectories;
+	context->coalescingWindowMs  = params.coalescingWindowMs;
+	context->inotifyFd           = inotifyFd;
+	context->stopEventFd         = eventfd(0, EFD_CLOEXEC);
+
+	// Watches are added before returning, so modifications done right after this call are not missed
+	AddDirectoryWatches(*context, lib::Path());
+
+	if (context->watchedDirectories.empty() || context->stopEventFd < 0)
+	{
+		if (context->stopEventFd >= 0)
+		{
+			close(context->stopEventFd);
+		}
+		close(inotifyFd);
+		delete context;
+		return 0u;
+	}
+
+	context->thread = std::thread(WatcherThreadProc, context);
+
+	return reinterpret_cast<FileWatcherHandle>(context);
+}
+
+
+void StopWatchingDirectoryImpl(FileWatcherHandle handle)
+{
+	FileWatcherContext* context = reinterpret_cast<FileWatcherContext*>(handle);
+	if (context)
+	{
+		const Uint64 stopValue = 1u;
+		SPT_MAYBE_UNUSED
+		const ssize_t written = write(context->stopEventFd, &stopValue, sizeof(stopValue));
+
+		if (context->thread.joinable())
+		{
+			context->thread.join();
+		}
+		close(context->stopEventFd);
+		close(context->inotifyFd);
 		delete context;
 	}
 }
@@ -23,6 +23,9 @@ struct WatchParams
 	lib::Path            directory;
 	FileModifiedCallback callback;
 	Bool                 watchSubdirectories = false;
+
+	/** Modifications of the same file are reported once, after file wasn't modified for this time. 0 reports every notification */
+	Uint32               coalescingWindowMs = 100u;
 };
 
 
@@ -55,7 +55,7 @@ std::ofstream File::OpenOutputStream(const Path& path, EFileOpenFlags openFlags
 	if (!outputStream.is_open() && HasAnyFlag(openFlags, EFileOpenFlags::ForceCreate))
 	{
 		std::filesystem::create_directories(path.parent_path());
-		outputStream.open(path);
+		outputStream.open(path, priv::GetOpenMode(openFlags));
 	}
 
 	SPT_CHECK(!HasAnyFlag(openFlags, EFileOpenFlags::ForceCreate) || !outputStream.bad());
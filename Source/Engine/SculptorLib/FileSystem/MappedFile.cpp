@@ -0,0 +1,151 @@
+#include "MappedFile.h"
+
+#ifdef SPT_PLATFORM_WINDOWS
+#include <Windows.h>
+#elif defined(SPT_PLATFORM_LINUX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // SPT_PLATFORM_WINDOWS
+
+
+namespace spt::lib
+{
+
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+MappedFile::MappedFile(MappedFile&& rhs)
+	: m_data(std::exchange(rhs.m_data, nullptr))
+	, m_size(std::exchange(rhs.m_size, 0u))
+	, m_mappingHandle(std::exchange(rhs.m_mappingHandle, nullptr))
+{ }
+
+MappedFile& MappedFile::operator=(MappedFile&& rhs)
+{
+	if (this != &rhs)
+	{
+		Close();
+
+		m_data          = std::exchange(rhs.m_data, nullptr);
+		m_size          = std::exchange(rhs.m_size, 0u);
+		m_mappingHandle = std::exchange(rhs.m_mappingHandle, nullptr);
+	}
+
+	return *this;
+}
+
+#ifdef SPT_PLATFORM_WINDOWS
+
+Bool MappedFile::Open(const Path& path)
+{
+	SPT_PROFILER_FUNCTION();
+
+	Close();
+
+	const HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	const HANDLE hMapping = CreateFileMappingW(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+
+	// Mapping keeps reference to the file, so file handle is not needed anymore
+	CloseHandle(hFile);
+
+	if (hMapping == NULL)
+	{
+		return false;
+	}
+
+	const void* data = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		CloseHandle(hMapping);
+		return false;
+	}
+
+	m_data          = static_cast<const Byte*>(data);
+	m_size          = static_cast<SizeType>(fileSize.QuadPart);
+	m_mappingHandle = hMapping;
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data)
+	{
+		UnmapViewOfFile(m_data);
+		CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+
+		m_data          = nullptr;
+		m_size          = 0u;
+		m_mappingHandle = nullptr;
+	}
+}
+
+#elif defined(SPT_PLATFORM_LINUX)
+
+Bool MappedFile::Open(const Path& path)
+{
+	SPT_PROFILER_FUNCTION();
+
+	Close();
+
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat = {};
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// Mapping keeps reference to the file, so descriptor is not needed anymore
+	close(fd);
+
+	if (data == MAP_FAILED)
+	{
+		return false;
+	}
+
+	madvise(data, static_cast<size_t>(fileStat.st_size), MADV_SEQUENTIAL);
+
+	m_data = static_cast<const Byte*>(data);
+	m_size = static_cast<SizeType>(fileStat.st_size);
+
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_data)
+	{
+		munmap(const_cast<Byte*>(m_data), m_size);
+
+		m_data = nullptr;
+		m_size = 0u;
+	}
+}
+
+#endif // SPT_PLATFORM_WINDOWS
+
+} // spt::lib
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "SculptorCoreTypes.h"
+#include "FileSystem/File.h"
+
+
+namespace spt::lib
+{
+
+/**
+ * Read-only view of whole file mapped to memory.
+ * Pages are loaded by the OS on first access, so only parts of the file that are actually read are loaded from disk.
+ */
+class SCULPTOR_LIB_API MappedFile
+{
+public:
+
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile& rhs) = delete;
+	MappedFile& operator=(const MappedFile& rhs) = delete;
+
+	MappedFile(MappedFile&& rhs);
+	MappedFile& operator=(MappedFile&& rhs);
+
+	/** Returns false if file doesn't exist, is empty or cannot be mapped */
+	Bool Open(const Path& path);
+	void Close();
+
+	Bool IsValid() const { return m_data != nullptr; }
+
+	Span<const Byte> GetData() const { return Span<const Byte>(m_data, m_size); }
+	SizeType         GetSize() const { return m_size; }
+
+private:
+
+	const Byte* m_data = nullptr;
+	SizeType    m_size = 0u;
+
+	/** Platform specific handle of the mapping */
+	void* m_mappingHandle = nullptr;
+};
+
+} // spt::lib
@@ -2,10 +2,7 @@
 
 #if WITH_LOGGER
 
-#include "spdlog/logger.h"
-#include "spdlog/sinks/stdout_color_sinks.h"
-#include "spdlog/spdlog.h"
-#include "memory.h"
+#include "Logger.h"
 
 #endif
 
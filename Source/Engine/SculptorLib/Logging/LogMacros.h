@@ -4,6 +4,12 @@
 
 
 #if WITH_LOGGER
+
+// Messages below this level are removed at compile time
+#ifndef SPT_LOG_COMPILE_TIME_MIN_LEVEL
+#define SPT_LOG_COMPILE_TIME_MIN_LEVEL spt::lib::ELogLevel::Trace
+#endif // SPT_LOG_COMPILE_TIME_MIN_LEVEL
+
 #define SPT_DEFINE_LOG_CATEGORY(Category, Enabled)							\
 class LogCategory_##Category##												\
 {																			\
@@ -13,15 +19,26 @@ public:																		\
 																			\
 	spt::Bool IsEnabled() const { return m_enabled; }						\
 																			\
-	std::shared_ptr<spdlog::logger> m_logger;								\
+	spt::Bool ShouldLog(spt::lib::ELogLevel level) const					\
+	{																		\
+		return m_enabled && level >= m_minLevel.load(std::memory_order_relaxed); \
+	}																		\
+																			\
+	void SetMinLevel(spt::lib::ELogLevel level)								\
+	{																		\
+		m_minLevel.store(level, std::memory_order_relaxed);					\
+	}																		\
+																			\
+	const char* GetName() const { return #Category; }						\
+																			\
+	std::atomic<spt::lib::ELogLevel> m_minLevel;							\
 	spt::Bool m_enabled;													\
 																			\
 private:																	\
 																			\
 	LogCategory_##Category##()												\
-		: m_logger(spdlog::stdout_color_mt(#Category))						\
+		: m_minLevel(spt::lib::ELogLevel::Trace)							\
 	{																		\
-		m_logger->set_level(spdlog::level::trace);							\
 		m_enabled = Enabled;												\
 	}																		\
 };																			\
@@ -35,13 +52,23 @@ inline LogCategory_##Category##& LogCategory_##Category##::Get()			\
 
 #define SPT_IS_LOG_CATEGORY_ENABLED(Category) (SPT_GET_LOGGER(Category).IsEnabled())
 
-#define SPT_LOG_IMPL(Category, Type, ...)	if(SPT_IS_LOG_CATEGORY_ENABLED(Category)) { SPT_GET_LOGGER(Category).m_logger->Type(__VA_ARGS__); }
+#define SPT_SET_LOG_CATEGORY_MIN_LEVEL(Category, Level) SPT_GET_LOGGER(Category).SetMinLevel(Level)
 
-#define SPT_LOG_TRACE(Category, ...)		SPT_LOG_IMPL(Category, trace, __VA_ARGS__)
-#define SPT_LOG_INFO(Category, ...)			SPT_LOG_IMPL(Category, info, __VA_ARGS__)
-#define SPT_LOG_WARN(Category, ...)			SPT_LOG_IMPL(Category, warn, __VA_ARGS__)
-#define SPT_LOG_ERROR(Category, ...)		SPT_LOG_IMPL(Category, error, __VA_ARGS__)
-#define SPT_LOG_FATAL(Category, ...)		SPT_LOG_IMPL(Category, critical, __VA_ARGS__)
+// Level is checked before arguments are copied, so filtered messages cost only one comparison
+#define SPT_LOG_IMPL(Category, Level, ...)																			\
+	if constexpr (Level >= SPT_LOG_COMPILE_TIME_MIN_LEVEL)															\
+	{																												\
+		if (SPT_GET_LOGGER(Category).ShouldLog(Level))																\
+		{																											\
+			spt::lib::Logger::GetDefault().Log(SPT_GET_LOGGER(Category).GetName(), Level, __VA_ARGS__);			\
+		}																											\
+	}
+
+#define SPT_LOG_TRACE(Category, ...)		SPT_LOG_IMPL(Category, spt::lib::ELogLevel::Trace, __VA_ARGS__)
+#define SPT_LOG_INFO(Category, ...)			SPT_LOG_IMPL(Category, spt::lib::ELogLevel::Info, __VA_ARGS__)
+#define SPT_LOG_WARN(Category, ...)			SPT_LOG_IMPL(Category, spt::lib::ELogLevel::Warn, __VA_ARGS__)
+#define SPT_LOG_ERROR(Category, ...)		SPT_LOG_IMPL(Category, spt::lib::ELogLevel::Error, __VA_ARGS__)
+#define SPT_LOG_FATAL(Category, ...)		SPT_LOG_IMPL(Category, spt::lib::ELogLevel::Fatal, __VA_ARGS__)
 
 #else // WITH_LOGGER
 
@@ -49,10 +76,12 @@ inline LogCategory_##Category##& LogCategory_##Category##::Get()			\
 
 #define SPT_IS_LOG_CATEGORY_ENABLED(Category) false
 
+#define SPT_SET_LOG_CATEGORY_MIN_LEVEL(Category, Level)
+
 #define SPT_LOG_TRACE(Category, ...)
 #define SPT_LOG_INFO(Category, ...)
 #define SPT_LOG_WARN(Category, ...)
 #define SPT_LOG_ERROR(Category, ...)
 #define SPT_LOG_FATAL(Category, ...)
 
-#endif // WITH_LOGGER
\ No newline at end of file
+#endif // WITH_LOGGER
@@ -0,0 +1,73 @@
+#include "LogSinks.h"
+
+#include "spdlog/details/log_msg.h"
+#include "spdlog/sinks/basic_file_sink.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+#include <chrono>
+
+
+namespace spt::lib
+{
+
+namespace priv
+{
+
+static spdlog::level::level_enum ToSpdlogLevel(ELogLevel level)
+{
+	switch (level)
+	{
+	case ELogLevel::Trace: return spdlog::level::trace;
+	case ELogLevel::Info:  return spdlog::level::info;
+	case ELogLevel::Warn:  return spdlog::level::warn;
+	case ELogLevel::Error: return spdlog::level::err;
+	case ELogLevel::Fatal: return spdlog::level::critical;
+	default:               return spdlog::level::off;
+	}
+}
+
+
+/** Spdlog sinks are used only for writing already formatted messages. Multithreaded sinks are not needed, as logger writes to sinks from one thread at a time */
+class SpdlogLogSink : public LogSink
+{
+public:
+
+	explicit SpdlogLogSink(std::shared_ptr<spdlog::sinks::sink> sink)
+		: m_sink(std::move(sink))
+	{
+		m_sink->set_level(spdlog::level::trace);
+	}
+
+	virtual void Write(const LogMessage& message) override
+	{
+		const auto time = spdlog::log_clock::time_point(std::chrono::duration_cast<spdlog::log_clock::duration>(std::chrono::nanoseconds(message.timestampNs)));
+
+		spdlog::details::log_msg spdlogMessage(time, spdlog::source_loc{}, message.category, ToSpdlogLevel(message.level), spdlog::string_view_t(message.text.data(), message.text.size()));
+		spdlogMessage.thread_id = static_cast<SizeType>(message.threadID);
+
+		m_sink->log(spdlogMessage);
+	}
+
+	virtual void Flush() override
+	{
+		m_sink->flush();
+	}
+
+private:
+
+	std::shared_ptr<spdlog::sinks::sink> m_sink;
+};
+
+} // priv
+
+std::shared_ptr<LogSink> CreateConsoleLogSink()
+{
+	return std::make_shared<priv::SpdlogLogSink>(std::make_shared<spdlog::sinks::stdout_color_sink_st>());
+}
+
+std::shared_ptr<LogSink> CreateFileLogSink(const std::string& filePath, Bool truncate /*= true*/)
+{
+	return std::make_shared<priv::SpdlogLogSink>(std::make_shared<spdlog::sinks::basic_file_sink_st>(filePath, truncate));
+}
+
+} // spt::lib
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "Logger.h"
+
+
+namespace spt::lib
+{
+
+/** Writes colored messages to standard output */
+SCULPTOR_LIB_API std::shared_ptr<LogSink> CreateConsoleLogSink();
+
+SCULPTOR_LIB_API std::shared_ptr<LogSink> CreateFileLogSink(const std::string& filePath, Bool truncate = true);
+
+} // spt::lib
@@ -0,0 +1,315 @@
+#include "Logger.h"
+#include "LogSinks.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+
+
+namespace spt::lib
+{
+
+namespace priv
+{
+
+static constexpr SizeType threadBufferCapacity = 256u * 1024u;
+
+/** Logger thread sleeps at most this long, so messages are written even if nobody wakes it */
+static constexpr std::chrono::milliseconds loggerThreadSleepTime = std::chrono::milliseconds(5);
+
+
+static Uint32 CreateLoggerID()
+{
+	static std::atomic<Uint32> nextID = 0u;
+	return nextID.fetch_add(1u, std::memory_order_relaxed);
+}
+
+
+static Uint64 GetCurrentThreadID()
+{
+	return static_cast<Uint64>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+}
+
+
+/** Buffers created by this thread. Each logger has separate buffer, identified by logger ID (addresses of loggers can be reused) */
+struct ThreadBuffers
+{
+	~ThreadBuffers()
+	{
+		for (const auto& [loggerID, buffer] : buffers)
+		{
+			buffer->MarkOwnerFinished();
+		}
+	}
+
+	std::vector<std::pair<Uint32, std::shared_ptr<log_impl::RecordsBuffer>>> buffers;
+};
+
+thread_local ThreadBuffers tlsThreadBuffers;
+
+
+/** Formats record. If format doesn't match arguments, fallback message is written instead, so that one invalid message doesn't break logging */
+static void FormatRecordMessage(log_impl::ArgsFormatter formatter, const char* format, Byte* args, std::string& outMessage)
+{
+	try
+	{
+		formatter(format, args, outMessage);
+	}
+	catch (const fmt::format_error& error)
+	{
+		outMessage = fmt::format("Failed to format log message \"{}\": {}", format ? format : "", error.what());
+	}
+}
+
+} // priv
+
+const char* GetLogLevelName(ELogLevel level)
+{
+	switch (level)
+	{
+	case ELogLevel::Trace: return "trace";
+	case ELogLevel::Info:  return "info";
+	case ELogLevel::Warn:  return "warning";
+	case ELogLevel::Error: return "error";
+	case ELogLevel::Fatal: return "critical";
+	default:               return "off";
+	}
+}
+
+namespace log_impl
+{
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// RecordsBuffer =================================================================================
+
+RecordsBuffer::RecordsBuffer(SizeType capacity, Uint64 threadID)
+	: m_capacity(capacity)
+	, m_threadID(threadID)
+{
+	// Capacity must be power of 2, as offsets are wrapped using mask
+	if ((capacity & (capacity - 1u)) != 0u)
+	{
+		std::abort();
+	}
+
+	m_data = static_cast<Byte*>(::operator new(capacity, std::align_val_t(recordAlignment)));
+}
+
+RecordsBuffer::~RecordsBuffer()
+{
+	::operator delete(m_data, std::align_val_t(recordAlignment));
+}
+
+} // log_impl
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Logger ========================================================================================
+
+Logger& Logger::GetDefault()
+{
+	static Logger& instance = []() -> Logger&
+	{
+		static Logger logger;
+		logger.AddSink(CreateConsoleLogSink());
+		return logger;
+	}();
+
+	return instance;
+}
+
+Logger::Logger()
+	: m_id(priv::CreateLoggerID())
+{
+	m_thread = std::thread([this] { LoggerThreadMain(); });
+}
+
+Logger::~Logger()
+{
+	m_stopRequested.store(true);
+
+	{
+		const std::lock_guard<std::mutex> lock(m_wakeLock);
+		m_wakeCondition.notify_one();
+	}
+
+	if (m_thread.joinable())
+	{
+		m_thread.join();
+	}
+
+	Flush();
+}
+
+void Logger::AddSink(std::shared_ptr<LogSink> sink)
+{
+	const std::lock_guard<std::mutex> lock(m_sinksLock);
+	m_sinks.emplace_back(std::move(sink));
+}
+
+void Logger::RemoveSink(const std::shared_ptr<LogSink>& sink)
+{
+	const std::lock_guard<std::mutex> lock(m_sinksLock);
+	m_sinks.erase(std::remove(m_sinks.begin(), m_sinks.end(), sink), m_sinks.end());
+}
+
+void Logger::Flush()
+{
+	DrainBuffers();
+
+	const std::lock_guard<std::mutex> lock(m_sinksLock);
+	for (const std::shared_ptr<LogSink>& sink : m_sinks)
+	{
+		sink->Flush();
+	}
+}
+
+log_impl::RecordsBuffer& Logger::GetThreadBuffer()
+{
+	priv::ThreadBuffers& threadBuffers = priv::tlsThreadBuffers;
+
+	for (const auto& [loggerID, buffer] : threadBuffers.buffers)
+	{
+		if (loggerID == m_id)
+		{
+			return *buffer;
+		}
+	}
+
+	std::shared_ptr<log_impl::RecordsBuffer> buffer = std::make_shared<log_impl::RecordsBuffer>(priv::threadBufferCapacity, priv::GetCurrentThreadID());
+
+	{
+		const std::lock_guard<std::mutex> lock(m_buffersLock);
+		m_buffers.emplace_back(buffer);
+	}
+
+	threadBuffers.buffers.emplace_back(m_id, buffer);
+
+	return *buffer;
+}
+
+void Logger::WriteSynchronous(log_impl::ArgsFormatter formatter, const char* category, ELogLevel level, const char* format, Uint64 timestampNs, Byte* args)
+{
+	m_synchronousMessagesNum.fetch_add(1u, std::memory_order_relaxed);
+
+	// Messages that were logged earlier must be written first
+	DrainBuffers();
+
+	std::string message;
+	priv::FormatRecordMessage(formatter, format, args, message);
+
+	const LogMessage logMessage
+	{
+		.category    = category,
+		.level       = level,
+		.timestampNs = timestampNs,
+		.threadID    = priv::GetCurrentThreadID(),
+		.text        = message
+	};
+
+	WriteToSinks(logMessage);
+
+	const std::lock_guard<std::mutex> sinksLock(m_sinksLock);
+	for (const std::shared_ptr<LogSink>& sink : m_sinks)
+	{
+		sink->Flush();
+	}
+}
+
+Bool Logger::WaitForFreeSpace(log_impl::RecordsBuffer& buffer, SizeType size)
+{
+	// Records that are bigger than half of the buffer are written synchronously
+	if (size > buffer.GetCapacity() / 2u)
+	{
+		return false;
+	}
+
+	// Reservation is checked again when record is written. It always succeeds, as only this thread writes to the buffer
+	while (!buffer.TryReserve(size))
+	{
+		if (m_stopRequested.load(std::memory_order_relaxed))
+		{
+			return false;
+		}
+
+		m_wakeCondition.notify_one();
+		std::this_thread::yield();
+	}
+
+	return true;
+}
+
+void Logger::LoggerThreadMain()
+{
+	while (!m_stopRequested.load(std::memory_order_acquire))
+	{
+		const SizeType writtenRecordsNum = DrainBuffers();
+
+		if (writtenRecordsNum == 0u)
+		{
+			std::unique_lock<std::mutex> lock(m_wakeLock);
+			m_wakeCondition.wait_for(lock, priv::loggerThreadSleepTime);
+		}
+	}
+}
+
+SizeType Logger::DrainBuffers()
+{
+	const std::lock_guard<std::mutex> drainLock(m_drainLock);
+
+	{
+		const std::lock_guard<std::mutex> buffersLock(m_buffersLock);
+
+		// Buffers of finished threads are released when everything was read from them
+		m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+									   [](const std::shared_ptr<log_impl::RecordsBuffer>& buffer)
+									   {
+										   return !buffer->IsOwnerAlive() && buffer->IsEmpty();
+									   }),
+						m_buffers.end());
+
+		m_drainedBuffers = m_buffers;
+	}
+
+	SizeType writtenRecordsNum = 0u;
+
+	for (const std::shared_ptr<log_impl::RecordsBuffer>& buffer : m_drainedBuffers)
+	{
+		writtenRecordsNum += buffer->Consume([this, &buffer](const log_impl::RecordHeader& header, Byte* args)
+											 {
+												 priv::FormatRecordMessage(header.formatter, header.format, args, m_formattedMessage);
+
+												 const LogMessage message
+												 {
+													 .category    = header.category,
+													 .level       = header.level,
+													 .timestampNs = header.timestampNs,
+													 .threadID    = buffer->GetThreadID(),
+													 .text        = m_formattedMessage
+												 };
+
+												 WriteToSinks(message);
+											 });
+	}
+
+	m_drainedBuffers.clear();
+
+	return writtenRecordsNum;
+}
+
+void Logger::WriteToSinks(const LogMessage& message)
+{
+	const std::lock_guard<std::mutex> lock(m_sinksLock);
+
+	for (const std::shared_ptr<LogSink>& sink : m_sinks)
+	{
+		sink->Write(message);
+	}
+}
+
+Uint64 Logger::GetTimestampNs()
+{
+	return static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+} // spt::lib
@@ -0,0 +1,500 @@
+#pragma once
+
+#include "SculptorLibMacros.h"
+#include "SculptorAliases.h"
+
+#include "spdlog/fmt/fmt.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+
+namespace spt::lib
+{
+
+enum class ELogLevel : Uint8
+{
+	Trace,
+	Info,
+	Warn,
+	Error,
+	Fatal,
+	Off
+};
+
+
+SCULPTOR_LIB_API const char* GetLogLevelName(ELogLevel level);
+
+
+struct LogMessage
+{
+	const char*      category    = nullptr;
+	ELogLevel        level       = ELogLevel::Trace;
+	/** Nanoseconds since system clock epoch */
+	Uint64           timestampNs = 0u;
+	Uint64           threadID    = 0u;
+	std::string_view text;
+};
+
+
+class SCULPTOR_LIB_API LogSink
+{
+public:
+
+	virtual ~LogSink() = default;
+
+	/** Called by one thread at a time */
+	virtual void Write(const LogMessage& message) = 0;
+	virtual void Flush() {}
+};
+
+
+namespace log_impl
+{
+
+using ArgsFormatter = void(*)(const char* format, Byte* args, std::string& outMessage);
+
+
+struct RecordHeader
+{
+	/** Null formatter marks padding at the end of buffer */
+	ArgsFormatter formatter   = nullptr;
+	const char*   format      = nullptr;
+	const char*   category    = nullptr;
+	Uint64        timestampNs = 0u;
+	Uint32        size        = 0u;
+	ELogLevel     level       = ELogLevel::Trace;
+};
+
+
+static constexpr SizeType recordAlignment = alignof(std::max_align_t);
+static constexpr SizeType recordHeaderSize = (sizeof(RecordHeader) + recordAlignment - 1u) & ~(recordAlignment - 1u);
+
+
+constexpr SizeType AlignOffset(SizeType offset, SizeType alignment)
+{
+	return (offset + alignment - 1u) & ~(alignment - 1u);
+}
+
+
+template<typename TType>
+concept CStringLike = std::is_same_v<std::decay_t<TType>, const char*>
+				   || std::is_same_v<std::decay_t<TType>, char*>
+				   || std::is_convertible_v<const TType&, std::string_view>;
+
+
+/** Arguments are stored as copies. Strings are stored as length and characters, so that they don't reference caller's memory */
+template<typename TArg>
+struct ArgCodec
+{
+	using StoredType = std::decay_t<TArg>;
+
+	static SizeType Measure(SizeType offset, const TArg& arg)
+	{
+		return AlignOffset(offset, alignof(StoredType)) + sizeof(StoredType);
+	}
+
+	static void Encode(Byte* args, SizeType& offset, const TArg& arg)
+	{
+		offset = AlignOffset(offset, alignof(StoredType));
+		new (args + offset) StoredType(arg);
+		offset += sizeof(StoredType);
+	}
+
+	static const StoredType& Decode(Byte* args, SizeType& offset)
+	{
+		offset = AlignOffset(offset, alignof(StoredType));
+		const StoredType& value = *std::launder(reinterpret_cast<const StoredType*>(args + offset));
+		offset += sizeof(StoredType);
+		return value;
+	}
+
+	static void Destroy(Byte* args, SizeType& offset)
+	{
+		offset = AlignOffset(offset, alignof(StoredType));
+		if constexpr (!std::is_trivially_destructible_v<StoredType>)
+		{
+			std::launder(reinterpret_cast<StoredType*>(args + offset))->~StoredType();
+		}
+		offset += sizeof(StoredType);
+	}
+};
+
+
+template<CStringLike TArg>
+struct ArgCodec<TArg>
+{
+	static std::string_view ToView(const TArg& arg)
+	{
+		if constexpr (std::is_pointer_v<std::decay_t<TArg>>)
+		{
+			return arg ? std::string_view(arg) : std::string_view();
+		}
+		else
+		{
+			return std::string_view(arg);
+		}
+	}
+
+	static SizeType Measure(SizeType offset, const TArg& arg)
+	{
+		return AlignOffset(offset, alignof(Uint32)) + sizeof(Uint32) + ToView(arg).size();
+	}
+
+	static void Encode(Byte* args, SizeType& offset, const TArg& arg)
+	{
+		const std::string_view view = ToView(arg);
+		const Uint32 length = static_cast<Uint32>(view.size());
+
+		offset = AlignOffset(offset, alignof(Uint32));
+		std::memcpy(args + offset, &length, sizeof(Uint32));
+		std::memcpy(args + offset + sizeof(Uint32), view.data(), length);
+		offset += sizeof(Uint32) + length;
+	}
+
+	static std::string_view Decode(Byte* args, SizeType& offset)
+	{
+		Uint32 length = 0u;
+
+		offset = AlignOffset(offset, alignof(Uint32));
+		std::memcpy(&length, args + offset, sizeof(Uint32));
+		const std::string_view view(reinterpret_cast<const char*>(args + offset + sizeof(Uint32)), length);
+		offset += sizeof(Uint32) + length;
+
+		return view;
+	}
+
+	static void Destroy(Byte* args, SizeType& offset)
+	{
+		Decode(args, offset);
+	}
+};
+
+
+template<typename... TArgs>
+void FormatArgs(const char* format, Byte* args, std::string& outMessage)
+{
+	const auto destroyArgs = [args]()
+	{
+		SizeType offset = 0u;
+		(ArgCodec<TArgs>::Destroy(args, offset), ...);
+	};
+
+	try
+	{
+		SizeType offset = 0u;
+
+		// Elements of braced initializer are evaluated in order, so arguments are decoded in the same order as they were encoded
+		const std::tuple<decltype(ArgCodec<TArgs>::Decode(args, offset))...> decodedArgs{ ArgCodec<TArgs>::Decode(args, offset)... };
+
+		std::apply([format, &outMessage](const auto&... values)
+				   {
+					   outMessage = fmt::vformat(fmt::string_view(format), fmt::make_format_args(values...));
+				   },
+				   decodedArgs);
+	}
+	catch (...)
+	{
+		// Arguments must be destroyed even if formatting failed
+		destroyArgs();
+		throw;
+	}
+
+	destroyArgs();
+}
+
+
+inline void FormatLiteralMessage(const char* format, Byte* args, std::string& outMessage)
+{
+	outMessage.assign(format);
+}
+
+
+inline void FormatStoredMessage(const char* format, Byte* args, std::string& outMessage)
+{
+	SizeType offset = 0u;
+	outMessage.assign(ArgCodec<std::string_view>::Decode(args, offset));
+}
+
+
+/** Single producer (owning thread), single consumer (logger thread) ring of records */
+class RecordsBuffer
+{
+public:
+
+	RecordsBuffer(SizeType capacity, Uint64 threadID);
+	~RecordsBuffer();
+
+	RecordsBuffer(const RecordsBuffer&) = delete;
+	RecordsBuffer& operator=(const RecordsBuffer&) = delete;
+
+	SizeType GetCapacity() const { return m_capacity; }
+	Uint64   GetThreadID() const { return m_threadID; }
+
+	/** Returns nullptr if there's not enough free space. Size must be aligned to record alignment */
+	Byte* TryReserve(SizeType size)
+	{
+		const Uint64 writeOffset = m_writeOffset.load(std::memory_order_relaxed);
+		const Uint64 readOffset  = m_readOffset.load(std::memory_order_acquire);
+
+		const SizeType position   = static_cast<SizeType>(writeOffset & (m_capacity - 1u));
+		const SizeType contiguous = m_capacity - position;
+
+		// Records are never split, so if record doesn't fit before the end of buffer, rest of the buffer is skipped
+		const SizeType padding = size > contiguous ? contiguous : 0u;
+
+		if (writeOffset + padding + size - readOffset > m_capacity)
+		{
+			return nullptr;
+		}
+
+		if (padding > 0u && padding >= recordHeaderSize)
+		{
+			new (m_data + position) RecordHeader{ .formatter = nullptr, .size = static_cast<Uint32>(padding) };
+		}
+
+		m_pendingPadding = padding;
+
+		return m_data + (padding > 0u ? 0u : position);
+	}
+
+	void Commit(SizeType size)
+	{
+		const Uint64 writeOffset = m_writeOffset.load(std::memory_order_relaxed);
+		m_writeOffset.store(writeOffset + m_pendingPadding + size, std::memory_order_release);
+	}
+
+	/** Can be called only by consumer. Returns number of consumed records */
+	template<typename TCallable>
+	SizeType Consume(TCallable&& callable)
+	{
+		Uint64 readOffset = m_readOffset.load(std::memory_order_relaxed);
+		const Uint64 writeOffset = m_writeOffset.load(std::memory_order_acquire);
+
+		SizeType recordsNum = 0u;
+
+		while (readOffset < writeOffset)
+		{
+			const SizeType position   = static_cast<SizeType>(readOffset & (m_capacity - 1u));
+			const SizeType contiguous = m_capacity - position;
+
+			if (contiguous < recordHeaderSize)
+			{
+				readOffset += contiguous;
+				continue;
+			}
+
+			RecordHeader* header = std::launder(reinterpret_cast<RecordHeader*>(m_data + position));
+
+			if (header->formatter)
+			{
+				callable(*header, m_data + position + recordHeaderSize);
+				++recordsNum;
+			}
+
+			readOffset += header->size;
+
+			m_readOffset.store(readOffset, std::memory_order_release);
+		}
+
+		m_readOffset.store(readOffset, std::memory_order_release);
+
+		return recordsNum;
+	}
+
+	Bool IsEmpty() const
+	{
+		return m_readOffset.load(std::memory_order_acquire) == m_writeOffset.load(std::memory_order_acquire);
+	}
+
+	void MarkOwnerFinished()   { m_isOwnerAlive.store(false, std::memory_order_release); }
+	Bool IsOwnerAlive() const { return m_isOwnerAlive.load(std::memory_order_acquire); }
+
+private:
+
+	Byte*    m_data     = nullptr;
+	SizeType m_capacity = 0u;
+	Uint64   m_threadID = 0u;
+
+	/** Used only by producer */
+	SizeType m_pendingPadding = 0u;
+
+	alignas(64) std::atomic<Uint64> m_writeOffset = 0u;
+	alignas(64) std::atomic<Uint64> m_readOffset  = 0u;
+
+	std::atomic<Bool> m_isOwnerAlive = true;
+};
+
+} // log_impl
+
+
+/**
+ * Asynchronous logger.
+ * Calling thread only copies format string pointer and arguments to its own buffer. Formatting and writing to sinks is done by logger thread.
+ * Fatal messages are written synchronously, so that they are visible before application is terminated
+ */
+class SCULPTOR_LIB_API Logger
+{
+public:
+
+	static Logger& GetDefault();
+
+	/** Logger without sinks */
+	Logger();
+	~Logger();
+
+	Logger(const Logger&) = delete;
+	Logger& operator=(const Logger&) = delete;
+
+	void AddSink(std::shared_ptr<LogSink> sink);
+	void RemoveSink(const std::shared_ptr<LogSink>& sink);
+
+	/** Blocks until all messages logged before this call are written to sinks */
+	void Flush();
+
+	/** Logs message without formatting. Message can be any string or formattable value */
+	template<typename TMessage>
+	void Log(const char* category, ELogLevel level, const TMessage& message);
+
+	/** Logs formatted message. Format is checked at compile time and must be string literal, as only pointer to it is stored */
+	template<typename TArg, typename... TArgs>
+	void Log(const char* category, ELogLevel level, fmt::format_string<TArg, TArgs...> format, const TArg& arg, const TArgs&... args);
+
+	/** Number of messages that didn't fit in buffer and were written synchronously */
+	Uint64 GetSynchronousMessagesNum() const { return m_synchronousMessagesNum.load(std::memory_order_relaxed); }
+
+private:
+
+	template<typename... TArgs>
+	void WriteRecord(log_impl::ArgsFormatter formatter, const char* category, ELogLevel level, const char* format, const TArgs&... args);
+
+	log_impl::RecordsBuffer& GetThreadBuffer();
+
+	void WriteSynchronous(log_impl::ArgsFormatter formatter, const char* category, ELogLevel level, const char* format, Uint64 timestampNs, Byte* args);
+
+	/** Waits until buffer has at least requested amount of free space or until it's obvious that it will never have it */
+	Bool WaitForFreeSpace(log_impl::RecordsBuffer& buffer, SizeType size);
+
+	void LoggerThreadMain();
+
+	/** Writes all buffered records to sinks. Returns number of written records */
+	SizeType DrainBuffers();
+
+	void WriteToSinks(const LogMessage& message);
+
+	static Uint64 GetTimestampNs();
+
+	const Uint32 m_id;
+
+	std::mutex                                              m_buffersLock;
+	std::vector<std::shared_ptr<log_impl::RecordsBuffer>> m_buffers;
+
+	/** Only one thread at a time can consume records and write to sinks */
+	std::mutex                                              m_drainLock;
+	std::vector<std::shared_ptr<log_impl::RecordsBuffer>> m_drainedBuffers;
+	std::string                                             m_formattedMessage;
+
+	std::mutex                             m_sinksLock;
+	std::vector<std::shared_ptr<LogSink>> m_sinks;
+
+	std::mutex              m_wakeLock;
+	std::condition_variable m_wakeCondition;
+	std::atomic<Bool>       m_stopRequested = false;
+
+	std::atomic<Uint64> m_synchronousMessagesNum = 0u;
+
+	std::thread m_thread;
+};
+
+
+template<typename TMessage>
+void Logger::Log(const char* category, ELogLevel level, const TMessage& message)
+{
+	if constexpr (std::is_array_v<TMessage>)
+	{
+		WriteRecord(&log_impl::FormatLiteralMessage, category, level, message);
+	}
+	else if constexpr (log_impl::CStringLike<TMessage>)
+	{
+		WriteRecord(&log_impl::FormatStoredMessage, category, level, nullptr, message);
+	}
+	else
+	{
+		WriteRecord(&log_impl::FormatArgs<TMessage>, category, level, "{}", message);
+	}
+}
+
+
+template<typename TArg, typename... TArgs>
+void Logger::Log(const char* category, ELogLevel level, fmt::format_string<TArg, TArgs...> format, const TArg& arg, const TArgs&... args)
+{
+	// Format string is a view of string literal, so it's null terminated and outlives the record
+	WriteRecord(&log_impl::FormatArgs<TArg, TArgs...>, category, level, static_cast<fmt::string_view>(format).data(), arg, args...);
+}
+
+
+template<typename... TArgs>
+void Logger::WriteRecord(log_impl::ArgsFormatter formatter, const char* category, ELogLevel level, const char* format, const TArgs&... args)
+{
+	const Uint64 timestampNs = GetTimestampNs();
+
+	SizeType argsSize = 0u;
+	((argsSize = log_impl::ArgCodec<TArgs>::Measure(argsSize, args)), ...);
+
+	const SizeType recordSize = log_impl::AlignOffset(log_impl::recordHeaderSize + argsSize, log_impl::recordAlignment);
+
+	log_impl::RecordsBuffer& buffer = GetThreadBuffer();
+
+	const Bool isSynchronous = level >= ELogLevel::Fatal || !WaitForFreeSpace(buffer, recordSize);
+
+	if (isSynchronous)
+	{
+		// Message is formatted on calling thread. Arguments are encoded the same way, so that the same formatter can be used
+		alignas(log_impl::recordAlignment) Byte inlineStorage[512];
+		std::unique_ptr<Byte[]> heapStorage;
+
+		Byte* argsData = inlineStorage;
+		if (argsSize > sizeof(inlineStorage))
+		{
+			heapStorage = std::make_unique<Byte[]>(argsSize + log_impl::recordAlignment);
+			argsData = reinterpret_cast<Byte*>(log_impl::AlignOffset(reinterpret_cast<SizeType>(heapStorage.get()), log_impl::recordAlignment));
+		}
+
+		SizeType offset = 0u;
+		(log_impl::ArgCodec<TArgs>::Encode(argsData, offset, args), ...);
+
+		WriteSynchronous(formatter, category, level, format, timestampNs, argsData);
+		return;
+	}
+
+	Byte* recordData = buffer.TryReserve(recordSize);
+
+	new (recordData) log_impl::RecordHeader
+	{
+		.formatter   = formatter,
+		.format      = format,
+		.category    = category,
+		.timestampNs = timestampNs,
+		.size        = static_cast<Uint32>(recordSize),
+		.level       = level
+	};
+
+	Byte* argsData = recordData + log_impl::recordHeaderSize;
+
+	SizeType offset = 0u;
+	(log_impl::ArgCodec<TArgs>::Encode(argsData, offset, args), ...);
+
+	buffer.Commit(recordSize);
+}
+
+} // spt::lib
@@ -1,6 +1,28 @@
 #include "Noise.h"
 #include "TileableVolumeNoise.h"
 
+// Library is not compiled with AVX2 enabled, so only code between SPT_NOISE_BEGIN_AVX2_CODE and SPT_NOISE_END_AVX2_CODE is compiled for AVX2.
+// This code is executed only if CPU supports AVX2
+#if defined(_MSC_VER) && defined(_M_X64)
+	#include <immintrin.h>
+	#include <intrin.h>
+	#define SPT_NOISE_WITH_AVX2 1
+	// MSVC allows using AVX2 intrinsics without /arch:AVX2
+	#define SPT_NOISE_BEGIN_AVX2_CODE
+	#define SPT_NOISE_END_AVX2_CODE
+#elif defined(__clang__) && defined(__x86_64__)
+	#include <immintrin.h>
+	#define SPT_NOISE_WITH_AVX2 1
+	#define SPT_NOISE_BEGIN_AVX2_CODE _Pragma("clang attribute push(__attribute__((target(\"avx2\"))), apply_to = function)")
+	#define SPT_NOISE_END_AVX2_CODE   _Pragma("clang attribute pop")
+#elif defined(__GNUC__) && defined(__x86_64__)
+	#include <immintrin.h>
+	#define SPT_NOISE_WITH_AVX2 1
+	#define SPT_NOISE_BEGIN_AVX2_CODE _Pragma("GCC push_options") _Pragma("GCC target(\"avx2\")")
+	#define SPT_NOISE_END_AVX2_CODE   _Pragma("GCC pop_options")
+#else
+	#define SPT_NOISE_WITH_AVX2 0
+#endif
 
 namespace spt::lib::noise
 {
@@ -15,4 +37,233 @@ Real32 GenerateTileableWorleyNoise3D(math::Vector3f coords, Real32 cellCount)
 	return TileableWorleyNoise3D(coords.x(), coords.y(), coords.z(), cellCount);
 }
 
+namespace priv
+{
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Lanes operations ==============================================================================
+
+struct ScalarOps
+{
+	using F    = Real32;
+	using I    = Uint32;
+	using Mask = Bool;
+
+	static F Set(Real32 value)  { return value; }
+	static I SetI(Uint32 value) { return value; }
+
+	static F Add(F a, F b) { return a + b; }
+	static F Sub(F a, F b) { return a - b; }
+	static F Mul(F a, F b) { return a * b; }
+	static F Div(F a, F b) { return a / b; }
+	static F Min(F a, F b) { return std::min(a, b); }
+	static F Max(F a, F b) { return std::max(a, b); }
+	static F Floor(F a)    { return std::floor(a); }
+
+	static I AddI(I a, I b) { return a + b; }
+	static I MulI(I a, I b) { return a * b; }
+	static I AndI(I a, I b) { return a & b; }
+	static I XorI(I a, I b) { return a ^ b; }
+
+	template<Int32 shift>
+	static I ShrI(I a) { return a >> shift; }
+
+	static F ToFloat(I a) { return static_cast<Real32>(static_cast<Int32>(a)); }
+	static I ToInt(F a)   { return static_cast<Uint32>(static_cast<Int32>(a)); }
+
+	static Mask EqualI(I a, I b) { return a == b; }
+
+	/** mask ? a : b */
+	static F Select(Mask mask, F a, F b) { return mask ? a : b; }
+};
+
+
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Kernels =======================================================================================
+
+namespace scalar
+{
+#include "NoiseKernels.inl"
+} // scalar
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Batches execution =============================================================================
+
+template<typename TEvaluator>
+void EvaluateBatchScalar(lib::Span<const math::Vector3f> coords, lib::Span<Real32> outValues, const TEvaluator& evaluator)
+{
+	for (SizeType idx = 0u; idx < coords.size(); ++idx)
+	{
+		const math::Vector3f& coord = coords[idx];
+		outValues[idx] = evaluator(coord.x(), coord.y(), coord.z());
+	}
+}
+
+#if SPT_NOISE_WITH_AVX2
+
+SPT_NOISE_BEGIN_AVX2_CODE
+
+struct AVX2Ops
+{
+	using F    = __m256;
+	using I    = __m256i;
+	using Mask = __m256;
+
+	static F Set(Real32 value)  { return _mm256_set1_ps(value); }
+	static I SetI(Uint32 value) { return _mm256_set1_epi32(static_cast<Int32>(value)); }
+
+	static F Add(F a, F b) { return _mm256_add_ps(a, b); }
+	static F Sub(F a, F b) { return _mm256_sub_ps(a, b); }
+	static F Mul(F a, F b) { return _mm256_mul_ps(a, b); }
+	static F Div(F a, F b) { return _mm256_div_ps(a, b); }
+	static F Min(F a, F b) { return _mm256_min_ps(a, b); }
+	static F Max(F a, F b) { return _mm256_max_ps(a, b); }
+	static F Floor(F a)    { return _mm256_floor_ps(a); }
+
+	static I AddI(I a, I b) { return _mm256_add_epi32(a, b); }
+	static I MulI(I a, I b) { return _mm256_mullo_epi32(a, b); }
+	static I AndI(I a, I b) { return _mm256_and_si256(a, b); }
+	static I XorI(I a, I b) { return _mm256_xor_si256(a, b); }
+
+	template<Int32 shift>
+	static I ShrI(I a) { return _mm256_srli_epi32(a, shift); }
+
+	static F ToFloat(I a) { return _mm256_cvtepi32_ps(a); }
+	static I ToInt(F a)   { return _mm256_cvttps_epi32(a); }
+
+	static Mask EqualI(I a, I b) { return _mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)); }
+
+	/** mask ? a : b */
+	static F Select(Mask mask, F a, F b) { return _mm256_blendv_ps(b, a, mask); }
+};
+
+
+namespace avx2
+{
+#include "NoiseKernels.inl"
+} // avx2
+
+
+template<typename TEvaluator>
+void EvaluateBatchAVX2(lib::Span<const math::Vector3f> coords, lib::Span<Real32> outValues, const TEvaluator& evaluator)
+{
+	alignas(32) Real32 xs[batchWidth];
+	alignas(32) Real32 ys[batchWidth];
+	alignas(32) Real32 zs[batchWidth];
+	alignas(32) Real32 results[batchWidth];
+
+	const SizeType fullBatchesEnd = coords.size() - coords.size() % batchWidth;
+
+	for (SizeType batchBegin = 0u; batchBegin < fullBatchesEnd; batchBegin += batchWidth)
+	{
+		for (SizeType lane = 0u; lane < batchWidth; ++lane)
+		{
+			const math::Vector3f& coord = coords[batchBegin + lane];
+			xs[lane] = coord.x();
+			ys[lane] = coord.y();
+			zs[lane] = coord.z();
+		}
+
+		const __m256 result = evaluator(_mm256_load_ps(xs), _mm256_load_ps(ys), _mm256_load_ps(zs));
+		_mm256_storeu_ps(outValues.data() + batchBegin, result);
+	}
+
+	const SizeType remainingNum = coords.size() - fullBatchesEnd;
+	if (remainingNum > 0u)
+	{
+		// Pad last batch with the last coordinate, so all lanes have valid inputs
+		for (SizeType lane = 0u; lane < batchWidth; ++lane)
+		{
+			const math::Vector3f& coord = coords[fullBatchesEnd + std::min(lane, remainingNum - 1u)];
+			xs[lane] = coord.x();
+			ys[lane] = coord.y();
+			zs[lane] = coord.z();
+		}
+
+		_mm256_store_ps(results, evaluator(_mm256_load_ps(xs), _mm256_load_ps(ys), _mm256_load_ps(zs)));
+
+		std::copy_n(results, remainingNum, outValues.data() + fullBatchesEnd);
+	}
+}
+
+SPT_NOISE_END_AVX2_CODE
+
+#endif // SPT_NOISE_WITH_AVX2
+
+static Bool DetectAVX2Support()
+{
+#if defined(__AVX2__)
+	return true;
+#elif SPT_NOISE_WITH_AVX2 && !defined(_MSC_VER)
+	// Also checks if OS saves YMM registers
+	return __builtin_cpu_supports("avx2");
+#elif SPT_NOISE_WITH_AVX2
+	Int32 cpuInfo[4] = {};
+
+	__cpuid(cpuInfo, 0);
+	if (cpuInfo[0] < 7)
+	{
+		return false;
+	}
+
+	__cpuid(cpuInfo, 1);
+	const Bool hasOSXSave = (cpuInfo[2] & (1 << 27)) != 0;
+	const Bool hasAVX     = (cpuInfo[2] & (1 << 28)) != 0;
+	if (!hasOSXSave || !hasAVX)
+	{
+		return false;
+	}
+
+	// OS must save YMM registers on context switch
+	if ((_xgetbv(0) & 0x6u) != 0x6u)
+	{
+		return false;
+	}
+
+	__cpuidex(cpuInfo, 7, 0);
+	return (cpuInfo[1] & (1 << 5)) != 0;
+#else
+	return false;
+#endif // defined(__AVX2__)
+}
+
+} // priv
+
+Bool IsAVX2NoiseSupported()
+{
+	static const Bool isSupported = priv::DetectAVX2Support();
+	return isSupported;
+}
+
+void GenerateTileablePerlinNoise3DBatch(lib::Span<const math::Vector3f> coords, Real32 frequency, Int32 octaveCount, lib::Span<Real32> outValues, EBatchNoiseImpl impl /*= EBatchNoiseImpl::Best*/)
+{
+	SPT_CHECK(coords.size() == outValues.size());
+
+#if SPT_NOISE_WITH_AVX2
+	if (impl == EBatchNoiseImpl::Best && IsAVX2NoiseSupported())
+	{
+		priv::EvaluateBatchAVX2(coords, outValues, priv::avx2::PerlinFBMEvaluator<priv::AVX2Ops>{ frequency, octaveCount });
+		return;
+	}
+#endif // SPT_NOISE_WITH_AVX2
+
+	priv::EvaluateBatchScalar(coords, outValues, priv::scalar::PerlinFBMEvaluator<priv::ScalarOps>{ frequency, octaveCount });
+}
+
+void GenerateTileableWorleyNoise3DBatch(lib::Span<const math::Vector3f> coords, Real32 cellCount, lib::Span<Real32> outValues, EBatchNoiseImpl impl /*= EBatchNoiseImpl::Best*/)
+{
+	SPT_CHECK(coords.size() == outValues.size());
+
+#if SPT_NOISE_WITH_AVX2
+	if (impl == EBatchNoiseImpl::Best && IsAVX2NoiseSupported())
+	{
+		priv::EvaluateBatchAVX2(coords, outValues, priv::avx2::WorleyEvaluator<priv::AVX2Ops>{ cellCount });
+		return;
+	}
+#endif // SPT_NOISE_WITH_AVX2
+
+	priv::EvaluateBatchScalar(coords, outValues, priv::scalar::WorleyEvaluator<priv::ScalarOps>{ cellCount });
+}
+
 } // spt::lib::noise
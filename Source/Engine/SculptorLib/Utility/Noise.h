@@ -14,6 +14,35 @@ SCULPTOR_LIB_API Real32 GenerateTileablePerlineNoise3D(math::Vector3f coords, Re
 
 SCULPTOR_LIB_API Real32 GenerateTileableWorleyNoise3D(math::Vector3f coords, Real32 cellCount);
 
+// Batched Noise ==========================================================
+
+/**
+ * Batched functions evaluate noise for many coordinates per call. Coordinates are processed in groups of batchWidth using AVX2 when it's supported by CPU.
+ * They use engine's own tileable noise implementation, so results are not the same as results of single coordinate functions above (but have the same properties and ranges).
+ * Results of scalar and SIMD implementations are the same (up to floating point rounding)
+ */
+static constexpr SizeType batchWidth = 8u;
+
+/** Must be bumped whenever results of batched functions change. Should be part of keys of any cached data generated using these functions */
+static constexpr Uint32 batchNoiseVersion = 1u;
+
+
+enum class EBatchNoiseImpl
+{
+	/** Best implementation supported by CPU */
+	Best,
+	Scalar
+};
+
+
+SCULPTOR_LIB_API Bool IsAVX2NoiseSupported();
+
+/** Tileable fBm of gradient noise. Noise tiles with period of 1 in each dimension. Returns values in [0, 1] range */
+SCULPTOR_LIB_API void GenerateTileablePerlinNoise3DBatch(lib::Span<const math::Vector3f> coords, Real32 frequency, Int32 octaveCount, lib::Span<Real32> outValues, EBatchNoiseImpl impl = EBatchNoiseImpl::Best);
+
+/** Tileable cellular noise (squared distance to the closest feature point). Noise tiles with period of 1 in each dimension. Returns values in [0, 1] range */
+SCULPTOR_LIB_API void GenerateTileableWorleyNoise3DBatch(lib::Span<const math::Vector3f> coords, Real32 cellCount, lib::Span<Real32> outValues, EBatchNoiseImpl impl = EBatchNoiseImpl::Best);
+
 } // noise
 
-} // spt::lib
\ No newline at end of file
+} // spt::lib
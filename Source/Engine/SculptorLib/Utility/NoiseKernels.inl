@@ -0,0 +1,212 @@
+// Included by Noise.cpp once for each supported instruction set, so every copy of kernels is compiled with different target options.
+// Because of that this file has no include guard and mustn't include anything
+
+/** Noise algorithms written once for all lanes operations, so scalar and SIMD implementations can't diverge */
+template<typename TOps>
+struct NoiseKernels
+{
+	using F    = typename TOps::F;
+	using I    = typename TOps::I;
+	using Mask = typename TOps::Mask;
+
+	static I Hash(I x)
+	{
+		x = TOps::XorI(x, TOps::template ShrI<16>(x));
+		x = TOps::MulI(x, TOps::SetI(0x7feb352du));
+		x = TOps::XorI(x, TOps::template ShrI<15>(x));
+		x = TOps::MulI(x, TOps::SetI(0x846ca68bu));
+		x = TOps::XorI(x, TOps::template ShrI<16>(x));
+		return x;
+	}
+
+	static I HashCell(I x, I y, I z)
+	{
+		return Hash(TOps::AddI(x, Hash(TOps::AddI(y, Hash(z)))));
+	}
+
+	/** Wraps integral cell coordinate to [0, period) range and converts it to integer */
+	static I WrapCell(F cell, F period)
+	{
+		return TOps::ToInt(TOps::Sub(cell, TOps::Mul(period, TOps::Floor(TOps::Div(cell, period)))));
+	}
+
+	static F Lerp(F a, F b, F t)
+	{
+		return TOps::Add(a, TOps::Mul(TOps::Sub(b, a), t));
+	}
+
+	static F Fade(F t)
+	{
+		// 6t^5 - 15t^4 + 10t^3
+		const F inner = TOps::Add(TOps::Mul(t, TOps::Sub(TOps::Mul(t, TOps::Set(6.f)), TOps::Set(15.f))), TOps::Set(10.f));
+		return TOps::Mul(TOps::Mul(TOps::Mul(t, t), t), inner);
+	}
+
+	/** Dot product with one of 12 gradients pointing to cube edges (classic Perlin noise gradients) */
+	static F Gradient(I hash, F x, F y, F z)
+	{
+		const I h = TOps::AndI(hash, TOps::SetI(15u));
+
+		const Mask hLess8     = TOps::EqualI(TOps::AndI(h, TOps::SetI(8u)), TOps::SetI(0u));
+		const Mask hLess4     = TOps::EqualI(TOps::AndI(h, TOps::SetI(12u)), TOps::SetI(0u));
+		const Mask h12Or14    = TOps::EqualI(TOps::AndI(h, TOps::SetI(13u)), TOps::SetI(12u));
+		const Mask negateU    = TOps::EqualI(TOps::AndI(h, TOps::SetI(1u)), TOps::SetI(1u));
+		const Mask negateV    = TOps::EqualI(TOps::AndI(h, TOps::SetI(2u)), TOps::SetI(2u));
+
+		const F u = TOps::Select(hLess8, x, y);
+		const F v = TOps::Select(hLess4, y, TOps::Select(h12Or14, x, z));
+
+		const F zero = TOps::Set(0.f);
+
+		return TOps::Add(TOps::Select(negateU, TOps::Sub(zero, u), u), TOps::Select(negateV, TOps::Sub(zero, v), v));
+	}
+
+	/** Single octave of gradient noise, tiling with given period (in noise cells). Returns values in ~[-1, 1] range */
+	static F Perlin(F x, F y, F z, F period)
+	{
+		const F one = TOps::Set(1.f);
+
+		const F x0 = TOps::Floor(x);
+		const F y0 = TOps::Floor(y);
+		const F z0 = TOps::Floor(z);
+
+		const F fx0 = TOps::Sub(x, x0);
+		const F fy0 = TOps::Sub(y, y0);
+		const F fz0 = TOps::Sub(z, z0);
+
+		const F fx1 = TOps::Sub(fx0, one);
+		const F fy1 = TOps::Sub(fy0, one);
+		const F fz1 = TOps::Sub(fz0, one);
+
+		const I ix0 = WrapCell(x0, period);
+		const I iy0 = WrapCell(y0, period);
+		const I iz0 = WrapCell(z0, period);
+
+		const I ix1 = WrapCell(TOps::Add(x0, one), period);
+		const I iy1 = WrapCell(TOps::Add(y0, one), period);
+		const I iz1 = WrapCell(TOps::Add(z0, one), period);
+
+		const F g000 = Gradient(HashCell(ix0, iy0, iz0), fx0, fy0, fz0);
+		const F g100 = Gradient(HashCell(ix1, iy0, iz0), fx1, fy0, fz0);
+		const F g010 = Gradient(HashCell(ix0, iy1, iz0), fx0, fy1, fz0);
+		const F g110 = Gradient(HashCell(ix1, iy1, iz0), fx1, fy1, fz0);
+		const F g001 = Gradient(HashCell(ix0, iy0, iz1), fx0, fy0, fz1);
+		const F g101 = Gradient(HashCell(ix1, iy0, iz1), fx1, fy0, fz1);
+		const F g011 = Gradient(HashCell(ix0, iy1, iz1), fx0, fy1, fz1);
+		const F g111 = Gradient(HashCell(ix1, iy1, iz1), fx1, fy1, fz1);
+
+		const F u = Fade(fx0);
+		const F v = Fade(fy0);
+		const F w = Fade(fz0);
+
+		const F x00 = Lerp(g000, g100, u);
+		const F x10 = Lerp(g010, g110, u);
+		const F x01 = Lerp(g001, g101, u);
+		const F x11 = Lerp(g011, g111, u);
+
+		return Lerp(Lerp(x00, x10, v), Lerp(x01, x11, v), w);
+	}
+
+	static F PerlinFBM(F x, F y, F z, Real32 frequency, Int32 octaveCount)
+	{
+		F sum = TOps::Set(0.f);
+
+		Real32 weight    = 0.5f;
+		Real32 weightSum = 0.f;
+
+		for (Int32 octaveIdx = 0; octaveIdx < octaveCount; ++octaveIdx)
+		{
+			const F octaveFrequency = TOps::Set(frequency);
+
+			const F value = Perlin(TOps::Mul(x, octaveFrequency), TOps::Mul(y, octaveFrequency), TOps::Mul(z, octaveFrequency), octaveFrequency);
+
+			sum = TOps::Add(sum, TOps::Mul(value, TOps::Set(weight)));
+
+			weightSum += weight;
+			weight    *= weight;
+			frequency *= 2.f;
+		}
+
+		const F noise = TOps::Add(TOps::Mul(sum, TOps::Set(0.5f / std::max(weightSum, 1e-6f))), TOps::Set(0.5f));
+
+		return TOps::Min(TOps::Max(noise, TOps::Set(0.f)), TOps::Set(1.f));
+	}
+
+	static F Worley(F x, F y, F z, Real32 cellCount)
+	{
+		const F period = TOps::Set(cellCount);
+
+		const F px = TOps::Mul(x, period);
+		const F py = TOps::Mul(y, period);
+		const F pz = TOps::Mul(z, period);
+
+		const F baseX = TOps::Floor(px);
+		const F baseY = TOps::Floor(py);
+		const F baseZ = TOps::Floor(pz);
+
+		const I featureMask  = TOps::SetI(0x3FFu);
+		const F featureScale = TOps::Set(1.f / 1024.f);
+
+		F minDistance2 = TOps::Set(1e10f);
+
+		for (Int32 offsetZ = -1; offsetZ <= 1; ++offsetZ)
+		{
+			const F cellZ = TOps::Add(baseZ, TOps::Set(static_cast<Real32>(offsetZ)));
+			const I wrappedZ = WrapCell(cellZ, period);
+
+			for (Int32 offsetY = -1; offsetY <= 1; ++offsetY)
+			{
+				const F cellY = TOps::Add(baseY, TOps::Set(static_cast<Real32>(offsetY)));
+				const I wrappedY = WrapCell(cellY, period);
+
+				for (Int32 offsetX = -1; offsetX <= 1; ++offsetX)
+				{
+					const F cellX = TOps::Add(baseX, TOps::Set(static_cast<Real32>(offsetX)));
+					const I wrappedX = WrapCell(cellX, period);
+
+					// Feature point position within cell is encoded in 3x10 bits of the cell hash
+					const I hash = HashCell(wrappedX, wrappedY, wrappedZ);
+
+					const F featureX = TOps::Mul(TOps::ToFloat(TOps::AndI(hash, featureMask)), featureScale);
+					const F featureY = TOps::Mul(TOps::ToFloat(TOps::AndI(TOps::template ShrI<10>(hash), featureMask)), featureScale);
+					const F featureZ = TOps::Mul(TOps::ToFloat(TOps::AndI(TOps::template ShrI<20>(hash), featureMask)), featureScale);
+
+					const F dx = TOps::Sub(px, TOps::Add(cellX, featureX));
+					const F dy = TOps::Sub(py, TOps::Add(cellY, featureY));
+					const F dz = TOps::Sub(pz, TOps::Add(cellZ, featureZ));
+
+					const F distance2 = TOps::Add(TOps::Add(TOps::Mul(dx, dx), TOps::Mul(dy, dy)), TOps::Mul(dz, dz));
+
+					minDistance2 = TOps::Min(minDistance2, distance2);
+				}
+			}
+		}
+
+		return TOps::Min(TOps::Max(minDistance2, TOps::Set(0.f)), TOps::Set(1.f));
+	}
+};
+
+
+template<typename TOps>
+struct PerlinFBMEvaluator
+{
+	Real32 frequency   = 0.f;
+	Int32  octaveCount = 0;
+
+	typename TOps::F operator()(typename TOps::F x, typename TOps::F y, typename TOps::F z) const
+	{
+		return NoiseKernels<TOps>::PerlinFBM(x, y, z, frequency, octaveCount);
+	}
+};
+
+
+template<typename TOps>
+struct WorleyEvaluator
+{
+	Real32 cellCount = 0.f;
+
+	typename TOps::F operator()(typename TOps::F x, typename TOps::F y, typename TOps::F z) const
+	{
+		return NoiseKernels<TOps>::Worley(x, y, z, cellCount);
+	}
+};
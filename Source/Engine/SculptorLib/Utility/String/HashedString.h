@@ -28,11 +28,15 @@ public:
 		: m_key(DataBaseType::keyNone)
 	{ }
 
-	StringHash(const char* literal)
+	constexpr StringHash(const char* literal)
 		: m_key(DataBaseType::HashString(literal))
 	{ }
 
-	SPT_NODISCARD KeyType GetKey() const
+	constexpr StringHash(StringView string)
+		: m_key(DataBaseType::HashString(string))
+	{ }
+
+	SPT_NODISCARD constexpr KeyType GetKey() const
 	{
 		return m_key;
 	}
@@ -91,6 +95,13 @@ public:
 		m_key = DataBaseType::GetRecord(StringView(rhs), m_stringView);
 	}
 
+	/** Skips hashing of the string. Hash must be created from the same string (f.e. in compile time, using SPT_HASHED_STRING) */
+	HashedString(StringHash<DataBaseType> hash, StringView string)
+		: m_key(hash.GetKey())
+	{
+		DataBaseType::GetRecord(m_key, string, m_stringView);
+	}
+
 	ThisType& operator=(const ThisType& rhs)
 	{
 		m_key = rhs.m_key;
@@ -223,6 +234,10 @@ struct Hasher<HashedString>
 } // spt::lib
 
 
+/** Creates hashed string from literal, with hash computed in compile time */
+#define SPT_HASHED_STRING(Literal) spt::lib::HashedString([]() { constexpr spt::lib::StringHash hash(Literal); return hash; }(), Literal)
+
+
 namespace std
 {
 	template<>
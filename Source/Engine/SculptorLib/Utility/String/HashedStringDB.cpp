@@ -1,8 +1,10 @@
 #include "HashedStringDB.h"
-#include "Containers/HashMap.h"
 #include "ProfilerCore.h"
 #include "Utility/Threading/Lock.h"
 #include "Assertions/Assertions.h"
+#include "MathUtils.h"
+
+#include <atomic>
 
 
 namespace spt::lib
@@ -11,17 +13,248 @@ namespace spt::lib
 namespace db
 {
 
+struct Record
+{
+	StringView GetView() const
+	{
+		return StringView(reinterpret_cast<const char*>(this + 1), size);
+	}
+
+	HashedStringDB::KeyType key;
+	SizeType                size;
+
+	// Null-terminated string data is stored directly after the record
+};
+
+
+/**
+ * Append-only storage for records. Records are never moved or freed, so views to them are valid for the whole lifetime of the database
+ */
+class RecordsStorage
+{
+public:
+
+	RecordsStorage()
+		: m_currentChunkOffset(0u)
+		, m_currentChunkSize(0u)
+	{ }
+
+	Record* Allocate(HashedStringDB::KeyType key, StringView string)
+	{
+		const SizeType allocationSize = math::Utils::RoundUp(sizeof(Record) + string.size() + 1u, alignof(Record));
+
+		Byte* memory = nullptr;
+
+		{
+			const LockGuard lockGuard(m_lock);
+
+			if (m_currentChunkOffset + allocationSize > m_currentChunkSize)
+			{
+				m_currentChunkSize   = std::max(chunkSize, allocationSize);
+				m_currentChunkOffset = 0u;
+				m_chunks.emplace_back(std::make_unique<Byte[]>(m_currentChunkSize));
+			}
+
+			memory = m_chunks.back().get() + m_currentChunkOffset;
+			m_currentChunkOffset += allocationSize;
+		}
+
+		Record* record = new (memory) Record{ key, string.size() };
+
+		char* data = reinterpret_cast<char*>(record + 1);
+		std::copy_n(string.data(), string.size(), data);
+		data[string.size()] = '\0';
+
+		return record;
+	}
+
+private:
+
+	static constexpr SizeType chunkSize = 64u * 1024u;
+
+	DynamicArray<std::unique_ptr<Byte[]>> m_chunks;
+	SizeType                              m_currentChunkOffset;
+	SizeType                              m_currentChunkSize;
+	Lock                                  m_lock;
+};
+
+
+/**
+ * Append-only open addressing hash table with fixed capacity.
+ * Lookups never take locks and are wait-free (bounded by capacity). Inserts publish records with CAS, so lookups always see fully initialized records
+ */
+class TableSegment
+{
+public:
+
+	explicit TableSegment(SizeType inCapacity)
+		: m_capacity(inCapacity)
+		, m_mask(inCapacity - 1u)
+		, m_maxRecordsNum(inCapacity / 4u * 3u)
+		, m_slots(std::make_unique<std::atomic<const Record*>[]>(inCapacity))
+		, m_recordsNum(0u)
+		, m_next(nullptr)
+	{
+		SPT_CHECK(math::Utils::IsPowerOf2(inCapacity));
+	}
+
+	~TableSegment()
+	{
+		delete m_next.load(std::memory_order_acquire);
+	}
+
+	const Record* Find(HashedStringDB::KeyType key) const
+	{
+		for (SizeType probe = 0u; probe < m_capacity; ++probe)
+		{
+			const Record* record = m_slots[(key + probe) & m_mask].load(std::memory_order_acquire);
+
+			if (!record)
+			{
+				return nullptr;
+			}
+
+			if (record->key == key)
+			{
+				return record;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/**
+	 * Returns nullptr if key is not in this segment and segment is full, so it must be added to next segment.
+	 * newRecord is allocated only once, so it can be carried over to next segment
+	 */
+	const Record* FindOrAdd(HashedStringDB::KeyType key, StringView string, RecordsStorage& storage, Record*& newRecord)
+	{
+		for (SizeType probe = 0u; probe < m_capacity; ++probe)
+		{
+			std::atomic<const Record*>& slot = m_slots[(key + probe) & m_mask];
+
+			const Record* record = slot.load(std::memory_order_acquire);
+
+			while (!record)
+			{
+				// Keep load factor low, so that probe sequences stay short. Limit may be exceeded by concurrent inserts, but only by few records
+				if (m_recordsNum.load(std::memory_order_relaxed) >= m_maxRecordsNum)
+				{
+					return nullptr;
+				}
+
+				if (!newRecord)
+				{
+					newRecord = storage.Allocate(key, string);
+				}
+
+				if (slot.compare_exchange_weak(record, newRecord, std::memory_order_acq_rel, std::memory_order_acquire))
+				{
+					m_recordsNum.fetch_add(1u, std::memory_order_relaxed);
+					return newRecord;
+				}
+
+				// On failure, record contains value published by other thread (or is still null if CAS failed spuriously)
+			}
+
+			// If other thread inserted the same string in the meantime, our allocated record is abandoned. This is rare and it's only wasted memory
+			if (record->key == key)
+			{
+				return record;
+			}
+		}
+
+		return nullptr;
+	}
+
+	TableSegment* GetNext() const
+	{
+		return m_next.load(std::memory_order_acquire);
+	}
+
+	TableSegment& GetOrCreateNext(Lock& segmentsLock)
+	{
+		TableSegment* next = GetNext();
+
+		if (!next)
+		{
+			const LockGuard lockGuard(segmentsLock);
+
+			next = m_next.load(std::memory_order_relaxed);
+			if (!next)
+			{
+				next = new TableSegment(m_capacity * 2u);
+				m_next.store(next, std::memory_order_release);
+			}
+		}
+
+		return *next;
+	}
+
+private:
+
+	const SizeType m_capacity;
+	const SizeType m_mask;
+	const SizeType m_maxRecordsNum;
+
+	std::unique_ptr<std::atomic<const Record*>[]> m_slots;
+	std::atomic<SizeType>                         m_recordsNum;
+
+	std::atomic<TableSegment*> m_next;
+};
+
+
+/**
+ * Chain of append-only hash tables. When segment is full, records are added to next segment, which has twice the capacity.
+ * Existing segments are never rehashed, so lookups stay lock-free. Only allocation of record storage and creation of new segment are guarded by locks.
+ * In rare case when two threads add the same string while segment becomes full, string may end up in two segments. Both records have the same content
+ */
 class DataBase
 {
 public:
 
+	static constexpr SizeType initialCapacity = 1u << 18;
+
 	DataBase()
+		: m_firstSegment(initialCapacity)
+	{ }
+
+	const Record* Find(HashedStringDB::KeyType key) const
 	{
-		records.reserve(4096);
+		for (const TableSegment* segment = &m_firstSegment; segment; segment = segment->GetNext())
+		{
+			if (const Record* record = segment->Find(key))
+			{
+				return record;
+			}
+		}
+
+		return nullptr;
+	}
+
+	const Record& FindOrAdd(HashedStringDB::KeyType key, StringView string)
+	{
+		Record* newRecord = nullptr;
+
+		TableSegment* segment = &m_firstSegment;
+
+		while (true)
+		{
+			if (const Record* record = segment->FindOrAdd(key, string, m_storage, newRecord))
+			{
+				return *record;
+			}
+
+			segment = &segment->GetOrCreateNext(m_segmentsLock);
+		}
 	}
 
-	ReadWriteLock								recordsMutex;
-	HashMap<HashedStringDB::KeyType, String>	records;
+private:
+
+	TableSegment m_firstSegment;
+	Lock         m_segmentsLock;
+
+	RecordsStorage m_storage;
 };
 
 DataBase* g_dbInstance = nullptr;
@@ -47,57 +280,24 @@ HashedStringDBData* HashedStringDB::GetDBData()
 
 HashedStringDB::KeyType HashedStringDB::GetRecord(String&& inString, StringView& outView)
 {
-	const KeyType key = HashString(inString);
-
-	const Bool foundRecord = FindRecord(key, outView);
-
-	if (!foundRecord)
-	{
-		// We need to disable SSO (small string optimization) in these strings
-		// otherwise string_views in HashedString may point invalid memory after reallocation of records after reallocation of records
-		constexpr SizeType requiredSizeToDisableSSO = sizeof(String) + 1;
-
-		String newRecord;
-		if (inString.size() > requiredSizeToDisableSSO)
-		{
-			newRecord = std::forward<String>(inString);
-		}
-		else
-		{
-			newRecord.reserve(requiredSizeToDisableSSO);
-			newRecord = inString;
-		}
-
-		outView = CreateRecord(key, std::move(newRecord));
-	}
-
-	return key;
+	// Records are copied to database storage, so there is no benefit from taking ownership of the string
+	return GetRecord(StringView(inString), outView);
 }
 
 HashedStringDB::KeyType HashedStringDB::GetRecord(StringView inString, StringView& outView)
 {
 	const KeyType key = HashString(inString);
 
-	const Bool foundRecord = FindRecord(key, outView);
-
-	if (!foundRecord)
-	{
-		// We need to disable SSO (small string optimization) in these strings
-		// otherwise string_views in HashedString may point invalid memory after reallocation of records after reallocation of records
-		constexpr SizeType requiredSizeToDisableSSO = sizeof(String) + 1;
-
-		String newRecord(inString);
-		if (inString.size() < requiredSizeToDisableSSO)
-		{
-			newRecord.reserve(requiredSizeToDisableSSO);
-		}
-
-		outView = CreateRecord(key, std::move(newRecord));
-	}
+	GetRecord(key, inString, outView);
 
 	return key;
 }
 
+void HashedStringDB::GetRecord(KeyType key, StringView inString, StringView& outView)
+{
+	outView = db::g_dbInstance->FindOrAdd(key, inString).GetView();
+}
+
 StringView HashedStringDB::GetRecordStringChecked(KeyType key)
 {
 	StringView outString;
@@ -109,30 +309,14 @@ StringView HashedStringDB::GetRecordStringChecked(KeyType key)
 
 Bool HashedStringDB::FindRecord(KeyType key, StringView& outView)
 {
-	const ReadLockGuard readRecordsLock(db::g_dbInstance->recordsMutex);
-
-	const auto foundRecord = db::g_dbInstance->records.find(key);
-	if (foundRecord != db::g_dbInstance->records.cend())
+	const db::Record* record = db::g_dbInstance->Find(key);
+	if (record)
 	{
-		outView = foundRecord->second;
-
+		outView = record->GetView();
 		return true;
 	}
 
 	return false;
 }
 
-String& HashedStringDB::CreateRecord(KeyType key, String&& newRecord)
-{
-	const WriteLockGuard addRecordLock(db::g_dbInstance->recordsMutex);
-
-	String& recordRef = db::g_dbInstance->records[key];
-	if (recordRef.empty())
-	{
-		recordRef = std::move(newRecord);
-	}
-
-	return recordRef;
-}
-
 }
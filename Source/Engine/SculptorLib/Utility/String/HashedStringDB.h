@@ -27,18 +27,34 @@ public:
 	static KeyType GetRecord(String&& inString, StringView& outView);
 	static KeyType GetRecord(StringView inString, StringView& outView);
 
+	/** Fast path for strings which hash is already known (f.e. computed in compile time). Key must be equal to HashString(inString) */
+	static void GetRecord(KeyType key, StringView inString, StringView& outView);
+
 	static StringView GetRecordStringChecked(KeyType key);
 
+	/**
+	 * 64-bit FNV-1a. It's the same function that is used by MSVC's std::hash for strings, so keys didn't change after making it constexpr
+	 */
 	SPT_NODISCARD static constexpr KeyType HashString(StringView string)
 	{
-		return GetHash(string);
+		static_assert(sizeof(KeyType) == sizeof(Uint64), "FNV-1a constants are defined for 64-bit keys");
+
+		constexpr KeyType offsetBasis = 14695981039346656037ull;
+		constexpr KeyType prime       = 1099511628211ull;
+
+		KeyType hash = offsetBasis;
+		for (const char c : string)
+		{
+			hash ^= static_cast<KeyType>(static_cast<unsigned char>(c));
+			hash *= prime;
+		}
+
+		return hash;
 	}
 
 private:
 
 	static Bool FindRecord(KeyType key, StringView& outView);
-
-	static String& CreateRecord(KeyType key, String&& newRecord);
 };
 
 } // spt::lib
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "SculptorAliases.h"
+#include "Utility/UtilityMacros.h"
+#include "Utility/Memory.h"
+#include "Containers/DynamicArray.h"
+#include "Containers/StaticArray.h"
+#include "Assertions/Assertions.h"
+
+#include <atomic>
+
+
+namespace spt::lib
+{
+
+/**
+ * Read-copy-update container of immutable data.
+ * Readers access current data without locks. Writers publish new version of data and old versions are destroyed after all readers that could see them finish.
+ *
+ * Readers are counted in two slots selected by epoch. Epoch is advanced only when readers of previous epoch finished,
+ * so data retired in epoch N can be destroyed when epoch reaches N + 2.
+ * Writes (Publish, GetCurrent, TryReclaim) must be synchronized by the owner.
+ */
+template<typename TData>
+class RCUData
+{
+public:
+
+	class ReadScope
+	{
+	public:
+
+		explicit ReadScope(const RCUData& owner)
+			: m_owner(owner)
+		{
+			Uint32 epoch = m_owner.m_epoch.load();
+
+			while (true)
+			{
+				m_owner.m_readersNum[epoch & 1u].fetch_add(1u);
+
+				// Writer may have advanced epoch and checked this slot before reader was registered
+				const Uint32 currentEpoch = m_owner.m_epoch.load();
+				if (currentEpoch == epoch)
+				{
+					break;
+				}
+
+				m_owner.m_readersNum[epoch & 1u].fetch_sub(1u);
+				epoch = currentEpoch;
+			}
+
+			m_slotIdx = epoch & 1u;
+			m_data    = m_owner.m_data.load();
+		}
+
+		~ReadScope()
+		{
+			m_owner.m_readersNum[m_slotIdx].fetch_sub(1u);
+		}
+
+		ReadScope(const ReadScope& rhs) = delete;
+		ReadScope& operator=(const ReadScope& rhs) = delete;
+
+		/** Returned data is valid until end of scope, even if new data was published in the meantime */
+		const TData* Get() const { return m_data; }
+
+	private:
+
+		const RCUData& m_owner;
+		Uint32         m_slotIdx = 0u;
+		const TData*   m_data    = nullptr;
+	};
+
+	RCUData() = default;
+
+	~RCUData()
+	{
+		SPT_CHECK_MSG(m_readersNum[0].load() == 0u && m_readersNum[1].load() == 0u, "RCU data destroyed during read");
+
+		delete m_data.load();
+	}
+
+	RCUData(const RCUData& rhs) = delete;
+	RCUData& operator=(const RCUData& rhs) = delete;
+
+	SPT_NODISCARD ReadScope Read() const
+	{
+		return ReadScope(*this);
+	}
+
+	/** Writers only */
+	TData* GetCurrent() const
+	{
+		return m_data.load();
+	}
+
+	/** Writers only. Previous data is retired and destroyed when it's no longer read */
+	void Publish(lib::UniquePtr<TData> newData)
+	{
+		TData* prevData = m_data.exchange(newData.release());
+		if (prevData)
+		{
+			m_retiredData.emplace_back(RetiredData{ lib::UniquePtr<TData>(prevData), m_epoch.load() });
+			m_hasRetiredData.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	/** Writers only. Destroys retired data that can't be read anymore */
+	void TryReclaim()
+	{
+		while (!m_retiredData.empty())
+		{
+			const Uint32 epoch = m_epoch.load();
+
+			std::erase_if(m_retiredData,
+						  [epoch](const RetiredData& retired)
+						  {
+							  return epoch - retired.epoch >= 2u;
+						  });
+
+			// Advance epoch only if all readers of previous epoch (which uses the same slot as next epoch) finished
+			if (m_retiredData.empty() || m_readersNum[(epoch + 1u) & 1u].load() != 0u)
+			{
+				break;
+			}
+
+			m_epoch.store(epoch + 1u);
+		}
+
+		m_hasRetiredData.store(!m_retiredData.empty(), std::memory_order_relaxed);
+	}
+
+	/** Can be called by readers to check if writer should try to reclaim retired data */
+	Bool HasRetiredData() const
+	{
+		return m_hasRetiredData.load(std::memory_order_relaxed);
+	}
+
+private:
+
+	struct RetiredData
+	{
+		lib::UniquePtr<TData> data;
+		Uint32                epoch = 0u;
+	};
+
+	std::atomic<TData*> m_data = nullptr;
+
+	mutable std::atomic<Uint32>                      m_epoch = 0u;
+	mutable lib::StaticArray<std::atomic<Uint32>, 2> m_readersNum{};
+
+	lib::DynamicArray<RetiredData> m_retiredData;
+	std::atomic<Bool>              m_hasRetiredData = false;
+};
+
+} // spt::lib
@@ -0,0 +1,246 @@
+#include "gtest/gtest.h"
+#include "SculptorCoreTypes.h"
+#include "Allocators/ConcurrentIndexAllocator.h"
+
+#include <chrono>
+#include <random>
+#include <thread>
+
+
+namespace spt::lib::tests
+{
+
+namespace priv
+{
+
+/** Previous implementation of descriptors allocator - single free stack protected by spinlock */
+class SpinlockIndexAllocator
+{
+public:
+
+	explicit SpinlockIndexAllocator(Uint32 size)
+		: m_freeIndicesNum(size)
+		, m_freeStack(size)
+	{
+		for (Uint32 idx = 0u; idx < size; ++idx)
+		{
+			m_freeStack[idx] = idx;
+		}
+	}
+
+	Uint32 Allocate()
+	{
+		const lib::LockGuard lockGuard(m_lock);
+		return m_freeIndicesNum > 0u ? m_freeStack[--m_freeIndicesNum] : idxNone<Uint32>;
+	}
+
+	void Free(Uint32 idx)
+	{
+		const lib::LockGuard lockGuard(m_lock);
+		m_freeStack[m_freeIndicesNum++] = idx;
+	}
+
+private:
+
+	lib::Spinlock m_lock;
+	Uint32 m_freeIndicesNum = 0u;
+	lib::DynamicArray<Uint32> m_freeStack;
+};
+
+
+template<typename TCallable>
+Real64 RunWorkers(Uint32 workersNum, TCallable&& callable)
+{
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+
+	lib::DynamicArray<std::thread> workers;
+	for (Uint32 workerIdx = 0u; workerIdx < workersNum; ++workerIdx)
+	{
+		workers.emplace_back([workerIdx, &callable] { callable(workerIdx); });
+	}
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	return std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+}
+
+
+/** Each worker keeps some indices allocated and frees them in batches, similar to resources created and released during frame */
+template<typename TAllocator>
+Real64 MeasureAllocationsTimeMs(TAllocator& allocator, Uint32 workersNum, Uint32 iterationsNum)
+{
+	return RunWorkers(workersNum,
+					  [&allocator, iterationsNum](Uint32 workerIdx)
+					  {
+						  constexpr Uint32 liveIndicesNum = 32u;
+
+						  lib::StaticArray<Uint32, liveIndicesNum> indices;
+
+						  for (Uint32 iteration = 0u; iteration < iterationsNum; ++iteration)
+						  {
+							  for (Uint32& idx : indices)
+							  {
+								  idx = allocator.Allocate();
+							  }
+
+							  for (Uint32 idx : indices)
+							  {
+								  allocator.Free(idx);
+							  }
+						  }
+					  });
+}
+
+} // priv
+
+TEST(ConcurrentIndexAllocatorTests, AllocatesAllIndices)
+{
+	constexpr Uint32 size = 1000u;
+
+	ConcurrentIndexAllocator allocator(size);
+
+	lib::DynamicArray<Bool> allocated(size, false);
+
+	for (Uint32 i = 0u; i < size; ++i)
+	{
+		const Uint32 idx = allocator.Allocate();
+		ASSERT_LT(idx, size);
+		EXPECT_FALSE(allocated[idx]);
+		allocated[idx] = true;
+	}
+
+	EXPECT_EQ(allocator.Allocate(), idxNone<Uint32>);
+	EXPECT_EQ(allocator.GetFreeIndicesNum(), 0u);
+}
+
+TEST(ConcurrentIndexAllocatorTests, AllocatesIndicesCachedByOtherThreads)
+{
+	constexpr Uint32 size = 512u;
+
+	ConcurrentIndexAllocator allocator(size);
+
+	lib::DynamicArray<Uint32> indices;
+	for (Uint32 i = 0u; i < size; ++i)
+	{
+		indices.emplace_back(allocator.Allocate());
+	}
+
+	// Indices freed by other thread stay in its cache, or are returned to shared pool
+	std::thread([&allocator, &indices]
+				{
+					allocator.FreeBulk(lib::Span<const Uint32>(indices.data(), size / 2u));
+
+					for (Uint32 i = size / 2u; i < size; ++i)
+					{
+						allocator.Free(indices[i]);
+					}
+				}).join();
+
+	EXPECT_EQ(allocator.GetFreeIndicesNum(), size);
+
+	lib::DynamicArray<Bool> allocated(size, false);
+
+	for (Uint32 i = 0u; i < size; ++i)
+	{
+		const Uint32 idx = allocator.Allocate();
+		ASSERT_LT(idx, size);
+		EXPECT_FALSE(allocated[idx]);
+		allocated[idx] = true;
+	}
+
+	EXPECT_EQ(allocator.Allocate(), idxNone<Uint32>);
+}
+
+TEST(ConcurrentIndexAllocatorTests, MultithreadedStress)
+{
+	constexpr Uint32 size          = 4096u;
+	constexpr Uint32 workersNum    = 8u;
+	constexpr Uint32 iterationsNum = 20000u;
+
+	ConcurrentIndexAllocator allocator(size);
+
+	lib::DynamicArray<std::atomic<Bool>> allocated(size);
+	std::atomic<Uint32> doubleAllocationsNum = 0u;
+
+	priv::RunWorkers(workersNum,
+					 [&](Uint32 workerIdx)
+					 {
+						 std::mt19937 random(workerIdx);
+
+						 lib::DynamicArray<Uint32> liveIndices;
+
+						 for (Uint32 iteration = 0u; iteration < iterationsNum; ++iteration)
+						 {
+							 const Uint32 operation = random() % 8u;
+
+							 if (operation < 4u)
+							 {
+								 const Uint32 idx = allocator.Allocate();
+								 if (idx != idxNone<Uint32>)
+								 {
+									 if (allocated[idx].exchange(true))
+									 {
+										 ++doubleAllocationsNum;
+									 }
+									 liveIndices.emplace_back(idx);
+								 }
+							 }
+							 else if (operation < 7u && !liveIndices.empty())
+							 {
+								 const SizeType liveIdx = random() % liveIndices.size();
+								 const Uint32 idx = liveIndices[liveIdx];
+								 liveIndices[liveIdx] = liveIndices.back();
+								 liveIndices.pop_back();
+
+								 allocated[idx].store(false);
+								 allocator.Free(idx);
+							 }
+							 else if (!liveIndices.empty())
+							 {
+								 for (Uint32 idx : liveIndices)
+								 {
+									 allocated[idx].store(false);
+								 }
+
+								 allocator.FreeBulk(liveIndices);
+								 liveIndices.clear();
+							 }
+						 }
+
+						 for (Uint32 idx : liveIndices)
+						 {
+							 allocated[idx].store(false);
+						 }
+						 allocator.FreeBulk(liveIndices);
+					 });
+
+	EXPECT_EQ(doubleAllocationsNum.load(), 0u);
+	EXPECT_EQ(allocator.GetFreeIndicesNum(), size);
+}
+
+TEST(ConcurrentIndexAllocatorTests, ConcurrentVsSpinlockBenchmark)
+{
+	constexpr Uint32 size          = 1024u * 128u;
+	constexpr Uint32 workersNum    = 8u;
+	constexpr Uint32 iterationsNum = 20000u;
+
+	priv::SpinlockIndexAllocator spinlockAllocator(size);
+	ConcurrentIndexAllocator concurrentAllocator(size);
+
+	const Real64 spinlockMs   = priv::MeasureAllocationsTimeMs(spinlockAllocator, workersNum, iterationsNum);
+	const Real64 concurrentMs = priv::MeasureAllocationsTimeMs(concurrentAllocator, workersNum, iterationsNum);
+
+	EXPECT_EQ(concurrentAllocator.GetFreeIndicesNum(), size);
+
+	const Real64 operationsNum = static_cast<Real64>(workersNum) * iterationsNum * 32.0 * 2.0;
+
+	RecordProperty("SpinlockMs",        std::to_string(spinlockMs));
+	RecordProperty("ConcurrentMs",      std::to_string(concurrentMs));
+	RecordProperty("SpinlockNsPerOp",   std::to_string(spinlockMs * 1000000.0 / operationsNum));
+	RecordProperty("ConcurrentNsPerOp", std::to_string(concurrentMs * 1000000.0 / operationsNum));
+}
+
+} // spt::lib::tests
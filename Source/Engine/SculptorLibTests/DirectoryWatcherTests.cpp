@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+#include "SculptorCoreTypes.h"
+#include "FileSystem/DirectoryWatcher.h"
+
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <thread>
+
+
+namespace spt::lib::tests
+{
+
+namespace priv
+{
+
+/** Creates empty temporary directory and removes it at the end of the test */
+class TempDirectory
+{
+public:
+
+	TempDirectory()
+	{
+		std::random_device randomDevice;
+		m_path = std::filesystem::temp_directory_path() / ("SculptorDirectoryWatcherTests_" + std::to_string(randomDevice()));
+		std::filesystem::create_directories(m_path);
+	}
+
+	~TempDirectory()
+	{
+		std::error_code errorCode;
+		std::filesystem::remove_all(m_path, errorCode);
+	}
+
+	const lib::Path& GetPath() const { return m_path; }
+
+private:
+
+	lib::Path m_path;
+};
+
+
+/** Collects notifications received on watcher thread */
+class ModificationsRecorder
+{
+public:
+
+	FileModifiedCallback CreateCallback()
+	{
+		return FileModifiedCallback::CreateLambda([this](const FileModifiedPayload& payload)
+												  {
+													  const lib::LockGuard lockGuard(m_lock);
+													  m_modifications.emplace_back(payload.relativePath.generic_string());
+												  });
+	}
+
+	/** Waits until at least one notification is received, and then for some additional time, so duplicated notifications would be received too */
+	lib::DynamicArray<lib::String> WaitForModifications(std::chrono::milliseconds settleTime)
+	{
+		const auto timeoutTime = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+		while (std::chrono::steady_clock::now() < timeoutTime)
+		{
+			{
+				const lib::LockGuard lockGuard(m_lock);
+				if (!m_modifications.empty())
+				{
+					break;
+				}
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+
+		std::this_thread::sleep_for(settleTime);
+
+		const lib::LockGuard lockGuard(m_lock);
+		return m_modifications;
+	}
+
+private:
+
+	lib::Lock                      m_lock;
+	lib::DynamicArray<lib::String> m_modifications;
+};
+
+
+static void WriteFile(const lib::Path& path, const lib::String& content)
+{
+	std::ofstream stream(path, std::ios::binary | std::ios::app);
+	stream << content;
+}
+
+} // priv
+
+TEST(DirectoryWatcherTests, CoalescesMultipleWritesToSameFile)
+{
+	const priv::TempDirectory tempDirectory;
+	priv::ModificationsRecorder recorder;
+
+	WatchParams params;
+	params.directory          = tempDirectory.GetPath();
+	params.callback           = recorder.CreateCallback();
+	params.coalescingWindowMs = 200u;
+
+	const FileWatcherHandle handle = StartWatchingDirectory(std::move(params));
+	ASSERT_NE(handle, 0u);
+
+	// Editors often save file in multiple steps
+	for (Uint32 writeIdx = 0u; writeIdx < 5u; ++writeIdx)
+	{
+		priv::WriteFile(tempDirectory.GetPath() / "Shader.hlsl", "// step " + std::to_string(writeIdx) + "\n");
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	const lib::DynamicArray<lib::String> modifications = recorder.WaitForModifications(std::chrono::milliseconds(600));
+
+	StopWatchingDirectory(handle);
+
+	ASSERT_EQ(modifications.size(), 1u);
+	EXPECT_EQ(modifications[0], "Shader.hlsl");
+}
+
+TEST(DirectoryWatcherTests, ReportsDifferentFilesSeparately)
+{
+	const priv::TempDirectory tempDirectory;
+	priv::ModificationsRecorder recorder;
+
+	WatchParams params;
+	params.directory          = tempDirectory.GetPath();
+	params.callback           = recorder.CreateCallback();
+	params.coalescingWindowMs = 100u;
+
+	const FileWatcherHandle handle = StartWatchingDirectory(std::move(params));
+	ASSERT_NE(handle, 0u);
+
+	priv::WriteFile(tempDirectory.GetPath() / "A.txt", "a");
+	priv::WriteFile(tempDirectory.GetPath() / "B.txt", "b");
+	priv::WriteFile(tempDirectory.GetPath() / "A.txt", "a");
+
+	lib::DynamicArray<lib::String> modifications = recorder.WaitForModifications(std::chrono::milliseconds(500));
+
+	StopWatchingDirectory(handle);
+
+	std::sort(std::begin(modifications), std::end(modifications));
+	EXPECT_EQ(modifications, lib::DynamicArray<lib::String>({ "A.txt", "B.txt" }));
+}
+
+TEST(DirectoryWatcherTests, WatchesSubdirectoriesCreatedAfterStart)
+{
+	const priv::TempDirectory tempDirectory;
+	priv::ModificationsRecorder recorder;
+
+	WatchParams params;
+	params.directory           = tempDirectory.GetPath();
+	params.callback            = recorder.CreateCallback();
+	params.watchSubdirectories = true;
+	params.coalescingWindowMs  = 100u;
+
+	const FileWatcherHandle handle = StartWatchingDirectory(std::move(params));
+	ASSERT_NE(handle, 0u);
+
+	std::filesystem::create_directories(tempDirectory.GetPath() / "Materials" / "Metals");
+	priv::WriteFile(tempDirectory.GetPath() / "Materials" / "Metals" / "Gold.sptasset", "gold");
+
+	const lib::DynamicArray<lib::String> modifications = recorder.WaitForModifications(std::chrono::milliseconds(500));
+
+	StopWatchingDirectory(handle);
+
+	ASSERT_EQ(modifications.size(), 1u);
+	EXPECT_EQ(modifications[0], "Materials/Metals/Gold.sptasset");
+}
+
+} // spt::lib::tests
@@ -0,0 +1,85 @@
+#include "gtest/gtest.h"
+#include "SculptorCoreTypes.h"
+#include "Utility/String/HashedStringDB.h"
+
+#include <thread>
+
+
+namespace spt::lib::tests
+{
+
+namespace priv
+{
+
+static lib::String CreateTestString(const char* prefix, Uint32 idx)
+{
+	return lib::String(prefix) + std::to_string(idx);
+}
+
+} // priv
+
+
+/** Database starts with 2^18 slots. Adding more strings must create new segments instead of failing */
+TEST(HashedStringDBTests, GrowsBeyondInitialCapacity)
+{
+	constexpr Uint32 stringsNum = 1u << 19;
+
+	for (Uint32 idx = 0u; idx < stringsNum; ++idx)
+	{
+		const lib::String string = priv::CreateTestString("GrowthTest_", idx);
+
+		StringView view;
+		const HashedStringDB::KeyType key = HashedStringDB::GetRecord(StringView(string), view);
+
+		ASSERT_EQ(key, HashedStringDB::HashString(string));
+		ASSERT_EQ(view, string);
+	}
+
+	// Strings from first and later segments must be found
+	for (Uint32 idx = 0u; idx < stringsNum; ++idx)
+	{
+		const lib::String string = priv::CreateTestString("GrowthTest_", idx);
+		ASSERT_EQ(HashedStringDB::GetRecordStringChecked(HashedStringDB::HashString(string)), string);
+	}
+}
+
+
+TEST(HashedStringDBTests, ConcurrentInsertsReturnTheSameString)
+{
+	constexpr Uint32 threadsNum = 4u;
+	constexpr Uint32 stringsNum = 1u << 17;
+
+	lib::DynamicArray<std::thread> threads;
+	lib::DynamicArray<Uint32> errorsNum(threadsNum, 0u);
+
+	for (Uint32 threadIdx = 0u; threadIdx < threadsNum; ++threadIdx)
+	{
+		threads.emplace_back([threadIdx, &errorsNum]
+							 {
+								 for (Uint32 idx = 0u; idx < stringsNum; ++idx)
+								 {
+									 const lib::String string = priv::CreateTestString("ConcurrencyTest_", idx);
+
+									 StringView view;
+									 HashedStringDB::GetRecord(StringView(string), view);
+
+									 if (view != string)
+									 {
+										 ++errorsNum[threadIdx];
+									 }
+								 }
+							 });
+	}
+
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (Uint32 threadErrorsNum : errorsNum)
+	{
+		EXPECT_EQ(threadErrorsNum, 0u);
+	}
+}
+
+} // spt::lib::tests
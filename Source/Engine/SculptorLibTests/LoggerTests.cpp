@@ -0,0 +1,209 @@
+#include "gtest/gtest.h"
+#include "SculptorCoreTypes.h"
+#include "Logging/LogSinks.h"
+
+#include "spdlog/sinks/basic_file_sink.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <thread>
+
+
+namespace spt::lib::tests
+{
+
+namespace priv
+{
+
+class CapturingLogSink : public LogSink
+{
+public:
+
+	virtual void Write(const LogMessage& message) override
+	{
+		messages.emplace_back(message.text);
+	}
+
+	lib::DynamicArray<lib::String> messages;
+};
+
+
+template<typename TCallable>
+Real64 MeasureLoggingTimeMs(TCallable&& callable)
+{
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+	callable();
+	return std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+}
+
+
+template<typename TLogFunction>
+Real64 MeasureWorkersLoggingTimeMs(Uint32 workersNum, Uint32 messagesPerWorker, TLogFunction&& logFunction)
+{
+	return MeasureLoggingTimeMs([&]
+								{
+									lib::DynamicArray<std::thread> workers;
+									for (Uint32 workerIdx = 0u; workerIdx < workersNum; ++workerIdx)
+									{
+										workers.emplace_back([workerIdx, messagesPerWorker, &logFunction]
+															 {
+																 for (Uint32 messageIdx = 0u; messageIdx < messagesPerWorker; ++messageIdx)
+																 {
+																	 logFunction(workerIdx, messageIdx);
+																 }
+															 });
+									}
+
+									for (std::thread& worker : workers)
+									{
+										worker.join();
+									}
+								});
+}
+
+} // priv
+
+TEST(LoggerTests, MessagesFromMultipleThreads)
+{
+	constexpr Uint32 workersNum        = 4u;
+	constexpr Uint32 messagesPerWorker = 10000u;
+
+	const std::shared_ptr<priv::CapturingLogSink> sink = std::make_shared<priv::CapturingLogSink>();
+
+	Logger logger;
+	logger.AddSink(sink);
+
+	priv::MeasureWorkersLoggingTimeMs(workersNum, messagesPerWorker,
+									  [&logger](Uint32 workerIdx, Uint32 messageIdx)
+									  {
+										  logger.Log("LoggerTests", ELogLevel::Info, "{} {} {}", workerIdx, messageIdx, lib::String("payload"));
+									  });
+
+	logger.Flush();
+
+	ASSERT_EQ(sink->messages.size(), workersNum * messagesPerWorker);
+
+	// Messages from one thread must be written in order
+	lib::DynamicArray<Uint32> nextMessageIdx(workersNum, 0u);
+	for (const lib::String& message : sink->messages)
+	{
+		Uint32 workerIdx  = 0u;
+		Uint32 messageIdx = 0u;
+		char payload[16] = {};
+		ASSERT_EQ(std::sscanf(message.c_str(), "%u %u %15s", &workerIdx, &messageIdx, payload), 3);
+		ASSERT_LT(workerIdx, workersNum);
+		EXPECT_EQ(messageIdx, nextMessageIdx[workerIdx]++);
+		EXPECT_STREQ(payload, "payload");
+	}
+}
+
+TEST(LoggerTests, MessagesWithoutArguments)
+{
+	const std::shared_ptr<priv::CapturingLogSink> sink = std::make_shared<priv::CapturingLogSink>();
+
+	Logger logger;
+	logger.AddSink(sink);
+
+	const lib::String dynamicMessage = "Dynamic {}";
+
+	logger.Log("LoggerTests", ELogLevel::Info, "Literal {}");
+	logger.Log("LoggerTests", ELogLevel::Warn, dynamicMessage);
+	logger.Log("LoggerTests", ELogLevel::Error, dynamicMessage.c_str());
+	logger.Log("LoggerTests", ELogLevel::Info, "{:.2f} {}", 1.5f, true);
+
+	logger.Flush();
+
+	ASSERT_EQ(sink->messages.size(), 4u);
+	EXPECT_EQ(sink->messages[0], "Literal {}");
+	EXPECT_EQ(sink->messages[1], "Dynamic {}");
+	EXPECT_EQ(sink->messages[2], "Dynamic {}");
+	EXPECT_EQ(sink->messages[3], "1.50 true");
+}
+
+TEST(LoggerTests, InvalidArgumentsWriteFallbackMessage)
+{
+	const std::shared_ptr<priv::CapturingLogSink> sink = std::make_shared<priv::CapturingLogSink>();
+
+	Logger logger;
+	logger.AddSink(sink);
+
+	// Dynamic width is validated only when message is formatted
+	logger.Log("LoggerTests", ELogLevel::Info, "{:{}}", 1, -1);
+	logger.Log("LoggerTests", ELogLevel::Info, "{}", 2);
+
+	logger.Flush();
+
+	ASSERT_EQ(sink->messages.size(), 2u);
+	EXPECT_NE(sink->messages[0].find("Failed to format log message"), lib::String::npos);
+	EXPECT_EQ(sink->messages[1], "2");
+}
+
+TEST(LoggerTests, AsyncVsSpdlogBenchmark)
+{
+	constexpr Uint32 messagesNum       = 200000u;
+	constexpr Uint32 workersNum        = 8u;
+	constexpr Uint32 messagesPerWorker = 50000u;
+
+	const std::filesystem::path tempDirectory = std::filesystem::temp_directory_path();
+	const lib::String spdlogFilePath = (tempDirectory / "SculptorLoggerBenchmark_Spdlog.log").string();
+	const lib::String asyncFilePath  = (tempDirectory / "SculptorLoggerBenchmark_Async.log").string();
+
+	// Previous logging path - message is formatted and written on calling thread
+	spdlog::logger spdlogLogger("Benchmark", std::make_shared<spdlog::sinks::basic_file_sink_mt>(spdlogFilePath, true));
+	spdlogLogger.set_level(spdlog::level::trace);
+
+	Logger asyncLogger;
+	asyncLogger.AddSink(CreateFileLogSink(asyncFilePath));
+
+	const lib::String payload = "payload";
+
+	const Real64 spdlogLatencyMs = priv::MeasureLoggingTimeMs([&]
+															  {
+																  for (Uint32 messageIdx = 0u; messageIdx < messagesNum; ++messageIdx)
+																  {
+																	  spdlogLogger.info("Message {} value {:.3f} {}", messageIdx, static_cast<Real32>(messageIdx) * 0.5f, payload);
+																  }
+															  });
+
+	const Real64 asyncLatencyMs = priv::MeasureLoggingTimeMs([&]
+															 {
+																 for (Uint32 messageIdx = 0u; messageIdx < messagesNum; ++messageIdx)
+																 {
+																	 asyncLogger.Log("Benchmark", ELogLevel::Info, "Message {} value {:.3f} {}", messageIdx, static_cast<Real32>(messageIdx) * 0.5f, payload);
+																 }
+															 });
+
+	const Real64 asyncFlushMs = priv::MeasureLoggingTimeMs([&] { asyncLogger.Flush(); });
+
+	const Real64 spdlogWorkersMs = priv::MeasureWorkersLoggingTimeMs(workersNum, messagesPerWorker,
+																	 [&](Uint32 workerIdx, Uint32 messageIdx)
+																	 {
+																		 spdlogLogger.info("Worker {} message {} {}", workerIdx, messageIdx, payload);
+																	 });
+
+	const Real64 asyncWorkersMs = priv::MeasureWorkersLoggingTimeMs(workersNum, messagesPerWorker,
+																	[&](Uint32 workerIdx, Uint32 messageIdx)
+																	{
+																		asyncLogger.Log("Benchmark", ELogLevel::Info, "Worker {} message {} {}", workerIdx, messageIdx, payload);
+																	});
+
+	asyncLogger.Flush();
+	spdlogLogger.flush();
+
+	const Real64 spdlogLatencyNs = spdlogLatencyMs * 1000000.0 / messagesNum;
+	const Real64 asyncLatencyNs  = asyncLatencyMs * 1000000.0 / messagesNum;
+
+	const Real64 workersMessagesNum = static_cast<Real64>(workersNum) * messagesPerWorker;
+	const Real64 spdlogThroughput   = workersMessagesNum / (spdlogWorkersMs / 1000.0);
+	const Real64 asyncThroughput    = workersMessagesNum / (asyncWorkersMs / 1000.0);
+
+	RecordProperty("SpdlogLatencyNs",   std::to_string(spdlogLatencyNs));
+	RecordProperty("AsyncLatencyNs",    std::to_string(asyncLatencyNs));
+	RecordProperty("SpdlogWorkersMsgS", std::to_string(spdlogThroughput));
+	RecordProperty("AsyncWorkersMsgS",  std::to_string(asyncThroughput));
+	RecordProperty("AsyncFlushMs",      std::to_string(asyncFlushMs));
+	RecordProperty("SynchronousMsgNum", std::to_string(asyncLogger.GetSynchronousMessagesNum()));
+}
+
+} // spt::lib::tests
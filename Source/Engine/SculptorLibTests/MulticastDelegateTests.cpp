@@ -0,0 +1,255 @@
+#include "gtest/gtest.h"
+#include "SculptorCoreTypes.h"
+#include "Delegates/MulticastDelegate.h"
+
+#include <chrono>
+#include <thread>
+
+
+namespace spt::lib::tests
+{
+
+namespace priv
+{
+
+/** Previous implementation of thread safe multicast delegate - every operation (including broadcast) takes the same lock */
+template<typename... TArgs>
+class LockedMulticastDelegate
+{
+public:
+
+	template<typename TLambda>
+	DelegateHandle AddLambda(TLambda&& callable)
+	{
+		const lib::LockGuard lockGuard(m_lock);
+		return m_delegate.AddLambda(std::forward<TLambda>(callable));
+	}
+
+	void Unbind(DelegateHandle handle)
+	{
+		const lib::LockGuard lockGuard(m_lock);
+		m_delegate.Unbind(handle);
+	}
+
+	void Broadcast(TArgs... arguments)
+	{
+		const lib::LockGuard lockGuard(m_lock);
+		m_delegate.Broadcast(arguments...);
+	}
+
+private:
+
+	lib::RecursiveLock                     m_lock;
+	lib::MulticastDelegate<void(TArgs...)> m_delegate;
+};
+
+
+/** Small amount of work that doesn't touch shared memory, so broadcasts from different threads could run in parallel */
+static void SimulateListenerWork(Uint32 value)
+{
+	thread_local Uint64 state = 0u;
+
+	for (Uint32 idx = 0u; idx < 16u; ++idx)
+	{
+		state = state * 6364136223846793005u + value;
+	}
+}
+
+
+/** Many threads broadcast the delegate, while one thread binds and unbinds delegates from time to time */
+template<typename TDelegate>
+Real64 MeasureBroadcastsTimeMs(TDelegate& delegate, Uint32 broadcastersNum, Uint32 broadcastsNum)
+{
+	for (Uint32 idx = 0u; idx < 4u; ++idx)
+	{
+		delegate.AddLambda([](Uint32 value) { SimulateListenerWork(value); });
+	}
+
+	std::atomic<Bool> broadcastsFinished = false;
+
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+
+	std::thread binder([&]
+					   {
+						   while (!broadcastsFinished.load())
+						   {
+							   const DelegateHandle handle = delegate.AddLambda([](Uint32) {});
+							   std::this_thread::sleep_for(std::chrono::microseconds(50));
+							   delegate.Unbind(handle);
+						   }
+					   });
+
+	lib::DynamicArray<std::thread> broadcasters;
+	for (Uint32 broadcasterIdx = 0u; broadcasterIdx < broadcastersNum; ++broadcasterIdx)
+	{
+		broadcasters.emplace_back([&delegate, broadcastsNum]
+								  {
+									  for (Uint32 idx = 0u; idx < broadcastsNum; ++idx)
+									  {
+										  delegate.Broadcast(1u);
+									  }
+								  });
+	}
+
+	for (std::thread& broadcaster : broadcasters)
+	{
+		broadcaster.join();
+	}
+
+	const Real64 timeMs = std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+
+	broadcastsFinished = true;
+	binder.join();
+
+	return timeMs;
+}
+
+} // priv
+
+TEST(ThreadSafeMulticastDelegateTests, BroadcastsAndUnbinds)
+{
+	ThreadSafeMulticastDelegate<void(Uint32)> delegate;
+
+	Uint32 sum = 0u;
+
+	const DelegateHandle first  = delegate.AddLambda([&sum](Uint32 value) { sum += value; });
+	const DelegateHandle second = delegate.AddLambda([&sum](Uint32 value) { sum += value * 10u; });
+
+	EXPECT_TRUE(delegate.IsBound());
+
+	delegate.Broadcast(1u);
+	EXPECT_EQ(sum, 11u);
+
+	delegate.Unbind(first);
+	delegate.Broadcast(1u);
+	EXPECT_EQ(sum, 21u);
+
+	delegate.Unbind(second);
+	EXPECT_FALSE(delegate.IsBound());
+
+	delegate.Broadcast(1u);
+	EXPECT_EQ(sum, 21u);
+}
+
+TEST(ThreadSafeMulticastDelegateTests, ModificationsDuringBroadcast)
+{
+	ThreadSafeMulticastDelegate<void()> delegate;
+
+	Uint32 firstCallsNum  = 0u;
+	Uint32 secondCallsNum = 0u;
+	Uint32 addedCallsNum  = 0u;
+
+	DelegateHandle secondHandle;
+
+	delegate.AddLambda([&]
+					   {
+						   ++firstCallsNum;
+						   if (secondHandle.IsValid())
+						   {
+							   // Unbound delegate must not be executed by current broadcast
+							   delegate.Unbind(secondHandle);
+							   secondHandle.Reset();
+
+							   // Added delegate is executed starting from next broadcast
+							   delegate.AddLambda([&addedCallsNum] { ++addedCallsNum; });
+						   }
+					   });
+
+	secondHandle = delegate.AddLambda([&secondCallsNum] { ++secondCallsNum; });
+
+	delegate.Broadcast();
+	EXPECT_EQ(firstCallsNum, 1u);
+	EXPECT_EQ(secondCallsNum, 0u);
+	EXPECT_EQ(addedCallsNum, 0u);
+
+	delegate.Broadcast();
+	EXPECT_EQ(firstCallsNum, 2u);
+	EXPECT_EQ(secondCallsNum, 0u);
+	EXPECT_EQ(addedCallsNum, 1u);
+}
+
+TEST(ThreadSafeMulticastDelegateTests, ResetAndBroadcastExecutesDelegatesOnce)
+{
+	ThreadSafeMulticastDelegate<void()> delegate;
+
+	Uint32 callsNum = 0u;
+	delegate.AddLambda([&callsNum] { ++callsNum; });
+	delegate.AddLambda([&callsNum] { ++callsNum; });
+
+	delegate.ResetAndBroadcast();
+	delegate.ResetAndBroadcast();
+	delegate.Broadcast();
+
+	EXPECT_EQ(callsNum, 2u);
+	EXPECT_FALSE(delegate.IsBound());
+}
+
+TEST(ThreadSafeMulticastDelegateTests, ConcurrentBroadcastsAndBinds)
+{
+	constexpr Uint32 broadcastersNum = 6u;
+	constexpr Uint32 binderIterations = 2000u;
+
+	ThreadSafeMulticastDelegate<void(Uint32)> delegate;
+
+	std::atomic<Uint64> permanentCallsNum = 0u;
+	delegate.AddLambda([&permanentCallsNum](Uint32) { permanentCallsNum.fetch_add(1u); });
+
+	std::atomic<Bool> bindsFinished = false;
+	std::atomic<Uint64> broadcastsNum = 0u;
+
+	lib::DynamicArray<std::thread> broadcasters;
+	for (Uint32 idx = 0u; idx < broadcastersNum; ++idx)
+	{
+		broadcasters.emplace_back([&]
+								  {
+									  while (!bindsFinished.load())
+									  {
+										  delegate.Broadcast(1u);
+										  broadcastsNum.fetch_add(1u);
+									  }
+								  });
+	}
+
+	std::thread binder([&]
+					   {
+						   for (Uint32 idx = 0u; idx < binderIterations; ++idx)
+						   {
+							   // Shared payload is released only when no broadcast can use the delegate anymore
+							   lib::SharedPtr<Uint32> payload = std::make_shared<Uint32>(idx);
+							   const DelegateHandle handle = delegate.AddLambda([payload](Uint32) { SPT_CHECK(*payload != idxNone<Uint32>); });
+							   delegate.Unbind(handle);
+						   }
+
+						   bindsFinished = true;
+					   });
+
+	binder.join();
+
+	for (std::thread& broadcaster : broadcasters)
+	{
+		broadcaster.join();
+	}
+
+	EXPECT_EQ(permanentCallsNum.load(), broadcastsNum.load());
+}
+
+TEST(ThreadSafeMulticastDelegateTests, SnapshotVsLockedBroadcastBenchmark)
+{
+	constexpr Uint32 broadcastersNum = 8u;
+	constexpr Uint32 broadcastsNum   = 200000u;
+
+	priv::LockedMulticastDelegate<Uint32> lockedDelegate;
+	ThreadSafeMulticastDelegate<void(Uint32)> snapshotDelegate;
+
+	const Real64 lockedMs   = priv::MeasureBroadcastsTimeMs(lockedDelegate, broadcastersNum, broadcastsNum);
+	const Real64 snapshotMs = priv::MeasureBroadcastsTimeMs(snapshotDelegate, broadcastersNum, broadcastsNum);
+
+	const Real64 totalBroadcastsNum = static_cast<Real64>(broadcastersNum) * broadcastsNum;
+
+	RecordProperty("LockedMs",               std::to_string(lockedMs));
+	RecordProperty("SnapshotMs",             std::to_string(snapshotMs));
+	RecordProperty("LockedNsPerBroadcast",   std::to_string(lockedMs * 1000000.0 / totalBroadcastsNum));
+	RecordProperty("SnapshotNsPerBroadcast", std::to_string(snapshotMs * 1000000.0 / totalBroadcastsNum));
+}
+
+} // spt::lib::tests
@@ -0,0 +1,129 @@
+#include "gtest/gtest.h"
+#include "Utility/Noise.h"
+
+#include <chrono>
+
+
+namespace spt::lib::tests
+{
+
+namespace priv
+{
+
+lib::DynamicArray<math::Vector3f> CreateVolumeCoords(Uint32 resolution)
+{
+	lib::DynamicArray<math::Vector3f> coords;
+	coords.reserve(static_cast<SizeType>(resolution) * resolution * resolution);
+
+	const Real32 rcpResolution = 1.f / static_cast<Real32>(resolution);
+
+	for (Uint32 z = 0u; z < resolution; ++z)
+	{
+		for (Uint32 y = 0u; y < resolution; ++y)
+		{
+			for (Uint32 x = 0u; x < resolution; ++x)
+			{
+				coords.emplace_back((math::Vector3f(static_cast<Real32>(x), static_cast<Real32>(y), static_cast<Real32>(z)) + math::Vector3f::Constant(0.5f)) * rcpResolution);
+			}
+		}
+	}
+
+	return coords;
+}
+
+template<typename TCallable>
+Real64 MeasureTimeMs(TCallable&& callable)
+{
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+	callable();
+	return std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+}
+
+} // priv
+
+TEST(NoiseTests, BatchedNoiseMatchesScalarImplementation)
+{
+	// Odd number of coordinates, so that last batch is partial
+	lib::DynamicArray<math::Vector3f> coords = priv::CreateVolumeCoords(17u);
+
+	lib::DynamicArray<Real32> scalarValues(coords.size());
+	lib::DynamicArray<Real32> bestValues(coords.size());
+
+	noise::GenerateTileableWorleyNoise3DBatch(coords, 8.f, scalarValues, noise::EBatchNoiseImpl::Scalar);
+	noise::GenerateTileableWorleyNoise3DBatch(coords, 8.f, bestValues, noise::EBatchNoiseImpl::Best);
+
+	for (SizeType idx = 0u; idx < coords.size(); ++idx)
+	{
+		EXPECT_NEAR(scalarValues[idx], bestValues[idx], 1e-5f);
+		EXPECT_GE(bestValues[idx], 0.f);
+		EXPECT_LE(bestValues[idx], 1.f);
+	}
+
+	noise::GenerateTileablePerlinNoise3DBatch(coords, 8.f, 3, scalarValues, noise::EBatchNoiseImpl::Scalar);
+	noise::GenerateTileablePerlinNoise3DBatch(coords, 8.f, 3, bestValues, noise::EBatchNoiseImpl::Best);
+
+	for (SizeType idx = 0u; idx < coords.size(); ++idx)
+	{
+		EXPECT_NEAR(scalarValues[idx], bestValues[idx], 1e-5f);
+		EXPECT_GE(bestValues[idx], 0.f);
+		EXPECT_LE(bestValues[idx], 1.f);
+	}
+}
+
+TEST(NoiseTests, BatchedNoiseIsTileable)
+{
+	const lib::DynamicArray<math::Vector3f> coords =
+	{
+		math::Vector3f(0.1f, 0.3f, 0.7f),
+		math::Vector3f(0.9f, 0.2f, 0.4f),
+		math::Vector3f(0.5f, 0.5f, 0.5f)
+	};
+
+	lib::DynamicArray<math::Vector3f> offsetCoords;
+	for (const math::Vector3f& coord : coords)
+	{
+		offsetCoords.emplace_back(coord + math::Vector3f(1.f, 2.f, 1.f));
+	}
+
+	lib::DynamicArray<Real32> values(coords.size());
+	lib::DynamicArray<Real32> offsetValues(coords.size());
+
+	noise::GenerateTileableWorleyNoise3DBatch(coords, 4.f, values);
+	noise::GenerateTileableWorleyNoise3DBatch(offsetCoords, 4.f, offsetValues);
+
+	for (SizeType idx = 0u; idx < coords.size(); ++idx)
+	{
+		EXPECT_NEAR(values[idx], offsetValues[idx], 1e-4f);
+	}
+
+	noise::GenerateTileablePerlinNoise3DBatch(coords, 4.f, 3, values);
+	noise::GenerateTileablePerlinNoise3DBatch(offsetCoords, 4.f, 3, offsetValues);
+
+	for (SizeType idx = 0u; idx < coords.size(); ++idx)
+	{
+		EXPECT_NEAR(values[idx], offsetValues[idx], 1e-4f);
+	}
+}
+
+TEST(NoiseTests, ScalarVsSIMDBenchmark)
+{
+	constexpr Uint32 resolution = 64u;
+
+	const lib::DynamicArray<math::Vector3f> coords = priv::CreateVolumeCoords(resolution);
+
+	lib::DynamicArray<Real32> values(coords.size());
+
+	const Real64 worleyScalarMs = priv::MeasureTimeMs([&] { noise::GenerateTileableWorleyNoise3DBatch(coords, 16.f, values, noise::EBatchNoiseImpl::Scalar); });
+	const Real64 worleySIMDMs   = priv::MeasureTimeMs([&] { noise::GenerateTileableWorleyNoise3DBatch(coords, 16.f, values, noise::EBatchNoiseImpl::Best); });
+
+	const Real64 perlinScalarMs = priv::MeasureTimeMs([&] { noise::GenerateTileablePerlinNoise3DBatch(coords, 8.f, 3, values, noise::EBatchNoiseImpl::Scalar); });
+	const Real64 perlinSIMDMs   = priv::MeasureTimeMs([&] { noise::GenerateTileablePerlinNoise3DBatch(coords, 8.f, 3, values, noise::EBatchNoiseImpl::Best); });
+
+	RecordProperty("WorleyScalarMs", std::to_string(worleyScalarMs));
+	RecordProperty("WorleySIMDMs",   std::to_string(worleySIMDMs));
+	RecordProperty("PerlinScalarMs", std::to_string(perlinScalarMs));
+	RecordProperty("PerlinSIMDMs",   std::to_string(perlinSIMDMs));
+	RecordProperty("AVX2Supported",  noise::IsAVX2NoiseSupported() ? "true" : "false");
+}
+
+} // spt::lib::tests
@@ -0,0 +1,8 @@
+SculptorLibTests = Project:CreateProject("SculptorLibTests", ETargetType.Application)
+
+function SculptorLibTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("SculptorLib")
+    self:AddPrivateDependency("GoogleTest")
+end
+
+SculptorLibTests:SetupProject()
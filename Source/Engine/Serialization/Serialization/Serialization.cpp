@@ -84,8 +84,8 @@ void Serializer::Serialize(const char* name, lib::HashedString& value)
 	}
 	else
 	{
-		const lib::String str = GetImpl<lib::String>(name);
-		value = str.empty() ? lib::HashedString() : lib::HashedString(std::move(str));
+		const lib::StringView str = GetStringViewImpl(name);
+		value = str.empty() ? lib::HashedString() : lib::HashedString(str);
 	}
 }
 
@@ -97,7 +97,7 @@ void Serializer::Serialize(const char* name, lib::Path& value)
 	}
 	else
 	{
-		value = lib::Path(GetImpl<lib::String>(name));
+		value = lib::Path(GetStringViewImpl(name));
 	}
 }
 
@@ -109,9 +109,186 @@ void Serializer::Serialize(const char* name, lib::RuntimeTypeInfo& value)
 	}
 	else
 	{
-		const lib::HashedString typeName = GetImpl<lib::String>(name);
+		const lib::HashedString typeName = GetStringViewImpl(name);
 		value = lib::RuntimeTypeInfo::CreateFromName(typeName.GetView());
 	}
 }
 
+lib::DynamicArray<Byte> Serializer::ToBinary() const
+{
+	SPT_CHECK(IsBinary());
+
+	const binary::DocumentHeader header;
+
+	lib::DynamicArray<Byte> result(sizeof(binary::DocumentHeader) + m_binaryData.size());
+	std::memcpy(result.data(), &header, sizeof(binary::DocumentHeader));
+	std::memcpy(result.data() + sizeof(binary::DocumentHeader), m_binaryData.data(), m_binaryData.size());
+
+	return result;
+}
+
+void Serializer::WriteBinaryValue(const char* name, binary::ETag tag, const void* data, SizeType dataSize)
+{
+	SPT_CHECK(IsSaving());
+
+	const Uint32 nameHash = binary::HashFieldName(name);
+
+	const SizeType offset = m_binaryData.size();
+	m_binaryData.resize(offset + binary::fieldHeaderSize + dataSize);
+
+	Byte* dst = m_binaryData.data() + offset;
+	std::memcpy(dst, &nameHash, sizeof(Uint32));
+	std::memcpy(dst + sizeof(Uint32), &tag, sizeof(binary::ETag));
+	std::memcpy(dst + binary::fieldHeaderSize, data, dataSize);
+}
+
+void Serializer::WriteBinaryBlob(const char* name, binary::ETag tag, lib::Span<const Byte> data)
+{
+	SPT_CHECK(IsSaving());
+	SPT_CHECK(data.size() <= maxValue<Uint32>);
+
+	const Uint32 nameHash = binary::HashFieldName(name);
+	const Uint32 blobSize = static_cast<Uint32>(data.size());
+
+	const SizeType offset = m_binaryData.size();
+	m_binaryData.resize(offset + binary::fieldHeaderSize + sizeof(Uint32) + data.size());
+
+	Byte* dst = m_binaryData.data() + offset;
+	std::memcpy(dst, &nameHash, sizeof(Uint32));
+	std::memcpy(dst + sizeof(Uint32), &tag, sizeof(binary::ETag));
+	std::memcpy(dst + binary::fieldHeaderSize, &blobSize, sizeof(Uint32));
+	if (!data.empty())
+	{
+		std::memcpy(dst + binary::fieldHeaderSize + sizeof(Uint32), data.data(), data.size());
+	}
+}
+
+void Serializer::WriteBinaryArrayItems(const char* name, Uint32 itemsNum, lib::Span<const Byte> items)
+{
+	lib::DynamicArray<Byte> arrayBlob(sizeof(Uint32) + items.size());
+	std::memcpy(arrayBlob.data(), &itemsNum, sizeof(Uint32));
+	if (!items.empty())
+	{
+		std::memcpy(arrayBlob.data() + sizeof(Uint32), items.data(), items.size());
+	}
+
+	WriteBinaryBlob(name, binary::ETag::Array, arrayBlob);
+}
+
+lib::Span<const Byte> Serializer::ReadBinaryBlob(const char* name, binary::ETag tag)
+{
+	const lib::Span<const Byte> field = FindBinaryField(name);
+	if (field.empty())
+	{
+		return {};
+	}
+
+	binary::ETag fieldTag;
+	std::memcpy(&fieldTag, field.data() + sizeof(Uint32), sizeof(binary::ETag));
+
+	if (fieldTag != tag)
+	{
+		return {};
+	}
+
+	return field.subspan(binary::fieldHeaderSize + sizeof(Uint32));
+}
+
+Uint32 Serializer::GetBinaryArraySize(const char* name)
+{
+	const SizeType cursor = m_binaryCursor;
+
+	const lib::Span<const Byte> arrayBlob = ReadBinaryBlob(name, binary::ETag::Array);
+
+	m_binaryCursor = cursor;
+
+	return arrayBlob.size() >= sizeof(Uint32) ? ReadBinaryPOD<Uint32>(arrayBlob.data()) : 0u;
+}
+
+lib::Span<const Byte> Serializer::FindBinaryField(const char* name)
+{
+	SPT_CHECK(IsLoading());
+
+	const Uint32 nameHash = binary::HashFieldName(name);
+
+	const auto findInRange = [this, nameHash](SizeType begin, SizeType end) -> lib::Span<const Byte>
+	{
+		SizeType offset = begin;
+		while (offset < end)
+		{
+			const SizeType fieldSize = GetBinaryFieldSize(m_binaryView, offset);
+			if (fieldSize == 0u)
+			{
+				break;
+			}
+
+			if (ReadBinaryPOD<Uint32>(m_binaryView.data() + offset) == nameHash)
+			{
+				m_binaryCursor = offset + fieldSize;
+				return m_binaryView.subspan(offset, fieldSize);
+			}
+
+			offset += fieldSize;
+		}
+
+		return {};
+	};
+
+	// Fields are usually read in the order in which they were written, so start from the field after the last one that was read
+	const SizeType cursor = m_binaryCursor;
+
+	lib::Span<const Byte> field = findInRange(cursor, m_binaryView.size());
+	if (field.empty() && cursor > 0u)
+	{
+		field = findInRange(0u, cursor);
+	}
+
+	return field;
+}
+
+SizeType Serializer::GetBinaryFieldSize(lib::Span<const Byte> data, SizeType offset)
+{
+	if (offset + binary::fieldHeaderSize > data.size())
+	{
+		return 0u;
+	}
+
+	binary::ETag tag;
+	std::memcpy(&tag, data.data() + offset + sizeof(Uint32), sizeof(binary::ETag));
+
+	SizeType payloadSize = 0u;
+
+	switch (tag)
+	{
+	case binary::ETag::Bool:
+		payloadSize = sizeof(Uint8);
+		break;
+	case binary::ETag::Int32:
+	case binary::ETag::Uint32:
+	case binary::ETag::Real32:
+		payloadSize = sizeof(Uint32);
+		break;
+	case binary::ETag::Uint64:
+		payloadSize = sizeof(Uint64);
+		break;
+	case binary::ETag::String:
+	case binary::ETag::Object:
+	case binary::ETag::Array:
+	case binary::ETag::Bytes:
+		if (offset + binary::fieldHeaderSize + sizeof(Uint32) > data.size())
+		{
+			return 0u;
+		}
+		payloadSize = sizeof(Uint32) + ReadBinaryPOD<Uint32>(data.data() + offset + binary::fieldHeaderSize);
+		break;
+	default:
+		// Corrupted data
+		return 0u;
+	}
+
+	const SizeType fieldSize = binary::fieldHeaderSize + payloadSize;
+
+	return offset + fieldSize <= data.size() ? fieldSize : 0u;
+}
+
 } // spt::srl
@@ -4,6 +4,7 @@
 #include "SculptorLib/FileSystem/File.h"
 #include "nlohmann/json.hpp"
 #include "Utility/Base64.h"
+#include "Utility/Hash.h"
 
 
 namespace spt::srl
@@ -30,6 +31,62 @@ concept CSerializableEnum = std::is_enum_v<TType>;
 using JSON =  nlohmann::json;
 
 
+enum class ESerializationFormat : Uint8
+{
+	/** Human readable format. Used for editable source data */
+	JSON,
+	/** Compact tagged binary format. Used for compiled and cooked data */
+	Binary
+};
+
+
+/**
+ * Binary format stores objects as sequences of tagged fields: [name hash (Uint32)][tag (Uint8)][payload].
+ * Variable sized payloads (strings, objects, arrays, bytes) are prefixed with their size, so readers can skip unknown fields.
+ * Readers don't build any intermediate structures - they are views over serialized data.
+ * Fields are usually read in the same order in which they were written, so field lookup starts from the last read field
+ */
+namespace binary
+{
+
+enum class ETag : Uint8
+{
+	Bool,
+	Int32,
+	Uint32,
+	Uint64,
+	Real32,
+	String,
+	Object,
+	Array,
+	Bytes
+};
+
+static constexpr Uint32 magic   = 0x42545053u; // "SPTB"
+static constexpr Uint32 version = 1u;
+
+struct DocumentHeader
+{
+	Uint32 magic   = binary::magic;
+	Uint32 version = binary::version;
+};
+
+static constexpr SizeType fieldHeaderSize = sizeof(Uint32) + sizeof(ETag);
+
+inline Uint32 HashFieldName(const char* name)
+{
+	if (!name)
+	{
+		return 0u;
+	}
+
+	const SizeType hash = lib::FNV1a::Hash({ name, std::strlen(name) });
+	return static_cast<Uint32>(hash ^ (hash >> 32u));
+}
+
+} // binary
+
+
 class Serializer
 {
 public:
@@ -39,6 +96,11 @@ public:
 		return Serializer();
 	}
 
+	static Serializer CreateBinaryWriter()
+	{
+		return Serializer(ESerializationFormat::Binary);
+	}
+
 	static Serializer CreateReader(const lib::String& data)
 	{
 		return Serializer(data);
@@ -51,12 +113,41 @@ public:
 
 	static Serializer CreateReader(JSON j)
 	{
-		return Serializer(j);
+		return Serializer(std::move(j));
+	}
+
+	/** Data must outlive the reader. Reader created from data with invalid header or version is not valid and reads only default values */
+	static Serializer CreateBinaryReader(lib::Span<const Byte> data)
+	{
+		if (!IsBinaryData(data))
+		{
+			return Serializer(lib::Span<const Byte>{}, false);
+		}
+
+		return Serializer(data.subspan(sizeof(binary::DocumentHeader)), true);
+	}
+
+	/** Returns true if data starts with header of the current version of binary format */
+	static Bool IsBinaryData(lib::Span<const Byte> data)
+	{
+		if (data.size() < sizeof(binary::DocumentHeader))
+		{
+			return false;
+		}
+
+		binary::DocumentHeader header;
+		std::memcpy(&header, data.data(), sizeof(binary::DocumentHeader));
+		return header.magic == binary::magic && header.version == binary::version;
 	}
 
 	Bool IsSaving() const { return m_isSaving; }
 	Bool IsLoading() const { return !IsSaving(); }
 
+	ESerializationFormat GetFormat() const { return m_format; }
+	Bool IsBinary() const { return m_format == ESerializationFormat::Binary; }
+
+	Bool IsValid() const { return m_isValid; }
+
 	void Serialize(const char* name, Bool& value);
 	void Serialize(const char* name, Int32& value);
 	void Serialize(const char* name, Uint32& value);
@@ -72,16 +163,29 @@ public:
 	template<detail::CSerializableIntrusive TDataType>
 	void Serialize(const char* name, TDataType& value)
 	{
-		if (IsSaving())
+		if (IsBinary())
+		{
+			if (IsSaving())
+			{
+				Serializer subWriter = Serializer::CreateBinaryWriter();
+				value.Serialize(subWriter);
+				WriteBinaryBlob(name, binary::ETag::Object, subWriter.m_binaryData);
+			}
+			else
+			{
+				Serializer subReader(ReadBinaryBlob(name, binary::ETag::Object), m_isValid);
+				value.Serialize(subReader);
+			}
+		}
+		else if (IsSaving())
 		{
 			Serializer subWriter = Serializer::CreateWriter();
 			value.Serialize(subWriter);
-			m_json[name] = subWriter.GetJson();
+			SetJson(name, std::move(subWriter.m_json));
 		}
 		else
 		{
-			JSON subJson = m_json[name];
-			Serializer subReader = Serializer::CreateReader(subJson);
+			Serializer subReader = CreateSubReader(FindJson(name));
 			value.Serialize(subReader);
 		}
 	}
@@ -96,7 +200,27 @@ public:
 	template<typename TType, int Rows, int Cols>
 	void Serialize(const char* name, math::Matrix<TType, Rows, Cols>& data)
 	{
-		if (IsSaving())
+		if (IsBinary())
+		{
+			// Matrices are stored as raw column major data
+			if (IsSaving())
+			{
+				WriteBinaryBlob(name, binary::ETag::Bytes, lib::Span<const Byte>(reinterpret_cast<const Byte*>(data.data()), sizeof(TType) * Rows * Cols));
+			}
+			else
+			{
+				const lib::Span<const Byte> blob = ReadBinaryBlob(name, binary::ETag::Bytes);
+				if (blob.size() == sizeof(TType) * Rows * Cols)
+				{
+					std::memcpy(data.data(), blob.data(), blob.size());
+				}
+				else
+				{
+					data = {};
+				}
+			}
+		}
+		else if (IsSaving())
 		{
 			nlohmann::json jsonArray = nlohmann::json::array();
 			for (int i = 0; i < Cols; ++i)
@@ -106,21 +230,20 @@ public:
 					jsonArray.push_back(data(j, i));
 				}
 			}
-			m_json[name] = jsonArray;
+			SetJson(name, std::move(jsonArray));
 		}
 		else
 		{
 			Bool loaded = false;
-			if (m_json.contains(name))
+			if (const JSON* jsonArray = FindJson(name))
 			{
-				JSON jsonArray = m_json[name];
-				if (jsonArray.size() == Cols * Rows)
+				if (jsonArray->is_array() && jsonArray->size() == Cols * Rows)
 				{
 					for (int i = 0; i < Cols; ++i)
 					{
 						for (int j = 0; j < Rows; ++j)
 						{
-							data(j, i) = jsonArray[i * Rows + j].get<TType>();
+							data(j, i) = (*jsonArray)[i * Rows + j].get<TType>();
 						}
 					}
 
@@ -138,7 +261,26 @@ public:
 	template<typename TDataType, SizeType N>
 	void Serialize(const char* name, lib::InlineDynamicArray<TDataType, N>& dataArray)
 	{
-		if (IsSaving())
+		if (IsBinary())
+		{
+			if (IsSaving())
+			{
+				WriteBinaryArray(name, dataArray);
+			}
+			else
+			{
+				dataArray.Clear();
+
+				ReadBinaryArray(name,
+								[&dataArray](Serializer& itemReader)
+								{
+									TDataType item{};
+									itemReader.Serialize(nullptr, item);
+									dataArray.EmplaceBack(std::move(item));
+								});
+			}
+		}
+		else if (IsSaving())
 		{
 			JSON jsonArray = JSON::array();
 
@@ -147,16 +289,18 @@ public:
 				jsonArray.push_back(ToJSON(item));
 			}
 
-			m_json[name] = jsonArray;
+			SetJson(name, std::move(jsonArray));
 		}
 		else
 		{
-			const JSON jsonArray = m_json[name];
 			dataArray.Clear();
 
-			for (const auto& itemJson : jsonArray)
+			if (const JSON* jsonArray = FindJsonArray(name))
 			{
-				dataArray.EmplaceBack(FromJSON<TDataType>(itemJson));
+				for (const JSON& itemJson : *jsonArray)
+				{
+					dataArray.EmplaceBack(FromJSON<TDataType>(itemJson));
+				}
 			}
 		}
 	}
@@ -164,7 +308,27 @@ public:
 	template<typename TDataType, SizeType N>
 	void Serialize(const char* name, lib::StaticArray<TDataType, N>& dataArray)
 	{
-		if (IsSaving())
+		if (IsBinary())
+		{
+			if (IsSaving())
+			{
+				WriteBinaryArray(name, dataArray);
+			}
+			else
+			{
+				SizeType itemIdx = 0u;
+
+				ReadBinaryArray(name,
+								[&dataArray, &itemIdx](Serializer& itemReader)
+								{
+									if (itemIdx < N)
+									{
+										itemReader.Serialize(nullptr, dataArray[itemIdx++]);
+									}
+								});
+			}
+		}
+		else if (IsSaving())
 		{
 			JSON jsonArray = JSON::array();
 
@@ -173,15 +337,16 @@ public:
 				jsonArray.push_back(ToJSON(item));
 			}
 
-			m_json[name] = jsonArray;
+			SetJson(name, std::move(jsonArray));
 		}
 		else
 		{
-			const JSON jsonArray = m_json[name];
-
-			for (SizeType i = 0; i < N && i < jsonArray.size(); ++i)
+			if (const JSON* jsonArray = FindJsonArray(name))
 			{
-				dataArray[i] = FromJSON<TDataType>(jsonArray[i]);
+				for (SizeType i = 0; i < N && i < jsonArray->size(); ++i)
+				{
+					dataArray[i] = FromJSON<TDataType>((*jsonArray)[i]);
+				}
 			}
 		}
 	}
@@ -189,7 +354,25 @@ public:
 	template<typename TDataType>
 	void Serialize(const char* name, lib::DynamicArray<TDataType>& dataArray)
 	{
-		if (IsSaving())
+		if (IsBinary())
+		{
+			if (IsSaving())
+			{
+				WriteBinaryArray(name, dataArray);
+			}
+			else
+			{
+				dataArray.clear();
+				dataArray.reserve(GetBinaryArraySize(name));
+
+				ReadBinaryArray(name,
+								[&dataArray](Serializer& itemReader)
+								{
+									itemReader.Serialize(nullptr, dataArray.emplace_back());
+								});
+			}
+		}
+		else if (IsSaving())
 		{
 			JSON jsonArray = JSON::array();
 
@@ -198,17 +381,20 @@ public:
 				jsonArray.push_back(ToJSON(item));
 			}
 
-			m_json[name] = jsonArray;
+			SetJson(name, std::move(jsonArray));
 		}
 		else
 		{
-			const JSON jsonArray = m_json[name];
 			dataArray.clear();
-			dataArray.reserve(jsonArray.size());
 
-			for (const auto& itemJson : jsonArray)
+			if (const JSON* jsonArray = FindJsonArray(name))
 			{
-				dataArray.emplace_back(FromJSON<TDataType>(itemJson));
+				dataArray.reserve(jsonArray->size());
+
+				for (const JSON& itemJson : *jsonArray)
+				{
+					dataArray.emplace_back(FromJSON<TDataType>(itemJson));
+				}
 			}
 		}
 	}
@@ -216,20 +402,74 @@ public:
 	template<>
 	void Serialize(const char* name, lib::DynamicArray<Byte>& dataArray)
 	{
-		if (IsSaving())
+		if (IsBinary())
 		{
-			m_json[name] = lib::EncodeBase64(dataArray);
+			if (IsSaving())
+			{
+				WriteBinaryBlob(name, binary::ETag::Bytes, dataArray);
+			}
+			else
+			{
+				const lib::Span<const Byte> blob = ReadBinaryBlob(name, binary::ETag::Bytes);
+				dataArray.assign(blob.begin(), blob.end());
+			}
+		}
+		else if (IsSaving())
+		{
+			SetJson(name, lib::EncodeBase64(dataArray));
 		}
 		else
 		{
-			dataArray = lib::DecodeBase64(m_json[name].get<lib::String>());
+			dataArray = lib::DecodeBase64(lib::String(GetStringViewImpl(name)));
 		}
 	}
 
 	template<typename TKeyType, typename TDataType>
 	void Serialize(const char* name, lib::HashMap<TKeyType, TDataType>& dataMap)
 	{
-		if (IsSaving())
+		if (IsBinary())
+		{
+			// Each entry is stored as two consecutive array items (key and value)
+			if (IsSaving())
+			{
+				Serializer itemsWriter = Serializer::CreateBinaryWriter();
+
+				for (auto& [key, value] : dataMap)
+				{
+					itemsWriter.Serialize(nullptr, const_cast<TKeyType&>(key));
+					itemsWriter.Serialize(nullptr, value);
+				}
+
+				WriteBinaryArrayItems(name, static_cast<Uint32>(dataMap.size() * 2u), itemsWriter.m_binaryData);
+			}
+			else
+			{
+				dataMap.clear();
+				dataMap.reserve(GetBinaryArraySize(name) / 2u);
+
+				TKeyType key{};
+				Bool isKey = true;
+
+				ReadBinaryArray(name,
+								[&dataMap, &key, &isKey](Serializer& itemReader)
+								{
+									if (isKey)
+									{
+										key = TKeyType{};
+										itemReader.Serialize(nullptr, key);
+									}
+									else
+									{
+										TDataType value{};
+										itemReader.Serialize(nullptr, value);
+										dataMap.emplace(std::move(key), std::move(value));
+									}
+
+									isKey = !isKey;
+								});
+			}
+		}
+		else if (IsSaving())
 		{
 			JSON jsonArray = JSON::array();
 
@@ -240,47 +480,69 @@ public:
 				elem.emplace_back(ToJSON<TKeyType>(const_cast<TKeyType&>(key)));
 				elem.emplace_back(ToJSON<TDataType>(value));
 
-				jsonArray.push_back(elem);
+				jsonArray.push_back(std::move(elem));
 			}
 
-			m_json[name] = jsonArray;
+			SetJson(name, std::move(jsonArray));
 		}
 		else
 		{
-			const JSON jsonArray = m_json[name];
-
 			dataMap.clear();
-			dataMap.reserve(jsonArray.size());
 
-			for (const auto& itemJson : jsonArray)
+			if (const JSON* jsonArray = FindJsonArray(name))
 			{
-				JSON keyJson   = itemJson[0];
-				JSON valueJson = itemJson[1];
+				dataMap.reserve(jsonArray->size());
 
-				TKeyType key = FromJSON<TKeyType>(keyJson);
-				TDataType value = FromJSON<TDataType>(valueJson);
+				for (const JSON& itemJson : *jsonArray)
+				{
+					if (!itemJson.is_array() || itemJson.size() != 2u)
+					{
+						continue;
+					}
 
-				dataMap.emplace(std::move(key), std::move(value));
+					TKeyType key = FromJSON<TKeyType>(itemJson[0]);
+					TDataType value = FromJSON<TDataType>(itemJson[1]);
+
+					dataMap.emplace(std::move(key), std::move(value));
+				}
 			}
 		}
 	}
 
 	lib::String ToCompactString() const
 	{
-		return m_json.dump();
+		SPT_CHECK(!IsBinary());
+		return GetReadJson().dump();
 	}
 
 	lib::String ToString() const
 	{
-		return m_json.dump(4);
+		SPT_CHECK(!IsBinary());
+		return GetReadJson().dump(4);
 	}
 
+	/** Returns binary document (header and serialized fields) */
+	lib::DynamicArray<Byte> ToBinary() const;
+
 protected:
 
 	explicit Serializer()
 		: m_isSaving(true)
 	{ }
 
+	explicit Serializer(ESerializationFormat format)
+		: m_isSaving(true)
+		, m_format(format)
+	{ }
+
+	/** Binary reader of serialized fields (without document header) */
+	explicit Serializer(lib::Span<const Byte> binaryFields, Bool isValid)
+		: m_isSaving(false)
+		, m_format(ESerializationFormat::Binary)
+		, m_isValid(isValid)
+		, m_binaryView(binaryFields)
+	{ }
+
 	explicit Serializer(const lib::String& data)
 		: m_json(JSON::parse(data))
 		, m_isSaving(false)
@@ -294,14 +556,63 @@ protected:
 	}
 
 	explicit Serializer(JSON j)
-		: m_json(j)
+		: m_json(std::move(j))
 		, m_isSaving(false)
 	{
 	}
 
-	JSON& GetJson()
+	/** Reader that walks node of parent reader's DOM by reference. Node must outlive the reader */
+	static Serializer CreateSubReader(const JSON* node)
 	{
-		return m_json;
+		static const JSON nullJson;
+
+		Serializer reader;
+		reader.m_isSaving = false;
+		reader.m_jsonView = node ? node : &nullJson;
+		return reader;
+	}
+
+	const JSON& GetReadJson() const
+	{
+		return m_jsonView ? *m_jsonView : m_json;
+	}
+
+	/** Returns node with given name or current node if name is null. Returns nullptr if node doesn't exist */
+	const JSON* FindJson(const char* name) const
+	{
+		const JSON& json = GetReadJson();
+
+		if (!name)
+		{
+			return &json;
+		}
+
+		if (!json.is_object())
+		{
+			return nullptr;
+		}
+
+		const auto it = json.find(name);
+		return it != json.cend() ? &(*it) : nullptr;
+	}
+
+	const JSON* FindJsonArray(const char* name) const
+	{
+		const JSON* json = FindJson(name);
+		return json && json->is_array() ? json : nullptr;
+	}
+
+	template<typename TData>
+	void SetJson(const char* name, TData&& data)
+	{
+		if (name)
+		{
+			m_json[name] = std::forward<TData>(data);
+		}
+		else
+		{
+			m_json = std::forward<TData>(data);
+		}
 	}
 
 	template<typename TDataType>
@@ -318,14 +629,14 @@ protected:
 			writer.Serialize(nullptr, const_cast<TDataType&>(data));
 		}
 
-		return writer.GetJson();
+		return std::move(writer.m_json);
 	}
 
 	template<typename TDataType>
 	TDataType FromJSON(const JSON& json)
 	{
 		TDataType data;
-		Serializer reader = Serializer::CreateReader(json);
+		Serializer reader = CreateSubReader(&json);
 
 		if constexpr (detail::CSerializableIntrusive<TDataType>)
 		{
@@ -342,32 +653,197 @@ protected:
 	template<typename TData>
 	void SetImpl(const char* name, const TData& data)
 	{
-		if (name)
+		if (IsBinary())
 		{
-			m_json[name] = data;
+			SetBinaryImpl(name, data);
 		}
 		else
 		{
-			m_json = data;
+			SetJson(name, data);
 		}
 	}
 
 	template<typename TData>
-	TData GetImpl(const char* name) const
+	TData GetImpl(const char* name)
 	{
-		if (name)
+		if (IsBinary())
+		{
+			return GetBinaryImpl<TData>(name);
+		}
+		else
+		{
+			const JSON* json = FindJson(name);
+			return json && !json->is_null() ? json->get<TData>() : TData{};
+		}
+	}
+
+	/** Returns view of string stored in serialized data (DOM or binary blob), so it's valid only as long as reader */
+	lib::StringView GetStringViewImpl(const char* name)
+	{
+		if (IsBinary())
+		{
+			const lib::Span<const Byte> blob = ReadBinaryBlob(name, binary::ETag::String);
+			return lib::StringView(reinterpret_cast<const char*>(blob.data()), blob.size());
+		}
+		else
+		{
+			const JSON* json = FindJson(name);
+			return json && json->is_string() ? lib::StringView(json->get_ref<const JSON::string_t&>()) : lib::StringView();
+		}
+	}
+
+	template<typename TData>
+	void SetBinaryImpl(const char* name, const TData& data)
+	{
+		if constexpr (std::is_same_v<TData, Bool>)
+		{
+			const Uint8 value = data ? 1u : 0u;
+			WriteBinaryValue(name, binary::ETag::Bool, &value, sizeof(Uint8));
+		}
+		else if constexpr (std::is_same_v<TData, Int32>)
+		{
+			WriteBinaryValue(name, binary::ETag::Int32, &data, sizeof(Int32));
+		}
+		else if constexpr (std::is_same_v<TData, Uint32>)
+		{
+			WriteBinaryValue(name, binary::ETag::Uint32, &data, sizeof(Uint32));
+		}
+		else if constexpr (std::is_same_v<TData, Real32>)
+		{
+			WriteBinaryValue(name, binary::ETag::Real32, &data, sizeof(Real32));
+		}
+		else if constexpr (std::is_integral_v<TData> && sizeof(TData) == sizeof(Uint64))
 		{
-			return m_json.contains(name) ? m_json[name].get<TData>() : TData{};
+			const Uint64 value = static_cast<Uint64>(data);
+			WriteBinaryValue(name, binary::ETag::Uint64, &value, sizeof(Uint64));
 		}
 		else
 		{
-			return m_json.get<TData>();
+			static_assert(std::is_same_v<TData, lib::String>, "Unsupported binary value type");
+			WriteBinaryBlob(name, binary::ETag::String, lib::Span<const Byte>(reinterpret_cast<const Byte*>(data.data()), data.size()));
 		}
 	}
 
-	JSON m_json;
+	template<typename TData>
+	TData GetBinaryImpl(const char* name)
+	{
+		const lib::Span<const Byte> field = FindBinaryField(name);
+		if (field.empty())
+		{
+			return TData{};
+		}
+
+		binary::ETag tag;
+		std::memcpy(&tag, field.data() + sizeof(Uint32), sizeof(binary::ETag));
+		const Byte* payload = field.data() + binary::fieldHeaderSize;
+
+		if constexpr (std::is_same_v<TData, lib::String>)
+		{
+			if (tag == binary::ETag::String)
+			{
+				return lib::String(reinterpret_cast<const char*>(payload + sizeof(Uint32)), field.size() - binary::fieldHeaderSize - sizeof(Uint32));
+			}
+
+			return TData{};
+		}
+		else
+		{
+			// Numeric values are converted, so that type of field may change without breaking compiled data
+			switch (tag)
+			{
+			case binary::ETag::Bool:   return static_cast<TData>(ReadBinaryPOD<Uint8>(payload) != 0u);
+			case binary::ETag::Int32:  return static_cast<TData>(ReadBinaryPOD<Int32>(payload));
+			case binary::ETag::Uint32: return static_cast<TData>(ReadBinaryPOD<Uint32>(payload));
+			case binary::ETag::Uint64: return static_cast<TData>(ReadBinaryPOD<Uint64>(payload));
+			case binary::ETag::Real32: return static_cast<TData>(ReadBinaryPOD<Real32>(payload));
+			default:                   return TData{};
+			}
+		}
+	}
+
+	template<typename TPOD>
+	static TPOD ReadBinaryPOD(const Byte* data)
+	{
+		TPOD value;
+		std::memcpy(&value, data, sizeof(TPOD));
+		return value;
+	}
+
+	template<typename TRange>
+	void WriteBinaryArray(const char* name, TRange& items)
+	{
+		Serializer itemsWriter = Serializer::CreateBinaryWriter();
+
+		Uint32 itemsNum = 0u;
+		for (auto& item : items)
+		{
+			itemsWriter.Serialize(nullptr, item);
+			++itemsNum;
+		}
+
+		WriteBinaryArrayItems(name, itemsNum, itemsWriter.m_binaryData);
+	}
+
+	/** Calls itemReader for each array item. Each item is a single unnamed field */
+	template<typename TItemReader>
+	void ReadBinaryArray(const char* name, TItemReader&& itemReader)
+	{
+		const lib::Span<const Byte> arrayBlob = ReadBinaryBlob(name, binary::ETag::Array);
+		if (arrayBlob.size() < sizeof(Uint32))
+		{
+			return;
+		}
+
+		const Uint32 itemsNum = ReadBinaryPOD<Uint32>(arrayBlob.data());
+
+		SizeType offset = sizeof(Uint32);
+		for (Uint32 itemIdx = 0u; itemIdx < itemsNum; ++itemIdx)
+		{
+			const SizeType itemSize = GetBinaryFieldSize(arrayBlob, offset);
+			if (itemSize == 0u)
+			{
+				break;
+			}
+
+			Serializer itemSerializer(arrayBlob.subspan(offset, itemSize), m_isValid);
+			itemReader(itemSerializer);
+
+			offset += itemSize;
+		}
+	}
+
+	void WriteBinaryValue(const char* name, binary::ETag tag, const void* data, SizeType dataSize);
+	void WriteBinaryBlob(const char* name, binary::ETag tag, lib::Span<const Byte> data);
+	void WriteBinaryArrayItems(const char* name, Uint32 itemsNum, lib::Span<const Byte> items);
+
+	/** Returns payload of blob field (without size prefix) or empty span if field doesn't exist or has different tag */
+	lib::Span<const Byte> ReadBinaryBlob(const char* name, binary::ETag tag);
+
+	/** Returns number of items in array field without advancing lookup cursor */
+	Uint32 GetBinaryArraySize(const char* name);
+
+	/** Returns whole field (including header) or empty span if field doesn't exist */
+	lib::Span<const Byte> FindBinaryField(const char* name);
+
+	/** Returns size of field starting at offset or 0 if field is invalid */
+	static SizeType GetBinaryFieldSize(lib::Span<const Byte> data, SizeType offset);
+
+	/** Root readers and all writers own their JSON. Sub-readers only point to nodes of the root DOM */
+	JSON        m_json;
+	const JSON* m_jsonView = nullptr;
 
 	Bool m_isSaving = true;
+
+	ESerializationFormat m_format = ESerializationFormat::JSON;
+
+	Bool m_isValid = true;
+
+	// Binary writer
+	lib::DynamicArray<Byte> m_binaryData;
+
+	// Binary reader
+	lib::Span<const Byte> m_binaryView;
+	SizeType              m_binaryCursor = 0u;
 };
 
 } // spt::srl
@@ -19,6 +19,14 @@ public:
 	template<typename TStructType>
 	static Bool DeserializeStruct(TStructType& data, const lib::String& serializedData);
 
+	/** Binary format should be used for compiled data, that is never edited manually */
+	template<typename TStructType>
+	static lib::DynamicArray<Byte> SerializeStructBinary(const TStructType& data);
+
+	/** Returns false if data is not binary document of the current version */
+	template<typename TStructType>
+	static Bool DeserializeStructBinary(TStructType& data, lib::Span<const Byte> serializedData);
+
 	template<typename TStructType>
 	static void SaveTextStructToFile(const TStructType& data, const lib::String& filePath);
 
@@ -49,6 +57,32 @@ Bool SerializationHelper::DeserializeStruct(TStructType& data, const lib::String
 	return true;
 }
 
+template<typename TStructType>
+lib::DynamicArray<Byte> SerializationHelper::SerializeStructBinary(const TStructType& data)
+{
+	SPT_PROFILER_FUNCTION();
+
+	srl::Serializer serializer = srl::Serializer::CreateBinaryWriter();
+	const_cast<TStructType&>(data).Serialize(serializer);
+	return serializer.ToBinary();
+}
+
+template<typename TStructType>
+Bool SerializationHelper::DeserializeStructBinary(TStructType& data, lib::Span<const Byte> serializedData)
+{
+	SPT_PROFILER_FUNCTION();
+
+	srl::Serializer serializer = srl::Serializer::CreateBinaryReader(serializedData);
+	if (!serializer.IsValid())
+	{
+		return false;
+	}
+
+	data.Serialize(serializer);
+
+	return true;
+}
+
 template<typename TStructType>
 void SerializationHelper::SaveTextStructToFile(const TStructType& data, const lib::String& filePath)
 {
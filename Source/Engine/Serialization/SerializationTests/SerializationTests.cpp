@@ -2,6 +2,8 @@
 #include "Serialization.h"
 #include "Utility/Random.h"
 
+#include <chrono>
+
 
 namespace spt::srl::tests
 {
@@ -38,6 +40,86 @@ struct CustomType2
 static_assert(detail::CSerializableIntrusive<CustomType>);
 
 
+struct BenchmarkNode
+{
+	lib::String                     name;
+	lib::HashedString               typeName;
+	lib::DynamicArray<Real32>       values;
+	lib::DynamicArray<BenchmarkNode> children;
+
+	void Serialize(Serializer& serializer)
+	{
+		serializer.Serialize("Name", name);
+		serializer.Serialize("TypeName", typeName);
+		serializer.Serialize("Values", values);
+		serializer.Serialize("Children", children);
+	}
+};
+
+
+namespace priv
+{
+
+BenchmarkNode CreateBenchmarkTree(Uint32 depth, Uint32 childrenNum)
+{
+	BenchmarkNode node;
+	node.name     = "Node_" + std::to_string(depth) + "_" + std::to_string(lib::rnd::Random(0, 1000000));
+	node.typeName = "BenchmarkNodeType";
+	node.values.resize(8u, static_cast<Real32>(depth));
+
+	if (depth > 0u)
+	{
+		for (Uint32 childIdx = 0u; childIdx < childrenNum; ++childIdx)
+		{
+			node.children.emplace_back(CreateBenchmarkTree(depth - 1u, childrenNum));
+		}
+	}
+
+	return node;
+}
+
+/** Reads tree the same way as reader that copied subtree for every nested object and array item */
+void ReadBenchmarkTreeWithSubtreeCopies(BenchmarkNode& node, JSON json)
+{
+	node.name     = json["Name"].get<lib::String>();
+	node.typeName = json["TypeName"].get<lib::String>();
+
+	const JSON valuesJson = json["Values"];
+	for (const JSON& valueJson : valuesJson)
+	{
+		const JSON valueCopy = valueJson;
+		node.values.emplace_back(valueCopy.get<Real32>());
+	}
+
+	const JSON childrenJson = json["Children"];
+	for (const JSON& childJson : childrenJson)
+	{
+		JSON childCopy = childJson;
+		ReadBenchmarkTreeWithSubtreeCopies(node.children.emplace_back(), std::move(childCopy));
+	}
+}
+
+SizeType CountNodes(const BenchmarkNode& node)
+{
+	SizeType count = 1u;
+	for (const BenchmarkNode& child : node.children)
+	{
+		count += CountNodes(child);
+	}
+	return count;
+}
+
+template<typename TCallable>
+Real64 MeasureTimeMs(TCallable&& callable)
+{
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+	callable();
+	return std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+}
+
+} // priv
+
+
 TEST(BasicTypesSerialization, Serialization)
 {
 	Real32  value = 3.14f;
@@ -212,6 +294,230 @@ TEST(EmptyArray, Serialization)
 	EXPECT_EQ(originalData.size(), loadedData.size());
 }
 
+TEST(BinaryCustomType, Serialization)
+{
+	CustomType2 originalData;
+	originalData.floatValue = 1.618f;
+	originalData.nestedType.floatValue  = 6.28f;
+	originalData.nestedType.intValue    = 42;
+	originalData.nestedType.stringValue = "Hello, Serialization!";
+
+	Serializer writer = Serializer::CreateBinaryWriter();
+	writer.Serialize("Data", originalData);
+
+	const lib::DynamicArray<Byte> serializedData = writer.ToBinary();
+
+	EXPECT_TRUE(Serializer::IsBinaryData(serializedData));
+
+	CustomType2 loadedData;
+	Serializer reader = Serializer::CreateBinaryReader(serializedData);
+	reader.Serialize("Data", loadedData);
+
+	EXPECT_TRUE(reader.IsValid());
+	EXPECT_EQ(originalData.floatValue, loadedData.floatValue);
+	EXPECT_EQ(originalData.nestedType.floatValue, loadedData.nestedType.floatValue);
+	EXPECT_EQ(originalData.nestedType.intValue, loadedData.nestedType.intValue);
+	EXPECT_EQ(originalData.nestedType.stringValue, loadedData.nestedType.stringValue);
+}
+
+TEST(BinaryContainers, Serialization)
+{
+	lib::DynamicArray<CustomType> originalArray = {
+		CustomType{ 1.1f, 10, "First"  },
+		CustomType{ 2.2f, 20, "Second" }
+	};
+
+	lib::DynamicArray<lib::DynamicArray<Uint32>> originalNestedArray = { { 1u, 2u }, {}, { 3u } };
+
+	lib::DynamicArray<Byte> originalBytes = { Byte(1), Byte(0), Byte(255) };
+
+	lib::HashMap<lib::String, Int32> originalMap = {
+		{"One", 1},
+		{"Two", 2}
+	};
+
+	math::Matrix4f originalMatrix = math::Matrix4f::Identity();
+	originalMatrix(0, 3) = 5.f;
+
+	Serializer writer = Serializer::CreateBinaryWriter();
+	writer.Serialize("Array", originalArray);
+	writer.Serialize("NestedArray", originalNestedArray);
+	writer.Serialize("Bytes", originalBytes);
+	writer.Serialize("Map", originalMap);
+	writer.Serialize("Matrix", originalMatrix);
+
+	const lib::DynamicArray<Byte> serializedData = writer.ToBinary();
+
+	lib::DynamicArray<CustomType> loadedArray;
+	lib::DynamicArray<lib::DynamicArray<Uint32>> loadedNestedArray;
+	lib::DynamicArray<Byte> loadedBytes;
+	lib::HashMap<lib::String, Int32> loadedMap;
+	math::Matrix4f loadedMatrix;
+
+	Serializer reader = Serializer::CreateBinaryReader(serializedData);
+	reader.Serialize("Array", loadedArray);
+	reader.Serialize("NestedArray", loadedNestedArray);
+	reader.Serialize("Bytes", loadedBytes);
+	reader.Serialize("Map", loadedMap);
+	reader.Serialize("Matrix", loadedMatrix);
+
+	ASSERT_EQ(originalArray.size(), loadedArray.size());
+	for (SizeType i = 0; i < originalArray.size(); ++i)
+	{
+		EXPECT_EQ(originalArray[i].floatValue, loadedArray[i].floatValue);
+		EXPECT_EQ(originalArray[i].intValue, loadedArray[i].intValue);
+		EXPECT_EQ(originalArray[i].stringValue, loadedArray[i].stringValue);
+	}
+
+	EXPECT_EQ(originalNestedArray, loadedNestedArray);
+	EXPECT_EQ(originalBytes, loadedBytes);
+	EXPECT_EQ(originalMap, loadedMap);
+	EXPECT_EQ(originalMatrix, loadedMatrix);
+}
+
+TEST(BinaryFieldsLookup, Serialization)
+{
+	CustomType originalData;
+	originalData.floatValue  = 6.28f;
+	originalData.intValue    = 42;
+	originalData.stringValue = "Hello, Serialization!";
+
+	Serializer writer = Serializer::CreateBinaryWriter();
+	originalData.Serialize(writer);
+
+	const lib::DynamicArray<Byte> serializedData = writer.ToBinary();
+
+	// Fields may be read in different order than they were written and missing fields are default initialized
+	lib::String loadedString;
+	Int32       loadedInt       = 0;
+	Real32      loadedMissing   = 1.f;
+	SizeType    loadedConverted = 0u;
+
+	Serializer reader = Serializer::CreateBinaryReader(serializedData);
+	reader.Serialize("StringValue", loadedString);
+	reader.Serialize("IntValue", loadedInt);
+	reader.Serialize("MissingValue", loadedMissing);
+	reader.Serialize("IntValue", loadedConverted);
+
+	EXPECT_EQ(originalData.stringValue, loadedString);
+	EXPECT_EQ(originalData.intValue, loadedInt);
+	EXPECT_EQ(loadedMissing, 0.f);
+	EXPECT_EQ(loadedConverted, 42u);
+}
+
+TEST(BinaryInvalidVersion, Serialization)
+{
+	CustomType originalData;
+	originalData.intValue = 42;
+
+	Serializer writer = Serializer::CreateBinaryWriter();
+	writer.Serialize("Data", originalData);
+
+	lib::DynamicArray<Byte> serializedData = writer.ToBinary();
+
+	// Change version stored in header
+	serializedData[sizeof(Uint32)] = Byte(0xFF);
+
+	EXPECT_FALSE(Serializer::IsBinaryData(serializedData));
+
+	CustomType loadedData;
+	Serializer reader = Serializer::CreateBinaryReader(serializedData);
+	reader.Serialize("Data", loadedData);
+
+	EXPECT_FALSE(reader.IsValid());
+	EXPECT_EQ(loadedData.intValue, 0);
+}
+
+TEST(NestedArrays, Serialization)
+{
+	lib::DynamicArray<lib::DynamicArray<Int32>> originalData = { { 1, 2 }, {}, { 3 } };
+
+	Serializer writer = Serializer::CreateWriter();
+	writer.Serialize("NestedArray", originalData);
+
+	const lib::String serializedData = writer.ToString();
+
+	lib::DynamicArray<lib::DynamicArray<Int32>> loadedData;
+	Serializer reader = Serializer::CreateReader(serializedData);
+	reader.Serialize("NestedArray", loadedData);
+
+	EXPECT_EQ(originalData, loadedData);
+}
+
+TEST(MissingFields, Serialization)
+{
+	Serializer writer = Serializer::CreateWriter();
+
+	const lib::String serializedData = writer.ToString();
+
+	CustomType2             loadedData;
+	lib::DynamicArray<Int32> loadedArray = { 1 };
+	lib::String             loadedString = "Test";
+
+	Serializer reader = Serializer::CreateReader(serializedData);
+	reader.Serialize("Data", loadedData);
+	reader.Serialize("DataArray", loadedArray);
+	reader.Serialize("StringValue", loadedString);
+
+	EXPECT_EQ(loadedData.nestedType.intValue, 0);
+	EXPECT_TRUE(loadedArray.empty());
+	EXPECT_TRUE(loadedString.empty());
+}
+
+TEST(DeepHierarchyReadBenchmark, Serialization)
+{
+	const BenchmarkNode originalTree = priv::CreateBenchmarkTree(7u, 4u);
+
+	Serializer writer = Serializer::CreateWriter();
+	writer.Serialize("Root", const_cast<BenchmarkNode&>(originalTree));
+	const lib::String serializedData = writer.ToCompactString();
+
+	Serializer binaryWriter = Serializer::CreateBinaryWriter();
+	binaryWriter.Serialize("Root", const_cast<BenchmarkNode&>(originalTree));
+	const lib::DynamicArray<Byte> binaryData = binaryWriter.ToBinary();
+
+	const JSON parsedJson = JSON::parse(serializedData);
+
+	BenchmarkNode subtreeCopiesTree;
+	const Real64 subtreeCopiesMs = priv::MeasureTimeMs([&] { priv::ReadBenchmarkTreeWithSubtreeCopies(subtreeCopiesTree, parsedJson["Root"]); });
+
+	JSON domJson = parsedJson;
+
+	BenchmarkNode domTree;
+	const Real64 domMs = priv::MeasureTimeMs([&]
+											 {
+												 Serializer reader = Serializer::CreateReader(std::move(domJson));
+												 reader.Serialize("Root", domTree);
+											 });
+
+	BenchmarkNode parseAndReadTree;
+	const Real64 parseAndReadMs = priv::MeasureTimeMs([&]
+													  {
+														  Serializer reader = Serializer::CreateReader(serializedData);
+														  reader.Serialize("Root", parseAndReadTree);
+													  });
+
+	BenchmarkNode binaryTree;
+	const Real64 binaryMs = priv::MeasureTimeMs([&]
+												{
+													Serializer reader = Serializer::CreateBinaryReader(binaryData);
+													reader.Serialize("Root", binaryTree);
+												});
+
+	const SizeType nodesNum = priv::CountNodes(originalTree);
+	EXPECT_EQ(priv::CountNodes(subtreeCopiesTree), nodesNum);
+	EXPECT_EQ(priv::CountNodes(domTree), nodesNum);
+	EXPECT_EQ(priv::CountNodes(parseAndReadTree), nodesNum);
+	EXPECT_EQ(priv::CountNodes(binaryTree), nodesNum);
+	EXPECT_EQ(domTree.children.back().children.back().name, originalTree.children.back().children.back().name);
+	EXPECT_EQ(binaryTree.children.back().children.back().name, originalTree.children.back().children.back().name);
+
+	RecordProperty("SubtreeCopiesMs", std::to_string(subtreeCopiesMs));
+	RecordProperty("DOMReadMs",       std::to_string(domMs));
+	RecordProperty("ParseAndReadMs",  std::to_string(parseAndReadMs));
+	RecordProperty("BinaryReadMs",    std::to_string(binaryMs));
+}
+
 } // spt::srl::tests
 
 
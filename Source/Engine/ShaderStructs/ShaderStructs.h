@@ -447,6 +447,16 @@ public:
 };
 
 
+template<typename TStruct>
+void CopyCPPToHLSLArray(lib::Span<const TStruct> cppData, lib::Span<HLSLStorage<TStruct>> hlslData)
+{
+	SPT_STATIC_CHECK_MSG(sizeof(HLSLStorage<TStruct>) == HLSLStorage<TStruct>::s_size, "HLSL storage array must be tightly packed");
+	SPT_CHECK(hlslData.size() >= cppData.size());
+
+	shader_translator::CopyCPPToHLSLArray(cppData, lib::Span<Byte>(reinterpret_cast<Byte*>(hlslData.data()), hlslData.size() * HLSLStorage<TStruct>::s_size));
+}
+
+
 template<typename TShaderStructMemberMetaData, typename TMember>
 constexpr const char* VariableNameOfTypeImpl()
 {
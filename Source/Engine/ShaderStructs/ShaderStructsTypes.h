@@ -468,6 +468,9 @@ void CopyCPPMembersToHLSL(lib::Span<const Byte> cppData, lib::Span<Byte> hlslDat
 template<typename TType>
 struct StructCPPToHLSLTranslator
 {
+	/** Types translated by default implementation can be copied as raw memory by copy plans (custom translators don't define it) */
+	static constexpr Bool isDefaultTranslator = true;
+
 	static void Copy(const TType& cppData, lib::Span<Byte> hlslData)
 	{
 		if constexpr (lib::CContainer<TType>)
@@ -575,6 +578,214 @@ struct StructHLSLAlignmentEvaluator<lib::HashedString>
 	}
 };
 
+//////////////////////////////////////////////////////////////////////////////////////////////////
+// Copy Plans ====================================================================================
+
+/**
+ * Single operation of CPU to HLSL struct copy.
+ * Operations without translate function copy raw memory. Adjacent memory copies are merged, so structs with the same layout are copied with single memcpy.
+ */
+struct HLSLCopyOp
+{
+	using TranslateFunction = void(*)(const Byte* cppData, Byte* hlslData);
+
+	Uint32            cppOffset  = 0u;
+	Uint32            hlslOffset = 0u;
+	Uint32            size       = 0u;
+	TranslateFunction translate  = nullptr;
+};
+
+
+namespace priv
+{
+
+template<typename TType>
+concept CDefaultTranslatedType = requires { StructCPPToHLSLTranslator<TType>::isDefaultTranslator; };
+
+
+template<typename TType>
+void TranslateElement(const Byte* cppData, Byte* hlslData)
+{
+	StructCPPToHLSLTranslator<TType>::Copy(*reinterpret_cast<const TType*>(cppData), lib::Span<Byte>(hlslData, HLSLSizeOf<TType>()));
+}
+
+
+constexpr void AppendMemoryCopyOp(lib::DynamicArray<HLSLCopyOp>& ops, Uint32 cppOffset, Uint32 hlslOffset, Uint32 size)
+{
+	if (!ops.empty())
+	{
+		HLSLCopyOp& lastOp = ops.back();
+		if (lastOp.translate == nullptr && lastOp.cppOffset + lastOp.size == cppOffset && lastOp.hlslOffset + lastOp.size == hlslOffset)
+		{
+			lastOp.size += size;
+			return;
+		}
+	}
+
+	ops.emplace_back(HLSLCopyOp{ cppOffset, hlslOffset, size, nullptr });
+}
+
+
+template<typename TType>
+constexpr void AppendCopyOps(lib::DynamicArray<HLSLCopyOp>& ops, Uint32 cppOffset, Uint32 hlslOffset);
+
+
+template<typename TShaderStructMemberMetaData>
+constexpr void AppendMembersCopyOps(lib::DynamicArray<HLSLCopyOp>& ops, Uint32 cppOffset, Uint32 hlslOffset)
+{
+	if constexpr (!IsTailMember<TShaderStructMemberMetaData>())
+	{
+		AppendMembersCopyOps<typename TShaderStructMemberMetaData::PrevMemberMetaDataType>(ops, cppOffset, hlslOffset);
+	}
+
+	if constexpr (!IsHeadMember<TShaderStructMemberMetaData>())
+	{
+		using TMemberType = typename TShaderStructMemberMetaData::UnderlyingType;
+
+		AppendCopyOps<TMemberType>(ops,
+								   cppOffset + TShaderStructMemberMetaData::s_cpp_memberOffset,
+								   hlslOffset + TShaderStructMemberMetaData::s_hlsl_memberOffset);
+	}
+}
+
+
+template<typename TType>
+constexpr void AppendCopyOps(lib::DynamicArray<HLSLCopyOp>& ops, Uint32 cppOffset, Uint32 hlslOffset)
+{
+	if constexpr (lib::CContainer<TType>)
+	{
+		using TArrayTraits = lib::StaticArrayTraits<TType>;
+		using TElemType = typename TArrayTraits::Type;
+
+		for (Uint32 idx = 0u; idx < TArrayTraits::Size; ++idx)
+		{
+			AppendCopyOps<TElemType>(ops, cppOffset + idx * static_cast<Uint32>(sizeof(TElemType)), hlslOffset + idx * HLSLSizeOf<TElemType>());
+		}
+	}
+	else if constexpr (CShaderStruct<TType>)
+	{
+		AppendMembersCopyOps<typename TType::HeadMemberMetaData>(ops, cppOffset, hlslOffset);
+	}
+	else if constexpr (CDefaultTranslatedType<TType>)
+	{
+		SPT_STATIC_CHECK_MSG(sizeof(TType) == HLSLSizeOf<TType>(), "Default implementation handles only types of the same size");
+		AppendMemoryCopyOp(ops, cppOffset, hlslOffset, static_cast<Uint32>(sizeof(TType)));
+	}
+	else
+	{
+		ops.emplace_back(HLSLCopyOp{ cppOffset, hlslOffset, HLSLSizeOf<TType>(), &TranslateElement<TType> });
+	}
+}
+
+
+template<typename TType>
+consteval SizeType GetHLSLCopyOpsNum()
+{
+	lib::DynamicArray<HLSLCopyOp> ops;
+	AppendCopyOps<TType>(ops, 0u, 0u);
+	return ops.size();
+}
+
+
+template<typename TType>
+consteval auto BuildHLSLCopyPlan()
+{
+	lib::DynamicArray<HLSLCopyOp> ops;
+	AppendCopyOps<TType>(ops, 0u, 0u);
+
+	lib::StaticArray<HLSLCopyOp, GetHLSLCopyOpsNum<TType>()> plan;
+	SPT_CHECK(ops.size() == plan.size());
+	std::copy(std::cbegin(ops), std::cend(ops), std::begin(plan));
+
+	return plan;
+}
+
+
+template<typename TType>
+inline constexpr auto hlslCopyPlan = BuildHLSLCopyPlan<TType>();
+
+
+/** True if CPU and HLSL layouts differ only by padding, so arrays can be copied with single memcpy */
+template<typename TType>
+consteval Bool HasHLSLCompatibleLayout()
+{
+	if constexpr (sizeof(TType) != HLSLSizeOf<TType>())
+	{
+		return false;
+	}
+	else
+	{
+		for (const HLSLCopyOp& op : hlslCopyPlan<TType>)
+		{
+			if (op.translate != nullptr || op.cppOffset != op.hlslOffset)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+
+template<typename TType, SizeType opIdx>
+void ExecuteCopyOp(const Byte* cppData, Byte* hlslData)
+{
+	constexpr HLSLCopyOp op = hlslCopyPlan<TType>[opIdx];
+
+	if constexpr (op.translate == nullptr)
+	{
+		// Size is known at compile time, so compiler emits unrolled (vector) moves instead of calling memcpy
+		std::memcpy(hlslData + op.hlslOffset, cppData + op.cppOffset, op.size);
+	}
+	else
+	{
+		op.translate(cppData + op.cppOffset, hlslData + op.hlslOffset);
+	}
+}
+
+
+template<typename TType, SizeType... opIndices>
+void ExecuteCopyPlan(const Byte* cppData, Byte* hlslData, std::index_sequence<opIndices...>)
+{
+	(ExecuteCopyOp<TType, opIndices>(cppData, hlslData), ...);
+}
+
+} // priv
+
+/**
+ * Copies array of CPU structs to tightly packed HLSL array (element stride is HLSLSizeOf<TType>()).
+ * Uses copy plan computed at compile time instead of translating members one by one, so it's much faster for large arrays.
+ * hlslData may point directly to mapped GPU memory.
+ */
+template<typename TType>
+void CopyCPPToHLSLArray(lib::Span<const TType> cppData, lib::Span<Byte> hlslData)
+{
+	constexpr Uint32 hlslElementSize = HLSLSizeOf<TType>();
+
+	SPT_CHECK(hlslData.size() >= cppData.size() * hlslElementSize);
+
+	if constexpr (priv::HasHLSLCompatibleLayout<TType>())
+	{
+		std::memcpy(hlslData.data(), cppData.data(), cppData.size() * hlslElementSize);
+	}
+	else
+	{
+		constexpr SizeType opsNum = priv::hlslCopyPlan<TType>.size();
+
+		const Byte* cppElement = reinterpret_cast<const Byte*>(cppData.data());
+		Byte* hlslElement      = hlslData.data();
+
+		for (SizeType idx = 0u; idx < cppData.size(); ++idx)
+		{
+			priv::ExecuteCopyPlan<TType>(cppElement, hlslElement, std::make_index_sequence<opsNum>{});
+
+			cppElement  += sizeof(TType);
+			hlslElement += hlslElementSize;
+		}
+	}
+}
+
 } // shader_translator
 
 } // spt::rdr
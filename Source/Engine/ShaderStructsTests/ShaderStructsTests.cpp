@@ -0,0 +1,199 @@
+#include "gtest/gtest.h"
+#include "ShaderStructs/ShaderStructs.h"
+#include "Utility/String/HashedStringDB.h"
+
+#include <chrono>
+#include <cstring>
+#include <random>
+
+
+namespace spt::rdr::tests
+{
+
+BEGIN_SHADER_STRUCT(PackingTestPlainStruct)
+	SHADER_STRUCT_FIELD(math::Vector3f, position)
+	SHADER_STRUCT_FIELD(Real32,         radius)
+	SHADER_STRUCT_FIELD(math::Vector4f, color)
+END_SHADER_STRUCT();
+
+
+BEGIN_SHADER_STRUCT(PackingTestInnerStruct)
+	SHADER_STRUCT_FIELD(Uint32, value)
+	SHADER_STRUCT_FIELD(Bool,   flag)
+END_SHADER_STRUCT();
+
+
+BEGIN_SHADER_STRUCT(PackingTestStruct)
+	SHADER_STRUCT_FIELD(math::Vector3f,    position)
+	SHADER_STRUCT_FIELD(Bool,              enabled)
+	SHADER_STRUCT_FIELD(Uint16,            flags)
+	SHADER_STRUCT_FIELD(math::Vector3f,    direction)
+	SHADER_STRUCT_FIELD(lib::HashedString, name)
+	SHADER_STRUCT_FIELD(SPT_SINGLE_ARG(lib::StaticArray<PackingTestInnerStruct, 3>), inner)
+	SHADER_STRUCT_FIELD(math::Matrix4f,    transform)
+END_SHADER_STRUCT();
+
+
+namespace priv
+{
+
+static lib::DynamicArray<PackingTestPlainStruct> CreatePlainStructs(SizeType num)
+{
+	lib::DynamicArray<PackingTestPlainStruct> structs(num);
+
+	std::mt19937 random(7u);
+	std::uniform_real_distribution<Real32> distribution(-100.f, 100.f);
+
+	for (PackingTestPlainStruct& data : structs)
+	{
+		data.position = math::Vector3f(distribution(random), distribution(random), distribution(random));
+		data.radius   = distribution(random);
+		data.color    = math::Vector4f(distribution(random), distribution(random), distribution(random), distribution(random));
+	}
+
+	return structs;
+}
+
+
+static lib::DynamicArray<PackingTestStruct> CreateStructs(SizeType num)
+{
+	lib::DynamicArray<PackingTestStruct> structs(num);
+
+	std::mt19937 random(7u);
+	std::uniform_real_distribution<Real32> distribution(-100.f, 100.f);
+
+	for (SizeType idx = 0u; idx < num; ++idx)
+	{
+		PackingTestStruct& data = structs[idx];
+		data.position  = math::Vector3f(distribution(random), distribution(random), distribution(random));
+		data.enabled   = random() % 2u == 0u;
+		data.flags     = static_cast<Uint16>(random());
+		data.direction = math::Vector3f(distribution(random), distribution(random), distribution(random));
+		data.name      = lib::HashedString(std::to_string(idx % 64u));
+		for (PackingTestInnerStruct& inner : data.inner)
+		{
+			inner.value = static_cast<Uint32>(random());
+			inner.flag  = random() % 2u == 0u;
+		}
+		data.transform = math::Matrix4f::Identity() * distribution(random);
+	}
+
+	return structs;
+}
+
+
+/** Previous way of packing arrays - each element is translated member by member */
+template<typename TStruct>
+void CopyPerElement(lib::Span<const TStruct> cppData, lib::Span<Byte> hlslData)
+{
+	constexpr Uint32 hlslSize = shader_translator::HLSLSizeOf<TStruct>();
+
+	for (SizeType idx = 0u; idx < cppData.size(); ++idx)
+	{
+		shader_translator::CopyCPPToHLSL(cppData[idx], hlslData.subspan(idx * hlslSize, hlslSize));
+	}
+}
+
+
+template<typename TStruct>
+void ExpectSameAsPerElementCopy(lib::Span<const TStruct> cppData)
+{
+	constexpr Uint32 hlslSize = shader_translator::HLSLSizeOf<TStruct>();
+
+	// Padding isn't written, so both buffers must start with the same contents
+	lib::DynamicArray<Byte> expected(cppData.size() * hlslSize, Byte(0xCD));
+	lib::DynamicArray<Byte> packed(cppData.size() * hlslSize, Byte(0xCD));
+
+	CopyPerElement(cppData, lib::Span<Byte>(expected));
+	shader_translator::CopyCPPToHLSLArray(cppData, lib::Span<Byte>(packed));
+
+	EXPECT_EQ(expected, packed);
+}
+
+
+template<typename TCallable>
+Real64 MeasureTimeMs(TCallable&& callable)
+{
+	const auto beginTime = std::chrono::high_resolution_clock::now();
+	callable();
+	return std::chrono::duration<Real64, std::milli>(std::chrono::high_resolution_clock::now() - beginTime).count();
+}
+
+} // priv
+
+TEST(ShaderStructsPackingTests, PlainStructIsCopiedWithSingleOperation)
+{
+	EXPECT_EQ(shader_translator::priv::hlslCopyPlan<PackingTestPlainStruct>.size(), 1u);
+	EXPECT_TRUE(shader_translator::priv::HasHLSLCompatibleLayout<PackingTestPlainStruct>());
+
+	const lib::DynamicArray<PackingTestPlainStruct> structs = priv::CreatePlainStructs(257u);
+	priv::ExpectSameAsPerElementCopy<PackingTestPlainStruct>(structs);
+}
+
+TEST(ShaderStructsPackingTests, CustomTranslatorsAndPaddingMatchPerElementCopy)
+{
+	EXPECT_FALSE(shader_translator::priv::HasHLSLCompatibleLayout<PackingTestStruct>());
+
+	const lib::DynamicArray<PackingTestStruct> structs = priv::CreateStructs(257u);
+	priv::ExpectSameAsPerElementCopy<PackingTestStruct>(structs);
+}
+
+TEST(ShaderStructsPackingTests, CopiesToHLSLStorageArray)
+{
+	const lib::DynamicArray<PackingTestStruct> structs = priv::CreateStructs(33u);
+
+	constexpr Uint32 hlslSize = shader_translator::HLSLSizeOf<PackingTestStruct>();
+
+	lib::DynamicArray<HLSLStorage<PackingTestStruct>> hlslStructs(structs.size());
+	std::memset(hlslStructs.data(), 0, structs.size() * hlslSize);
+
+	CopyCPPToHLSLArray<PackingTestStruct>(structs, hlslStructs);
+
+	lib::DynamicArray<Byte> expected(structs.size() * hlslSize, Byte(0));
+	priv::CopyPerElement<PackingTestStruct>(structs, expected);
+
+	EXPECT_EQ(std::memcmp(hlslStructs.data(), expected.data(), expected.size()), 0);
+}
+
+TEST(ShaderStructsPackingTests, BulkVsPerElementBenchmark)
+{
+	constexpr SizeType structsNum    = 100000u;
+	constexpr Uint32   iterationsNum = 20u;
+
+	const lib::DynamicArray<PackingTestStruct> structs = priv::CreateStructs(structsNum);
+
+	lib::DynamicArray<Byte> hlslData(structsNum * shader_translator::HLSLSizeOf<PackingTestStruct>());
+
+	const Real64 perElementMs = priv::MeasureTimeMs([&]
+													{
+														for (Uint32 iteration = 0u; iteration < iterationsNum; ++iteration)
+														{
+															priv::CopyPerElement<PackingTestStruct>(structs, hlslData);
+														}
+													});
+
+	const Real64 bulkMs = priv::MeasureTimeMs([&]
+											  {
+												  for (Uint32 iteration = 0u; iteration < iterationsNum; ++iteration)
+												  {
+													  shader_translator::CopyCPPToHLSLArray<PackingTestStruct>(structs, hlslData);
+												  }
+											  });
+
+	RecordProperty("PerElementMs", std::to_string(perElementMs));
+	RecordProperty("BulkMs",       std::to_string(bulkMs));
+}
+
+} // spt::rdr::tests
+
+
+int main(int argc, char** argv)
+{
+	testing::InitGoogleTest(&argc, argv);
+
+	spt::lib::HashedStringDB::Initialize();
+
+	const auto testsResult = RUN_ALL_TESTS();
+
+	return testsResult;
+}
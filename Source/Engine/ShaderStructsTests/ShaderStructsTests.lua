@@ -0,0 +1,8 @@
+ShaderStructsTests = Project:CreateProject("ShaderStructsTests", ETargetType.Application)
+
+function ShaderStructsTests:SetupConfiguration(configuration, platform)
+    self:AddPrivateDependency("ShaderStructs")
+    self:AddPrivateDependency("GoogleTest")
+end
+
+ShaderStructsTests:SetupProject()
\ No newline at end of file
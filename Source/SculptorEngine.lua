@@ -6,6 +6,7 @@ IncludeProject("Math")
 IncludeProject("ProfilerCore")
 IncludeProject("Platform")
 IncludeProject("SculptorLib")
+IncludeProject("SculptorLibTests")
 IncludeProject("Tokenizer")
 
 SetProjectsSubgroupName("Serialization")
@@ -43,6 +44,7 @@ IncludeProject("PlatformWindow")
 
 SetProjectsSubgroupName("Graphics/Rendering")
 IncludeProject("ShaderStructs")
+IncludeProject("ShaderStructsTests")
 
 SetProjectsSubgroupName("Graphics/Shaders")
 IncludeProject("ShaderMetaData")
@@ -50,7 +52,9 @@ IncludeProject("ShaderCompiler")
 
 SetProjectsSubgroupName("Graphics/Rendering")
 IncludeProject("RendererCore")
+IncludeProject("RendererCoreTests")
 IncludeProject("RenderGraph")
+IncludeProject("RenderGraphTests")
 
 SetProjectsSubgroupName("Graphics/Rendering/DLSS")
 IncludeProjectFromDirectory("DLSS/SculptorDLSSVulkan", "SculptorDLSSVulkan")
@@ -58,10 +62,13 @@ IncludeProjectFromDirectory("DLSS/SculptorDLSS", "SculptorDLSS")
 
 SetProjectsSubgroupName("Graphics/Rendering")
 IncludeProject("Graphics")
+IncludeProject("GraphicsTests")
 IncludeProject("Materials")
+IncludeProject("MaterialsTests")
 
 SetProjectsSubgroupName("Scene")
 IncludeProject("RenderScene")
+IncludeProject("RenderSceneTests")
 IncludeProject("SceneRenderer")
 
 SetProjectsSubgroupName("Core/AssetSystem")
@@ -81,6 +88,7 @@ IncludeProjectFromDirectory("Assets/Assets",               "Assets")
 
 SetProjectsSubgroupName("Engine")
 IncludeProject("GameFramework")
+IncludeProject("GameFrameworkTests")
 
 SetProjectsSubgroupName("Tools")
 IncludeProject("Profiler")